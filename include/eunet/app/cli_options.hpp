@@ -0,0 +1,56 @@
+/*
+ * ============================================================================
+ *  File Name   : cli_options.hpp
+ *  Module      : app
+ *
+ *  Description :
+ *      eunet_cli 的命令行选项与解析。只做参数检查与互斥关系判定，
+ *      不创建任何运行期组件，便于单独测试。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_APP_CLI_OPTIONS
+#define INCLUDE_EUNET_APP_CLI_OPTIONS
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "eunet/net/bench_scenario.hpp"
+
+namespace app
+{
+    struct CliOptions
+    {
+        std::string url = "http://www.baidu.com"; // 默认值
+        bool bench = false;
+        net::http::BenchConfig bench_cfg;
+
+        bool json = false;
+        bool json_events = false;
+        std::vector<std::string> urls; // 批处理模式下的全部位置参数
+
+        std::string record_path; // 非空时把事件写入追踪文件
+        std::string open_path;   // 非空时离线浏览追踪文件
+        std::optional<double> replay_speed; // 与 --open 同用，按倍速回放，0 表示尽快
+
+        std::string spill_dir;      // 非空时开启冷数据落盘
+        std::optional<std::size_t> memory_mib; // 落盘前 Timeline 的内存预算，只与 --spill 同用
+    };
+
+    // 打印用法到 stderr
+    void print_usage(const char *prog);
+
+    // 解析命令行，参数非法或组合冲突时返回空
+    std::optional<CliOptions> parse_args(int argc, char **argv);
+}
+
+#endif // INCLUDE_EUNET_APP_CLI_OPTIONS
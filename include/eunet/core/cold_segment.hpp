@@ -0,0 +1,324 @@
+/*
+ * ============================================================================
+ *  File Name   : cold_segment.hpp
+ *  Module      : core
+ *
+ *  Description :
+ *      压缩的冷数据段。长时间采集中旧的记录很少被访问，且高度重复：
+ *      消息与响应头几乎相同，相邻时间戳只差几毫秒。冷数据段把一段记录
+ *      编码为紧凑的只读映像：
+ *          记录流   : 定长字段改为变长整数，时间戳与会话号存相邻差值（zigzag）
+ *          字典     : 文本按行拆分，每行只存一次，文本存为行号序列；
+ *                     响应头等多行文本中只有变化的行占用新空间
+ *          载荷块   : 载荷按内容去重后拼接成约 64 KiB 的块，逐块 LZ 压缩，
+ *                     查询需要载荷时才解压所在的块
+ *          附属映像 : 错误与 TcpInfo 写成 ArenaImage 后整体压缩，首次访问时解压
+ *      记录流每隔 CHECKPOINT_INTERVAL 条存一个解码起点，按下标访问与
+ *      有序段上的时间范围查询从最近的起点开始解码。
+ *
+ *      映像布局（各部分按 8 字节对齐，偏移相对映像起点）：
+ *          Header | 记录流 | Checkpoint[] | 字典 | 附属映像 | PayloadSlot[] | BlockEntry[] | 块数据
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_CORE_COLD_SEGMENT
+#define INCLUDE_EUNET_CORE_COLD_SEGMENT
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/core/event.hpp"
+#include "eunet/core/event_record.hpp"
+#include "eunet/core/timeline.hpp"
+#include "eunet/core/timeline_snapshot.hpp"
+
+namespace core
+{
+    namespace cold
+    {
+        inline constexpr std::uint32_t MAGIC = 0x444C4F43; // "COLD"
+        inline constexpr std::uint32_t VERSION = 1;
+
+        inline constexpr std::size_t CHECKPOINT_INTERVAL = 128;
+        inline constexpr std::size_t PAYLOAD_BLOCK = 64 * 1024; // 载荷块的目标原始大小
+
+        enum Flags : std::uint32_t
+        {
+            ORDERED = 1u << 0, // 记录按时间戳有序
+        };
+
+        struct Section
+        {
+            std::uint64_t offset;
+            std::uint64_t size;
+        };
+
+        struct Header
+        {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint64_t count;
+            std::int64_t min_ts;
+            std::int64_t max_ts;
+            std::uint32_t flags;
+            std::uint32_t type_mask; // 出现过的 EventType
+            std::uint64_t fd_mask;   // 出现过的 fd 按 fd % 64 置位，按 fd 查询时先以此剪枝
+            std::uint64_t errors;    // 带错误的记录数
+            std::uint64_t side_raw;  // 附属映像解压后的字节数
+
+            Section records;
+            Section checkpoints;
+            Section dictionary;
+            Section side;
+            Section payloads;
+            Section blocks;
+            Section block_data;
+        };
+
+        /** 解码第 k * CHECKPOINT_INTERVAL 条记录所需的状态 */
+        struct Checkpoint
+        {
+            std::uint64_t offset;  // 在记录流中的偏移
+            std::int64_t prev_ts;  // 前一条记录的时间戳
+            std::uint64_t prev_session;
+            std::int64_t first_ts; // 本组首条记录的时间戳
+        };
+
+        /** 字典布局：DictHeader | 各行结束偏移[lines] | 各文本结束位置[texts] | 行号[ids] | 行内容 */
+        struct DictHeader
+        {
+            std::uint32_t lines;
+            std::uint32_t texts;
+            std::uint32_t ids;
+            std::uint32_t bytes;
+        };
+
+        struct PayloadSlot
+        {
+            std::uint32_t block;
+            std::uint32_t offset; // 在块解压后内容中的偏移
+            std::uint32_t size;
+            std::uint32_t reserved;
+        };
+
+        struct BlockEntry
+        {
+            std::uint64_t offset; // 在块数据中的偏移
+            std::uint32_t stored; // 存储的字节数，与 raw 相等时未压缩
+            std::uint32_t raw;
+        };
+
+        static_assert(sizeof(Header) % 8 == 0);
+        static_assert(sizeof(Checkpoint) % 8 == 0);
+        static_assert(sizeof(DictHeader) % 8 == 0);
+        static_assert(sizeof(PayloadSlot) % 8 == 0);
+        static_assert(sizeof(BlockEntry) % 8 == 0);
+    }
+
+    /**
+     * @brief 压缩的只读记录段
+     *
+     * 只引用外部映像，owner 负责保持映像有效（可以是内存缓冲区或文件映射）。
+     * 记录中的句柄均为段内编号，需经本段的 text() / payload() 等解析。
+     * 下标为段内下标。构造后不可变，可被多个线程同时查询。
+     */
+    class ColdSegment
+    {
+    public:
+        using EvIdx = std::size_t;
+        using EvCnt = std::size_t;
+        using TimeStamp = platform::time::WallPoint;
+        using IdxList = std::vector<EvIdx>;
+        using EvList = std::vector<Event>;
+        using EvResult = util::ResultV<Event>;
+
+        /**
+         * @brief 顺序解码记录流
+         *
+         * 解码器只持有映像中的位置与相邻差值的状态，复制代价很小。
+         */
+        class Decoder
+        {
+        private:
+            const std::byte *m_pos = nullptr;
+            const std::byte *m_end = nullptr;
+            std::int64_t m_ts = 0;
+            std::uint64_t m_session = 0;
+
+        public:
+            Decoder() = default;
+
+            /** 从段内下标 from 开始解码 */
+            Decoder(const ColdSegment &seg, EvIdx from) noexcept;
+
+            /** 解码下一条记录，记录流结束或损坏时返回 false */
+            bool next(EventRecord &rec) noexcept;
+        };
+
+    private:
+        std::span<const std::byte> m_image;
+        std::shared_ptr<const void> m_owner;
+        const cold::Header *m_header = nullptr;
+
+        // 字典的各表直接引用映像，打开时只校验长度
+        const std::uint32_t *m_line_ends = nullptr;
+        const std::uint32_t *m_text_ends = nullptr;
+        const std::uint32_t *m_text_ids = nullptr;
+        const char *m_line_bytes = nullptr;
+        std::uint32_t m_line_count = 0;
+        std::uint32_t m_text_count = 0;
+        std::uint32_t m_id_count = 0;
+        std::uint32_t m_line_bytes_size = 0;
+
+        struct Cache
+        {
+            std::once_flag side_once;
+            std::vector<std::byte> side;
+            ArenaImage side_image;
+
+            // 只缓存最近解压的一个载荷块，内存占用不随查询增长
+            std::mutex block_mtx;
+            std::uint32_t block = UINT32_MAX;
+            std::vector<std::byte> block_data;
+        };
+        std::unique_ptr<Cache> m_cache = std::make_unique<Cache>();
+
+    public:
+        /**
+         * @brief 把一组记录编码为映像，追加到 out 末尾
+         *
+         * out 先补齐到 8 字节，映像从补齐后的位置开始；
+         * refs 可以来自不同的存储区。
+         */
+        static void encode(std::span<const RecordRef> refs, std::vector<std::byte> &out);
+
+        /**
+         * @brief 绑定并校验一段映像
+         *
+         * @param image 起始地址按 8 字节对齐
+         * @param owner 保持映像有效的对象，可为空（由调用方保证）
+         */
+        static util::ResultV<ColdSegment> open(
+            std::span<const std::byte> image,
+            std::shared_ptr<const void> owner = {});
+
+        /** 压缩快照中 [from, from + count) 的记录，映像由返回的段持有 */
+        static util::ResultV<ColdSegment> compress(
+            const TimelineSnapshot &snap,
+            EvIdx from = 0,
+            EvCnt count = SIZE_MAX);
+
+        ColdSegment() = default;
+
+        ColdSegment(ColdSegment &&) noexcept = default;
+        ColdSegment &operator=(ColdSegment &&) noexcept = default;
+
+    public:
+        EvCnt size() const noexcept { return m_header ? m_header->count : 0; }
+        bool empty() const noexcept { return size() == 0; }
+        bool ordered() const noexcept { return m_header && (m_header->flags & cold::ORDERED); }
+        std::int64_t min_ts() const noexcept { return m_header ? m_header->min_ts : 0; }
+        std::int64_t max_ts() const noexcept { return m_header ? m_header->max_ts : 0; }
+
+        /** 映像的字节数 */
+        std::size_t image_bytes() const noexcept { return m_image.size(); }
+
+        /** 映像之外占用的内存，即解压缓存（近似） */
+        std::size_t memory_bytes() const;
+
+        bool has_type(EventType type) const noexcept;
+
+        /** 为 false 时段内一定没有该 fd；为 true 时可能有 */
+        bool may_contain_fd(int fd) const noexcept;
+
+        /** 调用方保证 idx < size() */
+        EventRecord record_at(EvIdx idx) const noexcept;
+
+        /**
+         * @brief 第一条 ts >= ts_ns 的段内下标，没有时返回 size()
+         *
+         * 只适用于有序段，从解码起点开始解码，最多解码 CHECKPOINT_INTERVAL 条。
+         */
+        EvIdx lower_bound(std::int64_t ts_ns) const noexcept;
+
+        /** 还原为内存中的段，句柄改为新段存储区中的编号 */
+        TimelineSegment thaw() const;
+
+        /** 把段内记录 rec 的变长数据复制进 arena，返回句柄改为 arena 中编号的记录 */
+        EventRecord adopt(const EventRecord &rec, RecordArena &arena) const;
+
+        /** 依次访问每条记录：fn(EvIdx, const EventRecord &) */
+        template <typename Fn>
+        void for_each(Fn &&fn) const
+        {
+            Decoder d(*this, 0);
+            EventRecord rec;
+            for (EvIdx i = 0; i < size() && d.next(rec); ++i)
+                fn(i, rec);
+        }
+
+    public:
+        std::string text(std::uint32_t h) const;
+
+        /** 解压载荷所在的块并复制出载荷 */
+        std::vector<std::byte> payload(std::uint32_t h) const;
+
+        std::optional<util::Error> error(std::uint32_t h) const;
+        const platform::net::TcpInfo *tcp_info(std::uint32_t h) const;
+
+    public:
+        EvResult event_at(EvIdx idx, bool with_payload = true) const;
+
+        EvCnt count_by_fd(int fd) const;
+        EvCnt count_by_type(EventType type) const;
+        EvCnt count_by_time(TimeStamp start, TimeStamp end) const;
+        EvCnt count_by_session(SessionId sid) const;
+
+        EvList replay_all() const;
+
+        EvList query_by_fd(int fd) const;
+        EvList query_by_type(EventType type) const;
+        EvList query_by_time(TimeStamp start, TimeStamp end) const;
+        EvList query_by_session(SessionId sid) const;
+        EvList query_errors() const;
+
+        /** 与 Timeline::query 语义相同的多条件查询 */
+        EvList query(const TimelineQuery &q) const;
+        EvCnt count_matching(const TimelineQuery &q) const;
+
+        /** 命中的段内下标，不还原事件 */
+        IdxList select(const TimelineQuery &q) const;
+
+        /** 按下标列表还原事件，越界的下标被跳过 */
+        EvList materialize(const IdxList &idxs) const;
+
+    private:
+        std::span<const std::byte> section(const cold::Section &s) const noexcept;
+        const ArenaImage &side() const;
+
+        /** 有序段上第一个可能含有 ts >= lo 的记录的解码起点 */
+        EvIdx seek_time(std::int64_t lo) const noexcept;
+
+        /** 对满足 q 的记录依次调用 fn(EvIdx, const EventRecord &) */
+        template <typename Fn>
+        void scan(const TimelineQuery &q, Fn &&fn) const;
+    };
+}
+
+#endif // INCLUDE_EUNET_CORE_COLD_SEGMENT
@@ -0,0 +1,115 @@
+/*
+ * ============================================================================
+ *  File Name   : cold_store.hpp
+ *  Module      : core
+ *
+ *  Description :
+ *      冷段文件存储。后台线程把封存的内存段压缩为 ColdSegment 映像，
+ *      写入指定目录下的文件后以 mmap 只读映射回来，映射交给冷段持有。
+ *      文件创建后立即 unlink，映射解除时由内核回收，进程异常退出也不会
+ *      残留文件；映射的页属于可回收的页缓存，内存紧张时由内核换出。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_CORE_COLD_STORE
+#define INCLUDE_EUNET_CORE_COLD_STORE
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/core/cold_segment.hpp"
+#include "eunet/core/timeline_snapshot.hpp"
+
+namespace core
+{
+    /**
+     * @brief 把内存段写成冷段文件的后台写入器
+     *
+     * submit() 线程安全，段按提交顺序逐个处理，处理完成后在后台线程上
+     * 调用完成回调；回调中可以加调用方自己的锁，但调用方不得在持有该锁时
+     * 调用 flush()。析构时停止后台线程，尚未处理的段被丢弃。
+     * 持有后台线程，不可移动，通过 create() 构造于堆上。
+     */
+    class ColdStore
+    {
+    public:
+        using SegmentPtr = std::shared_ptr<const TimelineSegment>;
+        using ColdPtr = std::shared_ptr<const ColdSegment>;
+        using Done = std::function<void(const SegmentPtr &, util::ResultV<ColdPtr> &&)>;
+
+    private:
+        std::string m_dir;
+        Done m_done;
+
+        std::mutex m_mtx;
+        std::condition_variable m_wake; // 有新任务或需要停止
+        std::condition_variable m_idle; // 队列已清空且没有正在处理的段
+        std::deque<SegmentPtr> m_queue;
+        bool m_busy = false;
+        bool m_stop = false;
+
+        std::atomic<std::uint64_t> m_written{0};
+        std::atomic<std::uint64_t> m_segments{0};
+        std::thread m_thread;
+
+    public:
+        /**
+         * @brief 检查目录并启动后台线程
+         *
+         * @param dir  冷段文件所在目录，需已存在且可写
+         * @param done 每个段处理完成后调用，成功时携带映射好的冷段
+         */
+        static util::ResultV<std::unique_ptr<ColdStore>> create(std::string dir, Done done);
+
+        /**
+         * @brief 同步地把一个段写入 dir 下的文件并映射为冷段
+         *
+         * 不经过后台线程，供 ColdStore 内部与一次性落盘使用。
+         */
+        static util::ResultV<ColdPtr> write(const std::string &dir, const TimelineSegment &seg);
+
+        ~ColdStore();
+
+        ColdStore(const ColdStore &) = delete;
+        ColdStore &operator=(const ColdStore &) = delete;
+
+    public:
+        /** 提交一个已封存的段，段在处理完成前由写入器共同持有 */
+        void submit(SegmentPtr seg);
+
+        /** 阻塞直到已提交的段全部处理完成 */
+        void flush();
+
+        /** 尚未处理完成的段数 */
+        std::size_t pending();
+
+        const std::string &dir() const noexcept { return m_dir; }
+
+        /** 累计写入的映像字节数与段数 */
+        std::uint64_t written_bytes() const noexcept { return m_written.load(std::memory_order_relaxed); }
+        std::uint64_t written_segments() const noexcept { return m_segments.load(std::memory_order_relaxed); }
+
+    private:
+        ColdStore(std::string dir, Done done);
+
+        void run();
+    };
+}
+
+#endif // INCLUDE_EUNET_CORE_COLD_STORE
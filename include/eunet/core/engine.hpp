@@ -22,8 +22,11 @@
 #include <thread>
 #include <memory>
 #include <atomic>
+#include <mutex>
+#include <optional>
 
 #include "eunet/core/scenario.hpp"
+#include "eunet/platform/scheduler.hpp"
 
 namespace core
 {
@@ -34,6 +37,13 @@ namespace core
         std::unique_ptr<std::thread> worker_;
         std::atomic<bool> running_{false};
 
+        // 最近一次 Scenario 的失败原因，成功时为空
+        mutable std::mutex result_mtx_;
+        std::optional<util::Error> last_error_;
+
+        // 可选的 CPU 任务调度器，由外部持有
+        platform::sched::Scheduler *sched_ = nullptr;
+
     public:
         explicit NetworkEngine(Orchestrator &orch) : orch_(orch) {}
 
@@ -69,13 +79,24 @@ namespace core
             worker_ = std::make_unique<std::thread>(
                 [this, sc = std::move(scenario)]()
                 {
+                    std::optional<util::Error> err;
                     try
                     {
-                        (void)sc->run(orch_);
+                        auto res = sc->run(orch_);
+                        if (res.is_err())
+                            err = res.unwrap_err();
                     }
                     catch (...)
                     {
                         // 防止线程内异常导致程序崩溃
+                        err = util::Error::internal()
+                                  .message("Scenario threw an exception")
+                                  .context("NetworkEngine::execute")
+                                  .build();
+                    }
+                    {
+                        std::lock_guard lock(result_mtx_);
+                        last_error_ = std::move(err);
                     }
                     running_.store(false);
                 });
@@ -84,6 +105,38 @@ namespace core
         }
 
         bool is_running() const { return running_; }
+
+        /** 阻塞等待当前 Scenario 执行结束（不可在 Scenario 内部调用） */
+        void wait()
+        {
+            if (worker_ && worker_->joinable())
+                worker_->join();
+        }
+
+        /** 最近一次执行完毕的 Scenario 的失败原因 */
+        std::optional<util::Error> last_error() const
+        {
+            std::lock_guard lock(result_mtx_);
+            return last_error_;
+        }
+
+        /** 绑定 CPU 任务调度器（需比引擎活得更久），传入 nullptr 解除绑定 */
+        void set_scheduler(platform::sched::Scheduler *sched) noexcept { sched_ = sched; }
+        platform::sched::Scheduler *scheduler() const noexcept { return sched_; }
+
+        /**
+         * @brief 提交 CPU 侧任务
+         *
+         * 已绑定调度器时异步执行，否则在调用线程内联执行。
+         */
+        void submit(platform::sched::Job job,
+                    platform::sched::Priority prio = platform::sched::Priority::Normal)
+        {
+            if (sched_)
+                sched_->submit(std::move(job), prio);
+            else
+                job();
+        }
     };
 }
 
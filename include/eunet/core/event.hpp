@@ -19,6 +19,7 @@
 #ifndef INCLUDE_EUNET_CORE_EVENT
 #define INCLUDE_EUNET_CORE_EVENT
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <optional>
@@ -29,10 +30,11 @@
 #include "eunet/util/error.hpp"
 #include "eunet/platform/time.hpp"
 #include "eunet/platform/fd.hpp"
+#include "eunet/platform/net/tcp_info.hpp"
 
 namespace core
 {
-    enum class EventType
+    enum class EventType : std::uint8_t
     {
         // DNS
         DNS_RESOLVE_START,
@@ -41,6 +43,7 @@ namespace core
         TCP_CONNECT_START,
         TCP_CONNECT_SUCCESS,
         TCP_CONNECT_TIMEOUT,
+        SOCKET_OPTION_SET, // 套接字调优选项已应用
         // TLS
         TLS_HANDSHAKE_START,
         TLS_HANDSHAKE_DONE,
@@ -50,11 +53,17 @@ namespace core
         HTTP_REQUEST_BUILD,
         HTTP_HEADERS_RECEIVED,
         HTTP_BODY_DONE,
+        // Kernel
+        TCP_INFO_SAMPLE, // 内核 TCP_INFO 采样
         // Lifecycle
         CONNECTION_IDLE, // 连接闲置中
         CONNECTION_CLOSED
     };
 
+    /** EventType 的取值个数，用于按类型建表 */
+    inline constexpr std::size_t EVENT_TYPE_COUNT =
+        static_cast<std::size_t>(EventType::CONNECTION_CLOSED) + 1;
+
     using SessionId = uint64_t;
 
     /**
@@ -68,8 +77,12 @@ namespace core
     public:
         /** 事件类型枚举 */
         EventType type;
-        /** 事件发生的墙上时间 */
+        /** 事件发生的墙上时间，由 mono_ns 经进程级锚点换算，不随系统时间跳变 */
         platform::time::WallPoint ts;
+        /** 事件时钟读数（纳秒，单调），计算间隔应以此为准 */
+        std::int64_t mono_ns{0};
+        /** 内核软件时间戳 (SO_TIMESTAMPING)，与 ts 换算到同一时间轴 */
+        std::optional<platform::time::WallPoint> kernel_ts = std::nullopt;
         /** 关联的文件描述符（如果有） */
         platform::fd::FdView fd{-1};
         /** 关联的会话 ID */
@@ -78,6 +91,8 @@ namespace core
         std::string msg;
         std::optional<util::Error> error = std::nullopt;
         std::optional<std::vector<std::byte>> payload = std::nullopt;
+        /** 内核 TCP_INFO 采样（仅 TCP_INFO_SAMPLE 事件携带） */
+        std::optional<platform::net::TcpInfo> tcp_info = std::nullopt;
 
     public:
         static Event info(
@@ -91,6 +106,10 @@ namespace core
             util::Error err,
             platform::fd::FdView fd = {-1}) noexcept;
 
+        static Event tcp_sample(
+            const platform::net::TcpInfo &info,
+            platform::fd::FdView fd) noexcept;
+
     private:
         Event();
 
@@ -100,6 +119,14 @@ namespace core
     public:
         bool is_ok() const noexcept;
         bool is_error() const noexcept;
+
+        /**
+         * @brief 内核时间戳减去用户态时间戳（带符号，与 EventRecord::kernel_delay_ns 一致）
+         *
+         * 接收事件通常为负，绝对值是内核收包到用户态读取的延迟；
+         * 发送事件通常为正，是用户态发起到数据离开协议栈的延迟。
+         */
+        std::optional<std::chrono::nanoseconds> kernel_delay() const noexcept;
     };
 }
 
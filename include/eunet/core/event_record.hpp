@@ -0,0 +1,270 @@
+/*
+ * ============================================================================
+ *  File Name   : event_record.hpp
+ *  Module      : core
+ *
+ *  Description :
+ *      紧凑事件记录。EventRecord 为 64 字节、可平凡复制的定长结构，
+ *      只保存类型、单调时间戳、FD、会话、消息模板编号与少量类型化参数；
+ *      字符串、载荷、错误等变长数据存放在 RecordArena 中，以句柄引用。
+ *      可读文本只在 render_message() / materialize() 时才格式化。
+ *      存储区可写成连续的只读映像 (ArenaImage)，映像可直接指向 mmap 的
+ *      文件内容，按句柄访问时才取出数据。
+ *
+ *  Third-Party Dependencies :
+ *      - fmt
+ *          Usage     : 延迟格式化消息文本
+ *          License   : MIT License
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_CORE_EVENT_RECORD
+#define INCLUDE_EUNET_CORE_EVENT_RECORD
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "eunet/util/error.hpp"
+#include "eunet/platform/time.hpp"
+#include "eunet/platform/net/tcp_info.hpp"
+#include "eunet/core/event.hpp"
+
+namespace core
+{
+    /**
+     * @brief 消息模板编号
+     *
+     * 每个编号对应一条固定格式的消息，参数取自 EventRecord::args 与 text 句柄。
+     */
+    enum class MessageId : std::uint8_t
+    {
+        Text,                  // text 原样输出
+        ResolvingHost,         // "Resolving host: {text}"
+        ResolvedTo,            // "Resolved to: {text}"
+        Connecting,            // "Connecting to {text}:{args[0]} (timeout={args[1]}ms)..."
+        ConnectionEstablished, // "Connection established"
+        SendingBytes,          // "Sending {args[0]} bytes..."
+        ReceivedBytes,         // "Received {args[0]} bytes"，带内核时间戳时附加延迟
+        PeerClosed,            // "Peer closed"
+        ClosingConnection,     // "Closing connection"
+        HttpGet,               // "HTTP GET {text}"
+        HttpRequestSent,       // "HTTP request sent"
+        TcpInfoSample,         // to_string(tcp_info)
+    };
+
+    /**
+     * @brief 定长事件记录
+     *
+     * 句柄为 RecordArena 内的序号加一，0 表示不存在。
+     * 时间戳为事件时钟纳秒（platform::time::event_now），与墙上时间的换算见 WallAnchor。
+     */
+    struct EventRecord
+    {
+        enum Flags : std::uint16_t
+        {
+            HAS_KERNEL_TS = 1u << 0,
+        };
+
+        EventType type = EventType::CONNECTION_IDLE;
+        MessageId msg = MessageId::Text;
+        std::uint16_t flags = 0;
+        std::int32_t fd = -1;
+        SessionId session = 0;
+
+        std::int64_t ts_ns = 0;           // 事件时钟纳秒
+        std::int64_t kernel_delay_ns = 0; // 内核时间戳 - ts（HAS_KERNEL_TS 时有效）
+
+        std::uint64_t args[2] = {0, 0};
+
+        std::uint32_t text = 0;
+        std::uint32_t payload = 0;
+        std::uint32_t error = 0;
+        std::uint32_t tcp_info = 0;
+
+        bool is_error() const noexcept { return error != 0; }
+        bool has_payload() const noexcept { return payload != 0; }
+    };
+
+    static_assert(sizeof(EventRecord) <= 64);
+    static_assert(std::is_trivially_copyable_v<EventRecord>);
+
+    /**
+     * @brief 构造记录时附带的变长数据，仅在调用期间有效
+     *
+     * payload 以 data() 是否为空指针区分"无载荷"与"空载荷"。
+     */
+    struct RecordExtras
+    {
+        std::string_view text{};
+        std::span<const std::byte> payload{};
+        const util::Error *error = nullptr;
+        const platform::net::TcpInfo *tcp_info = nullptr;
+    };
+
+    /**
+     * @brief 记录的变长数据存储区
+     *
+     * 文本按内容去重；载荷连续存放在同一块字节缓冲区中，避免逐条分配。
+     * 非线程安全，由持有者加锁。
+     */
+    class RecordArena
+    {
+    private:
+        struct Slice
+        {
+            std::size_t offset;
+            std::size_t size;
+        };
+
+        std::deque<std::string> texts; // deque 保证字符串地址稳定，供去重表引用
+        std::unordered_map<std::string_view, std::uint32_t> text_ids;
+
+        std::vector<std::byte> bytes;
+        std::vector<Slice> payloads;
+
+        std::vector<util::Error> errors;
+        std::vector<platform::net::TcpInfo> tcp_infos;
+
+    public:
+        RecordArena() = default;
+
+        // 去重表以 string_view 引用 texts，按值复制会悬空；移动时 deque 元素地址不变
+        RecordArena(const RecordArena &) = delete;
+        RecordArena &operator=(const RecordArena &) = delete;
+
+        RecordArena(RecordArena &&) noexcept = default;
+        RecordArena &operator=(RecordArena &&) noexcept = default;
+
+    public:
+        std::uint32_t add_text(std::string_view s);
+        std::uint32_t add_payload(std::span<const std::byte> data);
+        std::uint32_t add_error(const util::Error &err);
+        std::uint32_t add_tcp_info(const platform::net::TcpInfo &info);
+
+        /** 把 extras 写入存储区并填好 rec 中对应的句柄 */
+        void attach(EventRecord &rec, const RecordExtras &extras);
+
+        std::string_view text(std::uint32_t h) const noexcept;
+        std::span<const std::byte> payload(std::uint32_t h) const noexcept;
+        const util::Error *error(std::uint32_t h) const noexcept;
+        const platform::net::TcpInfo *tcp_info(std::uint32_t h) const noexcept;
+
+        /** 把另一个存储区中 rec 引用的数据复制过来，返回句柄改写后的记录 */
+        EventRecord adopt(const EventRecord &rec, const RecordArena &from);
+
+        void clear();
+
+        /** 变长数据占用的字节数（近似） */
+        std::size_t memory_bytes() const noexcept;
+
+        /**
+         * @brief 把全部数据写成只读映像，追加到 out 末尾
+         *
+         * 映像内句柄与本存储区一致，长度补齐到 8 字节；格式见 ArenaImage。
+         */
+        void write_image(std::vector<std::byte> &out) const;
+    };
+
+    /**
+     * @brief RecordArena 的只读映像
+     *
+     * 布局依次为 Header、文本 / 载荷 / 错误的 Slice 表、TcpInfo 数组与字节区，
+     * 各部分均按 8 字节对齐，Slice 的偏移相对字节区起点。
+     * 绑定时只校验各表的长度，不逐项解析；错误在访问时才解码为新的 util::Error。
+     * 只引用外部内存，不持有数据，调用方保证映像在使用期间有效。
+     */
+    class ArenaImage
+    {
+    public:
+        struct Header
+        {
+            std::uint32_t texts = 0;
+            std::uint32_t payloads = 0;
+            std::uint32_t errors = 0;
+            std::uint32_t tcp_infos = 0;
+            std::uint64_t blob_size = 0;
+        };
+
+        struct Slice
+        {
+            std::uint64_t offset;
+            std::uint64_t size;
+        };
+
+    private:
+        const Header *m_header = nullptr;
+        const Slice *m_texts = nullptr;
+        const Slice *m_payloads = nullptr;
+        const Slice *m_errors = nullptr;
+        const platform::net::TcpInfo *m_tcp_infos = nullptr;
+        const std::byte *m_blob = nullptr;
+
+    public:
+        ArenaImage() = default;
+
+        /**
+         * @brief 绑定到一段映像
+         *
+         * @param data 起始地址按 8 字节对齐，长度不小于映像长度
+         * @return 各表越界或未对齐时返回错误
+         */
+        static util::ResultV<ArenaImage> view(std::span<const std::byte> data);
+
+    public:
+        std::string_view text(std::uint32_t h) const noexcept;
+        std::span<const std::byte> payload(std::uint32_t h) const noexcept;
+        std::optional<util::Error> error(std::uint32_t h) const;
+        const platform::net::TcpInfo *tcp_info(std::uint32_t h) const noexcept;
+
+        /** 映像的总字节数（含对齐填充） */
+        std::size_t image_bytes() const noexcept;
+
+    private:
+        std::span<const std::byte> slice(const Slice *table, std::uint32_t count, std::uint32_t h) const noexcept;
+    };
+
+    class ColdSegment;
+
+    /**
+     * @brief 指向某个存储区中的一条记录
+     */
+    struct RecordRef
+    {
+        const EventRecord *rec;
+        const RecordArena *arena;
+    };
+
+    /** 只构造定长部分，时间戳取当前事件时钟 */
+    EventRecord make_record(
+        EventType type,
+        MessageId msg,
+        int fd = -1,
+        SessionId session = 0) noexcept;
+
+    /** 按消息模板格式化可读文本 */
+    std::string render_message(const EventRecord &rec, const RecordArena &arena);
+    std::string render_message(const EventRecord &rec, const ArenaImage &arena);
+    std::string render_message(const EventRecord &rec, const ColdSegment &seg);
+
+    /** 还原为完整的 Event（文本在此处才格式化） */
+    Event materialize(const EventRecord &rec, const RecordArena &arena);
+    Event materialize(const EventRecord &rec, const ArenaImage &arena);
+    Event materialize(const EventRecord &rec, const ColdSegment &seg);
+
+    /** 把 Event 压缩为记录，全部字段均可经 materialize 还原 */
+    EventRecord compact(const Event &e, RecordArena &arena);
+}
+
+#endif // INCLUDE_EUNET_CORE_EVENT_RECORD
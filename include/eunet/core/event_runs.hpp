@@ -0,0 +1,126 @@
+/*
+ * ============================================================================
+ *  File Name   : event_runs.hpp
+ *  Module      : core
+ *
+ *  Description :
+ *      线程局部事件段。每个生产者线程把记录追加到自己独占的段（EventRun）中，
+ *      不获取任何锁；段写满或显式 flush 时封存并以一次原子入队交给合并方。
+ *      合并方一次取走所有已封存的段，按时间戳做 k 路归并后整批写入 Timeline。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_CORE_EVENT_RUNS
+#define INCLUDE_EUNET_CORE_EVENT_RUNS
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "eunet/util/mpsc_queue.hpp"
+#include "eunet/core/event_record.hpp"
+
+namespace core
+{
+    /**
+     * @brief 单个生产者线程写出的一段记录，封存时已按时间戳排序
+     */
+    struct EventRun
+    {
+        std::vector<EventRecord> records;
+        RecordArena arena;
+    };
+
+    /**
+     * @brief 线程局部事件段集合
+     *
+     * append() / flush() 可由任意线程调用，只访问调用线程自己的段；
+     * collect() 只允许单一消费者线程调用。
+     * 未封存的段对合并方不可见，生产者应在一轮 IO 结束时调用 flush()；
+     * 线程退出时其残留的段会自动封存。
+     */
+    class EventRuns
+    {
+    public:
+        using RunPtr = std::unique_ptr<EventRun>;
+
+        static constexpr std::size_t DEFAULT_RUN_CAPACITY = 256;
+
+    private:
+        struct Shared
+        {
+            util::MpscQueue<RunPtr> sealed;
+            std::atomic<std::size_t> pending{0}; // 已封存未取走的记录数
+        };
+
+        // 线程局部的写入端，按 owner 区分不同的 EventRuns 实例
+        struct Writer
+        {
+            std::uint64_t owner = 0;
+            std::weak_ptr<Shared> shared;
+            RunPtr run;
+
+            Writer() = default;
+            Writer(Writer &&) noexcept = default;
+            Writer &operator=(Writer &&) noexcept = default;
+            ~Writer();
+
+            void seal();
+        };
+
+    private:
+        std::uint64_t m_id;
+        std::size_t m_capacity;
+        std::shared_ptr<Shared> m_shared;
+
+    public:
+        explicit EventRuns(std::size_t run_capacity = DEFAULT_RUN_CAPACITY);
+
+        EventRuns(const EventRuns &) = delete;
+        EventRuns &operator=(const EventRuns &) = delete;
+
+    public:
+        /**
+         * @brief 追加一条记录到调用线程的段（无锁）
+         *
+         * 记录中的句柄会被忽略，变长数据取自 extras 并复制进段自己的存储区。
+         */
+        void append(const EventRecord &rec, const RecordExtras &extras = {});
+
+        /** 封存调用线程当前的段 */
+        void flush();
+
+        /**
+         * @brief 取走已封存的段（仅限单一消费者线程）
+         *
+         * @param out 追加到该数组末尾
+         * @param limit 本次最多取走的段数
+         * @return 取走的段数
+         */
+        std::size_t collect(std::vector<RunPtr> &out, std::size_t limit = SIZE_MAX);
+
+        /** 已封存但尚未取走的记录数（近似值） */
+        std::size_t pending() const noexcept { return m_shared->pending.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief 按时间戳 k 路归并若干段
+         *
+         * 时间戳相同时先取下标较小的段，同一段内保持原有顺序。
+         */
+        static std::vector<RecordRef> merge(const std::vector<RunPtr> &runs);
+
+    private:
+        Writer &local_writer();
+    };
+}
+
+#endif // INCLUDE_EUNET_CORE_EVENT_RUNS
@@ -36,6 +36,8 @@ namespace core
         platform::time::WallPoint ts;
         std::optional<util::Error> error = std::nullopt;
         std::optional<std::vector<std::byte>> payload = std::nullopt;
+        /** 原始载荷字节数；不订阅载荷的 Sink 收到的快照中 payload 为空，但该值仍有效 */
+        std::size_t payload_size = 0;
     };
 
 }
@@ -59,8 +59,11 @@ namespace core
         int fd{-1};
 
         LifeState state{LifeState::Init};
-        TimeStamp start_ts{};
-        TimeStamp last_ts{};
+        // 事件时钟读数，间隔计算不受系统时间调整影响
+        std::int64_t start_ns{0};
+        std::int64_t last_ns{0};
+        // 会话首个事件时捕获，仅用于把时间戳换算成展示用的墙上时间
+        platform::time::WallAnchor anchor{};
 
         std::optional<util::Error> last_error;
 
@@ -74,6 +77,14 @@ namespace core
         TimeStamp start_timestamp() const noexcept;
         TimeStamp last_timestamp() const noexcept;
 
+        /** 首个事件到最近一个事件的间隔，始终非负 */
+        std::chrono::nanoseconds elapsed() const noexcept;
+
+        /** 本会话的墙上时间锚点 */
+        const platform::time::WallAnchor &wall_anchor() const noexcept;
+        /** 以本会话锚点把事件时钟读数换算为墙上时间 */
+        TimeStamp to_wall(std::int64_t event_ns) const noexcept;
+
         bool has_error() const noexcept;
         std::optional<util::Error> get_last_error() const noexcept;
 
@@ -88,6 +99,17 @@ namespace core
          */
         void on_event(const Event &e);
 
+        /**
+         * @brief 以事件的关键字段更新状态
+         *
+         * 供紧凑记录直接驱动状态机，无需先还原成完整 Event。
+         */
+        void on_event(
+            EventType type,
+            int event_fd,
+            std::int64_t event_ns,
+            const util::Error *err);
+
     private:
         void transit(LifeState next) noexcept;
     };
@@ -109,6 +131,12 @@ namespace core
 
     public:
         void on_event(const Event &e);
+        void on_event(
+            EventType type,
+            int fd,
+            SessionId sid,
+            std::int64_t event_ns,
+            const util::Error *err);
         void clear();
     };
 }
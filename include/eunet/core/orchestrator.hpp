@@ -19,6 +19,7 @@
 #ifndef INCLUDE_EUNET_CORE_ORCHESTRATOR
 #define INCLUDE_EUNET_CORE_ORCHESTRATOR
 
+#include <array>
 #include <vector>
 #include <mutex>
 #include <memory>
@@ -26,18 +27,34 @@
 
 #include "eunet/util/result.hpp"
 #include "eunet/util/error.hpp"
+#include "eunet/util/mpsc_queue.hpp"
+#include "eunet/core/event_record.hpp"
+#include "eunet/core/event_runs.hpp"
 #include "eunet/core/timeline.hpp"
 #include "eunet/core/lifecycle_fsm.hpp"
 #include "eunet/core/sink.hpp"
 
 namespace core
 {
+    /**
+     * @brief 分发统计
+     */
+    struct DispatchStats
+    {
+        std::uint64_t snapshots_built = 0;   // 构建的快照数（含载荷与不含载荷两种）
+        std::uint64_t payload_snapshots = 0; // 其中携带载荷的快照数
+        std::uint64_t snapshots_skipped = 0; // 没有任何 Sink 接收而未构建快照的事件数
+        std::uint64_t deliveries = 0;        // on_event 调用次数
+        std::uint64_t filtered = 0;          // 类型匹配但被会话 / 错误条件过滤的次数
+    };
+
     /**
      * @brief 核心编排器
      *
      * 系统的中枢神经。负责接收来自 Network 层的事件，
      * 将其写入 Timeline，更新 FSM 状态，并将快照分发给所有注册的 Sink（如 UI）。
      * 保证了事件处理的线性化和线程安全。
+     * 分发按各 Sink 的订阅条件（sink::Interest）进行，快照按需延迟构建。
      */
     class Orchestrator
     {
@@ -49,10 +66,32 @@ namespace core
         Timeline timeline;
         FsmManager fsm_manager;
 
-        std::vector<SinkPtr> sinks;
+        struct SinkEntry
+        {
+            SinkPtr sink;
+            sink::Interest interest;
+        };
+
+        std::vector<SinkEntry> sinks;
+        // 按事件类型预先计算的候选 Sink 下标，attach / detach 时重建
+        std::array<std::vector<std::size_t>, EVENT_TYPE_COUNT> dispatch;
+
+        std::atomic<std::uint64_t> stat_built{0};
+        std::atomic<std::uint64_t> stat_payload{0};
+        std::atomic<std::uint64_t> stat_skipped{0};
+        std::atomic<std::uint64_t> stat_deliveries{0};
+        std::atomic<std::uint64_t> stat_filtered{0};
+
         std::atomic<SessionId> next_session_id_{1};
         mutable std::mutex mtx;
 
+        // 多 reactor 无锁投递通道：生产者只做一次原子入队，由单一消费者 drain
+        util::MpscQueue<Event> inbox;
+        std::atomic<std::size_t> inbox_pending{0};
+
+        // 线程局部事件段：生产者各写各的段 由 merge() 归并后整批入库
+        EventRuns runs;
+
     public:
         Orchestrator() = default;
 
@@ -71,11 +110,92 @@ namespace core
          */
         EmitResult emit(Event e);
 
+        /**
+         * @brief 提交一条紧凑记录
+         *
+         * 与 emit 流程相同，但记录直接写入 Timeline，
+         * 只有存在接收该事件的 Sink 时才还原成 Event 并格式化消息文本。
+         *
+         * @param rec 定长记录（其中的句柄会被忽略）
+         * @param extras 变长数据，仅在调用期间有效
+         */
+        EmitResult record(const EventRecord &rec, const RecordExtras &extras = {});
+
+        /**
+         * @brief 无锁提交事件
+         *
+         * 供多个 reactor 线程在 IO 路径上调用，不获取任何互斥锁。
+         * 事件暂存于 MPSC 队列，需由单一消费者线程调用 drain() 写入 Timeline 并分发。
+         *
+         * @param e 待提交的事件
+         */
+        void submit(Event e);
+
+        /**
+         * @brief 处理已 submit 的事件（仅限单一消费者线程）
+         *
+         * 整批事件只加一次锁，按入队顺序依次执行与 emit 相同的流程。
+         *
+         * @param limit 本次最多处理的事件数
+         * @return util::ResultV<size_t> 实际处理的事件数，遇到失败时返回首个错误
+         */
+        util::ResultV<std::size_t> drain(std::size_t limit = SIZE_MAX);
+
+        /** 已 submit 但尚未 drain 的事件数（近似值） */
+        std::size_t pending() const noexcept { return inbox_pending.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief 追加记录到调用线程的局部事件段
+         *
+         * 不获取任何锁，也不与其他生产者共享缓存行。记录在段封存
+         * （写满、flush_local() 或线程退出）并经 merge() 归并后才进入 Timeline。
+         */
+        void append(const EventRecord &rec, const RecordExtras &extras = {});
+
+        /** 封存调用线程的局部事件段，使其对 merge() 可见 */
+        void flush_local();
+
+        /**
+         * @brief 归并已封存的事件段（仅限单一消费者线程）
+         *
+         * 各段按时间戳 k 路归并后整批写入 Timeline（只加一次锁），
+         * 再按时间顺序依次更新 FSM 并分发。
+         *
+         * @param max_runs 本次最多归并的段数
+         * @return util::ResultV<size_t> 写入的记录数
+         */
+        util::ResultV<std::size_t> merge(std::size_t max_runs = SIZE_MAX);
+
+        /** 已封存但尚未 merge 的记录数（近似值） */
+        std::size_t pending_runs() const noexcept { return runs.pending(); }
+
         SessionId new_session() { return next_session_id_.fetch_add(1); }
 
+        /** 开启 Timeline 的冷数据落盘，见 Timeline::enable_spill */
+        util::ResultV<void> enable_spill(SpillOptions opts);
+
+        /** 以 Sink 自身声明的 interest() 订阅 */
         void attach(SinkPtr sink);
+        /** 以指定条件订阅，覆盖 Sink 自身的声明 */
+        void attach(SinkPtr sink, sink::Interest interest);
         void detach(SinkPtr sink);
         void reset();
+
+        /** 分发统计（可在 Sink 回调内调用，不加锁） */
+        DispatchStats dispatch_stats() const noexcept;
+
+    private:
+        EmitResult commit(Event &e);
+        void rebuild_dispatch();
+
+        /** make(with_payload) 返回要放入快照的事件，仅在有 Sink 接收时调用 */
+        template <typename MakeEvent>
+        void deliver(
+            EventType type,
+            SessionId sid,
+            bool is_error,
+            std::size_t payload_size,
+            MakeEvent &&make);
     };
 }
 
@@ -0,0 +1,121 @@
+/*
+ * ============================================================================
+ *  File Name   : replay_scenario.hpp
+ *  Module      : core
+ *
+ *  Description :
+ *      追踪回放场景。读取 TraceFile 中的记录，经 Orchestrator::record()
+ *      重新写入 Timeline、驱动状态机并分发给已挂载的 Sink，不产生任何网络 IO。
+ *      发送时刻由模拟时钟决定：模拟时钟以设定倍速推进，记录在模拟时刻
+ *      到达其时间戳时才被提交，因此事件间隔按倍速等比缩放；倍速为 0 时不等待。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_CORE_REPLAY_SCENARIO
+#define INCLUDE_EUNET_CORE_REPLAY_SCENARIO
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <string>
+
+#include "eunet/core/scenario.hpp"
+#include "eunet/core/trace_file.hpp"
+
+namespace core::scenario
+{
+    struct ReplayConfig
+    {
+        double speed = 1.0;         // 回放倍速，<= 0 表示不等待、尽快提交
+        bool rebase = true;         // 时间戳整体平移到回放开始时刻，事件间隔保持记录中的原值
+        bool remap_sessions = true; // 记录中的会话改用新分配的会话号，避免与现有会话冲突
+
+        std::size_t first = 0;        // 回放的起始下标
+        std::size_t count = SIZE_MAX; // 最多回放的条数
+    };
+
+    /**
+     * @brief 回放用的模拟时钟
+     *
+     * 把追踪文件中的时间戳映射到本进程的事件时钟：
+     * 模拟时刻 = trace_origin + (真实时刻 - real_origin) * speed。
+     */
+    class ReplayClock
+    {
+    private:
+        std::int64_t m_trace_origin;
+        std::int64_t m_real_origin;
+        double m_speed;
+
+    public:
+        ReplayClock(std::int64_t trace_origin, std::int64_t real_origin, double speed) noexcept
+            : m_trace_origin(trace_origin), m_real_origin(real_origin), m_speed(speed) {}
+
+    public:
+        /** 倍速不大于 0 时时钟不受真实时间约束 */
+        bool unbounded() const noexcept { return m_speed <= 0; }
+
+        /** 真实时刻 real_ns 对应的模拟时刻 */
+        std::int64_t trace_at(std::int64_t real_ns) const noexcept;
+
+        /** 模拟时刻 trace_ns 对应的真实时刻；不受约束时即为 real_origin */
+        std::int64_t real_at(std::int64_t trace_ns) const noexcept;
+    };
+
+    struct ReplayStats
+    {
+        std::size_t emitted = 0;
+        std::int64_t elapsed_ns = 0;    // 回放的真实耗时
+        std::int64_t trace_span_ns = 0; // 已回放部分在记录中跨越的时长
+        std::int64_t max_lag_ns = 0;    // 提交时刻相对计划时刻的最大滞后
+        bool stopped = false;           // 被 stop() 提前结束
+    };
+
+    class ReplayScenario : public Scenario
+    {
+    private:
+        std::string m_path;
+        std::shared_ptr<const TraceFile> m_trace;
+        ReplayConfig m_cfg;
+        ReplayStats m_stats;
+        std::stop_source m_stop;
+
+    public:
+        /** 在 run() 时打开 path 指定的追踪文件 */
+        explicit ReplayScenario(std::string path, ReplayConfig cfg = {});
+
+        /** 回放已打开的追踪文件，可被多个场景共享 */
+        explicit ReplayScenario(std::shared_ptr<const TraceFile> trace, ReplayConfig cfg = {});
+
+        RunResult run(Orchestrator &orch) override;
+
+        /** 请求提前结束，可在其他线程调用；等待中的场景在一个等待片内返回，之后再运行也立即结束 */
+        void stop() noexcept { m_stop.request_stop(); }
+
+        /**
+         * @brief 共享的停止源
+         *
+         * 场景交给 NetworkEngine 后所有权随之转移，调用方可先取得停止源，
+         * 之后即使场景已被销毁也能安全地请求停止。
+         */
+        std::stop_source stop_source() const noexcept { return m_stop; }
+
+        /** 最近一次运行的统计 */
+        const ReplayStats &stats() const noexcept { return m_stats; }
+        const ReplayConfig &config() const noexcept { return m_cfg; }
+
+    private:
+        /** 等待到事件时钟 real_ns，被 stop() 打断时返回 false */
+        bool wait_until(std::int64_t real_ns) const;
+    };
+}
+
+#endif // INCLUDE_EUNET_CORE_REPLAY_SCENARIO
@@ -6,6 +6,8 @@
  *  Description :
  *      网络场景的抽象基类。定义了 `run` 接口，任何具体的网络任务
  *      （如 HTTP 请求、Ping 探测）都继承此类并在 run 中执行逻辑。
+ *      `run_async` 为协程版本，挂起在 reactor 上等待 IO，
+ *      大量会话只占用协程帧而不占用线程。
  *
  *  Third-Party Dependencies :
  *      None
@@ -20,6 +22,8 @@
 #define INCLUDE_EUNET_CORE_SCENARIO
 
 #include "eunet/util/result.hpp"
+#include "eunet/util/task.hpp"
+#include "eunet/platform/event_loop.hpp"
 #include "eunet/core/orchestrator.hpp"
 
 namespace core::scenario
@@ -32,6 +36,21 @@ namespace core::scenario
     public:
         virtual ~Scenario() = default;
         virtual RunResult run(Orchestrator &orch) = 0;
+
+        /**
+         * @brief 以协程方式运行场景
+         *
+         * 只能在 loop 所属线程内 co_await 或 spawn。
+         * 默认实现直接调用同步的 run()，会阻塞 reactor 线程；
+         * 需要高并发的场景应覆写为真正挂起的实现。
+         */
+        virtual util::Task<RunResult> run_async(
+            Orchestrator &orch,
+            platform::reactor::EventLoop &loop)
+        {
+            (void)loop;
+            co_return run(orch);
+        }
     };
 }
 
@@ -19,16 +19,90 @@
 #ifndef INCLUDE_EUNET_CORE_SINK
 #define INCLUDE_EUNET_CORE_SINK
 
+#include <bitset>
+#include <initializer_list>
+#include <unordered_set>
+
 #include "eunet/core/event_snapshot.hpp"
 
 namespace core::sink
 {
+    /**
+     * @brief Sink 的订阅条件
+     *
+     * Orchestrator 据此预先按事件类型建立分发表，不感兴趣的 Sink 不会被调用；
+     * 没有任何 Sink 订阅的事件不构建快照，不需要载荷的 Sink 收到不含载荷的快照。
+     * 默认订阅全部事件（含载荷）。
+     */
+    struct Interest
+    {
+        std::bitset<EVENT_TYPE_COUNT> types;
+        std::unordered_set<SessionId> sessions; // 为空表示全部会话
+        bool errors_only = false;
+        bool payload = true;
+
+        Interest() { types.set(); }
+
+        static Interest all() { return {}; }
+
+        static Interest only(std::initializer_list<EventType> list)
+        {
+            Interest i;
+            i.types.reset();
+            for (auto t : list)
+                i.types.set(static_cast<std::size_t>(t));
+            return i;
+        }
+
+        Interest &with_payload(bool on) &
+        {
+            payload = on;
+            return *this;
+        }
+        Interest &&with_payload(bool on) && { return std::move(with_payload(on)); }
+
+        Interest &errors(bool on = true) &
+        {
+            errors_only = on;
+            return *this;
+        }
+        Interest &&errors(bool on = true) && { return std::move(errors(on)); }
+
+        Interest &session(SessionId sid) &
+        {
+            sessions.insert(sid);
+            return *this;
+        }
+        Interest &&session(SessionId sid) && { return std::move(session(sid)); }
+
+        bool wants(EventType t) const noexcept
+        {
+            return types.test(static_cast<std::size_t>(t));
+        }
+
+        /** 类型之外的过滤条件（会话与错误），类型已由分发表筛过 */
+        bool accepts(const Event &e) const
+        {
+            return accepts(e.session_id, e.is_error());
+        }
+
+        bool accepts(SessionId sid, bool is_error) const
+        {
+            if (errors_only && !is_error)
+                return false;
+            return sessions.empty() || sessions.contains(sid);
+        }
+    };
+
     class IEventSink
     {
     public:
         virtual ~IEventSink() = default;
 
         virtual void on_event(const EventSnapshot &snap) = 0;
+
+        /** attach 时未显式指定订阅条件则使用该值 */
+        virtual Interest interest() const { return Interest::all(); }
     };
 
 }
@@ -18,6 +18,11 @@ namespace core::sink
                 << " @ " << to_string(s.ts)
                 << "\n";
         }
+
+        Interest interest() const override
+        {
+            return Interest::all().with_payload(false);
+        }
     };
 }
 
@@ -0,0 +1,311 @@
+#ifndef INCLUDE_EUNET_CORE_SINK_JSON_SINK
+#define INCLUDE_EUNET_CORE_SINK_JSON_SINK
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "eunet/core/event_snapshot.hpp"
+#include "eunet/core/sink.hpp"
+
+namespace core::sink
+{
+    struct JsonSinkOptions
+    {
+        bool events = false; // 是否逐条输出原始事件
+    };
+
+    /**
+     * @brief 以 NDJSON（每行一个 JSON 对象）流式输出的 Sink
+     *
+     * 每个会话在连接关闭或首次失败时输出一行 "session" 记录，包含 DNS / 建连 /
+     * 请求构建 / 首字节 / 响应体各阶段耗时（毫秒，缺失的阶段为 null）；
+     * 失败事件同时立即输出一行 "error" 记录。未结束的会话在 flush() 时补齐输出。
+     * 会话记录输出后即从表中移除，长时间运行时内存只与并发会话数相关；
+     * 最近结束的会话号保留在定长窗口中，用于丢弃其迟到事件。
+     * 只按 Event::session_id 聚合，session_id 为 0 的事件不参与阶段统计。
+     */
+    class JsonSink : public IEventSink
+    {
+    private:
+        using WallPoint = platform::time::WallPoint;
+
+        struct SessionTimes
+        {
+            int fd = -1;
+            WallPoint first{};
+            WallPoint last{};
+            std::optional<WallPoint> dns_start, dns_done;
+            std::optional<WallPoint> connect_start, connect_done;
+            std::optional<WallPoint> build, sent;
+            std::optional<WallPoint> first_byte, last_byte;
+            size_t bytes_received = 0;
+            std::optional<util::Error> error;
+        };
+
+        /** 记忆最近结束会话号的窗口大小 */
+        static constexpr size_t RETIRED_WINDOW = 4096;
+
+        std::ostream &out;
+        JsonSinkOptions opts;
+
+        mutable std::mutex mtx;
+        std::unordered_map<SessionId, SessionTimes> sessions;
+        std::unordered_set<SessionId> retired;
+        std::deque<SessionId> retired_order;
+        size_t lines = 0;
+
+    public:
+        explicit JsonSink(std::ostream &os, JsonSinkOptions o = {})
+            : out(os), opts(o) {}
+
+        ~JsonSink() override { flush(); }
+
+    public:
+        void on_event(const EventSnapshot &s) override
+        {
+            const Event &e = s.event;
+            std::lock_guard lock(mtx);
+
+            if (opts.events)
+                write_line(event_line(e));
+
+            if (e.is_error())
+                write_line(error_line(e));
+
+            if (e.session_id == 0 || retired.contains(e.session_id))
+                return;
+
+            auto [it, fresh] = sessions.try_emplace(e.session_id);
+            auto &st = it->second;
+
+            if (fresh)
+                st.first = e.ts;
+            st.last = e.ts;
+            if (e.fd.fd >= 0)
+                st.fd = e.fd.fd;
+
+            if (e.is_error())
+            {
+                st.error = e.error;
+                finish(it);
+                return;
+            }
+
+            switch (e.type)
+            {
+            case EventType::DNS_RESOLVE_START:
+                st.dns_start = st.dns_start.value_or(e.ts);
+                break;
+            case EventType::DNS_RESOLVE_DONE:
+                st.dns_done = e.ts;
+                break;
+            case EventType::TCP_CONNECT_START:
+                st.connect_start = st.connect_start.value_or(e.ts);
+                break;
+            case EventType::TCP_CONNECT_SUCCESS:
+                st.connect_done = e.ts;
+                break;
+            case EventType::HTTP_REQUEST_BUILD:
+                st.build = st.build.value_or(e.ts);
+                break;
+            case EventType::HTTP_SENT:
+                st.sent = e.ts;
+                break;
+            case EventType::HTTP_RECEIVED:
+                if (!st.first_byte)
+                    st.first_byte = e.ts;
+                st.last_byte = e.ts;
+                st.bytes_received += s.payload_size;
+                break;
+            case EventType::HTTP_BODY_DONE:
+                st.last_byte = e.ts;
+                break;
+            case EventType::CONNECTION_CLOSED:
+                finish(it);
+                break;
+            default:
+                break;
+            }
+        }
+
+        /** 只用到载荷长度，无需载荷本身 */
+        Interest interest() const override
+        {
+            return Interest::all().with_payload(false);
+        }
+
+        /** 输出所有尚未结束的会话记录（如仍在进行中的会话） */
+        void flush()
+        {
+            std::lock_guard lock(mtx);
+            while (!sessions.empty())
+                finish(sessions.begin());
+            out.flush();
+        }
+
+        /** 已输出的行数 */
+        size_t written() const
+        {
+            std::lock_guard lock(mtx);
+            return lines;
+        }
+
+        /** 尚未结束、仍在表中的会话数 */
+        size_t pending() const
+        {
+            std::lock_guard lock(mtx);
+            return sessions.size();
+        }
+
+    public:
+        /** 按 JSON 字符串规则转义（不含两侧引号） */
+        static std::string escape(std::string_view s)
+        {
+            std::string r;
+            r.reserve(s.size() + 8);
+            for (unsigned char c : s)
+            {
+                switch (c)
+                {
+                case '"':
+                    r += "\\\"";
+                    break;
+                case '\\':
+                    r += "\\\\";
+                    break;
+                case '\n':
+                    r += "\\n";
+                    break;
+                case '\r':
+                    r += "\\r";
+                    break;
+                case '\t':
+                    r += "\\t";
+                    break;
+                default:
+                    if (c < 0x20)
+                    {
+                        char buf[8];
+                        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                        r += buf;
+                    }
+                    else
+                        r += static_cast<char>(c);
+                }
+            }
+            return r;
+        }
+
+    private:
+        /** 输出会话记录并移除，会话号记入最近结束窗口 */
+        void finish(std::unordered_map<SessionId, SessionTimes>::iterator it)
+        {
+            const SessionId sid = it->first;
+            write_line(session_line(sid, it->second));
+            sessions.erase(it);
+
+            if (retired.insert(sid).second)
+            {
+                retired_order.push_back(sid);
+                if (retired_order.size() > RETIRED_WINDOW)
+                {
+                    retired.erase(retired_order.front());
+                    retired_order.pop_front();
+                }
+            }
+        }
+
+        void write_line(const std::string &line)
+        {
+            out << line << '\n';
+            out.flush();
+            ++lines;
+        }
+
+        static std::string quote(std::string_view s)
+        {
+            return "\"" + escape(s) + "\"";
+        }
+
+        static std::string unix_us(WallPoint tp)
+        {
+            return std::to_string(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    tp.time_since_epoch())
+                    .count());
+        }
+
+        static std::string span_ms(
+            const std::optional<WallPoint> &from,
+            const std::optional<WallPoint> &to)
+        {
+            if (!from || !to)
+                return "null";
+
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%.3f",
+                          std::chrono::duration<double, std::milli>(*to - *from).count());
+            return buf;
+        }
+
+        static std::string error_fields(const util::Error &err)
+        {
+            return "\"category\":" + quote(to_string(err.root_category())) +
+                   ",\"message\":" + quote(err.format());
+        }
+
+        static std::string event_line(const Event &e)
+        {
+            return "{\"type\":\"event\",\"session\":" + std::to_string(e.session_id) +
+                   ",\"event\":" + quote(to_string(e.type)) +
+                   ",\"fd\":" + std::to_string(e.fd.fd) +
+                   ",\"ts_us\":" + unix_us(e.ts) +
+                   ",\"msg\":" + quote(e.msg) + "}";
+        }
+
+        static std::string error_line(const Event &e)
+        {
+            return "{\"type\":\"error\",\"session\":" + std::to_string(e.session_id) +
+                   ",\"event\":" + quote(to_string(e.type)) +
+                   ",\"fd\":" + std::to_string(e.fd.fd) +
+                   ",\"ts_us\":" + unix_us(e.ts) + "," +
+                   error_fields(*e.error) + "}";
+        }
+
+        static std::string session_line(SessionId sid, const SessionTimes &st)
+        {
+            std::optional<WallPoint> first = st.first;
+            std::optional<WallPoint> last = st.last;
+
+            std::string line =
+                "{\"type\":\"session\",\"session\":" + std::to_string(sid) +
+                ",\"fd\":" + std::to_string(st.fd) +
+                ",\"start_us\":" + unix_us(st.first) +
+                ",\"dns_ms\":" + span_ms(st.dns_start, st.dns_done) +
+                ",\"connect_ms\":" + span_ms(st.connect_start, st.connect_done) +
+                ",\"request_build_ms\":" + span_ms(st.build, st.sent) +
+                ",\"ttfb_ms\":" + span_ms(st.sent, st.first_byte) +
+                ",\"body_ms\":" + span_ms(st.first_byte, st.last_byte) +
+                ",\"total_ms\":" + span_ms(first, last) +
+                ",\"bytes_received\":" + std::to_string(st.bytes_received) +
+                ",\"ok\":" + (st.error ? "false" : "true");
+
+            if (st.error)
+                line += ",\"error\":{" + error_fields(*st.error) + "}";
+            else
+                line += ",\"error\":null";
+
+            return line + "}";
+        }
+    };
+}
+
+#endif // INCLUDE_EUNET_CORE_SINK_JSON_SINK
@@ -2,6 +2,10 @@
 #define INCLUDE_EUNET_CORE_SINK_METRICS_SINK
 
 #include <atomic>
+#include <mutex>
+#include <optional>
+#include <algorithm>
+#include <unordered_map>
 
 #include "eunet/core/event_snapshot.hpp"
 #include "eunet/core/sink.hpp"
@@ -12,21 +16,77 @@ namespace core::sink
     {
         std::atomic<size_t> total_events{0};
         std::atomic<size_t> errors{0};
+        std::atomic<size_t> tcp_info_samples{0};
+    };
+
+    /**
+     * @brief 单连接的内核指标记录
+     *
+     * 由 TCP_INFO_SAMPLE 事件累积而来，保留最近一次采样
+     * 以及 RTT 极值，便于把 TTFB 抖动与重传关联起来。
+     * 按会话聚合：内核会复用 fd，fd 只作为展示字段保留最近一次的值。
+     */
+    struct ConnectionMetrics
+    {
+        int fd = -1;
+        size_t samples = 0;
+        platform::net::TcpInfo last{};
+        uint32_t min_rtt_us = 0;
+        uint32_t max_rtt_us = 0;
+        uint32_t max_unacked = 0;
     };
 
     class MetricsSink : public IEventSink
     {
         Metrics m;
 
+        mutable std::mutex conn_mtx;
+        std::unordered_map<SessionId, ConnectionMetrics> conns;
+
     public:
         void on_event(const EventSnapshot &s) override
         {
             ++m.total_events;
             if (s.error)
                 ++m.errors;
+
+            if (s.event.type == EventType::TCP_INFO_SAMPLE && s.event.tcp_info)
+                record(s.event.session_id, s.fd, *s.event.tcp_info);
+        }
+
+        Interest interest() const override
+        {
+            return Interest::all().with_payload(false);
         }
 
         const Metrics &snapshot() const noexcept { return m; }
+
+        /** 按会话查询内核指标，未采样过的会话返回空 */
+        std::optional<ConnectionMetrics> connection(SessionId sid) const
+        {
+            std::lock_guard lock(conn_mtx);
+            auto it = conns.find(sid);
+            if (it == conns.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+    private:
+        void record(SessionId sid, int fd, const platform::net::TcpInfo &info)
+        {
+            ++m.tcp_info_samples;
+
+            std::lock_guard lock(conn_mtx);
+            auto &c = conns[sid];
+            c.fd = fd;
+            c.min_rtt_us = c.samples == 0
+                               ? info.rtt_us
+                               : std::min(c.min_rtt_us, info.rtt_us);
+            c.max_rtt_us = std::max(c.max_rtt_us, info.rtt_us);
+            c.max_unacked = std::max(c.max_unacked, info.unacked);
+            c.last = info;
+            ++c.samples;
+        }
     };
 
 }
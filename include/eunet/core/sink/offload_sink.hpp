@@ -0,0 +1,55 @@
+#ifndef INCLUDE_EUNET_CORE_SINK_OFFLOAD_SINK
+#define INCLUDE_EUNET_CORE_SINK_OFFLOAD_SINK
+
+#include <atomic>
+#include <memory>
+
+#include "eunet/core/sink.hpp"
+#include "eunet/platform/scheduler.hpp"
+
+namespace core::sink
+{
+    /**
+     * @brief 把内层 Sink 的处理卸载到调度器上
+     *
+     * emit 线程只负责拷贝快照并投递，格式化、聚合等耗时处理在调度器 worker 上执行。
+     * 同一个 OffloadSink 的事件经由 Strand 串行处理，内层 Sink 看到的顺序与 emit 顺序一致，
+     * 因此内层 Sink 无需额外的线程安全保证。默认以低优先级运行，不与 IO 续体争抢 worker。
+     */
+    class OffloadSink : public IEventSink
+    {
+    private:
+        std::shared_ptr<IEventSink> inner;
+        platform::sched::Strand strand;
+        std::atomic<size_t> forwarded{0};
+
+    public:
+        OffloadSink(
+            std::shared_ptr<IEventSink> inner,
+            platform::sched::Scheduler &sched,
+            platform::sched::Priority prio = platform::sched::Priority::Low)
+            : inner(std::move(inner)), strand(sched, prio) {}
+
+    public:
+        void on_event(const EventSnapshot &s) override
+        {
+            strand.post(
+                [this, snap = s]
+                {
+                    inner->on_event(snap);
+                    forwarded.fetch_add(1, std::memory_order_relaxed);
+                });
+        }
+
+        /** 沿用内层 Sink 的订阅条件，不感兴趣的事件不会被投递 */
+        Interest interest() const override { return inner->interest(); }
+
+        /** 已交给内层 Sink 处理完毕的事件数 */
+        size_t processed() const noexcept { return forwarded.load(std::memory_order_relaxed); }
+
+        /** 尚未处理的事件数 */
+        size_t pending() const noexcept { return strand.pending(); }
+    };
+}
+
+#endif // INCLUDE_EUNET_CORE_SINK_OFFLOAD_SINK
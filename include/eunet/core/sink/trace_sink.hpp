@@ -0,0 +1,91 @@
+#ifndef INCLUDE_EUNET_CORE_SINK_TRACE_SINK
+#define INCLUDE_EUNET_CORE_SINK_TRACE_SINK
+
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "eunet/core/event_snapshot.hpp"
+#include "eunet/core/event_record.hpp"
+#include "eunet/core/trace_file.hpp"
+#include "eunet/core/sink.hpp"
+
+namespace core::sink
+{
+    /**
+     * @brief 把事件持续写入追踪文件的 Sink
+     *
+     * 事件压缩为 EventRecord 暂存，攒满 batch 条后写成一块，
+     * 每块写完文件即可被 TraceFile 打开；析构或 flush() 时写出剩余部分。
+     * 写入失败后不再写入，错误经 last_error() 取得。
+     */
+    class TraceSink : public IEventSink
+    {
+    public:
+        static constexpr std::size_t DEFAULT_BATCH = 1024;
+
+    private:
+        mutable std::mutex mtx;
+        TraceWriter writer;
+        std::size_t batch;
+
+        RecordArena arena;
+        std::vector<EventRecord> records;
+        std::optional<util::Error> error;
+
+    public:
+        explicit TraceSink(TraceWriter w, std::size_t batch_size = DEFAULT_BATCH)
+            : writer(std::move(w)),
+              batch(batch_size == 0 ? 1 : batch_size) {}
+
+        ~TraceSink() override { flush(); }
+
+    public:
+        void on_event(const EventSnapshot &s) override
+        {
+            std::lock_guard lock(mtx);
+            if (error)
+                return;
+
+            records.push_back(compact(s.event, arena));
+            if (records.size() >= batch)
+                flush_locked();
+        }
+
+        /** 写出暂存的事件，返回已写入文件的总条数 */
+        std::size_t flush()
+        {
+            std::lock_guard lock(mtx);
+            flush_locked();
+            return writer.size();
+        }
+
+        std::size_t written() const
+        {
+            std::lock_guard lock(mtx);
+            return writer.size();
+        }
+
+        std::optional<util::Error> last_error() const
+        {
+            std::lock_guard lock(mtx);
+            return error;
+        }
+
+    private:
+        void flush_locked()
+        {
+            if (records.empty() || error)
+                return;
+
+            auto r = writer.append(records, arena);
+            if (r.is_err())
+                error = r.unwrap_err();
+
+            records.clear();
+            arena.clear();
+        }
+    };
+}
+
+#endif // INCLUDE_EUNET_CORE_SINK_TRACE_SINK
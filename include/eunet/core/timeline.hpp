@@ -4,9 +4,15 @@
  *  Module      : core
  *
  *  Description :
- *      时间线存储与查询引擎。负责按时序存储所有 Event，并维护 FD 索引
- *      和 Type 索引，支持高效的按时间范围、按类型或按 FD 查询事件历史。
- *      线程安全。
+ *      时间线存储与查询引擎。负责按时序存储所有 Event，并维护 FD 索引、
+ *      Type 索引与会话链，支持高效的按时间范围、按类型、按 FD 或按会话
+ *      查询事件历史。各索引以压缩位图保存下标，多条件查询由位图求交完成。
+ *      内部以定长 EventRecord 分段存放，变长数据集中在各段的 RecordArena，
+ *      查询时才还原为 Event。段写满后封存为不可变段，读者经 snapshot()
+ *      取得只读快照后无锁遍历，不阻塞写入。线程安全。
+ *      开启落盘后，内存中的记录超出预算时最早的已封存段由后台线程压缩写入
+ *      文件并 mmap 回来，作为冷段留在段列表最前；索引仍覆盖全部记录，
+ *      查询透明地跨越内存段与冷段。
  *
  *  Third-Party Dependencies :
  *      None
@@ -20,16 +26,52 @@
 #ifndef INCLUDE_EUNET_CORE_TIMELINE
 #define INCLUDE_EUNET_CORE_TIMELINE
 
+#include <atomic>
+#include <climits>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 #include <unordered_map>
 #include <mutex>
+#include <span>
 
 #include "eunet/util/result.hpp"
 #include "eunet/util/error.hpp"
+#include "eunet/util/roaring_bitmap.hpp"
 #include "eunet/core/event.hpp"
+#include "eunet/core/event_record.hpp"
+#include "eunet/core/timeline_snapshot.hpp"
 
 namespace core
 {
+    /**
+     * @brief 多条件查询，未设置的条件不参与过滤
+     *
+     * types 中的类型之间取并集，其余条件之间取交集；时间范围为闭区间。
+     */
+    struct TimelineQuery
+    {
+        std::optional<int> fd;
+        std::vector<EventType> types;
+        std::optional<SessionId> session;
+        bool errors_only = false;
+        std::optional<platform::time::WallPoint> start;
+        std::optional<platform::time::WallPoint> end;
+    };
+
+    /**
+     * @brief 冷数据落盘的配置
+     */
+    struct SpillOptions
+    {
+        std::string dir;               // 冷段文件所在目录，需已存在
+        std::size_t memory_budget = 0; // 内存中记录与变长数据的字节数上限，为 0 时不落盘
+    };
+
+    class ColdStore;
+
     class Timeline
     {
     public:
@@ -40,29 +82,73 @@ namespace core
         using IdxList = std::vector<EvIdx>;
         using EvList = std::vector<Event>;
         template <typename T>
-        using QuerySet = std::unordered_map<T, IdxList>;
+        using QuerySet = std::unordered_map<T, util::RoaringBitmap>;
 
         using EvIdxResult = util::ResultV<EvIdx>;
         using EvCntResult = util::ResultV<EvCnt>;
         using EvListResult = util::ResultV<EvList>;
         using EvResult = util::ResultV<Event>;
 
+        /** 会话链：同一会话的记录经 session_next 依次相连，members 供多条件求交 */
+        struct SessionChain
+        {
+            EvIdx head;
+            EvIdx tail;
+            EvCnt count;
+            util::RoaringBitmap members;
+        };
+
+        static constexpr EvIdx NO_NEXT = static_cast<EvIdx>(-1);
+
+        static constexpr std::size_t SEGMENT_CAPACITY = 4096; // 尾段写满即封存
+        static constexpr std::size_t SNAPSHOT_SEAL_MIN = 256; // 取快照时尾段不少于此数则直接封存，否则复制
+
     private:
-        std::vector<Event> events;
+        // 已封存的段与快照共享；取快照时可能封存尾段，不改变逻辑内容，因此为 mutable
+        mutable std::shared_ptr<const SegmentList> sealed = std::make_shared<SegmentList>();
+        mutable std::shared_ptr<TimelineSegment> tail = std::make_shared<TimelineSegment>();
+        // 位图中的下标为 32 位，单个时间线最多索引 2^32 条记录
         QuerySet<int> fd_index;
         QuerySet<EventType> type_index;
+        util::RoaringBitmap error_index;
+
+        // 会话不随 fd 复用而混淆；session 为 0 的记录不入链
+        std::unordered_map<SessionId, SessionChain> session_index;
+        std::vector<EvIdx> session_next; // 按全局下标存放同会话的下一条记录
+        bool ordered = true; // 记录是否按时间戳有序，有序时 sort_by_time 无需排序
+        std::int64_t last_ts = INT64_MIN;
+        std::atomic<EvCnt> count{0};
+
+        std::uint64_t version = 0; // 内容每次变化递增
+        mutable std::shared_ptr<const SegmentList> published; // 最近一次发布的快照
+        mutable std::uint64_t published_version = UINT64_MAX;
+
+        // 落盘：已提交的段总是最早的若干内存段，写完后按提交顺序替换为冷段
+        struct Spilling
+        {
+            const TimelineSegment *seg;
+            std::size_t bytes;
+        };
+        SpillOptions spill;
+        std::vector<Spilling> spill_queue;
+        std::optional<util::Error> spill_failure; // 写入失败后停止落盘，记录留在内存中
+
         mutable std::mutex mtx;
 
+        // 最后声明、最先析构：后台线程先于其余成员停止
+        std::unique_ptr<ColdStore> cold_store;
+
     public:
-        Timeline() = default;
+        Timeline();
 
-        Timeline(const Timeline &) = default;
-        Timeline &operator=(const Timeline &) = default;
+        // 持有互斥量、原子计数与后台落盘线程，不可复制或移动；需要副本时使用 snapshot()
+        Timeline(const Timeline &) = delete;
+        Timeline &operator=(const Timeline &) = delete;
 
-        Timeline(Timeline &&) noexcept = default;
-        Timeline &operator=(Timeline &&) noexcept = default;
+        Timeline(Timeline &&) = delete;
+        Timeline &operator=(Timeline &&) = delete;
 
-        ~Timeline() = default;
+        ~Timeline();
 
     public:
         void clear();
@@ -70,6 +156,7 @@ namespace core
         EvCnt count_by_fd(int fd) const;
         EvCnt count_by_type(EventType type) const;
         EvCnt count_by_time(TimeStamp start, TimeStamp end) const;
+        EvCnt count_by_session(SessionId sid) const;
 
         bool has_type(EventType type) const noexcept;
 
@@ -79,11 +166,28 @@ namespace core
         EvIdxResult push(const Event &e);
         EvCntResult push(const std::vector<Event> &arr);
 
+        /**
+         * @brief 直接写入紧凑记录
+         *
+         * 记录中的句柄会被忽略，变长数据取自 extras 并复制进本时间线的存储区。
+         */
+        EvIdxResult push(const EventRecord &rec, const RecordExtras &extras = {});
+
+        /**
+         * @brief 整批写入已按时间戳排序的记录
+         *
+         * 批次早于现有尾部时只与尾部中重叠的部分归并，时间线保持有序。
+         */
+        EvCntResult push_sorted(std::span<const RecordRef> batch);
+
     public:
         EvCnt remove_by_fd(int fd);
         EvCnt remove_by_type(EventType type);
         EvCnt remove_by_time(TimeStamp start, TimeStamp end);
 
+        /** 只从该会话的第一条记录起重写，此前的段不受影响 */
+        EvCnt remove_by_session(SessionId sid);
+
     public:
         EvList replay_all() const;
         EvList replay_by_fd(int fd) const;
@@ -94,39 +198,207 @@ namespace core
         EvList query_by_type(EventType type) const;
         EvList query_by_time(TimeStamp start, TimeStamp end) const;
 
+        /** 沿会话链收集，耗时只与该会话的事件数有关 */
+        EvList query_by_session(SessionId sid) const;
+
         EvList query_errors() const;
 
+        /**
+         * @brief 多条件查询
+         *
+         * 在有序时间线上先二分出时间范围；范围较窄时沿基数最小的条件
+         * 在范围内逐个探测其余条件，否则从基数最小的条件起依次求交后再截取范围。
+         * 只在锁内确定下标，事件在锁外还原。
+         */
+        EvList query(const TimelineQuery &q) const;
+
+        /** 多条件计数，不还原事件 */
+        EvCnt count_matching(const TimelineQuery &q) const;
+
     public:
         EvResult latest_event() const;
         EvResult latest_by_fd(int fd) const;
         EvResult latest_by_type(EventType type) const;
 
+        /** 按下标还原单个事件，with_payload 为 false 时不复制载荷 */
+        EvResult event_at(EvIdx idx, bool with_payload = true) const;
+
+        /**
+         * @brief 记录与变长数据占用的字节数（近似）
+         *
+         * 包括会话链与冷段的解压缓存，不含冷段映像；落盘的内存预算以此计算。
+         */
+        std::size_t memory_bytes() const;
+
+    public:
+        /**
+         * @brief 开启冷数据落盘
+         *
+         * 每次封存段后检查内存占用，超过 memory_budget 时把最早的已封存段
+         * 交给后台线程，一次降到预算的四分之三以下，避免每封存一段就落盘一次。
+         * 段写入文件并映射后在锁内替换为冷段，期间查询仍使用内存中的段。
+         * 修改已落盘的历史（删除、排序、归并早于冷段的批次）时，
+         * 受影响的冷段逐段解码、重新编码后同步写回，不在内存中累积；
+         * 未受影响的冷段原样保留，只为下标变化的记录重建索引。
+         */
+        util::ResultV<void> enable_spill(SpillOptions opts);
+
+        /** 等待已提交的落盘全部完成，不得在持有本对象锁的回调中调用 */
+        void flush_spill();
+
+        /** 已落盘的记录数，这些记录的下标位于最前 */
+        EvCnt cold_size() const;
+
+        /** 冷段映像的总字节数，即落盘文件的大小 */
+        std::size_t disk_bytes() const;
+
+        /** 最近一次落盘失败的原因；失败后不再落盘 */
+        std::optional<util::Error> spill_error() const;
+
+        /**
+         * @brief 取得当前内容的只读快照
+         *
+         * 只在发布段列表时短暂加锁，之后对快照的遍历与查询均不加锁，
+         * 不会阻塞写入；内容未变化时重复调用返回同一版本。
+         */
+        TimelineSnapshot snapshot() const;
+
     private:
-        EvList query_by_fd_locked(int fd) const;
-        EvList query_by_type_locked(EventType type) const;
-        EvList query_by_time_locked(TimeStamp start, TimeStamp end) const;
+        template <typename T>
+        EvList query_indexed(const QuerySet<T> &index, const T &key) const
+        {
+            IdxList idxs;
+            TimelineSnapshot snap;
+            {
+                std::lock_guard lock(mtx);
+                auto it = index.find(key);
+                if (it == index.end())
+                    return {};
+                idxs.reserve(it->second.cardinality());
+                it->second.for_each([&](std::uint32_t idx)
+                                    { idxs.push_back(idx); });
+                snap = snapshot_locked();
+            }
+
+            // 还原在锁外进行
+            return snap.materialize(idxs);
+        }
 
     private:
-        void rebuild_indexes_locked(const std::vector<Event> &arr);
+        /** 内存中的记录，调用方保证 idx >= sealed->cold_total */
+        RecordRef ref_locked(EvIdx idx) const noexcept;
 
-        template <typename Pred>
-        EvCnt remove_if_locked(Pred pred)
+        /** 任意下标的时间戳与事件，冷段中的记录需从最近的解码起点解码 */
+        std::int64_t ts_locked(EvIdx idx) const noexcept;
+        Event event_locked(EvIdx idx, bool with_payload = true) const;
+
+        EvIdx append_locked(const EventRecord &rec);
+        EvIdx append_ref_locked(const RecordRef &ref);
+
+        /** 为下一个下标上的记录建立索引与会话链，不存放记录本身 */
+        EvIdx index_locked(const EventRecord &rec);
+        void seal_tail_locked() const;
+        TimelineSnapshot snapshot_locked() const;
+        void truncate_locked(EvIdx pos);
+        void truncate_indexes_locked(EvIdx pos);
+
+        /** 丢弃 pos 及之后的记录，再依次追加 refs（refs 可以指向被丢弃的段） */
+        void rewrite_from_locked(EvIdx pos, std::span<const RecordRef> refs);
+
+        void truncate_sessions_locked(EvIdx pos);
+
+        /**
+         * @brief 从 pos 起按顺序写回记录
+         *
+         * 原冷段区域内的记录攒满一段即重新编码落盘，其后的记录追加到内存。
+         */
+        class Rewriter;
+
+        /** 删除冷段中从 first 起满足 pred 的记录，first 本身满足 pred */
+        EvCnt remove_cold_locked(const std::function<bool(const EventRecord &)> &pred, EvIdx first);
+
+        /** 冷段中从 from 起第一条满足 pred 的下标，没有时返回 cold_total */
+        EvIdx find_cold_locked(const std::function<bool(const EventRecord &)> &pred, EvIdx from) const;
+
+        /** 含冷段时的排序：段内先排序，再逐段归并写回 */
+        void sort_cold_locked();
+
+        /** 已排序的批次与 pos（位于冷段中）起的记录归并写回 */
+        void merge_cold_locked(EvIdx pos, std::span<const RecordRef> batch);
+
+        std::size_t hot_bytes_locked() const;
+        std::size_t memory_bytes_locked() const;
+
+        /** 内存超出预算时把最早的已封存段提交给后台写入 */
+        void spill_locked();
+
+        /** 后台写入完成：段仍是最早的内存段时替换为冷段 */
+        void on_spilled(const std::shared_ptr<const TimelineSegment> &seg,
+                        util::ResultV<std::shared_ptr<const ColdSegment>> &&res);
+
+        /** 有序时间线上第一条 ts >= ts_ns / ts > ts_ns 的下标 */
+        EvIdx lower_bound_locked(std::int64_t ts_ns) const;
+        EvIdx upper_bound_locked(std::int64_t ts_ns) const;
+
+        /** 查询计划的执行：out 非空时收集命中下标，返回命中数 */
+        EvCnt select_locked(const TimelineQuery &q, IdxList *out) const;
+
+        /** 从全局下标 from 起依次访问记录，调用方保证 from 起的记录都在内存中 */
+        template <typename Fn>
+        void for_each_locked(Fn &&fn, EvIdx from = 0) const
         {
-            EvCnt removed = 0;
+            for (std::size_t i = 0; i < sealed->segments.size(); ++i)
+            {
+                const auto &seg = sealed->segments[i];
+                std::size_t start = sealed->starts[i];
+                if (start + seg->records.size() <= from)
+                    continue;
 
-            std::vector<Event> new_events;
-            new_events.reserve(events.size());
+                for (std::size_t j = from > start ? from - start : 0; j < seg->records.size(); ++j)
+                    fn(RecordRef{&seg->records[j], &seg->arena});
+            }
 
-            for (auto &e : events)
+            std::size_t start = sealed->total;
+            for (std::size_t j = from > start ? from - start : 0; j < tail->records.size(); ++j)
+                fn(RecordRef{&tail->records[j], &tail->arena});
+        }
+
+        template <typename Pred>
+        EvCnt remove_if_locked(Pred pred, EvIdx from = 0)
+        {
+            // 命中落在冷段中时逐段重写冷段，不把冷段解压回内存
+            if (from < sealed->cold_total)
             {
-                if (pred(e))
-                    ++removed;
-                else
-                    new_events.push_back(std::move(e));
+                EvIdx hit = find_cold_locked(pred, from);
+                if (hit < sealed->cold_total)
+                    return remove_cold_locked(pred, hit);
+                from = sealed->cold_total;
             }
 
-            rebuild_indexes_locked(new_events);
-            events.swap(new_events);
+            // 从第一条被删除的记录起重写，此前的段原样保留并继续与旧快照共享
+            constexpr EvIdx NONE = static_cast<EvIdx>(-1);
+            EvIdx idx = from, first = NONE;
+            std::vector<RecordRef> kept;
+
+            for_each_locked(
+                [&](const RecordRef &ref)
+                {
+                    if (pred(*ref.rec))
+                    {
+                        if (first == NONE)
+                            first = idx;
+                    }
+                    else if (first != NONE)
+                        kept.push_back(ref);
+                    ++idx;
+                },
+                from);
+
+            if (first == NONE)
+                return 0;
+
+            EvCnt removed = idx - first - kept.size();
+            rewrite_from_locked(first, kept);
             return removed;
         }
 
@@ -0,0 +1,204 @@
+/*
+ * ============================================================================
+ *  File Name   : timeline_snapshot.hpp
+ *  Module      : core
+ *
+ *  Description :
+ *      Timeline 的分段存储与只读快照。记录按段存放，段一经封存即不可变，
+ *      以 shared_ptr 在多个版本的段列表之间共享。读者持有某一版本的段列表
+ *      即可在不加锁的情况下遍历，写入方继续追加尾段或发布新的段列表，
+ *      旧版本在最后一个读者释放后自动回收。
+ *      落盘后的段以 ColdSegment 的形式排在段列表最前，全局下标与内存中的段
+ *      连续编号，快照上的查询同时覆盖两者。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_CORE_TIMELINE_SNAPSHOT
+#define INCLUDE_EUNET_CORE_TIMELINE_SNAPSHOT
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "eunet/util/result.hpp"
+#include "eunet/core/event.hpp"
+#include "eunet/core/event_record.hpp"
+
+namespace core
+{
+    class ColdSegment;
+    struct TimelineQuery;
+
+    /**
+     * @brief 一段连续的记录及其变长数据
+     */
+    struct TimelineSegment
+    {
+        std::vector<EventRecord> records;
+        RecordArena arena;
+    };
+
+    /**
+     * @brief 某一版本的段列表，发布后不再修改
+     */
+    struct SegmentList
+    {
+        // 已落盘的冷段排在最前，之后是内存中的段
+        std::vector<std::shared_ptr<const ColdSegment>> cold;
+        std::vector<std::size_t> cold_starts;
+        std::size_t cold_total = 0; // 冷段中的记录数，即第一个内存段的全局下标
+
+        std::vector<std::shared_ptr<const TimelineSegment>> segments;
+        std::vector<std::size_t> starts; // 每段首条记录的全局下标
+        std::size_t total = 0;
+
+        void append(std::shared_ptr<const TimelineSegment> seg);
+
+        /** 追加冷段，须在追加任何内存段之前 */
+        void append_cold(std::shared_ptr<const ColdSegment> seg);
+
+        /** 按全局下标定位内存中的记录，调用方保证 cold_total <= idx < total */
+        RecordRef at(std::size_t idx) const noexcept;
+
+        /** 全局下标所在的冷段序号，调用方保证 idx < cold_total */
+        std::size_t cold_index(std::size_t idx) const noexcept;
+
+        /** 第 i 个冷段的记录数 */
+        std::size_t cold_count(std::size_t i) const noexcept
+        {
+            return (i + 1 < cold_starts.size() ? cold_starts[i + 1] : cold_total) - cold_starts[i];
+        }
+
+        /** 按全局下标还原冷段中的记录，调用方保证 idx < cold_total */
+        Event cold_event(std::size_t idx, bool with_payload = true) const;
+        std::int64_t cold_ts(std::size_t idx) const noexcept;
+
+        /**
+         * @brief 冷段中第一条 ts >= ts_ns 的全局下标，没有时返回 cold_total
+         *
+         * 只适用于有序的时间线：先按各段的时间范围定位段，再由段内的解码起点查找。
+         */
+        std::size_t cold_lower_bound(std::int64_t ts_ns) const;
+    };
+
+    /**
+     * @brief Timeline 的只读快照
+     *
+     * 快照只持有不可变的段，构造后不需要任何锁，可跨线程长期持有；
+     * 之后写入 Timeline 的事件不会出现在快照中。
+     */
+    class TimelineSnapshot
+    {
+    public:
+        using EvIdx = std::size_t;
+        using EvCnt = std::size_t;
+        using TimeStamp = platform::time::WallPoint;
+        using EvList = std::vector<Event>;
+        using EvResult = util::ResultV<Event>;
+
+    private:
+        std::shared_ptr<const SegmentList> m_list;
+        bool m_ordered = true; // 有序时按时间查询走二分
+
+    public:
+        TimelineSnapshot();
+        TimelineSnapshot(std::shared_ptr<const SegmentList> list, bool ordered) noexcept;
+
+    public:
+        EvCnt size() const noexcept { return m_list->total; }
+        bool empty() const noexcept { return m_list->total == 0; }
+
+        /** 内存中的段数 */
+        std::size_t segment_count() const noexcept { return m_list->segments.size(); }
+
+        /** 已落盘的记录数，下标小于它的记录位于冷段 */
+        EvCnt cold_size() const noexcept { return m_list->cold_total; }
+
+        /** 内存中的记录，调用方保证 cold_size() <= idx < size() */
+        RecordRef ref_at(EvIdx idx) const noexcept { return m_list->at(idx); }
+
+        /**
+         * @brief 从下标 from 起依次访问记录：fn(const EventRecord &, const RecordArena &)
+         *
+         * 冷段逐段解压为临时段后访问，传给 fn 的引用只在本次调用内有效。
+         */
+        template <typename Fn>
+        void for_each(Fn &&fn, EvIdx from = 0) const
+        {
+            for (std::size_t i = 0; i < m_list->cold.size(); ++i)
+            {
+                std::size_t start = m_list->cold_starts[i];
+                if (start + m_list->cold_count(i) <= from)
+                    continue;
+
+                auto seg = thaw(i);
+                for (std::size_t j = from > start ? from - start : 0; j < seg->records.size(); ++j)
+                    fn(seg->records[j], seg->arena);
+            }
+
+            for (std::size_t i = 0; i < m_list->segments.size(); ++i)
+            {
+                const auto &seg = m_list->segments[i];
+                std::size_t start = m_list->starts[i];
+                if (start + seg->records.size() <= from)
+                    continue;
+
+                for (std::size_t j = from > start ? from - start : 0; j < seg->records.size(); ++j)
+                    fn(seg->records[j], seg->arena);
+            }
+        }
+
+    public:
+        EvResult event_at(EvIdx idx, bool with_payload = true) const;
+        EvResult latest_event() const;
+
+        EvCnt count_by_time(TimeStamp start, TimeStamp end) const;
+
+        EvList replay_all() const;
+        EvList replay_since(TimeStamp ts) const;
+
+        EvList query_by_fd(int fd) const;
+        EvList query_by_type(EventType type) const;
+        EvList query_by_time(TimeStamp start, TimeStamp end) const;
+        EvList query_errors() const;
+
+        /** 按下标列表还原事件，越界的下标被跳过 */
+        EvList materialize(const std::vector<EvIdx> &idxs) const;
+
+    private:
+        /** 把第 i 个冷段解压为内存段 */
+        std::shared_ptr<const TimelineSegment> thaw(std::size_t i) const;
+
+        EvIdx lower_bound(std::int64_t ts_ns) const;
+        EvIdx upper_bound(std::int64_t ts_ns) const;
+
+        /** 还原下标区间 [first, last) 的事件 */
+        EvList range(EvIdx first, EvIdx last) const;
+
+        /** 冷段上的查询结果依次追加到 out，各段先以段头的摘要剪枝 */
+        void query_cold(const TimelineQuery &q, EvList &out) const;
+
+        /** 冷段经 query_cold 按 q 过滤，内存中的段逐条按 pred 过滤 */
+        template <typename Pred>
+        EvList collect_if(const TimelineQuery &q, Pred pred) const
+        {
+            EvList result;
+            query_cold(q, result);
+            for (const auto &seg : m_list->segments)
+                for (const auto &rec : seg->records)
+                    if (pred(rec))
+                        result.push_back(core::materialize(rec, seg->arena));
+            return result;
+        }
+    };
+}
+
+#endif // INCLUDE_EUNET_CORE_TIMELINE_SNAPSHOT
@@ -0,0 +1,296 @@
+/*
+ * ============================================================================
+ *  File Name   : trace_file.hpp
+ *  Module      : core
+ *
+ *  Description :
+ *      二进制事件追踪文件。Timeline 的记录以只追加的方式分块写入文件，
+ *      每块由定长 EventRecord 数组与其变长数据的只读映像 (ArenaImage) 组成，
+ *      文件末尾是块索引与尾部标记。读取时整体 mmap，记录与变长数据
+ *      均在映射内存上原地访问，打开只读取索引，与文件大小无关。
+ *
+ *      文件布局（均按 8 字节对齐，字节序为写入端的本机字节序）：
+ *          FileHeader
+ *          Chunk 0 : ChunkHeader | EventRecord[count] | ArenaImage
+ *          Chunk 1 : ...
+ *          IndexEntry[chunk_count]
+ *          Trailer
+ *      每次追加都从旧索引处覆盖写入新块，再重写索引与尾部，已写入的块不再改动。
+ *      尾部缺失或损坏（如写入中途退出）时按块头顺序扫描恢复。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_CORE_TRACE_FILE
+#define INCLUDE_EUNET_CORE_TRACE_FILE
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/platform/fd.hpp"
+#include "eunet/platform/time.hpp"
+#include "eunet/core/event.hpp"
+#include "eunet/core/event_record.hpp"
+#include "eunet/core/timeline.hpp"
+#include "eunet/core/timeline_snapshot.hpp"
+
+namespace core
+{
+    namespace trace
+    {
+        inline constexpr char FILE_MAGIC[8] = {'E', 'U', 'N', 'T', 'R', 'A', 'C', 'E'};
+        inline constexpr char TRAILER_MAGIC[8] = {'E', 'U', 'N', 'T', 'E', 'N', 'D', '\0'};
+        inline constexpr std::uint32_t CHUNK_MAGIC = 0x4B4E4843; // "CHNK"
+        inline constexpr std::uint32_t VERSION = 1;
+
+        enum Flags : std::uint32_t
+        {
+            ORDERED = 1u << 0, // 块内（或整个文件内）记录按时间戳有序
+        };
+
+        struct FileHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t record_size;    // sizeof(EventRecord)，不一致时拒绝打开
+            std::int64_t anchor_event_ns; // 写入端的墙上时间锚点，供离线换算时间戳
+            std::int64_t anchor_wall_ns;  // 自 epoch 起的纳秒
+            std::uint64_t reserved[4];
+        };
+
+        struct ChunkHeader
+        {
+            std::uint32_t magic;
+            std::uint32_t flags;
+            std::uint64_t count; // 记录条数
+            std::uint64_t size;  // 整块字节数（含块头）
+            std::int64_t min_ts;
+            std::int64_t max_ts;
+            std::uint64_t reserved;
+        };
+
+        struct IndexEntry
+        {
+            std::uint64_t offset; // 块头在文件中的偏移
+            std::uint64_t first;  // 块内首条记录的全局下标
+            std::uint64_t count;
+            std::int64_t min_ts;
+            std::int64_t max_ts;
+            std::uint32_t flags;
+            std::uint32_t reserved;
+        };
+
+        struct Trailer
+        {
+            std::uint64_t index_offset;
+            std::uint64_t chunk_count;
+            std::uint64_t total;
+            std::uint32_t flags;
+            std::uint32_t version;
+            char magic[8];
+        };
+
+        static_assert(sizeof(FileHeader) % 8 == 0);
+        static_assert(sizeof(ChunkHeader) % 8 == 0);
+        static_assert(sizeof(EventRecord) % 8 == 0);
+    }
+
+    /**
+     * @brief 追踪文件写入器
+     *
+     * 每次 append 写成一个或多个块（每块至多 CHUNK_CAPACITY 条），写完即更新索引，
+     * 文件在任意两次 append 之间都可被 TraceFile 打开。非线程安全。
+     */
+    class TraceWriter
+    {
+    public:
+        using EvIdx = std::size_t;
+        using EvCnt = std::size_t;
+        using EvCntResult = util::ResultV<EvCnt>;
+
+        static constexpr std::size_t CHUNK_CAPACITY = Timeline::SEGMENT_CAPACITY;
+
+    private:
+        platform::fd::Fd m_fd;
+        std::string m_path;
+        platform::time::WallAnchor m_anchor;
+
+        std::vector<trace::IndexEntry> m_index;
+        std::uint64_t m_end = 0; // 最后一块之后的偏移，即索引的写入位置
+        EvCnt m_total = 0;
+        bool m_ordered = true;
+        std::vector<std::byte> m_buf; // 组装块的缓冲区，跨调用复用
+
+    public:
+        /**
+         * @brief 创建（或截断）追踪文件并写入文件头
+         *
+         * 时间戳按进程级锚点换算，与本进程的 Timeline 一致。
+         */
+        static util::ResultV<TraceWriter> create(const std::string &path);
+
+        TraceWriter(const TraceWriter &) = delete;
+        TraceWriter &operator=(const TraceWriter &) = delete;
+
+        TraceWriter(TraceWriter &&) noexcept = default;
+        TraceWriter &operator=(TraceWriter &&) noexcept = default;
+
+    public:
+        /** 追加一批记录，句柄解析自 arena */
+        EvCntResult append(std::span<const EventRecord> records, const RecordArena &arena);
+
+        /** 追加快照中从 from 起的全部记录，变长数据只复制被引用的部分 */
+        EvCntResult append(const TimelineSnapshot &snap, EvIdx from = 0);
+
+        EvCnt size() const noexcept { return m_total; }
+        std::size_t chunk_count() const noexcept { return m_index.size(); }
+        const std::string &path() const noexcept { return m_path; }
+
+    private:
+        TraceWriter(platform::fd::Fd fd, std::string path) noexcept;
+
+        EvCntResult write_chunk(std::span<const EventRecord> records, const RecordArena &arena);
+
+        /** 在 m_end 处重写索引与尾部，并截去其后的旧内容 */
+        util::ResultV<void> write_index();
+        util::ResultV<void> write_at(std::uint64_t offset, std::span<const std::byte> data);
+    };
+
+    /**
+     * @brief 以 mmap 打开的只读追踪文件
+     *
+     * 打开时只校验文件头、尾部与块索引，不读取任何记录；查询直接在映射内存上
+     * 扫描定长记录，按时间的条件先以块的时间范围剪枝，块内有序时再二分。
+     * 只读且不可变，构造后可被多个线程同时查询。
+     */
+    class TraceFile
+    {
+    public:
+        using EvIdx = std::size_t;
+        using EvCnt = std::size_t;
+        using TimeStamp = platform::time::WallPoint;
+        using IdxList = std::vector<EvIdx>;
+        using EvList = std::vector<Event>;
+        using EvResult = util::ResultV<Event>;
+
+        struct Chunk
+        {
+            const EventRecord *records = nullptr;
+            std::size_t count = 0;
+            EvIdx first = 0;
+            std::int64_t min_ts = 0;
+            std::int64_t max_ts = 0;
+            bool ordered = false;
+            ArenaImage arena;
+        };
+
+        struct Ref
+        {
+            const EventRecord *rec;
+            const ArenaImage *arena;
+        };
+
+    private:
+        const std::byte *m_data = nullptr;
+        std::size_t m_bytes = 0;
+
+        std::vector<Chunk> m_chunks;
+        EvCnt m_total = 0;
+        bool m_ordered = true;
+        bool m_recovered = false;
+
+        platform::time::WallAnchor m_anchor; // 写入端锚点
+        std::int64_t m_shift = 0;            // 写入端事件时钟 -> 本进程事件时钟
+
+    public:
+        /** 映射并校验文件；尾部无效时顺序扫描块头恢复 */
+        static util::ResultV<TraceFile> open(const std::string &path);
+
+        TraceFile() = default;
+        ~TraceFile();
+
+        TraceFile(const TraceFile &) = delete;
+        TraceFile &operator=(const TraceFile &) = delete;
+
+        TraceFile(TraceFile &&other) noexcept;
+        TraceFile &operator=(TraceFile &&other) noexcept;
+
+    public:
+        EvCnt size() const noexcept { return m_total; }
+        bool empty() const noexcept { return m_total == 0; }
+        bool ordered() const noexcept { return m_ordered; }
+        std::size_t chunk_count() const noexcept { return m_chunks.size(); }
+        std::size_t file_bytes() const noexcept { return m_bytes; }
+
+        /** 尾部缺失、经扫描块头打开时为 true */
+        bool recovered() const noexcept { return m_recovered; }
+
+        /** 写入端的墙上时间锚点，记录中的时间戳需以它换算 */
+        const platform::time::WallAnchor &anchor() const noexcept { return m_anchor; }
+
+        /** 把记录中的时间戳换算到本进程的事件时钟，对应的墙上时间不变 */
+        std::int64_t local_ts(std::int64_t file_ns) const noexcept { return file_ns + m_shift; }
+
+        /** 调用方保证 idx < size() */
+        Ref ref_at(EvIdx idx) const noexcept;
+
+        /** 依次访问每条记录：fn(const EventRecord &, const ArenaImage &) */
+        template <typename Fn>
+        void for_each(Fn &&fn) const
+        {
+            for (const auto &c : m_chunks)
+                for (std::size_t i = 0; i < c.count; ++i)
+                    fn(c.records[i], c.arena);
+        }
+
+    public:
+        EvResult event_at(EvIdx idx, bool with_payload = true) const;
+        EvResult latest_event() const;
+
+        EvCnt count_by_fd(int fd) const;
+        EvCnt count_by_type(EventType type) const;
+        EvCnt count_by_time(TimeStamp start, TimeStamp end) const;
+        EvCnt count_by_session(SessionId sid) const;
+
+        EvList replay_all() const;
+
+        EvList query_by_fd(int fd) const;
+        EvList query_by_type(EventType type) const;
+        EvList query_by_time(TimeStamp start, TimeStamp end) const;
+        EvList query_by_session(SessionId sid) const;
+        EvList query_errors() const;
+
+        /** 与 Timeline::query 语义相同的多条件查询 */
+        EvList query(const TimelineQuery &q) const;
+        EvCnt count_matching(const TimelineQuery &q) const;
+
+        /** 命中下标，不还原事件 */
+        IdxList select(const TimelineQuery &q) const;
+
+        /** 按下标列表还原事件，越界的下标被跳过 */
+        EvList materialize(const IdxList &idxs) const;
+
+    private:
+        void unmap() noexcept;
+
+        /** 还原单条记录，时间戳换算到本进程的事件时钟 */
+        Event restore(const EventRecord &rec, const ArenaImage &arena) const;
+
+        /** 对满足 q 的记录依次调用 fn(EvIdx, const EventRecord &, const ArenaImage &) */
+        template <typename Fn>
+        void scan(const TimelineQuery &q, Fn &&fn) const;
+    };
+}
+
+#endif // INCLUDE_EUNET_CORE_TRACE_FILE
@@ -0,0 +1,114 @@
+/*
+ * ============================================================================
+ *  File Name   : bench_scenario.hpp
+ *  Module      : net/http
+ *
+ *  Description :
+ *      闭环并发压测场景（wrk 风格）。N 条 keep-alive 连接分布在 T 个线程上，
+ *      每条连接收到响应后立即发送下一个请求，持续 D 时长。
+ *      每个线程运行自己的 EventLoop，请求走 HTTPClient 的协程路径，
+ *      事件照常上报 Orchestrator，因此统计结果包含可观测性开销。
+ *
+ *  Third-Party Dependencies :
+ *      - fmt
+ *          Usage     : 格式化压测报告
+ *          License   : MIT License
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_NET_BENCH_SCENARIO
+#define INCLUDE_EUNET_NET_BENCH_SCENARIO
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "eunet/util/error.hpp"
+#include "eunet/util/hdr_histogram.hpp"
+#include "eunet/core/scenario.hpp"
+#include "eunet/net/http_scenario.hpp"
+
+namespace net::http
+{
+    struct BenchConfig
+    {
+        std::string url;
+        std::size_t connections = 10; // 总连接数 (-c)
+        std::size_t threads = 2;      // 线程数 (-t)，多于连接数时按连接数截断
+        std::chrono::milliseconds duration{10000}; // 持续时长 (-d)
+        int timeout_ms = 2000;
+    };
+
+    /**
+     * @brief 压测报告
+     *
+     * 延迟单位为微秒，从写出请求前到完整读到响应为止。
+     */
+    struct BenchReport
+    {
+        std::uint64_t requests = 0;  // 收到完整响应的请求数
+        std::uint64_t bytes = 0;     // 线上接收的总字节数
+        std::uint64_t non_2xx = 0;   // 状态码不在 2xx 的响应数
+        std::uint64_t connects = 0;  // 成功建立的连接数（keep-alive 复用时接近 -c）
+        std::uint64_t errors = 0;
+        std::map<util::ErrorCategory, std::uint64_t> errors_by_category;
+
+        double elapsed_s = 0.0;
+        util::HdrHistogram latency{1, 60'000'000, 3};
+
+        double requests_per_sec() const noexcept { return elapsed_s > 0 ? requests / elapsed_s : 0.0; }
+        double bytes_per_sec() const noexcept { return elapsed_s > 0 ? bytes / elapsed_s : 0.0; }
+
+        /** 合并另一个线程的报告（耗时取最大值） */
+        void merge(const BenchReport &other);
+    };
+
+    /** 将报告格式化为 wrk 风格的多行文本 */
+    std::string format_report(const BenchConfig &cfg, const BenchReport &r);
+
+    class BenchScenario : public core::scenario::Scenario
+    {
+    private:
+        BenchConfig m_cfg;
+        HttpConfig m_target;
+        BenchReport m_report;
+
+    public:
+        explicit BenchScenario(BenchConfig cfg);
+
+        /** 启动 threads 个线程，各自运行 EventLoop 并驱动分到的连接，全部结束后返回 */
+        util::ResultV<void> run(
+            core::Orchestrator &orch) override;
+
+        /** 在给定 loop 上驱动全部连接（单线程） */
+        util::Task<util::ResultV<void>> run_async(
+            core::Orchestrator &orch,
+            platform::reactor::EventLoop &loop) override;
+
+        const BenchReport &report() const noexcept { return m_report; }
+        const BenchConfig &config() const noexcept { return m_cfg; }
+
+    private:
+        util::ResultV<void> validate() const;
+
+        util::Task<void> drive(
+            core::Orchestrator &orch,
+            platform::reactor::EventLoop &loop,
+            platform::time::MonoPoint deadline,
+            BenchReport &rep);
+
+        // 在当前线程上创建 EventLoop 并驱动 conns 条连接直到 deadline
+        util::ResultV<void> run_thread(
+            core::Orchestrator &orch,
+            std::size_t conns,
+            platform::time::MonoPoint deadline,
+            BenchReport &rep);
+    };
+}
+
+#endif // INCLUDE_EUNET_NET_BENCH_SCENARIO
@@ -20,7 +20,9 @@
 #define INCLUDE_EUNET_NET_CONNECTION_TCP_CONNECTION
 
 #include "eunet/util/byte_buffer.hpp"
+#include "eunet/util/task.hpp"
 #include "eunet/platform/time.hpp"
+#include "eunet/platform/event_loop.hpp"
 #include "eunet/platform/net/endpoint.hpp"
 #include "eunet/platform/socket/tcp_socket.hpp"
 #include "eunet/net/connection.hpp"
@@ -36,11 +38,28 @@ namespace net::tcp
         util::ByteBuffer m_in;
         util::ByteBuffer m_out;
 
+        // 曾以 async_* 在其上等待过的 reactor，fd 在其中保持注册直到关闭
+        platform::reactor::EventLoop *m_loop = nullptr;
+
     public:
         static util::ResultV<TCPConnection>
         connect(const platform::net::Endpoint &ep,
                 platform::poller::Poller &poller,
-                int timeout_ms = -1);
+                int timeout_ms = -1,
+                const platform::net::SocketOptions &opts = {});
+
+        /**
+         * @brief 协程版连接
+         *
+         * 套接字设为非阻塞并挂在 loop 上等待连接完成，
+         * 之后该连接只应使用 async_* 接口并在 loop 线程内访问。
+         * 参数按值传入，协程帧持有副本。
+         */
+        static util::Task<util::ResultV<TCPConnection>>
+        async_connect(platform::net::Endpoint ep,
+                      platform::reactor::EventLoop &loop,
+                      int timeout_ms = -1,
+                      platform::net::SocketOptions opts = {});
 
         static TCPConnection
         from_accepted_socket(platform::net::TCPSocket &&sock);
@@ -51,8 +70,11 @@ namespace net::tcp
         TCPConnection(const TCPConnection &) = delete;
         TCPConnection &operator=(const TCPConnection &) = delete;
 
-        TCPConnection(TCPConnection &&) noexcept = default;
-        TCPConnection &operator=(TCPConnection &&) noexcept = default;
+        TCPConnection(TCPConnection &&other) noexcept;
+        TCPConnection &operator=(TCPConnection &&) = delete; // 套接字持有 Poller 引用，不可重新赋值
+
+        /** 使用过 async_* 的连接需在 loop 线程内、loop 销毁前关闭或析构 */
+        ~TCPConnection() override;
 
     public:
         platform::fd::FdView fd() const noexcept override;
@@ -71,6 +93,25 @@ namespace net::tcp
         bool has_pending_output() const noexcept override;
         util::ResultV<void> flush() override;
 
+    public:
+        /**
+         * @brief 协程版读取：读到至少一个字节后返回，暂无数据时挂起等待可读
+         */
+        util::Task<IOResult>
+        async_read(util::ByteBuffer &buf,
+                   platform::reactor::EventLoop &loop,
+                   int timeout_ms = -1);
+
+        /**
+         * @brief 协程版写入：先写出积压的 out_buffer，再写完 buf 全部内容
+         *
+         * 推迟的 Fast Open 连接由首次写入发起，返回前等待握手确认。
+         */
+        util::Task<IOResult>
+        async_write(util::ByteBuffer &buf,
+                    platform::reactor::EventLoop &loop,
+                    int timeout_ms = -1);
+
     public:
         util::ByteBuffer &in_buffer() noexcept { return m_in; }
         util::ByteBuffer &out_buffer() noexcept { return m_out; }
@@ -22,7 +22,9 @@
 #include "eunet/util/result.hpp"
 #include "eunet/util/error.hpp"
 #include "eunet/util/byte_buffer.hpp"
+#include "eunet/util/task.hpp"
 #include "eunet/platform/time.hpp"
+#include "eunet/platform/event_loop.hpp"
 #include "eunet/platform/net/endpoint.hpp"
 #include "eunet/platform/socket/udp_socket.hpp"
 #include "eunet/net/connection.hpp"
@@ -38,12 +40,25 @@ namespace net::udp
         util::ByteBuffer m_in;
         util::ByteBuffer m_out;
 
+        // 曾以 async_* 在其上等待过的 reactor，fd 在其中保持注册直到关闭
+        platform::reactor::EventLoop *m_loop = nullptr;
+
     public:
         static util::ResultV<UDPConnection>
         connect(const platform::net::Endpoint &ep,
                 platform::poller::Poller &poller,
                 int timeout_ms = -1);
 
+        /**
+         * @brief 协程版连接
+         *
+         * UDP connect 只设置默认对端，不会挂起；
+         * 提供该接口是为了让场景协程统一使用 co_await 建连。
+         */
+        static util::Task<util::ResultV<UDPConnection>>
+        async_connect(platform::net::Endpoint ep,
+                      platform::reactor::EventLoop &loop);
+
         static UDPConnection
         from_accepted_socket(platform::net::UDPSocket &&sock);
 
@@ -53,8 +68,11 @@ namespace net::udp
         UDPConnection(const UDPConnection &) = delete;
         UDPConnection &operator=(const UDPConnection &) = delete;
 
-        UDPConnection(UDPConnection &&) noexcept = default;
-        UDPConnection &operator=(UDPConnection &&) noexcept = default;
+        UDPConnection(UDPConnection &&other) noexcept;
+        UDPConnection &operator=(UDPConnection &&) = delete; // 套接字持有 Poller 引用，不可重新赋值
+
+        /** 使用过 async_* 的连接需在 loop 线程内、loop 销毁前关闭或析构 */
+        ~UDPConnection() override;
 
     public:
         platform::fd::FdView fd() const noexcept override;
@@ -73,6 +91,19 @@ namespace net::udp
         bool has_pending_output() const noexcept override;
         util::ResultV<void> flush() override;
 
+    public:
+        /** 协程版读取：收到一个数据报后返回，暂无数据时挂起等待可读 */
+        util::Task<IOResult>
+        async_read(util::ByteBuffer &buf,
+                   platform::reactor::EventLoop &loop,
+                   int timeout_ms = -1);
+
+        /** 协程版写入：先发送积压的 out_buffer，再发送 buf */
+        util::Task<IOResult>
+        async_write(util::ByteBuffer &buf,
+                    platform::reactor::EventLoop &loop,
+                    int timeout_ms = -1);
+
     public:
         util::ByteBuffer &in_buffer() noexcept { return m_in; }
         util::ByteBuffer &out_buffer() noexcept { return m_out; }
@@ -23,6 +23,9 @@
 #include <string>
 #include <map>
 
+#include "eunet/platform/net/socket_options.hpp"
+#include "eunet/core/event.hpp"
+
 namespace net::http
 {
     struct HttpRequest
@@ -33,6 +36,10 @@ namespace net::http
         std::map<std::string, std::string> headers;
         int timeout_ms = 3000;
         bool connection_close = true;
+        int tcp_info_interval_ms = 0; // TCP_INFO 周期采样间隔，0 表示关闭
+        bool kernel_timestamps = false; // 是否开启 SO_TIMESTAMPING 软件时间戳
+        platform::net::SocketOptions socket_options;
+        core::SessionId session_id = 0; // 本次请求上报的事件所属会话，0 表示不关联
     };
 }
 
@@ -6,6 +6,8 @@
  *  Description :
  *      HTTP 响应的数据结构定义。包含状态码、状态原因、响应头
  *      和响应体。提供简便的 header 查找和状态判断方法。
+ *      Timings 记录单次请求各阶段耗时（类似 curl -w 的 time_* 变量），
+ *      调用方无需订阅 Orchestrator 即可直接读取。
  *
  *  Third-Party Dependencies :
  *      None
@@ -21,9 +23,37 @@
 
 #include <string>
 #include <map>
+#include <chrono>
+
+#include "eunet/platform/time.hpp"
 
 namespace net::http
 {
+    /**
+     * @brief 单次请求的阶段耗时
+     *
+     * 各阶段首尾相接，均由 platform::time::monotonic_now() 在阶段边界打点：
+     *     dns -> connect -> request -> ttfb -> body
+     * total 为从开始解析到响应解析完成的总耗时。
+     * 复用连接的请求没有 dns / connect 阶段，二者为 0。
+     */
+    struct Timings
+    {
+        using Span = platform::time::MonoClock::duration;
+
+        Span dns{};     // 域名解析
+        Span connect{}; // TCP 握手（含套接字选项设置）
+        Span request{}; // 请求构建与发送
+        Span ttfb{};    // 请求发出到收到首个字节
+        Span body{};    // 首个字节到响应解析完成
+        Span total{};
+
+        static double ms(Span s) noexcept
+        {
+            return std::chrono::duration<double, std::milli>(s).count();
+        }
+    };
+
     struct HttpResponse
     {
         // ---------------- status ----------------
@@ -39,6 +69,13 @@ namespace net::http
         // ---------------- body ----------------
         std::string body;
 
+        // ---------------- transport ----------------
+        size_t wire_size = 0;    // 线上接收的总字节数（状态行 + 头部 + 响应体）
+        bool keep_alive = false; // 连接在响应后仍可复用
+
+        // ---------------- timings ----------------
+        Timings timings;
+
         // ---------------- helpers ----------------
         bool ok() const noexcept { return status >= 200 && status < 300; }
 
@@ -7,6 +7,8 @@
  *      HTTP 客户端实现。利用 Boost.Beast 进行 HTTP 协议的序列化与解析，
  *      利用底层的 TCPClient 进行数据传输，并负责向 Orchestrator 汇报
  *      HTTP 层的细粒度事件（如 Headers Received）。
+ *      同步路径按 Observer 策略实例化（见 observer.hpp），
+ *      协程路径只在上报完整事件的 HTTPClient 上提供。
  *
  *  Third-Party Dependencies :
  *      - Boost.Beast
@@ -28,25 +30,104 @@
 
 #include "eunet/core/orchestrator.hpp"
 #include "eunet/util/result.hpp"
+#include "eunet/util/task.hpp"
+#include "eunet/platform/event_loop.hpp"
+#include "eunet/net/observer.hpp"
 #include "eunet/net/tcp_client.hpp"
 #include "eunet/net/http/http_request.hpp"
 #include "eunet/net/http/http_response.hpp"
 
 namespace net::http
 {
-    class HTTPClient
+    /**
+     * @brief HTTP 客户端
+     *
+     * @tparam Observer 可观测性策略；NullObserver 下 get() 不构造任何事件，
+     *                  HttpResponse::timings 全为 0
+     */
+    template <ObserverPolicy Observer = FullObserver>
+    class BasicHTTPClient
     {
+    private:
+        static constexpr bool full = std::same_as<Observer, FullObserver>;
+
     public:
-        explicit HTTPClient(core::Orchestrator &orch);
+        explicit BasicHTTPClient(Observer obs = Observer{});
+
+        explicit BasicHTTPClient(core::Orchestrator &orch)
+            requires std::constructible_from<Observer, core::Orchestrator &>
+            : BasicHTTPClient(Observer(orch)) {}
 
         util::ResultV<HttpResponse> get(const HttpRequest &req);
 
+        /**
+         * @brief 协程版 GET
+         *
+         * 连接、发送与接收均挂起在 loop 上等待就绪，单个 reactor 线程
+         * 即可同时推进大量会话；上报的事件序列与 get() 一致。
+         * DNS 解析仍为同步调用。
+         *
+         * @param orch 事件汇报目标
+         * @param req 请求配置（按值传入，协程帧持有副本）
+         * @param loop 驱动本次会话的 reactor，只能在其线程内调用
+         */
+        static util::Task<util::ResultV<HttpResponse>>
+        async_get(core::Orchestrator &orch,
+                  HttpRequest req,
+                  platform::reactor::EventLoop &loop)
+            requires full;
+
+        /**
+         * @brief 协程版建连：DNS 解析并建立 TCP 连接
+         *
+         * 上报的事件与 async_get 的建连阶段一致，得到的连接可交给
+         * async_request 连续发送多个请求（keep-alive 复用）。
+         *
+         * @param timings 非空时写入 dns 与 connect 阶段耗时，需在协程结束前保持有效
+         */
+        static util::Task<util::ResultV<net::tcp::TCPConnection>>
+        async_open(core::Orchestrator &orch,
+                   HttpRequest req,
+                   platform::reactor::EventLoop &loop,
+                   Timings *timings = nullptr)
+            requires full;
+
+        /**
+         * @brief 在已建立的连接上发送一个 GET 并读取完整响应
+         *
+         * 响应允许复用（req.connection_close 为 false 且服务端未要求关闭）时
+         * 连接保持打开，HttpResponse::keep_alive 为 true；否则连接在返回前关闭。
+         * 出错时连接同样被关闭。
+         * 返回的 Timings 只包含 request / ttfb / body，total 从构建请求开始计时。
+         *
+         * @param conn 由 async_open 得到的连接，需在协程结束前保持有效
+         */
+        static util::Task<util::ResultV<HttpResponse>>
+        async_request(core::Orchestrator &orch,
+                      net::tcp::TCPConnection &conn,
+                      HttpRequest req,
+                      platform::reactor::EventLoop &loop)
+            requires full;
+
     private:
-        core::Orchestrator &orch;
-        net::tcp::TCPClient tcp;
+        Observer m_obs;
+        net::tcp::BasicTCPClient<Observer> tcp;
+        core::SessionId session = 0;
+
+        template <typename Make>
+        void emit(Make &&make);
 
-        util::ResultV<void> emit(const core::Event &e);
+        template <typename Make>
+        void emit_record(Make &&make, const core::RecordExtras &extras = {});
     };
+
+    using HTTPClient = BasicHTTPClient<FullObserver>;
+    using TimingHTTPClient = BasicHTTPClient<TimingObserver>;
+    using NullHTTPClient = BasicHTTPClient<NullObserver>;
+
+    extern template class BasicHTTPClient<FullObserver>;
+    extern template class BasicHTTPClient<TimingObserver>;
+    extern template class BasicHTTPClient<NullObserver>;
 }
 
 #endif // INCLUDE_EUNET_NET_HTTP_CLIENT
\ No newline at end of file
@@ -45,6 +45,14 @@ namespace net::http
         std::string path = "/"; // path + query
     };
 
+    /**
+     * @brief 解析 URL 为请求配置
+     *
+     * 支持 scheme://host[:port][/path?query]，缺省 scheme 为 http，
+     * 缺省端口按 scheme 选择 80 / 443，片段 (#...) 会被丢弃。
+     */
+    HttpConfig parse_http_url(std::string url);
+
     class HttpGetScenario : public core::scenario::Scenario
     {
     private:
@@ -61,6 +69,10 @@ namespace net::http
 
         util::ResultV<void> run(
             core::Orchestrator &orch) override;
+
+        util::Task<util::ResultV<void>> run_async(
+            core::Orchestrator &orch,
+            platform::reactor::EventLoop &loop) override;
     };
 }
 
@@ -0,0 +1,138 @@
+/*
+ * ============================================================================
+ *  File Name   : load_scenario.hpp
+ *  Module      : net/http
+ *
+ *  Description :
+ *      开环恒定速率压测场景。按固定间隔或泊松到达计划发起 HTTP GET，
+ *      发送节拍不受响应快慢影响；延迟从“计划发送时刻”开始计算，
+ *      从而修正闭环压测中的协同遗漏 (coordinated omission)。
+ *      区分预热与稳态阶段，稳态结果以 HDR 直方图输出百分位。
+ *
+ *  Third-Party Dependencies :
+ *      - fmt
+ *          Usage     : 格式化压测报告
+ *          License   : MIT License
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_NET_LOAD_SCENARIO
+#define INCLUDE_EUNET_NET_LOAD_SCENARIO
+
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <string>
+
+#include "eunet/util/hdr_histogram.hpp"
+#include "eunet/core/scenario.hpp"
+#include "eunet/net/http_scenario.hpp"
+
+namespace net::http
+{
+    /**
+     * @brief 请求到达模型
+     */
+    enum class Arrival
+    {
+        Fixed,   // 等间隔
+        Poisson, // 指数分布间隔，模拟大量独立用户
+    };
+
+    struct LoadConfig
+    {
+        std::string url;
+        double rate = 100.0; // 目标速率 (req/s)
+        Arrival arrival = Arrival::Fixed;
+
+        std::chrono::milliseconds warmup{1000};   // 预热阶段，不计入统计
+        std::chrono::milliseconds duration{5000}; // 稳态阶段
+
+        int timeout_ms = 3000;
+
+        // 同时在途请求上限，防止耗尽 fd；达到上限时发送被推迟，推迟部分计入延迟
+        std::size_t max_in_flight = 1024;
+
+        // 发送滞后 p99 超过该阈值即认为发生器自身已饱和
+        std::chrono::milliseconds lag_threshold{10};
+
+        std::uint64_t seed = 1; // 泊松到达的随机种子，便于复现
+    };
+
+    /**
+     * @brief 压测报告
+     *
+     * 所有直方图单位均为微秒，只统计稳态阶段计划发出的请求。
+     */
+    struct LoadReport
+    {
+        double requested_rate = 0.0;
+        double achieved_rate = 0.0; // 稳态阶段实际发出速率
+        double completion_rate = 0.0; // 稳态阶段请求的完成速率
+
+        std::uint64_t warmup_sent = 0;
+        std::uint64_t sent = 0;
+        std::uint64_t completed = 0; // 成功收到响应
+        std::uint64_t errors = 0;
+
+        // 自计划发送时刻起的延迟（已修正协同遗漏），失败与超时的请求同样计入
+        util::HdrHistogram latency{1, 60'000'000, 3};
+        // 其中失败请求自计划发送时刻起到失败的耗时
+        util::HdrHistogram error_latency{1, 60'000'000, 3};
+        // 自实际发送时刻起的服务时间（未修正，对照用）
+        util::HdrHistogram service{1, 60'000'000, 3};
+        // 实际发送时刻相对计划时刻的滞后
+        util::HdrHistogram send_lag{1, 60'000'000, 3};
+
+        std::uint64_t throttled = 0; // 因在途上限被推迟的发送次数
+        std::size_t peak_in_flight = 0;
+
+        bool saturated = false; // 发生器自身未能按计划发送
+    };
+
+    /** 将报告格式化为多行文本 */
+    std::string format_report(const LoadReport &r);
+
+    class LoadScenario : public core::scenario::Scenario
+    {
+    private:
+        LoadConfig m_cfg;
+        HttpConfig m_target;
+        LoadReport m_report;
+
+        // 在途请求计数；达到上限时发生器挂起在 m_slot_waiter 上
+        std::size_t m_in_flight = 0;
+        std::coroutine_handle<> m_slot_waiter;
+
+    public:
+        explicit LoadScenario(LoadConfig cfg);
+
+        /** 创建私有 EventLoop 并在当前线程上运行到结束 */
+        util::ResultV<void> run(
+            core::Orchestrator &orch) override;
+
+        util::Task<util::ResultV<void>> run_async(
+            core::Orchestrator &orch,
+            platform::reactor::EventLoop &loop) override;
+
+        /** 最近一次运行的报告 */
+        const LoadReport &report() const noexcept { return m_report; }
+        const LoadConfig &config() const noexcept { return m_cfg; }
+
+    private:
+        util::Task<void> issue(
+            core::Orchestrator &orch,
+            platform::reactor::EventLoop &loop,
+            platform::time::MonoPoint intended,
+            platform::time::MonoPoint sent,
+            bool measured);
+
+        void release_slot(platform::reactor::EventLoop &loop);
+    };
+}
+
+#endif // INCLUDE_EUNET_NET_LOAD_SCENARIO
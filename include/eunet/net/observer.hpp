@@ -0,0 +1,141 @@
+/*
+ * ============================================================================
+ *  File Name   : observer.hpp
+ *  Module      : net
+ *
+ *  Description :
+ *      客户端可观测性策略。TCPClient / HTTPClient 以策略类型为模板参数，
+ *      在编译期决定是否构造并上报事件、是否在阶段边界打点计时：
+ *          FullObserver   : 上报完整事件序列并记录阶段耗时（默认）
+ *          TimingObserver : 只记录阶段耗时，不构造任何事件
+ *          NullObserver   : 二者皆无，事件构造、格式化与载荷拷贝全部编译期消除
+ *      热路径以紧凑记录（EventRecord）上报，文本格式化推迟到 Sink 需要时。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_NET_OBSERVER
+#define INCLUDE_EUNET_NET_OBSERVER
+
+#include <concepts>
+#include <utility>
+
+#include "eunet/core/event_record.hpp"
+#include "eunet/core/orchestrator.hpp"
+#include "eunet/platform/time.hpp"
+
+namespace net
+{
+    /**
+     * @brief 上报全部事件到 Orchestrator
+     */
+    class FullObserver
+    {
+    private:
+        core::Orchestrator *m_orch;
+
+    public:
+        static constexpr bool events = true;
+        static constexpr bool timings = true;
+
+        explicit FullObserver(core::Orchestrator &orch) noexcept : m_orch(&orch) {}
+
+        core::Orchestrator &orchestrator() const noexcept { return *m_orch; }
+
+        util::ResultV<void> emit(core::Event e) { return m_orch->emit(std::move(e)); }
+
+        util::ResultV<void> record(
+            const core::EventRecord &rec,
+            const core::RecordExtras &extras = {})
+        {
+            return m_orch->record(rec, extras);
+        }
+    };
+
+    /**
+     * @brief 只保留阶段计时
+     */
+    struct TimingObserver
+    {
+        static constexpr bool events = false;
+        static constexpr bool timings = true;
+
+        util::ResultV<void> emit(core::Event) { return util::ResultV<void>::Ok(); }
+    };
+
+    /**
+     * @brief 不做任何观测
+     */
+    struct NullObserver
+    {
+        static constexpr bool events = false;
+        static constexpr bool timings = false;
+
+        util::ResultV<void> emit(core::Event) { return util::ResultV<void>::Ok(); }
+    };
+
+    template <typename T>
+    concept ObserverPolicy =
+        std::move_constructible<T> &&
+        requires(T &obs, core::Event e) {
+            { T::events } -> std::convertible_to<bool>;
+            { T::timings } -> std::convertible_to<bool>;
+            { obs.emit(std::move(e)) } -> std::same_as<util::ResultV<void>>;
+        };
+
+    /**
+     * @brief 按策略延迟构造并上报事件
+     *
+     * make 只在策略开启事件时才被调用，关闭时整个调用（包括其中的
+     * 字符串格式化与载荷拷贝）在编译期被消除。
+     */
+    template <ObserverPolicy Observer, typename Make>
+    inline void observe(Observer &obs, core::SessionId sid, Make &&make)
+    {
+        if constexpr (Observer::events)
+        {
+            core::Event e = std::forward<Make>(make)();
+            e.session_id = sid;
+            (void)obs.emit(std::move(e));
+        }
+    }
+
+    /**
+     * @brief 按策略延迟构造并上报紧凑记录
+     *
+     * make 返回定长记录，只在策略开启事件时调用；变长数据以视图经 extras 传入，
+     * 由 Timeline 复制保存，消息文本直到 Sink 需要时才格式化。
+     */
+    template <ObserverPolicy Observer, typename Make>
+    inline void observe_record(
+        Observer &obs,
+        core::SessionId sid,
+        Make &&make,
+        const core::RecordExtras &extras = {})
+    {
+        if constexpr (Observer::events)
+        {
+            core::EventRecord rec = std::forward<Make>(make)();
+            rec.session = sid;
+            (void)obs.record(rec, extras);
+        }
+    }
+
+    /** 策略开启计时时读取单调时钟，否则返回零值而不产生系统调用 */
+    template <ObserverPolicy Observer>
+    inline platform::time::MonoPoint observe_now()
+    {
+        if constexpr (Observer::timings)
+            return platform::time::monotonic_now();
+        else
+            return {};
+    }
+}
+
+#endif // INCLUDE_EUNET_NET_OBSERVER
@@ -7,6 +7,8 @@
  *      高层 TCP 客户端封装。组合了 Poller、TCPConnection 和 DNS Resolver。
  *      管理连接建立的过程（DNS -> Connect），提供简化的 send/recv 接口，
  *      并负责生成 TCP 层的生命周期事件。
+ *      可观测性由模板参数 Observer 决定（见 observer.hpp），
+ *      TCPClient 为上报完整事件的默认实例。
  *
  *  Third-Party Dependencies :
  *      None
@@ -27,33 +29,63 @@
 
 #include "eunet/core/orchestrator.hpp"
 #include "eunet/util/result.hpp"
+#include "eunet/net/observer.hpp"
 #include "eunet/net/connection/tcp_connection.hpp"
 
 namespace net::tcp
 {
+    /**
+     * @brief 最近一次 connect() 的阶段耗时
+     */
+    struct ConnectTimings
+    {
+        platform::time::MonoClock::duration dns{};
+        platform::time::MonoClock::duration connect{};
+    };
+
     /**
      * @brief 可观测的 TCP 客户端
      *
      * 封装了 TCP 连接建立和数据收发过程。
      * 关键特性是它会在关键节点（DNS, Connect Start, Success, Send, Recv）
      * 主动向 Orchestrator 发送 Event，从而实现可视化。
+     * Observer 关闭事件时，所有事件构造与格式化在编译期消除；
+     * 关闭计时时 last_connect_timings() 恒为 0。
+     *
+     * @tparam Observer 可观测性策略，仅支持 observer.hpp 中的三种（显式实例化）
      */
-    class TCPClient
+    template <ObserverPolicy Observer = FullObserver>
+    class BasicTCPClient
     {
     private:
-        core::Orchestrator &orch;
+        Observer m_obs;
         std::optional<TCPConnection> m_conn;
         platform::poller::Poller m_poller;
+        platform::net::TcpInfoSampler m_info_sampler;
+        bool m_kernel_timestamps = false;
+        // 推迟的 Fast Open 连接 连接成功待首次写入确认握手后上报
+        bool m_connect_pending = false;
+        // 发送回执尚未到达的 HTTP_SENT 记录 在下一次收发、采样或关闭前补上时间戳上报
+        std::optional<core::EventRecord> m_pending_sent;
+        std::vector<std::byte> m_pending_payload;
+        platform::net::SocketOptions m_sock_opts;
+        core::SessionId m_session = 0;
+        ConnectTimings m_timings;
 
     public:
-        explicit TCPClient(core::Orchestrator &o);
-        ~TCPClient();
+        explicit BasicTCPClient(Observer obs = Observer{});
+
+        explicit BasicTCPClient(core::Orchestrator &o)
+            requires std::constructible_from<Observer, core::Orchestrator &>
+            : BasicTCPClient(Observer(o)) {}
+
+        ~BasicTCPClient();
 
         // 禁止拷贝，允许移动
-        TCPClient(const TCPClient &) = delete;
-        TCPClient &operator=(const TCPClient &) = delete;
-        TCPClient(TCPClient &&) = default;
-        TCPClient &operator=(TCPClient &&) = default;
+        BasicTCPClient(const BasicTCPClient &) = delete;
+        BasicTCPClient &operator=(const BasicTCPClient &) = delete;
+        BasicTCPClient(BasicTCPClient &&) = default;
+        BasicTCPClient &operator=(BasicTCPClient &&) = default;
 
     public:
         /**
@@ -74,9 +106,78 @@ namespace net::tcp
             std::vector<std::byte> &buffer, size_t max_size, int timeout_ms = 3000);
         void close() noexcept;
 
+    public:
+        /**
+         * @brief 设置套接字调优配置
+         *
+         * 对之后建立的连接生效。每个被应用的选项都会以
+         * SOCKET_OPTION_SET 事件记录在 Timeline 中。
+         *
+         * @param opts 声明式调优配置
+         */
+        void set_socket_options(const platform::net::SocketOptions &opts);
+
+        /**
+         * @brief 开启内核软件时间戳 (SO_TIMESTAMPING)
+         *
+         * 对之后建立的连接生效。开启后 HTTP_SENT / HTTP_RECEIVED 事件
+         * 在 kernel_ts 中携带内核时间戳，可据此计算每个分块的内核与用户态间隔。
+         * 发送回执按序号与本次发送匹配，写入返回时尚未到达的，
+         * HTTP_SENT 推迟到下一次 recv / send / 采样 / close 前上报。
+         */
+        void set_kernel_timestamps(bool enable) noexcept;
+
+        /**
+         * @brief 设置 TCP_INFO 周期采样间隔
+         *
+         * 采样在 send/recv 之后按间隔节流触发，间隔为 0 表示关闭周期采样。
+         * 连接建立与关闭时（若已开启）各补充一次采样。
+         *
+         * @param interval 两次周期采样的最小间隔
+         */
+        void set_tcp_info_interval(platform::time::Duration interval) noexcept;
+
+        /**
+         * @brief 设置所属会话
+         *
+         * 之后上报的事件都携带该会话 ID，便于按会话聚合各阶段耗时。
+         */
+        void set_session(core::SessionId sid) noexcept { m_session = sid; }
+        core::SessionId session() const noexcept { return m_session; }
+
+        /** 最近一次 connect() 的 DNS 与握手耗时，失败的阶段保持为 0 */
+        const ConnectTimings &last_connect_timings() const noexcept { return m_timings; }
+
+        /**
+         * @brief 按需采样一次 TCP_INFO 并上报 TCP_INFO_SAMPLE 事件（策略开启事件时）
+         *
+         * @return util::ResultV<platform::net::TcpInfo> 采样结果
+         */
+        util::ResultV<platform::net::TcpInfo> sample_tcp_info();
+
     private:
-        util::ResultV<void> emit_event(const core::Event &e);
+        template <typename Make>
+        void emit_event(Make &&make);
+
+        template <typename Make>
+        void emit_record(Make &&make, const core::RecordExtras &extras = {});
+
+        void maybe_sample_tcp_info();
+
+        /** 为发送记录附上与之匹配的内核 TX 时间戳，回执未到时返回 false */
+        bool attach_tx_timestamp(core::EventRecord &sent);
+
+        /** 上报暂存的 HTTP_SENT 记录（若有） */
+        void flush_pending_sent();
     };
+
+    using TCPClient = BasicTCPClient<FullObserver>;
+    using TimingTCPClient = BasicTCPClient<TimingObserver>;
+    using NullTCPClient = BasicTCPClient<NullObserver>;
+
+    extern template class BasicTCPClient<FullObserver>;
+    extern template class BasicTCPClient<TimingObserver>;
+    extern template class BasicTCPClient<NullObserver>;
 }
 
 #endif // INCLUDE_EUNET_NET_TCP_CLIENT
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*
+ * ============================================================================
+ *  File Name   : awaitable.hpp
+ *  Module      : platform/reactor
+ *
+ *  Description :
+ *      EventLoop 上的协程等待原语。co_await readable()/writable()
+ *      以单次关注在 reactor 上布防 fd 并挂起当前协程，IO 就绪或超时后
+ *      由 reactor 线程恢复，挂起期间不占用任何线程。
+ *      fd 只在首次等待时注册，之后每次等待仅以 EPOLL_CTL_MOD 切换关注掩码，
+ *      注册由 fd 的持有者（如连接关闭时）通过 EventLoop::unwatch 释放。
+ *      sleep_until() 挂起到指定时刻，用于按计划节拍发起请求。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_PLATFORM_AWAITABLE
+#define INCLUDE_EUNET_PLATFORM_AWAITABLE
+
+#include <coroutine>
+#include <cstdint>
+#include <optional>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/platform/fd.hpp"
+#include "eunet/platform/time.hpp"
+#include "eunet/platform/timer.hpp"
+#include "eunet/platform/event_loop.hpp"
+
+namespace platform::reactor
+{
+    /**
+     * @brief 等待 fd 就绪的 awaiter
+     *
+     * 只能在 loop 所属的 reactor 线程内 co_await。
+     * 就绪后单次关注由内核自动停用，超时则主动撤销，fd 保持注册，
+     * 因此同一 fd 可在恢复后再次等待而不产生额外的注册开销。
+     * 任何 epoll 事件（含 ERR / HUP）都视为就绪，具体错误由随后的系统调用报告。
+     * 挂起中的协程被销毁时（如场景停止）析构函数撤销关注与定时器，
+     * 之后的就绪或超时不会再经由已失效的 awaiter 恢复。
+     */
+    class FdReady
+    {
+    private:
+        EventLoop &m_loop;
+        platform::fd::FdView m_fd;
+        std::uint32_t m_events;
+        int m_timeout_ms;
+
+        std::coroutine_handle<> m_waiter;
+        std::optional<platform::timer::TimerId> m_timer;
+        std::optional<util::Error> m_error;
+        std::uint32_t m_revents = 0;
+        bool m_pending = false; // 已挂起且尚未被 IO 或超时唤醒
+
+    public:
+        /**
+         * @param timeout_ms 最长等待时间，-1 表示不超时
+         */
+        FdReady(EventLoop &loop,
+                platform::fd::FdView fd,
+                std::uint32_t events,
+                int timeout_ms = -1) noexcept
+            : m_loop(loop), m_fd(fd), m_events(events), m_timeout_ms(timeout_ms) {}
+
+        ~FdReady();
+
+        FdReady(const FdReady &) = delete;
+        FdReady &operator=(const FdReady &) = delete;
+
+    public:
+        bool await_ready() const noexcept { return false; }
+
+        /** 注册失败时不挂起，错误由 await_resume 返回 */
+        bool await_suspend(std::coroutine_handle<> waiter);
+
+        /** @return 就绪事件掩码，或超时 / 注册失败错误 */
+        util::ResultV<std::uint32_t> await_resume();
+
+    private:
+        void complete(std::uint32_t revents, bool timed_out);
+    };
+
+    /**
+     * @brief 等待到指定单调时刻的 awaiter
+     *
+     * 只能在 loop 所属的 reactor 线程内 co_await。
+     * 精度受时间轮分辨率限制，恢复时刻不会早于 deadline。
+     * 挂起中的协程被销毁时析构函数取消定时器。
+     */
+    class SleepUntil
+    {
+    private:
+        EventLoop &m_loop;
+        platform::time::MonoPoint m_deadline;
+        std::optional<platform::timer::TimerId> m_timer; // 挂起期间有效，到期恢复前清除
+        std::optional<util::Error> m_error;
+
+    public:
+        SleepUntil(EventLoop &loop, platform::time::MonoPoint deadline) noexcept
+            : m_loop(loop), m_deadline(deadline) {}
+
+        ~SleepUntil();
+
+        SleepUntil(const SleepUntil &) = delete;
+        SleepUntil &operator=(const SleepUntil &) = delete;
+
+    public:
+        bool await_ready() const noexcept;
+
+        /** 定时器注册失败时不挂起，错误由 await_resume 返回 */
+        bool await_suspend(std::coroutine_handle<> waiter);
+
+        util::ResultV<void> await_resume();
+    };
+
+    inline SleepUntil sleep_until(EventLoop &loop, platform::time::MonoPoint deadline)
+    {
+        return SleepUntil(loop, deadline);
+    }
+
+    inline FdReady readable(EventLoop &loop, platform::fd::FdView fd, int timeout_ms = -1)
+    {
+        return FdReady(loop, fd, EPOLLIN, timeout_ms);
+    }
+
+    inline FdReady writable(EventLoop &loop, platform::fd::FdView fd, int timeout_ms = -1)
+    {
+        return FdReady(loop, fd, EPOLLOUT, timeout_ms);
+    }
+}
+
+#endif // INCLUDE_EUNET_PLATFORM_AWAITABLE
@@ -20,6 +20,9 @@
 #ifndef INCLUDE_EUNET_PLATFORM_BASE_SOCKET
 #define INCLUDE_EUNET_PLATFORM_BASE_SOCKET
 
+#include <cstdint>
+#include <optional>
+
 #include "eunet/util/result.hpp"
 #include "eunet/util/error.hpp"
 #include "eunet/util/byte_buffer.hpp"
@@ -37,6 +40,17 @@ namespace platform::net
         fd::Fd m_fd;
         poller::Poller &m_poller;
 
+        // SO_TIMESTAMPING 软件时间戳状态
+        bool m_timestamping = false;
+        std::optional<time::WallPoint> m_last_rx_ts;
+        std::optional<time::WallPoint> m_last_tx_ts;
+
+        // SOF_TIMESTAMPING_OPT_ID 发送回执序号：流式套接字按字节计，数据报按报文计
+        bool m_tx_ids = false;
+        bool m_tx_stream = false;
+        std::uint32_t m_tx_count = 0;
+        std::optional<std::uint32_t> m_tx_key; // 最近一次发送的回执序号
+
         explicit BaseSocket(fd::Fd &&fd, poller::Poller &poller);
 
     public:
@@ -59,6 +73,81 @@ namespace platform::net
         util::ResultV<Endpoint>
         remote_endpoint() const;
 
+        /**
+         * @brief 切换 O_NONBLOCK
+         *
+         * 交给 reactor 驱动的套接字需设为非阻塞，
+         * 之后应使用 try_read / try_write 并在 Busy 时等待就绪。
+         */
+        util::ResultV<void> set_nonblocking(bool enable);
+
+    public:
+        /**
+         * @brief 开启内核软件时间戳 (SO_TIMESTAMPING)
+         *
+         * 仅使用软件时间戳，无需网卡支持。开启后 read 改用 recvmsg
+         * 从控制消息中收取 RX 时间戳，TX 时间戳经由错误队列回传，
+         * 并以 SOF_TIMESTAMPING_OPT_ID 序号与对应的发送匹配。
+         * TCP 需在连接建立后开启才能分配序号；无法分配时只保留 RX 时间戳。
+         *
+         * @return ResultV<void> 成功或 setsockopt 错误
+         */
+        util::ResultV<void> enable_timestamping();
+
+        bool timestamping_enabled() const noexcept { return m_timestamping; }
+
+        /** 发送回执能否按序号与发送匹配（开启时间戳且内核接受了 OPT_ID） */
+        bool tx_timestamping() const noexcept { return m_timestamping && m_tx_ids; }
+
+        /** 最近一次 read 对应数据到达内核的时间（CLOCK_REALTIME） */
+        std::optional<time::WallPoint> last_rx_timestamp() const noexcept { return m_last_rx_ts; }
+
+        /**
+         * @brief 最近一次 write 对应数据离开协议栈的时间（CLOCK_REALTIME）
+         *
+         * 只接受序号与最近一次发送相符的回执，回执尚未到达时为 nullopt，
+         * 不会误报上一次发送的时间。
+         */
+        std::optional<time::WallPoint> last_tx_timestamp() const noexcept { return m_last_tx_ts; }
+
+        /**
+         * @brief 非阻塞地排空错误队列中的 TX 软件时间戳
+         *
+         * 每次发送后以及等待中出现 EPOLLERR 时自动调用；回执晚到时可由调用方再次收取。
+         * 错误队列非空会使 epoll 报告 EPOLLERR，因此开启时间戳后需及时排空。
+         *
+         * @return 最近一次发送的时间戳；对应回执尚未到达时为 nullopt
+         */
+        std::optional<time::WallPoint> drain_tx_timestamps() noexcept;
+
+    protected:
+        /**
+         * @brief 带时间戳收取的 recv
+         *
+         * 未开启时间戳时等价于 ::recv；开启后使用 recvmsg 并更新 m_last_rx_ts。
+         */
+        ssize_t recv_stamped(void *data, size_t len, int flags) noexcept;
+
+        /**
+         * @brief 登记一次成功的发送
+         *
+         * 推进 OPT_ID 序号并清除旧的 TX 时间戳，再尝试收取本次发送的回执；
+         * 此前发送的迟到回执在此一并排空。未开启时间戳时为空操作。
+         */
+        void note_tx(size_t bytes) noexcept;
+
+        /**
+         * @brief 等待 fd 就绪
+         *
+         * 未开启时间戳时等价于 wait_fd_epoll；开启后错误队列中的发送回执
+         * 同样会触发 EPOLLERR，此时收取回执后继续等待，只有套接字本身出错才返回错误。
+         */
+        util::ResultV<void> wait_ready(std::uint32_t events, int timeout_ms);
+
+    private:
+        /** 排空错误队列并按序号匹配回执，返回取出的消息数 */
+        std::size_t drain_error_queue() noexcept;
+
     public:
         virtual IOResult
         read(util::ByteBuffer &buf, int timeout_ms = -1) = 0;
@@ -0,0 +1,202 @@
+/*
+ * ============================================================================
+ *  File Name   : event_loop.hpp
+ *  Module      : platform/reactor
+ *
+ *  Description :
+ *      单线程 reactor 事件循环。组合 Poller、TimerService 与 eventfd 唤醒器，
+ *      其他线程通过 post() 把任务投递到无锁 MPSC 队列中，
+ *      由 reactor 线程在下一轮循环中批量执行。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_PLATFORM_EVENT_LOOP
+#define INCLUDE_EUNET_PLATFORM_EVENT_LOOP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/util/mpsc_queue.hpp"
+#include "eunet/platform/fd.hpp"
+#include "eunet/platform/poller.hpp"
+#include "eunet/platform/timer.hpp"
+
+namespace platform::reactor
+{
+    using Task = std::function<void()>;
+    using IoCallback = std::function<void(std::uint32_t events)>;
+
+    /**
+     * @brief eventfd 唤醒器
+     *
+     * 多次 notify() 在被 reactor 消费前合并为一次可读事件。
+     */
+    class Wakeup
+    {
+    private:
+        platform::fd::Fd m_fd;
+
+    public:
+        static util::ResultV<Wakeup> create();
+
+    private:
+        explicit Wakeup(platform::fd::Fd fd) : m_fd(std::move(fd)) {}
+
+    public:
+        platform::fd::FdView fd() const noexcept { return m_fd.view(); }
+
+        /** 线程安全，写入计数 1 */
+        void notify() noexcept;
+
+        /** 读出并清零计数，返回自上次读取以来的 notify 次数 */
+        std::uint64_t drain() noexcept;
+    };
+
+    /**
+     * @brief 事件循环运行统计
+     */
+    struct LoopStats
+    {
+        std::atomic<std::uint64_t> posted{0};   // post() 次数
+        std::atomic<std::uint64_t> executed{0}; // 已执行任务数
+        std::atomic<std::uint64_t> wakeups{0};  // 实际写入 eventfd 的次数
+        std::atomic<std::uint64_t> iterations{0};
+    };
+
+    /**
+     * @brief 单线程 reactor
+     *
+     * post() / stop() 可由任意线程调用；其余接口只允许在 reactor 线程
+     * （调用 run() 的线程）或 run() 启动前调用。
+     * 内部以对象地址作为 epoll 用户数据，因此不可移动，通过 create() 构造于堆上。
+     */
+    class EventLoop
+    {
+    private:
+        static constexpr std::size_t TASK_BATCH = 1024;
+
+        struct IoWatch
+        {
+            int fd;
+            IoCallback cb;
+            bool oneshot = false; // 触发一次后回调即被取走，需 arm() 重新布防
+        };
+
+    private:
+        platform::poller::Poller m_poller;
+        platform::timer::TimerService m_timers;
+        Wakeup m_wakeup;
+
+        util::MpscQueue<Task> m_tasks;
+        std::atomic<bool> m_wake_pending{false};
+        std::atomic<bool> m_stop{false};
+        std::atomic<std::thread::id> m_owner{};
+
+        std::unordered_map<int, std::unique_ptr<IoWatch>> m_watches;
+        std::vector<std::unique_ptr<IoWatch>> m_retired; // 本轮结束后再释放
+
+        platform::poller::EventArray m_events;
+        LoopStats m_stats;
+
+        // 作为 epoll 用户数据的哨兵地址
+        char m_wake_tag = 0;
+        char m_timer_tag = 0;
+
+    public:
+        static util::ResultV<std::unique_ptr<EventLoop>>
+        create(std::size_t max_events = 1024);
+
+    private:
+        EventLoop(
+            platform::poller::Poller poller,
+            platform::timer::TimerService timers,
+            Wakeup wakeup,
+            std::size_t max_events);
+
+    public:
+        EventLoop(const EventLoop &) = delete;
+        EventLoop &operator=(const EventLoop &) = delete;
+
+    public:
+        /**
+         * @brief 投递任务（线程安全）
+         *
+         * 一次原子入队；只有在 reactor 尚未被唤醒时才写一次 eventfd。
+         */
+        void post(Task fn);
+
+        /** 在 reactor 线程内直接执行，否则投递 */
+        void dispatch(Task fn);
+
+        /** 请求退出 run()（线程安全） */
+        void stop();
+
+        /**
+         * @brief 运行事件循环直到 stop()
+         */
+        util::ResultV<void> run();
+
+        /**
+         * @brief 执行一轮循环
+         *
+         * @param timeout_ms 最长等待时间，-1 表示无限等待
+         * @return 本轮处理的回调数量（IO + 定时器 + 任务）
+         */
+        util::ResultV<std::size_t> run_once(int timeout_ms = -1);
+
+        bool in_loop_thread() const noexcept;
+        bool stopped() const noexcept { return m_stop.load(std::memory_order_acquire); }
+
+    public:
+        /**
+         * @brief 关注 fd 上的 IO 事件
+         *
+         * 重复调用会替换事件掩码与回调。
+         */
+        util::ResultV<void> watch(
+            platform::fd::FdView fd,
+            std::uint32_t events,
+            IoCallback cb);
+
+        util::ResultV<void> unwatch(platform::fd::FdView fd);
+
+        /**
+         * @brief 单次关注 fd 上的 IO 事件
+         *
+         * 首次调用以 EPOLLONESHOT 注册 fd，此后只以 EPOLL_CTL_MOD 重新布防并替换回调，
+         * 不再重复 ADD / DEL 与分配。触发一次后内核自动停用，回调随之清除。
+         * 注册一直保留到 unwatch()，由 fd 的持有者在关闭前注销。
+         */
+        util::ResultV<void> arm(
+            platform::fd::FdView fd,
+            std::uint32_t events,
+            IoCallback cb);
+
+        /** 撤销尚未触发的单次关注，fd 仍保持注册 */
+        util::ResultV<void> disarm(platform::fd::FdView fd);
+
+        platform::timer::TimerService &timers() noexcept { return m_timers; }
+        platform::poller::Poller &poller() noexcept { return m_poller; }
+
+        const LoopStats &stats() const noexcept { return m_stats; }
+
+    private:
+        std::size_t run_tasks();
+    };
+}
+
+#endif // INCLUDE_EUNET_PLATFORM_EVENT_LOOP
@@ -0,0 +1,112 @@
+/*
+ * ============================================================================
+ *  File Name   : socket_options.hpp
+ *  Module      : platform/net
+ *
+ *  Description :
+ *      声明式套接字调优配置。描述 TCP_NODELAY、收发缓冲区、TCP_QUICKACK、
+ *      SO_KEEPALIVE 与 TCP Fast Open 等选项，按创建期 / 连接期两个阶段
+ *      应用到套接字上，并返回每个选项的应用记录以便写入 Timeline。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_PLATFORM_NET_SOCKET_OPTIONS
+#define INCLUDE_EUNET_PLATFORM_NET_SOCKET_OPTIONS
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/platform/fd.hpp"
+
+namespace platform::net
+{
+    /**
+     * @brief 选项生效阶段
+     *
+     * Create  : socket() 之后、connect() 之前（NODELAY、缓冲区、TFO 等）
+     * Connect : 连接建立之后（QUICKACK 每次 ACK 后会被内核复位，需要重新设置）
+     */
+    enum class SocketOptionStage
+    {
+        Create,
+        Connect,
+    };
+
+    /**
+     * @brief 套接字调优配置
+     *
+     * 未设置（nullopt）的选项保持内核默认值，不产生系统调用。
+     */
+    struct SocketOptions
+    {
+        std::optional<bool> tcp_nodelay;  // 禁用 Nagle 算法
+        std::optional<bool> tcp_quickack; // 立即 ACK，关闭延迟确认
+        std::optional<bool> keepalive;    // SO_KEEPALIVE
+        std::optional<int> send_buffer;   // SO_SNDBUF（字节）
+        std::optional<int> recv_buffer;   // SO_RCVBUF（字节）
+
+        // TCP Fast Open：优先使用 TCP_FASTOPEN_CONNECT，
+        // 不支持时退化为首次写入时 sendto(MSG_FASTOPEN) 携带数据发起连接
+        bool fastopen = false;
+
+        /** 与 libcurl / Beast 基准测试对齐的低延迟配置 */
+        static SocketOptions low_latency()
+        {
+            SocketOptions o;
+            o.tcp_nodelay = true;
+            o.tcp_quickack = true;
+            return o;
+        }
+
+        bool empty() const noexcept
+        {
+            return !tcp_nodelay && !tcp_quickack && !keepalive &&
+                   !send_buffer && !recv_buffer && !fastopen;
+        }
+    };
+
+    /**
+     * @brief 单个选项的应用记录
+     */
+    struct AppliedSocketOption
+    {
+        std::string name; // 如 "TCP_NODELAY"
+        int value = 0;
+        SocketOptionStage stage = SocketOptionStage::Create;
+        std::optional<util::Error> error = std::nullopt;
+
+        bool ok() const noexcept { return !error.has_value(); }
+    };
+
+    using AppliedSocketOptions = std::vector<AppliedSocketOption>;
+
+    /**
+     * @brief 将指定阶段的选项应用到套接字
+     *
+     * 单个选项失败不会中断其余选项，失败原因记录在返回值中。
+     *
+     * @param fd 目标套接字
+     * @param opts 调优配置
+     * @param stage 当前所处阶段
+     * @return AppliedSocketOptions 本阶段实际尝试设置的选项
+     */
+    AppliedSocketOptions apply_socket_options(
+        fd::FdView fd,
+        const SocketOptions &opts,
+        SocketOptionStage stage);
+}
+
+std::string to_string(platform::net::SocketOptionStage stage);
+std::string to_string(const platform::net::AppliedSocketOption &opt);
+
+#endif // INCLUDE_EUNET_PLATFORM_NET_SOCKET_OPTIONS
@@ -0,0 +1,96 @@
+/*
+ * ============================================================================
+ *  File Name   : tcp_info.hpp
+ *  Module      : platform/net
+ *
+ *  Description :
+ *      内核 TCP_INFO 采样封装。通过 getsockopt(TCP_INFO) 读取连接的
+ *      RTT、RTT 方差、拥塞窗口、重传数、投递速率与未确认分段等指标，
+ *      并提供按固定间隔节流的采样器，使采样开销可预期。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_PLATFORM_NET_TCP_INFO
+#define INCLUDE_EUNET_PLATFORM_NET_TCP_INFO
+
+#include <cstdint>
+#include <string>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/platform/fd.hpp"
+#include "eunet/platform/time.hpp"
+
+namespace platform::net
+{
+    /**
+     * @brief 单次 TCP_INFO 采样结果
+     *
+     * 仅保留定位延迟问题最常用的字段，时间类字段单位均为微秒。
+     */
+    struct TcpInfo
+    {
+        uint8_t state = 0;              // TCP 状态 (TCP_ESTABLISHED 等)
+        uint32_t rtt_us = 0;            // 平滑 RTT
+        uint32_t rttvar_us = 0;         // RTT 方差
+        uint32_t snd_cwnd = 0;          // 拥塞窗口（分段数）
+        uint32_t snd_mss = 0;           // 发送 MSS
+        uint32_t retransmits = 0;       // 当前未恢复的重传次数
+        uint32_t total_retrans = 0;     // 连接累计重传分段数
+        uint32_t lost = 0;              // 判定丢失的分段数
+        uint32_t unacked = 0;           // 已发送未确认的分段数
+        uint64_t delivery_rate = 0;     // 投递速率 (bytes/s)，旧内核为 0
+        platform::time::MonoPoint at{}; // 采样时刻
+    };
+
+    /**
+     * @brief 读取指定套接字的 TCP_INFO
+     *
+     * @param fd 已连接的 TCP 套接字
+     * @return util::ResultV<TcpInfo> 采样结果或系统错误
+     */
+    util::ResultV<TcpInfo> query_tcp_info(fd::FdView fd);
+
+    /**
+     * @brief TCP_INFO 采样节流器
+     *
+     * 记录上次采样时刻，只有间隔到期才允许下一次采样。
+     * 间隔为 0 表示关闭周期采样（按需采样不受影响）。
+     */
+    class TcpInfoSampler
+    {
+    private:
+        platform::time::Duration m_interval{0};
+        platform::time::MonoPoint m_last{};
+        bool m_sampled = false;
+
+    public:
+        explicit TcpInfoSampler(
+            platform::time::Duration interval = platform::time::Duration{0}) noexcept
+            : m_interval(interval) {}
+
+    public:
+        platform::time::Duration interval() const noexcept { return m_interval; }
+        void set_interval(platform::time::Duration interval) noexcept { m_interval = interval; }
+        bool enabled() const noexcept { return m_interval.count() > 0; }
+
+        /** 当前时刻是否到了下一次周期采样 */
+        bool due(platform::time::MonoPoint now) const noexcept;
+
+        /** 记录一次采样（周期或按需均会重置间隔） */
+        void mark(platform::time::MonoPoint now) noexcept;
+
+        void reset() noexcept { m_sampled = false; }
+    };
+}
+
+std::string to_string(const platform::net::TcpInfo &info);
+
+#endif // INCLUDE_EUNET_PLATFORM_NET_TCP_INFO
@@ -22,9 +22,11 @@
 
 #include <sys/epoll.h>
 #include <cstdint>
+#include <cstddef>
 #include <vector>
 #include <string>
-#include <unordered_set>
+#include <span>
+#include <unordered_map>
 
 #include "eunet/util/result.hpp"
 #include "eunet/util/error.hpp"
@@ -37,6 +39,11 @@ namespace platform::poller
         Read = EPOLLIN,
         Write = EPOLLOUT,
         Error = EPOLLERR | EPOLLHUP,
+        PeerHangup = EPOLLRDHUP,
+
+        // 触发方式标志（与读写事件按位或使用）
+        EdgeTriggered = EPOLLET,
+        OneShot = EPOLLONESHOT,
     };
 
     struct PollEvent;
@@ -51,6 +58,39 @@ namespace platform::poller
         bool is_writable() { return events & static_cast<uint32_t>(PollEventType::Write); }
     };
 
+    /**
+     * @brief 可复用的就绪事件数组
+     *
+     * 高吞吐模式下由调用方持有并在多次 wait 之间复用，
+     * 容量在构造时确定，wait 过程中不产生任何堆分配。
+     */
+    class EventArray
+    {
+    private:
+        std::vector<epoll_event> m_events;
+        std::size_t m_count = 0;
+
+    public:
+        explicit EventArray(std::size_t capacity = 1024)
+            : m_events(capacity == 0 ? 1 : capacity) {}
+
+    public:
+        std::size_t capacity() const noexcept { return m_events.size(); }
+        std::size_t size() const noexcept { return m_count; }
+        bool empty() const noexcept { return m_count == 0; }
+
+        /** 第 i 个就绪事件注册时携带的用户数据指针 */
+        void *data(std::size_t i) const noexcept { return m_events[i].data.ptr; }
+        std::uint32_t events(std::size_t i) const noexcept { return m_events[i].events; }
+
+        std::span<const epoll_event> ready() const noexcept { return {m_events.data(), m_count}; }
+
+    private:
+        friend class Poller;
+        std::span<epoll_event> storage() noexcept { return m_events; }
+        void set_size(std::size_t n) noexcept { m_count = n; }
+    };
+
     /**
      * @brief Epoll 多路复用器封装
      *
@@ -60,14 +100,33 @@ namespace platform::poller
     class Poller
     {
     public:
-        using FdTable = std::unordered_set<int>;
+        /**
+         * @brief 单个 fd 的注册信息
+         *
+         * 以 fd 为下标存放在平坦数组中，查询与更新均为 O(1)。
+         */
+        struct Registration
+        {
+            bool active = false;
+            std::uint32_t events = 0;
+            void *data = nullptr; // 非空时 epoll_data.ptr 携带该指针
+        };
+
+        using FdTable = std::vector<Registration>;
 
     private:
-        static constexpr int MAX_EVENTS = 64;
+        static constexpr int DEFAULT_MAX_EVENTS = 64;
 
     private:
         platform::fd::Fd epoll_fd;
         FdTable fd_table;
+        std::size_t registered = 0;
+
+        // 用户数据指针到 fd 的反查表，供 wait(int) 还原以指针注册的 fd
+        std::unordered_map<void *, int> data_fds;
+
+        // 兼容接口 wait(int) 复用的内部事件数组
+        std::vector<epoll_event> scratch;
 
     public:
         static util::ResultV<Poller> create();
@@ -89,6 +148,21 @@ namespace platform::poller
         const platform::fd::Fd &get_fd() const noexcept;
 
         bool has_fd(int fd) const noexcept;
+        std::size_t size() const noexcept { return registered; }
+
+        /**
+         * @brief 查询 fd 的注册信息
+         *
+         * @return 已注册时返回表项指针，否则为 nullptr
+         */
+        const Registration *registration(int fd) const noexcept;
+
+        /**
+         * @brief 调整 wait(int) 单次可返回的最大事件数
+         *
+         * @param n 内部复用事件数组的容量，默认 64
+         */
+        void set_max_events(std::size_t n);
 
     public:
         /**
@@ -122,11 +196,74 @@ namespace platform::poller
         util::ResultV<void>
         remove(platform::fd::FdView fd) noexcept;
 
+    public:
+        // ---------------- 高吞吐模式 ----------------
+
+        /**
+         * @brief 以用户数据指针注册 fd
+         *
+         * 就绪时 epoll_data.ptr 直接返回该指针，调用方无需再由 fd 反查连接对象。
+         * events 可按位或 EPOLLET / EPOLLONESHOT。
+         * 同一 Poller 内指针应互不相同，wait(int) 依此把指针还原为 fd。
+         *
+         * @param fd 目标文件描述符视图
+         * @param events 感兴趣的事件掩码
+         * @param data 就绪时回传的用户数据指针（不可为空）
+         * @return ResultV<void> 成功或系统错误
+         */
+        util::ResultV<void> add(
+            platform::fd::FdView fd,
+            std::uint32_t events,
+            void *data) noexcept;
+
+        /**
+         * @brief 重新装填 EPOLLONESHOT 注册
+         *
+         * 沿用注册时的用户数据与事件掩码；可选地替换事件掩码。
+         *
+         * @param fd 目标文件描述符视图
+         * @param events 新的事件掩码，0 表示沿用原掩码
+         * @return ResultV<void> 成功或系统错误
+         */
+        util::ResultV<void> rearm(
+            platform::fd::FdView fd,
+            std::uint32_t events = 0) noexcept;
+
+        /**
+         * @brief 等待事件并写入调用方提供的事件数组
+         *
+         * 不分配内存，单次最多返回 out.capacity() 个事件。
+         *
+         * @param out 可复用的事件数组
+         * @param timeout_ms 超时时间（毫秒），-1 表示无限等待
+         * @return ResultV<size_t> 就绪事件数
+         */
+        util::ResultV<std::size_t>
+        wait(EventArray &out, int timeout_ms) noexcept;
+
+        /**
+         * @brief 等待事件并写入调用方提供的原始 epoll_event 缓冲区
+         *
+         * @param out 调用方持有的缓冲区
+         * @param timeout_ms 超时时间（毫秒），-1 表示无限等待
+         * @return ResultV<size_t> 就绪事件数
+         */
+        util::ResultV<std::size_t>
+        wait(std::span<epoll_event> out, int timeout_ms) noexcept;
+
+    private:
+        util::ResultV<void> not_initialized() const noexcept;
+        util::ResultV<void> ctl(int op, int fd, const Registration &reg, const char *context) noexcept;
+        util::ResultV<std::size_t> wait_raw(epoll_event *out, int max_events, int timeout_ms) noexcept;
+        void store(int fd, const Registration &reg);
+        void forget(int fd) noexcept;
+
     public:
         /**
          * @brief 等待事件发生
          *
-         * 封装 epoll_wait。
+         * 封装 epoll_wait。以用户数据指针注册的 fd 经反查表还原为 fd，
+         * 两种注册方式可以混用；高吞吐路径应改用 wait(EventArray&, int)。
          *
          * @param timeout_ms 超时时间（毫秒），-1 表示无限等待
          * @return ResultV<std::vector<PollEvent>> 就绪的事件列表
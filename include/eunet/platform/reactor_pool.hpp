@@ -0,0 +1,172 @@
+/*
+ * ============================================================================
+ *  File Name   : reactor_pool.hpp
+ *  Module      : platform/reactor
+ *
+ *  Description :
+ *      Thread-per-core 多 reactor 运行时。每个 reactor 线程独占
+ *      EventLoop（Poller + 时间轮）与 BufferPool，并通过 pthread_setaffinity_np
+ *      绑定到固定 CPU。新会话按轮询或最小负载分配到某个 reactor，
+ *      IO 路径上不存在跨 reactor 共享的锁。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_PLATFORM_REACTOR_POOL
+#define INCLUDE_EUNET_PLATFORM_REACTOR_POOL
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/util/buffer_pool.hpp"
+#include "eunet/platform/event_loop.hpp"
+
+namespace platform::reactor
+{
+    /**
+     * @brief 会话分配策略
+     */
+    enum class Placement
+    {
+        RoundRobin, // 轮询
+        LeastLoad,  // 当前活跃会话数最少
+    };
+
+    struct ReactorPoolOptions
+    {
+        std::size_t threads = 0; // 0 表示使用 hardware_concurrency
+        bool pin_cpus = true;    // 第 i 个 reactor 绑定到第 i 个 CPU（取模）
+        Placement placement = Placement::RoundRobin;
+
+        std::size_t buffer_size = 16 * 1024;
+        std::size_t buffers_per_reactor = 64;
+    };
+
+    /**
+     * @brief 单个 reactor 线程
+     *
+     * loop() 与 buffers() 只允许在该 reactor 线程内访问（跨线程请使用 post）。
+     */
+    class Reactor
+    {
+    private:
+        std::size_t m_index;
+        int m_cpu = -1;
+        bool m_pinned = false;
+
+        std::unique_ptr<EventLoop> m_loop;
+        util::BufferPool m_buffers;
+        std::thread m_thread;
+
+        std::atomic<std::size_t> m_load{0};
+        std::atomic<std::uint64_t> m_assigned{0};
+
+    public:
+        Reactor(std::size_t index,
+                std::unique_ptr<EventLoop> loop,
+                std::size_t buffer_size,
+                std::size_t buffers);
+
+        Reactor(const Reactor &) = delete;
+        Reactor &operator=(const Reactor &) = delete;
+
+    public:
+        std::size_t index() const noexcept { return m_index; }
+        int cpu() const noexcept { return m_cpu; }
+        bool pinned() const noexcept { return m_pinned; }
+
+        EventLoop &loop() noexcept { return *m_loop; }
+        util::BufferPool &buffers() noexcept { return m_buffers; }
+
+        void post(Task fn) { m_loop->post(std::move(fn)); }
+
+        /** 当前活跃会话数 */
+        std::size_t load() const noexcept { return m_load.load(std::memory_order_relaxed); }
+        /** 累计分配到的会话数 */
+        std::uint64_t assigned() const noexcept { return m_assigned.load(std::memory_order_relaxed); }
+
+        /** 会话结束时调用，归还负载计数 */
+        void release() noexcept { m_load.fetch_sub(1, std::memory_order_relaxed); }
+
+    private:
+        friend class ReactorPool;
+
+        void acquire() noexcept
+        {
+            m_load.fetch_add(1, std::memory_order_relaxed);
+            m_assigned.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void start(int cpu, bool pin);
+        void join();
+    };
+
+    /**
+     * @brief 多 reactor 线程池
+     */
+    class ReactorPool
+    {
+    private:
+        ReactorPoolOptions m_opts;
+        std::vector<std::unique_ptr<Reactor>> m_reactors;
+        std::atomic<std::size_t> m_next{0};
+        bool m_running = false;
+
+    public:
+        static util::ResultV<std::unique_ptr<ReactorPool>>
+        create(ReactorPoolOptions opts = {});
+
+    private:
+        explicit ReactorPool(ReactorPoolOptions opts) : m_opts(opts) {}
+
+    public:
+        ~ReactorPool();
+
+        ReactorPool(const ReactorPool &) = delete;
+        ReactorPool &operator=(const ReactorPool &) = delete;
+
+    public:
+        /** 启动全部 reactor 线程 */
+        void start();
+
+        /** 请求全部 reactor 退出并等待线程结束 */
+        void stop();
+
+        std::size_t size() const noexcept { return m_reactors.size(); }
+        Reactor &at(std::size_t i) noexcept { return *m_reactors[i]; }
+        const ReactorPoolOptions &options() const noexcept { return m_opts; }
+
+        /**
+         * @brief 为新会话选择 reactor 并计入其负载
+         *
+         * 会话结束时需调用 Reactor::release()。
+         */
+        Reactor &assign();
+
+        /**
+         * @brief 把会话任务分配到某个 reactor 上执行
+         *
+         * 任务返回即视为会话结束并归还负载；
+         * 跨越多轮事件循环的异步会话请改用 assign() 并自行 release()。
+         *
+         * @return 被选中的 reactor 下标
+         */
+        std::size_t submit(Task fn);
+
+    private:
+        std::size_t pick() noexcept;
+    };
+}
+
+#endif // INCLUDE_EUNET_PLATFORM_REACTOR_POOL
@@ -0,0 +1,235 @@
+/*
+ * ============================================================================
+ *  File Name   : scheduler.hpp
+ *  Module      : platform/sched
+ *
+ *  Description :
+ *      CPU 侧工作窃取调度器。报文解析、载荷拷贝、十六进制格式化、
+ *      指标聚合等计算任务从 emit 调用线程卸载到这里执行。
+ *      每个 worker 按优先级各持有一个 Chase-Lev 队列，空闲时随机选择
+ *      其他 worker 窃取；高优先级（IO 续体）永远先于批量分析任务被取出。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_PLATFORM_SCHEDULER
+#define INCLUDE_EUNET_PLATFORM_SCHEDULER
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/util/mpsc_queue.hpp"
+#include "eunet/util/ws_deque.hpp"
+
+namespace platform::sched
+{
+    using Job = std::function<void()>;
+
+    /**
+     * @brief 任务优先级，数值越小越先执行
+     */
+    enum class Priority : std::uint8_t
+    {
+        High = 0,   // IO 续体等延迟敏感任务
+        Normal = 1, // 默认
+        Low = 2,    // 批量分析、格式化等可延后任务
+    };
+
+    inline constexpr std::size_t PRIORITY_COUNT = 3;
+
+    struct SchedulerOptions
+    {
+        std::size_t threads = 0;      // 0 表示使用 hardware_concurrency
+        std::size_t spin_rounds = 64; // 找不到任务时进入休眠前的让出次数
+        std::size_t deque_capacity = 256;
+    };
+
+    /**
+     * @brief 单个 worker 的统计快照
+     */
+    struct WorkerStats
+    {
+        std::uint64_t executed = 0;
+        std::uint64_t stolen = 0;       // 从其他 worker 窃取成功的任务数
+        std::uint64_t steal_misses = 0; // 完整一轮窃取均落空的次数
+        std::uint64_t idle_sleeps = 0;  // 进入休眠的次数
+        std::uint64_t idle_ns = 0;      // 累计休眠时长
+    };
+
+    /**
+     * @brief 调度器统计快照
+     */
+    struct SchedulerStats
+    {
+        std::uint64_t submitted = 0;
+        std::uint64_t executed = 0;
+        std::uint64_t stolen = 0;
+        std::uint64_t steal_misses = 0;
+        std::uint64_t idle_sleeps = 0;
+        std::uint64_t idle_ns = 0;
+        std::array<std::uint64_t, PRIORITY_COUNT> executed_by_priority{};
+
+        std::vector<WorkerStats> workers;
+    };
+
+    /**
+     * @brief 工作窃取线程池
+     *
+     * submit() 线程安全：在本调度器的 worker 线程内提交时压入自身队列，
+     * 其他线程提交时进入按优先级划分的全局注入队列。
+     * 调度器内部以 worker 地址作为线程局部标识，因此不可移动，通过 create() 构造于堆上。
+     */
+    class Scheduler
+    {
+    private:
+        struct Node
+        {
+            Job fn;
+            Priority prio;
+        };
+
+        using Deque = util::WorkStealingDeque<Node *>;
+
+        struct alignas(64) Counters
+        {
+            std::atomic<std::uint64_t> executed{0};
+            std::atomic<std::uint64_t> stolen{0};
+            std::atomic<std::uint64_t> steal_misses{0};
+            std::atomic<std::uint64_t> idle_sleeps{0};
+            std::atomic<std::uint64_t> idle_ns{0};
+        };
+
+        struct Worker
+        {
+            std::size_t index;
+            std::array<std::unique_ptr<Deque>, PRIORITY_COUNT> deques;
+            Counters counters;
+            std::uint64_t rng; // xorshift 状态，用于随机选择窃取对象
+            std::thread thread;
+        };
+
+        // 外部线程提交的任务，按优先级各一条
+        struct Injector
+        {
+            std::mutex mtx;
+            std::deque<Node *> queue;
+            std::atomic<std::size_t> size{0};
+        };
+
+    private:
+        SchedulerOptions m_opts;
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::array<Injector, PRIORITY_COUNT> m_injectors;
+
+        // 休眠 / 唤醒：提交时推进 m_epoch，worker 在 epoch 未变化时休眠
+        std::atomic<std::uint32_t> m_epoch{0};
+        std::atomic<std::size_t> m_sleepers{0};
+
+        std::atomic<std::uint64_t> m_submitted{0};
+        std::array<std::atomic<std::uint64_t>, PRIORITY_COUNT> m_executed_by_prio{};
+        std::atomic<std::size_t> m_outstanding{0};
+
+        std::atomic<bool> m_stop{false};
+        bool m_running = false;
+
+    public:
+        static util::ResultV<std::unique_ptr<Scheduler>>
+        create(SchedulerOptions opts = {});
+
+    private:
+        explicit Scheduler(SchedulerOptions opts) : m_opts(opts) {}
+
+    public:
+        ~Scheduler();
+
+        Scheduler(const Scheduler &) = delete;
+        Scheduler &operator=(const Scheduler &) = delete;
+
+    public:
+        /** 启动全部 worker 线程；启动前提交的任务会在启动后执行 */
+        void start();
+
+        /**
+         * @brief 停止调度器
+         *
+         * 已提交的任务（包括执行期间派生的任务）全部执行完毕后 worker 才退出。
+         */
+        void stop();
+
+        /** 提交任务（线程安全） */
+        void submit(Job fn, Priority prio = Priority::Normal);
+
+        /** 阻塞等待所有已提交任务执行完毕（不可在 worker 线程内调用） */
+        void wait_idle();
+
+        /** 当前线程是否为本调度器的 worker */
+        bool in_worker() const noexcept;
+
+        std::size_t size() const noexcept { return m_workers.size(); }
+        std::size_t outstanding() const noexcept { return m_outstanding.load(std::memory_order_acquire); }
+
+        SchedulerStats stats() const;
+
+    private:
+        void run_worker(Worker &w);
+        Node *find_work(Worker &w);
+        Node *steal_from_others(Worker &w, std::size_t prio);
+        Node *pop_injected(std::size_t prio);
+        void execute(Worker &w, Node *node);
+        void wake_one();
+    };
+
+    /**
+     * @brief 串行执行器
+     *
+     * 投递到同一个 Strand 的任务在调度器上按投递顺序逐个执行，互不并发，
+     * 适合把有状态的处理（如某个 Sink）整体卸载到调度器上。
+     * Strand 析构时会等待已投递任务执行完毕，调度器需在此之前保持运行。
+     */
+    class Strand
+    {
+    private:
+        static constexpr std::size_t BATCH = 256;
+
+        Scheduler &m_sched;
+        Priority m_prio;
+        util::MpscQueue<Job> m_queue;
+        std::atomic<std::size_t> m_pending{0};
+
+    public:
+        explicit Strand(Scheduler &sched, Priority prio = Priority::Normal)
+            : m_sched(sched), m_prio(prio) {}
+
+        ~Strand();
+
+        Strand(const Strand &) = delete;
+        Strand &operator=(const Strand &) = delete;
+
+    public:
+        /** 投递任务（线程安全） */
+        void post(Job fn);
+
+        std::size_t pending() const noexcept { return m_pending.load(std::memory_order_acquire); }
+
+    private:
+        void run_batch();
+    };
+}
+
+#endif // INCLUDE_EUNET_PLATFORM_SCHEDULER
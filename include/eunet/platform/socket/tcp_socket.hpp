@@ -24,16 +24,36 @@
 #include "eunet/platform/base_socket.hpp"
 #include "eunet/platform/net/common.hpp"
 #include "eunet/platform/net/endpoint.hpp"
+#include "eunet/platform/net/tcp_info.hpp"
+#include "eunet/platform/net/socket_options.hpp"
 
 namespace platform::net
 {
     class TCPSocket final
         : public BaseSocket
     {
+    private:
+        SocketOptions m_options;
+        AppliedSocketOptions m_applied;
+
+        // TCP_FASTOPEN_CONNECT 不可用时 连接推迟到首次写入 由 MSG_FASTOPEN 携带数据发起
+        std::optional<Endpoint> m_fastopen_peer;
+
+        // SYN 已随首次写入发出 尚待 finish_connect() 确认握手结果
+        bool m_fastopen_handshake = false;
+
     public:
+        /**
+         * @brief 创建 TCP 套接字并应用创建期调优选项
+         *
+         * @param poller 等待 IO 就绪所用的 Poller
+         * @param af 地址族
+         * @param opts 套接字调优配置，默认不做任何设置
+         */
         static util::ResultV<TCPSocket> create(
             poller::Poller &poller,
-            AddressFamily af = AddressFamily::IPv4);
+            AddressFamily af = AddressFamily::IPv4,
+            const SocketOptions &opts = {});
 
     public:
         explicit TCPSocket(
@@ -56,6 +76,68 @@ namespace platform::net
 
         util::ResultV<void>
         connect(const Endpoint &ep, int timeout_ms = -1) override;
+
+    public:
+        /**
+         * @brief 单次非阻塞读取
+         *
+         * 不等待就绪；暂无数据时返回 Busy 错误，由调用方（如协程）等待可读后重试。
+         */
+        IOResult try_read(util::ByteBuffer &buf);
+
+        /**
+         * @brief 单次非阻塞写入
+         *
+         * 发送缓冲区已满时返回 Busy 错误。推迟的 Fast Open 连接同样由此发起，
+         * 没有 cookie 时内核只发出 SYN，返回 Busy，等待可写后重试；
+         * 写完后 connect_pending() 仍为 true 时需等待可写并调用 finish_connect()。
+         */
+        IOResult try_write(util::ByteBuffer &buf);
+
+        /**
+         * @brief 发起非阻塞连接，不等待完成
+         *
+         * @return true 表示连接已立即建立（或推迟到首次写入）；
+         *         false 表示连接进行中，需等待可写后调用 finish_connect()
+         */
+        util::ResultV<bool> start_connect(const Endpoint &ep);
+
+        /**
+         * @brief 可写后确认连接结果并应用连接期选项
+         */
+        util::ResultV<void> finish_connect();
+
+        /**
+         * @brief 连接是否尚未确认
+         *
+         * 推迟的 Fast Open 连接在首次写入前、以及 SYN 发出后握手确认前为 true；
+         * 同步 write() 返回时已完成确认。
+         */
+        bool connect_pending() const noexcept
+        {
+            return m_fastopen_peer.has_value() || m_fastopen_handshake;
+        }
+
+    public:
+        /**
+         * @brief 按需读取内核 TCP_INFO
+         *
+         * @return util::ResultV<TcpInfo> 当前连接的内核统计
+         */
+        util::ResultV<TcpInfo> tcp_info() const;
+
+        const SocketOptions &options() const noexcept { return m_options; }
+
+        /** 创建期与连接期实际应用的选项记录 */
+        const AppliedSocketOptions &applied_options() const noexcept { return m_applied; }
+
+    private:
+        IOResult recv_once(util::ByteBuffer &buf, int flags);
+        IOResult send_once(util::ByteBuffer &buf, int flags);
+        IOResult write_fastopen(util::ByteBuffer &buf);
+        IOResult write_fastopen_all(util::ByteBuffer &buf, int timeout_ms);
+        void apply_connect_options();
+        bool fastopen_connect_enabled() const noexcept;
     };
 }
 #endif // INCLUDE_EUNET_PLATFORM_SOCKET_TCP_SOCKET
\ No newline at end of file
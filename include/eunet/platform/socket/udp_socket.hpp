@@ -57,6 +57,13 @@ namespace platform::net
 
         util::ResultV<void>
         connect(const Endpoint &ep, int timeout_ms = -1) override;
+
+    public:
+        /** 单次非阻塞收取一个数据报，暂无数据时返回 Busy 错误 */
+        IOResult try_read(util::ByteBuffer &buf);
+
+        /** 单次非阻塞发送，发送缓冲区已满时返回 Busy 错误 */
+        IOResult try_write(util::ByteBuffer &buf);
     };
 }
 
@@ -6,6 +6,9 @@
  *  Description :
  *      时间与时钟的封装。区分单调时钟 (Monotonic Clock，用于计时)
  *      和墙上时钟 (Wall Clock，用于展示)。提供时间点计算和格式化功能。
+ *      事件时钟 (Event Clock) 为事件打点专用：不受 NTP 调整影响，
+ *      在具备不变 TSC 的 x86 上直接读 TSC 并按校准系数换算为纳秒，
+ *      否则使用 vDSO 中的 CLOCK_MONOTONIC_RAW；展示时借助墙上时间锚点换算。
  *
  *  Third-Party Dependencies :
  *      None
@@ -20,6 +23,9 @@
 #define INCLUDE_EUNET_PLATFORM_TIME
 
 #include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string>
 
 namespace platform::time
 {
@@ -49,9 +55,65 @@ namespace platform::time
     void sleep_for(Duration d);
     void sleep_until(MonoPoint tp);
 
+    // 事件时钟（单调纳秒，进程内可比较）
+    enum class EventClockSource
+    {
+        MonotonicRaw, // clock_gettime(CLOCK_MONOTONIC_RAW)，经 vDSO 无系统调用
+        Tsc,          // rdtsc + 启动时对 CLOCK_MONOTONIC_RAW 的校准
+    };
+
+    /** 进程首次使用事件时钟时选定的时钟源 */
+    EventClockSource event_clock_source() noexcept;
+
+    /** 当前事件时钟读数（纳秒） */
+    std::int64_t event_now() noexcept;
+
+    /** CLOCK_MONOTONIC_RAW 读数（纳秒） */
+    std::int64_t monotonic_raw_ns() noexcept;
+
+    /** 两个事件时钟读数之差 */
+    inline std::chrono::nanoseconds event_elapsed(std::int64_t from, std::int64_t to) noexcept
+    {
+        return std::chrono::nanoseconds(to - from);
+    }
+
+    /**
+     * @brief 墙上时间锚点
+     *
+     * 同一时刻的事件时钟读数与墙上时间，用于把事件时钟读数换算成可展示的时间。
+     * 换算只做整数加减，同一锚点下双向换算可精确往返。
+     */
+    struct WallAnchor
+    {
+        std::int64_t event_ns = 0;
+        WallPoint wall{};
+
+        static WallAnchor capture() noexcept;
+
+        WallPoint to_wall(std::int64_t ns) const noexcept
+        {
+            return wall + std::chrono::duration_cast<WallClock::duration>(
+                              std::chrono::nanoseconds(ns - event_ns));
+        }
+
+        std::int64_t from_wall(WallPoint tp) const noexcept
+        {
+            return event_ns +
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(tp - wall).count();
+        }
+    };
+
+    /** 进程级锚点，首次使用时捕获且之后不再变化 */
+    const WallAnchor &process_anchor() noexcept;
+
+    /** 以进程级锚点换算 */
+    inline WallPoint event_to_wall(std::int64_t ns) noexcept { return process_anchor().to_wall(ns); }
+    inline std::int64_t event_from_wall(WallPoint tp) noexcept { return process_anchor().from_wall(tp); }
+
 }
 
 std::string to_string(platform::time::MonoPoint tp);
 std::string to_string(platform::time::WallPoint tp);
+std::string to_string(platform::time::EventClockSource src);
 
 #endif // INCLUDE_EUNET_PLATFORM_TIME
\ No newline at end of file
@@ -0,0 +1,226 @@
+/*
+ * ============================================================================
+ *  File Name   : timer.hpp
+ *  Module      : platform/timer
+ *
+ *  Description :
+ *      分层时间轮定时器。4 层 x 64 槽，节点以侵入式双向链表挂在槽上，
+ *      添加 / 取消均为 O(1)，到期时按槽批量触发。
+ *      TimerService 以单个 timerfd 驱动时间轮，并注册到 Poller 中，
+ *      使成千上万个独立的截止时间（连接、空闲、请求、重试）共享一次唤醒。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_PLATFORM_TIMER
+#define INCLUDE_EUNET_PLATFORM_TIMER
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+#include "eunet/platform/fd.hpp"
+#include "eunet/platform/time.hpp"
+#include "eunet/platform/poller.hpp"
+
+namespace platform::timer
+{
+    using Tick = std::uint64_t;
+    using Callback = std::function<void()>;
+
+    /**
+     * @brief 定时器句柄
+     *
+     * 由节点下标与代数组成，节点复用后旧句柄自动失效，
+     * 重复取消或取消已触发的定时器都是安全的。
+     */
+    struct TimerId
+    {
+        std::uint32_t index = UINT32_MAX;
+        std::uint32_t generation = 0;
+
+        bool valid() const noexcept { return index != UINT32_MAX; }
+    };
+
+    /**
+     * @brief 分层时间轮
+     *
+     * 纯数据结构，不涉及系统调用，由调用方通过 advance() 推进。
+     * 截止时间向上取整到 tick，保证定时器不会提前触发。
+     */
+    class TimerWheel
+    {
+    public:
+        static constexpr std::size_t SLOT_BITS = 6;
+        static constexpr std::size_t SLOTS = 1u << SLOT_BITS;
+        static constexpr std::size_t LEVELS = 4;
+
+        // 超过该跨度的截止时间先挂在最高层，到期前会被重新分层
+        static constexpr Tick MAX_SPAN = (Tick{1} << (SLOT_BITS * LEVELS)) - 1;
+
+    private:
+        static constexpr std::uint32_t NIL = UINT32_MAX;
+
+        // 每层 64 个槽 + 已过期链表 + 正在触发链表
+        static constexpr std::size_t OVERDUE = SLOTS * LEVELS;
+        static constexpr std::size_t FIRING = OVERDUE + 1;
+        static constexpr std::size_t LIST_COUNT = FIRING + 1;
+
+        struct Node
+        {
+            Tick expires = 0;
+            std::uint32_t prev = NIL;
+            std::uint32_t next = NIL;
+            std::uint32_t list = NIL; // 所在链表，NIL 表示空闲
+            std::uint32_t generation = 0;
+            Callback cb;
+        };
+
+    private:
+        platform::time::MonoPoint m_origin;
+        std::chrono::nanoseconds m_resolution;
+        Tick m_now = 0;
+
+        std::vector<Node> m_nodes;
+        std::vector<std::uint32_t> m_free;
+        std::array<std::uint32_t, LIST_COUNT> m_heads;
+        std::array<std::uint64_t, LEVELS> m_occupied{}; // 每层非空槽位图
+        std::size_t m_size = 0;
+
+    public:
+        explicit TimerWheel(
+            std::chrono::nanoseconds resolution = std::chrono::milliseconds(1),
+            platform::time::MonoPoint origin = platform::time::monotonic_now());
+
+    public:
+        /**
+         * @brief 在绝对截止时间上添加定时器
+         *
+         * 可直接传入 platform::time::deadline_after() 的结果。
+         * 已过期的截止时间会在下一次 advance() 时触发。
+         */
+        TimerId schedule(platform::time::MonoPoint deadline, Callback cb);
+
+        TimerId schedule_after(std::chrono::nanoseconds delay, Callback cb);
+
+        /**
+         * @brief 取消定时器
+         *
+         * @return 定时器仍在等待并被成功取消时返回 true
+         */
+        bool cancel(TimerId id) noexcept;
+
+        bool pending(TimerId id) const noexcept;
+
+        /**
+         * @brief 推进时间轮并批量触发到期定时器
+         *
+         * 回调中可以安全地添加或取消其他定时器。
+         *
+         * @param now 当前单调时间
+         * @return 本次触发的定时器数量
+         */
+        std::size_t advance(platform::time::MonoPoint now);
+
+        /**
+         * @brief 下一次需要推进时间轮的时刻
+         *
+         * 可能早于真实的最早截止时间（高层槽需要先下放），
+         * 但绝不会晚于它。没有定时器时返回 nullopt。
+         */
+        std::optional<platform::time::MonoPoint> next_wakeup() const noexcept;
+
+        std::size_t size() const noexcept { return m_size; }
+        bool empty() const noexcept { return m_size == 0; }
+        std::chrono::nanoseconds resolution() const noexcept { return m_resolution; }
+
+    private:
+        Tick tick_ceil(platform::time::MonoPoint tp) const noexcept;
+        Tick tick_floor(platform::time::MonoPoint tp) const noexcept;
+        platform::time::MonoPoint point_of(Tick t) const noexcept;
+
+        std::uint32_t alloc_node();
+        void release_node(std::uint32_t idx) noexcept;
+
+        void place(std::uint32_t idx) noexcept;
+        void link(std::uint32_t idx, std::size_t list) noexcept;
+        void unlink(std::uint32_t idx) noexcept;
+
+        void cascade(std::size_t list) noexcept;
+        std::size_t fire_list(std::size_t list);
+    };
+
+    /**
+     * @brief 由 timerfd 驱动的定时器服务
+     *
+     * 持有一个 CLOCK_MONOTONIC timerfd，始终按时间轮的下一次唤醒时刻
+     * 以绝对时间装填。timerfd 注册进 Poller 后，读就绪时调用 dispatch()。
+     */
+    class TimerService
+    {
+    private:
+        platform::fd::Fd m_tfd;
+        TimerWheel m_wheel;
+        std::optional<platform::time::MonoPoint> m_armed;
+
+    public:
+        static util::ResultV<TimerService> create(
+            std::chrono::nanoseconds resolution = std::chrono::milliseconds(1));
+
+    private:
+        TimerService(platform::fd::Fd tfd, std::chrono::nanoseconds resolution);
+
+    public:
+        TimerService(const TimerService &) = delete;
+        TimerService &operator=(const TimerService &) = delete;
+
+        TimerService(TimerService &&) noexcept = default;
+        TimerService &operator=(TimerService &&) noexcept = default;
+
+    public:
+        platform::fd::FdView fd() const noexcept { return m_tfd.view(); }
+
+        /**
+         * @brief 将 timerfd 注册到 Poller
+         *
+         * @param poller 目标 Poller
+         * @param tag 非空时以用户数据指针方式注册，便于高吞吐模式分发
+         */
+        util::ResultV<void> attach(
+            platform::poller::Poller &poller,
+            void *tag = nullptr);
+
+        util::ResultV<TimerId> schedule(platform::time::MonoPoint deadline, Callback cb);
+        util::ResultV<TimerId> schedule_after(std::chrono::nanoseconds delay, Callback cb);
+        bool cancel(TimerId id) noexcept { return m_wheel.cancel(id); }
+
+        /**
+         * @brief 处理 timerfd 读就绪
+         *
+         * 读出到期计数、推进时间轮并重新装填 timerfd。
+         *
+         * @return 本次触发的定时器数量
+         */
+        util::ResultV<std::size_t> dispatch();
+
+        const TimerWheel &wheel() const noexcept { return m_wheel; }
+        std::size_t size() const noexcept { return m_wheel.size(); }
+
+    private:
+        util::ResultV<void> rearm();
+    };
+}
+
+#endif // INCLUDE_EUNET_PLATFORM_TIMER
@@ -53,9 +53,10 @@ namespace ui
      */
     class TuiApp
     {
-    private:
+    public:
         static constexpr size_t MAX_EVENTS = 2000;
 
+    private:
         core::Orchestrator &orch_;
         core::NetworkEngine &engine_;
 
@@ -97,6 +98,14 @@ namespace ui
          */
         void run();
 
+        /**
+         * @brief 离线浏览：以给定快照替换当前列表
+         *
+         * 用于展示从追踪文件读回的事件，超出 MAX_EVENTS 的部分只保留最后的若干条。
+         * 需在 run() 之前调用。
+         */
+        void load(std::vector<core::EventSnapshot> snaps);
+
     private:
         // ============================================================
         // init
@@ -0,0 +1,82 @@
+/*
+ * ============================================================================
+ *  File Name   : buffer_pool.hpp
+ *  Module      : util
+ *
+ *  Description :
+ *      ByteBuffer 对象池。归还的缓冲区清空读写指针后缓存复用，
+ *      避免每次收发都向分配器申请内存。非线程安全，
+ *      设计为每个 reactor 线程独占一个实例。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_UTIL_BUFFER_POOL
+#define INCLUDE_EUNET_UTIL_BUFFER_POOL
+
+#include <cstddef>
+#include <vector>
+
+#include "eunet/util/byte_buffer.hpp"
+
+namespace util
+{
+    class BufferPool
+    {
+    private:
+        std::vector<ByteBuffer> m_free;
+        std::size_t m_buffer_size;
+        std::size_t m_max_cached;
+
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+
+    public:
+        /**
+         * @param buffer_size 新建缓冲区的初始容量
+         * @param max_cached 最多缓存的空闲缓冲区数量，超出部分直接释放
+         */
+        explicit BufferPool(std::size_t buffer_size = 16 * 1024, std::size_t max_cached = 64)
+            : m_buffer_size(buffer_size), m_max_cached(max_cached)
+        {
+            m_free.reserve(max_cached);
+        }
+
+    public:
+        ByteBuffer acquire()
+        {
+            if (m_free.empty())
+            {
+                ++m_misses;
+                return ByteBuffer(m_buffer_size);
+            }
+
+            ++m_hits;
+            ByteBuffer buf = std::move(m_free.back());
+            m_free.pop_back();
+            return buf;
+        }
+
+        void release(ByteBuffer &&buf)
+        {
+            if (m_free.size() >= m_max_cached)
+                return;
+
+            buf.clear();
+            m_free.push_back(std::move(buf));
+        }
+
+        std::size_t cached() const noexcept { return m_free.size(); }
+        std::size_t hits() const noexcept { return m_hits; }
+        std::size_t misses() const noexcept { return m_misses; }
+        std::size_t buffer_size() const noexcept { return m_buffer_size; }
+    };
+}
+
+#endif // INCLUDE_EUNET_UTIL_BUFFER_POOL
@@ -250,8 +250,17 @@ namespace util
         ErrorCategory category() const noexcept;
         int code() const noexcept;
         std::string message() const noexcept;
+        ErrorSeverity severity() const noexcept;
+        std::string context() const noexcept;
         const Error *cause() const noexcept;
 
+        /**
+         * @brief 错误链上第一个有明确分类的类别
+         *
+         * 包装层通常只设置领域与描述，真正的分类（如 ConnectionRefused）在原因错误上。
+         */
+        ErrorCategory root_category() const noexcept;
+
         std::string format() const;
     };
 
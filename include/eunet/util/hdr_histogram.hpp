@@ -0,0 +1,114 @@
+/*
+ * ============================================================================
+ *  File Name   : hdr_histogram.hpp
+ *  Module      : util
+ *
+ *  Description :
+ *      HDR（High Dynamic Range）直方图。按 2 的幂分桶、桶内线性细分，
+ *      在整个量程内保持固定的相对精度，记录 O(1)、内存固定，
+ *      用于延迟分布与尾延迟百分位统计。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_UTIL_HDR_HISTOGRAM
+#define INCLUDE_EUNET_UTIL_HDR_HISTOGRAM
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util
+{
+    /**
+     * @brief HDR 直方图
+     *
+     * 数值单位由调用方决定（通常为微秒）。
+     * 超出 highest 的数值按 highest 记录，并计入 clamped()。
+     * 非线程安全；多线程场景下各自记录后 merge()。
+     */
+    class HdrHistogram
+    {
+    private:
+        std::int64_t m_lowest;
+        std::int64_t m_highest;
+        int m_sig_figs;
+
+        int m_unit_magnitude;
+        int m_sub_bucket_half_count_magnitude;
+        std::int64_t m_sub_bucket_count;
+        std::int64_t m_sub_bucket_half_count;
+        std::int64_t m_sub_bucket_mask;
+        int m_bucket_count;
+
+        std::vector<std::uint64_t> m_counts;
+        std::uint64_t m_total = 0;
+        std::uint64_t m_clamped = 0;
+        std::int64_t m_min;
+        std::int64_t m_max = 0;
+        double m_sum = 0.0;
+
+    public:
+        /**
+         * @param lowest 可区分的最小值（>= 1）
+         * @param highest 可记录的最大值（>= 2 * lowest）
+         * @param significant_figures 有效数字位数（1 ~ 5）
+         */
+        explicit HdrHistogram(
+            std::int64_t lowest = 1,
+            std::int64_t highest = 60'000'000,
+            int significant_figures = 3);
+
+    public:
+        void record(std::int64_t value, std::uint64_t count = 1) noexcept;
+
+        /** 合并另一个直方图，两者的量程与精度需一致 */
+        bool merge(const HdrHistogram &other) noexcept;
+
+        void reset() noexcept;
+
+    public:
+        /**
+         * @brief 百分位数值
+         *
+         * @param percentile 取值 [0, 100]
+         * @return 该百分位所在等价区间的上界，直方图为空时返回 0
+         */
+        std::int64_t value_at_percentile(double percentile) const noexcept;
+
+        std::uint64_t total_count() const noexcept { return m_total; }
+        std::uint64_t clamped() const noexcept { return m_clamped; }
+        std::int64_t min() const noexcept { return m_total ? m_min : 0; }
+        std::int64_t max() const noexcept { return m_max; }
+        double mean() const noexcept { return m_total ? m_sum / static_cast<double>(m_total) : 0.0; }
+
+        std::int64_t lowest_trackable() const noexcept { return m_lowest; }
+        std::int64_t highest_trackable() const noexcept { return m_highest; }
+        int significant_figures() const noexcept { return m_sig_figs; }
+
+        /** 与 value 落在同一计数槽内的最大值 */
+        std::int64_t highest_equivalent(std::int64_t value) const noexcept;
+
+        /** 与 value 落在同一计数槽内的最小值 */
+        std::int64_t lowest_equivalent(std::int64_t value) const noexcept;
+
+        /** 计数槽数量，即内存占用（单位：计数器） */
+        std::size_t slot_count() const noexcept { return m_counts.size(); }
+
+    private:
+        int bucket_index(std::int64_t value) const noexcept;
+        int sub_bucket_index(std::int64_t value, int bucket) const noexcept;
+        std::size_t counts_index(int bucket, int sub_bucket) const noexcept;
+        std::size_t counts_index_for(std::int64_t value) const noexcept;
+        std::int64_t value_at_index(std::size_t index) const noexcept;
+        std::int64_t value_from(int bucket, int sub_bucket) const noexcept;
+    };
+}
+
+#endif // INCLUDE_EUNET_UTIL_HDR_HISTOGRAM
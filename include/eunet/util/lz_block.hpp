@@ -0,0 +1,56 @@
+/*
+ * ============================================================================
+ *  File Name   : lz_block.hpp
+ *  Module      : util
+ *
+ *  Description :
+ *      LZ77 块压缩。格式与 LZ4 的块格式相同：由若干序列组成，每个序列
+ *      依次为标记字节（高 4 位字面量长度、低 4 位匹配长度 - 4）、
+ *      扩展长度、字面量、2 字节回溯距离与扩展匹配长度，最后一个序列只有字面量。
+ *      压缩以 4 字节哈希表贪心查找匹配，窗口 64 KiB；解压逐项校验边界，
+ *      不信任输入。适合在内存中压缩重复度高的载荷。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_UTIL_LZ_BLOCK
+#define INCLUDE_EUNET_UTIL_LZ_BLOCK
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+
+namespace util::lz
+{
+    /** 压缩 n 字节输入的最大输出长度 */
+    constexpr std::size_t max_compressed_size(std::size_t n) noexcept
+    {
+        return n + n / 255 + 16;
+    }
+
+    /**
+     * @brief 压缩 src，结果追加到 out 末尾
+     *
+     * @return 追加的字节数
+     */
+    std::size_t compress(std::span<const std::byte> src, std::vector<std::byte> &out);
+
+    /**
+     * @brief 解压到 dst
+     *
+     * @param dst 长度必须恰为原始长度
+     * @return 输入损坏、越界或长度不符时返回错误
+     */
+    ResultV<void> decompress(std::span<const std::byte> src, std::span<std::byte> dst);
+}
+
+#endif // INCLUDE_EUNET_UTIL_LZ_BLOCK
@@ -0,0 +1,148 @@
+/*
+ * ============================================================================
+ *  File Name   : mpsc_queue.hpp
+ *  Module      : util
+ *
+ *  Description :
+ *      无锁多生产者单消费者队列（Vyukov 链表式）。
+ *      生产者入队只需一次原子 exchange，消费者出队无需任何 CAS，
+ *      用于跨线程向 reactor 投递任务与事件。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_UTIL_MPSC_QUEUE
+#define INCLUDE_EUNET_UTIL_MPSC_QUEUE
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace util
+{
+    /**
+     * @brief 无锁 MPSC 队列
+     *
+     * push() 可由任意线程并发调用；try_pop() / pop_all() 只允许单一消费者线程调用。
+     * 队首始终保留一个哑节点，元素存放在哑节点之后的节点中。
+     *
+     * @tparam T 元素类型，需可移动构造
+     */
+    template <typename T>
+    class MpscQueue
+    {
+    private:
+        struct Node
+        {
+            std::atomic<Node *> next{nullptr};
+            std::optional<T> value;
+        };
+
+    private:
+        // 生产者与消费者各占一条缓存行，避免伪共享
+        alignas(64) std::atomic<Node *> m_head;
+        alignas(64) Node *m_tail;
+
+    public:
+        MpscQueue()
+        {
+            Node *stub = new Node();
+            m_head.store(stub, std::memory_order_relaxed);
+            m_tail = stub;
+        }
+
+        ~MpscQueue()
+        {
+            while (m_tail)
+            {
+                Node *next = m_tail->next.load(std::memory_order_relaxed);
+                delete m_tail;
+                m_tail = next;
+            }
+        }
+
+        MpscQueue(const MpscQueue &) = delete;
+        MpscQueue &operator=(const MpscQueue &) = delete;
+
+    public:
+        /**
+         * @brief 入队（线程安全）
+         */
+        void push(T value)
+        {
+            Node *n = new Node();
+            n->value.emplace(std::move(value));
+
+            Node *prev = m_head.exchange(n, std::memory_order_seq_cst);
+            // exchange 与下面的 store 之间队列处于“断链”状态，消费者会短暂等待
+            prev->next.store(n, std::memory_order_release);
+        }
+
+        /**
+         * @brief 尝试出队（仅消费者线程）
+         *
+         * 队列为空或生产者尚未完成链接时返回 nullopt。
+         */
+        std::optional<T> try_pop()
+        {
+            Node *next = m_tail->next.load(std::memory_order_acquire);
+            if (!next)
+                return std::nullopt;
+
+            std::optional<T> out(std::move(next->value));
+            next->value.reset();
+
+            delete m_tail;
+            m_tail = next;
+            return out;
+        }
+
+        /**
+         * @brief 取出元素并逐个交给 fn（仅消费者线程）
+         *
+         * 遇到生产者正处于断链窗口时自旋让出，保证调用前已完成的 push 都能被取到。
+         *
+         * @param fn 元素处理函数
+         * @param limit 本次最多处理的元素数，防止 fn 内持续入队导致无法返回
+         * @return 处理的元素数量
+         */
+        template <typename Fn>
+        std::size_t pop_all(Fn &&fn, std::size_t limit = SIZE_MAX)
+        {
+            std::size_t n = 0;
+            while (n < limit)
+            {
+                auto v = try_pop();
+                if (v)
+                {
+                    fn(std::move(*v));
+                    ++n;
+                    continue;
+                }
+
+                if (empty())
+                    break;
+
+                std::this_thread::yield();
+            }
+            return n;
+        }
+
+        /** 队列是否为空（仅消费者线程调用时结果可靠） */
+        bool empty() const noexcept
+        {
+            return m_head.load(std::memory_order_seq_cst) == m_tail;
+        }
+    };
+}
+
+#endif // INCLUDE_EUNET_UTIL_MPSC_QUEUE
@@ -0,0 +1,146 @@
+/*
+ * ============================================================================
+ *  File Name   : roaring_bitmap.hpp
+ *  Module      : util
+ *
+ *  Description :
+ *      Roaring 风格的压缩位图。32 位整数按高 16 位分块，每块按密度
+ *      选择有序 uint16 数组（稀疏）或 65536 位的位集（稠密）存放。
+ *      稠密块之间的交、并按 64 位字批量运算，支持 AVX2 的 x86-64 CPU 上
+ *      在运行时切换到 256 位向量实现。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_UTIL_ROARING_BITMAP
+#define INCLUDE_EUNET_UTIL_ROARING_BITMAP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace util
+{
+    /**
+     * @brief 压缩位图
+     *
+     * 按升序追加是最快的路径（Timeline 的下标即按此方式写入），
+     * 任意顺序的 add 也受支持。非线程安全。
+     */
+    class RoaringBitmap
+    {
+    public:
+        static constexpr std::size_t ARRAY_MAX = 4096;   // 超过该基数的块转为位集
+        static constexpr std::size_t BITSET_WORDS = 1024; // 65536 位
+
+    private:
+        struct Container
+        {
+            std::uint16_t key = 0;
+            std::uint32_t card = 0;
+            std::vector<std::uint16_t> array; // 稀疏块：有序低 16 位
+            std::vector<std::uint64_t> bits;  // 稠密块：非空即为位集
+
+            bool is_bitset() const noexcept { return !bits.empty(); }
+        };
+
+        std::vector<Container> m_containers; // 按 key 升序
+        std::size_t m_card = 0;
+
+    public:
+        void add(std::uint32_t v);
+        bool contains(std::uint32_t v) const noexcept;
+
+        /** 删除所有 >= v 的元素 */
+        void remove_from(std::uint32_t v);
+        void clear() noexcept;
+
+        std::size_t cardinality() const noexcept { return m_card; }
+        bool empty() const noexcept { return m_card == 0; }
+
+        /** 最小 / 最大元素，位图为空时返回 0 */
+        std::uint32_t minimum() const noexcept;
+        std::uint32_t maximum() const noexcept;
+
+        /** 交集 / 并集 */
+        static RoaringBitmap intersect(const RoaringBitmap &a, const RoaringBitmap &b);
+        static RoaringBitmap unite(const RoaringBitmap &a, const RoaringBitmap &b);
+
+        /** 交集的基数，不物化结果 */
+        static std::size_t intersect_count(const RoaringBitmap &a, const RoaringBitmap &b);
+
+        /** 按升序访问 [lo, hi) 内的元素，整块落在区间外的部分直接跳过 */
+        template <typename Fn>
+        void for_each(Fn &&fn, std::uint64_t lo = 0, std::uint64_t hi = UINT64_MAX) const
+        {
+            for (const auto &c : m_containers)
+            {
+                std::uint64_t base = static_cast<std::uint64_t>(c.key) << 16;
+                if (base + 65536 <= lo)
+                    continue;
+                if (base >= hi)
+                    break;
+
+                if (c.is_bitset())
+                {
+                    std::size_t w_begin = lo > base ? (lo - base) >> 6 : 0;
+                    std::size_t w_end = hi - base >= 65536 ? BITSET_WORDS : ((hi - base) + 63) >> 6;
+                    for (std::size_t w = w_begin; w < w_end; ++w)
+                    {
+                        std::uint64_t word = c.bits[w];
+                        while (word)
+                        {
+                            std::uint64_t v = base + w * 64 + static_cast<unsigned>(std::countr_zero(word));
+                            word &= word - 1;
+                            if (v >= lo && v < hi)
+                                fn(static_cast<std::uint32_t>(v));
+                        }
+                    }
+                }
+                else
+                {
+                    auto first = c.array.begin();
+                    if (lo > base)
+                        first = std::lower_bound(first, c.array.end(), lo - base);
+                    for (auto it = first; it != c.array.end(); ++it)
+                    {
+                        std::uint64_t v = base + *it;
+                        if (v >= hi)
+                            break;
+                        if (v >= lo)
+                            fn(static_cast<std::uint32_t>(v));
+                    }
+                }
+            }
+        }
+
+        std::vector<std::uint32_t> to_vector() const;
+
+        /** 占用的字节数（近似） */
+        std::size_t memory_bytes() const noexcept;
+
+        /** 当前进程使用的位集运算实现："avx2" 或 "scalar" */
+        static const char *simd_backend() noexcept;
+
+    private:
+        Container *find_or_insert(std::uint16_t key);
+        const Container *find(std::uint16_t key) const noexcept;
+
+        static void to_bitset(Container &c);
+        static void to_array(Container &c);
+
+        static Container intersect(const Container &a, const Container &b);
+        static Container unite(const Container &a, const Container &b);
+        static std::uint32_t intersect_count(const Container &a, const Container &b);
+    };
+}
+
+#endif // INCLUDE_EUNET_UTIL_ROARING_BITMAP
@@ -0,0 +1,221 @@
+/*
+ * ============================================================================
+ *  File Name   : task.hpp
+ *  Module      : util
+ *
+ *  Description :
+ *      C++20 协程任务类型。Task<T> 为惰性协程：创建后不执行，
+ *      被 co_await 时才开始运行，结束时通过对称转移恢复等待者，
+ *      深层嵌套的 co_await 链不会增长调用栈。
+ *      spawn() 把顶层 Task 挂到当前线程上独立运行，
+ *      协程帧随任务结束自动释放。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_UTIL_TASK
+#define INCLUDE_EUNET_UTIL_TASK
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace util
+{
+    template <typename T = void>
+    class Task;
+
+    namespace task_detail
+    {
+        struct PromiseBase
+        {
+            // 协程结束后需要恢复的等待者，顶层任务为 noop
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+
+                template <typename P>
+                std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<P> h) noexcept
+                {
+                    return h.promise().continuation;
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+
+            // 项目以 Result 传递错误，协程内逃逸的异常视为程序缺陷
+            void unhandled_exception() const noexcept { std::terminate(); }
+        };
+
+        template <typename T>
+        struct Promise : PromiseBase
+        {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            // 以模板转发直接构造，兼容只有 explicit 移动构造的 Result
+            template <typename U>
+            void return_value(U &&v)
+            {
+                value.emplace(std::forward<U>(v));
+            }
+        };
+
+        template <>
+        struct Promise<void> : PromiseBase
+        {
+            Task<void> get_return_object() noexcept;
+            void return_void() const noexcept {}
+        };
+    }
+
+    /**
+     * @brief 惰性协程任务
+     *
+     * 独占协程帧的所有权，析构时销毁协程帧。
+     * 只能被 co_await 一次（右值）或交给 spawn() 运行。
+     *
+     * @tparam T 协程返回值类型
+     */
+    template <typename T>
+    class [[nodiscard]] Task
+    {
+    public:
+        using promise_type = task_detail::Promise<T>;
+        using Handle = std::coroutine_handle<promise_type>;
+
+    private:
+        Handle m_handle;
+
+    public:
+        Task() noexcept = default;
+        explicit Task(Handle h) noexcept : m_handle(h) {}
+
+        Task(Task &&other) noexcept
+            : m_handle(std::exchange(other.m_handle, {})) {}
+
+        Task &operator=(Task &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (m_handle)
+                    m_handle.destroy();
+                m_handle = std::exchange(other.m_handle, {});
+            }
+            return *this;
+        }
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        ~Task()
+        {
+            if (m_handle)
+                m_handle.destroy();
+        }
+
+    public:
+        bool valid() const noexcept { return static_cast<bool>(m_handle); }
+        bool done() const noexcept { return !m_handle || m_handle.done(); }
+
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter
+            {
+                Handle h;
+
+                bool await_ready() const noexcept { return !h || h.done(); }
+
+                std::coroutine_handle<>
+                await_suspend(std::coroutine_handle<> waiter) noexcept
+                {
+                    h.promise().continuation = waiter;
+                    return h;
+                }
+
+                T await_resume()
+                {
+                    if constexpr (!std::is_void_v<T>)
+                        return T(std::move(*h.promise().value));
+                }
+            };
+            return Awaiter{m_handle};
+        }
+    };
+
+    namespace task_detail
+    {
+        template <typename T>
+        Task<T> Promise<T>::get_return_object() noexcept
+        {
+            return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+        }
+
+        inline Task<void> Promise<void>::get_return_object() noexcept
+        {
+            return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+        }
+
+        // 立即开始、结束时自动销毁的协程，用于承载顶层 Task
+        struct Detached
+        {
+            struct promise_type
+            {
+                Detached get_return_object() const noexcept { return {}; }
+                std::suspend_never initial_suspend() const noexcept { return {}; }
+                std::suspend_never final_suspend() const noexcept { return {}; }
+                void return_void() const noexcept {}
+                void unhandled_exception() const noexcept { std::terminate(); }
+            };
+        };
+
+        template <typename T, typename Fn>
+        Detached run_detached(Task<T> task, Fn on_done)
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                co_await std::move(task);
+                on_done();
+            }
+            else
+                on_done(co_await std::move(task));
+        }
+    }
+
+    /**
+     * @brief 在当前线程上启动顶层任务
+     *
+     * 任务立即运行到第一个挂起点，之后由 reactor 在 IO 就绪时恢复。
+     * 任务结束时调用 on_done（非 void 任务以结果为参数）。
+     */
+    template <typename T, typename Fn>
+    void spawn(Task<T> task, Fn on_done)
+    {
+        (void)task_detail::run_detached(std::move(task), std::move(on_done));
+    }
+
+    template <typename T>
+    void spawn(Task<T> task)
+    {
+        if constexpr (std::is_void_v<T>)
+            spawn(std::move(task), [] {});
+        else
+            spawn(std::move(task), [](T &&) {});
+    }
+}
+
+#endif // INCLUDE_EUNET_UTIL_TASK
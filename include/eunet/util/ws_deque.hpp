@@ -0,0 +1,188 @@
+/*
+ * ============================================================================
+ *  File Name   : ws_deque.hpp
+ *  Module      : util
+ *
+ *  Description :
+ *      无锁工作窃取双端队列（Chase-Lev）。
+ *      所有者线程在底部 push / pop（LIFO，缓存友好），
+ *      其他线程从顶部 steal（FIFO），只有争抢最后一个元素时才需要 CAS。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#ifndef INCLUDE_EUNET_UTIL_WS_DEQUE
+#define INCLUDE_EUNET_UTIL_WS_DEQUE
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace util
+{
+    /**
+     * @brief Chase-Lev 工作窃取队列
+     *
+     * push() / pop() 只允许所有者线程调用；steal() 可由任意线程并发调用。
+     * 环形缓冲区满时扩容为两倍，旧缓冲区延迟到析构时释放，
+     * 保证并发 steal 读到的旧缓冲区仍然有效。
+     *
+     * @tparam T 元素类型，需可平凡复制（通常为任务指针）
+     */
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    class WorkStealingDeque
+    {
+    private:
+        struct Ring
+        {
+            std::int64_t capacity;
+            std::int64_t mask;
+            std::unique_ptr<std::atomic<T>[]> slots;
+
+            explicit Ring(std::int64_t cap)
+                : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+
+            T get(std::int64_t i) const noexcept
+            {
+                return slots[i & mask].load(std::memory_order_relaxed);
+            }
+
+            void put(std::int64_t i, T v) noexcept
+            {
+                slots[i & mask].store(v, std::memory_order_relaxed);
+            }
+        };
+
+    private:
+        alignas(64) std::atomic<std::int64_t> m_top{0};
+        alignas(64) std::atomic<std::int64_t> m_bottom{0};
+        std::atomic<Ring *> m_ring;
+
+        // 扩容前的旧缓冲区（仅所有者线程访问）
+        std::vector<std::unique_ptr<Ring>> m_rings;
+
+    public:
+        /**
+         * @param capacity 初始容量，向上取整为 2 的幂
+         */
+        explicit WorkStealingDeque(std::size_t capacity = 256)
+        {
+            std::int64_t cap = 2;
+            while (cap < static_cast<std::int64_t>(capacity))
+                cap <<= 1;
+
+            m_rings.push_back(std::make_unique<Ring>(cap));
+            m_ring.store(m_rings.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkStealingDeque(const WorkStealingDeque &) = delete;
+        WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+    public:
+        /** 底部入队（仅所有者线程） */
+        void push(T v)
+        {
+            std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+            std::int64_t t = m_top.load(std::memory_order_acquire);
+            Ring *r = m_ring.load(std::memory_order_relaxed);
+
+            if (b - t > r->capacity - 1)
+                r = grow(r, t, b);
+
+            r->put(b, v);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+
+        /** 底部出队（仅所有者线程），队列为空或最后一个元素被窃取时返回 nullopt */
+        std::optional<T> pop()
+        {
+            std::int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+            Ring *r = m_ring.load(std::memory_order_relaxed);
+            m_bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t t = m_top.load(std::memory_order_relaxed);
+
+            if (t > b)
+            {
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T v = r->get(b);
+            if (t == b)
+            {
+                // 只剩一个元素时与窃取者竞争
+                bool won = m_top.compare_exchange_strong(
+                    t, t + 1,
+                    std::memory_order_seq_cst,
+                    std::memory_order_relaxed);
+                m_bottom.store(b + 1, std::memory_order_relaxed);
+                if (!won)
+                    return std::nullopt;
+            }
+            return v;
+        }
+
+        /** 顶部窃取（任意线程），队列为空或竞争失败时返回 nullopt */
+        std::optional<T> steal()
+        {
+            std::int64_t t = m_top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            std::int64_t b = m_bottom.load(std::memory_order_acquire);
+
+            if (t >= b)
+                return std::nullopt;
+
+            Ring *r = m_ring.load(std::memory_order_acquire);
+            T v = r->get(t);
+            if (!m_top.compare_exchange_strong(
+                    t, t + 1,
+                    std::memory_order_seq_cst,
+                    std::memory_order_relaxed))
+                return std::nullopt;
+            return v;
+        }
+
+        /** 近似元素数（并发下仅供参考） */
+        std::size_t size() const noexcept
+        {
+            std::int64_t b = m_bottom.load(std::memory_order_relaxed);
+            std::int64_t t = m_top.load(std::memory_order_relaxed);
+            return b > t ? static_cast<std::size_t>(b - t) : 0;
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+
+        std::size_t capacity() const noexcept
+        {
+            return static_cast<std::size_t>(m_ring.load(std::memory_order_relaxed)->capacity);
+        }
+
+    private:
+        Ring *grow(Ring *old, std::int64_t t, std::int64_t b)
+        {
+            auto next = std::make_unique<Ring>(old->capacity * 2);
+            for (std::int64_t i = t; i < b; ++i)
+                next->put(i, old->get(i));
+
+            Ring *r = next.get();
+            m_rings.push_back(std::move(next));
+            m_ring.store(r, std::memory_order_release);
+            return r;
+        }
+    };
+}
+
+#endif // INCLUDE_EUNET_UTIL_WS_DEQUE
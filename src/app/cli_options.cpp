@@ -0,0 +1,203 @@
+/*
+ * ============================================================================
+ *  File Name   : cli_options.cpp
+ *  Module      : app
+ *
+ *  Description :
+ *      命令行解析实现。时长、倍速与计数参数各自解析，最后统一检查
+ *      模式之间的互斥关系。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/app/cli_options.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+namespace app
+{
+    void print_usage(const char *prog)
+    {
+        std::cerr
+            << "Usage: " << prog << " [options] [url]\n"
+            << "  (no options)       interactive TUI with a single GET\n"
+            << "  -c <N>             connections to keep open (bench mode)\n"
+            << "  -t <N>             threads to use (bench mode)\n"
+            << "  -d <duration>      test duration, e.g. 10s, 500ms, 2m (bench mode)\n"
+            << "  --timeout <ms>     per-request timeout (bench mode)\n"
+            << "  --json             headless batch mode, NDJSON to stdout; accepts multiple urls\n"
+            << "  --events           with --json, also emit every raw event\n"
+            << "  --record <file>    also write every event to a binary trace file\n"
+            << "  --open <file>      browse a recorded trace file offline in the TUI\n"
+            << "  --replay <speed>   with --open, re-drive the trace at 1x / 10x / max speed\n"
+            << "  --spill <dir>      move old timeline segments to files in <dir> when over budget\n"
+            << "  --memory <MiB>     with --spill, in-memory timeline budget (default 256)\n";
+    }
+
+    namespace
+    {
+        // 解析 "10s" / "500ms" / "2m" / "10"（秒）
+        std::optional<std::chrono::milliseconds> parse_duration(std::string_view s)
+        {
+            char *end = nullptr;
+            std::string str(s);
+            double v = std::strtod(str.c_str(), &end);
+            if (end == str.c_str() || v < 0)
+                return std::nullopt;
+
+            std::string_view unit(end);
+            double ms;
+            if (unit.empty() || unit == "s")
+                ms = v * 1000.0;
+            else if (unit == "ms")
+                ms = v;
+            else if (unit == "m")
+                ms = v * 60'000.0;
+            else if (unit == "h")
+                ms = v * 3'600'000.0;
+            else
+                return std::nullopt;
+
+            return std::chrono::milliseconds(static_cast<long long>(ms));
+        }
+
+        // 解析 "1" / "2.5x" / "max"
+        std::optional<double> parse_speed(std::string_view s)
+        {
+            if (s == "max")
+                return 0.0;
+            if (!s.empty() && s.back() == 'x')
+                s.remove_suffix(1);
+
+            std::string str(s);
+            char *end = nullptr;
+            double v = std::strtod(str.c_str(), &end);
+            if (end == str.c_str() || *end != '\0' || v <= 0)
+                return std::nullopt;
+            return v;
+        }
+
+        std::optional<std::size_t> parse_count(std::string_view s)
+        {
+            std::string str(s);
+            char *end = nullptr;
+            long long v = std::strtoll(str.c_str(), &end, 10);
+            if (end == str.c_str() || *end != '\0' || v <= 0)
+                return std::nullopt;
+            return static_cast<std::size_t>(v);
+        }
+    }
+
+    std::optional<CliOptions> parse_args(int argc, char **argv)
+    {
+        CliOptions opts;
+
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg = argv[i];
+            auto next = [&]() -> std::optional<std::string_view>
+            {
+                if (i + 1 >= argc)
+                    return std::nullopt;
+                return std::string_view(argv[++i]);
+            };
+
+            if (arg == "-h" || arg == "--help")
+                return std::nullopt;
+
+            if (arg == "-c" || arg == "-t")
+            {
+                auto v = next();
+                auto n = v ? parse_count(*v) : std::nullopt;
+                if (!n)
+                    return std::nullopt;
+                (arg == "-c" ? opts.bench_cfg.connections : opts.bench_cfg.threads) = *n;
+                opts.bench = true;
+            }
+            else if (arg == "-d")
+            {
+                auto v = next();
+                auto d = v ? parse_duration(*v) : std::nullopt;
+                if (!d)
+                    return std::nullopt;
+                opts.bench_cfg.duration = *d;
+                opts.bench = true;
+            }
+            else if (arg == "--timeout")
+            {
+                auto v = next();
+                auto n = v ? parse_count(*v) : std::nullopt;
+                if (!n)
+                    return std::nullopt;
+                opts.bench_cfg.timeout_ms = static_cast<int>(*n);
+            }
+            else if (arg == "--json")
+                opts.json = true;
+            else if (arg == "--events")
+                opts.json_events = true;
+            else if (arg == "--record" || arg == "--open")
+            {
+                auto v = next();
+                if (!v || v->empty())
+                    return std::nullopt;
+                (arg == "--record" ? opts.record_path : opts.open_path) = std::string(*v);
+            }
+            else if (arg == "--spill")
+            {
+                auto v = next();
+                if (!v || v->empty())
+                    return std::nullopt;
+                opts.spill_dir = std::string(*v);
+            }
+            else if (arg == "--memory")
+            {
+                auto v = next();
+                auto n = v ? parse_count(*v) : std::nullopt;
+                if (!n)
+                    return std::nullopt;
+                opts.memory_mib = n;
+            }
+            else if (arg == "--replay")
+            {
+                auto v = next();
+                auto speed = v ? parse_speed(*v) : std::nullopt;
+                if (!speed)
+                    return std::nullopt;
+                opts.replay_speed = *speed;
+            }
+            else if (!arg.empty() && arg[0] == '-')
+                return std::nullopt;
+            else
+            {
+                opts.url = std::string(arg); // 接受位置参数作为 URL
+                opts.urls.push_back(opts.url);
+            }
+        }
+
+        // 批处理与压测互斥，--events 只对批处理有意义；离线浏览不发起请求
+        if ((opts.json && opts.bench) || (opts.json_events && !opts.json))
+            return std::nullopt;
+        if (!opts.open_path.empty() && (opts.bench || opts.json || !opts.record_path.empty()))
+            return std::nullopt;
+        if (opts.replay_speed && opts.open_path.empty())
+            return std::nullopt;
+        // --memory 只是落盘预算，单独给出时拒绝而不是静默忽略
+        if (opts.memory_mib && opts.spill_dir.empty())
+            return std::nullopt;
+
+        if (opts.urls.empty())
+            opts.urls.push_back(opts.url);
+
+        opts.bench_cfg.url = opts.url;
+        return opts;
+    }
+}
@@ -0,0 +1,945 @@
+/*
+ * ============================================================================
+ *  File Name   : cold_segment.cpp
+ *  Module      : core
+ *
+ *  Description :
+ *      压缩冷数据段的编码、校验与查询实现。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/core/cold_segment.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <climits>
+#include <cstring>
+#include <unordered_map>
+
+#include "eunet/util/lz_block.hpp"
+
+namespace core
+{
+    namespace
+    {
+        // 记录流中每条记录的存在位：为 0 的字段不写入
+        enum Present : std::uint8_t
+        {
+            HAS_TEXT = 1u << 0,
+            HAS_PAYLOAD = 1u << 1,
+            HAS_ERROR = 1u << 2,
+            HAS_TCP_INFO = 1u << 3,
+            HAS_FLAGS = 1u << 4,
+            HAS_ARG0 = 1u << 5,
+            HAS_ARG1 = 1u << 6,
+            HAS_KERNEL_DELAY = 1u << 7,
+        };
+
+        util::Error format_error(const char *what)
+        {
+            return util::Error::state()
+                .data_truncated()
+                .message("Invalid cold segment")
+                .context(what)
+                .build();
+        }
+
+        std::uint64_t zigzag(std::int64_t v) noexcept
+        {
+            return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+        }
+
+        std::int64_t unzigzag(std::uint64_t v) noexcept
+        {
+            return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+        }
+
+        void put_varint(std::vector<std::byte> &out, std::uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                out.push_back(static_cast<std::byte>(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<std::byte>(v));
+        }
+
+        bool get_varint(const std::byte *&p, const std::byte *end, std::uint64_t &v) noexcept
+        {
+            v = 0;
+            for (int shift = 0; shift < 64 && p < end; shift += 7)
+            {
+                auto b = static_cast<std::uint8_t>(*p++);
+                v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80))
+                    return true;
+            }
+            return false;
+        }
+
+        void align8(std::vector<std::byte> &out)
+        {
+            out.resize((out.size() + 7) & ~std::size_t{7});
+        }
+
+        template <typename T>
+        std::span<const std::byte> bytes_of(const std::vector<T> &v) noexcept
+        {
+            return std::as_bytes(std::span<const T>(v));
+        }
+
+        std::string_view as_view(std::span<const std::byte> s) noexcept
+        {
+            return {reinterpret_cast<const char *>(s.data()), s.size()};
+        }
+
+        class Encoder
+        {
+        private:
+            std::vector<std::byte> stream;
+            std::vector<cold::Checkpoint> checkpoints;
+            std::int64_t prev_ts = 0;
+            std::uint64_t prev_session = 0;
+
+            // 去重表中的 string_view 引用源存储区，只在编码期间使用
+            std::unordered_map<std::string_view, std::uint32_t> line_ids;
+            std::vector<std::string_view> lines;
+            std::unordered_map<std::string_view, std::uint32_t> text_ids;
+            std::vector<std::vector<std::uint32_t>> texts;
+
+            std::unordered_map<std::string_view, std::uint32_t> payload_ids;
+            std::vector<cold::PayloadSlot> slots;
+            std::vector<cold::BlockEntry> blocks;
+            std::vector<std::byte> block_raw;
+            std::vector<std::byte> block_data;
+
+            RecordArena side;
+
+            cold::Header header{};
+            std::size_t count = 0;
+
+        public:
+            void add(const EventRecord &r, const RecordArena &arena)
+            {
+                if (count % cold::CHECKPOINT_INTERVAL == 0)
+                    checkpoints.push_back({stream.size(), prev_ts, prev_session, r.ts_ns});
+
+                if (count == 0)
+                {
+                    header.min_ts = header.max_ts = r.ts_ns;
+                    header.flags = cold::ORDERED;
+                }
+                else if (r.ts_ns < prev_ts)
+                    header.flags &= ~std::uint32_t{cold::ORDERED};
+                header.min_ts = std::min(header.min_ts, r.ts_ns);
+                header.max_ts = std::max(header.max_ts, r.ts_ns);
+                header.type_mask |= 1u << (static_cast<unsigned>(r.type) & 31);
+                header.fd_mask |= std::uint64_t{1} << (static_cast<std::uint32_t>(r.fd) & 63);
+
+                std::uint32_t text = r.text ? add_text(arena.text(r.text)) : 0;
+                std::uint32_t payload = r.payload ? add_payload(arena.payload(r.payload)) : 0;
+                std::uint32_t error = 0, tcp_info = 0;
+                if (const auto *err = arena.error(r.error))
+                {
+                    error = side.add_error(*err);
+                    ++header.errors;
+                }
+                if (const auto *info = arena.tcp_info(r.tcp_info))
+                    tcp_info = side.add_tcp_info(*info);
+
+                std::uint8_t present = (text ? HAS_TEXT : 0) |
+                                       (payload ? HAS_PAYLOAD : 0) |
+                                       (error ? HAS_ERROR : 0) |
+                                       (tcp_info ? HAS_TCP_INFO : 0) |
+                                       (r.flags ? HAS_FLAGS : 0) |
+                                       (r.args[0] ? HAS_ARG0 : 0) |
+                                       (r.args[1] ? HAS_ARG1 : 0) |
+                                       (r.kernel_delay_ns ? HAS_KERNEL_DELAY : 0);
+
+                stream.push_back(static_cast<std::byte>(r.type));
+                stream.push_back(static_cast<std::byte>(r.msg));
+                stream.push_back(static_cast<std::byte>(present));
+                put_varint(stream, zigzag(r.fd));
+                put_varint(stream, zigzag(static_cast<std::int64_t>(r.session - prev_session)));
+                put_varint(stream, zigzag(r.ts_ns - prev_ts));
+                if (present & HAS_FLAGS)
+                    put_varint(stream, r.flags);
+                if (present & HAS_KERNEL_DELAY)
+                    put_varint(stream, zigzag(r.kernel_delay_ns));
+                if (present & HAS_ARG0)
+                    put_varint(stream, r.args[0]);
+                if (present & HAS_ARG1)
+                    put_varint(stream, r.args[1]);
+                if (text)
+                    put_varint(stream, text);
+                if (payload)
+                    put_varint(stream, payload);
+                if (error)
+                    put_varint(stream, error);
+                if (tcp_info)
+                    put_varint(stream, tcp_info);
+
+                prev_ts = r.ts_ns;
+                prev_session = r.session;
+                ++count;
+            }
+
+            void finish(std::vector<std::byte> &out)
+            {
+                flush_block();
+
+                header.magic = cold::MAGIC;
+                header.version = cold::VERSION;
+                header.count = count;
+
+                align8(out);
+                std::size_t base = out.size();
+                out.resize(base + sizeof(cold::Header));
+
+                auto emit = [&](std::span<const std::byte> data)
+                {
+                    align8(out);
+                    cold::Section s{out.size() - base, data.size()};
+                    out.insert(out.end(), data.begin(), data.end());
+                    return s;
+                };
+
+                header.records = emit(stream);
+                header.checkpoints = emit(bytes_of(checkpoints));
+                header.dictionary = emit(write_dictionary());
+
+                std::vector<std::byte> side_raw, side_packed;
+                side.write_image(side_raw);
+                header.side_raw = side_raw.size();
+                util::lz::compress(side_raw, side_packed);
+                header.side = emit(side_packed.size() < side_raw.size() ? side_packed : side_raw);
+
+                header.payloads = emit(bytes_of(slots));
+                header.blocks = emit(bytes_of(blocks));
+                header.block_data = emit(block_data);
+                align8(out);
+
+                std::memcpy(out.data() + base, &header, sizeof(header));
+            }
+
+        private:
+            std::uint32_t add_text(std::string_view s)
+            {
+                auto [it, fresh] = text_ids.try_emplace(s, static_cast<std::uint32_t>(texts.size() + 1));
+                if (!fresh)
+                    return it->second;
+
+                // 按行拆分，拼接时以 '\n' 连接即可原样还原
+                std::vector<std::uint32_t> ids;
+                std::size_t begin = 0;
+                while (true)
+                {
+                    auto end = s.find('\n', begin);
+                    auto line = s.substr(begin, end == std::string_view::npos ? std::string_view::npos : end - begin);
+                    auto [lit, added] = line_ids.try_emplace(line, static_cast<std::uint32_t>(lines.size()));
+                    if (added)
+                        lines.push_back(line);
+                    ids.push_back(lit->second);
+
+                    if (end == std::string_view::npos)
+                        break;
+                    begin = end + 1;
+                }
+                texts.push_back(std::move(ids));
+                return it->second;
+            }
+
+            std::uint32_t add_payload(std::span<const std::byte> data)
+            {
+                auto [it, fresh] = payload_ids.try_emplace(as_view(data), static_cast<std::uint32_t>(slots.size() + 1));
+                if (!fresh)
+                    return it->second;
+
+                if (!block_raw.empty() && block_raw.size() + data.size() > cold::PAYLOAD_BLOCK)
+                    flush_block();
+
+                slots.push_back({static_cast<std::uint32_t>(blocks.size()),
+                                 static_cast<std::uint32_t>(block_raw.size()),
+                                 static_cast<std::uint32_t>(data.size()),
+                                 0});
+                block_raw.insert(block_raw.end(), data.begin(), data.end());
+                return it->second;
+            }
+
+            void flush_block()
+            {
+                if (block_raw.empty())
+                    return;
+
+                std::vector<std::byte> packed;
+                util::lz::compress(block_raw, packed);
+
+                // 压缩后不更小的块原样存放
+                const auto &stored = packed.size() < block_raw.size() ? packed : block_raw;
+                blocks.push_back({block_data.size(),
+                                  static_cast<std::uint32_t>(stored.size()),
+                                  static_cast<std::uint32_t>(block_raw.size())});
+                block_data.insert(block_data.end(), stored.begin(), stored.end());
+                block_raw.clear();
+            }
+
+            std::vector<std::byte> write_dictionary() const
+            {
+                std::vector<std::uint32_t> line_ends, text_ends, ids;
+                std::uint32_t bytes = 0;
+                for (auto line : lines)
+                    line_ends.push_back(bytes += static_cast<std::uint32_t>(line.size()));
+                for (const auto &t : texts)
+                {
+                    ids.insert(ids.end(), t.begin(), t.end());
+                    text_ends.push_back(static_cast<std::uint32_t>(ids.size()));
+                }
+
+                cold::DictHeader h{static_cast<std::uint32_t>(lines.size()),
+                                   static_cast<std::uint32_t>(texts.size()),
+                                   static_cast<std::uint32_t>(ids.size()),
+                                   bytes};
+                std::vector<std::byte> out;
+                const auto *hp = reinterpret_cast<const std::byte *>(&h);
+                out.insert(out.end(), hp, hp + sizeof(h));
+                for (const auto *table : {&line_ends, &text_ends, &ids})
+                {
+                    auto b = bytes_of(*table);
+                    out.insert(out.end(), b.begin(), b.end());
+                }
+                for (auto line : lines)
+                {
+                    const auto *p = reinterpret_cast<const std::byte *>(line.data());
+                    out.insert(out.end(), p, p + line.size());
+                }
+                return out;
+            }
+        };
+
+        bool section_ok(const cold::Section &s, std::size_t image, std::size_t align) noexcept
+        {
+            return s.offset <= image && s.size <= image - s.offset && s.offset % align == 0;
+        }
+    }
+
+    // ================= 编码与打开 =================
+
+    void ColdSegment::encode(std::span<const RecordRef> refs, std::vector<std::byte> &out)
+    {
+        Encoder enc;
+        for (const auto &ref : refs)
+            enc.add(*ref.rec, *ref.arena);
+        enc.finish(out);
+    }
+
+    util::ResultV<ColdSegment> ColdSegment::open(
+        std::span<const std::byte> image,
+        std::shared_ptr<const void> owner)
+    {
+        using Ret = util::ResultV<ColdSegment>;
+
+        if (image.size() < sizeof(cold::Header) ||
+            reinterpret_cast<std::uintptr_t>(image.data()) % 8 != 0)
+            return Ret::Err(format_error("header"));
+
+        const auto *h = reinterpret_cast<const cold::Header *>(image.data());
+        if (h->magic != cold::MAGIC || h->version != cold::VERSION)
+            return Ret::Err(format_error("magic"));
+
+        const cold::Section *sections[] = {
+            &h->records, &h->checkpoints, &h->dictionary, &h->side,
+            &h->payloads, &h->blocks, &h->block_data};
+        std::uint64_t end = sizeof(cold::Header);
+        for (const auto *s : sections)
+        {
+            if (!section_ok(*s, image.size(), 8))
+                return Ret::Err(format_error("section out of range"));
+            end = std::max(end, s->offset + s->size);
+        }
+
+        auto groups = (h->count + cold::CHECKPOINT_INTERVAL - 1) / cold::CHECKPOINT_INTERVAL;
+        if (h->checkpoints.size != groups * sizeof(cold::Checkpoint) ||
+            h->payloads.size % sizeof(cold::PayloadSlot) != 0 ||
+            h->blocks.size % sizeof(cold::BlockEntry) != 0 ||
+            h->side.size > h->side_raw)
+            return Ret::Err(format_error("table size"));
+
+        ColdSegment seg;
+        seg.m_image = image.first(std::min<std::size_t>((end + 7) & ~std::uint64_t{7}, image.size()));
+        seg.m_owner = std::move(owner);
+        seg.m_header = h;
+
+        // 字典只校验各表的长度，表项在访问时检查
+        auto dict = seg.section(h->dictionary);
+        if (dict.size() < sizeof(cold::DictHeader))
+            return Ret::Err(format_error("dictionary"));
+        const auto *dh = reinterpret_cast<const cold::DictHeader *>(dict.data());
+        std::uint64_t tables = (std::uint64_t{dh->lines} + dh->texts + dh->ids) * sizeof(std::uint32_t);
+        if (tables > dict.size() - sizeof(cold::DictHeader) ||
+            dh->bytes > dict.size() - sizeof(cold::DictHeader) - tables)
+            return Ret::Err(format_error("dictionary"));
+
+        seg.m_line_ends = reinterpret_cast<const std::uint32_t *>(dict.data() + sizeof(cold::DictHeader));
+        seg.m_text_ends = seg.m_line_ends + dh->lines;
+        seg.m_text_ids = seg.m_text_ends + dh->texts;
+        seg.m_line_bytes = reinterpret_cast<const char *>(seg.m_text_ids + dh->ids);
+        seg.m_line_count = dh->lines;
+        seg.m_text_count = dh->texts;
+        seg.m_id_count = dh->ids;
+        seg.m_line_bytes_size = dh->bytes;
+
+        return Ret::Ok(std::move(seg));
+    }
+
+    util::ResultV<ColdSegment> ColdSegment::compress(const TimelineSnapshot &snap, EvIdx from, EvCnt count)
+    {
+        from = std::min(from, snap.size());
+        count = std::min(count, snap.size() - from);
+
+        std::vector<RecordRef> refs;
+        refs.reserve(count);
+
+        // 范围内含已落盘的记录时先复制到临时段，引用在编码期间保持有效
+        TimelineSegment copy;
+        if (from < snap.cold_size())
+        {
+            copy.records.reserve(count);
+            snap.for_each(
+                [&](const EventRecord &rec, const RecordArena &arena)
+                {
+                    if (copy.records.size() < count)
+                        copy.records.push_back(copy.arena.adopt(rec, arena));
+                },
+                from);
+            for (const auto &rec : copy.records)
+                refs.push_back({&rec, &copy.arena});
+        }
+        else
+        {
+            for (EvIdx i = from; i < from + count; ++i)
+                refs.push_back(snap.ref_at(i));
+        }
+
+        auto buf = std::make_shared<std::vector<std::byte>>();
+        encode(refs, *buf);
+        return open(*buf, buf);
+    }
+
+    // ================= 解码 =================
+
+    ColdSegment::Decoder::Decoder(const ColdSegment &seg, EvIdx from) noexcept
+    {
+        if (from >= seg.size())
+            return;
+
+        auto records = seg.section(seg.m_header->records);
+        auto cps = seg.section(seg.m_header->checkpoints);
+        const auto *cp = reinterpret_cast<const cold::Checkpoint *>(cps.data()) + from / cold::CHECKPOINT_INTERVAL;
+        if (cp->offset > records.size())
+            return;
+
+        m_pos = records.data() + cp->offset;
+        m_end = records.data() + records.size();
+        m_ts = cp->prev_ts;
+        m_session = cp->prev_session;
+
+        EventRecord skip;
+        for (EvIdx i = from % cold::CHECKPOINT_INTERVAL; i > 0; --i)
+            if (!next(skip))
+                return;
+    }
+
+    bool ColdSegment::Decoder::next(EventRecord &rec) noexcept
+    {
+        if (m_end - m_pos < 3)
+        {
+            m_pos = m_end;
+            return false;
+        }
+
+        rec = EventRecord{};
+        rec.type = static_cast<EventType>(m_pos[0]);
+        rec.msg = static_cast<MessageId>(m_pos[1]);
+        auto present = static_cast<std::uint8_t>(m_pos[2]);
+        m_pos += 3;
+
+        std::uint64_t v = 0;
+        auto read = [&](std::uint64_t &out)
+        {
+            return get_varint(m_pos, m_end, out);
+        };
+
+        bool ok = read(v);
+        rec.fd = static_cast<std::int32_t>(unzigzag(v));
+        ok = ok && read(v);
+        m_session += static_cast<std::uint64_t>(unzigzag(v));
+        rec.session = m_session;
+        ok = ok && read(v);
+        m_ts += unzigzag(v);
+        rec.ts_ns = m_ts;
+
+        if (ok && (present & HAS_FLAGS) && (ok = read(v)))
+            rec.flags = static_cast<std::uint16_t>(v);
+        if (ok && (present & HAS_KERNEL_DELAY) && (ok = read(v)))
+            rec.kernel_delay_ns = unzigzag(v);
+        if (ok && (present & HAS_ARG0))
+            ok = read(rec.args[0]);
+        if (ok && (present & HAS_ARG1))
+            ok = read(rec.args[1]);
+        if (ok && (present & HAS_TEXT) && (ok = read(v)))
+            rec.text = static_cast<std::uint32_t>(v);
+        if (ok && (present & HAS_PAYLOAD) && (ok = read(v)))
+            rec.payload = static_cast<std::uint32_t>(v);
+        if (ok && (present & HAS_ERROR) && (ok = read(v)))
+            rec.error = static_cast<std::uint32_t>(v);
+        if (ok && (present & HAS_TCP_INFO) && (ok = read(v)))
+            rec.tcp_info = static_cast<std::uint32_t>(v);
+
+        if (!ok)
+            m_pos = m_end;
+        return ok;
+    }
+
+    // ================= 变长数据 =================
+
+    std::span<const std::byte> ColdSegment::section(const cold::Section &s) const noexcept
+    {
+        return m_image.subspan(s.offset, s.size);
+    }
+
+    std::size_t ColdSegment::memory_bytes() const
+    {
+        if (!m_cache)
+            return 0;
+        return m_cache->side.capacity() + m_cache->block_data.capacity();
+    }
+
+    bool ColdSegment::has_type(EventType type) const noexcept
+    {
+        return m_header && (m_header->type_mask >> (static_cast<unsigned>(type) & 31) & 1u);
+    }
+
+    bool ColdSegment::may_contain_fd(int fd) const noexcept
+    {
+        return m_header && (m_header->fd_mask >> (static_cast<std::uint32_t>(fd) & 63) & 1u);
+    }
+
+    EventRecord ColdSegment::record_at(EvIdx idx) const noexcept
+    {
+        EventRecord rec;
+        Decoder d(*this, idx);
+        d.next(rec);
+        return rec;
+    }
+
+    std::string ColdSegment::text(std::uint32_t h) const
+    {
+        if (h == 0 || h > m_text_count)
+            return {};
+
+        std::uint32_t begin = h > 1 ? m_text_ends[h - 2] : 0;
+        std::uint32_t end = m_text_ends[h - 1];
+        if (begin > end || end > m_id_count)
+            return {};
+
+        std::string s;
+        for (auto i = begin; i < end; ++i)
+        {
+            auto id = m_text_ids[i];
+            if (id >= m_line_count)
+                return {};
+            std::uint32_t from = id > 0 ? m_line_ends[id - 1] : 0;
+            std::uint32_t to = m_line_ends[id];
+            if (from > to || to > m_line_bytes_size)
+                return {};
+
+            if (i != begin)
+                s += '\n';
+            s.append(m_line_bytes + from, to - from);
+        }
+        return s;
+    }
+
+    std::vector<std::byte> ColdSegment::payload(std::uint32_t h) const
+    {
+        auto slots = section(m_header->payloads);
+        auto blocks = section(m_header->blocks);
+        if (h == 0 || h > slots.size() / sizeof(cold::PayloadSlot))
+            return {};
+
+        const auto &slot = reinterpret_cast<const cold::PayloadSlot *>(slots.data())[h - 1];
+        if (slot.block >= blocks.size() / sizeof(cold::BlockEntry))
+            return {};
+        const auto &block = reinterpret_cast<const cold::BlockEntry *>(blocks.data())[slot.block];
+        if (slot.offset > block.raw || slot.size > block.raw - slot.offset)
+            return {};
+
+        auto data = section(m_header->block_data);
+        if (block.offset > data.size() || block.stored > data.size() - block.offset)
+            return {};
+        auto stored = data.subspan(block.offset, block.stored);
+
+        if (block.stored == block.raw)
+        {
+            auto s = stored.subspan(slot.offset, slot.size);
+            return {s.begin(), s.end()};
+        }
+
+        std::lock_guard lock(m_cache->block_mtx);
+        if (m_cache->block != slot.block)
+        {
+            m_cache->block = UINT32_MAX;
+            m_cache->block_data.resize(block.raw);
+            if (util::lz::decompress(stored, m_cache->block_data).is_err())
+                return {};
+            m_cache->block = slot.block;
+        }
+
+        auto begin = m_cache->block_data.begin() + slot.offset;
+        return {begin, begin + slot.size};
+    }
+
+    const ArenaImage &ColdSegment::side() const
+    {
+        std::call_once(m_cache->side_once, [this]
+                       {
+            auto stored = section(m_header->side);
+            auto &buf = m_cache->side;
+            if (stored.size() == m_header->side_raw)
+                buf.assign(stored.begin(), stored.end());
+            else
+            {
+                buf.resize(m_header->side_raw);
+                if (util::lz::decompress(stored, buf).is_err())
+                {
+                    buf.clear();
+                    return;
+                }
+            }
+
+            auto view = ArenaImage::view(buf);
+            if (view.is_ok())
+                m_cache->side_image = view.unwrap(); });
+        return m_cache->side_image;
+    }
+
+    std::optional<util::Error> ColdSegment::error(std::uint32_t h) const
+    {
+        if (h == 0)
+            return std::nullopt;
+        return side().error(h);
+    }
+
+    const platform::net::TcpInfo *ColdSegment::tcp_info(std::uint32_t h) const
+    {
+        if (h == 0)
+            return nullptr;
+        return side().tcp_info(h);
+    }
+
+    // ================= 查询 =================
+
+    ColdSegment::EvIdx ColdSegment::seek_time(std::int64_t lo) const noexcept
+    {
+        auto cps = section(m_header->checkpoints);
+        const auto *first = reinterpret_cast<const cold::Checkpoint *>(cps.data());
+        const auto *last = first + cps.size() / sizeof(cold::Checkpoint);
+
+        // 首条时间戳不小于 lo 的组之前的那一组可能还有 ts >= lo 的记录
+        const auto *it = std::partition_point(first, last, [lo](const cold::Checkpoint &c)
+                                              { return c.first_ts < lo; });
+        auto group = static_cast<EvIdx>(it - first);
+        return group == 0 ? 0 : (group - 1) * cold::CHECKPOINT_INTERVAL;
+    }
+
+    ColdSegment::EvIdx ColdSegment::lower_bound(std::int64_t ts_ns) const noexcept
+    {
+        if (empty() || max_ts() < ts_ns)
+            return size();
+        if (min_ts() >= ts_ns)
+            return 0;
+
+        EvIdx idx = seek_time(ts_ns);
+        Decoder d(*this, idx);
+        EventRecord r;
+        for (; idx < size() && d.next(r); ++idx)
+            if (r.ts_ns >= ts_ns)
+                return idx;
+        return size();
+    }
+
+    TimelineSegment ColdSegment::thaw() const
+    {
+        TimelineSegment seg;
+        seg.records.reserve(size());
+        for_each([&](EvIdx, const EventRecord &r)
+                 { seg.records.push_back(adopt(r, seg.arena)); });
+        return seg;
+    }
+
+    EventRecord ColdSegment::adopt(const EventRecord &r, RecordArena &arena) const
+    {
+        static constexpr std::byte none{};
+
+        auto text = this->text(r.text);
+        auto payload = this->payload(r.payload);
+        auto err = error(r.error);
+
+        // 空载荷也要保留句柄，attach 以非空指针区分
+        RecordExtras extras{
+            .text = text,
+            .payload = r.payload && payload.empty() ? std::span<const std::byte>(&none, 0) : payload,
+            .error = err ? &*err : nullptr,
+            .tcp_info = tcp_info(r.tcp_info),
+        };
+        EventRecord rec = r;
+        rec.text = rec.payload = rec.error = rec.tcp_info = 0;
+        arena.attach(rec, extras);
+        return rec;
+    }
+
+    template <typename Fn>
+    void ColdSegment::scan(const TimelineQuery &q, Fn &&fn) const
+    {
+        if (empty())
+            return;
+
+        std::bitset<EVENT_TYPE_COUNT> types;
+        if (q.types.empty())
+            types.set();
+        bool any_type = q.types.empty();
+        for (auto t : q.types)
+        {
+            types.set(static_cast<std::size_t>(t));
+            any_type = any_type || has_type(t);
+        }
+
+        const auto &anchor = platform::time::process_anchor();
+        std::int64_t lo = q.start ? anchor.from_wall(*q.start) : INT64_MIN;
+        std::int64_t hi = q.end ? anchor.from_wall(*q.end) : INT64_MAX;
+
+        // 先以段头的摘要剪枝，整段不相交时不解码
+        if (!any_type || lo > hi || max_ts() < lo || min_ts() > hi)
+            return;
+        if ((q.fd && !may_contain_fd(*q.fd)) || (q.errors_only && m_header->errors == 0))
+            return;
+
+        bool check_ts = min_ts() < lo || max_ts() > hi;
+        EvIdx idx = ordered() && min_ts() < lo ? seek_time(lo) : 0;
+
+        Decoder d(*this, idx);
+        EventRecord r;
+        for (; idx < size() && d.next(r); ++idx)
+        {
+            if (check_ts && (r.ts_ns < lo || r.ts_ns > hi))
+            {
+                if (ordered() && r.ts_ns > hi)
+                    break;
+                continue;
+            }
+            if (q.fd && r.fd != *q.fd)
+                continue;
+            auto type = static_cast<std::size_t>(r.type);
+            if (type >= EVENT_TYPE_COUNT || !types.test(type))
+                continue;
+            if (q.session && r.session != *q.session)
+                continue;
+            if (q.errors_only && !r.is_error())
+                continue;
+            fn(idx, r);
+        }
+    }
+
+    ColdSegment::EvResult ColdSegment::event_at(EvIdx idx, bool with_payload) const
+    {
+        using Ret = EvResult;
+        using util::Error;
+
+        if (idx >= size())
+        {
+            return Ret::Err(
+                Error::state()
+                    .target_not_found()
+                    .message("Event index out of range")
+                    .context(std::to_string(idx))
+                    .build());
+        }
+
+        auto rec = record_at(idx);
+        if (!with_payload)
+            rec.payload = 0;
+        return Ret::Ok(core::materialize(rec, *this));
+    }
+
+    ColdSegment::EvCnt ColdSegment::count_by_fd(int fd) const
+    {
+        TimelineQuery q;
+        q.fd = fd;
+        return count_matching(q);
+    }
+
+    ColdSegment::EvCnt ColdSegment::count_by_type(EventType type) const
+    {
+        TimelineQuery q;
+        q.types = {type};
+        return count_matching(q);
+    }
+
+    ColdSegment::EvCnt ColdSegment::count_by_time(TimeStamp start, TimeStamp end) const
+    {
+        TimelineQuery q;
+        q.start = start;
+        q.end = end;
+        return count_matching(q);
+    }
+
+    ColdSegment::EvCnt ColdSegment::count_by_session(SessionId sid) const
+    {
+        TimelineQuery q;
+        q.session = sid;
+        return count_matching(q);
+    }
+
+    ColdSegment::EvList ColdSegment::replay_all() const
+    {
+        EvList result;
+        result.reserve(size());
+        for_each([&](EvIdx, const EventRecord &r)
+                 { result.push_back(core::materialize(r, *this)); });
+        return result;
+    }
+
+    ColdSegment::EvList ColdSegment::query_by_fd(int fd) const
+    {
+        TimelineQuery q;
+        q.fd = fd;
+        return query(q);
+    }
+
+    ColdSegment::EvList ColdSegment::query_by_type(EventType type) const
+    {
+        TimelineQuery q;
+        q.types = {type};
+        return query(q);
+    }
+
+    ColdSegment::EvList ColdSegment::query_by_time(TimeStamp start, TimeStamp end) const
+    {
+        TimelineQuery q;
+        q.start = start;
+        q.end = end;
+        return query(q);
+    }
+
+    ColdSegment::EvList ColdSegment::query_by_session(SessionId sid) const
+    {
+        TimelineQuery q;
+        q.session = sid;
+        return query(q);
+    }
+
+    ColdSegment::EvList ColdSegment::query_errors() const
+    {
+        TimelineQuery q;
+        q.errors_only = true;
+        return query(q);
+    }
+
+    ColdSegment::EvList ColdSegment::query(const TimelineQuery &q) const
+    {
+        EvList result;
+        scan(q, [&](EvIdx, const EventRecord &r)
+             { result.push_back(core::materialize(r, *this)); });
+        return result;
+    }
+
+    ColdSegment::EvCnt ColdSegment::count_matching(const TimelineQuery &q) const
+    {
+        // 有序段上只有时间条件时，完全落在范围内的组直接计入，不解码
+        bool time_only = !q.fd && q.types.empty() && !q.session && !q.errors_only;
+        if (time_only && ordered())
+        {
+            const auto &anchor = platform::time::process_anchor();
+            std::int64_t lo = q.start ? anchor.from_wall(*q.start) : INT64_MIN;
+            std::int64_t hi = q.end ? anchor.from_wall(*q.end) : INT64_MAX;
+            if (lo > hi || max_ts() < lo || min_ts() > hi)
+                return 0;
+
+            auto cps = section(m_header->checkpoints);
+            const auto *cp = reinterpret_cast<const cold::Checkpoint *>(cps.data());
+            std::size_t groups = cps.size() / sizeof(cold::Checkpoint);
+
+            EvCnt cnt = 0;
+            for (std::size_t g = 0; g < groups; ++g)
+            {
+                EvIdx begin = g * cold::CHECKPOINT_INTERVAL;
+                EvIdx end = std::min<EvIdx>(begin + cold::CHECKPOINT_INTERVAL, size());
+                std::int64_t first = cp[g].first_ts;
+                std::int64_t last = g + 1 < groups ? cp[g + 1].first_ts : max_ts(); // 本组时间戳的上界
+
+                if (first > hi)
+                    break;
+                if (last < lo)
+                    continue;
+                if (first >= lo && last <= hi)
+                {
+                    cnt += end - begin;
+                    continue;
+                }
+
+                Decoder d(*this, begin);
+                EventRecord r;
+                for (EvIdx i = begin; i < end && d.next(r); ++i)
+                    cnt += (r.ts_ns >= lo && r.ts_ns <= hi);
+            }
+            return cnt;
+        }
+
+        EvCnt cnt = 0;
+        scan(q, [&](EvIdx, const EventRecord &)
+             { ++cnt; });
+        return cnt;
+    }
+
+    ColdSegment::IdxList ColdSegment::select(const TimelineQuery &q) const
+    {
+        IdxList result;
+        scan(q, [&](EvIdx idx, const EventRecord &)
+             { result.push_back(idx); });
+        return result;
+    }
+
+    ColdSegment::EvList ColdSegment::materialize(const IdxList &idxs) const
+    {
+        EvList result;
+        result.reserve(idxs.size());
+
+        // 递增的下标顺序解码，只在跳跃较远时重新定位
+        Decoder d;
+        EventRecord r;
+        EvIdx next = SIZE_MAX;
+        for (auto idx : idxs)
+        {
+            if (idx >= size())
+                continue;
+            if (idx < next || idx - next >= cold::CHECKPOINT_INTERVAL)
+            {
+                d = Decoder(*this, idx);
+                next = idx;
+            }
+            for (; next <= idx; ++next)
+                if (!d.next(r))
+                    break;
+            if (next == idx + 1)
+                result.push_back(core::materialize(r, *this));
+        }
+        return result;
+    }
+}
@@ -0,0 +1,211 @@
+/*
+ * ============================================================================
+ *  File Name   : cold_store.cpp
+ *  Module      : core
+ *
+ *  Description :
+ *      冷段文件存储实现。编码在后台线程上进行，只读取已封存、不可变的段，
+ *      不需要 Timeline 的锁；文件以 mkstemp 创建、立即 unlink，
+ *      pwrite 写完后整体 mmap，映射的生命周期交给 ColdSegment 的 owner。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/core/cold_store.hpp"
+
+#include <cerrno>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "eunet/platform/fd.hpp"
+
+namespace core
+{
+    namespace
+    {
+        util::Error system_error(int err_no, const char *msg, const std::string &ctx)
+        {
+            return util::Error::system()
+                .code(err_no)
+                .set_category(from_errno(err_no))
+                .message(msg)
+                .context(ctx)
+                .build();
+        }
+
+        /** 只读映射，析构时解除 */
+        struct Mapping
+        {
+            void *addr = nullptr;
+            std::size_t bytes = 0;
+
+            Mapping(void *a, std::size_t n) noexcept : addr(a), bytes(n) {}
+            ~Mapping()
+            {
+                if (addr)
+                    ::munmap(addr, bytes);
+            }
+
+            Mapping(const Mapping &) = delete;
+            Mapping &operator=(const Mapping &) = delete;
+        };
+    }
+
+    ColdStore::ColdStore(std::string dir, Done done)
+        : m_dir(std::move(dir)), m_done(std::move(done)) {}
+
+    util::ResultV<std::unique_ptr<ColdStore>> ColdStore::create(std::string dir, Done done)
+    {
+        using Ret = util::ResultV<std::unique_ptr<ColdStore>>;
+        using util::Error;
+
+        struct stat st{};
+        if (::stat(dir.c_str(), &st) != 0)
+            return Ret::Err(system_error(errno, "Cold segment directory unavailable", dir));
+        if (!S_ISDIR(st.st_mode))
+        {
+            return Ret::Err(
+                Error::internal()
+                    .invalid_argument()
+                    .message("Cold segment path is not a directory")
+                    .context(dir)
+                    .build());
+        }
+
+        std::unique_ptr<ColdStore> store(new ColdStore(std::move(dir), std::move(done)));
+        store->m_thread = std::thread([s = store.get()]
+                                      { s->run(); });
+        return Ret::Ok(std::move(store));
+    }
+
+    ColdStore::~ColdStore()
+    {
+        {
+            std::lock_guard lock(m_mtx);
+            m_stop = true;
+            m_queue.clear();
+        }
+        m_wake.notify_all();
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    util::ResultV<ColdStore::ColdPtr> ColdStore::write(const std::string &dir, const TimelineSegment &seg)
+    {
+        using Ret = util::ResultV<ColdPtr>;
+
+        std::vector<RecordRef> refs;
+        refs.reserve(seg.records.size());
+        for (const auto &rec : seg.records)
+            refs.push_back({&rec, &seg.arena});
+
+        std::vector<std::byte> image;
+        ColdSegment::encode(refs, image);
+
+        std::string path = dir + "/eunet-cold-XXXXXX";
+        platform::fd::Fd fd(::mkstemp(path.data()));
+        if (!fd)
+            return Ret::Err(system_error(errno, "Failed to create cold segment file", path));
+
+        // 打开的描述符与之后的映射仍可访问文件内容
+        ::unlink(path.c_str());
+
+        std::size_t off = 0;
+        while (off < image.size())
+        {
+            ssize_t n = ::pwrite(fd.get(), image.data() + off, image.size() - off, static_cast<off_t>(off));
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return Ret::Err(system_error(errno, "Failed to write cold segment file", path));
+            }
+            off += static_cast<std::size_t>(n);
+        }
+
+        void *addr = ::mmap(nullptr, image.size(), PROT_READ, MAP_SHARED, fd.get(), 0);
+        if (addr == MAP_FAILED)
+            return Ret::Err(system_error(errno, "Failed to map cold segment file", path));
+
+        auto mapping = std::make_shared<const Mapping>(addr, image.size());
+        std::span<const std::byte> view(static_cast<const std::byte *>(addr), image.size());
+
+        auto opened = ColdSegment::open(view, mapping);
+        if (opened.is_err())
+            return Ret::Err(opened.unwrap_err());
+        return Ret::Ok(std::make_shared<const ColdSegment>(std::move(opened).unwrap()));
+    }
+
+    void ColdStore::submit(SegmentPtr seg)
+    {
+        if (!seg || seg->records.empty())
+            return;
+
+        {
+            std::lock_guard lock(m_mtx);
+            if (m_stop)
+                return;
+            m_queue.push_back(std::move(seg));
+        }
+        m_wake.notify_one();
+    }
+
+    void ColdStore::flush()
+    {
+        std::unique_lock lock(m_mtx);
+        m_idle.wait(lock, [this]
+                    { return m_stop || (m_queue.empty() && !m_busy); });
+    }
+
+    std::size_t ColdStore::pending()
+    {
+        std::lock_guard lock(m_mtx);
+        return m_queue.size() + (m_busy ? 1 : 0);
+    }
+
+    void ColdStore::run()
+    {
+        std::unique_lock lock(m_mtx);
+        while (true)
+        {
+            m_wake.wait(lock, [this]
+                        { return m_stop || !m_queue.empty(); });
+            if (m_stop)
+                break;
+
+            auto seg = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_busy = true;
+            lock.unlock();
+
+            // 编码、写入与回调都不持有队列锁，回调可以再提交新的段
+            auto res = write(m_dir, *seg);
+            if (res.is_ok())
+            {
+                m_written.fetch_add(res.unwrap()->image_bytes(), std::memory_order_relaxed);
+                m_segments.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (m_done)
+                m_done(seg, std::move(res));
+
+            lock.lock();
+            m_busy = false;
+            if (m_queue.empty())
+                m_idle.notify_all();
+        }
+
+        m_busy = false;
+        m_idle.notify_all();
+    }
+}
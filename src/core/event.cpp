@@ -52,11 +52,37 @@ namespace core
         return e;
     }
 
-    Event::Event() : ts(platform::time::wall_now()) {}
+    Event Event::tcp_sample(
+        const platform::net::TcpInfo &info,
+        platform::fd::FdView fd) noexcept
+    {
+        Event e;
+        e.type = EventType::TCP_INFO_SAMPLE;
+        e.fd = fd;
+
+        e.msg = ::to_string(info);
+        e.tcp_info = info;
+        return e;
+    }
+
+    Event::Event()
+    {
+        mono_ns = platform::time::event_now();
+        ts = platform::time::event_to_wall(mono_ns);
+    }
 
     bool Event::is_ok() const noexcept { return !error.has_value(); }
     bool Event::is_error() const noexcept { return error.has_value(); }
 
+    std::optional<std::chrono::nanoseconds>
+    Event::kernel_delay() const noexcept
+    {
+        if (!kernel_ts)
+            return std::nullopt;
+
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(*kernel_ts - ts);
+    }
+
 }
 
 std::string to_string(core::EventType type)
@@ -75,6 +101,8 @@ std::string to_string(core::EventType type)
         return "TCP Connection Success";
     case EventType::TCP_CONNECT_TIMEOUT:
         return "TCP Connection Timeout";
+    case EventType::SOCKET_OPTION_SET:
+        return "Socket Option Set";
 
     case EventType::TLS_HANDSHAKE_START:
         return "TLS Handshake Start";
@@ -92,6 +120,9 @@ std::string to_string(core::EventType type)
     case EventType::HTTP_BODY_DONE:
         return "HTTP Body Done";
 
+    case EventType::TCP_INFO_SAMPLE:
+        return "TCP Info Sample";
+
     case EventType::CONNECTION_IDLE:
         return "Connection Idle";
     case EventType::CONNECTION_CLOSED:
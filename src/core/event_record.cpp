@@ -0,0 +1,499 @@
+/*
+ * ============================================================================
+ *  File Name   : event_record.cpp
+ *  Module      : core
+ *
+ *  Description :
+ *      紧凑事件记录的存储区、只读映像与延迟格式化实现。
+ *      render_message / materialize 对 RecordArena、ArenaImage 与 ColdSegment 共用同一份模板实现。
+ *
+ *  Third-Party Dependencies :
+ *      - fmt
+ *          Usage     : 延迟格式化消息文本
+ *          License   : MIT License
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/core/event_record.hpp"
+#include "eunet/core/cold_segment.hpp"
+
+#include <cstring>
+#include <memory>
+
+#include <fmt/format.h>
+
+namespace core
+{
+    namespace
+    {
+        // 空载荷也要与"无载荷"区分，给它一个非空地址
+        const std::byte EMPTY_PAYLOAD{};
+
+        constexpr std::size_t IMAGE_ALIGN = 8;
+
+        // 映像中一层错误的定长部分，之后紧跟 message 与 context；有原因错误时接着存放下一层
+        struct ErrorImage
+        {
+            std::uint8_t domain;
+            std::uint8_t category;
+            std::uint8_t severity;
+            std::uint8_t has_cause;
+            std::int32_t code;
+            std::uint32_t message_len;
+            std::uint32_t context_len;
+        };
+
+        constexpr std::size_t align_up(std::size_t n) noexcept
+        {
+            return (n + IMAGE_ALIGN - 1) & ~(IMAGE_ALIGN - 1);
+        }
+
+        void put_bytes(std::vector<std::byte> &out, const void *data, std::size_t n)
+        {
+            const auto *p = static_cast<const std::byte *>(data);
+            out.insert(out.end(), p, p + n);
+        }
+
+        void put_error(std::vector<std::byte> &out, const util::Error &err)
+        {
+            for (const util::Error *e = &err; e; e = e->cause())
+            {
+                auto msg = e->message();
+                auto ctx = e->context();
+                ErrorImage head{
+                    static_cast<std::uint8_t>(e->domain()),
+                    static_cast<std::uint8_t>(e->category()),
+                    static_cast<std::uint8_t>(e->severity()),
+                    static_cast<std::uint8_t>(e->cause() != nullptr),
+                    e->code(),
+                    static_cast<std::uint32_t>(msg.size()),
+                    static_cast<std::uint32_t>(ctx.size()),
+                };
+                put_bytes(out, &head, sizeof(head));
+                put_bytes(out, msg.data(), msg.size());
+                put_bytes(out, ctx.data(), ctx.size());
+            }
+        }
+
+        std::optional<util::Error> get_error(std::span<const std::byte> data)
+        {
+            // 先由外到内解出每一层，再由内到外逐层包装
+            std::vector<util::Error> chain;
+            bool more = true;
+            while (more)
+            {
+                ErrorImage head;
+                if (data.size() < sizeof(head))
+                    return std::nullopt;
+                std::memcpy(&head, data.data(), sizeof(head));
+                data = data.subspan(sizeof(head));
+
+                std::size_t text_len = std::size_t{head.message_len} + head.context_len;
+                if (data.size() < text_len)
+                    return std::nullopt;
+
+                const char *text = reinterpret_cast<const char *>(data.data());
+                chain.emplace_back(std::make_shared<util::ErrorData>(util::ErrorData{
+                    static_cast<util::ErrorDomain>(head.domain),
+                    static_cast<util::ErrorCategory>(head.category),
+                    static_cast<util::ErrorSeverity>(head.severity),
+                    head.code,
+                    std::string(text, head.message_len),
+                    std::string(text + head.message_len, head.context_len),
+                }));
+                data = data.subspan(text_len);
+                more = head.has_cause != 0;
+            }
+
+            for (std::size_t i = chain.size() - 1; i > 0; --i)
+                chain[i - 1].wrap(std::make_shared<util::Error>(chain[i]));
+            return chain.front();
+        }
+
+        template <typename Arena>
+        std::string render_message_with(const EventRecord &rec, const Arena &arena)
+        {
+            switch (rec.msg)
+            {
+            case MessageId::Text:
+                return std::string(arena.text(rec.text));
+            case MessageId::ResolvingHost:
+                return fmt::format("Resolving host: {}", arena.text(rec.text));
+            case MessageId::ResolvedTo:
+                return fmt::format("Resolved to: {}", arena.text(rec.text));
+            case MessageId::Connecting:
+                return fmt::format("Connecting to {}:{} (timeout={}ms)...",
+                                   arena.text(rec.text), rec.args[0],
+                                   static_cast<std::int64_t>(rec.args[1]));
+            case MessageId::ConnectionEstablished:
+                return "Connection established";
+            case MessageId::SendingBytes:
+                return fmt::format("Sending {} bytes...", rec.args[0]);
+            case MessageId::ReceivedBytes:
+            {
+                auto s = fmt::format("Received {} bytes", rec.args[0]);
+                if (rec.flags & EventRecord::HAS_KERNEL_TS)
+                {
+                    auto delay = rec.kernel_delay_ns < 0 ? -rec.kernel_delay_ns : rec.kernel_delay_ns;
+                    s += fmt::format(" (kernel->user {}us)", delay / 1000);
+                }
+                return s;
+            }
+            case MessageId::PeerClosed:
+                return "Peer closed";
+            case MessageId::ClosingConnection:
+                return "Closing connection";
+            case MessageId::HttpGet:
+                return fmt::format("HTTP GET {}", arena.text(rec.text));
+            case MessageId::HttpRequestSent:
+                return "HTTP request sent";
+            case MessageId::TcpInfoSample:
+                if (const auto *info = arena.tcp_info(rec.tcp_info))
+                    return ::to_string(*info);
+                return {};
+            }
+            return {};
+        }
+
+        template <typename Arena>
+        Event materialize_with(const EventRecord &rec, const Arena &arena)
+        {
+            // RecordArena 返回指针，ArenaImage / ColdSegment 返回解码后的 optional，都可按布尔判断后解引用
+            Event e = [&]
+            {
+                if (auto err = arena.error(rec.error))
+                    return Event::failure(rec.type, *err, {rec.fd});
+                return Event::info(rec.type, {}, {rec.fd});
+            }();
+
+            e.msg = render_message_with(rec, arena);
+
+            e.session_id = rec.session;
+            e.mono_ns = rec.ts_ns;
+            e.ts = platform::time::event_to_wall(rec.ts_ns);
+            if (rec.flags & EventRecord::HAS_KERNEL_TS)
+                e.kernel_ts = platform::time::event_to_wall(rec.ts_ns + rec.kernel_delay_ns);
+
+            if (rec.payload)
+            {
+                auto bytes = arena.payload(rec.payload);
+                e.payload.emplace(bytes.begin(), bytes.end());
+            }
+            if (const auto *info = arena.tcp_info(rec.tcp_info))
+                e.tcp_info = *info;
+            return e;
+        }
+    }
+
+    std::uint32_t RecordArena::add_text(std::string_view s)
+    {
+        if (auto it = text_ids.find(s); it != text_ids.end())
+            return it->second;
+
+        texts.emplace_back(s);
+        auto id = static_cast<std::uint32_t>(texts.size());
+        text_ids.emplace(texts.back(), id);
+        return id;
+    }
+
+    std::uint32_t RecordArena::add_payload(std::span<const std::byte> data)
+    {
+        payloads.push_back({bytes.size(), data.size()});
+        bytes.insert(bytes.end(), data.begin(), data.end());
+        return static_cast<std::uint32_t>(payloads.size());
+    }
+
+    std::uint32_t RecordArena::add_error(const util::Error &err)
+    {
+        errors.push_back(err);
+        return static_cast<std::uint32_t>(errors.size());
+    }
+
+    std::uint32_t RecordArena::add_tcp_info(const platform::net::TcpInfo &info)
+    {
+        tcp_infos.push_back(info);
+        return static_cast<std::uint32_t>(tcp_infos.size());
+    }
+
+    void RecordArena::attach(EventRecord &rec, const RecordExtras &extras)
+    {
+        if (!extras.text.empty())
+            rec.text = add_text(extras.text);
+        if (extras.payload.data() != nullptr)
+            rec.payload = add_payload(extras.payload);
+        if (extras.error)
+            rec.error = add_error(*extras.error);
+        if (extras.tcp_info)
+            rec.tcp_info = add_tcp_info(*extras.tcp_info);
+    }
+
+    std::string_view RecordArena::text(std::uint32_t h) const noexcept
+    {
+        if (h == 0 || h > texts.size())
+            return {};
+        return texts[h - 1];
+    }
+
+    std::span<const std::byte> RecordArena::payload(std::uint32_t h) const noexcept
+    {
+        if (h == 0 || h > payloads.size())
+            return {};
+        const auto &s = payloads[h - 1];
+        return {bytes.data() + s.offset, s.size};
+    }
+
+    const util::Error *RecordArena::error(std::uint32_t h) const noexcept
+    {
+        if (h == 0 || h > errors.size())
+            return nullptr;
+        return &errors[h - 1];
+    }
+
+    const platform::net::TcpInfo *RecordArena::tcp_info(std::uint32_t h) const noexcept
+    {
+        if (h == 0 || h > tcp_infos.size())
+            return nullptr;
+        return &tcp_infos[h - 1];
+    }
+
+    EventRecord RecordArena::adopt(const EventRecord &rec, const RecordArena &from)
+    {
+        EventRecord out = rec;
+        out.text = rec.text ? add_text(from.text(rec.text)) : 0;
+        out.payload = rec.payload ? add_payload(from.payload(rec.payload)) : 0;
+        out.error = rec.error ? add_error(*from.error(rec.error)) : 0;
+        out.tcp_info = rec.tcp_info ? add_tcp_info(*from.tcp_info(rec.tcp_info)) : 0;
+        return out;
+    }
+
+    void RecordArena::clear()
+    {
+        text_ids.clear();
+        texts.clear();
+        bytes.clear();
+        payloads.clear();
+        errors.clear();
+        tcp_infos.clear();
+    }
+
+    std::size_t RecordArena::memory_bytes() const noexcept
+    {
+        std::size_t n = bytes.capacity() +
+                        payloads.capacity() * sizeof(Slice) +
+                        errors.capacity() * sizeof(util::Error) +
+                        tcp_infos.capacity() * sizeof(platform::net::TcpInfo);
+        for (const auto &s : texts)
+            n += s.capacity() + sizeof(std::string);
+        return n;
+    }
+
+    void RecordArena::write_image(std::vector<std::byte> &out) const
+    {
+        // 先拼好字节区得到各项偏移，再依次写出头部、各表与字节区
+        std::vector<std::byte> blob;
+        std::vector<ArenaImage::Slice> text_tab, payload_tab, error_tab;
+        text_tab.reserve(texts.size());
+        payload_tab.reserve(payloads.size());
+        error_tab.reserve(errors.size());
+
+        for (const auto &s : texts)
+        {
+            text_tab.push_back({blob.size(), s.size()});
+            put_bytes(blob, s.data(), s.size());
+        }
+        for (const auto &s : payloads)
+        {
+            payload_tab.push_back({blob.size(), s.size});
+            put_bytes(blob, bytes.data() + s.offset, s.size);
+        }
+        for (const auto &e : errors)
+        {
+            std::size_t offset = blob.size();
+            put_error(blob, e);
+            error_tab.push_back({offset, blob.size() - offset});
+        }
+
+        ArenaImage::Header head{
+            static_cast<std::uint32_t>(text_tab.size()),
+            static_cast<std::uint32_t>(payload_tab.size()),
+            static_cast<std::uint32_t>(error_tab.size()),
+            static_cast<std::uint32_t>(tcp_infos.size()),
+            blob.size(),
+        };
+
+        std::size_t base = out.size();
+        put_bytes(out, &head, sizeof(head));
+        put_bytes(out, text_tab.data(), text_tab.size() * sizeof(ArenaImage::Slice));
+        put_bytes(out, payload_tab.data(), payload_tab.size() * sizeof(ArenaImage::Slice));
+        put_bytes(out, error_tab.data(), error_tab.size() * sizeof(ArenaImage::Slice));
+        put_bytes(out, tcp_infos.data(), tcp_infos.size() * sizeof(platform::net::TcpInfo));
+        put_bytes(out, blob.data(), blob.size());
+        out.resize(base + align_up(out.size() - base), std::byte{0});
+    }
+
+    util::ResultV<ArenaImage> ArenaImage::view(std::span<const std::byte> data)
+    {
+        using Ret = util::ResultV<ArenaImage>;
+        using util::Error;
+
+        auto invalid = [](const char *what)
+        {
+            return Ret::Err(
+                Error::state()
+                    .data_truncated()
+                    .message("Invalid arena image")
+                    .context(what)
+                    .build());
+        };
+
+        if (reinterpret_cast<std::uintptr_t>(data.data()) % IMAGE_ALIGN != 0)
+            return invalid("misaligned");
+        if (data.size() < sizeof(Header))
+            return invalid("header");
+
+        ArenaImage img;
+        img.m_header = reinterpret_cast<const Header *>(data.data());
+        const auto &h = *img.m_header;
+
+        // 各计数为 32 位，表长度之和不会溢出 64 位
+        std::uint64_t tables = sizeof(Header) +
+                               (std::uint64_t{h.texts} + h.payloads + h.errors) * sizeof(Slice) +
+                               std::uint64_t{h.tcp_infos} * sizeof(platform::net::TcpInfo);
+        if (tables > data.size() || h.blob_size > data.size() - tables)
+            return invalid("tables");
+
+        const auto *p = data.data() + sizeof(Header);
+        img.m_texts = reinterpret_cast<const Slice *>(p);
+        img.m_payloads = img.m_texts + h.texts;
+        img.m_errors = img.m_payloads + h.payloads;
+        img.m_tcp_infos = reinterpret_cast<const platform::net::TcpInfo *>(img.m_errors + h.errors);
+        img.m_blob = data.data() + tables;
+        return Ret::Ok(img);
+    }
+
+    std::span<const std::byte> ArenaImage::slice(
+        const Slice *table,
+        std::uint32_t count,
+        std::uint32_t h) const noexcept
+    {
+        if (!m_header || h == 0 || h > count)
+            return {};
+        const auto &s = table[h - 1];
+        if (s.offset > m_header->blob_size || s.size > m_header->blob_size - s.offset)
+            return {};
+        return {m_blob + s.offset, static_cast<std::size_t>(s.size)};
+    }
+
+    std::string_view ArenaImage::text(std::uint32_t h) const noexcept
+    {
+        auto s = slice(m_texts, m_header ? m_header->texts : 0, h);
+        return {reinterpret_cast<const char *>(s.data()), s.size()};
+    }
+
+    std::span<const std::byte> ArenaImage::payload(std::uint32_t h) const noexcept
+    {
+        return slice(m_payloads, m_header ? m_header->payloads : 0, h);
+    }
+
+    std::optional<util::Error> ArenaImage::error(std::uint32_t h) const
+    {
+        auto s = slice(m_errors, m_header ? m_header->errors : 0, h);
+        if (s.empty())
+            return std::nullopt;
+        return get_error(s);
+    }
+
+    const platform::net::TcpInfo *ArenaImage::tcp_info(std::uint32_t h) const noexcept
+    {
+        if (!m_header || h == 0 || h > m_header->tcp_infos)
+            return nullptr;
+        return &m_tcp_infos[h - 1];
+    }
+
+    std::size_t ArenaImage::image_bytes() const noexcept
+    {
+        if (!m_header)
+            return 0;
+        return align_up(static_cast<std::size_t>(m_blob - reinterpret_cast<const std::byte *>(m_header)) +
+                        m_header->blob_size);
+    }
+
+    EventRecord make_record(
+        EventType type,
+        MessageId msg,
+        int fd,
+        SessionId session) noexcept
+    {
+        EventRecord rec;
+        rec.type = type;
+        rec.msg = msg;
+        rec.fd = fd;
+        rec.session = session;
+        rec.ts_ns = platform::time::event_now();
+        return rec;
+    }
+
+    std::string render_message(const EventRecord &rec, const RecordArena &arena)
+    {
+        return render_message_with(rec, arena);
+    }
+
+    std::string render_message(const EventRecord &rec, const ArenaImage &arena)
+    {
+        return render_message_with(rec, arena);
+    }
+
+    std::string render_message(const EventRecord &rec, const ColdSegment &seg)
+    {
+        return render_message_with(rec, seg);
+    }
+
+    Event materialize(const EventRecord &rec, const RecordArena &arena)
+    {
+        return materialize_with(rec, arena);
+    }
+
+    Event materialize(const EventRecord &rec, const ArenaImage &arena)
+    {
+        return materialize_with(rec, arena);
+    }
+
+    Event materialize(const EventRecord &rec, const ColdSegment &seg)
+    {
+        return materialize_with(rec, seg);
+    }
+
+    EventRecord compact(const Event &e, RecordArena &arena)
+    {
+        EventRecord rec;
+        rec.type = e.type;
+        rec.msg = MessageId::Text;
+        rec.fd = e.fd.fd;
+        rec.session = e.session_id;
+        rec.ts_ns = platform::time::event_from_wall(e.ts);
+
+        if (e.kernel_ts)
+        {
+            rec.flags |= EventRecord::HAS_KERNEL_TS;
+            rec.kernel_delay_ns = platform::time::event_from_wall(*e.kernel_ts) - rec.ts_ns;
+        }
+
+        std::span<const std::byte> payload{};
+        if (e.payload)
+            payload = e.payload->empty()
+                          ? std::span<const std::byte>(&EMPTY_PAYLOAD, 0)
+                          : std::span<const std::byte>(*e.payload);
+
+        arena.attach(rec, RecordExtras{
+                              .text = e.msg,
+                              .payload = payload,
+                              .error = e.error ? &*e.error : nullptr,
+                              .tcp_info = e.tcp_info ? &*e.tcp_info : nullptr,
+                          });
+        return rec;
+    }
+}
@@ -0,0 +1,160 @@
+/*
+ * ============================================================================
+ *  File Name   : event_runs.cpp
+ *  Module      : core
+ *
+ *  Description :
+ *      线程局部事件段实现。写入端保存在 thread_local 数组中，
+ *      以实例编号区分不同的 EventRuns；实例销毁后残留的写入端
+ *      因 weak_ptr 失效而被惰性清理。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/core/event_runs.hpp"
+
+#include <algorithm>
+#include <queue>
+#include <tuple>
+
+namespace core
+{
+    namespace
+    {
+        // 实例编号只增不减 已销毁实例的编号不会被复用
+        std::atomic<std::uint64_t> g_next_id{1};
+
+        bool ts_before(const EventRecord &a, const EventRecord &b) { return a.ts_ns < b.ts_ns; }
+    }
+
+    EventRuns::Writer::~Writer() { seal(); }
+
+    void EventRuns::Writer::seal()
+    {
+        if (!run || run->records.empty())
+            return;
+
+        auto target = shared.lock();
+        if (!target)
+        {
+            run.reset();
+            return;
+        }
+
+        // 同一线程的打点通常已经有序 只有记录先构造后追加时才可能需要排序
+        auto &recs = run->records;
+        if (!std::is_sorted(recs.begin(), recs.end(), ts_before))
+            std::stable_sort(recs.begin(), recs.end(), ts_before);
+
+        std::size_t n = recs.size();
+        target->sealed.push(std::move(run));
+        target->pending.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    EventRuns::EventRuns(std::size_t run_capacity)
+        : m_id(g_next_id.fetch_add(1, std::memory_order_relaxed)),
+          m_capacity(std::max<std::size_t>(1, run_capacity)),
+          m_shared(std::make_shared<Shared>()) {}
+
+    EventRuns::Writer &EventRuns::local_writer()
+    {
+        thread_local std::vector<Writer> t_writers;
+
+        for (auto &w : t_writers)
+            if (w.owner == m_id)
+                return w;
+
+        // 顺便清理已销毁实例留下的写入端
+        std::erase_if(t_writers, [](const Writer &w)
+                      { return w.shared.expired(); });
+
+        Writer w;
+        w.owner = m_id;
+        w.shared = m_shared;
+        t_writers.push_back(std::move(w));
+        return t_writers.back();
+    }
+
+    void EventRuns::append(const EventRecord &rec, const RecordExtras &extras)
+    {
+        Writer &w = local_writer();
+        if (!w.run)
+        {
+            w.run = std::make_unique<EventRun>();
+            w.run->records.reserve(m_capacity);
+        }
+
+        EventRecord stored = rec;
+        stored.text = stored.payload = stored.error = stored.tcp_info = 0;
+        w.run->arena.attach(stored, extras);
+        w.run->records.push_back(stored);
+
+        if (w.run->records.size() >= m_capacity)
+            w.seal();
+    }
+
+    void EventRuns::flush()
+    {
+        local_writer().seal();
+    }
+
+    std::size_t EventRuns::collect(std::vector<RunPtr> &out, std::size_t limit)
+    {
+        std::size_t records = 0;
+        std::size_t n = m_shared->sealed.pop_all(
+            [&](RunPtr &&run)
+            {
+                records += run->records.size();
+                out.push_back(std::move(run));
+            },
+            limit);
+
+        m_shared->pending.fetch_sub(records, std::memory_order_relaxed);
+        return n;
+    }
+
+    std::vector<RecordRef> EventRuns::merge(const std::vector<RunPtr> &runs)
+    {
+        std::vector<RecordRef> out;
+
+        std::size_t total = 0;
+        for (const auto &r : runs)
+            total += r->records.size();
+        out.reserve(total);
+
+        if (runs.size() == 1)
+        {
+            for (const auto &rec : runs.front()->records)
+                out.push_back({&rec, &runs.front()->arena});
+            return out;
+        }
+
+        // 小顶堆：(时间戳, 段下标, 段内位置)
+        using Cursor = std::tuple<std::int64_t, std::size_t, std::size_t>;
+        std::priority_queue<Cursor, std::vector<Cursor>, std::greater<>> heap;
+
+        for (std::size_t i = 0; i < runs.size(); ++i)
+            if (!runs[i]->records.empty())
+                heap.emplace(runs[i]->records.front().ts_ns, i, 0);
+
+        while (!heap.empty())
+        {
+            auto [ts, i, pos] = heap.top();
+            heap.pop();
+
+            const auto &run = *runs[i];
+            out.push_back({&run.records[pos], &run.arena});
+
+            if (pos + 1 < run.records.size())
+                heap.emplace(run.records[pos + 1].ts_ns, i, pos + 1);
+        }
+
+        return out;
+    }
+}
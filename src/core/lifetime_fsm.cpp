@@ -18,6 +18,8 @@
 
 #include "eunet/core/lifecycle_fsm.hpp"
 
+#include <algorithm>
+
 #define STATE_CASE(name)        \
     case core::LifeState::name: \
         return #name
@@ -31,27 +33,48 @@ namespace core
     LifeState LifecycleFSM::current_state() const noexcept { return state; }
 
     LifecycleFSM::TimeStamp
-    LifecycleFSM::start_timestamp() const noexcept { return start_ts; }
+    LifecycleFSM::start_timestamp() const noexcept { return to_wall(start_ns); }
     LifecycleFSM::TimeStamp
-    LifecycleFSM::last_timestamp() const noexcept { return last_ts; }
+    LifecycleFSM::last_timestamp() const noexcept { return to_wall(last_ns); }
+
+    std::chrono::nanoseconds
+    LifecycleFSM::elapsed() const noexcept { return platform::time::event_elapsed(start_ns, last_ns); }
+
+    const platform::time::WallAnchor &
+    LifecycleFSM::wall_anchor() const noexcept { return anchor; }
+
+    LifecycleFSM::TimeStamp
+    LifecycleFSM::to_wall(std::int64_t event_ns) const noexcept { return anchor.to_wall(event_ns); }
 
     bool LifecycleFSM::has_error() const noexcept { return last_error.has_value(); }
     std::optional<util::Error>
     LifecycleFSM::get_last_error() const noexcept { return last_error; }
 
     void LifecycleFSM::on_event(const Event &e)
+    {
+        on_event(e.type, e.fd.fd, e.mono_ns, e.error ? &*e.error : nullptr);
+    }
+
+    void LifecycleFSM::on_event(
+        EventType type,
+        int event_fd,
+        std::int64_t event_ns,
+        const util::Error *err)
     {
         if (fd < 0)
-            fd = e.fd.fd;
+            fd = event_fd;
 
-        last_ts = e.ts;
-        if (state == LifeState::Init)
-            start_ts = e.ts;
+        if (state == LifeState::Init && start_ns == 0)
+        {
+            start_ns = event_ns;
+            anchor = platform::time::WallAnchor::capture();
+        }
+        last_ns = std::max(last_ns, event_ns);
 
         // -------- 全局错误处理 --------
-        if (e.is_error())
+        if (err)
         {
-            last_error = e.error.value();
+            last_error = *err;
             transit(LifeState::Error);
             return;
         }
@@ -59,7 +82,7 @@ namespace core
         switch (state)
         {
         case LifeState::Init:
-            switch (e.type)
+            switch (type)
             {
             case EventType::DNS_RESOLVE_START:
                 transit(LifeState::Resolving);
@@ -73,12 +96,12 @@ namespace core
             break;
 
         case LifeState::Resolving:
-            if (e.type == EventType::DNS_RESOLVE_DONE)
+            if (type == EventType::DNS_RESOLVE_DONE)
                 transit(LifeState::Connecting);
             break;
 
         case LifeState::Connecting:
-            switch (e.type)
+            switch (type)
             {
             case EventType::TCP_CONNECT_SUCCESS:
                 // 是否启用 TLS，通常由 config 决定
@@ -98,7 +121,7 @@ namespace core
             break;
 
         case LifeState::Handshaking:
-            switch (e.type)
+            switch (type)
             {
             case EventType::TLS_HANDSHAKE_DONE:
                 transit(LifeState::Established);
@@ -109,20 +132,20 @@ namespace core
             break;
 
         case LifeState::Established:
-            if (e.type == EventType::HTTP_REQUEST_BUILD ||
-                e.type == EventType::HTTP_SENT)
+            if (type == EventType::HTTP_REQUEST_BUILD ||
+                type == EventType::HTTP_SENT)
             {
                 transit(LifeState::Sending);
             }
             break;
 
         case LifeState::Sending:
-            if (e.type == EventType::HTTP_SENT)
+            if (type == EventType::HTTP_SENT)
                 transit(LifeState::Receiving);
             break;
 
         case LifeState::Receiving:
-            switch (e.type)
+            switch (type)
             {
             case EventType::HTTP_HEADERS_RECEIVED:
                 // still Receiving
@@ -166,18 +189,25 @@ namespace core
 
     void FsmManager::on_event(const Event &e)
     {
-        // if (!e.fd)
-        //     return;
+        on_event(e.type, e.fd.fd, e.session_id, e.mono_ns, e.error ? &*e.error : nullptr);
+    }
+
+    void FsmManager::on_event(
+        EventType type,
+        int fd,
+        SessionId sid,
+        std::int64_t event_ns,
+        const util::Error *err)
+    {
         // 允许存在无关联 fd 的事件
 
         std::lock_guard lock(mtx);
 
-        SessionId key = e.session_id;
-        auto it = fsms.find(e.fd.fd);
+        auto it = fsms.find(sid);
         if (it == fsms.end())
-            it = fsms.emplace(key, LifecycleFSM{e.fd.fd}).first;
+            it = fsms.emplace(sid, LifecycleFSM{fd}).first;
 
-        fsms[key].on_event(e);
+        it->second.on_event(type, fd, event_ns, err);
     }
 
     void FsmManager::clear()
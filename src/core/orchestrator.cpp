@@ -4,7 +4,7 @@
  *  Module      : core
  *
  *  Description :
- *      Orchestrator 实现。线程安全地接收 emit 请求，顺序更新 Timeline 和
+ *      Orchestrator 实现。线程安全地接收 emit / record 请求，顺序更新 Timeline 和
  *      FSM，构建 Snapshot 并分发给所有注册的 Sink。
  *
  *  Third-Party Dependencies :
@@ -21,6 +21,8 @@
 #include "eunet/core/event_snapshot.hpp"
 
 #include <algorithm>
+#include <optional>
+#include <utility>
 
 namespace core
 {
@@ -32,11 +34,49 @@ namespace core
     Orchestrator::EmitResult
     Orchestrator::emit(Event e)
     {
-        using Ret = EmitResult;
-        using util::Error;
-
         // 加锁 保护 Timeline 和 FSM 以及 Sink 列表
         std::lock_guard lock(mtx);
+        return commit(e);
+    }
+
+    void Orchestrator::submit(Event e)
+    {
+        inbox.push(std::move(e));
+        inbox_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    util::ResultV<std::size_t>
+    Orchestrator::drain(std::size_t limit)
+    {
+        using Ret = util::ResultV<std::size_t>;
+
+        if (inbox.empty())
+            return Ret::Ok(0);
+
+        // 生产者不碰这把锁 只与直接调用 emit 的线程互斥
+        std::lock_guard lock(mtx);
+
+        std::optional<util::Error> first_err;
+        std::size_t n = inbox.pop_all(
+            [&](Event &&e)
+            {
+                auto r = commit(e);
+                if (r.is_err() && !first_err)
+                    first_err = r.unwrap_err();
+            },
+            limit);
+        inbox_pending.fetch_sub(n, std::memory_order_relaxed);
+
+        if (first_err)
+            return Ret::Err(*first_err);
+        return Ret::Ok(n);
+    }
+
+    Orchestrator::EmitResult
+    Orchestrator::commit(Event &e)
+    {
+        using Ret = EmitResult;
+        using util::Error;
 
         // 将事件追加到 Timeline 数据库中
         auto idx_res = timeline.push(e);
@@ -55,56 +95,246 @@ namespace core
         // 将事件输入状态机管理器 更新对应 Session 的生命周期状态
         fsm_manager.on_event(e);
 
-        // 获取当前 Session 的状态机实例 如果是新建的则可能需要查找
-        const auto *fsm = fsm_manager.get(e.session_id);
+        std::size_t payload_size = e.payload ? e.payload->size() : 0;
+        deliver(
+            e.type, e.session_id, e.is_error(), payload_size,
+            [&](bool with_payload)
+            {
+                if (with_payload)
+                    return e;
+
+                // 不含载荷时临时移出 避免拷贝整段载荷
+                auto held = std::exchange(e.payload, std::nullopt);
+                Event lean = e;
+                e.payload = std::move(held);
+                return lean;
+            });
+
+        return Ret::Ok();
+    }
 
-        // 从 Timeline 取回刚刚存入的事件以确保一致性
-        auto latest_event_result = timeline.latest_event();
-        if (latest_event_result.is_err())
+    Orchestrator::EmitResult
+    Orchestrator::record(const EventRecord &rec, const RecordExtras &extras)
+    {
+        using Ret = EmitResult;
+        using util::Error;
+
+        std::lock_guard lock(mtx);
+
+        auto idx_res = timeline.push(rec, extras);
+        if (!idx_res.is_ok())
         {
             return Ret::Err(
                 Error::internal()
-                    .message("Failed to fetch latest event after commit")
-                    .context("Orchestrator::emit")
-                    .wrap(latest_event_result.unwrap_err())
+                    .resource_exhausted()
+                    .message("Failed to append record to timeline")
+                    .context("Orchestrator::record")
+                    .wrap(idx_res.unwrap_err())
+                    .build());
+        }
+        auto idx = idx_res.unwrap();
+
+        fsm_manager.on_event(rec.type, rec.fd, rec.session, rec.ts_ns, extras.error);
+
+        // 只有真正要交给 Sink 时才从 Timeline 还原事件 消息文本在此处才格式化
+        deliver(
+            rec.type, rec.session, extras.error != nullptr, extras.payload.size(),
+            [&](bool with_payload)
+            { return timeline.event_at(idx, with_payload).unwrap(); });
+
+        return Ret::Ok();
+    }
+
+    void Orchestrator::append(const EventRecord &rec, const RecordExtras &extras)
+    {
+        runs.append(rec, extras);
+    }
+
+    void Orchestrator::flush_local() { runs.flush(); }
+
+    util::ResultV<std::size_t>
+    Orchestrator::merge(std::size_t max_runs)
+    {
+        using Ret = util::ResultV<std::size_t>;
+        using util::Error;
+
+        std::vector<EventRuns::RunPtr> sealed;
+        if (runs.collect(sealed, max_runs) == 0)
+            return Ret::Ok(0);
+
+        // 归并在锁外完成 持锁期间只做整批写入与分发
+        auto batch = EventRuns::merge(sealed);
+
+        std::lock_guard lock(mtx);
+
+        auto cnt_res = timeline.push_sorted(batch);
+        if (cnt_res.is_err())
+        {
+            return Ret::Err(
+                Error::internal()
+                    .resource_exhausted()
+                    .message("Failed to merge event runs into timeline")
+                    .context("Orchestrator::merge")
+                    .wrap(cnt_res.unwrap_err())
                     .build());
         }
 
+        for (const auto &ref : batch)
+        {
+            const auto &rec = *ref.rec;
+            const auto *err = ref.arena->error(rec.error);
+            fsm_manager.on_event(rec.type, rec.fd, rec.session, rec.ts_ns, err);
+
+            deliver(
+                rec.type, rec.session, err != nullptr,
+                ref.arena->payload(rec.payload).size(),
+                [&](bool with_payload)
+                {
+                    if (with_payload)
+                        return materialize(rec, *ref.arena);
+
+                    EventRecord lean = rec;
+                    lean.payload = 0;
+                    return materialize(lean, *ref.arena);
+                });
+        }
+
+        return Ret::Ok(batch.size());
+    }
+
+    template <typename MakeEvent>
+    void Orchestrator::deliver(
+        EventType type,
+        SessionId sid,
+        bool is_error,
+        std::size_t payload_size,
+        MakeEvent &&make)
+    {
+        // 没有任何 Sink 订阅该类型时 不构建快照
+        const auto &targets = dispatch[static_cast<std::size_t>(type)];
+        if (targets.empty())
+        {
+            stat_skipped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // 获取当前 Session 的状态机实例
+        const auto *fsm = fsm_manager.get(sid);
+
         // 构建事件快照 包含原始事件、当前状态、累积错误等
         // 快照是不可变的数据结构 适合跨线程传递给 UI
-        EventSnapshot snap{
-            .event = e,
-            .fd = e.fd.fd,
-            .state = fsm ? fsm->current_state() : LifeState::Finished,
-            .ts = e.ts,
-            .error = fsm ? fsm->get_last_error() : std::nullopt,
-            .payload = e.payload,
+        // 含载荷与不含载荷两种快照各自按需构建 至多一次
+        auto build = [&](bool with_payload)
+        {
+            Event ev = make(with_payload);
+            // 展示时间以会话锚点换算 同一会话内的时间差与事件时钟一致
+            auto ts = fsm ? fsm->to_wall(ev.mono_ns) : ev.ts;
+            auto fd = ev.fd.fd;
+            auto payload = ev.payload;
+
+            EventSnapshot snap{
+                .event = std::move(ev),
+                .fd = fd,
+                .state = fsm ? fsm->current_state() : LifeState::Finished,
+                .ts = ts,
+                .error = fsm ? fsm->get_last_error() : std::nullopt,
+                .payload = std::move(payload),
+                .payload_size = payload_size,
+            };
+
+            stat_built.fetch_add(1, std::memory_order_relaxed);
+            if (with_payload && payload_size > 0)
+                stat_payload.fetch_add(1, std::memory_order_relaxed);
+            return snap;
         };
 
-        // 遍历所有注册的 Sink 分发快照
-        for (auto &sink : sinks)
+        std::optional<EventSnapshot> full, lean;
+        bool delivered = false;
+
+        // 按分发表依次交给感兴趣的 Sink
+        for (std::size_t i : targets)
         {
-            if (sink)
-                sink->on_event(snap);
+            const auto &entry = sinks[i];
+            if (!entry.interest.accepts(sid, is_error))
+            {
+                stat_filtered.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // 事件本身没有载荷时两种快照相同 共用一份
+            bool with_payload = entry.interest.payload && payload_size > 0;
+            auto &slot = with_payload ? full : lean;
+            if (!slot)
+                slot.emplace(build(with_payload));
+
+            entry.sink->on_event(*slot);
+            stat_deliveries.fetch_add(1, std::memory_order_relaxed);
+            delivered = true;
         }
 
-        return Ret::Ok();
+        if (!delivered)
+            stat_skipped.fetch_add(1, std::memory_order_relaxed);
     }
 
     void Orchestrator::attach(SinkPtr sink)
+    {
+        if (!sink)
+            return;
+
+        auto interest = sink->interest();
+        attach(std::move(sink), std::move(interest));
+    }
+
+    void Orchestrator::attach(SinkPtr sink, sink::Interest interest)
     {
         std::lock_guard lock(mtx);
-        if (sink)
-            sinks.push_back(sink);
+        if (!sink)
+            return;
+
+        sinks.push_back({std::move(sink), std::move(interest)});
+        rebuild_dispatch();
     }
 
     void Orchestrator::detach(SinkPtr sink)
     {
         std::lock_guard lock(mtx);
-        if (sink)
-            sinks.erase(
-                std::remove(sinks.begin(), sinks.end(), sink),
-                sinks.end());
+        if (!sink)
+            return;
+
+        sinks.erase(
+            std::remove_if(sinks.begin(), sinks.end(),
+                           [&](const SinkEntry &entry)
+                           { return entry.sink == sink; }),
+            sinks.end());
+        rebuild_dispatch();
+    }
+
+    void Orchestrator::rebuild_dispatch()
+    {
+        for (auto &list : dispatch)
+            list.clear();
+
+        for (std::size_t i = 0; i < sinks.size(); ++i)
+            for (std::size_t t = 0; t < EVENT_TYPE_COUNT; ++t)
+                if (sinks[i].interest.types.test(t))
+                    dispatch[t].push_back(i);
+    }
+
+    DispatchStats Orchestrator::dispatch_stats() const noexcept
+    {
+        return DispatchStats{
+            .snapshots_built = stat_built.load(std::memory_order_relaxed),
+            .payload_snapshots = stat_payload.load(std::memory_order_relaxed),
+            .snapshots_skipped = stat_skipped.load(std::memory_order_relaxed),
+            .deliveries = stat_deliveries.load(std::memory_order_relaxed),
+            .filtered = stat_filtered.load(std::memory_order_relaxed),
+        };
+    }
+
+    util::ResultV<void> Orchestrator::enable_spill(SpillOptions opts)
+    {
+        // Timeline 自行加锁，落盘回调不经过编排器的锁
+        return timeline.enable_spill(std::move(opts));
     }
 
     void Orchestrator::reset()
@@ -0,0 +1,154 @@
+/*
+ * ============================================================================
+ *  File Name   : replay_scenario.cpp
+ *  Module      : core
+ *
+ *  Description :
+ *      追踪回放场景实现。记录与变长数据直接取自映射内存，
+ *      按模拟时钟等待到期后经 Orchestrator::record() 提交。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/core/replay_scenario.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+namespace core::scenario
+{
+    namespace
+    {
+        // 单次休眠的上限，保证 stop() 能及时生效
+        constexpr std::int64_t WAIT_SLICE_NS = 50'000'000;
+    }
+
+    std::int64_t ReplayClock::trace_at(std::int64_t real_ns) const noexcept
+    {
+        if (unbounded())
+            return INT64_MAX;
+        return m_trace_origin + static_cast<std::int64_t>(
+                                    static_cast<double>(real_ns - m_real_origin) * m_speed);
+    }
+
+    std::int64_t ReplayClock::real_at(std::int64_t trace_ns) const noexcept
+    {
+        if (unbounded())
+            return m_real_origin;
+        return m_real_origin + static_cast<std::int64_t>(
+                                   static_cast<double>(trace_ns - m_trace_origin) / m_speed);
+    }
+
+    ReplayScenario::ReplayScenario(std::string path, ReplayConfig cfg)
+        : m_path(std::move(path)), m_cfg(cfg) {}
+
+    ReplayScenario::ReplayScenario(std::shared_ptr<const TraceFile> trace, ReplayConfig cfg)
+        : m_trace(std::move(trace)), m_cfg(cfg) {}
+
+    Scenario::RunResult ReplayScenario::run(Orchestrator &orch)
+    {
+        using Ret = RunResult;
+
+        m_stats = {};
+        if (!m_trace)
+        {
+            auto opened = TraceFile::open(m_path);
+            if (opened.is_err())
+                return Ret::Err(opened.unwrap_err());
+            m_trace = std::make_shared<const TraceFile>(std::move(opened).unwrap());
+        }
+
+        const auto &trace = *m_trace;
+        std::size_t first = std::min(m_cfg.first, trace.size());
+        std::size_t last = first + std::min(m_cfg.count, trace.size() - first);
+        if (first == last)
+            return Ret::Ok();
+
+        std::int64_t trace_origin = trace.ref_at(first).rec->ts_ns;
+        std::int64_t real_origin = platform::time::event_now();
+        ReplayClock clock(trace_origin, real_origin, m_cfg.speed);
+
+        std::unordered_map<SessionId, SessionId> sessions;
+        std::int64_t trace_min = trace_origin, trace_max = trace_origin;
+
+        for (std::size_t idx = first; idx < last; ++idx)
+        {
+            if (m_stop.stop_requested())
+            {
+                m_stats.stopped = true;
+                break;
+            }
+
+            auto ref = trace.ref_at(idx);
+            const auto &src = *ref.rec;
+            const auto &arena = *ref.arena;
+
+            // 乱序的记录不会让时钟回退：计划时刻已过则立即提交
+            if (!clock.unbounded())
+            {
+                auto due = clock.real_at(src.ts_ns);
+                if (!wait_until(due))
+                {
+                    m_stats.stopped = true;
+                    break;
+                }
+                m_stats.max_lag_ns = std::max(m_stats.max_lag_ns, platform::time::event_now() - due);
+            }
+
+            EventRecord rec = src;
+            rec.ts_ns = m_cfg.rebase ? real_origin + (src.ts_ns - trace_origin)
+                                     : trace.local_ts(src.ts_ns);
+
+            if (m_cfg.remap_sessions && src.session != 0)
+            {
+                auto [it, fresh] = sessions.try_emplace(src.session, 0);
+                if (fresh)
+                    it->second = orch.new_session();
+                rec.session = it->second;
+            }
+
+            std::optional<util::Error> err = arena.error(src.error);
+            RecordExtras extras{
+                .text = arena.text(src.text),
+                .payload = src.payload ? arena.payload(src.payload) : std::span<const std::byte>{},
+                .error = err ? &*err : nullptr,
+                .tcp_info = arena.tcp_info(src.tcp_info),
+            };
+
+            auto r = orch.record(rec, extras);
+            if (r.is_err())
+                return Ret::Err(r.unwrap_err());
+
+            ++m_stats.emitted;
+            trace_min = std::min(trace_min, src.ts_ns);
+            trace_max = std::max(trace_max, src.ts_ns);
+        }
+
+        m_stats.elapsed_ns = platform::time::event_now() - real_origin;
+        m_stats.trace_span_ns = trace_max - trace_min;
+        return Ret::Ok();
+    }
+
+    bool ReplayScenario::wait_until(std::int64_t real_ns) const
+    {
+        while (true)
+        {
+            auto remaining = real_ns - platform::time::event_now();
+            if (remaining <= 0)
+                return true;
+            if (m_stop.stop_requested())
+                return false;
+            std::this_thread::sleep_for(std::chrono::nanoseconds(std::min(remaining, WAIT_SLICE_NS)));
+        }
+    }
+}
@@ -4,8 +4,14 @@
  *  Module      : core
  *
  *  Description :
- *      Timeline 实现。维护事件的主存储 vector 以及基于 FD 和 Type 的
- *      辅助索引 (Hash Map)，提供线程安全的查询、排序和回放功能。
+ *      Timeline 实现。维护紧凑记录的分段主存储、基于 FD 和 Type 的
+ *      辅助索引 (Hash Map) 以及按全局下标串联的会话链，
+ *      提供线程安全的查询、排序和回放功能。
+ *      时间比较统一换算为记录的事件时钟纳秒进行。
+ *      修改历史记录（归并、排序、删除）时不改动已封存的段，而是从受影响的
+ *      位置起重写新段并发布新的段列表，旧快照仍指向原来的段。
+ *      落盘的段交给 ColdStore 在后台写入，完成后才在锁内替换进段列表；
+ *      改写冷段中的历史时由 Rewriter 逐段解码、重新编码后同步写回。
  *
  *  Third-Party Dependencies :
  *      None
@@ -19,21 +25,221 @@
 #include "eunet/core/timeline.hpp"
 
 #include <algorithm>
-#include <unordered_set>
+#include <initializer_list>
+#include <iterator>
+#include <queue>
+
+#include "eunet/core/cold_segment.hpp"
+#include "eunet/core/cold_store.hpp"
 
 namespace core
 {
+    namespace
+    {
+        bool ref_before(const RecordRef &a, const RecordRef &b) { return a.rec->ts_ns < b.rec->ts_ns; }
+
+        std::size_t segment_bytes(const TimelineSegment &seg)
+        {
+            return seg.records.capacity() * sizeof(EventRecord) + seg.arena.memory_bytes();
+        }
+
+        /** 只含 list 中完整位于 pos 之前的冷段的新段列表 */
+        std::shared_ptr<SegmentList> cold_part(const SegmentList &list, std::size_t pos = SIZE_MAX)
+        {
+            auto out = std::make_shared<SegmentList>();
+            for (std::size_t i = 0; i < list.cold.size(); ++i)
+                if (list.cold_starts[i] + list.cold_count(i) <= pos)
+                    out->append_cold(list.cold[i]);
+            return out;
+        }
+
+        /** 归并排序时的一路有序输入：逐条解码的冷段，或内存中记录的引用 */
+        struct Run
+        {
+            const ColdSegment *cold = nullptr;
+            ColdSegment::Decoder dec;
+            std::size_t left = 0;
+            EventRecord rec{};
+
+            std::span<const RecordRef> refs;
+            std::size_t pos = 0;
+
+            static Run of(const ColdSegment &seg)
+            {
+                Run r;
+                r.cold = &seg;
+                r.dec = ColdSegment::Decoder(seg, 0);
+                r.left = seg.size();
+                return r;
+            }
+
+            static Run of(std::span<const RecordRef> refs)
+            {
+                Run r;
+                r.refs = refs;
+                return r;
+            }
+
+            /** 取出第一条记录，没有记录时返回 false */
+            bool start() { return cold ? take() : !refs.empty(); }
+
+            /** 前进到下一条记录，没有更多记录时返回 false */
+            bool advance() { return cold ? take() : ++pos < refs.size(); }
+
+            std::int64_t ts() const noexcept { return cold ? rec.ts_ns : refs[pos].rec->ts_ns; }
+
+        private:
+            bool take()
+            {
+                if (left == 0 || !dec.next(rec))
+                    return false;
+                --left;
+                return true;
+            }
+        };
+    }
+
+    class Timeline::Rewriter
+    {
+    private:
+        Timeline &m_tl;
+        std::shared_ptr<SegmentList> m_list; // 重写期间独占，结束前不会被发布
+        std::shared_ptr<TimelineSegment> m_pending;
+        EvIdx m_cold_limit;
+        bool m_cold_ok;
+
+    public:
+        /** pos 位于冷段中时须是某个冷段的起点 */
+        Rewriter(Timeline &tl, EvIdx pos)
+            : m_tl(tl),
+              m_cold_limit(tl.sealed->cold_total),
+              m_cold_ok(tl.cold_store && !tl.spill_failure)
+        {
+            tl.truncate_locked(pos);
+            if (tl.ordered)
+                tl.last_ts = pos > 0 ? tl.ts_locked(pos - 1) : INT64_MIN;
+
+            m_list = std::make_shared<SegmentList>(*tl.sealed);
+            tl.sealed = m_list;
+        }
+
+        Rewriter(const Rewriter &) = delete;
+        Rewriter &operator=(const Rewriter &) = delete;
+
+        /** 写回内存中的记录 */
+        void push(const RecordRef &ref)
+        {
+            if (cold())
+                add_pending(pending().arena.adopt(*ref.rec, *ref.arena));
+            else
+                m_tl.append_ref_locked(ref);
+        }
+
+        /** 写回冷段中的记录，rec 的句柄属于 seg */
+        void push(const ColdSegment &seg, const EventRecord &rec)
+        {
+            if (cold())
+                add_pending(seg.adopt(rec, pending().arena));
+            else
+                m_tl.append_locked(seg.adopt(rec, m_tl.tail->arena));
+        }
+
+        /** 原样保留整个冷段，只为其中的记录重建索引；recs 为段内按顺序解码的全部记录 */
+        void keep(const std::shared_ptr<const ColdSegment> &seg, std::span<const EventRecord> recs)
+        {
+            flush();
+            if (!cold())
+            {
+                for (const auto &rec : recs)
+                    push(*seg, rec);
+                return;
+            }
+
+            m_list->append_cold(seg);
+            for (const auto &rec : recs)
+                m_tl.index_locked(rec);
+        }
+
+        /** 写出未满的冷段，新内容由下一次取快照发布 */
+        void finish()
+        {
+            flush();
+            ++m_tl.version;
+            m_tl.published.reset();
+        }
+
+    private:
+        bool cold() const noexcept
+        {
+            return m_cold_ok && m_tl.count.load(std::memory_order_relaxed) < m_cold_limit;
+        }
+
+        TimelineSegment &pending()
+        {
+            if (!m_pending)
+            {
+                m_pending = std::make_shared<TimelineSegment>();
+                m_pending->records.reserve(SEGMENT_CAPACITY);
+            }
+            return *m_pending;
+        }
+
+        void add_pending(const EventRecord &rec)
+        {
+            m_pending->records.push_back(rec);
+            m_tl.index_locked(rec);
+
+            if (m_pending->records.size() >= SEGMENT_CAPACITY ||
+                m_tl.count.load(std::memory_order_relaxed) >= m_cold_limit)
+                flush();
+        }
+
+        void flush()
+        {
+            if (!m_pending || m_pending->records.empty())
+                return;
+
+            auto seg = std::move(m_pending);
+            auto res = ColdStore::write(m_tl.spill.dir, *seg);
+            if (res.is_ok())
+            {
+                m_list->append_cold(std::move(res).unwrap());
+                return;
+            }
+
+            // 写入失败：停止落盘，该段与之后的记录留在内存中
+            m_tl.spill_failure = res.unwrap_err();
+            m_tl.spill_queue.clear();
+            m_cold_ok = false;
+            m_list->append(std::move(seg));
+        }
+    };
+
+    Timeline::Timeline() = default;
+    Timeline::~Timeline() = default;
+
     void Timeline::clear()
     {
         std::lock_guard lock(mtx);
 
-        events.clear();
+        sealed = std::make_shared<SegmentList>();
+        tail = std::make_shared<TimelineSegment>();
         fd_index.clear();
         type_index.clear();
+        error_index.clear();
+        session_index.clear();
+        session_next.clear();
+        ordered = true;
+        last_ts = INT64_MIN;
+        count.store(0, std::memory_order_release);
+        spill_queue.clear();
+
+        ++version;
+        published.reset();
     }
 
     Timeline::EvCnt
-    Timeline::size() const noexcept { return events.size(); }
+    Timeline::size() const noexcept { return count.load(std::memory_order_acquire); }
 
     Timeline::EvCnt
     Timeline::count_by_fd(int fd) const
@@ -41,7 +247,7 @@ namespace core
         std::lock_guard lock(mtx);
         auto it = fd_index.find(fd);
         return it != fd_index.end()
-                   ? it->second.size()
+                   ? it->second.cardinality()
                    : 0UL;
     }
 
@@ -51,7 +257,7 @@ namespace core
         std::lock_guard lock(mtx);
         auto it = type_index.find(type);
         return it != type_index.end()
-                   ? it->second.size()
+                   ? it->second.cardinality()
                    : 0UL;
     }
 
@@ -60,23 +266,17 @@ namespace core
         TimeStamp start,
         TimeStamp end) const
     {
-        std::lock_guard lock(mtx);
-
-        if (start > end)
-            return 0UL;
-
-        auto comp = [](const Event &e, const TimeStamp &t)
-        { return e.ts < t; };
+        return snapshot().count_by_time(start, end);
+    }
 
-        auto it_start = std::lower_bound(
-            events.begin(), events.end(), start,
-            [](const Event &e, const TimeStamp &t)
-            { return e.ts < t; });
-        auto it_end = std::upper_bound(
-            events.begin(), events.end(), end,
-            [](const TimeStamp &t, const Event &e)
-            { return t < e.ts; });
-        return it_end - it_start;
+    Timeline::EvCnt
+    Timeline::count_by_session(SessionId sid) const
+    {
+        std::lock_guard lock(mtx);
+        auto it = session_index.find(sid);
+        return it != session_index.end()
+                   ? it->second.count
+                   : 0UL;
     }
 
     bool Timeline::has_type(EventType type) const noexcept
@@ -90,37 +290,35 @@ namespace core
     {
         std::lock_guard lock(mtx);
 
-        std::sort(
-            events.begin(), events.end(),
-            [](const Event &a, const Event &b)
-            { return a.ts < b.ts; });
+        // 经 push_sorted 归并写入的时间线本就有序 不必重排
+        EvCnt n = count.load(std::memory_order_relaxed);
+        if (ordered)
+            return EvCntResult::Ok(n);
 
-        fd_index.clear();
-        type_index.clear();
-        for (size_t i = 0; i < events.size(); ++i)
+        if (sealed->cold_total > 0)
         {
-            if (events[i].fd)
-                fd_index[events[i].fd.fd].push_back(i);
-            type_index[events[i].type].push_back(i);
+            sort_cold_locked();
+            return EvCntResult::Ok(n);
         }
 
-        return EvCntResult::Ok(events.size());
+        // 只对引用排序，变长数据在重写时随记录一并搬入新段
+        std::vector<RecordRef> refs;
+        refs.reserve(n);
+        for_each_locked([&](const RecordRef &ref)
+                        { refs.push_back(ref); });
+        std::stable_sort(refs.begin(), refs.end(), ref_before);
+
+        last_ts = INT64_MIN;
+        ordered = true;
+        rewrite_from_locked(0, refs);
+        return EvCntResult::Ok(n);
     }
 
     Timeline::EvIdxResult
     Timeline::push(const Event &e)
     {
         std::lock_guard lock(mtx);
-
-        events.push_back(e);
-        size_t idx = events.size() - 1;
-
-        if (e.fd)
-            fd_index[e.fd.fd].push_back(idx);
-
-        type_index[e.type].push_back(idx);
-
-        return EvIdxResult::Ok(idx);
+        return EvIdxResult::Ok(append_locked(compact(e, tail->arena)));
     }
 
     Timeline::EvCntResult
@@ -128,97 +326,100 @@ namespace core
     {
         std::lock_guard lock(mtx);
 
-        EvCnt count = 0;
-        events.reserve(events.size() + arr.size());
+        EvCnt n = 0;
         for (const auto &e : arr)
         {
-            events.push_back(e);
-            EvIdx idx = events.size() - 1;
-            if (e.fd)
-                fd_index[e.fd.fd].push_back(idx);
-            type_index[e.type].push_back(idx);
-            ++count;
+            append_locked(compact(e, tail->arena));
+            ++n;
         }
 
-        return EvCntResult::Ok(count);
+        return EvCntResult::Ok(n);
     }
 
-    Timeline::EvCnt
-    Timeline::remove_by_fd(int fd)
+    Timeline::EvIdxResult
+    Timeline::push(const EventRecord &rec, const RecordExtras &extras)
     {
         std::lock_guard lock(mtx);
 
-        auto it = fd_index.find(fd);
-        if (it == fd_index.end())
-            return 0UL;
+        EventRecord stored = rec;
+        stored.text = stored.payload = stored.error = stored.tcp_info = 0;
+        tail->arena.attach(stored, extras);
 
-        IdxList &idxs = it->second;
-        int count = 0;
+        return EvIdxResult::Ok(append_locked(stored));
+    }
 
-        std::vector<Event> new_events;
-        QuerySet<int> new_fd_index;
-        QuerySet<EventType> new_type_index;
+    Timeline::EvCntResult
+    Timeline::push_sorted(std::span<const RecordRef> batch)
+    {
+        std::lock_guard lock(mtx);
 
-        for (size_t i = 0; i < events.size(); ++i)
+        if (batch.empty())
+            return EvCntResult::Ok(0);
+
+        bool batch_sorted = std::is_sorted(batch.begin(), batch.end(), ref_before);
+        std::int64_t first = batch.front().rec->ts_ns;
+        EvIdx n = count.load(std::memory_order_relaxed);
+
+        if (ordered && batch_sorted && n > 0 && first < last_ts)
         {
-            if (std::find(idxs.begin(), idxs.end(), i) != idxs.end())
-                ++count;
-            else
+            // 只有尾部晚于批次起点的部分需要与批次归并 其余保持原位
+            EvIdx pos = upper_bound_locked(first);
+            if (pos < sealed->cold_total)
             {
-                Event &e = events[i];
-                size_t new_idx = new_events.size();
-                new_events.push_back(e);
-
-                if (e.fd)
-                    new_fd_index[e.fd.fd].push_back(new_idx);
-                new_type_index[e.type].push_back(new_idx);
+                merge_cold_locked(pos, batch);
+                return EvCntResult::Ok(batch.size());
             }
-        }
 
-        events = std::move(new_events);
-        fd_index = std::move(new_fd_index);
-        type_index = std::move(new_type_index);
+            std::vector<RecordRef> merged;
+            merged.reserve(n - pos + batch.size());
+
+            std::vector<RecordRef> overlap;
+            overlap.reserve(n - pos);
+            for (EvIdx idx = pos; idx < n; ++idx)
+                overlap.push_back(ref_locked(idx));
+
+            // 时间戳相同时已有记录在前
+            std::merge(
+                overlap.begin(), overlap.end(),
+                batch.begin(), batch.end(),
+                std::back_inserter(merged), ref_before);
+            rewrite_from_locked(pos, merged);
+        }
+        else
+        {
+            // append_locked 自行判断是否打破有序
+            for (const auto &ref : batch)
+                append_ref_locked(ref);
+        }
 
-        return count;
+        return EvCntResult::Ok(batch.size());
     }
 
     Timeline::EvCnt
-    Timeline::remove_by_type(EventType type)
+    Timeline::remove_by_fd(int fd)
     {
         std::lock_guard lock(mtx);
 
-        auto it = type_index.find(type);
-        if (it == type_index.end())
+        auto it = fd_index.find(fd);
+        if (it == fd_index.end())
             return 0UL;
 
-        IdxList &idxs = it->second;
-        int count = 0;
-
-        std::vector<Event> new_events;
-        QuerySet<int> new_fd_index;
-        QuerySet<EventType> new_type_index;
-
-        for (size_t i = 0; i < events.size(); ++i)
-        {
-            if (events[i].type == type)
-                ++count;
-            else
-            {
-                Event &e = events[i];
-                size_t new_idx = new_events.size();
-                new_events.push_back(e);
+        // 从第一条命中的记录起检查，之前已落盘的段不必解压
+        return remove_if_locked(
+            [fd](const EventRecord &r)
+            { return r.fd == fd; },
+            it->second.minimum());
+    }
 
-                if (e.fd)
-                    new_fd_index[e.fd.fd].push_back(new_idx);
-                new_type_index[e.type].push_back(new_idx);
-            }
-        }
+    Timeline::EvCnt
+    Timeline::remove_by_type(EventType type)
+    {
+        std::lock_guard lock(mtx);
 
-        events = std::move(new_events);
-        fd_index = std::move(new_fd_index);
-        type_index = std::move(new_type_index);
+        if (type_index.find(type) == type_index.end())
+            return 0UL;
 
-        return count;
+        return remove_by_type_locked(type);
     }
 
     Timeline::EvCnt
@@ -231,83 +432,57 @@ namespace core
         if (start > end)
             return 0UL;
 
-        EvCnt count = 0;
-        std::vector<Event> new_events;
-        QuerySet<int> new_fd_index;
-        QuerySet<EventType> new_type_index;
+        auto lo = platform::time::event_from_wall(start);
+        auto hi = platform::time::event_from_wall(end);
+        return remove_if_locked(
+            [lo, hi](const EventRecord &r)
+            { return r.ts_ns >= lo && r.ts_ns <= hi; },
+            ordered ? lower_bound_locked(lo) : 0);
+    }
 
-        for (size_t i = 0; i < events.size(); ++i)
-        {
-            const Event &e = events[i];
-            if (e.ts >= start && e.ts <= end)
-                ++count;
-            else
-            {
-                size_t new_idx = new_events.size();
-                new_events.push_back(e);
-                if (e.fd)
-                    new_fd_index[e.fd.fd].push_back(new_idx);
-                new_type_index[e.type].push_back(new_idx);
-            }
-        }
+    Timeline::EvCnt
+    Timeline::remove_by_session(SessionId sid)
+    {
+        std::lock_guard lock(mtx);
 
-        events = std::move(new_events);
-        fd_index = std::move(new_fd_index);
-        type_index = std::move(new_type_index);
+        auto it = session_index.find(sid);
+        if (sid == 0 || it == session_index.end())
+            return 0UL;
 
-        return count;
+        return remove_if_locked(
+            [sid](const EventRecord &r)
+            { return r.session == sid; },
+            it->second.head);
     }
 
     Timeline::EvList
     Timeline::replay_all() const
     {
-        std::lock_guard lock(mtx);
-
-        EvList result;
-        result.reserve(events.size());
-        for (const auto &e : events)
-            result.push_back(e);
-
-        return result;
+        return snapshot().replay_all();
     }
 
     Timeline::EvList
     Timeline::replay_by_fd(int fd) const
     {
-        std::lock_guard lock(mtx);
-        return query_by_fd_locked(fd);
+        return query_indexed(fd_index, fd);
     }
 
     Timeline::EvList
     Timeline::replay_since(TimeStamp ts) const
     {
-        std::lock_guard lock(mtx);
-
-        auto it_start = std::lower_bound(
-            events.begin(), events.end(), ts,
-            [](const Event &e, TimeStamp t)
-            { return e.ts < t; });
-
-        EvList result;
-        result.reserve(events.end() - it_start);
-        for (auto it = it_start; it != events.end(); ++it)
-            result.push_back(*it);
-
-        return result;
+        return snapshot().replay_since(ts);
     }
 
     Timeline::EvList
     Timeline::query_by_fd(int fd) const
     {
-        std::lock_guard lock(mtx);
-        return query_by_fd_locked(fd);
+        return query_indexed(fd_index, fd);
     }
 
     Timeline::EvList
     Timeline::query_by_type(EventType type) const
     {
-        std::lock_guard lock(mtx);
-        return query_by_type_locked(type);
+        return query_indexed(type_index, type);
     }
 
     Timeline::EvList
@@ -315,21 +490,55 @@ namespace core
         TimeStamp start,
         TimeStamp end) const
     {
-        std::lock_guard lock(mtx);
-        return query_by_time_locked(start, end);
+        return snapshot().query_by_time(start, end);
+    }
+
+    Timeline::EvList
+    Timeline::query_by_session(SessionId sid) const
+    {
+        IdxList idxs;
+        TimelineSnapshot snap;
+        {
+            std::lock_guard lock(mtx);
+            auto it = session_index.find(sid);
+            if (it == session_index.end())
+                return {};
+
+            idxs.reserve(it->second.count);
+            for (EvIdx idx = it->second.head; idx != NO_NEXT; idx = session_next[idx])
+                idxs.push_back(idx);
+            snap = snapshot_locked();
+        }
+
+        return snap.materialize(idxs);
     }
 
     Timeline::EvList
     Timeline::query_errors() const
     {
-        std::lock_guard lock(mtx);
+        return query(TimelineQuery{.errors_only = true});
+    }
 
-        EvList result;
-        for (const auto &e : events)
-            if (e.error)
-                result.push_back(e);
+    Timeline::EvList
+    Timeline::query(const TimelineQuery &q) const
+    {
+        IdxList idxs;
+        TimelineSnapshot snap;
+        {
+            std::lock_guard lock(mtx);
+            if (select_locked(q, &idxs) == 0)
+                return {};
+            snap = snapshot_locked();
+        }
+
+        return snap.materialize(idxs);
+    }
 
-        return result;
+    Timeline::EvCnt
+    Timeline::count_matching(const TimelineQuery &q) const
+    {
+        std::lock_guard lock(mtx);
+        return select_locked(q, nullptr);
     }
 
     Timeline::EvResult
@@ -340,14 +549,15 @@ namespace core
 
         std::lock_guard lock(mtx);
 
-        if (events.empty())
+        EvCnt n = count.load(std::memory_order_relaxed);
+        if (n == 0)
             return Ret::Err(
                 Error::state()
                     .invalid_state()
                     .message("Cannot fetch latest event: Timeline is empty")
                     .build());
 
-        return Ret::Ok(events.back());
+        return Ret::Ok(event_locked(n - 1));
     }
 
     Timeline::EvResult
@@ -358,9 +568,8 @@ namespace core
 
         std::lock_guard lock(mtx);
 
-        auto res = query_by_fd_locked(fd);
-
-        if (res.empty())
+        auto it = fd_index.find(fd);
+        if (it == fd_index.end() || it->second.empty())
         {
             return Ret::Err(
                 Error::state()
@@ -370,7 +579,7 @@ namespace core
                     .build());
         }
 
-        return Ret::Ok(res.back());
+        return Ret::Ok(event_locked(it->second.maximum()));
     }
 
     Timeline::EvResult
@@ -381,9 +590,8 @@ namespace core
 
         std::lock_guard lock(mtx);
 
-        auto res = query_by_type_locked(type);
-
-        if (res.empty())
+        auto it = type_index.find(type);
+        if (it == type_index.end() || it->second.empty())
         {
             return Ret::Err(
                 Error::state()
@@ -393,97 +601,868 @@ namespace core
                     .build());
         }
 
-        return Ret::Ok(res.back());
+        return Ret::Ok(event_locked(it->second.maximum()));
     }
 
-    Timeline::EvList
-    Timeline::query_by_fd_locked(int fd) const
+    Timeline::EvResult
+    Timeline::event_at(EvIdx idx, bool with_payload) const
     {
-        EvList result;
-        auto it = fd_index.find(fd);
-        if (it == fd_index.end())
-            return result;
+        using Ret = EvResult;
+        using util::Error;
 
-        result.reserve(it->second.size());
-        for (auto idx : it->second)
-            if (idx < events.size())
-                result.push_back(events[idx]);
+        std::lock_guard lock(mtx);
 
-        return result;
+        if (idx >= count.load(std::memory_order_relaxed))
+        {
+            return Ret::Err(
+                Error::state()
+                    .target_not_found()
+                    .message("Event index out of range")
+                    .context(std::to_string(idx))
+                    .build());
+        }
+
+        return Ret::Ok(event_locked(idx, with_payload));
     }
 
-    Timeline::EvList
-    Timeline::query_by_type_locked(
-        EventType type) const
+    std::size_t Timeline::memory_bytes() const
     {
-        EvList result;
-        auto it = type_index.find(type);
-        if (it == type_index.end())
-            return result;
+        std::lock_guard lock(mtx);
+        return memory_bytes_locked();
+    }
+
+    util::ResultV<void> Timeline::enable_spill(SpillOptions opts)
+    {
+        using Ret = util::ResultV<void>;
+        using util::Error;
+
+        if (opts.memory_budget == 0)
+        {
+            return Ret::Err(
+                Error::internal()
+                    .invalid_argument()
+                    .message("Spill memory budget must be positive")
+                    .context("Timeline::enable_spill")
+                    .build());
+        }
 
-        result.reserve(it->second.size());
-        for (auto idx : (*it).second)
-            if (idx < events.size())
-                result.push_back(events[idx]);
+        // 后台线程在回调中加锁，创建与替换写入器都在锁外进行
+        auto store = ColdStore::create(
+            opts.dir,
+            [this](const auto &seg, auto &&res)
+            { on_spilled(seg, std::move(res)); });
+        if (store.is_err())
+            return Ret::Err(store.unwrap_err());
 
-        return result;
+        std::unique_ptr<ColdStore> old;
+        {
+            std::lock_guard lock(mtx);
+            spill = std::move(opts);
+            spill_queue.clear();
+            spill_failure.reset();
+            old = std::exchange(cold_store, std::move(store).unwrap());
+            spill_locked();
+        }
+        return Ret::Ok();
     }
 
-    Timeline::EvList
-    Timeline::query_by_time_locked(
-        TimeStamp start,
-        TimeStamp end) const
+    void Timeline::flush_spill()
     {
-        EvList result;
-        if (start > end)
-            return result;
+        ColdStore *store;
+        {
+            std::lock_guard lock(mtx);
+            store = cold_store.get();
+        }
+        if (store)
+            store->flush();
+    }
 
-        auto it_start = std::lower_bound(
-            events.begin(), events.end(), start,
-            [](const Event &e, const TimeStamp &t)
-            { return e.ts < t; });
-        auto it_end = std::upper_bound(
-            events.begin(), events.end(), end,
-            [](const TimeStamp &t, const Event &e)
-            { return t < e.ts; });
+    Timeline::EvCnt
+    Timeline::cold_size() const
+    {
+        std::lock_guard lock(mtx);
+        return sealed->cold_total;
+    }
 
-        result.reserve(it_end - it_start);
-        for (auto it = it_start; it != it_end; ++it)
-            result.push_back(*it);
+    std::size_t Timeline::disk_bytes() const
+    {
+        std::lock_guard lock(mtx);
 
-        return result;
+        std::size_t bytes = 0;
+        for (const auto &seg : sealed->cold)
+            bytes += seg->image_bytes();
+        return bytes;
     }
 
-    void Timeline::rebuild_indexes_locked(const std::vector<Event> &arr)
+    std::optional<util::Error> Timeline::spill_error() const
     {
-        fd_index.clear();
-        type_index.clear();
+        std::lock_guard lock(mtx);
+        return spill_failure;
+    }
+
+    TimelineSnapshot Timeline::snapshot() const
+    {
+        std::lock_guard lock(mtx);
+        return snapshot_locked();
+    }
 
-        size_t len = arr.size();
-        for (size_t idx = 0; idx < len; ++idx)
+    RecordRef Timeline::ref_locked(EvIdx idx) const noexcept
+    {
+        if (idx < sealed->total)
+            return sealed->at(idx);
+        return {&tail->records[idx - sealed->total], &tail->arena};
+    }
+
+    std::int64_t Timeline::ts_locked(EvIdx idx) const noexcept
+    {
+        if (idx < sealed->cold_total)
+            return sealed->cold_ts(idx);
+        return ref_locked(idx).rec->ts_ns;
+    }
+
+    Event Timeline::event_locked(EvIdx idx, bool with_payload) const
+    {
+        if (idx < sealed->cold_total)
+            return sealed->cold_event(idx, with_payload);
+
+        auto ref = ref_locked(idx);
+        if (with_payload)
+            return materialize(*ref.rec, *ref.arena);
+
+        EventRecord lean = *ref.rec;
+        lean.payload = 0;
+        return materialize(lean, *ref.arena);
+    }
+
+    Timeline::EvIdx
+    Timeline::append_locked(const EventRecord &rec)
+    {
+        if (tail->records.capacity() == 0)
+            tail->records.reserve(SEGMENT_CAPACITY);
+
+        tail->records.push_back(rec);
+        EvIdx idx = index_locked(rec);
+
+        if (tail->records.size() >= SEGMENT_CAPACITY)
+        {
+            seal_tail_locked();
+            spill_locked();
+        }
+
+        return idx;
+    }
+
+    Timeline::EvIdx
+    Timeline::index_locked(const EventRecord &rec)
+    {
+        if (rec.ts_ns < last_ts)
+            ordered = false;
+        else
+            last_ts = rec.ts_ns;
+
+        EvIdx idx = count.load(std::memory_order_relaxed);
+
+        auto bit = static_cast<std::uint32_t>(idx);
+        if (rec.fd >= 0)
+            fd_index[rec.fd].add(bit);
+        type_index[rec.type].add(bit);
+        if (rec.is_error())
+            error_index.add(bit);
+
+        session_next.push_back(NO_NEXT);
+        if (rec.session != 0)
+        {
+            auto [it, inserted] = session_index.try_emplace(rec.session, SessionChain{idx, idx, 0, {}});
+            if (!inserted)
+                session_next[it->second.tail] = idx;
+            it->second.tail = idx;
+            ++it->second.count;
+            it->second.members.add(bit);
+        }
+
+        count.store(idx + 1, std::memory_order_release);
+        ++version;
+        return idx;
+    }
+
+    Timeline::EvIdx
+    Timeline::append_ref_locked(const RecordRef &ref)
+    {
+        return append_locked(tail->arena.adopt(*ref.rec, *ref.arena));
+    }
+
+    void Timeline::seal_tail_locked() const
+    {
+        if (tail->records.empty())
+            return;
+
+        // 提前封存的尾段不必保留整段容量
+        if (tail->records.capacity() > tail->records.size() * 2)
+            tail->records.shrink_to_fit();
+
+        // 段列表按值复制后发布，已发布的版本从不原地修改
+        auto list = std::make_shared<SegmentList>(*sealed);
+        list->append(std::move(tail));
+        sealed = std::move(list);
+        tail = std::make_shared<TimelineSegment>();
+    }
+
+    TimelineSnapshot Timeline::snapshot_locked() const
+    {
+        if (published && published_version == version)
+            return {published, ordered};
+
+        if (tail->records.size() >= SNAPSHOT_SEAL_MIN)
+            seal_tail_locked();
+
+        if (tail->records.empty())
+        {
+            published = sealed;
+        }
+        else
+        {
+            // 尾段较短 复制一份而不是封存 避免频繁取快照时产生大量碎段
+            auto copy = std::make_shared<TimelineSegment>();
+            copy->records.reserve(tail->records.size());
+            for (const auto &rec : tail->records)
+                copy->records.push_back(copy->arena.adopt(rec, tail->arena));
+
+            auto list = std::make_shared<SegmentList>(*sealed);
+            list->append(std::move(copy));
+            published = std::move(list);
+        }
+
+        published_version = version;
+        return {published, ordered};
+    }
+
+    void Timeline::truncate_locked(EvIdx pos)
+    {
+        auto fresh = std::make_shared<TimelineSegment>();
+
+        if (pos >= sealed->total)
+        {
+            // 已封存的段全部保留 只截断尾段
+            for (EvIdx i = sealed->total; i < pos; ++i)
+            {
+                const auto &rec = tail->records[i - sealed->total];
+                fresh->records.push_back(fresh->arena.adopt(rec, tail->arena));
+            }
+        }
+        else
+        {
+            // 完整位于 pos 之前的段继续共享，跨越 pos 的段只把前半部分复制进新尾段
+            // pos 位于冷段中时调用方保证它是某个冷段的起点
+            auto list = cold_part(*sealed, pos);
+            for (std::size_t i = 0; i < sealed->segments.size(); ++i)
+            {
+                const auto &seg = sealed->segments[i];
+                std::size_t start = sealed->starts[i];
+                if (start + seg->records.size() <= pos)
+                {
+                    list->append(seg);
+                    continue;
+                }
+
+                for (std::size_t j = 0; start + j < pos; ++j)
+                    fresh->records.push_back(fresh->arena.adopt(seg->records[j], seg->arena));
+                break;
+            }
+            sealed = std::move(list);
+
+            // 被丢弃的段即使写完也不再替换
+            std::size_t kept = 0;
+            while (kept < spill_queue.size() && kept < sealed->segments.size() &&
+                   spill_queue[kept].seg == sealed->segments[kept].get())
+                ++kept;
+            spill_queue.resize(kept);
+        }
+
+        tail = std::move(fresh);
+        truncate_indexes_locked(pos);
+        count.store(pos, std::memory_order_release);
+
+        ++version;
+        published.reset();
+    }
+
+    void Timeline::truncate_indexes_locked(EvIdx pos)
+    {
+        // 位图按块有序 截掉 pos 及之后的部分只触及末尾的块
+        auto bit = static_cast<std::uint32_t>(std::min<EvIdx>(pos, UINT32_MAX));
+        auto truncate = [bit](auto &index)
+        {
+            for (auto it = index.begin(); it != index.end();)
+            {
+                it->second.remove_from(bit);
+                it = it->second.empty() ? index.erase(it) : std::next(it);
+            }
+        };
+        truncate(fd_index);
+        truncate(type_index);
+        error_index.remove_from(bit);
+        truncate_sessions_locked(pos);
+    }
+
+    void Timeline::truncate_sessions_locked(EvIdx pos)
+    {
+        // 只有链尾落在 pos 之后的会话受影响，沿链找到 pos 之前的最后一条作为新链尾
+        for (auto it = session_index.begin(); it != session_index.end();)
+        {
+            auto &chain = it->second;
+            if (chain.tail < pos)
+            {
+                ++it;
+                continue;
+            }
+            if (chain.head >= pos)
+            {
+                it = session_index.erase(it);
+                continue;
+            }
+
+            EvIdx cur = chain.head;
+            EvCnt cnt = 1;
+            while (session_next[cur] != NO_NEXT && session_next[cur] < pos)
+            {
+                cur = session_next[cur];
+                ++cnt;
+            }
+            session_next[cur] = NO_NEXT;
+            chain.tail = cur;
+            chain.count = cnt;
+            chain.members.remove_from(static_cast<std::uint32_t>(pos));
+            ++it;
+        }
+
+        if (session_next.size() > pos)
+            session_next.resize(pos);
+    }
+
+    void Timeline::rewrite_from_locked(EvIdx pos, std::span<const RecordRef> refs)
+    {
+        // refs 可能指向即将被替换的段 重写完成前保持它们存活
+        auto hold_sealed = sealed;
+        auto hold_tail = tail;
+
+        truncate_locked(pos);
+
+        if (ordered)
+            last_ts = pos > 0 ? ts_locked(pos - 1) : INT64_MIN;
+
+        for (const auto &ref : refs)
+            append_ref_locked(ref);
+    }
+
+    Timeline::EvIdx
+    Timeline::find_cold_locked(
+        const std::function<bool(const EventRecord &)> &pred,
+        EvIdx from) const
+    {
+        const auto &list = *sealed;
+        for (std::size_t i = list.cold_index(from); i < list.cold.size(); ++i)
+        {
+            EvIdx start = list.cold_starts[i];
+            EvIdx j = from > start ? from - start : 0;
+            ColdSegment::Decoder dec(*list.cold[i], j);
+            EventRecord rec;
+            for (; j < list.cold_count(i) && dec.next(rec); ++j)
+                if (pred(rec))
+                    return start + j;
+        }
+        return list.cold_total;
+    }
+
+    Timeline::EvCnt
+    Timeline::remove_cold_locked(
+        const std::function<bool(const EventRecord &)> &pred,
+        EvIdx first)
+    {
+        // 重写期间旧段列表保持存活，冷段的映射与内存段的记录都从中读取
+        auto old = sealed;
+        auto old_tail = tail;
+
+        std::size_t ci = old->cold_index(first);
+        EvCnt removed = 0;
+        Rewriter rw(*this, old->cold_starts[ci]);
+
+        std::vector<EventRecord> recs;
+        for (std::size_t i = ci; i < old->cold.size(); ++i)
+        {
+            const auto &seg = old->cold[i];
+            recs.clear();
+            seg->for_each([&](EvIdx, const EventRecord &r)
+                          { recs.push_back(r); });
+
+            EvCnt hits = 0;
+            for (const auto &r : recs)
+                hits += pred(r);
+
+            // 没有命中的段原样保留，只因下标前移重建索引
+            if (hits == 0)
+            {
+                rw.keep(seg, recs);
+                continue;
+            }
+
+            removed += hits;
+            for (const auto &r : recs)
+                if (!pred(r))
+                    rw.push(*seg, r);
+        }
+
+        auto push_hot = [&](const TimelineSegment &seg)
+        {
+            for (const auto &r : seg.records)
+            {
+                if (pred(r))
+                    ++removed;
+                else
+                    rw.push(RecordRef{&r, &seg.arena});
+            }
+        };
+        for (const auto &seg : old->segments)
+            push_hot(*seg);
+        push_hot(*old_tail);
+
+        rw.finish();
+        return removed;
+    }
+
+    void Timeline::sort_cold_locked()
+    {
+        auto old = sealed;
+        auto old_tail = tail;
+
+        // 1. 每段先各自有序：段内无序的冷段逐段解压排序后重新编码，内存中的记录整体排序
+        std::vector<std::shared_ptr<const ColdSegment>> sorted;
+        std::vector<std::shared_ptr<const TimelineSegment>> fallback; // 写回失败的段留在内存中
+        std::vector<std::vector<RecordRef>> hot_runs;
+        for (const auto &seg : old->cold)
+        {
+            if (seg->ordered())
+            {
+                sorted.push_back(seg);
+                continue;
+            }
+
+            auto thawed = std::make_shared<TimelineSegment>(seg->thaw());
+            std::stable_sort(thawed->records.begin(), thawed->records.end(),
+                             [](const EventRecord &a, const EventRecord &b)
+                             { return a.ts_ns < b.ts_ns; });
+
+            auto res = spill_failure ? util::ResultV<std::shared_ptr<const ColdSegment>>::Err(*spill_failure)
+                                     : ColdStore::write(spill.dir, *thawed);
+            if (res.is_ok())
+            {
+                sorted.push_back(std::move(res).unwrap());
+                continue;
+            }
+
+            spill_failure = res.unwrap_err();
+            sorted.push_back(nullptr);
+            auto &run = hot_runs.emplace_back();
+            for (const auto &r : thawed->records)
+                run.push_back({&r, &thawed->arena});
+            fallback.push_back(std::move(thawed));
+        }
+
+        std::vector<RecordRef> hot;
+        hot.reserve(count.load(std::memory_order_relaxed) - old->cold_total);
+        for (const auto &seg : old->segments)
+            for (const auto &r : seg->records)
+                hot.push_back({&r, &seg->arena});
+        for (const auto &r : old_tail->records)
+            hot.push_back({&r, &old_tail->arena});
+        std::stable_sort(hot.begin(), hot.end(), ref_before);
+
+        // 2. 按原有顺序排列各路输入，时间戳相同时序号小的在前，整体等同稳定排序
+        std::vector<Run> runs;
+        runs.reserve(sorted.size() + 1);
+        std::size_t next_fallback = 0;
+        for (const auto &seg : sorted)
+            runs.push_back(seg ? Run::of(*seg) : Run::of(hot_runs[next_fallback++]));
+        runs.push_back(Run::of(hot));
+
+        using Head = std::pair<std::int64_t, std::size_t>;
+        std::priority_queue<Head, std::vector<Head>, std::greater<>> heads;
+        for (std::size_t i = 0; i < runs.size(); ++i)
+            if (runs[i].start())
+                heads.push({runs[i].ts(), i});
+
+        // 3. 归并写回：原冷段区域内的输出重新落盘
+        ordered = true;
+        last_ts = INT64_MIN;
+        Rewriter rw(*this, 0);
+        while (!heads.empty())
+        {
+            auto [ts, i] = heads.top();
+            heads.pop();
+
+            auto &run = runs[i];
+            if (run.cold)
+                rw.push(*run.cold, run.rec);
+            else
+                rw.push(run.refs[run.pos]);
+
+            if (run.advance())
+                heads.push({run.ts(), i});
+        }
+        rw.finish();
+    }
+
+    void Timeline::merge_cold_locked(EvIdx pos, std::span<const RecordRef> batch)
+    {
+        auto old = sealed;
+        auto old_tail = tail;
+
+        // 从 pos 所在冷段的起点重写，段内 pos 之前的记录不晚于批次起点，归并后仍在原位
+        std::size_t ci = old->cold_index(pos);
+        Rewriter rw(*this, old->cold_starts[ci]);
+
+        // 时间戳相同时已有记录在前
+        std::size_t b = 0;
+        auto drain_before = [&](std::int64_t ts)
         {
-            auto &e = arr[idx];
-            if (e.fd)
-                fd_index[e.fd.fd].push_back(idx);
+            while (b < batch.size() && batch[b].rec->ts_ns < ts)
+                rw.push(batch[b++]);
+        };
+
+        for (std::size_t i = ci; i < old->cold.size(); ++i)
+        {
+            const auto &seg = *old->cold[i];
+            seg.for_each([&](EvIdx, const EventRecord &r)
+                         {
+                             drain_before(r.ts_ns);
+                             rw.push(seg, r); });
+        }
+
+        auto push_hot = [&](const TimelineSegment &seg)
+        {
+            for (const auto &r : seg.records)
+            {
+                drain_before(r.ts_ns);
+                rw.push(RecordRef{&r, &seg.arena});
+            }
+        };
+        for (const auto &seg : old->segments)
+            push_hot(*seg);
+        push_hot(*old_tail);
+
+        while (b < batch.size())
+            rw.push(batch[b++]);
+        rw.finish();
+    }
+
+    std::size_t Timeline::hot_bytes_locked() const
+    {
+        std::size_t bytes = segment_bytes(*tail);
+        for (const auto &seg : sealed->segments)
+            bytes += segment_bytes(*seg);
+        return bytes;
+    }
+
+    std::size_t Timeline::memory_bytes_locked() const
+    {
+        std::size_t bytes = hot_bytes_locked() + session_next.capacity() * sizeof(EvIdx);
+        for (const auto &seg : sealed->cold)
+            bytes += seg->memory_bytes();
+        return bytes;
+    }
 
-            type_index[e.type].push_back(idx);
+    void Timeline::spill_locked()
+    {
+        if (!cold_store || spill_failure)
+            return;
+
+        // 会话链与冷段缓存不能落盘，但同样计入预算，由内存段多落盘一些来抵消
+        std::size_t hot = memory_bytes_locked();
+        for (const auto &s : spill_queue)
+            hot -= std::min(hot, s.bytes);
+        if (hot <= spill.memory_budget)
+            return;
+
+        // 一次降到预算的四分之三，尾段不参与
+        std::size_t target = spill.memory_budget - spill.memory_budget / 4;
+        const auto &segs = sealed->segments;
+        for (std::size_t i = spill_queue.size(); i < segs.size() && hot > target; ++i)
+        {
+            std::size_t bytes = segment_bytes(*segs[i]);
+            spill_queue.push_back({segs[i].get(), bytes});
+            cold_store->submit(segs[i]);
+            hot -= std::min(hot, bytes);
+        }
+    }
+
+    void Timeline::on_spilled(
+        const std::shared_ptr<const TimelineSegment> &seg,
+        util::ResultV<std::shared_ptr<const ColdSegment>> &&res)
+    {
+        std::lock_guard lock(mtx);
+
+        // 提交后被改写丢弃的段不在队首，结果直接作废
+        if (spill_queue.empty() || spill_queue.front().seg != seg.get() ||
+            sealed->segments.empty() || sealed->segments.front() != seg)
+            return;
+
+        if (res.is_err())
+        {
+            spill_failure = res.unwrap_err();
+            spill_queue.clear();
+            return;
+        }
+
+        // 段列表按值复制后发布：冷段追加到末尾，其余内存段不变，全局下标不变
+        auto list = cold_part(*sealed);
+        list->append_cold(std::move(res).unwrap());
+        for (std::size_t i = 1; i < sealed->segments.size(); ++i)
+            list->append(sealed->segments[i]);
+
+        sealed = std::move(list);
+        spill_queue.erase(spill_queue.begin());
+
+        // 已发布的快照仍引用内存段，丢弃后由下一次取快照重新发布，内存随旧快照释放
+        published.reset();
+    }
+
+    Timeline::EvIdx
+    Timeline::lower_bound_locked(std::int64_t ts_ns) const
+    {
+        // 冷段按各段的时间范围与段内解码起点定位，不逐条解码
+        if (EvIdx cold = sealed->cold_lower_bound(ts_ns); cold < sealed->cold_total)
+            return cold;
+
+        EvIdx lo = sealed->cold_total, hi = count.load(std::memory_order_relaxed);
+        while (lo < hi)
+        {
+            EvIdx mid = lo + (hi - lo) / 2;
+            if (ref_locked(mid).rec->ts_ns < ts_ns)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    Timeline::EvIdx
+    Timeline::upper_bound_locked(std::int64_t ts_ns) const
+    {
+        if (ts_ns == INT64_MAX)
+            return count.load(std::memory_order_relaxed);
+        if (EvIdx cold = sealed->cold_lower_bound(ts_ns + 1); cold < sealed->cold_total)
+            return cold;
+
+        EvIdx lo = sealed->cold_total, hi = count.load(std::memory_order_relaxed);
+        while (lo < hi)
+        {
+            EvIdx mid = lo + (hi - lo) / 2;
+            if (ref_locked(mid).rec->ts_ns <= ts_ns)
+                lo = mid + 1;
+            else
+                hi = mid;
         }
+        return lo;
+    }
+
+    Timeline::EvCnt
+    Timeline::select_locked(const TimelineQuery &q, IdxList *out) const
+    {
+        using util::RoaringBitmap;
+
+        EvIdx n = count.load(std::memory_order_relaxed);
+
+        // 1. 时间范围：有序时二分成下标区间，否则逐条比较时间戳
+        std::int64_t t_lo = q.start ? platform::time::event_from_wall(*q.start) : INT64_MIN;
+        std::int64_t t_hi = q.end ? platform::time::event_from_wall(*q.end) : INT64_MAX;
+        if (t_lo > t_hi)
+            return 0;
+
+        EvIdx lo = 0, hi = n;
+        bool filter_ts = q.start || q.end;
+        if (filter_ts && ordered)
+        {
+            lo = q.start ? lower_bound_locked(t_lo) : 0;
+            hi = q.end ? upper_bound_locked(t_hi) : n;
+            filter_ts = false;
+        }
+        if (lo >= hi)
+            return 0;
+
+        // 2. 收集各条件的位图，任一条件无匹配即可提前结束
+        // 每个条件是若干位图的并集（只有 types 可能多于一个），并集推迟到确实需要时才物化
+        struct Pred
+        {
+            std::vector<const RoaringBitmap *> any;
+            std::size_t card = 0; // 各位图基数之和，作为并集基数的上界
+
+            bool contains(std::uint32_t idx) const noexcept
+            {
+                for (const auto *bm : any)
+                    if (bm->contains(idx))
+                        return true;
+                return false;
+            }
+        };
+        std::vector<Pred> preds;
+
+        auto add_pred = [&](std::initializer_list<const RoaringBitmap *> bms)
+        {
+            Pred p;
+            for (const auto *bm : bms)
+            {
+                p.any.push_back(bm);
+                p.card += bm->cardinality();
+            }
+            preds.push_back(std::move(p));
+        };
+
+        if (q.fd)
+        {
+            auto it = fd_index.find(*q.fd);
+            if (it == fd_index.end())
+                return 0;
+            add_pred({&it->second});
+        }
+
+        if (!q.types.empty())
+        {
+            Pred p;
+            for (auto t : q.types)
+            {
+                auto it = type_index.find(t);
+                if (it == type_index.end() ||
+                    std::find(p.any.begin(), p.any.end(), &it->second) != p.any.end())
+                    continue;
+                p.any.push_back(&it->second);
+                p.card += it->second.cardinality();
+            }
+            if (p.any.empty())
+                return 0;
+            preds.push_back(std::move(p));
+        }
+
+        if (q.session)
+        {
+            auto it = session_index.find(*q.session);
+            if (it == session_index.end())
+                return 0;
+            add_pred({&it->second.members});
+        }
+
+        if (q.errors_only)
+        {
+            if (error_index.empty())
+                return 0;
+            add_pred({&error_index});
+        }
+
+        // 3. 按基数从小到大排列，选择性最强的条件先参与
+        std::sort(preds.begin(), preds.end(),
+                  [](const Pred &a, const Pred &b)
+                  { return a.card < b.card; });
+
+        EvCnt hits = 0;
+        auto emit = [&](EvIdx idx)
+        {
+            if (filter_ts)
+            {
+                auto ts = ts_locked(idx);
+                if (ts < t_lo || ts > t_hi)
+                    return;
+            }
+            ++hits;
+            if (out)
+                out->push_back(idx);
+        };
+
+        if (preds.empty())
+        {
+            for (EvIdx idx = lo; idx < hi; ++idx)
+                emit(idx);
+            return hits;
+        }
+
+        // 单个位图直接引用，多个位图才求并集写入 storage
+        auto resolve = [](const Pred &p, RoaringBitmap &storage) -> const RoaringBitmap *
+        {
+            if (p.any.size() == 1)
+                return p.any[0];
+            storage = RoaringBitmap::unite(*p.any[0], *p.any[1]);
+            for (std::size_t i = 2; i < p.any.size(); ++i)
+                storage = RoaringBitmap::unite(storage, *p.any[i]);
+            return &storage;
+        };
+
+        // 只计数且无范围限制时直接统计交集基数
+        bool full_range = !filter_ts && lo == 0 && hi == n;
+        if (!out && full_range && preds.size() <= 2 && preds[0].any.size() == 1 &&
+            (preds.size() == 1 || preds[1].any.size() == 1))
+            return preds.size() == 1
+                       ? preds[0].card
+                       : RoaringBitmap::intersect_count(*preds[0].any[0], *preds[1].any[0]);
+
+        // 4. 范围窄时沿最小条件在范围内逐个探测其余条件；
+        //    否则从最小条件起依次求交，累积结果越来越小，稀疏对稠密时走 galloping 或位测试
+        RoaringBitmap merged;
+        const RoaringBitmap *driver = resolve(preds[0], merged);
+
+        if (preds.size() == 1 || (hi - lo) * 4 < n)
+        {
+            driver->for_each(
+                [&](std::uint32_t idx)
+                {
+                    for (std::size_t i = 1; i < preds.size(); ++i)
+                        if (!preds[i].contains(idx))
+                            return;
+                    emit(idx);
+                },
+                lo, hi);
+            return hits;
+        }
+
+        // A ∩ (B1 ∪ B2) = (A ∩ B1) ∪ (A ∩ B2)：累积结果较小，不必物化大的并集
+        auto intersect_pred = [](const RoaringBitmap &acc, const Pred &p)
+        {
+            RoaringBitmap r = RoaringBitmap::intersect(acc, *p.any[0]);
+            for (std::size_t i = 1; i < p.any.size(); ++i)
+                r = RoaringBitmap::unite(r, RoaringBitmap::intersect(acc, *p.any[i]));
+            return r;
+        };
+
+        RoaringBitmap acc = intersect_pred(*driver, preds[1]);
+        for (std::size_t i = 2; i < preds.size() && !acc.empty(); ++i)
+            acc = intersect_pred(acc, preds[i]);
+
+        acc.for_each([&](std::uint32_t idx)
+                     { emit(idx); },
+                     lo, hi);
+        return hits;
     }
 
     Timeline::EvCnt
     Timeline::remove_by_fd_locked(platform::fd::FdView fd)
     {
+        auto it = fd_index.find(fd.fd);
+        if (it == fd_index.end())
+            return 0UL;
+
         return remove_if_locked(
-            [fd](const Event &e)
-            { return e.fd == fd; });
+            [fd](const EventRecord &r)
+            { return r.fd == fd.fd; },
+            it->second.minimum());
     }
 
     Timeline::EvCnt
     Timeline::remove_by_type_locked(EventType type)
     {
+        auto it = type_index.find(type);
+        if (it == type_index.end())
+            return 0UL;
+
         return remove_if_locked(
-            [type](const Event &e)
-            { return e.type == type; });
+            [type](const EventRecord &r)
+            { return r.type == type; },
+            it->second.minimum());
     }
 
     Timeline::EvCnt
@@ -491,8 +1470,13 @@ namespace core
         TimeStamp start,
         TimeStamp end)
     {
+        auto lo = platform::time::event_from_wall(start);
+        auto hi = platform::time::event_from_wall(end);
+
+        // 有序时从范围起点开始检查，更早的冷段不必解码
         return remove_if_locked(
-            [start, end](const Event &e)
-            { return start <= e.ts && e.ts < end; });
+            [lo, hi](const EventRecord &r)
+            { return lo <= r.ts_ns && r.ts_ns < hi; },
+            ordered ? lower_bound_locked(lo) : 0);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,360 @@
+/*
+ * ============================================================================
+ *  File Name   : timeline_snapshot.cpp
+ *  Module      : core
+ *
+ *  Description :
+ *      Timeline 只读快照实现。全局下标经各段起始下标二分定位到段内位置，
+ *      按时间查询在快照有序时对全局下标做二分。冷段上的查询交给
+ *      ColdSegment，按段头的摘要剪枝后只解码可能命中的段。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/core/timeline_snapshot.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <string>
+
+#include "eunet/core/cold_segment.hpp"
+#include "eunet/core/timeline.hpp"
+
+namespace core
+{
+    void SegmentList::append(std::shared_ptr<const TimelineSegment> seg)
+    {
+        if (!seg || seg->records.empty())
+            return;
+
+        starts.push_back(total);
+        total += seg->records.size();
+        segments.push_back(std::move(seg));
+    }
+
+    void SegmentList::append_cold(std::shared_ptr<const ColdSegment> seg)
+    {
+        if (!seg || seg->empty())
+            return;
+
+        cold_starts.push_back(cold_total);
+        cold_total += seg->size();
+        total = cold_total;
+        cold.push_back(std::move(seg));
+    }
+
+    RecordRef SegmentList::at(std::size_t idx) const noexcept
+    {
+        // 第一个起始下标大于 idx 的段的前一段即为所在段
+        auto it = std::upper_bound(starts.begin(), starts.end(), idx);
+        std::size_t seg = (it - starts.begin()) - 1;
+        const auto &s = *segments[seg];
+        return {&s.records[idx - starts[seg]], &s.arena};
+    }
+
+    std::size_t SegmentList::cold_index(std::size_t idx) const noexcept
+    {
+        auto it = std::upper_bound(cold_starts.begin(), cold_starts.end(), idx);
+        return (it - cold_starts.begin()) - 1;
+    }
+
+    Event SegmentList::cold_event(std::size_t idx, bool with_payload) const
+    {
+        std::size_t i = cold_index(idx);
+        auto rec = cold[i]->record_at(idx - cold_starts[i]);
+        if (!with_payload)
+            rec.payload = 0;
+        return core::materialize(rec, *cold[i]);
+    }
+
+    std::int64_t SegmentList::cold_ts(std::size_t idx) const noexcept
+    {
+        std::size_t i = cold_index(idx);
+        return cold[i]->record_at(idx - cold_starts[i]).ts_ns;
+    }
+
+    std::size_t SegmentList::cold_lower_bound(std::int64_t ts_ns) const
+    {
+        // 有序时各段的时间范围首尾相接，第一个 max_ts >= ts_ns 的段即为所在段
+        auto it = std::partition_point(cold.begin(), cold.end(), [ts_ns](const auto &seg)
+                                       { return seg->max_ts() < ts_ns; });
+        if (it == cold.end())
+            return cold_total;
+
+        std::size_t i = it - cold.begin();
+        return cold_starts[i] + (*it)->lower_bound(ts_ns);
+    }
+
+    TimelineSnapshot::TimelineSnapshot()
+        : m_list(std::make_shared<SegmentList>()) {}
+
+    TimelineSnapshot::TimelineSnapshot(
+        std::shared_ptr<const SegmentList> list,
+        bool ordered) noexcept
+        : m_list(std::move(list)), m_ordered(ordered) {}
+
+    TimelineSnapshot::EvResult
+    TimelineSnapshot::event_at(EvIdx idx, bool with_payload) const
+    {
+        using Ret = EvResult;
+        using util::Error;
+
+        if (idx >= size())
+        {
+            return Ret::Err(
+                Error::state()
+                    .target_not_found()
+                    .message("Event index out of range")
+                    .context(std::to_string(idx))
+                    .build());
+        }
+
+        if (idx < cold_size())
+            return Ret::Ok(m_list->cold_event(idx, with_payload));
+
+        auto ref = ref_at(idx);
+        if (with_payload)
+            return Ret::Ok(core::materialize(*ref.rec, *ref.arena));
+
+        EventRecord lean = *ref.rec;
+        lean.payload = 0;
+        return Ret::Ok(core::materialize(lean, *ref.arena));
+    }
+
+    TimelineSnapshot::EvResult
+    TimelineSnapshot::latest_event() const
+    {
+        using Ret = EvResult;
+        using util::Error;
+
+        if (empty())
+            return Ret::Err(
+                Error::state()
+                    .invalid_state()
+                    .message("Cannot fetch latest event: Timeline is empty")
+                    .build());
+
+        return event_at(size() - 1);
+    }
+
+    TimelineSnapshot::EvCnt
+    TimelineSnapshot::count_by_time(
+        TimeStamp start,
+        TimeStamp end) const
+    {
+        if (start > end)
+            return 0UL;
+
+        auto lo = platform::time::event_from_wall(start);
+        auto hi = platform::time::event_from_wall(end);
+
+        if (m_ordered)
+            return upper_bound(hi) - lower_bound(lo);
+
+        EvCnt cnt = 0;
+        for (const auto &seg : m_list->cold)
+            cnt += seg->count_by_time(start, end);
+        for (const auto &seg : m_list->segments)
+            for (const auto &r : seg->records)
+                cnt += (r.ts_ns >= lo && r.ts_ns <= hi);
+        return cnt;
+    }
+
+    TimelineSnapshot::EvList
+    TimelineSnapshot::replay_all() const
+    {
+        EvList result;
+        result.reserve(size());
+        for (const auto &seg : m_list->cold)
+        {
+            auto part = seg->replay_all();
+            std::move(part.begin(), part.end(), std::back_inserter(result));
+        }
+        for (const auto &seg : m_list->segments)
+            for (const auto &r : seg->records)
+                result.push_back(core::materialize(r, seg->arena));
+
+        return result;
+    }
+
+    TimelineSnapshot::EvList
+    TimelineSnapshot::replay_since(TimeStamp ts) const
+    {
+        auto lo = platform::time::event_from_wall(ts);
+        if (!m_ordered)
+            return collect_if(TimelineQuery{.start = ts},
+                              [lo](const EventRecord &r)
+                              { return r.ts_ns >= lo; });
+
+        return range(lower_bound(lo), size());
+    }
+
+    TimelineSnapshot::EvList
+    TimelineSnapshot::query_by_fd(int fd) const
+    {
+        return collect_if(TimelineQuery{.fd = fd},
+                          [fd](const EventRecord &r)
+                          { return r.fd == fd; });
+    }
+
+    TimelineSnapshot::EvList
+    TimelineSnapshot::query_by_type(EventType type) const
+    {
+        return collect_if(TimelineQuery{.types = {type}},
+                          [type](const EventRecord &r)
+                          { return r.type == type; });
+    }
+
+    TimelineSnapshot::EvList
+    TimelineSnapshot::query_by_time(
+        TimeStamp start,
+        TimeStamp end) const
+    {
+        EvList result;
+        if (start > end)
+            return result;
+
+        auto lo = platform::time::event_from_wall(start);
+        auto hi = platform::time::event_from_wall(end);
+
+        if (!m_ordered)
+            return collect_if(TimelineQuery{.start = start, .end = end},
+                              [lo, hi](const EventRecord &r)
+                              { return r.ts_ns >= lo && r.ts_ns <= hi; });
+
+        return range(lower_bound(lo), upper_bound(hi));
+    }
+
+    TimelineSnapshot::EvList
+    TimelineSnapshot::query_errors() const
+    {
+        return collect_if(TimelineQuery{.errors_only = true},
+                          [](const EventRecord &r)
+                          { return r.is_error(); });
+    }
+
+    TimelineSnapshot::EvList
+    TimelineSnapshot::materialize(const std::vector<EvIdx> &idxs) const
+    {
+        EvList result;
+        result.reserve(idxs.size());
+
+        // 落在同一冷段的相邻下标成批交给该段，段内顺序解码
+        std::vector<EvIdx> local;
+        for (std::size_t k = 0; k < idxs.size();)
+        {
+            EvIdx idx = idxs[k];
+            if (idx >= size())
+            {
+                ++k;
+                continue;
+            }
+            if (idx >= cold_size())
+            {
+                auto ref = ref_at(idx);
+                result.push_back(core::materialize(*ref.rec, *ref.arena));
+                ++k;
+                continue;
+            }
+
+            std::size_t i = m_list->cold_index(idx);
+            EvIdx start = m_list->cold_starts[i];
+            EvIdx end = start + m_list->cold_count(i);
+            local.clear();
+            for (; k < idxs.size() && idxs[k] >= start && idxs[k] < end; ++k)
+                local.push_back(idxs[k] - start);
+
+            auto part = m_list->cold[i]->materialize(local);
+            std::move(part.begin(), part.end(), std::back_inserter(result));
+        }
+
+        return result;
+    }
+
+    std::shared_ptr<const TimelineSegment> TimelineSnapshot::thaw(std::size_t i) const
+    {
+        return std::make_shared<const TimelineSegment>(m_list->cold[i]->thaw());
+    }
+
+    TimelineSnapshot::EvList
+    TimelineSnapshot::range(EvIdx first, EvIdx last) const
+    {
+        EvList result;
+        if (first >= last)
+            return result;
+
+        EvCnt n = last - first;
+        if (first < cold_size())
+        {
+            std::vector<EvIdx> idxs;
+            for (EvIdx idx = first; idx < std::min(last, cold_size()); ++idx)
+                idxs.push_back(idx);
+            result = materialize(idxs);
+            first = idxs.back() + 1;
+        }
+        result.reserve(n);
+
+        for (EvIdx idx = first; idx < last; ++idx)
+        {
+            auto ref = ref_at(idx);
+            result.push_back(core::materialize(*ref.rec, *ref.arena));
+        }
+        return result;
+    }
+
+    void TimelineSnapshot::query_cold(const TimelineQuery &q, EvList &out) const
+    {
+        for (const auto &seg : m_list->cold)
+        {
+            auto part = seg->query(q);
+            std::move(part.begin(), part.end(), std::back_inserter(out));
+        }
+    }
+
+    TimelineSnapshot::EvIdx
+    TimelineSnapshot::lower_bound(std::int64_t ts_ns) const
+    {
+        // 冷段按段定位；落在内存中的段时对全局下标二分：第一个 ts >= ts_ns 的位置
+        if (EvIdx cold = m_list->cold_lower_bound(ts_ns); cold < cold_size())
+            return cold;
+
+        EvIdx lo = cold_size(), hi = size();
+        while (lo < hi)
+        {
+            EvIdx mid = lo + (hi - lo) / 2;
+            if (ref_at(mid).rec->ts_ns < ts_ns)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    TimelineSnapshot::EvIdx
+    TimelineSnapshot::upper_bound(std::int64_t ts_ns) const
+    {
+        // 第一个 ts > ts_ns 的位置
+        if (ts_ns == INT64_MAX)
+            return size();
+        if (EvIdx cold = m_list->cold_lower_bound(ts_ns + 1); cold < cold_size())
+            return cold;
+
+        EvIdx lo = cold_size(), hi = size();
+        while (lo < hi)
+        {
+            EvIdx mid = lo + (hi - lo) / 2;
+            if (ref_at(mid).rec->ts_ns <= ts_ns)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+}
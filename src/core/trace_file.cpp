@@ -0,0 +1,726 @@
+/*
+ * ============================================================================
+ *  File Name   : trace_file.cpp
+ *  Module      : core
+ *
+ *  Description :
+ *      二进制事件追踪文件的写入与 mmap 读取实现。写入端以 pwrite 定位写块，
+ *      读取端只校验索引，记录在映射内存上原地访问。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/core/trace_file.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace core
+{
+    namespace
+    {
+        util::Error system_error(int err_no, const char *msg, const std::string &ctx)
+        {
+            return util::Error::system()
+                .code(err_no)
+                .set_category(from_errno(err_no))
+                .message(msg)
+                .context(ctx)
+                .build();
+        }
+
+        util::Error format_error(const char *what)
+        {
+            return util::Error::state()
+                .data_truncated()
+                .message("Invalid trace file")
+                .context(what)
+                .build();
+        }
+
+        template <typename T>
+        void put(std::vector<std::byte> &out, const T &v)
+        {
+            const auto *p = reinterpret_cast<const std::byte *>(&v);
+            out.insert(out.end(), p, p + sizeof(T));
+        }
+
+        std::int64_t wall_ns(platform::time::WallPoint tp) noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+        }
+
+        platform::time::WallPoint wall_from_ns(std::int64_t ns) noexcept
+        {
+            return platform::time::WallPoint(
+                std::chrono::duration_cast<platform::time::WallClock::duration>(
+                    std::chrono::nanoseconds(ns)));
+        }
+
+        /** 校验 offset 处的块并绑定到映射内存，越界或格式不符时返回空 */
+        std::optional<TraceFile::Chunk> bind_chunk(
+            const std::byte *data,
+            std::size_t bytes,
+            std::uint64_t offset)
+        {
+            if (offset % 8 != 0 || offset > bytes || bytes - offset < sizeof(trace::ChunkHeader))
+                return std::nullopt;
+
+            const auto *head = reinterpret_cast<const trace::ChunkHeader *>(data + offset);
+            if (head->magic != trace::CHUNK_MAGIC ||
+                head->size > bytes - offset ||
+                head->size < sizeof(trace::ChunkHeader) ||
+                head->count > (head->size - sizeof(trace::ChunkHeader)) / sizeof(EventRecord))
+                return std::nullopt;
+
+            std::size_t records_bytes = head->count * sizeof(EventRecord);
+            const auto *records = data + offset + sizeof(trace::ChunkHeader);
+            auto image = ArenaImage::view(
+                {records + records_bytes, head->size - sizeof(trace::ChunkHeader) - records_bytes});
+            if (image.is_err())
+                return std::nullopt;
+
+            TraceFile::Chunk c;
+            c.records = reinterpret_cast<const EventRecord *>(records);
+            c.count = head->count;
+            c.min_ts = head->min_ts;
+            c.max_ts = head->max_ts;
+            c.ordered = (head->flags & trace::ORDERED) != 0;
+            c.arena = image.unwrap();
+            return c;
+        }
+
+        /** 有序块内 ts 落在 [lo, hi] 的记录区间 */
+        std::pair<std::size_t, std::size_t> ordered_range(
+            const TraceFile::Chunk &c,
+            std::int64_t lo,
+            std::int64_t hi)
+        {
+            const auto *begin = c.records;
+            const auto *end = c.records + c.count;
+            auto first = std::lower_bound(begin, end, lo,
+                                          [](const EventRecord &r, std::int64_t ts)
+                                          { return r.ts_ns < ts; });
+            auto last = std::upper_bound(first, end, hi,
+                                         [](std::int64_t ts, const EventRecord &r)
+                                         { return ts < r.ts_ns; });
+            return {static_cast<std::size_t>(first - begin), static_cast<std::size_t>(last - begin)};
+        }
+    }
+
+    // ============================================================
+    // TraceWriter
+    // ============================================================
+
+    TraceWriter::TraceWriter(platform::fd::Fd fd, std::string path) noexcept
+        : m_fd(std::move(fd)), m_path(std::move(path)) {}
+
+    util::ResultV<TraceWriter> TraceWriter::create(const std::string &path)
+    {
+        using Ret = util::ResultV<TraceWriter>;
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+            return Ret::Err(system_error(errno, "Failed to create trace file", path));
+
+        TraceWriter w(platform::fd::Fd(fd), path);
+        w.m_anchor = platform::time::process_anchor();
+
+        trace::FileHeader head{};
+        std::memcpy(head.magic, trace::FILE_MAGIC, sizeof(head.magic));
+        head.version = trace::VERSION;
+        head.record_size = sizeof(EventRecord);
+        head.anchor_event_ns = w.m_anchor.event_ns;
+        head.anchor_wall_ns = wall_ns(w.m_anchor.wall);
+
+        auto r = w.write_at(0, {reinterpret_cast<const std::byte *>(&head), sizeof(head)});
+        if (r.is_err())
+            return Ret::Err(r.unwrap_err());
+
+        // 空文件也带索引，创建后即可打开
+        w.m_end = sizeof(head);
+        r = w.write_index();
+        if (r.is_err())
+            return Ret::Err(r.unwrap_err());
+
+        return Ret::Ok(std::move(w));
+    }
+
+    TraceWriter::EvCntResult TraceWriter::append(
+        std::span<const EventRecord> records,
+        const RecordArena &arena)
+    {
+        if (records.empty())
+            return EvCntResult::Ok(0UL);
+
+        // 超过一块时按块拆分，每块只带自己引用的变长数据
+        if (records.size() <= CHUNK_CAPACITY)
+            return write_chunk(records, arena);
+
+        EvCnt written = 0;
+        for (std::size_t i = 0; i < records.size(); i += CHUNK_CAPACITY)
+        {
+            auto part = records.subspan(i, std::min(CHUNK_CAPACITY, records.size() - i));
+            RecordArena local;
+            std::vector<EventRecord> adopted;
+            adopted.reserve(part.size());
+            for (const auto &rec : part)
+                adopted.push_back(local.adopt(rec, arena));
+
+            auto r = write_chunk(adopted, local);
+            if (r.is_err())
+                return EvCntResult::Err(r.unwrap_err());
+            written += r.unwrap();
+        }
+        return EvCntResult::Ok(std::move(written));
+    }
+
+    TraceWriter::EvCntResult TraceWriter::append(const TimelineSnapshot &snap, EvIdx from)
+    {
+        EvCnt written = 0;
+        std::vector<EventRecord> records;
+        RecordArena arena;
+
+        std::optional<util::Error> failed;
+
+        // 已落盘的记录由快照逐段解压后访问
+        snap.for_each(
+            [&](const EventRecord &rec, const RecordArena &from_arena)
+            {
+                if (failed)
+                    return;
+                records.push_back(arena.adopt(rec, from_arena));
+                if (records.size() < CHUNK_CAPACITY)
+                    return;
+
+                auto r = write_chunk(records, arena);
+                if (r.is_err())
+                    failed = r.unwrap_err();
+                else
+                    written += r.unwrap();
+                records.clear();
+                arena.clear();
+            },
+            from);
+
+        if (!failed && !records.empty())
+        {
+            auto r = write_chunk(records, arena);
+            if (r.is_err())
+                failed = r.unwrap_err();
+            else
+                written += r.unwrap();
+        }
+
+        if (failed)
+            return EvCntResult::Err(std::move(*failed));
+        return EvCntResult::Ok(std::move(written));
+    }
+
+    TraceWriter::EvCntResult TraceWriter::write_chunk(
+        std::span<const EventRecord> records,
+        const RecordArena &arena)
+    {
+        trace::ChunkHeader head{};
+        head.magic = trace::CHUNK_MAGIC;
+        head.count = records.size();
+        head.min_ts = INT64_MAX;
+        head.max_ts = INT64_MIN;
+
+        bool ordered = true;
+        std::int64_t prev = INT64_MIN;
+        for (const auto &r : records)
+        {
+            head.min_ts = std::min(head.min_ts, r.ts_ns);
+            head.max_ts = std::max(head.max_ts, r.ts_ns);
+            ordered = ordered && r.ts_ns >= prev;
+            prev = r.ts_ns;
+        }
+        head.flags = ordered ? std::uint32_t{trace::ORDERED} : 0u;
+
+        m_buf.clear();
+        put(m_buf, head);
+        m_buf.insert(m_buf.end(),
+                     reinterpret_cast<const std::byte *>(records.data()),
+                     reinterpret_cast<const std::byte *>(records.data() + records.size()));
+        arena.write_image(m_buf);
+
+        head.size = m_buf.size();
+        std::memcpy(m_buf.data(), &head, sizeof(head));
+
+        // 新块覆盖旧索引，写完后再在其后重写索引
+        auto r = write_at(m_end, m_buf);
+        if (r.is_err())
+            return EvCntResult::Err(r.unwrap_err());
+
+        if (!m_index.empty() && head.min_ts < m_index.back().max_ts)
+            m_ordered = false;
+        m_ordered = m_ordered && ordered;
+
+        m_index.push_back(trace::IndexEntry{
+            .offset = m_end,
+            .first = m_total,
+            .count = head.count,
+            .min_ts = head.min_ts,
+            .max_ts = head.max_ts,
+            .flags = head.flags,
+            .reserved = 0,
+        });
+        m_end += head.size;
+        m_total += records.size();
+
+        r = write_index();
+        if (r.is_err())
+            return EvCntResult::Err(r.unwrap_err());
+        return EvCntResult::Ok(records.size());
+    }
+
+    util::ResultV<void> TraceWriter::write_index()
+    {
+        using Ret = util::ResultV<void>;
+
+        trace::Trailer tail{};
+        tail.index_offset = m_end;
+        tail.chunk_count = m_index.size();
+        tail.total = m_total;
+        tail.flags = m_ordered ? std::uint32_t{trace::ORDERED} : 0u;
+        tail.version = trace::VERSION;
+        std::memcpy(tail.magic, trace::TRAILER_MAGIC, sizeof(tail.magic));
+
+        std::vector<std::byte> buf;
+        buf.reserve(m_index.size() * sizeof(trace::IndexEntry) + sizeof(tail));
+        for (const auto &e : m_index)
+            put(buf, e);
+        put(buf, tail);
+
+        auto r = write_at(m_end, buf);
+        if (r.is_err())
+            return Ret::Err(r.unwrap_err());
+
+        if (::ftruncate(m_fd.get(), static_cast<off_t>(m_end + buf.size())) != 0)
+            return Ret::Err(system_error(errno, "Failed to truncate trace file", m_path));
+        return Ret::Ok();
+    }
+
+    util::ResultV<void> TraceWriter::write_at(
+        std::uint64_t offset,
+        std::span<const std::byte> data)
+    {
+        using Ret = util::ResultV<void>;
+
+        while (!data.empty())
+        {
+            ssize_t n = ::pwrite(m_fd.get(), data.data(), data.size(), static_cast<off_t>(offset));
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return Ret::Err(system_error(errno, "Failed to write trace file", m_path));
+            }
+            data = data.subspan(static_cast<std::size_t>(n));
+            offset += static_cast<std::uint64_t>(n);
+        }
+        return Ret::Ok();
+    }
+
+    // ============================================================
+    // TraceFile
+    // ============================================================
+
+    TraceFile::~TraceFile() { unmap(); }
+
+    TraceFile::TraceFile(TraceFile &&other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)),
+          m_bytes(std::exchange(other.m_bytes, 0)),
+          m_chunks(std::move(other.m_chunks)),
+          m_total(std::exchange(other.m_total, 0)),
+          m_ordered(other.m_ordered),
+          m_recovered(other.m_recovered),
+          m_anchor(other.m_anchor),
+          m_shift(other.m_shift) {}
+
+    TraceFile &TraceFile::operator=(TraceFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_bytes = std::exchange(other.m_bytes, 0);
+            m_chunks = std::move(other.m_chunks);
+            m_total = std::exchange(other.m_total, 0);
+            m_ordered = other.m_ordered;
+            m_recovered = other.m_recovered;
+            m_anchor = other.m_anchor;
+            m_shift = other.m_shift;
+        }
+        return *this;
+    }
+
+    void TraceFile::unmap() noexcept
+    {
+        if (m_data)
+            ::munmap(const_cast<std::byte *>(m_data), m_bytes);
+        m_data = nullptr;
+        m_bytes = 0;
+        m_chunks.clear();
+        m_total = 0;
+    }
+
+    util::ResultV<TraceFile> TraceFile::open(const std::string &path)
+    {
+        using Ret = util::ResultV<TraceFile>;
+
+        platform::fd::Fd fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+        if (!fd)
+            return Ret::Err(system_error(errno, "Failed to open trace file", path));
+
+        struct stat st{};
+        if (::fstat(fd.get(), &st) != 0)
+            return Ret::Err(system_error(errno, "Failed to stat trace file", path));
+
+        auto bytes = static_cast<std::size_t>(st.st_size);
+        if (bytes < sizeof(trace::FileHeader))
+            return Ret::Err(format_error("header"));
+
+        void *addr = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd.get(), 0);
+        if (addr == MAP_FAILED)
+            return Ret::Err(system_error(errno, "Failed to map trace file", path));
+
+        // 映射在关闭描述符后依然有效；此后出错由 file 的析构解除映射
+        TraceFile file;
+        file.m_data = static_cast<const std::byte *>(addr);
+        file.m_bytes = bytes;
+
+        const auto *head = reinterpret_cast<const trace::FileHeader *>(file.m_data);
+        if (std::memcmp(head->magic, trace::FILE_MAGIC, sizeof(head->magic)) != 0)
+            return Ret::Err(format_error("magic"));
+        if (head->version != trace::VERSION)
+            return Ret::Err(format_error("version"));
+        if (head->record_size != sizeof(EventRecord))
+            return Ret::Err(format_error("record size"));
+
+        file.m_anchor.event_ns = head->anchor_event_ns;
+        file.m_anchor.wall = wall_from_ns(head->anchor_wall_ns);
+        file.m_shift = platform::time::process_anchor().from_wall(file.m_anchor.wall) -
+                       file.m_anchor.event_ns;
+
+        // 优先经尾部与索引定位各块
+        bool indexed = false;
+        if (bytes >= sizeof(trace::FileHeader) + sizeof(trace::Trailer))
+        {
+            // 文件被截断时尾部可能未对齐，复制出来再读
+            trace::Trailer tail;
+            std::memcpy(&tail, file.m_data + bytes - sizeof(tail), sizeof(tail));
+            std::uint64_t index_end = bytes - sizeof(trace::Trailer);
+
+            if (std::memcmp(tail.magic, trace::TRAILER_MAGIC, sizeof(tail.magic)) == 0 &&
+                tail.version == trace::VERSION &&
+                tail.index_offset % 8 == 0 &&
+                tail.index_offset <= index_end &&
+                tail.chunk_count == (index_end - tail.index_offset) / sizeof(trace::IndexEntry) &&
+                (index_end - tail.index_offset) % sizeof(trace::IndexEntry) == 0)
+            {
+                const auto *index = reinterpret_cast<const trace::IndexEntry *>(
+                    file.m_data + tail.index_offset);
+                file.m_chunks.reserve(tail.chunk_count);
+
+                indexed = true;
+                for (std::uint64_t i = 0; i < tail.chunk_count && indexed; ++i)
+                {
+                    auto c = bind_chunk(file.m_data, tail.index_offset, index[i].offset);
+                    if (!c || c->count != index[i].count || index[i].first != file.m_total)
+                    {
+                        indexed = false;
+                        break;
+                    }
+                    c->first = file.m_total;
+                    file.m_total += c->count;
+                    file.m_chunks.push_back(*c);
+                }
+
+                if (indexed)
+                {
+                    indexed = file.m_total == tail.total;
+                    file.m_ordered = (tail.flags & trace::ORDERED) != 0;
+                }
+            }
+        }
+
+        // 尾部无效：从文件头之后逐块扫描，直到遇到不完整的块
+        if (!indexed)
+        {
+            file.m_chunks.clear();
+            file.m_total = 0;
+            file.m_ordered = true;
+            file.m_recovered = true;
+
+            std::uint64_t offset = sizeof(trace::FileHeader);
+            while (auto c = bind_chunk(file.m_data, bytes, offset))
+            {
+                if (!c->ordered || (!file.m_chunks.empty() && c->min_ts < file.m_chunks.back().max_ts))
+                    file.m_ordered = false;
+
+                c->first = file.m_total;
+                file.m_total += c->count;
+                file.m_chunks.push_back(*c);
+                offset += reinterpret_cast<const trace::ChunkHeader *>(file.m_data + offset)->size;
+            }
+        }
+
+        return Ret::Ok(std::move(file));
+    }
+
+    TraceFile::Ref TraceFile::ref_at(EvIdx idx) const noexcept
+    {
+        auto it = std::upper_bound(m_chunks.begin(), m_chunks.end(), idx,
+                                   [](EvIdx i, const Chunk &c)
+                                   { return i < c.first; });
+        const auto &c = *(it - 1);
+        return {&c.records[idx - c.first], &c.arena};
+    }
+
+    Event TraceFile::restore(const EventRecord &rec, const ArenaImage &arena) const
+    {
+        EventRecord local = rec;
+        local.ts_ns = local_ts(rec.ts_ns);
+        return core::materialize(local, arena);
+    }
+
+    template <typename Fn>
+    void TraceFile::scan(const TimelineQuery &q, Fn &&fn) const
+    {
+        std::bitset<EVENT_TYPE_COUNT> types;
+        if (q.types.empty())
+            types.set();
+        for (auto t : q.types)
+            types.set(static_cast<std::size_t>(t));
+
+        std::int64_t lo = q.start ? m_anchor.from_wall(*q.start) : INT64_MIN;
+        std::int64_t hi = q.end ? m_anchor.from_wall(*q.end) : INT64_MAX;
+        if (lo > hi)
+            return;
+
+        for (const auto &c : m_chunks)
+        {
+            if (c.count == 0 || c.max_ts < lo || c.min_ts > hi)
+                continue;
+
+            // 有序块直接二分出时间范围，无序块逐条比较
+            std::size_t begin = 0, end = c.count;
+            bool check_ts = !c.ordered && (c.min_ts < lo || c.max_ts > hi);
+            if (c.ordered && (c.min_ts < lo || c.max_ts > hi))
+                std::tie(begin, end) = ordered_range(c, lo, hi);
+
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                const auto &r = c.records[i];
+                if (check_ts && (r.ts_ns < lo || r.ts_ns > hi))
+                    continue;
+                if (q.fd && r.fd != *q.fd)
+                    continue;
+                auto type = static_cast<std::size_t>(r.type);
+                if (type >= EVENT_TYPE_COUNT || !types.test(type))
+                    continue;
+                if (q.session && r.session != *q.session)
+                    continue;
+                if (q.errors_only && !r.is_error())
+                    continue;
+                fn(c.first + i, r, c.arena);
+            }
+        }
+    }
+
+    TraceFile::EvResult TraceFile::event_at(EvIdx idx, bool with_payload) const
+    {
+        using Ret = EvResult;
+        using util::Error;
+
+        if (idx >= size())
+        {
+            return Ret::Err(
+                Error::state()
+                    .target_not_found()
+                    .message("Event index out of range")
+                    .context(std::to_string(idx))
+                    .build());
+        }
+
+        auto ref = ref_at(idx);
+        if (with_payload)
+            return Ret::Ok(restore(*ref.rec, *ref.arena));
+
+        EventRecord lean = *ref.rec;
+        lean.payload = 0;
+        return Ret::Ok(restore(lean, *ref.arena));
+    }
+
+    TraceFile::EvResult TraceFile::latest_event() const
+    {
+        using Ret = EvResult;
+        using util::Error;
+
+        if (empty())
+            return Ret::Err(
+                Error::state()
+                    .invalid_state()
+                    .message("Cannot fetch latest event: Trace is empty")
+                    .build());
+
+        return event_at(size() - 1);
+    }
+
+    TraceFile::EvCnt TraceFile::count_by_fd(int fd) const
+    {
+        TimelineQuery q;
+        q.fd = fd;
+        return count_matching(q);
+    }
+
+    TraceFile::EvCnt TraceFile::count_by_type(EventType type) const
+    {
+        TimelineQuery q;
+        q.types = {type};
+        return count_matching(q);
+    }
+
+    TraceFile::EvCnt TraceFile::count_by_time(TimeStamp start, TimeStamp end) const
+    {
+        TimelineQuery q;
+        q.start = start;
+        q.end = end;
+        return count_matching(q);
+    }
+
+    TraceFile::EvCnt TraceFile::count_by_session(SessionId sid) const
+    {
+        TimelineQuery q;
+        q.session = sid;
+        return count_matching(q);
+    }
+
+    TraceFile::EvList TraceFile::replay_all() const
+    {
+        EvList result;
+        result.reserve(size());
+        for_each([&](const EventRecord &r, const ArenaImage &arena)
+                 { result.push_back(restore(r, arena)); });
+        return result;
+    }
+
+    TraceFile::EvList TraceFile::query_by_fd(int fd) const
+    {
+        TimelineQuery q;
+        q.fd = fd;
+        return query(q);
+    }
+
+    TraceFile::EvList TraceFile::query_by_type(EventType type) const
+    {
+        TimelineQuery q;
+        q.types = {type};
+        return query(q);
+    }
+
+    TraceFile::EvList TraceFile::query_by_time(TimeStamp start, TimeStamp end) const
+    {
+        TimelineQuery q;
+        q.start = start;
+        q.end = end;
+        return query(q);
+    }
+
+    TraceFile::EvList TraceFile::query_by_session(SessionId sid) const
+    {
+        TimelineQuery q;
+        q.session = sid;
+        return query(q);
+    }
+
+    TraceFile::EvList TraceFile::query_errors() const
+    {
+        TimelineQuery q;
+        q.errors_only = true;
+        return query(q);
+    }
+
+    TraceFile::EvList TraceFile::query(const TimelineQuery &q) const
+    {
+        EvList result;
+        scan(q, [&](EvIdx, const EventRecord &r, const ArenaImage &arena)
+             { result.push_back(restore(r, arena)); });
+        return result;
+    }
+
+    TraceFile::EvCnt TraceFile::count_matching(const TimelineQuery &q) const
+    {
+        // 只有时间条件时，有序块的命中数即二分出的区间长度
+        bool time_only = !q.fd && q.types.empty() && !q.session && !q.errors_only;
+        if (time_only)
+        {
+            std::int64_t lo = q.start ? m_anchor.from_wall(*q.start) : INT64_MIN;
+            std::int64_t hi = q.end ? m_anchor.from_wall(*q.end) : INT64_MAX;
+            if (lo > hi)
+                return 0;
+
+            EvCnt cnt = 0;
+            for (const auto &c : m_chunks)
+            {
+                if (c.count == 0 || c.max_ts < lo || c.min_ts > hi)
+                    continue;
+                if (c.ordered)
+                {
+                    auto [begin, end] = ordered_range(c, lo, hi);
+                    cnt += end - begin;
+                    continue;
+                }
+                for (std::size_t i = 0; i < c.count; ++i)
+                    cnt += (c.records[i].ts_ns >= lo && c.records[i].ts_ns <= hi);
+            }
+            return cnt;
+        }
+
+        EvCnt cnt = 0;
+        scan(q, [&](EvIdx, const EventRecord &, const ArenaImage &)
+             { ++cnt; });
+        return cnt;
+    }
+
+    TraceFile::IdxList TraceFile::select(const TimelineQuery &q) const
+    {
+        IdxList result;
+        scan(q, [&](EvIdx idx, const EventRecord &, const ArenaImage &)
+             { result.push_back(idx); });
+        return result;
+    }
+
+    TraceFile::EvList TraceFile::materialize(const IdxList &idxs) const
+    {
+        EvList result;
+        result.reserve(idxs.size());
+        for (auto idx : idxs)
+        {
+            if (idx >= size())
+                continue;
+            auto ref = ref_at(idx);
+            result.push_back(restore(*ref.rec, *ref.arena));
+        }
+        return result;
+    }
+}
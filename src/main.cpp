@@ -6,6 +6,20 @@
  *  Description :
  *      程序主入口。解析命令行参数，初始化 Orchestrator、Engine 和 TUI App，
  *      组装各模块并启动主循环。
+ *      指定 -c / -t / -d 任一参数时进入 wrk 风格的无界面压测模式：
+ *          eunet_cli -c 100 -t 4 -d 30s http://127.0.0.1:8080/
+ *      指定 --json 时进入无界面批处理模式，依次请求所有 URL，
+ *      以 NDJSON 格式把每个会话的阶段耗时与错误输出到 stdout：
+ *          eunet_cli --json http://a.example/ http://b.example/ | jq .
+ *      指定 --record 时把全部事件持续写入二进制追踪文件，之后可用
+ *      --open 以 mmap 打开该文件，在 TUI 中离线浏览：
+ *          eunet_cli --record run.trace http://a.example/
+ *          eunet_cli --open run.trace
+ *      --record 同样可与压测模式同用，记录全部连接的事件。
+ *      同时指定 --replay 时按记录中的事件间隔重新驱动 Orchestrator 与 TUI：
+ *          eunet_cli --open run.trace --replay 10x
+ *      指定 --spill 时 Timeline 内存超过 --memory 给出的预算后把旧段落盘：
+ *          eunet_cli --json --spill /var/tmp --memory 64 http://a.example/
  *
  *  Third-Party Dependencies :
  *      None
@@ -19,26 +33,235 @@
 #include <thread>
 #include <string>
 #include <chrono>
+#include <iostream>
+#include <optional>
+#include <vector>
 
 #include "eunet/core/orchestrator.hpp"
+#include "eunet/core/engine.hpp"
+#include "eunet/core/trace_file.hpp"
+#include "eunet/core/replay_scenario.hpp"
+#include "eunet/core/sink/json_sink.hpp"
+#include "eunet/core/sink/trace_sink.hpp"
 #include "eunet/tui/tui_app.hpp"
 #include "eunet/net/http_scenario.hpp"
+#include "eunet/net/bench_scenario.hpp"
+#include "eunet/app/cli_options.hpp"
 
-int main(int argc, char **argv)
+namespace
 {
-    std::string target_url = "http://www.baidu.com"; // 默认值
+    using app::CliOptions;
+
+    // 打开 --record 指定的追踪文件，失败时输出原因并返回空
+    std::optional<std::shared_ptr<core::sink::TraceSink>> make_recorder(const CliOptions &opts)
+    {
+        if (opts.record_path.empty())
+            return std::shared_ptr<core::sink::TraceSink>{};
+
+        auto writer = core::TraceWriter::create(opts.record_path);
+        if (writer.is_err())
+        {
+            std::cerr << "record failed: " << writer.unwrap_err().format() << "\n";
+            return std::nullopt;
+        }
+        return std::make_shared<core::sink::TraceSink>(std::move(writer).unwrap());
+    }
+
+    // 取追踪文件末尾至多 limit 条事件，按原顺序重放状态机得到展示用的快照
+    std::optional<std::vector<core::EventSnapshot>> load_trace(
+        const std::string &path,
+        std::size_t limit)
+    {
+        auto file = core::TraceFile::open(path);
+        if (file.is_err())
+        {
+            std::cerr << "open failed: " << file.unwrap_err().format() << "\n";
+            return std::nullopt;
+        }
+
+        const auto &trace = file.unwrap();
+        std::size_t first = trace.size() > limit ? trace.size() - limit : 0;
+
+        core::FsmManager fsms;
+        std::vector<core::EventSnapshot> snaps;
+        snaps.reserve(trace.size() - first);
+        for (std::size_t idx = first; idx < trace.size(); ++idx)
+        {
+            auto e = trace.event_at(idx).unwrap();
+            fsms.on_event(e);
+
+            const auto *fsm = fsms.get(e.session_id);
+            auto payload_size = e.payload ? e.payload->size() : 0;
+            auto fd = e.fd.fd;
+            auto ts = e.ts;
+            auto payload = e.payload;
+            snaps.push_back(core::EventSnapshot{
+                .event = std::move(e),
+                .fd = fd,
+                .state = fsm ? fsm->current_state() : core::LifeState::Finished,
+                .ts = ts,
+                .error = fsm ? fsm->get_last_error() : std::nullopt,
+                .payload = std::move(payload),
+                .payload_size = payload_size,
+            });
+        }
+        return snaps;
+    }
+
+    // 按 --spill / --memory 开启落盘，失败时输出原因
+    bool setup_spill(core::Orchestrator &orch, const CliOptions &opts)
+    {
+        if (opts.spill_dir.empty())
+            return true;
+
+        auto r = orch.enable_spill(core::SpillOptions{
+            .dir = opts.spill_dir,
+            .memory_budget = opts.memory_mib.value_or(256) * 1024 * 1024,
+        });
+        if (r.is_err())
+        {
+            std::cerr << "spill failed: " << r.unwrap_err().format() << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    int run_bench(const CliOptions &opts)
+    {
+        auto recorder = make_recorder(opts);
+        if (!recorder)
+            return 1;
+
+        const auto &cfg = opts.bench_cfg;
+        core::Orchestrator orch;
+        if (!setup_spill(orch, opts))
+            return 1;
+        if (*recorder)
+            orch.attach(*recorder);
+        net::http::BenchScenario scenario(cfg);
+
+        auto r = scenario.run(orch);
+        if (*recorder)
+        {
+            orch.detach(*recorder);
+            (*recorder)->flush();
+        }
+        if (r.is_err())
+        {
+            std::cerr << "bench failed: " << r.unwrap_err().format() << "\n";
+            return 1;
+        }
+
+        std::cout << net::http::format_report(cfg, scenario.report());
+        return 0;
+    }
+
+    // 依次经引擎执行每个 URL，任一场景失败时返回 1
+    int run_headless(const CliOptions &opts)
+    {
+        auto recorder = make_recorder(opts);
+        if (!recorder)
+            return 1;
+
+        core::Orchestrator orch;
+        if (!setup_spill(orch, opts))
+            return 1;
+        core::NetworkEngine engine(orch);
+
+        auto json = std::make_shared<core::sink::JsonSink>(
+            std::cout, core::sink::JsonSinkOptions{.events = opts.json_events});
+        orch.attach(json);
+        if (*recorder)
+            orch.attach(*recorder);
+
+        size_t failures = 0;
+        for (const auto &url : opts.urls)
+        {
+            engine.execute(std::make_unique<net::http::HttpGetScenario>(url));
+            engine.wait();
+            if (engine.last_error())
+                ++failures;
+        }
+
+        json->flush();
+        orch.detach(json);
+        if (*recorder)
+        {
+            orch.detach(*recorder);
+            (*recorder)->flush();
+        }
+        return failures == 0 ? 0 : 1;
+    }
+}
 
-    if (argc > 1)
+int main(int argc, char **argv)
+{
+    auto opts = app::parse_args(argc, argv);
+    if (!opts)
     {
-        target_url = argv[1]; // 接受命令行第一个参数作为 URL
+        app::print_usage(argv[0]);
+        return 2;
     }
 
+    // 压测模式不创建任何 TUI 组件
+    if (opts->bench)
+        return run_bench(*opts);
+
+    if (opts->json)
+        return run_headless(*opts);
+
     core::Orchestrator orch;
+    if (!setup_spill(orch, *opts))
+        return 1;
     core::NetworkEngine engine(orch);
     ui::TuiApp app(orch, engine); // 把引擎传给 UI
 
-    engine.execute(std::make_unique<net::http::HttpGetScenario>(target_url));
+    // 回放：事件经 Orchestrator 重新分发，TUI 按记录中的节奏逐条收到
+    if (!opts->open_path.empty() && opts->replay_speed)
+    {
+        auto replay = std::make_unique<core::scenario::ReplayScenario>(
+            opts->open_path, core::scenario::ReplayConfig{.speed = *opts->replay_speed});
+        auto stopper = replay->stop_source();
+
+        engine.execute(std::move(replay));
+        app.run();
+
+        // 界面退出时回放可能仍在等待下一条事件
+        stopper.request_stop();
+        engine.wait();
+        if (auto err = engine.last_error())
+        {
+            std::cerr << "replay failed: " << err->format() << "\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // 离线浏览只展示文件中的事件，不发起请求
+    if (!opts->open_path.empty())
+    {
+        auto snaps = load_trace(opts->open_path, ui::TuiApp::MAX_EVENTS);
+        if (!snaps)
+            return 1;
+        app.load(std::move(*snaps));
+        app.run();
+        return 0;
+    }
+
+    auto recorder = make_recorder(*opts);
+    if (!recorder)
+        return 1;
+    if (*recorder)
+        orch.attach(*recorder);
+
+    engine.execute(std::make_unique<net::http::HttpGetScenario>(opts->url));
 
     app.run();
+
+    if (*recorder)
+    {
+        orch.detach(*recorder);
+        (*recorder)->flush();
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,316 @@
+/*
+ * ============================================================================
+ *  File Name   : bench_scenario.cpp
+ *  Module      : net/http
+ *
+ *  Description :
+ *      BenchScenario 实现。每条连接是一个协程：建连一次后循环复用，
+ *      连接被关闭或出错时重新建连，直到截止时间。
+ *      各线程独立统计，结束后合并为总报告。
+ *
+ *  Third-Party Dependencies :
+ *      - fmt
+ *          Usage     : 格式化压测报告
+ *          License   : MIT License
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/net/bench_scenario.hpp"
+#include "eunet/net/http_client.hpp"
+#include "eunet/platform/awaitable.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "fmt/format.h"
+
+namespace net::http
+{
+    namespace
+    {
+        // 建连失败后的退避，避免对拒绝连接的目标空转
+        constexpr auto CONNECT_BACKOFF = std::chrono::milliseconds(10);
+
+        std::string human_bytes(double v)
+        {
+            const char *units[] = {"B", "KB", "MB", "GB"};
+            int i = 0;
+            while (v >= 1024.0 && i < 3)
+            {
+                v /= 1024.0;
+                ++i;
+            }
+            return fmt::format("{:.2f}{}", v, units[i]);
+        }
+
+        void record_error(BenchReport &rep, const util::Error &err)
+        {
+            ++rep.errors;
+            ++rep.errors_by_category[err.root_category()];
+        }
+    }
+
+    void BenchReport::merge(const BenchReport &other)
+    {
+        requests += other.requests;
+        bytes += other.bytes;
+        non_2xx += other.non_2xx;
+        connects += other.connects;
+        errors += other.errors;
+        for (const auto &[cat, n] : other.errors_by_category)
+            errors_by_category[cat] += n;
+
+        elapsed_s = std::max(elapsed_s, other.elapsed_s);
+        latency.merge(other.latency);
+    }
+
+    std::string format_report(const BenchConfig &cfg, const BenchReport &r)
+    {
+        auto ms = [](std::int64_t us)
+        { return static_cast<double>(us) / 1000.0; };
+
+        std::string out;
+        out += fmt::format("Running {:.1f}s test @ {}\n",
+                           static_cast<double>(cfg.duration.count()) / 1000.0, cfg.url);
+        out += fmt::format("  {} threads and {} connections\n",
+                           std::min(cfg.threads, cfg.connections), cfg.connections);
+        out += fmt::format("  Latency   mean {:.3f}ms  max {:.3f}ms\n",
+                           r.latency.mean() / 1000.0, ms(r.latency.max()));
+        out += "  Latency Distribution\n";
+        for (double p : {50.0, 75.0, 90.0, 99.0, 99.9})
+            out += fmt::format("    {:>6}%  {:.3f}ms\n", p, ms(r.latency.value_at_percentile(p)));
+
+        out += fmt::format("  {} requests in {:.2f}s, {} read ({} connects)\n",
+                           r.requests, r.elapsed_s, human_bytes(static_cast<double>(r.bytes)), r.connects);
+
+        if (r.non_2xx)
+            out += fmt::format("  Non-2xx responses: {}\n", r.non_2xx);
+
+        if (r.errors)
+        {
+            out += fmt::format("  Errors: {}\n", r.errors);
+            for (const auto &[cat, n] : r.errors_by_category)
+                out += fmt::format("    {:<20}{}\n", to_string(cat), n);
+        }
+
+        out += fmt::format("Requests/sec: {:.2f}\n", r.requests_per_sec());
+        out += fmt::format("Transfer/sec: {}\n", human_bytes(r.bytes_per_sec()));
+        return out;
+    }
+
+    BenchScenario::BenchScenario(BenchConfig cfg)
+        : m_cfg(std::move(cfg)),
+          m_target(parse_http_url(m_cfg.url))
+    {
+    }
+
+    util::ResultV<void> BenchScenario::validate() const
+    {
+        if (m_cfg.connections == 0 || m_cfg.threads == 0 || m_target.host.empty())
+        {
+            return util::ResultV<void>::Err(
+                util::Error::config()
+                    .invalid_argument()
+                    .message("Connections, threads and target host must be non-empty")
+                    .context("BenchScenario")
+                    .build());
+        }
+        return util::ResultV<void>::Ok();
+    }
+
+    util::ResultV<void>
+    BenchScenario::run(
+        core::Orchestrator &orch)
+    {
+        using Ret = util::ResultV<void>;
+
+        if (auto v = validate(); v.is_err())
+            return Ret::Err(v.unwrap_err());
+
+        std::size_t threads = std::min(m_cfg.threads, m_cfg.connections);
+        std::vector<BenchReport> reports(threads);
+        std::vector<std::optional<util::Error>> failures(threads);
+        std::vector<std::thread> workers;
+
+        auto start = platform::time::monotonic_now();
+        auto deadline = start + m_cfg.duration;
+
+        // 连接数按线程均分，余数分给前几个线程
+        for (std::size_t i = 0; i < threads; ++i)
+        {
+            std::size_t conns = m_cfg.connections / threads +
+                                (i < m_cfg.connections % threads ? 1 : 0);
+
+            workers.emplace_back(
+                [&, i, conns]
+                {
+                    auto r = run_thread(orch, conns, deadline, reports[i]);
+                    if (r.is_err())
+                        failures[i] = r.unwrap_err();
+                });
+        }
+
+        for (auto &w : workers)
+            w.join();
+
+        m_report = BenchReport{};
+        for (const auto &r : reports)
+            m_report.merge(r);
+
+        // 以全部线程共用的起点计时，各线程建立 EventLoop 的耗时不会使结果短于压测时长
+        m_report.elapsed_s = std::chrono::duration<double>(
+                                 platform::time::monotonic_now() - start)
+                                 .count();
+
+        for (auto &f : failures)
+            if (f)
+                return Ret::Err(*f);
+        return Ret::Ok();
+    }
+
+    util::ResultV<void>
+    BenchScenario::run_thread(
+        core::Orchestrator &orch,
+        std::size_t conns,
+        platform::time::MonoPoint deadline,
+        BenchReport &rep)
+    {
+        using Ret = util::ResultV<void>;
+
+        auto loop_res = platform::reactor::EventLoop::create();
+        if (loop_res.is_err())
+            return Ret::Err(loop_res.unwrap_err());
+        auto loop = std::move(loop_res.unwrap());
+
+        auto start = platform::time::monotonic_now();
+        std::size_t live = conns;
+        for (std::size_t i = 0; i < conns; ++i)
+            util::spawn(drive(orch, *loop, deadline, rep),
+                        [&]
+                        { --live; });
+
+        while (live > 0)
+        {
+            auto r = loop->run_once(100);
+            if (r.is_err())
+                return Ret::Err(r.unwrap_err());
+        }
+
+        rep.elapsed_s = std::chrono::duration<double>(
+                            platform::time::monotonic_now() - start)
+                            .count();
+        return Ret::Ok();
+    }
+
+    util::Task<util::ResultV<void>>
+    BenchScenario::run_async(
+        core::Orchestrator &orch,
+        platform::reactor::EventLoop &loop)
+    {
+        using Ret = util::ResultV<void>;
+
+        if (auto v = validate(); v.is_err())
+            co_return Ret::Err(v.unwrap_err());
+
+        m_report = BenchReport{};
+        auto start = platform::time::monotonic_now();
+        auto deadline = start + m_cfg.duration;
+
+        // 每条连接一个协程，全部结束后由最后一个恢复本协程
+        std::size_t live = m_cfg.connections;
+        std::coroutine_handle<> waiter;
+        struct WaitAll
+        {
+            std::size_t &live;
+            std::coroutine_handle<> &waiter;
+
+            bool await_ready() const noexcept { return live == 0; }
+            void await_suspend(std::coroutine_handle<> h) noexcept { waiter = h; }
+            void await_resume() const noexcept {}
+        };
+
+        for (std::size_t i = 0; i < m_cfg.connections; ++i)
+            util::spawn(drive(orch, loop, deadline, m_report),
+                        [&]
+                        {
+                            if (--live == 0 && waiter)
+                                loop.post([h = waiter]
+                                          { h.resume(); });
+                        });
+
+        co_await WaitAll{live, waiter};
+
+        m_report.elapsed_s = std::chrono::duration<double>(
+                                 platform::time::monotonic_now() - start)
+                                 .count();
+        co_return Ret::Ok();
+    }
+
+    util::Task<void>
+    BenchScenario::drive(
+        core::Orchestrator &orch,
+        platform::reactor::EventLoop &loop,
+        platform::time::MonoPoint deadline,
+        BenchReport &rep)
+    {
+        HttpRequest req;
+        req.host = m_target.host;
+        req.port = m_target.port;
+        req.target = m_target.path;
+        req.timeout_ms = m_cfg.timeout_ms;
+        req.connection_close = false;
+
+        std::optional<net::tcp::TCPConnection> conn;
+
+        while (platform::time::monotonic_now() < deadline)
+        {
+            if (!conn || !conn->is_open())
+            {
+                auto opened = co_await HTTPClient::async_open(orch, req, loop);
+                if (opened.is_err())
+                {
+                    record_error(rep, opened.unwrap_err());
+                    auto backoff = platform::time::monotonic_now() + CONNECT_BACKOFF;
+                    (void)co_await platform::reactor::sleep_until(loop, backoff);
+                    continue;
+                }
+
+                conn.emplace(std::move(opened.unwrap()));
+                ++rep.connects;
+            }
+
+            auto t0 = platform::time::monotonic_now();
+            auto res = co_await HTTPClient::async_request(orch, *conn, req, loop);
+            auto t1 = platform::time::monotonic_now();
+
+            if (res.is_err())
+            {
+                record_error(rep, res.unwrap_err());
+                continue;
+            }
+
+            const auto &resp = res.unwrap();
+            ++rep.requests;
+            rep.bytes += resp.wire_size;
+            if (!resp.ok())
+                ++rep.non_2xx;
+            rep.latency.record(
+                std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+        }
+
+        if (conn && conn->is_open())
+        {
+            (void)orch.emit(core::Event::info(
+                core::EventType::CONNECTION_CLOSED,
+                "Closing connection", conn->fd()));
+            conn->close();
+        }
+    }
+}
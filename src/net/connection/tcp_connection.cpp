@@ -17,6 +17,7 @@
  */
 
 #include "eunet/net/connection/tcp_connection.hpp"
+#include "eunet/platform/awaitable.hpp"
 
 #include <utility>
 #include <algorithm>
@@ -28,14 +29,15 @@ namespace net::tcp
     TCPConnection::connect(
         const platform::net::Endpoint &ep,
         platform::poller::Poller &poller,
-        int timeout_ms)
+        int timeout_ms,
+        const platform::net::SocketOptions &opts)
     {
         using platform::net::AddressFamily;
 
         auto af = static_cast<sa_family_t>(ep.family());
         auto domain = (af == AF_INET6) ? AddressFamily::IPv6 : AddressFamily::IPv4;
 
-        auto sock = platform::net::TCPSocket::create(poller, domain);
+        auto sock = platform::net::TCPSocket::create(poller, domain, opts);
         if (sock.is_err())
             return util::ResultV<TCPConnection>::Err(sock.unwrap_err());
 
@@ -49,10 +51,72 @@ namespace net::tcp
             TCPConnection(std::move(s)));
     }
 
+    util::Task<util::ResultV<TCPConnection>>
+    TCPConnection::async_connect(
+        platform::net::Endpoint ep,
+        platform::reactor::EventLoop &loop,
+        int timeout_ms,
+        platform::net::SocketOptions opts)
+    {
+        using Ret = util::ResultV<TCPConnection>;
+        using platform::net::AddressFamily;
+
+        auto af = static_cast<sa_family_t>(ep.family());
+        auto domain = (af == AF_INET6) ? AddressFamily::IPv6 : AddressFamily::IPv4;
+
+        auto sock = platform::net::TCPSocket::create(loop.poller(), domain, opts);
+        if (sock.is_err())
+            co_return Ret::Err(sock.unwrap_err());
+
+        auto s = std::move(sock.unwrap());
+
+        auto nb = s.set_nonblocking(true);
+        if (nb.is_err())
+            co_return Ret::Err(nb.unwrap_err());
+
+        auto started = s.start_connect(ep);
+        if (started.is_err())
+            co_return Ret::Err(started.unwrap_err());
+
+        // 连接进行中 挂起直到可写或超时
+        if (!started.unwrap())
+        {
+            auto w = co_await platform::reactor::writable(loop, s.view(), timeout_ms);
+            if (w.is_err())
+            {
+                (void)loop.unwatch(s.view());
+                co_return Ret::Err(w.unwrap_err());
+            }
+
+            auto done = s.finish_connect();
+            if (done.is_err())
+            {
+                (void)loop.unwatch(s.view());
+                co_return Ret::Err(done.unwrap_err());
+            }
+        }
+
+        // 等待连接时的注册随连接保留 后续读写只切换关注掩码
+        TCPConnection conn(std::move(s));
+        conn.m_loop = &loop;
+        co_return Ret::Ok(std::move(conn));
+    }
+
     TCPConnection::TCPConnection(
         platform::net::TCPSocket &&sock) noexcept
         : m_sock(std::move(sock)) {}
 
+    TCPConnection::TCPConnection(TCPConnection &&other) noexcept
+        : m_sock(std::move(other.m_sock)),
+          m_in(std::move(other.m_in)),
+          m_out(std::move(other.m_out)),
+          m_loop(std::exchange(other.m_loop, nullptr)) {}
+
+    TCPConnection::~TCPConnection()
+    {
+        close();
+    }
+
     TCPConnection
     TCPConnection::from_accepted_socket(
         platform::net::TCPSocket &&sock)
@@ -73,6 +137,11 @@ namespace net::tcp
 
     void TCPConnection::close() noexcept
     {
+        // 先注销 reactor 中的注册，fd 编号关闭后可能立即被复用
+        if (m_loop && m_sock.view())
+            (void)m_loop->unwatch(m_sock.view());
+        m_loop = nullptr;
+
         m_sock.close();
     }
 
@@ -164,4 +233,92 @@ namespace net::tcp
         }
         return util::ResultV<void>::Ok();
     }
-}
\ No newline at end of file
+
+    util::Task<IOResult>
+    TCPConnection::async_read(
+        util::ByteBuffer &buf,
+        platform::reactor::EventLoop &loop,
+        int timeout_ms)
+    {
+        m_loop = &loop;
+
+        // 1. 先搬已有的 in_buffer
+        if (!m_in.empty())
+        {
+            auto readable = m_in.readable();
+            buf.append(readable);
+            m_in.consume(readable.size());
+            co_return IOResult::Ok(readable.size());
+        }
+
+        // 2. 尝试直接读取 暂无数据时挂起等待可读
+        for (;;)
+        {
+            auto res = m_sock.try_read(buf);
+            if (res.is_ok())
+                co_return IOResult::Ok(res.unwrap());
+
+            if (res.unwrap_err().category() != util::ErrorCategory::Busy)
+                co_return IOResult::Err(res.unwrap_err());
+
+            auto w = co_await platform::reactor::readable(loop, fd(), timeout_ms);
+            if (w.is_err())
+                co_return IOResult::Err(w.unwrap_err());
+
+            // 开启时间戳后发送回执也会触发 EPOLLERR 及时收取
+            if (w.unwrap() & EPOLLERR)
+                (void)m_sock.drain_tx_timestamps();
+        }
+    }
+
+    util::Task<IOResult>
+    TCPConnection::async_write(
+        util::ByteBuffer &buf,
+        platform::reactor::EventLoop &loop,
+        int timeout_ms)
+    {
+        m_loop = &loop;
+
+        size_t total_written = 0;
+
+        // 先写出积压数据 保证字节序不乱
+        for (util::ByteBuffer *src : {&m_out, &buf})
+        {
+            while (!src->empty())
+            {
+                auto res = m_sock.try_write(*src);
+                if (res.is_ok())
+                {
+                    if (src == &buf)
+                        total_written += res.unwrap();
+                    continue;
+                }
+
+                if (res.unwrap_err().category() != util::ErrorCategory::Busy)
+                    co_return IOResult::Err(res.unwrap_err());
+
+                auto w = co_await platform::reactor::writable(loop, fd(), timeout_ms);
+                if (w.is_err())
+                    co_return IOResult::Err(w.unwrap_err());
+
+                // 开启时间戳后发送回执也会触发 EPOLLERR 及时收取
+                if (w.unwrap() & EPOLLERR)
+                    (void)m_sock.drain_tx_timestamps();
+            }
+        }
+
+        // 推迟的 Fast Open 连接 数据随 SYN 发出后等待握手确认
+        if (m_sock.connect_pending())
+        {
+            auto w = co_await platform::reactor::writable(loop, fd(), timeout_ms);
+            if (w.is_err())
+                co_return IOResult::Err(w.unwrap_err());
+
+            auto done = m_sock.finish_connect();
+            if (done.is_err())
+                co_return IOResult::Err(done.unwrap_err());
+        }
+
+        co_return IOResult::Ok(total_written);
+    }
+}
@@ -17,6 +17,9 @@
  */
 
 #include "eunet/net/connection/udp_connection.hpp"
+#include "eunet/platform/awaitable.hpp"
+
+#include <utility>
 
 namespace net::udp
 {
@@ -56,6 +59,26 @@ namespace net::udp
             UDPConnection(std::move(s)));
     }
 
+    util::Task<util::ResultV<UDPConnection>>
+    UDPConnection::async_connect(
+        platform::net::Endpoint ep,
+        platform::reactor::EventLoop &loop)
+    {
+        using Ret = util::ResultV<UDPConnection>;
+
+        auto res = connect(ep, loop.poller(), 0);
+        if (res.is_err())
+            co_return Ret::Err(res.unwrap_err());
+
+        auto conn = std::move(res.unwrap());
+
+        auto nb = conn.m_sock.set_nonblocking(true);
+        if (nb.is_err())
+            co_return Ret::Err(nb.unwrap_err());
+
+        co_return Ret::Ok(std::move(conn));
+    }
+
     UDPConnection
     UDPConnection::from_accepted_socket(
         platform::net::UDPSocket &&sock)
@@ -67,6 +90,17 @@ namespace net::udp
         platform::net::UDPSocket &&sock) noexcept
         : m_sock(std::move(sock)) {}
 
+    UDPConnection::UDPConnection(UDPConnection &&other) noexcept
+        : m_sock(std::move(other.m_sock)),
+          m_in(std::move(other.m_in)),
+          m_out(std::move(other.m_out)),
+          m_loop(std::exchange(other.m_loop, nullptr)) {}
+
+    UDPConnection::~UDPConnection()
+    {
+        close();
+    }
+
     platform::fd::FdView
     UDPConnection::fd() const noexcept
     {
@@ -82,6 +116,11 @@ namespace net::udp
     void
     UDPConnection::close() noexcept
     {
+        // 先注销 reactor 中的注册，fd 编号关闭后可能立即被复用
+        if (m_loop && m_sock.view())
+            (void)m_loop->unwatch(m_sock.view());
+        m_loop = nullptr;
+
         m_sock.close();
     }
 
@@ -171,4 +210,83 @@ namespace net::udp
 
         return util::ResultV<void>::Ok();
     }
+
+    util::Task<IOResult>
+    UDPConnection::async_read(
+        util::ByteBuffer &buf,
+        platform::reactor::EventLoop &loop,
+        int timeout_ms)
+    {
+        m_loop = &loop;
+
+        // 1. 优先消费 in_buffer
+        if (!m_in.empty())
+        {
+            auto readable = m_in.readable();
+            buf.append(readable);
+            m_in.consume(readable.size());
+            co_return IOResult::Ok(readable.size());
+        }
+
+        // 2. 收取一个 datagram 暂无数据时挂起等待可读
+        for (;;)
+        {
+            auto res = m_sock.try_read(buf);
+            if (res.is_ok())
+                co_return IOResult::Ok(res.unwrap());
+
+            if (res.unwrap_err().category() != util::ErrorCategory::Busy)
+                co_return IOResult::Err(res.unwrap_err());
+
+            auto w = co_await platform::reactor::readable(loop, fd(), timeout_ms);
+            if (w.is_err())
+                co_return IOResult::Err(w.unwrap_err());
+
+            // 开启时间戳后发送回执也会触发 EPOLLERR 及时收取
+            if (w.unwrap() & EPOLLERR)
+                (void)m_sock.drain_tx_timestamps();
+        }
+    }
+
+    util::Task<IOResult>
+    UDPConnection::async_write(
+        util::ByteBuffer &buf,
+        platform::reactor::EventLoop &loop,
+        int timeout_ms)
+    {
+        m_loop = &loop;
+
+        size_t total_written = 0;
+
+        // 每个缓冲区对应一个 datagram 发送缓冲区满时挂起等待可写
+        for (util::ByteBuffer *src : {&m_out, &buf})
+        {
+            if (src->empty())
+                continue;
+
+            for (;;)
+            {
+                auto res = m_sock.try_write(*src);
+                if (res.is_ok())
+                {
+                    if (src == &buf)
+                        total_written += res.unwrap();
+                    break;
+                }
+
+                if (res.unwrap_err().category() != util::ErrorCategory::Busy)
+                    co_return IOResult::Err(res.unwrap_err());
+
+                auto w = co_await platform::reactor::writable(loop, fd(), timeout_ms);
+                if (w.is_err())
+                    co_return IOResult::Err(w.unwrap_err());
+
+                // 开启时间戳后发送回执也会触发 EPOLLERR 及时收取
+                if (w.unwrap() & EPOLLERR)
+                    (void)m_sock.drain_tx_timestamps();
+            }
+        }
+
+        co_return IOResult::Ok(total_written);
+    }
 }
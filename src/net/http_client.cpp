@@ -6,7 +6,8 @@
  *  Description :
  *      HTTP 客户端核心逻辑实现。使用 Boost.Beast 序列化请求，
  *      通过 TCPClient 发送，解析响应数据，并在关键节点（如 Headers Received）
- *      触发业务事件。
+ *      触发业务事件。async_get 复用同一套构建与解析逻辑，
+ *      IO 改为在 EventLoop 上挂起等待。
  *
  *  Third-Party Dependencies :
  *      - Boost.Beast
@@ -24,9 +25,12 @@
  */
 
 #include "eunet/net/http_client.hpp"
+#include "eunet/platform/net/dns_resolver.hpp"
 
+#include <span>
 #include <sstream>
 
+#include <fmt/format.h>
 #include <boost/beast/http.hpp>
 #include <boost/beast/core.hpp>
 
@@ -35,19 +39,146 @@ namespace net::http
     namespace beast = boost::beast;
     namespace http = beast::http;
 
-    HTTPClient::HTTPClient(core::Orchestrator &o)
-        : orch(o), tcp(o) {}
+    namespace
+    {
+        using Parser = http::response_parser<http::dynamic_body>;
+
+        // 使用 Boost.Beast 构建 HTTP 请求并序列化为文本
+        std::string build_request_text(const HttpRequest &cfg)
+        {
+            http::request<http::string_body> req{
+                http::verb::get,
+                cfg.target,
+                11};
+
+            req.set(http::field::host, cfg.host);
+            req.set(http::field::user_agent, "EuNet/0.1");
+            if (cfg.connection_close)
+                req.set(http::field::connection, "close");
+
+            for (auto &[k, v] : cfg.headers)
+                req.set(k, v);
+
+            req.prepare_payload();
+
+            std::ostringstream oss;
+            oss << req;
+            return oss.str();
+        }
+
+        // 构造 HTTP 状态行与头部文本 (e.g., "HTTP/1.1 200 OK")
+        std::string describe_headers(const Parser &parser)
+        {
+            const auto &msg = parser.get();
+
+            std::stringstream ss;
+
+            // msg.version() 返回 11 代表 HTTP/1.1, 10 代表 HTTP/1.0
+            ss << "HTTP/" << (msg.version() / 10)
+               << "." << (msg.version() % 10) << " "
+               << msg.result_int() << " " // 状态码 (200)
+               << msg.reason() << "\r\n"; // 原因短语 (OK)
+
+            // 遍历所有 Header 字段
+            for (auto const &field : msg)
+            {
+                ss << field.name_string() << ": "
+                   << field.value() << "\r\n";
+            }
+            return ss.str();
+        }
+
+        util::ResultV<void> parse_error(const char *what, const boost::system::error_code &ec)
+        {
+            return util::ResultV<void>::Err(
+                util::Error::protocol()
+                    .message(what)
+                    .context(ec.message())
+                    .build());
+        }
+
+        // 将数据喂给解析器
+        // 解析器在头部完成时会先返回 需循环直到本块数据全部消费
+        util::ResultV<void> feed(Parser &parser, boost::asio::const_buffer bytes, const char *what)
+        {
+            boost::system::error_code ec;
+            while (bytes.size() > 0 && !parser.is_done())
+            {
+                std::size_t n = parser.put(bytes, ec);
+
+                // 如果是 "需要更多数据"，则不是错误，继续循环读取即可
+                if (ec == beast::http::error::need_more)
+                    return util::ResultV<void>::Ok();
+
+                if (ec)
+                    return parse_error(what, ec);
+
+                if (n == 0)
+                    break;
+                bytes += n;
+            }
+            return util::ResultV<void>::Ok();
+        }
+
+        // 告知解析器输入已结束（EOF），以便完成无长度响应体的解析
+        util::ResultV<void> feed_eof(Parser &parser, const char *what)
+        {
+            if (!parser.got_some() || parser.is_done())
+                return util::ResultV<void>::Ok();
+
+            boost::system::error_code ec;
+            parser.put_eof(ec);
+            if (ec)
+                return parse_error(what, ec);
+            return util::ResultV<void>::Ok();
+        }
+
+        HttpResponse make_response(Parser &parser)
+        {
+            auto res = parser.get();
+
+            HttpResponse out;
+            out.status = res.result_int();
+
+            for (auto const &h : res.base())
+                out.headers.emplace(h.name_string(), h.value());
+
+            out.body = beast::buffers_to_string(res.body().data());
+            return out;
+        }
+    }
+
+    template <ObserverPolicy Observer>
+    BasicHTTPClient<Observer>::BasicHTTPClient(Observer obs)
+        : m_obs(obs), tcp(std::move(obs)) {}
+
+    template <ObserverPolicy Observer>
+    template <typename Make>
+    void BasicHTTPClient<Observer>::emit(Make &&make)
+    {
+        observe(m_obs, session, std::forward<Make>(make));
+    }
 
-    util::ResultV<void>
-    HTTPClient::emit(const core::Event &e)
+    template <ObserverPolicy Observer>
+    template <typename Make>
+    void BasicHTTPClient<Observer>::emit_record(Make &&make, const core::RecordExtras &extras)
     {
-        return orch.emit(e);
+        observe_record(m_obs, session, std::forward<Make>(make), extras);
     }
 
+    template <ObserverPolicy Observer>
     util::ResultV<HttpResponse>
-    HTTPClient::get(const HttpRequest &cfg)
+    BasicHTTPClient<Observer>::get(const HttpRequest &cfg)
     {
         bool headers_emitted = false;
+        auto t_start = observe_now<Observer>();
+
+        session = cfg.session_id;
+        tcp.set_session(cfg.session_id);
+        tcp.set_tcp_info_interval(
+            platform::time::Duration{cfg.tcp_info_interval_ms});
+        tcp.set_kernel_timestamps(cfg.kernel_timestamps);
+        tcp.set_socket_options(cfg.socket_options);
 
         // 首先建立 TCP 连接 此处复用 TCPClient 的逻辑
         {
@@ -56,34 +187,20 @@ namespace net::http
                 return util::ResultV<HttpResponse>::Err(r.unwrap_err());
         }
 
-        // 上报构建请求事件
-        (void)emit(core::Event::info(
-            core::EventType::HTTP_REQUEST_BUILD,
-            "HTTP GET " + cfg.target));
-
-        // 使用 Boost.Beast 构建 HTTP 请求对象 设置头部信息
-        http::request<http::string_body> req{
-            http::verb::get,
-            cfg.target,
-            11};
-
-        req.set(http::field::host, cfg.host);
-        req.set(http::field::user_agent, "EuNet/0.1");
-        if (cfg.connection_close)
-            req.set(http::field::connection, "close");
-
-        for (auto &[k, v] : cfg.headers)
-            req.set(k, v);
+        Timings timings;
+        timings.dns = tcp.last_connect_timings().dns;
+        timings.connect = tcp.last_connect_timings().connect;
+        auto t_build = observe_now<Observer>();
 
-        req.prepare_payload();
+        // 上报构建请求事件
+        emit_record([]
+                    { return core::make_record(
+                          core::EventType::HTTP_REQUEST_BUILD,
+                          core::MessageId::HttpGet); },
+                    {.text = cfg.target});
 
         // 将请求序列化为文本 并转换为字节数组
-        std::string req_text;
-        {
-            std::ostringstream oss;
-            oss << req;
-            req_text = oss.str();
-        }
+        std::string req_text = build_request_text(cfg);
 
         std::vector<std::byte> send_buf(
             reinterpret_cast<const std::byte *>(req_text.data()),
@@ -103,18 +220,23 @@ namespace net::http
             }
         }
 
+        auto t_sent = observe_now<Observer>();
+        auto t_first = t_sent;
+        timings.request = t_sent - t_build;
+
         // 上报请求已发送事件
-        (void)emit(core::Event::info(
-            core::EventType::HTTP_SENT,
-            "HTTP request sent"));
+        emit_record([]
+                    { return core::make_record(
+                          core::EventType::HTTP_SENT,
+                          core::MessageId::HttpRequestSent); });
 
         // 初始化 HTTP 响应解析器
-        beast::flat_buffer read_buf;
-        http::response_parser<http::dynamic_body> parser;
+        Parser parser;
         parser.body_limit(16 * 1024 * 1024);
 
         // 循环读取数据直到解析完成
         std::vector<std::byte> buf(4096);
+        std::size_t wire = 0;
         while (!parser.is_done())
         {
             // 从 TCP 接收数据到临时缓冲区
@@ -126,56 +248,30 @@ namespace net::http
                 auto n = r.unwrap();
                 if (n == 0)
                     break;
+                if (wire == 0)
+                    t_first = observe_now<Observer>();
+                wire += n;
 
-                auto bytes = boost::asio::buffer(buf.data(), n);
-
-                boost::system::error_code ec;
-                parser.put(bytes, ec);
-
-                // 如果是 "需要更多数据"，则不是错误，继续循环读取即可
-                if (ec == beast::http::error::need_more)
-                {
-                    ec = {}; // 清除错误状态
-                }
+                auto fed = feed(
+                    parser,
+                    boost::asio::buffer(buf.data(), n),
+                    "HTTP parse error");
 
                 // 如果头部解析刚刚完成 上报头部接收事件
                 if (parser.is_header_done() && !headers_emitted)
                 {
-                    const auto &msg = parser.get();
-
-                    std::stringstream ss;
-
-                    // 构造 HTTP 状态行 (e.g., "HTTP/1.1 200 OK")
-                    // msg.version() 返回 11 代表 HTTP/1.1, 10 代表 HTTP/1.0
-                    ss << "HTTP/" << (msg.version() / 10)
-                       << "." << (msg.version() % 10) << " "
-                       << msg.result_int() << " " // 状态码 (200)
-                       << msg.reason() << "\r\n"; // 原因短语 (OK)
-
-                    // 遍历所有 Header 字段
-                    for (auto const &field : msg)
-                    {
-                        ss << field.name_string() << ": "
-                           << field.value() << "\r\n";
-                    }
-
-                    // 发送事件
-                    (void)emit(
-                        core::Event::info(
-                            core::EventType::HTTP_HEADERS_RECEIVED,
-                            ss.str()));
+                    emit([&]
+                         { return core::Event::info(
+                               core::EventType::HTTP_HEADERS_RECEIVED,
+                               describe_headers(parser)); });
                     headers_emitted = true;
                 }
 
                 // 检查解析器错误
-                if (ec)
+                if (fed.is_err())
                 {
                     tcp.close();
-                    return util::ResultV<HttpResponse>::Err(
-                        util::Error::protocol()
-                            .message("HTTP parse error")
-                            .context(ec.message())
-                            .build());
+                    return util::ResultV<HttpResponse>::Err(fed.unwrap_err());
                 }
 
                 if (parser.is_done())
@@ -190,24 +286,12 @@ namespace net::http
 
             if (err.category() == util::ErrorCategory::PeerClosed)
             {
-                // 告知 parser：输入已结束（EOF）
-                boost::system::error_code ec;
-                parser.put(boost::asio::const_buffer{}, ec);
+                auto fed = feed_eof(parser, "HTTP parse error on EOF");
 
-                // 如果是 "需要更多数据"，则不是错误，继续循环读取即可
-                if (ec == beast::http::error::need_more)
-                {
-                    ec = {}; // 清除错误状态
-                }
-
-                if (ec)
+                if (fed.is_err())
                 {
                     tcp.close();
-                    return util::ResultV<HttpResponse>::Err(
-                        util::Error::protocol()
-                            .message("HTTP parse error on EOF")
-                            .context(ec.message())
-                            .build());
+                    return util::ResultV<HttpResponse>::Err(fed.unwrap_err());
                 }
 
                 // 现在 parser 很可能已经 is_done()
@@ -219,21 +303,366 @@ namespace net::http
             return util::ResultV<HttpResponse>::Err(err);
         }
 
+        auto t_done = observe_now<Observer>();
+        timings.ttfb = t_first - t_sent;
+        timings.body = t_done - t_first;
+        timings.total = t_done - t_start;
+
         // 关闭连接
         tcp.close();
 
-        // ---------------- build response ----------------
-        auto res = parser.get();
+        // 构建最终的 HttpResponse 对象返回
+        auto res = make_response(parser);
+        res.wire_size = wire;
+        res.timings = timings;
+        return util::ResultV<HttpResponse>::Ok(std::move(res));
+    }
 
-        HttpResponse out;
-        out.status = res.result_int();
+    template <ObserverPolicy Observer>
+    util::Task<util::ResultV<net::tcp::TCPConnection>>
+    BasicHTTPClient<Observer>::async_open(
+        core::Orchestrator &orch,
+        HttpRequest cfg,
+        platform::reactor::EventLoop &loop,
+        Timings *timings)
+        requires full
+    {
+        using Ret = util::ResultV<net::tcp::TCPConnection>;
+        using util::Error;
+        using core::Event;
+        using core::EventType;
+        using platform::time::monotonic_now;
 
-        for (auto const &h : res.base())
-            out.headers.emplace(h.name_string(), h.value());
+        auto t_dns = monotonic_now();
 
-        out.body = beast::buffers_to_string(res.body().data());
+        auto emit = [&orch, sid = cfg.session_id](Event e)
+        {
+            e.session_id = sid;
+            return orch.emit(std::move(e));
+        };
 
-        // 构建最终的 HttpResponse 对象返回
-        return util::ResultV<HttpResponse>::Ok(std::move(out));
+        // ---------------- DNS ----------------
+        (void)emit(Event::info(
+            EventType::DNS_RESOLVE_START,
+            "Resolving host: " + cfg.host));
+
+        auto resolved = platform::net::DNSResolver::resolve(
+            cfg.host, cfg.port,
+            platform::net::AddressFamily::IPv4);
+
+        if (resolved.is_err())
+        {
+            auto err = resolved.unwrap_err();
+            (void)emit(Event::failure(EventType::DNS_RESOLVE_DONE, err));
+
+            co_return Ret::Err(
+                Error::dns()
+                    .message("DNS resolve failed")
+                    .context("HTTPClient::async_open")
+                    .wrap(err)
+                    .build());
+        }
+
+        auto ep = resolved.unwrap().front();
+        auto t_connect = monotonic_now();
+
+        (void)emit(Event::info(
+            EventType::DNS_RESOLVE_DONE,
+            "Resolved to: " + to_string(ep)));
+
+        // ---------------- connect ----------------
+        (void)emit(Event::info(
+            EventType::TCP_CONNECT_START,
+            fmt::format("Connecting to {}:{} (timeout={}ms)...",
+                        cfg.host, cfg.port, cfg.timeout_ms)));
+
+        auto conn_res = co_await net::tcp::TCPConnection::async_connect(
+            ep, loop, cfg.timeout_ms, cfg.socket_options);
+
+        if (conn_res.is_err())
+        {
+            auto err = conn_res.unwrap_err();
+            (void)emit(Event::failure(
+                err.category() == util::ErrorCategory::Timeout
+                    ? EventType::TCP_CONNECT_TIMEOUT
+                    : EventType::TCP_CONNECT_START,
+                err));
+
+            co_return Ret::Err(
+                Error::transport()
+                    .message("TCP connect failed")
+                    .context("HTTPClient::async_open")
+                    .wrap(err)
+                    .build());
+        }
+
+        if (timings)
+        {
+            timings->dns = t_connect - t_dns;
+            timings->connect = monotonic_now() - t_connect;
+        }
+
+        auto conn = std::move(conn_res.unwrap());
+        auto fd = conn.fd();
+
+        for (const auto &opt : conn.socket().applied_options())
+            (void)emit(Event::info(
+                EventType::SOCKET_OPTION_SET,
+                ::to_string(opt), fd));
+
+        // 推迟的 Fast Open 连接此时尚未发出 SYN 改由 async_request 在握手确认后上报
+        if (!conn.socket().connect_pending())
+            (void)emit(Event::info(
+                EventType::TCP_CONNECT_SUCCESS,
+                "Connection established", fd));
+
+        co_return Ret::Ok(std::move(conn));
+    }
+
+    template <ObserverPolicy Observer>
+    util::Task<util::ResultV<HttpResponse>>
+    BasicHTTPClient<Observer>::async_request(
+        core::Orchestrator &orch,
+        net::tcp::TCPConnection &conn,
+        HttpRequest cfg,
+        platform::reactor::EventLoop &loop)
+        requires full
+    {
+        using Ret = util::ResultV<HttpResponse>;
+        using util::Error;
+        using core::Event;
+        using core::EventType;
+
+        auto emit = [&orch, sid = cfg.session_id](Event e)
+        {
+            e.session_id = sid;
+            return orch.emit(std::move(e));
+        };
+
+        using platform::time::monotonic_now;
+
+        auto fd = conn.fd();
+        auto t_build = monotonic_now();
+
+        // 关闭前统一上报 CONNECTION_CLOSED
+        auto close = [&]
+        {
+            (void)emit(Event::info(
+                EventType::CONNECTION_CLOSED,
+                "Closing connection", fd));
+            conn.close();
+        };
+
+        // ---------------- send ----------------
+        (void)emit(Event::info(
+            EventType::HTTP_REQUEST_BUILD,
+            "HTTP GET " + cfg.target));
+
+        std::string req_text = build_request_text(cfg);
+        auto req_bytes = std::as_bytes(std::span(req_text));
+
+        util::ByteBuffer out(req_bytes.size());
+        out.append(req_bytes);
+
+        // 事件在写入前构造以保留用户态发起时刻
+        auto sent = Event::info(
+            EventType::HTTP_SENT,
+            fmt::format("Sending {} bytes...", req_bytes.size()),
+            fd,
+            std::vector<std::byte>(req_bytes.begin(), req_bytes.end()));
+
+        bool confirm = conn.socket().connect_pending();
+        auto wrote = co_await conn.async_write(out, loop, cfg.timeout_ms);
+        auto t_sent = monotonic_now();
+        auto t_first = t_sent;
+
+        // 推迟的 Fast Open 连接由本次写入发起并确认 连接结果排在 HTTP_SENT 之前上报
+        if (confirm)
+        {
+            if (wrote.is_ok())
+            {
+                auto est = Event::info(
+                    EventType::TCP_CONNECT_SUCCESS,
+                    "Connection established", fd);
+
+                // 请求数据随 SYN 发出 发送时刻不早于连接确认 保持时间线有序
+                if (sent.mono_ns < est.mono_ns)
+                {
+                    sent.mono_ns = est.mono_ns;
+                    sent.ts = est.ts;
+                }
+                (void)emit(std::move(est));
+            }
+            else
+            {
+                auto err = wrote.unwrap_err();
+                (void)emit(Event::failure(
+                    err.category() == util::ErrorCategory::Timeout
+                        ? EventType::TCP_CONNECT_TIMEOUT
+                        : EventType::TCP_CONNECT_START,
+                    err, fd));
+            }
+        }
+        (void)emit(sent);
+
+        if (wrote.is_err())
+        {
+            auto err = wrote.unwrap_err();
+            (void)emit(Event::failure(EventType::HTTP_SENT, err, fd));
+            close();
+
+            co_return Ret::Err(
+                Error::transport()
+                    .message("TCP send failed")
+                    .context("HTTPClient::async_request")
+                    .wrap(err)
+                    .build());
+        }
+
+        // ---------------- receive ----------------
+        Parser parser;
+        parser.body_limit(16 * 1024 * 1024);
+        bool headers_emitted = false;
+        bool peer_closed = false;
+        std::size_t wire = 0;
+
+        util::ByteBuffer in(4096);
+        while (!parser.is_done())
+        {
+            in.clear();
+            auto r = co_await conn.async_read(in, loop, cfg.timeout_ms);
+
+            if (r.is_err())
+            {
+                auto err = r.unwrap_err();
+
+                if (err.category() != util::ErrorCategory::PeerClosed)
+                {
+                    (void)emit(Event::failure(EventType::HTTP_RECEIVED, err, fd));
+                    close();
+                    co_return Ret::Err(err);
+                }
+
+                // 对端关闭 告知解析器输入已结束
+                (void)emit(Event::info(
+                    EventType::CONNECTION_CLOSED,
+                    "Peer closed", fd));
+                peer_closed = true;
+
+                // 复用的连接在发出请求后、收到任何响应前被对端关闭
+                if (!parser.got_some())
+                {
+                    conn.close();
+                    co_return Ret::Err(err);
+                }
+
+                auto fed = feed_eof(parser, "HTTP parse error on EOF");
+                if (fed.is_err())
+                {
+                    conn.close();
+                    co_return Ret::Err(fed.unwrap_err());
+                }
+                break;
+            }
+
+            auto bytes = in.readable();
+            if (bytes.empty())
+                break;
+            if (wire == 0)
+                t_first = monotonic_now();
+            wire += bytes.size();
+
+            (void)emit(Event::info(
+                EventType::HTTP_RECEIVED,
+                fmt::format("Received {} bytes", bytes.size()),
+                fd,
+                std::vector<std::byte>(bytes.begin(), bytes.end())));
+
+            auto fed = feed(
+                parser,
+                boost::asio::buffer(bytes.data(), bytes.size()),
+                "HTTP parse error");
+
+            if (parser.is_header_done() && !headers_emitted)
+            {
+                (void)emit(Event::info(
+                    EventType::HTTP_HEADERS_RECEIVED,
+                    describe_headers(parser), fd));
+                headers_emitted = true;
+            }
+
+            if (fed.is_err())
+            {
+                close();
+                co_return Ret::Err(fed.unwrap_err());
+            }
+        }
+
+        auto t_done = monotonic_now();
+
+        auto res = make_response(parser);
+        res.wire_size = wire;
+        res.timings.request = t_sent - t_build;
+        res.timings.ttfb = t_first - t_sent;
+        res.timings.body = t_done - t_first;
+        res.timings.total = t_done - t_build;
+        res.keep_alive = !peer_closed && !cfg.connection_close &&
+                         parser.is_done() && parser.keep_alive();
+
+        // 不可复用的连接在此关闭；可复用时交还调用方
+        if (peer_closed)
+            conn.close();
+        else if (!res.keep_alive)
+            close();
+
+        co_return Ret::Ok(std::move(res));
     }
+
+    template <ObserverPolicy Observer>
+    util::Task<util::ResultV<HttpResponse>>
+    BasicHTTPClient<Observer>::async_get(
+        core::Orchestrator &orch,
+        HttpRequest cfg,
+        platform::reactor::EventLoop &loop)
+        requires full
+    {
+        using Ret = util::ResultV<HttpResponse>;
+
+        auto t_start = platform::time::monotonic_now();
+        Timings open_timings;
+
+        auto opened = co_await async_open(orch, cfg, loop, &open_timings);
+        if (opened.is_err())
+            co_return Ret::Err(opened.unwrap_err());
+
+        auto conn = std::move(opened.unwrap());
+
+        // 单次请求：无论响应是否允许复用，结束后都关闭连接
+        bool keep = !cfg.connection_close;
+        auto sid = cfg.session_id;
+        auto res = co_await async_request(orch, conn, std::move(cfg), loop);
+
+        if (keep && conn.is_open())
+        {
+            auto closed = core::Event::info(
+                core::EventType::CONNECTION_CLOSED,
+                "Closing connection", conn.fd());
+            closed.session_id = sid;
+            (void)orch.emit(std::move(closed));
+            conn.close();
+        }
+
+        if (res.is_err())
+            co_return Ret::Err(res.unwrap_err());
+
+        auto &out = res.unwrap();
+        out.timings.dns = open_timings.dns;
+        out.timings.connect = open_timings.connect;
+        out.timings.total = platform::time::monotonic_now() - t_start;
+        co_return Ret::Ok(std::move(out));
+    }
+
+    template class BasicHTTPClient<FullObserver>;
+    template class BasicHTTPClient<TimingObserver>;
+    template class BasicHTTPClient<NullObserver>;
 }
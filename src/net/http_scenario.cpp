@@ -21,15 +21,17 @@
 
 namespace net::http
 {
-    void HttpGetScenario::parse_url()
+    HttpConfig parse_http_url(std::string raw)
     {
-        std::string_view url = config_.url;
+        HttpConfig cfg;
+        cfg.url = std::move(raw);
+        std::string_view url = cfg.url;
 
         // ---------------- scheme ----------------
-        config_.scheme = "http";
+        cfg.scheme = "http";
         if (auto pos = url.find("://"); pos != std::string_view::npos)
         {
-            config_.scheme = std::string(url.substr(0, pos));
+            cfg.scheme = std::string(url.substr(0, pos));
             url.remove_prefix(pos + 3);
         }
 
@@ -49,21 +51,27 @@ namespace net::http
         // ---------------- host / port ----------------
         if (auto colon = authority.find(':'); colon != std::string_view::npos)
         {
-            config_.host = std::string(authority.substr(0, colon));
-            config_.port = static_cast<uint16_t>(
+            cfg.host = std::string(authority.substr(0, colon));
+            cfg.port = static_cast<uint16_t>(
                 std::stoi(std::string(authority.substr(colon + 1))));
         }
         else
         {
-            config_.host = std::string(authority);
-            config_.port = (config_.scheme == "https") ? 443 : 80;
+            cfg.host = std::string(authority);
+            cfg.port = (cfg.scheme == "https") ? 443 : 80;
         }
 
         // ---------------- path + query ----------------
         if (auto hash = url.find('#'); hash != std::string_view::npos)
             url = url.substr(0, hash);
 
-        config_.path = url.empty() ? "/" : std::string(url);
+        cfg.path = url.empty() ? "/" : std::string(url);
+        return cfg;
+    }
+
+    void HttpGetScenario::parse_url()
+    {
+        config_ = parse_http_url(std::move(config_.url));
     }
 
     util::ResultV<void>
@@ -71,21 +79,24 @@ namespace net::http
         core::Orchestrator &orch)
     {
         HTTPClient client(orch);
+        auto sid = orch.new_session();
 
         auto res = client.get(
             {.host = config_.host,
              .port = config_.port,
-             .target = config_.path});
+             .target = config_.path,
+             .session_id = sid});
 
         if (res.is_err())
         {
             auto err = res.unwrap_err();
             if (err.category() != util::ErrorCategory::PeerClosed)
             {
-                (void)orch.emit(
-                    core::Event::failure(
-                        core::EventType::CONNECTION_IDLE,
-                        err));
+                auto failed = core::Event::failure(
+                    core::EventType::CONNECTION_IDLE,
+                    err);
+                failed.session_id = sid;
+                (void)orch.emit(std::move(failed));
 
                 return util::ResultV<void>::Err(
                     util::Error::protocol()
@@ -98,4 +109,42 @@ namespace net::http
 
         return util::ResultV<void>::Ok();
     }
-}
\ No newline at end of file
+
+    util::Task<util::ResultV<void>>
+    HttpGetScenario::run_async(
+        core::Orchestrator &orch,
+        platform::reactor::EventLoop &loop)
+    {
+        // 请求先具名构造再传入 避免 co_await 表达式中的聚合临时对象
+        auto sid = orch.new_session();
+        HttpRequest req{
+            .host = config_.host,
+            .port = config_.port,
+            .target = config_.path,
+            .session_id = sid};
+
+        auto res = co_await HTTPClient::async_get(orch, std::move(req), loop);
+
+        if (res.is_err())
+        {
+            auto err = res.unwrap_err();
+            if (err.category() != util::ErrorCategory::PeerClosed)
+            {
+                auto failed = core::Event::failure(
+                    core::EventType::CONNECTION_IDLE,
+                    err);
+                failed.session_id = sid;
+                (void)orch.emit(std::move(failed));
+
+                co_return util::ResultV<void>::Err(
+                    util::Error::protocol()
+                        .message("HTTP GET failed")
+                        .context("HttpGetScenario")
+                        .wrap(err)
+                        .build());
+            }
+        }
+
+        co_return util::ResultV<void>::Ok();
+    }
+}
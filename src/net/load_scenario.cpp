@@ -0,0 +1,271 @@
+/*
+ * ============================================================================
+ *  File Name   : load_scenario.cpp
+ *  Module      : net/http
+ *
+ *  Description :
+ *      LoadScenario 实现。发生器协程按计划时刻逐个派生请求协程，
+ *      落后于计划时立即补发（不跳过），请求完成时以计划时刻为起点记录延迟。
+ *
+ *  Third-Party Dependencies :
+ *      - fmt
+ *          Usage     : 格式化压测报告
+ *          License   : MIT License
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/net/load_scenario.hpp"
+#include "eunet/net/http_client.hpp"
+#include "eunet/platform/awaitable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+
+#include "fmt/format.h"
+
+namespace net::http
+{
+    namespace
+    {
+        std::int64_t to_us(std::chrono::nanoseconds d)
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+        }
+
+        // 发生器挂起等待在途名额的 awaiter，须以纯右值形式 co_await
+        struct WaitSlot
+        {
+            std::coroutine_handle<> &slot;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) noexcept { slot = h; }
+            void await_resume() const noexcept {}
+        };
+
+        std::string format_histogram(const char *name, const util::HdrHistogram &h)
+        {
+            auto ms = [](std::int64_t us)
+            { return static_cast<double>(us) / 1000.0; };
+
+            return fmt::format(
+                "  {:<9}p50 {:.3f}ms  p90 {:.3f}ms  p99 {:.3f}ms  p99.9 {:.3f}ms  p99.99 {:.3f}ms  max {:.3f}ms\n",
+                name,
+                ms(h.value_at_percentile(50)),
+                ms(h.value_at_percentile(90)),
+                ms(h.value_at_percentile(99)),
+                ms(h.value_at_percentile(99.9)),
+                ms(h.value_at_percentile(99.99)),
+                ms(h.max()));
+        }
+    }
+
+    std::string format_report(const LoadReport &r)
+    {
+        std::string out;
+        out += fmt::format(
+            "  Rate     requested {:.1f}/s  achieved {:.1f}/s  completed {:.1f}/s\n",
+            r.requested_rate, r.achieved_rate, r.completion_rate);
+        out += fmt::format(
+            "  Requests sent {}  ok {}  errors {}  (warmup {})\n",
+            r.sent, r.completed, r.errors, r.warmup_sent);
+        out += format_histogram("Latency", r.latency);
+        if (r.errors > 0)
+            out += format_histogram("Errors", r.error_latency);
+        out += format_histogram("Service", r.service);
+        out += format_histogram("SendLag", r.send_lag);
+        out += fmt::format(
+            "  Generator peak in-flight {}  throttled {}  {}\n",
+            r.peak_in_flight, r.throttled,
+            r.saturated ? "SATURATED (results understate load)" : "ok");
+        return out;
+    }
+
+    LoadScenario::LoadScenario(LoadConfig cfg)
+        : m_cfg(std::move(cfg)),
+          m_target(parse_http_url(m_cfg.url))
+    {
+    }
+
+    util::ResultV<void>
+    LoadScenario::run(
+        core::Orchestrator &orch)
+    {
+        using Ret = util::ResultV<void>;
+
+        auto loop_res = platform::reactor::EventLoop::create();
+        if (loop_res.is_err())
+            return Ret::Err(loop_res.unwrap_err());
+        auto loop = std::move(loop_res.unwrap());
+
+        std::optional<Ret> result;
+        util::spawn(run_async(orch, *loop),
+                    [&](Ret r)
+                    { result.emplace(r.is_ok() ? Ret::Ok() : Ret::Err(r.unwrap_err())); });
+
+        while (!result)
+        {
+            auto r = loop->run_once(100);
+            if (r.is_err())
+                return Ret::Err(r.unwrap_err());
+        }
+
+        return result->is_ok() ? Ret::Ok() : Ret::Err(result->unwrap_err());
+    }
+
+    util::Task<util::ResultV<void>>
+    LoadScenario::run_async(
+        core::Orchestrator &orch,
+        platform::reactor::EventLoop &loop)
+    {
+        using Ret = util::ResultV<void>;
+        using namespace std::chrono;
+
+        if (!(m_cfg.rate > 0.0) || m_target.host.empty() || m_cfg.max_in_flight == 0)
+        {
+            co_return Ret::Err(
+                util::Error::config()
+                    .invalid_argument()
+                    .message("Load rate, target host and in-flight limit must be positive")
+                    .context("LoadScenario")
+                    .build());
+        }
+
+        m_report = LoadReport{};
+        m_report.requested_rate = m_cfg.rate;
+        m_in_flight = 0;
+
+        std::mt19937_64 rng(m_cfg.seed);
+        std::exponential_distribution<double> gap(m_cfg.rate);
+
+        auto start = platform::time::monotonic_now();
+        auto warmup_end = start + m_cfg.warmup;
+        auto end = warmup_end + m_cfg.duration;
+
+        // 固定间隔按序号直接换算计划时刻，避免逐次累加造成速率漂移
+        std::uint64_t seq = 0;
+        double offset = 0.0;
+        auto intended = start;
+
+        while (intended < end)
+        {
+            auto now = platform::time::monotonic_now();
+            if (now < intended)
+            {
+                auto slept = co_await platform::reactor::sleep_until(loop, intended);
+                if (slept.is_err())
+                    co_return Ret::Err(slept.unwrap_err());
+                now = platform::time::monotonic_now();
+            }
+
+            if (m_in_flight >= m_cfg.max_in_flight)
+            {
+                // 名额耗尽时推迟发送，推迟的时间仍会计入以计划时刻为起点的延迟
+                ++m_report.throttled;
+                while (m_in_flight >= m_cfg.max_in_flight)
+                    co_await WaitSlot{m_slot_waiter};
+                now = platform::time::monotonic_now();
+            }
+
+            bool measured = intended >= warmup_end;
+            if (measured)
+            {
+                ++m_report.sent;
+                m_report.send_lag.record(to_us(now - intended));
+            }
+            else
+                ++m_report.warmup_sent;
+
+            ++m_in_flight;
+            m_report.peak_in_flight = std::max(m_report.peak_in_flight, m_in_flight);
+            util::spawn(issue(orch, loop, intended, now, measured),
+                        [this, &loop]
+                        { release_slot(loop); });
+
+            ++seq;
+            if (m_cfg.arrival == Arrival::Poisson)
+                offset += gap(rng);
+            else
+                offset = static_cast<double>(seq) / m_cfg.rate;
+            intended = start + nanoseconds(std::llround(offset * 1e9));
+        }
+
+        auto send_done = platform::time::monotonic_now();
+
+        while (m_in_flight > 0)
+            co_await WaitSlot{m_slot_waiter};
+
+        auto finished = platform::time::monotonic_now();
+
+        double steady_s = duration<double>(send_done - warmup_end).count();
+        double complete_s = duration<double>(finished - warmup_end).count();
+        if (steady_s > 0.0)
+            m_report.achieved_rate = static_cast<double>(m_report.sent) / steady_s;
+        if (complete_s > 0.0)
+            m_report.completion_rate = static_cast<double>(m_report.completed) / complete_s;
+
+        // 速率比较以本次实际排定的到达数为准：泊松到达在短时间内本就会
+        // 明显偏离 rate * duration，按名义速率比较会把正常运行误判为饱和
+        double window_s = duration<double>(m_cfg.duration).count();
+        double scheduled_rate = window_s > 0.0 ? static_cast<double>(m_report.sent) / window_s : 0.0;
+
+        // 发送节拍明显落后于计划，说明瓶颈在发生器而不是被测服务
+        m_report.saturated =
+            m_report.throttled > 0 ||
+            m_report.send_lag.value_at_percentile(99) > to_us(m_cfg.lag_threshold) ||
+            m_report.achieved_rate < scheduled_rate * 0.95;
+
+        co_return Ret::Ok();
+    }
+
+    util::Task<void>
+    LoadScenario::issue(
+        core::Orchestrator &orch,
+        platform::reactor::EventLoop &loop,
+        platform::time::MonoPoint intended,
+        platform::time::MonoPoint sent,
+        bool measured)
+    {
+        HttpRequest req;
+        req.host = m_target.host;
+        req.port = m_target.port;
+        req.target = m_target.path;
+        req.timeout_ms = m_cfg.timeout_ms;
+        req.session_id = orch.new_session();
+
+        auto res = co_await HTTPClient::async_get(orch, std::move(req), loop);
+        auto done = platform::time::monotonic_now();
+
+        if (!measured)
+            co_return;
+
+        // 失败与超时往往是最慢的结果 同样计入延迟分布 否则尾部延迟被低估
+        auto latency = to_us(done - intended);
+        m_report.latency.record(latency);
+        m_report.service.record(to_us(done - sent));
+
+        if (res.is_err())
+        {
+            ++m_report.errors;
+            m_report.error_latency.record(latency);
+            co_return;
+        }
+
+        ++m_report.completed;
+    }
+
+    void LoadScenario::release_slot(platform::reactor::EventLoop &loop)
+    {
+        --m_in_flight;
+
+        // 经由 post 恢复发生器，避免在请求协程的收尾过程中嵌套执行
+        if (auto h = std::exchange(m_slot_waiter, {}))
+            loop.post([h]
+                      { h.resume(); });
+    }
+}
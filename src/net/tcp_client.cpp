@@ -6,11 +6,12 @@
  *  Description :
  *      TCP 客户端逻辑实现。串联 DNS 解析 -> 建立 TCP 连接 -> 发送/接收数据
  *      的完整流程，并在每一步产生对应的 Timeline 事件。
+ *      事件均以 lambda 延迟构造，按 Observer 策略决定是否实例化；
+ *      建连与收发路径上报紧凑记录，消息文本由 Sink 需要时再格式化；
+ *      文件末尾显式实例化三种策略。
  *
  *  Third-Party Dependencies :
- *      - fmt
- *          Usage     : 格式化事件日志
- *          License   : MIT License
+ *      None
  *
  *  Author      : 爱特小登队
  *  Created On  : 2026-1-4
@@ -23,38 +24,56 @@
 #include "eunet/platform/net/dns_resolver.hpp"
 #include "eunet/platform/net/endpoint.hpp"
 #include "eunet/util/byte_buffer.hpp"
-#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstring>
 
 namespace net::tcp
 {
     using util::Error;
 
-    TCPClient::TCPClient(core::Orchestrator &o)
-        : orch(o),
+    template <ObserverPolicy Observer>
+    BasicTCPClient<Observer>::BasicTCPClient(Observer obs)
+        : m_obs(std::move(obs)),
           m_poller(platform::poller::Poller::create().unwrap()) {}
 
     // 析构时确保资源释放和事件上报
-    TCPClient::~TCPClient() { close(); }
+    template <ObserverPolicy Observer>
+    BasicTCPClient<Observer>::~BasicTCPClient() { close(); }
+
+    template <ObserverPolicy Observer>
+    template <typename Make>
+    void BasicTCPClient<Observer>::emit_event(Make &&make)
+    {
+        observe(m_obs, m_session, std::forward<Make>(make));
+    }
 
-    util::ResultV<void> TCPClient::emit_event(const core::Event &e)
+    template <ObserverPolicy Observer>
+    template <typename Make>
+    void BasicTCPClient<Observer>::emit_record(Make &&make, const core::RecordExtras &extras)
     {
-        return orch.emit(e);
+        observe_record(m_obs, m_session, std::forward<Make>(make), extras);
     }
 
+    template <ObserverPolicy Observer>
     util::ResultV<void>
-    TCPClient::connect(
+    BasicTCPClient<Observer>::connect(
         const std::string &host,
         uint16_t port,
         int timeout_ms)
     {
         using Ret = util::ResultV<void>;
         using util::Error;
+        flush_pending_sent();
+        m_timings = {};
+        auto t_dns = observe_now<Observer>();
 
         // 上报 DNS 解析开始事件
-        (void)emit_event(
-            core::Event::info(
-                core::EventType::DNS_RESOLVE_START,
-                "Resolving host: " + host));
+        emit_record([]
+                    { return core::make_record(
+                          core::EventType::DNS_RESOLVE_START,
+                          core::MessageId::ResolvingHost); },
+                    {.text = host});
 
         // 调用底层 Resolver 进行域名解析
         auto resolve_res =
@@ -67,10 +86,10 @@ namespace net::tcp
         {
             auto err = resolve_res.unwrap_err();
 
-            (void)emit_event(
-                core::Event::failure(
-                    core::EventType::DNS_RESOLVE_DONE,
-                    err));
+            emit_event([&]
+                       { return core::Event::failure(
+                             core::EventType::DNS_RESOLVE_DONE,
+                             err); });
 
             return Ret::Err(
                 Error::dns()
@@ -80,34 +99,48 @@ namespace net::tcp
                     .build());
         }
 
+        auto t_connect = observe_now<Observer>();
+        m_timings.dns = t_connect - t_dns;
+
         // 获取解析到的第一个 Endpoint
         const auto &ep = resolve_res.unwrap().front();
 
         // 上报 DNS 解析完成事件
-        (void)emit_event(
-            core::Event::info(
-                core::EventType::DNS_RESOLVE_DONE,
-                "Resolved to: " + to_string(ep)));
-
-        // 上报 TCP 连接开始事件
-        (void)emit_event(
-            core::Event::info(
-                core::EventType::TCP_CONNECT_START,
-                fmt::format("Connecting to {}:{} (timeout={}ms)...",
-                            host, port, timeout_ms)));
+        if constexpr (Observer::events)
+        {
+            auto resolved = to_string(ep);
+            emit_record([]
+                        { return core::make_record(
+                              core::EventType::DNS_RESOLVE_DONE,
+                              core::MessageId::ResolvedTo); },
+                        {.text = resolved});
+        }
+
+        // 上报 TCP 连接开始事件 端口与超时作为参数保存 文本延后格式化
+        emit_record([&]
+                    {
+                        auto rec = core::make_record(
+                            core::EventType::TCP_CONNECT_START,
+                            core::MessageId::Connecting);
+                        rec.args[0] = port;
+                        rec.args[1] = static_cast<std::uint64_t>(timeout_ms);
+                        return rec; },
+                    {.text = host});
 
         // 调用底层 TCP Connection 的连接逻辑
-        auto conn_res = TCPConnection::connect(ep, m_poller, timeout_ms);
+        auto conn_res = TCPConnection::connect(ep, m_poller, timeout_ms, m_sock_opts);
 
-        // 检查连接结果 如果失败则上报连接失败事件
+        // 检查连接结果 如果失败则上报连接失败事件 超时单独归为 TCP_CONNECT_TIMEOUT
         if (conn_res.is_err())
         {
             auto err = conn_res.unwrap_err();
 
-            (void)emit_event(
-                core::Event::failure(
-                    core::EventType::TCP_CONNECT_START,
-                    err));
+            emit_event([&]
+                       { return core::Event::failure(
+                             err.category() == util::ErrorCategory::Timeout
+                                 ? core::EventType::TCP_CONNECT_TIMEOUT
+                                 : core::EventType::TCP_CONNECT_START,
+                             err); });
 
             return Ret::Err(
                 Error::transport()
@@ -117,21 +150,55 @@ namespace net::tcp
                     .build());
         }
 
+        m_timings.connect = observe_now<Observer>() - t_connect;
+
         // 保存连接对象所有权
         m_conn.emplace(std::move(conn_res.unwrap()));
 
+        // 记录每个调优选项的应用结果 单项失败不视为会话错误
+        if constexpr (Observer::events)
+        {
+            for (const auto &opt : m_conn->socket().applied_options())
+            {
+                emit_event([&]
+                           { return core::Event::info(
+                                 core::EventType::SOCKET_OPTION_SET,
+                                 ::to_string(opt),
+                                 m_conn->fd()); });
+            }
+        }
+
+        // 按需开启内核软件时间戳 失败时降级为仅用户态时间戳
+        // 时间戳只附在事件上 关闭事件时无需开启
+        if (Observer::events && m_kernel_timestamps)
+        {
+            auto ts_res = m_conn->socket().enable_timestamping();
+            if (ts_res.is_err())
+                m_kernel_timestamps = false;
+        }
+
         // 上报 TCP 连接成功事件 附带分配的 FD
-        (void)emit_event(
-            core::Event::info(
-                core::EventType::TCP_CONNECT_SUCCESS,
-                "Connection established",
-                m_conn->fd()));
+        // 推迟的 Fast Open 连接此时尚未发出 SYN 改由 send() 在握手确认后上报
+        m_connect_pending = m_conn->socket().connect_pending();
+        if (!m_connect_pending)
+        {
+            emit_record([&]
+                        { return core::make_record(
+                              core::EventType::TCP_CONNECT_SUCCESS,
+                              core::MessageId::ConnectionEstablished,
+                              m_conn->fd().fd); });
+        }
+
+        // 开启周期采样时 以建连后的首个样本作为基线
+        m_info_sampler.reset();
+        maybe_sample_tcp_info();
 
         return Ret::Ok();
     }
 
+    template <ObserverPolicy Observer>
     util::ResultV<size_t>
-    TCPClient::send(
+    BasicTCPClient<Observer>::send(
         const std::vector<std::byte> &data,
         int timeout_ms)
     {
@@ -146,33 +213,89 @@ namespace net::tcp
                            .context("TCPClient::send")
                            .build();
 
-            (void)emit_event(
-                core::Event::failure(
-                    core::EventType::HTTP_SENT,
-                    err));
+            emit_event([&]
+                       { return core::Event::failure(
+                             core::EventType::HTTP_SENT,
+                             err); });
 
             return Ret::Err(err);
         }
 
-        (void)emit_event(
-            core::Event::info(
+        // 上一次发送的记录仍在等待回执 先于本次发送上报
+        flush_pending_sent();
+
+        // 记录在写入前构造以保留用户态发起时刻 写入后再附上内核 TX 时间戳上报
+        core::EventRecord sent;
+        if constexpr (Observer::events)
+        {
+            sent = core::make_record(
                 core::EventType::HTTP_SENT,
-                fmt::format("Sending {} bytes...", data.size()),
-                m_conn->fd(),
-                data));
+                core::MessageId::SendingBytes,
+                m_conn->fd().fd);
+            sent.args[0] = data.size();
+        }
 
         util::ByteBuffer buf(data.size());
         buf.append(data);
 
         auto res = m_conn->write(buf, timeout_ms);
+
+        // 推迟的 Fast Open 连接由本次写入发起并确认 连接结果排在 HTTP_SENT 之前上报
+        if (m_connect_pending)
+        {
+            m_connect_pending = false;
+            if (res.is_ok())
+            {
+                std::int64_t established = 0;
+                emit_record([&]
+                            {
+                                auto rec = core::make_record(
+                                    core::EventType::TCP_CONNECT_SUCCESS,
+                                    core::MessageId::ConnectionEstablished,
+                                    m_conn->fd().fd);
+                                established = rec.ts_ns;
+                                return rec; });
+
+                // 请求数据随 SYN 发出 发送时刻不早于连接确认 保持时间线有序
+                sent.ts_ns = std::max(sent.ts_ns, established);
+            }
+            else
+            {
+                auto err = res.unwrap_err();
+                emit_event([&]
+                           { return core::Event::failure(
+                                 err.category() == util::ErrorCategory::Timeout
+                                     ? core::EventType::TCP_CONNECT_TIMEOUT
+                                     : core::EventType::TCP_CONNECT_START,
+                                 err, m_conn->fd()); });
+            }
+        }
+
+        if constexpr (Observer::events)
+        {
+            // 回执尚未到达时暂存记录 其间不再上报其他事件 保持时间线有序
+            if (res.is_ok() && m_kernel_timestamps &&
+                m_conn->socket().tx_timestamping() && !attach_tx_timestamp(sent))
+            {
+                m_pending_sent = sent;
+                m_pending_payload.assign(data.begin(), data.end());
+            }
+            else
+            {
+                emit_record([&]
+                            { return sent; },
+                            {.payload = data});
+            }
+        }
+
         if (res.is_err())
         {
             auto err = res.unwrap_err();
 
-            (void)emit_event(
-                core::Event::failure(
-                    core::EventType::HTTP_SENT,
-                    err, m_conn->fd()));
+            emit_event([&]
+                       { return core::Event::failure(
+                             core::EventType::HTTP_SENT,
+                             err, m_conn->fd()); });
 
             return Ret::Err(
                 Error::transport()
@@ -186,11 +309,12 @@ namespace net::tcp
         if (flush_res.is_err())
         {
             auto err = flush_res.unwrap_err();
+            flush_pending_sent();
 
-            (void)emit_event(
-                core::Event::failure(
-                    core::EventType::HTTP_SENT,
-                    err, m_conn->fd()));
+            emit_event([&]
+                       { return core::Event::failure(
+                             core::EventType::HTTP_SENT,
+                             err, m_conn->fd()); });
 
             return Ret::Err(
                 Error::transport()
@@ -200,11 +324,16 @@ namespace net::tcp
                     .build());
         }
 
+        // 暂存的记录等到回执到达后再上报 周期采样留给之后的 recv
+        if (!m_pending_sent)
+            maybe_sample_tcp_info();
+
         return Ret::Ok(data.size());
     }
 
+    template <ObserverPolicy Observer>
     util::ResultV<size_t>
-    TCPClient::recv(
+    BasicTCPClient<Observer>::recv(
         std::vector<std::byte> &buffer,
         size_t max_size,
         int timeout_ms)
@@ -220,10 +349,10 @@ namespace net::tcp
                            .context("TCPClient::recv")
                            .build();
 
-            (void)emit_event(
-                core::Event::failure(
-                    core::EventType::HTTP_RECEIVED,
-                    err));
+            emit_event([&]
+                       { return core::Event::failure(
+                             core::EventType::HTTP_RECEIVED,
+                             err); });
 
             return Ret::Err(err);
         }
@@ -231,25 +360,29 @@ namespace net::tcp
         util::ByteBuffer buf(max_size);
 
         auto read_res = m_conn->read(buf, timeout_ms);
+
+        // 收到数据时请求必然已离开本机 此时补上发送回执最为可靠
+        flush_pending_sent();
+
         if (read_res.is_err())
         {
             auto err = read_res.unwrap_err();
 
             if (err.category() == util::ErrorCategory::PeerClosed)
             {
-                (void)emit_event(
-                    core::Event::info(
-                        core::EventType::CONNECTION_CLOSED,
-                        "Peer closed",
-                        m_conn->fd()));
+                emit_record([&]
+                            { return core::make_record(
+                                  core::EventType::CONNECTION_CLOSED,
+                                  core::MessageId::PeerClosed,
+                                  m_conn->fd().fd); });
 
                 return Ret::Err(err);
             }
 
-            (void)emit_event(
-                core::Event::failure(
-                    core::EventType::HTTP_RECEIVED,
-                    err, m_conn->fd()));
+            emit_event([&]
+                       { return core::Event::failure(
+                             core::EventType::HTTP_RECEIVED,
+                             err, m_conn->fd()); });
 
             return Ret::Err(
                 Error::transport()
@@ -267,31 +400,162 @@ namespace net::tcp
             buffer.resize(readable.size());
             std::memcpy(buffer.data(), readable.data(), readable.size());
 
-            std::vector<std::byte> received_payload(
-                readable.begin(), readable.end());
-
-            (void)emit_event(
-                core::Event::info(
+            emit_record([&]
+                        {
+                auto received = core::make_record(
                     core::EventType::HTTP_RECEIVED,
-                    fmt::format("Received {} bytes", n),
-                    m_conn->fd(),
-                    received_payload));
+                    core::MessageId::ReceivedBytes,
+                    m_conn->fd().fd);
+                received.args[0] = n;
+
+                // 附上内核收包时间戳 展示每个分块的内核到用户态延迟
+                if (m_kernel_timestamps)
+                {
+                    if (auto rx_ts = m_conn->socket().last_rx_timestamp())
+                    {
+                        received.flags |= core::EventRecord::HAS_KERNEL_TS;
+                        auto anchor = platform::time::WallAnchor::capture();
+                        received.kernel_delay_ns = anchor.from_wall(*rx_ts) - received.ts_ns;
+                    }
+                }
+                return received; },
+                        {.payload = std::span<const std::byte>(buffer.data(), buffer.size())});
+
+            maybe_sample_tcp_info();
         }
 
         return Ret::Ok(n);
     }
 
-    void TCPClient::close() noexcept
+    template <ObserverPolicy Observer>
+    void BasicTCPClient<Observer>::close() noexcept
     {
+        flush_pending_sent();
+
         if (m_conn && m_conn->is_open())
         {
-            (void)emit_event(
-                core::Event::info(
-                    core::EventType::CONNECTION_CLOSED,
-                    "Closing connection",
-                    m_conn->fd()));
+            // 关闭前补充最后一次采样 记录连接最终的重传与 RTT
+            if (Observer::events && m_info_sampler.enabled())
+                (void)sample_tcp_info();
+
+            emit_record([&]
+                        { return core::make_record(
+                              core::EventType::CONNECTION_CLOSED,
+                              core::MessageId::ClosingConnection,
+                              m_conn->fd().fd); });
             m_conn->close();
             m_conn.reset();
         }
     }
+
+    template <ObserverPolicy Observer>
+    void BasicTCPClient<Observer>::set_socket_options(
+        const platform::net::SocketOptions &opts)
+    {
+        m_sock_opts = opts;
+    }
+
+    template <ObserverPolicy Observer>
+    void BasicTCPClient<Observer>::set_kernel_timestamps(bool enable) noexcept
+    {
+        m_kernel_timestamps = enable;
+    }
+
+    template <ObserverPolicy Observer>
+    void BasicTCPClient<Observer>::set_tcp_info_interval(
+        platform::time::Duration interval) noexcept
+    {
+        m_info_sampler.set_interval(interval);
+    }
+
+    template <ObserverPolicy Observer>
+    util::ResultV<platform::net::TcpInfo>
+    BasicTCPClient<Observer>::sample_tcp_info()
+    {
+        using Ret = util::ResultV<platform::net::TcpInfo>;
+        using util::Error;
+
+        if (!m_conn || !m_conn->is_open())
+        {
+            return Ret::Err(
+                Error::state()
+                    .invalid_state()
+                    .message("tcp_info on unconnected")
+                    .context("TCPClient::sample_tcp_info")
+                    .build());
+        }
+
+        auto info_res = m_conn->socket().tcp_info();
+        if (info_res.is_err())
+            return Ret::Err(info_res.unwrap_err());
+
+        auto info = info_res.unwrap();
+        m_info_sampler.mark(info.at);
+
+        flush_pending_sent();
+
+        emit_event([&]
+                   { return core::Event::tcp_sample(info, m_conn->fd()); });
+
+        return Ret::Ok(info);
+    }
+
+    template <ObserverPolicy Observer>
+    void BasicTCPClient<Observer>::maybe_sample_tcp_info()
+    {
+        // 周期采样只为上报事件服务 关闭事件时不产生 getsockopt 调用
+        if constexpr (Observer::events)
+        {
+            if (!m_info_sampler.due(platform::time::monotonic_now()))
+                return;
+
+            (void)sample_tcp_info();
+        }
+    }
+
+    template <ObserverPolicy Observer>
+    bool BasicTCPClient<Observer>::attach_tx_timestamp(core::EventRecord &sent)
+    {
+        if (!m_conn)
+            return false;
+
+        // 回执按 OPT_ID 序号匹配 只会得到本次发送的时间戳
+        auto tx_ts = m_conn->socket().drain_tx_timestamps();
+        if (!tx_ts)
+            return false;
+
+        // 内核时间戳为 CLOCK_REALTIME 以当下重新取的锚点换算到事件时钟 不受长期漂移影响
+        auto anchor = platform::time::WallAnchor::capture();
+        auto delay = anchor.from_wall(*tx_ts) - sent.ts_ns;
+        if (delay >= 0)
+        {
+            sent.flags |= core::EventRecord::HAS_KERNEL_TS;
+            sent.kernel_delay_ns = delay;
+        }
+        return true;
+    }
+
+    template <ObserverPolicy Observer>
+    void BasicTCPClient<Observer>::flush_pending_sent()
+    {
+        if constexpr (Observer::events)
+        {
+            if (!m_pending_sent)
+                return;
+
+            auto sent = *m_pending_sent;
+            m_pending_sent.reset();
+
+            // 此时回执仍未到达则不带内核时间戳上报
+            (void)attach_tx_timestamp(sent);
+            emit_record([&]
+                        { return sent; },
+                        {.payload = m_pending_payload});
+            m_pending_payload.clear();
+        }
+    }
+
+    template class BasicTCPClient<FullObserver>;
+    template class BasicTCPClient<TimingObserver>;
+    template class BasicTCPClient<NullObserver>;
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+/*
+ * ============================================================================
+ *  File Name   : awaitable.cpp
+ *  Module      : platform/reactor
+ *
+ *  Description :
+ *      FdReady 实现。IO 回调与超时定时器先到者生效，
+ *      生效时撤销另一方后再恢复协程，协程恢复后 awaiter 即可能被销毁。
+ *      协程在挂起中被销毁时由析构函数撤销两方；SleepUntil 同样取消定时器。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/platform/awaitable.hpp"
+
+#include <chrono>
+
+namespace platform::reactor
+{
+    FdReady::~FdReady()
+    {
+        if (!m_pending)
+            return;
+
+        // 两方回调都捕获了 this，必须在 awaiter 失效前全部撤销
+        if (m_timer)
+            (void)m_loop.timers().cancel(*m_timer);
+        (void)m_loop.disarm(m_fd);
+    }
+
+    bool FdReady::await_suspend(std::coroutine_handle<> waiter)
+    {
+        m_waiter = waiter;
+
+        auto w = m_loop.arm(
+            m_fd, m_events,
+            [this](std::uint32_t revents)
+            { complete(revents, false); });
+
+        if (w.is_err())
+        {
+            m_error = w.unwrap_err();
+            return false;
+        }
+
+        if (m_timeout_ms >= 0)
+        {
+            auto t = m_loop.timers().schedule_after(
+                std::chrono::milliseconds(m_timeout_ms),
+                [this]
+                { complete(0, true); });
+
+            if (t.is_err())
+            {
+                (void)m_loop.disarm(m_fd);
+                m_error = t.unwrap_err();
+                return false;
+            }
+            m_timer = t.unwrap();
+        }
+
+        m_pending = true;
+        return true;
+    }
+
+    util::ResultV<std::uint32_t> FdReady::await_resume()
+    {
+        using Ret = util::ResultV<std::uint32_t>;
+
+        if (m_error)
+            return Ret::Err(*m_error);
+        return Ret::Ok(m_revents);
+    }
+
+    void FdReady::complete(std::uint32_t revents, bool timed_out)
+    {
+        // 先撤销另一方再恢复：协程恢复后可能立即在同一 fd 上重新等待
+        // IO 就绪时单次关注已由内核停用，无需系统调用
+        if (timed_out)
+        {
+            (void)m_loop.disarm(m_fd);
+            m_error = util::Error::transport()
+                          .timeout()
+                          .transient()
+                          .message("Wait for socket events timed out")
+                          .context("FdReady")
+                          .build();
+        }
+        else if (m_timer)
+            (void)m_loop.timers().cancel(*m_timer);
+
+        m_revents = revents;
+        m_pending = false;
+
+        // 之后不得再访问 this
+        auto waiter = m_waiter;
+        waiter.resume();
+    }
+
+    bool SleepUntil::await_ready() const noexcept
+    {
+        return platform::time::monotonic_now() >= m_deadline;
+    }
+
+    SleepUntil::~SleepUntil()
+    {
+        if (m_timer)
+            (void)m_loop.timers().cancel(*m_timer);
+    }
+
+    bool SleepUntil::await_suspend(std::coroutine_handle<> waiter)
+    {
+        auto t = m_loop.timers().schedule(
+            m_deadline,
+            [this, waiter]
+            {
+                m_timer.reset();
+                waiter.resume();
+            });
+
+        if (t.is_err())
+        {
+            m_error = t.unwrap_err();
+            return false;
+        }
+        m_timer = t.unwrap();
+        return true;
+    }
+
+    util::ResultV<void> SleepUntil::await_resume()
+    {
+        if (m_error)
+            return util::ResultV<void>::Err(*m_error);
+        return util::ResultV<void>::Ok();
+    }
+}
@@ -20,7 +20,14 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <algorithm>
+#include <chrono>
 #include <utility>
+#include <cstring>
+#include <sys/socket.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <netinet/in.h>
 
 namespace platform::net
 {
@@ -96,6 +103,271 @@ namespace platform::net
                 static_cast<socklen_t>(len)));
     }
 
+    util::ResultV<void>
+    BaseSocket::set_nonblocking(bool enable)
+    {
+        using Result = util::ResultV<void>;
+        using util::Error;
+
+        int flags = ::fcntl(view().fd, F_GETFL);
+        if (flags >= 0)
+        {
+            int next = enable ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+            if (next == flags || ::fcntl(view().fd, F_SETFL, next) == 0)
+                return Result::Ok();
+        }
+
+        int err_no = errno;
+        return Result::Err(
+            Error::system()
+                .code(err_no)
+                .set_category(from_errno(err_no))
+                .message("Failed to toggle O_NONBLOCK")
+                .context("fcntl")
+                .build());
+    }
+
+    namespace
+    {
+        // 错误队列消息附带的扩展错误，时间戳回执的 ee_data 即 OPT_ID 序号
+        std::optional<std::uint32_t>
+        parse_timestamping_id(msghdr &msg) noexcept
+        {
+            for (cmsghdr *c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c))
+            {
+                bool recverr =
+                    (c->cmsg_level == SOL_IP && c->cmsg_type == IP_RECVERR) ||
+                    (c->cmsg_level == SOL_IPV6 && c->cmsg_type == IPV6_RECVERR);
+                if (!recverr)
+                    continue;
+
+                sock_extended_err ee;
+                std::memcpy(&ee, CMSG_DATA(c), sizeof(ee));
+                if (ee.ee_errno == ENOMSG &&
+                    ee.ee_origin == SO_EE_ORIGIN_TIMESTAMPING)
+                    return ee.ee_data;
+            }
+            return std::nullopt;
+        }
+
+        // scm_timestamping 由三个 timespec 组成，ts[0] 为软件时间戳
+        std::optional<time::WallPoint>
+        parse_timestamping_cmsg(msghdr &msg) noexcept
+        {
+            for (cmsghdr *c = CMSG_FIRSTHDR(&msg); c; c = CMSG_NXTHDR(&msg, c))
+            {
+                if (c->cmsg_level != SOL_SOCKET ||
+                    c->cmsg_type != SO_TIMESTAMPING)
+                    continue;
+
+                timespec ts[3];
+                std::memcpy(ts, CMSG_DATA(c), sizeof(ts));
+                if (ts[0].tv_sec == 0 && ts[0].tv_nsec == 0)
+                    continue;
+
+                auto since_epoch =
+                    std::chrono::seconds(ts[0].tv_sec) +
+                    std::chrono::nanoseconds(ts[0].tv_nsec);
+                return time::WallPoint(
+                    std::chrono::duration_cast<time::WallClock::duration>(
+                        since_epoch));
+            }
+            return std::nullopt;
+        }
+
+        constexpr size_t TIMESTAMP_CMSG_SPACE = 256;
+    }
+
+    util::ResultV<void>
+    BaseSocket::enable_timestamping()
+    {
+        using Result = util::ResultV<void>;
+        using util::Error;
+
+        int flags =
+            SOF_TIMESTAMPING_SOFTWARE |
+            SOF_TIMESTAMPING_RX_SOFTWARE |
+            SOF_TIMESTAMPING_TX_SOFTWARE |
+            SOF_TIMESTAMPING_OPT_TSONLY;
+
+        int type = 0;
+        socklen_t type_len = sizeof(type);
+        (void)::getsockopt(view().fd, SOL_SOCKET, SO_TYPE, &type, &type_len);
+
+        // 先带 OPT_ID 开启 以序号匹配回执；未连接的 TCP 套接字会拒绝 此时只保留 RX 时间戳
+        int with_ids = flags | SOF_TIMESTAMPING_OPT_ID;
+        bool ids = ::setsockopt(
+                       view().fd,
+                       SOL_SOCKET,
+                       SO_TIMESTAMPING,
+                       &with_ids,
+                       sizeof(with_ids)) == 0;
+
+        if (!ids &&
+            ::setsockopt(
+                view().fd,
+                SOL_SOCKET,
+                SO_TIMESTAMPING,
+                &flags,
+                sizeof(flags)) < 0)
+        {
+            int err_no = errno;
+            return Result::Err(
+                Error::system()
+                    .code(err_no)
+                    .set_category(from_errno(err_no))
+                    .message("Failed to enable software timestamping")
+                    .context("setsockopt(SO_TIMESTAMPING)")
+                    .build());
+        }
+
+        m_timestamping = true;
+        m_tx_ids = ids;
+        m_tx_stream = type == SOCK_STREAM;
+        m_tx_count = 0;
+        m_tx_key.reset();
+        m_last_tx_ts.reset();
+        return Result::Ok();
+    }
+
+    std::optional<time::WallPoint>
+    BaseSocket::drain_tx_timestamps() noexcept
+    {
+        (void)drain_error_queue();
+        return m_last_tx_ts;
+    }
+
+    std::size_t
+    BaseSocket::drain_error_queue() noexcept
+    {
+        if (!m_timestamping)
+            return 0;
+
+        std::size_t drained = 0;
+
+        // 错误队列中可能堆积多条发送回执 全部取出 只保留与最近一次发送序号相符的
+        for (;;)
+        {
+            char control[TIMESTAMP_CMSG_SPACE];
+            char dummy[1];
+            iovec iov{dummy, sizeof(dummy)};
+
+            msghdr msg{};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+
+            ssize_t n = ::recvmsg(
+                view().fd, &msg,
+                MSG_ERRQUEUE | MSG_DONTWAIT);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+            ++drained;
+
+            if (!m_tx_ids || !m_tx_key)
+                continue;
+
+            auto id = parse_timestamping_id(msg);
+            if (!id || *id != *m_tx_key)
+                continue;
+
+            if (auto ts = parse_timestamping_cmsg(msg))
+                m_last_tx_ts = ts;
+        }
+
+        return drained;
+    }
+
+    void
+    BaseSocket::note_tx(size_t bytes) noexcept
+    {
+        if (!m_timestamping)
+            return;
+
+        // 本次发送的回执可能在 send 返回前就已入队 先推进序号再收取
+        // 队列中之前发送的迟到回执序号不符 随之丢弃
+        if (m_tx_stream)
+        {
+            // TCP 回执序号为本次发送最后一个字节相对开启时的偏移
+            m_tx_count += static_cast<std::uint32_t>(bytes);
+            m_tx_key = m_tx_count - 1;
+        }
+        else
+            m_tx_key = m_tx_count++;
+
+        m_last_tx_ts.reset();
+        (void)drain_error_queue();
+    }
+
+    util::ResultV<void>
+    BaseSocket::wait_ready(std::uint32_t events, int timeout_ms)
+    {
+        using Ret = util::ResultV<void>;
+
+        if (!m_timestamping)
+            return wait_fd_epoll(m_poller, view(), events, timeout_ms);
+
+        auto deadline = time::monotonic_now() + std::chrono::milliseconds(timeout_ms);
+        for (;;)
+        {
+            (void)drain_error_queue();
+
+            int remaining = timeout_ms;
+            if (timeout_ms >= 0)
+            {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - time::monotonic_now());
+                remaining = static_cast<int>(std::max<std::int64_t>(left.count(), 0));
+            }
+
+            auto w = wait_fd_epoll(m_poller, view(), events, remaining);
+            if (w.is_ok())
+                return Ret::Ok();
+
+            auto err = w.unwrap_err();
+            if (err.category() == util::ErrorCategory::Timeout)
+                return Ret::Err(err);
+
+            // EPOLLERR 来自发送回执而非套接字错误时 收取后继续等待
+            int so_error = 0;
+            socklen_t len = sizeof(so_error);
+            if (drain_error_queue() == 0 ||
+                ::getsockopt(view().fd, SOL_SOCKET, SO_ERROR, &so_error, &len) < 0 ||
+                so_error != 0)
+                return Ret::Err(err);
+        }
+    }
+
+    ssize_t
+    BaseSocket::recv_stamped(
+        void *data,
+        size_t len,
+        int flags) noexcept
+    {
+        if (!m_timestamping)
+            return ::recv(view().fd, data, len, flags);
+
+        char control[TIMESTAMP_CMSG_SPACE];
+        iovec iov{data, len};
+
+        msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        ssize_t n = ::recvmsg(view().fd, &msg, flags);
+        if (n > 0)
+            m_last_rx_ts = parse_timestamping_cmsg(msg);
+
+        return n;
+    }
+
     util::ResultV<void>
     wait_fd_epoll(
         poller::Poller &poller,
@@ -0,0 +1,337 @@
+/*
+ * ============================================================================
+ *  File Name   : event_loop.cpp
+ *  Module      : platform/reactor
+ *
+ *  Description :
+ *      EventLoop 与 eventfd 唤醒器实现。跨线程投递通过 m_wake_pending 合并唤醒，
+ *      reactor 每轮先清除标志再取任务，保证不会漏掉任何已入队的任务。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/platform/event_loop.hpp"
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+
+namespace platform::reactor
+{
+    util::ResultV<Wakeup> Wakeup::create()
+    {
+        using Ret = util::ResultV<Wakeup>;
+        using util::Error;
+
+        platform::fd::Fd fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+        if (!fd.valid())
+        {
+            int err_no = errno;
+            return Ret::Err(
+                Error::system()
+                    .code(err_no)
+                    .set_category(from_errno(err_no))
+                    .message("Failed to create eventfd")
+                    .context("eventfd")
+                    .build());
+        }
+
+        return Ret::Ok(Wakeup(std::move(fd)));
+    }
+
+    void Wakeup::notify() noexcept
+    {
+        std::uint64_t one = 1;
+        ssize_t n;
+        do
+        {
+            n = ::write(m_fd.get(), &one, sizeof(one));
+        } while (n < 0 && errno == EINTR);
+        // EAGAIN 表示计数已接近上限，reactor 必然处于可读状态，可以忽略
+    }
+
+    std::uint64_t Wakeup::drain() noexcept
+    {
+        std::uint64_t count = 0;
+        ssize_t n;
+        do
+        {
+            n = ::read(m_fd.get(), &count, sizeof(count));
+        } while (n < 0 && errno == EINTR);
+        return n == sizeof(count) ? count : 0;
+    }
+
+    util::ResultV<std::unique_ptr<EventLoop>>
+    EventLoop::create(std::size_t max_events)
+    {
+        using Ret = util::ResultV<std::unique_ptr<EventLoop>>;
+
+        auto poller = platform::poller::Poller::create();
+        if (poller.is_err())
+            return Ret::Err(poller.unwrap_err());
+
+        auto timers = platform::timer::TimerService::create();
+        if (timers.is_err())
+            return Ret::Err(timers.unwrap_err());
+
+        auto wakeup = Wakeup::create();
+        if (wakeup.is_err())
+            return Ret::Err(wakeup.unwrap_err());
+
+        std::unique_ptr<EventLoop> loop(
+            new EventLoop(
+                std::move(poller.unwrap()),
+                std::move(timers.unwrap()),
+                std::move(wakeup.unwrap()),
+                max_events));
+
+        auto read = static_cast<std::uint32_t>(platform::poller::PollEventType::Read);
+
+        auto r = loop->m_poller.add(loop->m_wakeup.fd(), read, &loop->m_wake_tag);
+        if (r.is_err())
+            return Ret::Err(r.unwrap_err());
+
+        r = loop->m_timers.attach(loop->m_poller, &loop->m_timer_tag);
+        if (r.is_err())
+            return Ret::Err(r.unwrap_err());
+
+        return Ret::Ok(std::move(loop));
+    }
+
+    EventLoop::EventLoop(
+        platform::poller::Poller poller,
+        platform::timer::TimerService timers,
+        Wakeup wakeup,
+        std::size_t max_events)
+        : m_poller(std::move(poller)),
+          m_timers(std::move(timers)),
+          m_wakeup(std::move(wakeup)),
+          m_events(max_events) {}
+
+    void EventLoop::post(Task fn)
+    {
+        m_tasks.push(std::move(fn));
+        m_stats.posted.fetch_add(1, std::memory_order_relaxed);
+
+        // reactor 已被唤醒但尚未取任务时，无需再次写 eventfd；
+        // 先读后交换，避免高并发投递时反复争抢同一缓存行
+        if (!m_wake_pending.load() && !m_wake_pending.exchange(true))
+        {
+            m_wakeup.notify();
+            m_stats.wakeups.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void EventLoop::dispatch(Task fn)
+    {
+        if (in_loop_thread())
+        {
+            fn();
+            m_stats.executed.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        post(std::move(fn));
+    }
+
+    void EventLoop::stop()
+    {
+        m_stop.store(true, std::memory_order_release);
+        if (!m_wake_pending.exchange(true))
+            m_wakeup.notify();
+    }
+
+    bool EventLoop::in_loop_thread() const noexcept
+    {
+        return m_owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+    }
+
+    util::ResultV<void> EventLoop::run()
+    {
+        using Ret = util::ResultV<void>;
+
+        m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        while (!stopped())
+        {
+            auto r = run_once(-1);
+            if (r.is_err())
+                return Ret::Err(r.unwrap_err());
+        }
+
+        // 允许再次 run()
+        m_stop.store(false, std::memory_order_release);
+        return Ret::Ok();
+    }
+
+    util::ResultV<std::size_t> EventLoop::run_once(int timeout_ms)
+    {
+        using Ret = util::ResultV<std::size_t>;
+
+        if (m_owner.load(std::memory_order_relaxed) == std::thread::id{})
+            m_owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+        auto w = m_poller.wait(m_events, timeout_ms);
+        if (w.is_err())
+            return Ret::Err(w.unwrap_err());
+
+        std::size_t handled = 0;
+        bool woken = false;
+
+        for (std::size_t i = 0; i < m_events.size(); ++i)
+        {
+            void *data = m_events.data(i);
+
+            if (data == &m_wake_tag)
+            {
+                woken = true;
+                continue;
+            }
+
+            if (data == &m_timer_tag)
+            {
+                auto fired = m_timers.dispatch();
+                if (fired.is_err())
+                    return Ret::Err(fired.unwrap_err());
+                handled += fired.unwrap();
+                continue;
+            }
+
+            auto *watch = static_cast<IoWatch *>(data);
+            if (watch->fd < 0 || !watch->cb)
+                continue; // 本轮中已被 unwatch 或 disarm
+
+            if (watch->oneshot)
+            {
+                // 先取走回调：回调中可能立即对同一 fd 重新 arm
+                auto cb = std::move(watch->cb);
+                watch->cb = nullptr;
+                cb(m_events.events(i));
+            }
+            else
+                watch->cb(m_events.events(i));
+            ++handled;
+        }
+
+        if (woken)
+        {
+            // 先清除标志再取任务：此后入队的任务要么被本轮取到，要么会重新唤醒
+            m_wakeup.drain();
+            m_wake_pending.store(false);
+            handled += run_tasks();
+        }
+
+        m_retired.clear();
+        m_stats.iterations.fetch_add(1, std::memory_order_relaxed);
+        return Ret::Ok(handled);
+    }
+
+    std::size_t EventLoop::run_tasks()
+    {
+        std::size_t n = m_tasks.pop_all(
+            [](Task &&fn)
+            { fn(); },
+            TASK_BATCH);
+        m_stats.executed.fetch_add(n, std::memory_order_relaxed);
+
+        // 单轮只执行一批，剩余任务留到下一轮，避免饿死 IO
+        if (!m_tasks.empty() && !m_wake_pending.exchange(true))
+            m_wakeup.notify();
+
+        return n;
+    }
+
+    util::ResultV<void>
+    EventLoop::watch(
+        platform::fd::FdView fd,
+        std::uint32_t events,
+        IoCallback cb)
+    {
+        using Ret = util::ResultV<void>;
+
+        auto it = m_watches.find(fd.fd);
+        if (it != m_watches.end())
+        {
+            auto r = m_poller.add(fd, events, it->second.get());
+            if (r.is_err())
+                return Ret::Err(r.unwrap_err());
+            it->second->cb = std::move(cb);
+            it->second->oneshot = false;
+            return Ret::Ok();
+        }
+
+        auto w = std::make_unique<IoWatch>(IoWatch{fd.fd, std::move(cb)});
+        auto r = m_poller.add(fd, events, w.get());
+        if (r.is_err())
+            return Ret::Err(r.unwrap_err());
+
+        m_watches.emplace(fd.fd, std::move(w));
+        return Ret::Ok();
+    }
+
+    util::ResultV<void> EventLoop::unwatch(platform::fd::FdView fd)
+    {
+        using Ret = util::ResultV<void>;
+
+        auto it = m_watches.find(fd.fd);
+        if (it == m_watches.end())
+            return Ret::Ok();
+
+        auto r = m_poller.remove(fd);
+
+        // 同一轮中可能还有该 fd 的就绪事件，延后到本轮结束再释放
+        it->second->fd = -1;
+        m_retired.push_back(std::move(it->second));
+        m_watches.erase(it);
+
+        if (r.is_err())
+            return Ret::Err(r.unwrap_err());
+        return Ret::Ok();
+    }
+
+    util::ResultV<void>
+    EventLoop::arm(
+        platform::fd::FdView fd,
+        std::uint32_t events,
+        IoCallback cb)
+    {
+        using Ret = util::ResultV<void>;
+
+        auto it = m_watches.find(fd.fd);
+        if (it == m_watches.end())
+        {
+            auto w = std::make_unique<IoWatch>(IoWatch{fd.fd, nullptr, true});
+            auto r = m_poller.add(fd, events | EPOLLONESHOT, w.get());
+            if (r.is_err())
+                return Ret::Err(r.unwrap_err());
+
+            it = m_watches.emplace(fd.fd, std::move(w)).first;
+        }
+        else
+        {
+            auto r = m_poller.rearm(fd, events | EPOLLONESHOT);
+            if (r.is_err())
+                return Ret::Err(r.unwrap_err());
+            it->second->oneshot = true;
+        }
+
+        it->second->cb = std::move(cb);
+        return Ret::Ok();
+    }
+
+    util::ResultV<void> EventLoop::disarm(platform::fd::FdView fd)
+    {
+        auto it = m_watches.find(fd.fd);
+        if (it == m_watches.end())
+            return util::ResultV<void>::Ok();
+
+        // 掩码只留 EPOLLONESHOT：ERR / HUP 至多再报一次，且因回调为空被忽略
+        it->second->cb = nullptr;
+        return m_poller.rearm(fd, EPOLLONESHOT);
+    }
+}
@@ -0,0 +1,128 @@
+/*
+ * ============================================================================
+ *  File Name   : socket_options.cpp
+ *  Module      : platform/net
+ *
+ *  Description :
+ *      套接字调优配置实现。逐项调用 setsockopt，并把每个选项的结果
+ *      整理成 AppliedSocketOption 记录。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/platform/net/socket_options.hpp"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <cerrno>
+
+#ifndef TCP_FASTOPEN_CONNECT
+#define TCP_FASTOPEN_CONNECT 30
+#endif
+
+namespace platform::net
+{
+    namespace
+    {
+        AppliedSocketOption set_int_option(
+            fd::FdView fd,
+            int level,
+            int optname,
+            const char *name,
+            int value,
+            SocketOptionStage stage)
+        {
+            AppliedSocketOption rec{name, value, stage};
+
+            if (::setsockopt(fd.fd, level, optname, &value, sizeof(value)) < 0)
+            {
+                int err_no = errno;
+                rec.error = util::Error::system()
+                                .code(err_no)
+                                .set_category(from_errno(err_no))
+                                .message("Failed to set socket option")
+                                .context(std::string("setsockopt(") + name + ")")
+                                .build();
+            }
+
+            return rec;
+        }
+    }
+
+    AppliedSocketOptions apply_socket_options(
+        fd::FdView fd,
+        const SocketOptions &opts,
+        SocketOptionStage stage)
+    {
+        AppliedSocketOptions out;
+
+        if (stage == SocketOptionStage::Create)
+        {
+            if (opts.tcp_nodelay)
+                out.push_back(set_int_option(
+                    fd, IPPROTO_TCP, TCP_NODELAY, "TCP_NODELAY",
+                    *opts.tcp_nodelay ? 1 : 0, stage));
+
+            if (opts.keepalive)
+                out.push_back(set_int_option(
+                    fd, SOL_SOCKET, SO_KEEPALIVE, "SO_KEEPALIVE",
+                    *opts.keepalive ? 1 : 0, stage));
+
+            // 缓冲区需要在 connect 之前设置才能影响窗口缩放协商
+            if (opts.send_buffer)
+                out.push_back(set_int_option(
+                    fd, SOL_SOCKET, SO_SNDBUF, "SO_SNDBUF",
+                    *opts.send_buffer, stage));
+
+            if (opts.recv_buffer)
+                out.push_back(set_int_option(
+                    fd, SOL_SOCKET, SO_RCVBUF, "SO_RCVBUF",
+                    *opts.recv_buffer, stage));
+
+            if (opts.fastopen)
+                out.push_back(set_int_option(
+                    fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, "TCP_FASTOPEN_CONNECT",
+                    1, stage));
+        }
+        else
+        {
+            // QUICKACK 不是持久选项 连接建立后设置才有意义
+            if (opts.tcp_quickack)
+                out.push_back(set_int_option(
+                    fd, IPPROTO_TCP, TCP_QUICKACK, "TCP_QUICKACK",
+                    *opts.tcp_quickack ? 1 : 0, stage));
+        }
+
+        return out;
+    }
+}
+
+std::string to_string(platform::net::SocketOptionStage stage)
+{
+    using platform::net::SocketOptionStage;
+    switch (stage)
+    {
+    case SocketOptionStage::Create:
+        return "create";
+    case SocketOptionStage::Connect:
+        return "connect";
+    default:
+        return "unknown";
+    }
+}
+
+std::string to_string(const platform::net::AppliedSocketOption &opt)
+{
+    std::string s = opt.name + "=" + std::to_string(opt.value) +
+                    " (" + to_string(opt.stage) + ")";
+    if (opt.error)
+        s += " failed: " + opt.error->message();
+    return s;
+}
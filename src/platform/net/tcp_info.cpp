@@ -0,0 +1,98 @@
+/*
+ * ============================================================================
+ *  File Name   : tcp_info.cpp
+ *  Module      : platform/net
+ *
+ *  Description :
+ *      TCP_INFO 采样实现。使用 linux/tcp.h 中的完整 tcp_info 结构体，
+ *      以便读取 glibc 版本中缺失的 tcpi_delivery_rate 字段。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/platform/net/tcp_info.hpp"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <linux/tcp.h>
+#include <cerrno>
+#include <cstddef>
+#include <sstream>
+
+namespace platform::net
+{
+    util::ResultV<TcpInfo> query_tcp_info(fd::FdView fd)
+    {
+        using Ret = util::ResultV<TcpInfo>;
+        using util::Error;
+
+        struct tcp_info raw{};
+        socklen_t len = sizeof(raw);
+
+        if (::getsockopt(fd.fd, IPPROTO_TCP, TCP_INFO, &raw, &len) < 0)
+        {
+            int err_no = errno;
+            return Ret::Err(
+                Error::system()
+                    .code(err_no)
+                    .set_category(from_errno(err_no))
+                    .message("Failed to query TCP_INFO")
+                    .context("getsockopt(TCP_INFO)")
+                    .build());
+        }
+
+        TcpInfo info;
+        info.state = raw.tcpi_state;
+        info.rtt_us = raw.tcpi_rtt;
+        info.rttvar_us = raw.tcpi_rttvar;
+        info.snd_cwnd = raw.tcpi_snd_cwnd;
+        info.snd_mss = raw.tcpi_snd_mss;
+        info.retransmits = raw.tcpi_retransmits;
+        info.total_retrans = raw.tcpi_total_retrans;
+        info.lost = raw.tcpi_lost;
+        info.unacked = raw.tcpi_unacked;
+
+        // 内核按实际长度截断返回，旧内核不包含 delivery_rate
+        constexpr auto rate_end =
+            offsetof(struct tcp_info, tcpi_delivery_rate) +
+            sizeof(raw.tcpi_delivery_rate);
+        if (len >= rate_end)
+            info.delivery_rate = raw.tcpi_delivery_rate;
+
+        info.at = platform::time::monotonic_now();
+        return Ret::Ok(info);
+    }
+
+    bool TcpInfoSampler::due(platform::time::MonoPoint now) const noexcept
+    {
+        if (!enabled())
+            return false;
+        if (!m_sampled)
+            return true;
+        return now - m_last >= m_interval;
+    }
+
+    void TcpInfoSampler::mark(platform::time::MonoPoint now) noexcept
+    {
+        m_last = now;
+        m_sampled = true;
+    }
+}
+
+std::string to_string(const platform::net::TcpInfo &info)
+{
+    std::ostringstream oss;
+    oss << "rtt=" << info.rtt_us << "us"
+        << " rttvar=" << info.rttvar_us << "us"
+        << " cwnd=" << info.snd_cwnd
+        << " retrans=" << info.total_retrans
+        << " unacked=" << info.unacked
+        << " rate=" << info.delivery_rate << "B/s";
+    return oss.str();
+}
@@ -45,10 +45,18 @@ namespace platform::poller
     }
 
     Poller::Poller()
-        : epoll_fd(::epoll_create1(EPOLL_CLOEXEC)) {}
+        : epoll_fd(::epoll_create1(EPOLL_CLOEXEC)),
+          scratch(DEFAULT_MAX_EVENTS) {}
 
     Poller::Poller(Poller &&other) noexcept
-        : epoll_fd(std::move(other.epoll_fd)) {}
+        : epoll_fd(std::move(other.epoll_fd)),
+          fd_table(std::move(other.fd_table)),
+          registered(other.registered),
+          data_fds(std::move(other.data_fds)),
+          scratch(std::move(other.scratch))
+    {
+        other.registered = 0;
+    }
 
     Poller &Poller::operator=(Poller &&other) noexcept
     {
@@ -56,6 +64,11 @@ namespace platform::poller
             return *this;
 
         epoll_fd = std::move(other.epoll_fd);
+        fd_table = std::move(other.fd_table);
+        registered = other.registered;
+        data_fds = std::move(other.data_fds);
+        scratch = std::move(other.scratch);
+        other.registered = 0;
         return *this;
     }
 
@@ -64,49 +77,112 @@ namespace platform::poller
     platform::fd::Fd &Poller::get_fd() noexcept { return epoll_fd; }
     const platform::fd::Fd &Poller::get_fd() const noexcept { return epoll_fd; }
 
-    bool Poller::has_fd(int fd) const noexcept { return fd_table.count(fd); }
+    bool Poller::has_fd(int fd) const noexcept { return registration(fd) != nullptr; }
 
-    util::ResultV<void>
-    Poller::add(
-        platform::fd::FdView fd,
-        std::uint32_t events) noexcept
+    const Poller::Registration *Poller::registration(int fd) const noexcept
     {
-        if (has_fd(fd.fd))
-            return modify(fd, events);
-        fd_table.emplace(fd.fd);
+        if (fd < 0 || static_cast<std::size_t>(fd) >= fd_table.size())
+            return nullptr;
+        const auto &reg = fd_table[fd];
+        return reg.active ? &reg : nullptr;
+    }
+
+    void Poller::set_max_events(std::size_t n)
+    {
+        scratch.resize(n == 0 ? 1 : n);
+    }
+
+    void Poller::store(int fd, const Registration &reg)
+    {
+        auto &slot = fd_table[fd];
+        if (slot.active && slot.data && slot.data != reg.data)
+            forget(fd);
+        if (reg.data)
+            data_fds[reg.data] = fd;
+
+        slot = reg;
+        slot.active = true;
+    }
+
+    void Poller::forget(int fd) noexcept
+    {
+        auto it = data_fds.find(fd_table[fd].data);
+        if (it != data_fds.end() && it->second == fd)
+            data_fds.erase(it);
+    }
 
+    util::ResultV<void> Poller::not_initialized() const noexcept
+    {
+        return util::ResultV<void>::Err(
+            util::Error::internal()
+                .invalid_argument()
+                .message("Poller is not initialized")
+                .build());
+    }
+
+    util::ResultV<void>
+    Poller::ctl(
+        int op, int fd,
+        const Registration &reg,
+        const char *context) noexcept
+    {
         using Ret = util::ResultV<void>;
         using util::Error;
 
-        if (!valid())
+        epoll_event ev{};
+        ev.events = reg.events;
+        if (reg.data)
+            ev.data.ptr = reg.data;
+        else
+            ev.data.fd = fd;
+
+        if (::epoll_ctl(epoll_fd.get(), op, fd, &ev) == 0)
         {
-            return Ret::Err(
-                Error::internal()
-                    .invalid_argument()
-                    .message("Poller is not initialized")
-                    .build());
+            if (op == EPOLL_CTL_ADD)
+            {
+                // fd 由内核按最小可用分配，平坦表的规模与并发连接数同阶
+                if (static_cast<std::size_t>(fd) >= fd_table.size())
+                    fd_table.resize(static_cast<std::size_t>(fd) + 1);
+                ++registered;
+            }
+            store(fd, reg);
+            return Ret::Ok();
         }
 
-        epoll_event ev{};
-        ev.events = events;
-        ev.data.fd = fd.fd;
+        int err_no = errno;
 
-        if (::epoll_ctl(
-                epoll_fd.get(),
-                EPOLL_CTL_ADD,
-                fd.fd, &ev) == 0)
+        // fd 关闭时内核已自动移出兴趣列表 编号被复用后按新 fd 重新注册
+        if (op == EPOLL_CTL_MOD && err_no == ENOENT &&
+            ::epoll_ctl(epoll_fd.get(), EPOLL_CTL_ADD, fd, &ev) == 0)
+        {
+            store(fd, reg);
             return Ret::Ok();
+        }
 
-        int err_no = errno;
         return Ret::Err(
             Error::system()
                 .code(err_no)
                 .set_category(from_errno(err_no))
                 .message("Failed to update epoll interest list")
-                .context("Poller.add: epoll_ctl")
+                .context(context)
                 .build());
     }
 
+    util::ResultV<void>
+    Poller::add(
+        platform::fd::FdView fd,
+        std::uint32_t events) noexcept
+    {
+        if (has_fd(fd.fd))
+            return modify(fd, events);
+
+        if (!valid())
+            return not_initialized();
+
+        return ctl(EPOLL_CTL_ADD, fd.fd, {true, events, nullptr},
+                   "Poller.add: epoll_ctl");
+    }
+
     util::ResultV<void>
     Poller::modify(
         platform::fd::FdView fd,
@@ -115,27 +191,40 @@ namespace platform::poller
         if (!has_fd(fd.fd))
             return add(fd, events);
 
+        if (!valid())
+            return not_initialized();
+
+        // 保留注册时的用户数据指针
+        Registration reg = fd_table[fd.fd];
+        reg.events = events;
+        return ctl(EPOLL_CTL_MOD, fd.fd, reg,
+                   "Poller.modify: epoll_ctl");
+    }
+
+    util::ResultV<void>
+    Poller::remove(
+        platform::fd::FdView fd) noexcept
+    {
         using Ret = util::ResultV<void>;
         using util::Error;
 
         if (!valid())
-        {
-            return Ret::Err(
-                Error::internal()
-                    .invalid_argument()
-                    .message("Poller is not initialized")
-                    .build());
-        }
-
-        epoll_event ev{};
-        ev.events = events;
-        ev.data.fd = fd.fd;
+            return not_initialized();
 
         if (::epoll_ctl(
                 epoll_fd.get(),
-                EPOLL_CTL_MOD,
-                fd.fd, &ev) == 0)
+                EPOLL_CTL_DEL,
+                fd.fd, nullptr) == 0)
+        {
+            if (has_fd(fd.fd))
+            {
+                if (fd_table[fd.fd].data)
+                    forget(fd.fd);
+                fd_table[fd.fd] = Registration{};
+                --registered;
+            }
             return Ret::Ok();
+        }
 
         int err_no = errno;
         return Ret::Err(
@@ -143,49 +232,73 @@ namespace platform::poller
                 .code(err_no)
                 .set_category(from_errno(err_no))
                 .message("Failed to update epoll interest list")
-                .context("Poller.modify: epoll_ctl")
+                .context("Poller.remove: epoll_ctl")
                 .build());
     }
 
     util::ResultV<void>
-    Poller::remove(
-        platform::fd::FdView fd) noexcept
+    Poller::add(
+        platform::fd::FdView fd,
+        std::uint32_t events,
+        void *data) noexcept
     {
-        using Ret = util::ResultV<void>;
         using util::Error;
 
         if (!valid())
+            return not_initialized();
+
+        if (data == nullptr)
         {
-            return Ret::Err(
+            return util::ResultV<void>::Err(
                 Error::internal()
                     .invalid_argument()
-                    .message("Poller is not initialized")
+                    .message("User data pointer must not be null")
+                    .context("Poller.add")
                     .build());
         }
 
-        if (::epoll_ctl(
-                epoll_fd.get(),
-                EPOLL_CTL_DEL,
-                fd.fd, nullptr) == 0)
+        if (has_fd(fd.fd))
+            return ctl(EPOLL_CTL_MOD, fd.fd, {true, events, data},
+                       "Poller.add: epoll_ctl");
+
+        return ctl(EPOLL_CTL_ADD, fd.fd, {true, events, data},
+                   "Poller.add: epoll_ctl");
+    }
+
+    util::ResultV<void>
+    Poller::rearm(
+        platform::fd::FdView fd,
+        std::uint32_t events) noexcept
+    {
+        using util::Error;
+
+        if (!valid())
+            return not_initialized();
+
+        if (!has_fd(fd.fd))
         {
-            fd_table.erase(fd.fd);
-            return Ret::Ok();
+            return util::ResultV<void>::Err(
+                Error::internal()
+                    .invalid_argument()
+                    .message("Fd is not registered")
+                    .context("Poller.rearm")
+                    .build());
         }
 
-        int err_no = errno;
-        return Ret::Err(
-            Error::system()
-                .code(err_no)
-                .set_category(from_errno(err_no))
-                .message("Failed to update epoll interest list")
-                .context("Poller.remove: epoll_ctl")
-                .build());
+        Registration reg = fd_table[fd.fd];
+        if (events != 0)
+            reg.events = events;
+        return ctl(EPOLL_CTL_MOD, fd.fd, reg,
+                   "Poller.rearm: epoll_ctl");
     }
 
-    util::ResultV<std::vector<PollEvent>>
-    Poller::wait(int timeout_ms) noexcept
+    util::ResultV<std::size_t>
+    Poller::wait_raw(
+        epoll_event *out,
+        int max_events,
+        int timeout_ms) noexcept
     {
-        using Ret = util::ResultV<std::vector<PollEvent>>;
+        using Ret = util::ResultV<std::size_t>;
         using util::Error;
 
         if (!valid())
@@ -197,15 +310,14 @@ namespace platform::poller
                     .build());
         }
 
-        epoll_event events[MAX_EVENTS];
+        // 被信号打断时重试，与最初的 wait(int) 一致，调用方不会收到 EINTR
         int n;
-
         do
         {
             n = ::epoll_wait(
                 epoll_fd.get(),
-                events,
-                MAX_EVENTS,
+                out,
+                max_events,
                 timeout_ms);
         } while (n < 0 && errno == EINTR);
 
@@ -215,20 +327,77 @@ namespace platform::poller
             return Ret::Err(
                 Error::system()
                     .code(err_no)
-                    .set_category(from_errno(err_no)) // 主要是 EINTR (Cancelled)
+                    .set_category(from_errno(err_no)) // EINTR 已在上面重试，此处为 EBADF / EINVAL 等
                     .message("Epoll wait syscall failed")
                     .context("epoll_wait")
                     .build());
         }
 
+        return Ret::Ok(static_cast<std::size_t>(n));
+    }
+
+    util::ResultV<std::size_t>
+    Poller::wait(EventArray &out, int timeout_ms) noexcept
+    {
+        out.set_size(0);
+        auto buf = out.storage();
+        auto res = wait_raw(buf.data(), static_cast<int>(buf.size()), timeout_ms);
+        if (res.is_err())
+            return util::ResultV<std::size_t>::Err(res.unwrap_err());
+
+        std::size_t n = res.unwrap();
+        out.set_size(n);
+        return util::ResultV<std::size_t>::Ok(n);
+    }
+
+    util::ResultV<std::size_t>
+    Poller::wait(std::span<epoll_event> out, int timeout_ms) noexcept
+    {
+        using util::Error;
+
+        if (out.empty())
+        {
+            return util::ResultV<std::size_t>::Err(
+                Error::internal()
+                    .invalid_argument()
+                    .message("Event buffer must not be empty")
+                    .context("Poller.wait")
+                    .build());
+        }
+
+        return wait_raw(out.data(), static_cast<int>(out.size()), timeout_ms);
+    }
+
+    util::ResultV<std::vector<PollEvent>>
+    Poller::wait(int timeout_ms) noexcept
+    {
+        using Ret = util::ResultV<std::vector<PollEvent>>;
+
+        auto res = wait_raw(
+            scratch.data(),
+            static_cast<int>(scratch.size()),
+            timeout_ms);
+        if (res.is_err())
+            return Ret::Err(res.unwrap_err());
+
+        std::size_t n = res.unwrap();
         std::vector<PollEvent> result;
-        result.reserve(static_cast<size_t>(n));
+        result.reserve(n);
 
-        for (size_t i = 0; i < n; ++i)
+        for (std::size_t i = 0; i < n; ++i)
         {
+            // 以指针注册的 fd 经反查表还原，其余注册的 epoll_data 即为 fd
+            int fd = scratch[i].data.fd;
+            if (!data_fds.empty())
+            {
+                auto it = data_fds.find(scratch[i].data.ptr);
+                if (it != data_fds.end())
+                    fd = it->second;
+            }
+
             result.push_back({
-                events[i].data.fd,
-                events[i].events,
+                fd,
+                scratch[i].events,
             });
         }
 
@@ -0,0 +1,374 @@
+/*
+ * ============================================================================
+ *  File Name   : scheduler.cpp
+ *  Module      : platform/sched
+ *
+ *  Description :
+ *      工作窃取调度器与 Strand 实现。worker 取任务顺序：
+ *      逐个优先级依次尝试 自身队列 -> 全局注入队列 -> 随机窃取，
+ *      全部落空后先让出若干轮，再基于 epoch 计数休眠。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/platform/scheduler.hpp"
+#include "eunet/platform/time.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace platform::sched
+{
+    namespace
+    {
+        // 当前线程所属的调度器与 worker，用于把 worker 内的提交压入自身队列
+        struct CurrentWorker
+        {
+            const void *owner = nullptr;
+            void *worker = nullptr;
+        };
+
+        thread_local CurrentWorker t_current;
+
+        std::uint64_t xorshift(std::uint64_t &s) noexcept
+        {
+            s ^= s << 13;
+            s ^= s >> 7;
+            s ^= s << 17;
+            return s;
+        }
+    }
+
+    util::ResultV<std::unique_ptr<Scheduler>>
+    Scheduler::create(SchedulerOptions opts)
+    {
+        using Ret = util::ResultV<std::unique_ptr<Scheduler>>;
+        using util::Error;
+
+        if (opts.threads == 0)
+            opts.threads = std::max(1u, std::thread::hardware_concurrency());
+
+        if (opts.deque_capacity == 0)
+        {
+            return Ret::Err(
+                Error::internal()
+                    .invalid_argument()
+                    .message("Deque capacity must be positive")
+                    .context("Scheduler::create")
+                    .build());
+        }
+
+        std::unique_ptr<Scheduler> sched(new Scheduler(opts));
+        sched->m_workers.reserve(opts.threads);
+
+        for (std::size_t i = 0; i < opts.threads; ++i)
+        {
+            auto w = std::make_unique<Worker>();
+            w->index = i;
+            for (auto &d : w->deques)
+                d = std::make_unique<Deque>(opts.deque_capacity);
+            w->rng = (i + 1) * 0x9E3779B97F4A7C15ull;
+            sched->m_workers.push_back(std::move(w));
+        }
+
+        return Ret::Ok(std::move(sched));
+    }
+
+    Scheduler::~Scheduler()
+    {
+        stop();
+
+        // 未启动即销毁时释放残留任务
+        for (auto &inj : m_injectors)
+            for (Node *n : inj.queue)
+                delete n;
+
+        for (auto &w : m_workers)
+            for (auto &d : w->deques)
+                while (auto n = d->pop())
+                    delete *n;
+    }
+
+    void Scheduler::start()
+    {
+        if (m_running)
+            return;
+
+        m_stop.store(false, std::memory_order_release);
+        for (auto &w : m_workers)
+        {
+            Worker *wp = w.get();
+            w->thread = std::thread([this, wp]
+                                    { run_worker(*wp); });
+        }
+
+        m_running = true;
+    }
+
+    void Scheduler::stop()
+    {
+        if (!m_running)
+            return;
+
+        m_stop.store(true, std::memory_order_release);
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        m_epoch.notify_all();
+
+        for (auto &w : m_workers)
+            if (w->thread.joinable())
+                w->thread.join();
+
+        m_running = false;
+    }
+
+    bool Scheduler::in_worker() const noexcept
+    {
+        return t_current.owner == this;
+    }
+
+    void Scheduler::submit(Job fn, Priority prio)
+    {
+        auto p = static_cast<std::size_t>(prio);
+        Node *node = new Node{std::move(fn), prio};
+
+        m_submitted.fetch_add(1, std::memory_order_relaxed);
+        m_outstanding.fetch_add(1, std::memory_order_acq_rel);
+
+        if (t_current.owner == this)
+        {
+            // worker 内派生的任务压入自身队列，保持局部性，由其他 worker 按需窃取
+            static_cast<Worker *>(t_current.worker)->deques[p]->push(node);
+        }
+        else
+        {
+            auto &inj = m_injectors[p];
+            std::lock_guard lock(inj.mtx);
+            inj.queue.push_back(node);
+            inj.size.fetch_add(1, std::memory_order_release);
+        }
+
+        wake_one();
+    }
+
+    void Scheduler::wait_idle()
+    {
+        std::size_t v;
+        while ((v = m_outstanding.load(std::memory_order_acquire)) != 0)
+            m_outstanding.wait(v, std::memory_order_acquire);
+    }
+
+    SchedulerStats Scheduler::stats() const
+    {
+        SchedulerStats s;
+        s.submitted = m_submitted.load(std::memory_order_relaxed);
+        for (std::size_t p = 0; p < PRIORITY_COUNT; ++p)
+            s.executed_by_priority[p] = m_executed_by_prio[p].load(std::memory_order_relaxed);
+
+        s.workers.reserve(m_workers.size());
+        for (const auto &w : m_workers)
+        {
+            const auto &c = w->counters;
+            WorkerStats ws{
+                c.executed.load(std::memory_order_relaxed),
+                c.stolen.load(std::memory_order_relaxed),
+                c.steal_misses.load(std::memory_order_relaxed),
+                c.idle_sleeps.load(std::memory_order_relaxed),
+                c.idle_ns.load(std::memory_order_relaxed)};
+
+            s.executed += ws.executed;
+            s.stolen += ws.stolen;
+            s.steal_misses += ws.steal_misses;
+            s.idle_sleeps += ws.idle_sleeps;
+            s.idle_ns += ws.idle_ns;
+            s.workers.push_back(ws);
+        }
+        return s;
+    }
+
+    void Scheduler::run_worker(Worker &w)
+    {
+        t_current = {this, &w};
+
+        std::size_t idle_rounds = 0;
+        for (;;)
+        {
+            std::uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+
+            if (Node *n = find_work(w))
+            {
+                execute(w, n);
+                idle_rounds = 0;
+                continue;
+            }
+
+            if (m_stop.load(std::memory_order_acquire) &&
+                m_outstanding.load(std::memory_order_acquire) == 0)
+                break;
+
+            if (idle_rounds++ < m_opts.spin_rounds)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // 登记为休眠者后再次确认 epoch，避免错过刚发生的提交
+            m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (m_epoch.load(std::memory_order_seq_cst) == epoch)
+            {
+                w.counters.idle_sleeps.fetch_add(1, std::memory_order_relaxed);
+                auto t0 = platform::time::monotonic_now();
+                m_epoch.wait(epoch, std::memory_order_seq_cst);
+                auto slept = platform::time::monotonic_now() - t0;
+                w.counters.idle_ns.fetch_add(
+                    static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(slept).count()),
+                    std::memory_order_relaxed);
+            }
+            m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+            idle_rounds = 0;
+        }
+
+        t_current = {};
+    }
+
+    Scheduler::Node *Scheduler::find_work(Worker &w)
+    {
+        // 高优先级在任何来源中都先于低优先级被取出
+        for (std::size_t p = 0; p < PRIORITY_COUNT; ++p)
+        {
+            if (auto n = w.deques[p]->pop())
+                return *n;
+
+            if (Node *n = pop_injected(p))
+                return n;
+
+            if (Node *n = steal_from_others(w, p))
+                return n;
+        }
+
+        if (m_workers.size() > 1)
+            w.counters.steal_misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Scheduler::Node *Scheduler::steal_from_others(Worker &w, std::size_t prio)
+    {
+        std::size_t n = m_workers.size();
+        if (n < 2)
+            return nullptr;
+
+        // 从随机位置开始轮询，避免所有空闲 worker 同时盯住同一个受害者
+        std::size_t start = static_cast<std::size_t>(xorshift(w.rng) % n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            Worker &victim = *m_workers[(start + i) % n];
+            if (&victim == &w)
+                continue;
+
+            if (auto node = victim.deques[prio]->steal())
+            {
+                w.counters.stolen.fetch_add(1, std::memory_order_relaxed);
+                return *node;
+            }
+        }
+        return nullptr;
+    }
+
+    Scheduler::Node *Scheduler::pop_injected(std::size_t prio)
+    {
+        auto &inj = m_injectors[prio];
+        if (inj.size.load(std::memory_order_acquire) == 0)
+            return nullptr;
+
+        std::lock_guard lock(inj.mtx);
+        if (inj.queue.empty())
+            return nullptr;
+
+        Node *n = inj.queue.front();
+        inj.queue.pop_front();
+        inj.size.fetch_sub(1, std::memory_order_release);
+        return n;
+    }
+
+    void Scheduler::execute(Worker &w, Node *node)
+    {
+        auto p = static_cast<std::size_t>(node->prio);
+
+        try
+        {
+            node->fn();
+        }
+        catch (...)
+        {
+            // 防止任务内异常导致 worker 退出
+        }
+        delete node;
+
+        w.counters.executed.fetch_add(1, std::memory_order_relaxed);
+        m_executed_by_prio[p].fetch_add(1, std::memory_order_relaxed);
+
+        if (m_outstanding.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            m_outstanding.notify_all();
+
+            // 停止阶段最后一个任务完成后唤醒所有 worker 退出
+            if (m_stop.load(std::memory_order_acquire))
+            {
+                m_epoch.fetch_add(1, std::memory_order_seq_cst);
+                m_epoch.notify_all();
+            }
+        }
+    }
+
+    void Scheduler::wake_one()
+    {
+        m_epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (m_sleepers.load(std::memory_order_seq_cst) > 0)
+            m_epoch.notify_one();
+    }
+
+    Strand::~Strand()
+    {
+        while (m_pending.load(std::memory_order_acquire) != 0)
+            std::this_thread::yield();
+    }
+
+    void Strand::post(Job fn)
+    {
+        m_queue.push(std::move(fn));
+
+        // 只有从 0 变为 1 的投递者负责调度执行批次，保证同一时刻最多一个批次在运行
+        if (m_pending.fetch_add(1, std::memory_order_acq_rel) == 0)
+            m_sched.submit([this]
+                           { run_batch(); },
+                           m_prio);
+    }
+
+    void Strand::run_batch()
+    {
+        std::size_t n = m_queue.pop_all(
+            [](Job &&fn)
+            {
+                try
+                {
+                    fn();
+                }
+                catch (...)
+                {
+                }
+            },
+            BATCH);
+
+        // 批次结束时仍有未处理任务则重新调度，让出 worker 给其他任务
+        if (m_pending.fetch_sub(n, std::memory_order_acq_rel) != n)
+            m_sched.submit([this]
+                           { run_batch(); },
+                           m_prio);
+    }
+}
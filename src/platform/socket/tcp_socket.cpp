@@ -20,6 +20,7 @@
 #include "eunet/platform/poller.hpp"
 #include "eunet/platform/time.hpp"
 
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/epoll.h>
 #include <cerrno>
@@ -30,7 +31,8 @@ namespace platform::net
     util::ResultV<TCPSocket>
     TCPSocket::create(
         poller::Poller &poller,
-        AddressFamily af)
+        AddressFamily af,
+        const SocketOptions &opts)
     {
         using Result = util::ResultV<TCPSocket>;
 
@@ -47,19 +49,25 @@ namespace platform::net
         if (fd_res.is_err())
             return Result::Err(fd_res.unwrap_err());
 
-        return Result::Ok(
-            TCPSocket(std::move(fd_res.unwrap()), poller));
+        TCPSocket sock(std::move(fd_res.unwrap()), poller);
+
+        // 应用创建期选项 单项失败只记录不中断
+        sock.m_options = opts;
+        sock.m_applied = apply_socket_options(
+            sock.view(), opts, SocketOptionStage::Create);
+
+        return Result::Ok(std::move(sock));
     }
 
     IOResult
-    TCPSocket::read(
+    TCPSocket::recv_once(
         util::ByteBuffer &buf,
-        int timeout_ms)
+        int flags)
     {
         using Ret = IOResult;
         using util::Error;
 
-        // 进入读取循环以处理可能的信号中断或重试逻辑
+        // 进入读取循环以处理可能的信号中断
         for (;;)
         {
             // 获取缓冲区当前可写入的空间大小
@@ -68,17 +76,22 @@ namespace platform::net
             auto span = buf.weak_prepare(writable);
 
             // 调用系统调用 recv 尝试读取数据
-            ssize_t n = ::recv(
-                view().fd,
+            ssize_t n = recv_stamped(
                 span.data(),
                 writable,
-                0);
+                flags);
 
             // 如果返回值大于 0 表示成功读取到了数据
             if (n > 0)
             {
                 // 提交写入 更新缓冲区的 write_pos
                 buf.weak_commit(n);
+
+                // QUICKACK 会在内核发出 ACK 后复位 每次读取后重新开启
+                if (m_options.tcp_quickack.value_or(false))
+                    (void)apply_socket_options(
+                        view(), m_options, SocketOptionStage::Connect);
+
                 return Ret::Ok(static_cast<size_t>(n));
             }
 
@@ -101,20 +114,17 @@ namespace platform::net
             if (err == EINTR)
                 continue;
 
-            // 如果是资源暂时不可用 EAGAIN 或 EWOULDBLOCK
+            // 资源暂时不可用 交由调用方决定等待方式
             if (err == EAGAIN || err == EWOULDBLOCK)
             {
-                // 调用 epoll 等待该 fd 变为可读
-                auto w = wait_fd_epoll(
-                    m_poller, view(),
-                    EPOLLIN, timeout_ms);
-
-                // 如果等待失败或超时 直接返回错误
-                if (w.is_err())
-                    return Ret::Err(w.unwrap_err());
-
-                // 等待成功后 再次进入循环尝试 recv
-                continue;
+                return Ret::Err(
+                    Error::transport()
+                        .code(err)
+                        .busy()
+                        .transient()
+                        .message("TCP socket not readable yet")
+                        .context("TCPSocket::read")
+                        .build());
             }
 
             // 其他情况视为致命的系统错误
@@ -129,15 +139,15 @@ namespace platform::net
     }
 
     IOResult
-    TCPSocket::write(
+    TCPSocket::send_once(
         util::ByteBuffer &buf,
-        int timeout_ms)
+        int flags)
     {
         using Ret = IOResult;
         using util::Error;
 
-        // 进入读取循环以处理可能的信号中断或重试逻辑
-        while (!buf.empty())
+        // 进入写入循环以处理可能的信号中断
+        for (;;)
         {
             // 获取缓冲区当前可读取的空间大小
             auto data = buf.readable();
@@ -147,13 +157,16 @@ namespace platform::net
                 view().fd,
                 data.data(),
                 data.size(),
-                0);
+                flags);
 
             // 如果返回值大于 0 表示成功写入了数据
             if (n > 0)
             {
                 // 提交写入 更新缓冲区的 read_pos
                 buf.consume(n);
+
+                // 开启时间戳时 登记本次发送的回执序号并收取回执 避免错误队列堆积触发 EPOLLERR
+                note_tx(static_cast<size_t>(n));
                 return Ret::Ok(static_cast<size_t>(n));
             }
 
@@ -175,20 +188,17 @@ namespace platform::net
             if (err == EINTR)
                 continue;
 
-            // 如果是资源暂时不可用 EAGAIN 或 EWOULDBLOCK
-            if (err == EAGAIN || err == EWOULDBLOCK)
+            // 发送缓冲区已满或 Fast Open 握手尚未完成 交由调用方决定等待方式
+            if (err == EAGAIN || err == EWOULDBLOCK || err == EINPROGRESS)
             {
-                // 调用 epoll 等待该 fd 变为可读
-                auto w = wait_fd_epoll(
-                    m_poller, view(),
-                    EPOLLOUT, timeout_ms);
-
-                // 如果等待失败或超时 直接返回错误
-                if (w.is_err())
-                    return Ret::Err(w.unwrap_err());
-
-                // 等待成功后 再次进入循环尝试 send
-                continue;
+                return Ret::Err(
+                    Error::transport()
+                        .code(err)
+                        .busy()
+                        .transient()
+                        .message("TCP socket not writable yet")
+                        .context("TCPSocket::write")
+                        .build());
             }
 
             // 其他情况视为致命的系统错误
@@ -200,18 +210,94 @@ namespace platform::net
                     .context("TCPSocket::write")
                     .build());
         }
+    }
 
-        return Ret::Ok(0);
+    IOResult
+    TCPSocket::read(
+        util::ByteBuffer &buf,
+        int timeout_ms)
+    {
+        using Ret = IOResult;
+
+        for (;;)
+        {
+            auto r = recv_once(buf, 0);
+            if (r.is_ok())
+                return Ret::Ok(r.unwrap());
+
+            // 非 Busy 错误直接返回
+            if (r.unwrap_err().category() != util::ErrorCategory::Busy)
+                return Ret::Err(r.unwrap_err());
+
+            // 调用 epoll 等待该 fd 变为可读 等待成功后再次尝试 recv
+            auto w = wait_ready(EPOLLIN, timeout_ms);
+            if (w.is_err())
+                return Ret::Err(w.unwrap_err());
+        }
     }
 
-    util::ResultV<void>
-    TCPSocket::connect(
-        const Endpoint &ep,
+    IOResult
+    TCPSocket::write(
+        util::ByteBuffer &buf,
         int timeout_ms)
     {
-        using Result = util::ResultV<void>;
+        using Ret = IOResult;
+
+        // 推迟的 Fast Open 连接由首次写入携带数据发起
+        if (m_fastopen_peer && !buf.empty())
+            return write_fastopen_all(buf, timeout_ms);
+
+        while (!buf.empty())
+        {
+            auto r = send_once(buf, 0);
+            if (r.is_ok())
+                return Ret::Ok(r.unwrap());
+
+            // 非 Busy 错误直接返回
+            if (r.unwrap_err().category() != util::ErrorCategory::Busy)
+                return Ret::Err(r.unwrap_err());
+
+            // 调用 epoll 等待该 fd 变为可写 等待成功后再次尝试 send
+            auto w = wait_ready(EPOLLOUT, timeout_ms);
+            if (w.is_err())
+                return Ret::Err(w.unwrap_err());
+        }
+
+        return Ret::Ok(0);
+    }
+
+    IOResult
+    TCPSocket::try_read(util::ByteBuffer &buf)
+    {
+        return recv_once(buf, MSG_DONTWAIT);
+    }
+
+    IOResult
+    TCPSocket::try_write(util::ByteBuffer &buf)
+    {
+        if (buf.empty())
+            return IOResult::Ok(0);
+
+        if (m_fastopen_peer)
+            return write_fastopen(buf);
+
+        return send_once(buf, MSG_DONTWAIT);
+    }
+
+    util::ResultV<bool>
+    TCPSocket::start_connect(const Endpoint &ep)
+    {
+        using Result = util::ResultV<bool>;
         using util::Error;
 
+        // 请求了 Fast Open 但内核不支持 TCP_FASTOPEN_CONNECT 时
+        // 记录对端地址 由首次 write 通过 sendto(MSG_FASTOPEN) 发起连接
+        if (m_options.fastopen && !fastopen_connect_enabled())
+        {
+            m_fastopen_peer = ep;
+            return Result::Ok(true);
+        }
+
         // 调用非阻塞 connect 系统调用
         int ret = ::connect(
             view().fd,
@@ -219,27 +305,34 @@ namespace platform::net
             ep.length());
 
         // 如果返回 0 表示连接立即建立成功（主要见于本地环回）
+        // 开启 TCP_FASTOPEN_CONNECT 时 connect 同样立即返回 SYN 随首次写入发出
         if (ret == 0)
-            return Result::Ok();
+        {
+            apply_connect_options();
+            return Result::Ok(true);
+        }
 
         // 检查错误码 如果不是 EINPROGRESS 则表示连接立即失败
-        if (errno != EINPROGRESS)
+        int err = errno;
+        if (err != EINPROGRESS)
         {
             return Result::Err(
                 Error::transport()
-                    .code(errno)
-                    .set_category(from_errno(errno))
+                    .code(err)
+                    .set_category(from_errno(err))
                     .message("Immediate TCP connection attempt failed")
                     .context("connect")
                     .build());
         }
 
-        // 连接正在进行中 使用 epoll 等待 socket 变为可写
-        auto w = wait_fd_epoll(
-            m_poller, view(),
-            EPOLLOUT, timeout_ms);
-        if (w.is_err())
-            return Result::Err(w.unwrap_err());
+        return Result::Ok(false);
+    }
+
+    util::ResultV<void>
+    TCPSocket::finish_connect()
+    {
+        using Result = util::ResultV<void>;
+        using util::Error;
 
         // epoll 返回可写并不一定代表成功 需要检查 socket 错误状态
         int err = 0;
@@ -263,8 +356,171 @@ namespace platform::net
                     .build());
         }
 
-        // 没有任何错误 连接确认建立
+        // 没有任何错误 连接确认建立 应用连接期选项
+        m_fastopen_handshake = false;
+        apply_connect_options();
         return Result::Ok();
     }
 
+    util::ResultV<void>
+    TCPSocket::connect(
+        const Endpoint &ep,
+        int timeout_ms)
+    {
+        using Result = util::ResultV<void>;
+
+        auto started = start_connect(ep);
+        if (started.is_err())
+            return Result::Err(started.unwrap_err());
+        if (started.unwrap())
+            return Result::Ok();
+
+        // 连接正在进行中 使用 epoll 等待 socket 变为可写
+        auto w = wait_ready(EPOLLOUT, timeout_ms);
+        if (w.is_err())
+            return Result::Err(w.unwrap_err());
+
+        return finish_connect();
+    }
+
+    void TCPSocket::apply_connect_options()
+    {
+        auto applied = apply_socket_options(
+            view(), m_options, SocketOptionStage::Connect);
+        m_applied.insert(m_applied.end(), applied.begin(), applied.end());
+    }
+
+    util::ResultV<TcpInfo>
+    TCPSocket::tcp_info() const
+    {
+        return query_tcp_info(view());
+    }
+
+    bool TCPSocket::fastopen_connect_enabled() const noexcept
+    {
+        // 以套接字上的实际取值为准 创建后仍可能被关闭
+        int on = 0;
+        socklen_t len = sizeof(on);
+        if (::getsockopt(view().fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &on, &len) != 0)
+            return false;
+        return on != 0;
+    }
+
+    IOResult
+    TCPSocket::write_fastopen(util::ByteBuffer &buf)
+    {
+        using Ret = IOResult;
+        using util::Error;
+
+        Endpoint peer = *m_fastopen_peer;
+        m_fastopen_peer.reset();
+
+        auto data = buf.readable();
+
+        ssize_t n;
+        do
+        {
+            n = ::sendto(
+                view().fd,
+                data.data(),
+                data.size(),
+                MSG_FASTOPEN,
+                peer.as_sockaddr(),
+                peer.length());
+        } while (n < 0 && errno == EINTR);
+
+        if (n >= 0)
+        {
+            // 数据随 SYN 发出 握手结果待可写后确认
+            m_fastopen_handshake = true;
+            buf.consume(static_cast<size_t>(n));
+            note_tx(static_cast<size_t>(n));
+            return Ret::Ok(static_cast<size_t>(n));
+        }
+
+        int err = errno;
+
+        // 内核未开启客户端 TFO 时退化为普通非阻塞 connect 数据在连接建立后发送
+        if (err == EOPNOTSUPP)
+        {
+            m_options.fastopen = false;
+            auto started = start_connect(peer);
+            if (started.is_err())
+                return Ret::Err(started.unwrap_err());
+
+            m_fastopen_handshake = !started.unwrap();
+            if (!m_fastopen_handshake)
+                return send_once(buf, MSG_DONTWAIT);
+            err = EINPROGRESS;
+        }
+        else if (err == EINPROGRESS)
+        {
+            // 尚无 cookie 时内核只发出 SYN 数据未被取走 连接建立（可写）后按普通写入重试
+            m_fastopen_handshake = true;
+        }
+
+        if (err == EINPROGRESS)
+        {
+            return Ret::Err(
+                Error::transport()
+                    .code(err)
+                    .busy()
+                    .transient()
+                    .message("TCP Fast Open connect in progress")
+                    .context("sendto(MSG_FASTOPEN)")
+                    .build());
+        }
+
+        return Ret::Err(
+            Error::transport()
+                .code(err)
+                .set_category(from_errno(err))
+                .message("TCP Fast Open connect failed")
+                .context("sendto(MSG_FASTOPEN)")
+                .build());
+    }
+
+    IOResult
+    TCPSocket::write_fastopen_all(
+        util::ByteBuffer &buf,
+        int timeout_ms)
+    {
+        using Ret = IOResult;
+
+        size_t total = 0;
+        while (!buf.empty())
+        {
+            auto r = m_fastopen_peer
+                         ? write_fastopen(buf)
+                         : send_once(buf, MSG_DONTWAIT);
+            if (r.is_ok())
+            {
+                total += r.unwrap();
+                continue;
+            }
+
+            // 非 Busy 错误直接返回
+            if (r.unwrap_err().category() != util::ErrorCategory::Busy)
+                return Ret::Err(r.unwrap_err());
+
+            // SYN 已发出或发送缓冲区已满 等待可写后继续写入剩余数据
+            auto w = wait_ready(EPOLLOUT, timeout_ms);
+            if (w.is_err())
+                return Ret::Err(w.unwrap_err());
+        }
+
+        // 数据可能全部随 SYN 发出 等待对端确认握手后才算连接建立
+        if (m_fastopen_handshake)
+        {
+            auto w = wait_ready(EPOLLOUT, timeout_ms);
+            if (w.is_err())
+                return Ret::Err(w.unwrap_err());
+
+            auto done = finish_connect();
+            if (done.is_err())
+                return Ret::Err(done.unwrap_err());
+        }
+
+        return Ret::Ok(total);
+    }
 }
@@ -51,9 +51,7 @@ namespace platform::net
     }
 
     IOResult
-    UDPSocket::read(
-        util::ByteBuffer &buf,
-        int timeout_ms)
+    UDPSocket::try_read(util::ByteBuffer &buf)
     {
         using Ret = IOResult;
         using util::Error;
@@ -63,8 +61,8 @@ namespace platform::net
             auto writable = buf.writable_size();
             auto span = buf.weak_prepare(writable);
 
-            ssize_t n = ::recv(
-                view().fd, span.data(),
+            ssize_t n = recv_stamped(
+                span.data(),
                 writable, MSG_DONTWAIT);
 
             if (n >= 0)
@@ -79,19 +77,14 @@ namespace platform::net
 
             if (err == EAGAIN || err == EWOULDBLOCK)
             {
-                if (timeout_ms == 0)
-                    return Ret::Ok(0);
-
-                auto w = wait_fd_epoll(
-                    m_poller,
-                    view(),
-                    EPOLLIN,
-                    timeout_ms);
-
-                if (w.is_err())
-                    return Ret::Err(w.unwrap_err());
-
-                continue;
+                return Ret::Err(
+                    Error::transport()
+                        .code(err)
+                        .busy()
+                        .transient()
+                        .message("No datagram available on UDP socket")
+                        .context("read")
+                        .build());
             }
 
             return Ret::Err(
@@ -105,9 +98,7 @@ namespace platform::net
     }
 
     IOResult
-    UDPSocket::write(
-        util::ByteBuffer &buf,
-        int timeout_ms)
+    UDPSocket::try_write(util::ByteBuffer &buf)
     {
         using Ret = IOResult;
         using util::Error;
@@ -123,11 +114,12 @@ namespace platform::net
                 view().fd,
                 data.data(),
                 data.size(),
-                0);
+                MSG_DONTWAIT);
 
             if (n >= 0)
             {
                 buf.consume(static_cast<size_t>(n));
+                note_tx(static_cast<size_t>(n));
                 return Ret::Ok(static_cast<size_t>(n));
             }
 
@@ -137,16 +129,14 @@ namespace platform::net
 
             if (err == EAGAIN || err == EWOULDBLOCK)
             {
-                auto w = wait_fd_epoll(
-                    m_poller,
-                    view(),
-                    EPOLLOUT,
-                    timeout_ms);
-
-                if (w.is_err())
-                    return Ret::Err(w.unwrap_err());
-
-                continue;
+                return Ret::Err(
+                    Error::transport()
+                        .code(err)
+                        .busy()
+                        .transient()
+                        .message("UDP socket not writable yet")
+                        .context("write")
+                        .build());
             }
 
             return Ret::Err(
@@ -159,6 +149,55 @@ namespace platform::net
         }
     }
 
+    IOResult
+    UDPSocket::read(
+        util::ByteBuffer &buf,
+        int timeout_ms)
+    {
+        using Ret = IOResult;
+
+        for (;;)
+        {
+            auto r = try_read(buf);
+            if (r.is_ok())
+                return Ret::Ok(r.unwrap());
+
+            if (r.unwrap_err().category() != util::ErrorCategory::Busy)
+                return Ret::Err(r.unwrap_err());
+
+            if (timeout_ms == 0)
+                return Ret::Ok(0);
+
+            auto w = wait_ready(EPOLLIN, timeout_ms);
+
+            if (w.is_err())
+                return Ret::Err(w.unwrap_err());
+        }
+    }
+
+    IOResult
+    UDPSocket::write(
+        util::ByteBuffer &buf,
+        int timeout_ms)
+    {
+        using Ret = IOResult;
+
+        for (;;)
+        {
+            auto r = try_write(buf);
+            if (r.is_ok())
+                return Ret::Ok(r.unwrap());
+
+            if (r.unwrap_err().category() != util::ErrorCategory::Busy)
+                return Ret::Err(r.unwrap_err());
+
+            auto w = wait_ready(EPOLLOUT, timeout_ms);
+
+            if (w.is_err())
+                return Ret::Err(w.unwrap_err());
+        }
+    }
+
     util::ResultV<void>
     UDPSocket::connect(
         const Endpoint &ep,
@@ -186,11 +225,7 @@ namespace platform::net
                     .build());
         }
 
-        auto w = wait_fd_epoll(
-            m_poller,
-            view(),
-            EPOLLOUT,
-            timeout_ms);
+        auto w = wait_ready(EPOLLOUT, timeout_ms);
 
         if (w.is_err())
             return Result::Err(w.unwrap_err());
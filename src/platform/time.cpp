@@ -6,6 +6,8 @@
  *  Description :
  *      时间工具实现。基于 std::chrono 封装单调时钟与系统时钟的获取与转换，
  *      提供 human-readable 的时间字符串格式化功能。
+ *      事件时钟在首次使用时选定时钟源：CPU 声明不变 TSC 时以
+ *      CLOCK_MONOTONIC_RAW 为参照校准约 10ms，得到 TSC 到纳秒的定点系数。
  *
  *  Third-Party Dependencies :
  *      None
@@ -21,6 +23,13 @@
 #include <iomanip>
 #include <sstream>
 
+#include <time.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
 namespace platform::time
 {
     MonoPoint monotonic_now() { return MonoClock::now(); }
@@ -46,6 +55,122 @@ namespace platform::time
     {
         std::this_thread::sleep_until(tp);
     }
+
+    std::int64_t monotonic_raw_ns() noexcept
+    {
+        timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+        return static_cast<std::int64_t>(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+    }
+
+    namespace
+    {
+        // ns = base_ns + ((tsc - base_tsc) * mult) >> SHIFT
+        constexpr unsigned TSC_SHIFT = 32;
+        constexpr std::int64_t TSC_CALIBRATION_NS = 10'000'000;
+
+        struct EventClockState
+        {
+            EventClockSource source = EventClockSource::MonotonicRaw;
+            std::uint64_t base_tsc = 0;
+            std::int64_t base_ns = 0;
+            std::uint64_t mult = 0;
+        };
+
+#if defined(__x86_64__)
+        bool has_invariant_tsc() noexcept
+        {
+            unsigned a, b, c, d;
+            if (!__get_cpuid(0x80000000u, &a, &b, &c, &d) || a < 0x80000007u)
+                return false;
+            __get_cpuid(0x80000007u, &a, &b, &c, &d);
+            return (d & (1u << 8)) != 0;
+        }
+
+        // 用前后两次 TSC 夹住一次 CLOCK_MONOTONIC_RAW，取窗口最窄的一次作为对应点
+        void sample_pair(std::uint64_t &tsc, std::int64_t &ns) noexcept
+        {
+            std::uint64_t best = UINT64_MAX;
+            for (int i = 0; i < 5; ++i)
+            {
+                std::uint64_t t0 = __rdtsc();
+                std::int64_t n = monotonic_raw_ns();
+                std::uint64_t t1 = __rdtsc();
+                if (t1 - t0 < best)
+                {
+                    best = t1 - t0;
+                    tsc = t0 + (t1 - t0) / 2;
+                    ns = n;
+                }
+            }
+        }
+#endif
+
+        EventClockState calibrate() noexcept
+        {
+            EventClockState st;
+
+#if defined(__x86_64__)
+            if (has_invariant_tsc())
+            {
+                std::uint64_t tsc0, tsc1;
+                std::int64_t ns0, ns1;
+                sample_pair(tsc0, ns0);
+                do
+                    sample_pair(tsc1, ns1);
+                while (ns1 - ns0 < TSC_CALIBRATION_NS);
+
+                if (tsc1 > tsc0)
+                {
+                    st.source = EventClockSource::Tsc;
+                    st.base_tsc = tsc1;
+                    st.base_ns = ns1;
+                    st.mult = static_cast<std::uint64_t>(
+                        (static_cast<unsigned __int128>(ns1 - ns0) << TSC_SHIFT) / (tsc1 - tsc0));
+                }
+            }
+#endif
+            return st;
+        }
+
+        const EventClockState &clock_state() noexcept
+        {
+            static const EventClockState st = calibrate();
+            return st;
+        }
+    }
+
+    EventClockSource event_clock_source() noexcept { return clock_state().source; }
+
+    std::int64_t event_now() noexcept
+    {
+        const auto &st = clock_state();
+#if defined(__x86_64__)
+        if (st.source == EventClockSource::Tsc)
+        {
+            // 校准前的读数（极少见）按有符号差处理
+            auto delta = static_cast<std::int64_t>(__rdtsc() - st.base_tsc);
+            auto scaled = (static_cast<__int128>(delta) * st.mult) >> TSC_SHIFT;
+            return st.base_ns + static_cast<std::int64_t>(scaled);
+        }
+#endif
+        return monotonic_raw_ns();
+    }
+
+    WallAnchor WallAnchor::capture() noexcept
+    {
+        // 墙上时间夹在两次事件时钟读数中间，取中点作为对应时刻
+        auto before = event_now();
+        auto wall = wall_now();
+        auto after = event_now();
+        return WallAnchor{before + (after - before) / 2, wall};
+    }
+
+    const WallAnchor &process_anchor() noexcept
+    {
+        static const WallAnchor anchor = WallAnchor::capture();
+        return anchor;
+    }
 }
 
 std::string to_string(platform::time::MonoPoint tp)
@@ -66,3 +191,16 @@ std::string to_string(platform::time::WallPoint tp)
     oss << std::put_time(&tm, "%F %T"); // 2025-12-27 10:30:15
     return oss.str();
 }
+
+std::string to_string(platform::time::EventClockSource src)
+{
+    using platform::time::EventClockSource;
+    switch (src)
+    {
+    case EventClockSource::MonotonicRaw:
+        return "CLOCK_MONOTONIC_RAW";
+    case EventClockSource::Tsc:
+        return "TSC";
+    }
+    return "Unknown";
+}
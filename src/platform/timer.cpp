@@ -0,0 +1,436 @@
+/*
+ * ============================================================================
+ *  File Name   : timer.cpp
+ *  Module      : platform/timer
+ *
+ *  Description :
+ *      分层时间轮与 timerfd 定时器服务实现。第 L 层每个槽覆盖 64^L 个 tick，
+ *      低层转完一圈时把高层当前槽下放，到期节点按槽成批触发。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/platform/timer.hpp"
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <bit>
+
+namespace platform::timer
+{
+    TimerWheel::TimerWheel(
+        std::chrono::nanoseconds resolution,
+        platform::time::MonoPoint origin)
+        : m_origin(origin),
+          m_resolution(resolution.count() > 0 ? resolution : std::chrono::nanoseconds(1))
+    {
+        m_heads.fill(NIL);
+    }
+
+    Tick TimerWheel::tick_ceil(platform::time::MonoPoint tp) const noexcept
+    {
+        auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(tp - m_origin).count();
+        if (d <= 0)
+            return 0;
+        auto res = m_resolution.count();
+        return static_cast<Tick>((d + res - 1) / res);
+    }
+
+    Tick TimerWheel::tick_floor(platform::time::MonoPoint tp) const noexcept
+    {
+        auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(tp - m_origin).count();
+        if (d <= 0)
+            return 0;
+        return static_cast<Tick>(d / m_resolution.count());
+    }
+
+    platform::time::MonoPoint TimerWheel::point_of(Tick t) const noexcept
+    {
+        return m_origin +
+               std::chrono::duration_cast<platform::time::MonoClock::duration>(
+                   m_resolution * static_cast<std::int64_t>(t));
+    }
+
+    std::uint32_t TimerWheel::alloc_node()
+    {
+        if (!m_free.empty())
+        {
+            auto idx = m_free.back();
+            m_free.pop_back();
+            return idx;
+        }
+
+        m_nodes.emplace_back();
+        return static_cast<std::uint32_t>(m_nodes.size() - 1);
+    }
+
+    void TimerWheel::release_node(std::uint32_t idx) noexcept
+    {
+        auto &n = m_nodes[idx];
+        n.list = NIL;
+        n.cb = nullptr;
+        ++n.generation; // 使旧句柄失效
+        m_free.push_back(idx);
+    }
+
+    void TimerWheel::link(std::uint32_t idx, std::size_t list) noexcept
+    {
+        auto &n = m_nodes[idx];
+        n.list = static_cast<std::uint32_t>(list);
+        n.prev = NIL;
+        n.next = m_heads[list];
+        if (n.next != NIL)
+            m_nodes[n.next].prev = idx;
+        m_heads[list] = idx;
+
+        if (list < OVERDUE)
+            m_occupied[list / SLOTS] |= std::uint64_t{1} << (list % SLOTS);
+    }
+
+    void TimerWheel::unlink(std::uint32_t idx) noexcept
+    {
+        auto &n = m_nodes[idx];
+        std::size_t list = n.list;
+
+        if (n.prev != NIL)
+            m_nodes[n.prev].next = n.next;
+        else
+            m_heads[list] = n.next;
+        if (n.next != NIL)
+            m_nodes[n.next].prev = n.prev;
+
+        n.prev = n.next = NIL;
+
+        if (list < OVERDUE && m_heads[list] == NIL)
+            m_occupied[list / SLOTS] &= ~(std::uint64_t{1} << (list % SLOTS));
+    }
+
+    void TimerWheel::place(std::uint32_t idx) noexcept
+    {
+        Tick t = m_nodes[idx].expires;
+        if (t <= m_now)
+        {
+            link(idx, OVERDUE);
+            return;
+        }
+
+        Tick delta = t - m_now;
+        if (delta > MAX_SPAN)
+        {
+            // 超出时间轮跨度，挂在最远处，下放时会重新计算
+            delta = MAX_SPAN;
+            t = m_now + MAX_SPAN;
+        }
+
+        std::size_t level = 0;
+        while (level + 1 < LEVELS && (delta >> (SLOT_BITS * (level + 1))) != 0)
+            ++level;
+
+        std::size_t slot = (t >> (SLOT_BITS * level)) & (SLOTS - 1);
+        link(idx, level * SLOTS + slot);
+    }
+
+    void TimerWheel::cascade(std::size_t list) noexcept
+    {
+        std::uint32_t idx = m_heads[list];
+        m_heads[list] = NIL;
+        m_occupied[list / SLOTS] &= ~(std::uint64_t{1} << (list % SLOTS));
+
+        while (idx != NIL)
+        {
+            std::uint32_t next = m_nodes[idx].next;
+            place(idx);
+            idx = next;
+        }
+    }
+
+    std::size_t TimerWheel::fire_list(std::size_t list)
+    {
+        if (m_heads[list] == NIL)
+            return 0;
+
+        // 先整体移入触发链表：回调中新增的到期定时器留到下一轮，
+        // 回调中取消同批次的其他定时器也能正常摘链
+        std::uint32_t idx = m_heads[list];
+        m_heads[list] = NIL;
+        if (list < OVERDUE)
+            m_occupied[list / SLOTS] &= ~(std::uint64_t{1} << (list % SLOTS));
+
+        while (idx != NIL)
+        {
+            std::uint32_t next = m_nodes[idx].next;
+            link(idx, FIRING);
+            idx = next;
+        }
+
+        std::size_t fired = 0;
+        while (m_heads[FIRING] != NIL)
+        {
+            idx = m_heads[FIRING];
+            unlink(idx);
+
+            Callback cb = std::move(m_nodes[idx].cb);
+            release_node(idx);
+            --m_size;
+            ++fired;
+
+            if (cb)
+                cb();
+        }
+
+        return fired;
+    }
+
+    TimerId TimerWheel::schedule(platform::time::MonoPoint deadline, Callback cb)
+    {
+        std::uint32_t idx = alloc_node();
+        auto &n = m_nodes[idx];
+        n.expires = tick_ceil(deadline);
+        n.cb = std::move(cb);
+
+        place(idx);
+        ++m_size;
+
+        return TimerId{idx, m_nodes[idx].generation};
+    }
+
+    TimerId TimerWheel::schedule_after(std::chrono::nanoseconds delay, Callback cb)
+    {
+        return schedule(
+            platform::time::monotonic_now() +
+                std::chrono::duration_cast<platform::time::MonoClock::duration>(delay),
+            std::move(cb));
+    }
+
+    bool TimerWheel::pending(TimerId id) const noexcept
+    {
+        if (!id.valid() || id.index >= m_nodes.size())
+            return false;
+
+        const auto &n = m_nodes[id.index];
+        return n.generation == id.generation && n.list != NIL;
+    }
+
+    bool TimerWheel::cancel(TimerId id) noexcept
+    {
+        if (!pending(id))
+            return false;
+
+        unlink(id.index);
+        release_node(id.index);
+        --m_size;
+        return true;
+    }
+
+    std::size_t TimerWheel::advance(platform::time::MonoPoint now)
+    {
+        Tick target = tick_floor(now);
+        std::size_t fired = fire_list(OVERDUE);
+
+        while (m_now < target)
+        {
+            if (m_size == 0)
+            {
+                m_now = target;
+                break;
+            }
+
+            // 第 0 层为空时直接跳到下一次下放边界
+            if (m_occupied[0] == 0)
+            {
+                Tick boundary = ((m_now >> SLOT_BITS) + 1) << SLOT_BITS;
+                if (boundary > target)
+                {
+                    m_now = target;
+                    break;
+                }
+                m_now = boundary - 1;
+            }
+
+            ++m_now;
+
+            if ((m_now & (SLOTS - 1)) == 0)
+            {
+                for (std::size_t level = 1; level < LEVELS; ++level)
+                {
+                    std::size_t slot = (m_now >> (SLOT_BITS * level)) & (SLOTS - 1);
+                    cascade(level * SLOTS + slot);
+                    if (slot != 0)
+                        break;
+                }
+            }
+
+            fired += fire_list(m_now & (SLOTS - 1));
+        }
+
+        return fired;
+    }
+
+    std::optional<platform::time::MonoPoint> TimerWheel::next_wakeup() const noexcept
+    {
+        if (m_size == 0)
+            return std::nullopt;
+
+        if (m_heads[OVERDUE] != NIL)
+            return point_of(m_now);
+
+        std::optional<Tick> best;
+        for (std::size_t level = 0; level < LEVELS; ++level)
+        {
+            std::uint64_t bits = m_occupied[level];
+            if (bits == 0)
+                continue;
+
+            // 从当前槽的下一个开始找第一个非空槽
+            Tick base = m_now >> (SLOT_BITS * level);
+            int cur = static_cast<int>(base & (SLOTS - 1));
+            std::uint64_t rotated = std::rotr(bits, (cur + 1) % static_cast<int>(SLOTS));
+            Tick step = static_cast<Tick>(std::countr_zero(rotated)) + 1;
+
+            // 第 0 层为触发时刻，高层为下放时刻
+            Tick t = (base + step) << (SLOT_BITS * level);
+            if (!best || t < *best)
+                best = t;
+        }
+
+        return point_of(*best);
+    }
+
+    util::ResultV<TimerService> TimerService::create(std::chrono::nanoseconds resolution)
+    {
+        using Ret = util::ResultV<TimerService>;
+        using util::Error;
+
+        platform::fd::Fd tfd(::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC));
+        if (!tfd.valid())
+        {
+            int err_no = errno;
+            return Ret::Err(
+                Error::system()
+                    .code(err_no)
+                    .set_category(from_errno(err_no))
+                    .message("Failed to create timerfd")
+                    .context("timerfd_create")
+                    .build());
+        }
+
+        return Ret::Ok(TimerService(std::move(tfd), resolution));
+    }
+
+    TimerService::TimerService(platform::fd::Fd tfd, std::chrono::nanoseconds resolution)
+        : m_tfd(std::move(tfd)),
+          m_wheel(resolution) {}
+
+    util::ResultV<void>
+    TimerService::attach(
+        platform::poller::Poller &poller,
+        void *tag)
+    {
+        auto events = static_cast<std::uint32_t>(platform::poller::PollEventType::Read);
+        if (tag)
+            return poller.add(fd(), events, tag);
+        return poller.add(fd(), events);
+    }
+
+    util::ResultV<TimerId>
+    TimerService::schedule(platform::time::MonoPoint deadline, Callback cb)
+    {
+        using Ret = util::ResultV<TimerId>;
+
+        TimerId id = m_wheel.schedule(deadline, std::move(cb));
+
+        // 仅在新定时器比当前装填时刻更早时才需要重新 settime
+        auto wake = m_wheel.next_wakeup();
+        if (!m_armed || (wake && *wake < *m_armed))
+        {
+            auto r = rearm();
+            if (r.is_err())
+            {
+                m_wheel.cancel(id);
+                return Ret::Err(r.unwrap_err());
+            }
+        }
+
+        return Ret::Ok(id);
+    }
+
+    util::ResultV<TimerId>
+    TimerService::schedule_after(std::chrono::nanoseconds delay, Callback cb)
+    {
+        return schedule(
+            platform::time::monotonic_now() +
+                std::chrono::duration_cast<platform::time::MonoClock::duration>(delay),
+            std::move(cb));
+    }
+
+    util::ResultV<std::size_t> TimerService::dispatch()
+    {
+        using Ret = util::ResultV<std::size_t>;
+        using util::Error;
+
+        std::uint64_t expirations = 0;
+        ssize_t n = ::read(m_tfd.get(), &expirations, sizeof(expirations));
+        if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            int err_no = errno;
+            return Ret::Err(
+                Error::system()
+                    .code(err_no)
+                    .set_category(from_errno(err_no))
+                    .message("Failed to read timerfd")
+                    .context("TimerService.dispatch")
+                    .build());
+        }
+
+        m_armed.reset();
+        std::size_t fired = m_wheel.advance(platform::time::monotonic_now());
+
+        auto r = rearm();
+        if (r.is_err())
+            return Ret::Err(r.unwrap_err());
+
+        return Ret::Ok(fired);
+    }
+
+    util::ResultV<void> TimerService::rearm()
+    {
+        using Ret = util::ResultV<void>;
+        using util::Error;
+
+        itimerspec spec{};
+        auto wake = m_wheel.next_wakeup();
+        if (wake)
+        {
+            // steady_clock 与 CLOCK_MONOTONIC 同源，可直接作为绝对时间
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          wake->time_since_epoch())
+                          .count();
+            if (ns <= 0)
+                ns = 1; // 全零会解除装填
+            spec.it_value.tv_sec = ns / 1000000000;
+            spec.it_value.tv_nsec = ns % 1000000000;
+        }
+
+        if (::timerfd_settime(m_tfd.get(), TFD_TIMER_ABSTIME, &spec, nullptr) < 0)
+        {
+            int err_no = errno;
+            return Ret::Err(
+                Error::system()
+                    .code(err_no)
+                    .set_category(from_errno(err_no))
+                    .message("Failed to arm timerfd")
+                    .context("timerfd_settime")
+                    .build());
+        }
+
+        m_armed = wake;
+        return Ret::Ok();
+    }
+}
@@ -343,6 +343,16 @@ namespace ui
         screen_.PostEvent(Event::ArrowUp);
     }
 
+    void TuiApp::load(std::vector<core::EventSnapshot> snaps)
+    {
+        reset_session();
+
+        std::lock_guard lock(data_mtx_);
+        if (snaps.size() > MAX_EVENTS)
+            snaps.erase(snaps.begin(), snaps.end() - MAX_EVENTS);
+        pending_ = std::move(snaps);
+    }
+
     void TuiApp::on_new_event(
         const core::EventSnapshot &snap)
     {
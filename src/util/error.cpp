@@ -73,8 +73,18 @@ namespace util
     ErrorCategory Error::category() const noexcept { return m_data ? m_data->category : ErrorCategory::Unknown; }
     int Error::code() const noexcept { return m_data ? m_data->code : 0; }
     std::string Error::message() const noexcept { return m_data ? m_data->message : "Success"; }
+    ErrorSeverity Error::severity() const noexcept { return m_data ? m_data->severity : ErrorSeverity::Logic; }
+    std::string Error::context() const noexcept { return m_data ? m_data->context : std::string{}; }
     const Error *Error::cause() const noexcept { return m_cause.get(); }
 
+    ErrorCategory Error::root_category() const noexcept
+    {
+        const Error *e = this;
+        while (e->category() == ErrorCategory::Unknown && e->cause())
+            e = e->cause();
+        return e->category();
+    }
+
     std::string Error::format() const
     {
         if (is_ok())
@@ -0,0 +1,198 @@
+/*
+ * ============================================================================
+ *  File Name   : hdr_histogram.cpp
+ *  Module      : util
+ *
+ *  Description :
+ *      HdrHistogram 的实现。计数槽布局：第 0 桶占满全部子桶，
+ *      其余每个桶只使用上半部分子桶（下半部分与前一桶重叠）。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/util/hdr_histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace util
+{
+    HdrHistogram::HdrHistogram(
+        std::int64_t lowest,
+        std::int64_t highest,
+        int significant_figures)
+    {
+        m_lowest = std::max<std::int64_t>(1, lowest);
+        m_highest = std::max(highest, 2 * m_lowest);
+        m_sig_figs = std::clamp(significant_figures, 1, 5);
+        m_min = std::numeric_limits<std::int64_t>::max();
+
+        // 单位精度下需要区分的最大值决定每个桶的子桶数
+        std::int64_t largest_single_unit = 2;
+        for (int i = 0; i < m_sig_figs; ++i)
+            largest_single_unit *= 10;
+
+        int sub_bucket_count_magnitude =
+            static_cast<int>(std::ceil(std::log2(static_cast<double>(largest_single_unit))));
+        m_sub_bucket_half_count_magnitude = std::max(sub_bucket_count_magnitude, 1) - 1;
+        m_unit_magnitude = static_cast<int>(std::floor(std::log2(static_cast<double>(m_lowest))));
+
+        m_sub_bucket_count = std::int64_t{1} << (m_sub_bucket_half_count_magnitude + 1);
+        m_sub_bucket_half_count = m_sub_bucket_count / 2;
+        m_sub_bucket_mask = (m_sub_bucket_count - 1) << m_unit_magnitude;
+
+        std::int64_t smallest_untrackable = m_sub_bucket_count << m_unit_magnitude;
+        int buckets = 1;
+        while (smallest_untrackable <= m_highest)
+        {
+            if (smallest_untrackable > std::numeric_limits<std::int64_t>::max() / 2)
+            {
+                ++buckets;
+                break;
+            }
+            smallest_untrackable <<= 1;
+            ++buckets;
+        }
+        m_bucket_count = buckets;
+
+        m_counts.assign(
+            static_cast<std::size_t>((m_bucket_count + 1) * m_sub_bucket_half_count), 0);
+    }
+
+    void HdrHistogram::record(std::int64_t value, std::uint64_t count) noexcept
+    {
+        if (count == 0)
+            return;
+
+        value = std::max<std::int64_t>(value, 0);
+        if (value > m_highest)
+        {
+            value = m_highest;
+            m_clamped += count;
+        }
+
+        m_counts[counts_index_for(value)] += count;
+        m_total += count;
+        m_sum += static_cast<double>(value) * static_cast<double>(count);
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    bool HdrHistogram::merge(const HdrHistogram &other) noexcept
+    {
+        if (other.m_lowest != m_lowest ||
+            other.m_highest != m_highest ||
+            other.m_sig_figs != m_sig_figs)
+            return false;
+
+        for (std::size_t i = 0; i < m_counts.size(); ++i)
+            m_counts[i] += other.m_counts[i];
+
+        m_total += other.m_total;
+        m_clamped += other.m_clamped;
+        m_sum += other.m_sum;
+        if (other.m_total)
+        {
+            m_min = std::min(m_min, other.m_min);
+            m_max = std::max(m_max, other.m_max);
+        }
+        return true;
+    }
+
+    void HdrHistogram::reset() noexcept
+    {
+        std::fill(m_counts.begin(), m_counts.end(), 0);
+        m_total = 0;
+        m_clamped = 0;
+        m_sum = 0.0;
+        m_min = std::numeric_limits<std::int64_t>::max();
+        m_max = 0;
+    }
+
+    std::int64_t HdrHistogram::value_at_percentile(double percentile) const noexcept
+    {
+        if (m_total == 0)
+            return 0;
+
+        double p = std::clamp(percentile, 0.0, 100.0);
+        auto target = static_cast<std::uint64_t>(
+            std::ceil(p / 100.0 * static_cast<double>(m_total)));
+        target = std::max<std::uint64_t>(target, 1);
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < m_counts.size(); ++i)
+        {
+            seen += m_counts[i];
+            if (seen >= target)
+                return std::min(highest_equivalent(value_at_index(i)), m_max);
+        }
+        return m_max;
+    }
+
+    std::int64_t HdrHistogram::lowest_equivalent(std::int64_t value) const noexcept
+    {
+        int b = bucket_index(value);
+        int sb = sub_bucket_index(value, b);
+        return value_from(b, sb);
+    }
+
+    std::int64_t HdrHistogram::highest_equivalent(std::int64_t value) const noexcept
+    {
+        int b = bucket_index(value);
+        int sb = sub_bucket_index(value, b);
+        int adjusted = sb >= m_sub_bucket_count ? b + 1 : b;
+        std::int64_t range = std::int64_t{1} << (m_unit_magnitude + adjusted);
+        return value_from(b, sb) + range - 1;
+    }
+
+    int HdrHistogram::bucket_index(std::int64_t value) const noexcept
+    {
+        // 以子桶掩码兜底，保证小于一个完整子桶范围的数值落入第 0 桶
+        auto v = static_cast<std::uint64_t>(value | m_sub_bucket_mask);
+        int pow2_ceiling = 64 - std::countl_zero(v);
+        return pow2_ceiling - m_unit_magnitude - (m_sub_bucket_half_count_magnitude + 1);
+    }
+
+    int HdrHistogram::sub_bucket_index(std::int64_t value, int bucket) const noexcept
+    {
+        return static_cast<int>(value >> (bucket + m_unit_magnitude));
+    }
+
+    std::size_t HdrHistogram::counts_index(int bucket, int sub_bucket) const noexcept
+    {
+        std::int64_t base = static_cast<std::int64_t>(bucket + 1) << m_sub_bucket_half_count_magnitude;
+        return static_cast<std::size_t>(base + (sub_bucket - m_sub_bucket_half_count));
+    }
+
+    std::size_t HdrHistogram::counts_index_for(std::int64_t value) const noexcept
+    {
+        int b = bucket_index(value);
+        return counts_index(b, sub_bucket_index(value, b));
+    }
+
+    std::int64_t HdrHistogram::value_at_index(std::size_t index) const noexcept
+    {
+        auto i = static_cast<std::int64_t>(index);
+        int bucket = static_cast<int>(i >> m_sub_bucket_half_count_magnitude) - 1;
+        int sub_bucket = static_cast<int>((i & (m_sub_bucket_half_count - 1)) + m_sub_bucket_half_count);
+        if (bucket < 0)
+        {
+            sub_bucket -= static_cast<int>(m_sub_bucket_half_count);
+            bucket = 0;
+        }
+        return value_from(bucket, sub_bucket);
+    }
+
+    std::int64_t HdrHistogram::value_from(int bucket, int sub_bucket) const noexcept
+    {
+        return static_cast<std::int64_t>(sub_bucket) << (bucket + m_unit_magnitude);
+    }
+}
@@ -0,0 +1,207 @@
+/*
+ * ============================================================================
+ *  File Name   : lz_block.cpp
+ *  Module      : util
+ *
+ *  Description :
+ *      LZ77 块压缩实现。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/util/lz_block.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace util::lz
+{
+    namespace
+    {
+        constexpr int HASH_BITS = 14;
+        constexpr std::size_t MIN_MATCH = 4;
+        constexpr std::size_t MAX_OFFSET = 65535;
+        constexpr std::size_t LAST_LITERALS = 5; // 末尾至少保留的字面量
+        constexpr std::size_t MATCH_LIMIT = 12;  // 距末尾不足此数时不再开始新的匹配
+
+        std::uint32_t read32(const std::byte *p) noexcept
+        {
+            std::uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        std::uint32_t hash(std::uint32_t v) noexcept
+        {
+            return (v * 2654435761u) >> (32 - HASH_BITS);
+        }
+
+        void put_length(std::vector<std::byte> &out, std::size_t n)
+        {
+            for (; n >= 255; n -= 255)
+                out.push_back(std::byte{255});
+            out.push_back(static_cast<std::byte>(n));
+        }
+
+        /** match_len 为 0 表示只有字面量的最后一个序列 */
+        void put_sequence(
+            std::vector<std::byte> &out,
+            const std::byte *literals,
+            std::size_t lit_len,
+            std::size_t offset,
+            std::size_t match_len)
+        {
+            std::size_t m = match_len ? match_len - MIN_MATCH : 0;
+            auto token = static_cast<std::uint8_t>((std::min<std::size_t>(lit_len, 15) << 4) |
+                                                   std::min<std::size_t>(m, 15));
+            out.push_back(static_cast<std::byte>(token));
+            if (lit_len >= 15)
+                put_length(out, lit_len - 15);
+            out.insert(out.end(), literals, literals + lit_len);
+
+            if (!match_len)
+                return;
+
+            out.push_back(static_cast<std::byte>(offset & 0xFF));
+            out.push_back(static_cast<std::byte>(offset >> 8));
+            if (m >= 15)
+                put_length(out, m - 15);
+        }
+
+        /** 读取扩展长度，输入耗尽时返回 false */
+        bool get_length(std::span<const std::byte> src, std::size_t &ip, std::size_t &n) noexcept
+        {
+            std::uint8_t b;
+            do
+            {
+                if (ip >= src.size())
+                    return false;
+                b = static_cast<std::uint8_t>(src[ip++]);
+                n += b;
+            } while (b == 255);
+            return true;
+        }
+
+        util::Error corrupt(const char *what)
+        {
+            return util::Error::state()
+                .data_truncated()
+                .message("Corrupt compressed block")
+                .context(what)
+                .build();
+        }
+    }
+
+    std::size_t compress(std::span<const std::byte> src, std::vector<std::byte> &out)
+    {
+        const std::size_t start = out.size();
+        const std::size_t n = src.size();
+        const std::byte *base = src.data();
+        out.reserve(start + max_compressed_size(n));
+
+        std::size_t anchor = 0;
+        if (n > MATCH_LIMIT)
+        {
+            std::vector<std::uint32_t> table(std::size_t{1} << HASH_BITS, 0);
+            const std::size_t limit = n - MATCH_LIMIT;
+            const std::size_t match_end = n - LAST_LITERALS;
+
+            std::size_t ip = 0;
+            while (ip < limit)
+            {
+                std::uint32_t seq = read32(base + ip);
+                auto &slot = table[hash(seq)];
+                std::size_t ref = slot;
+                slot = static_cast<std::uint32_t>(ip);
+
+                if (ref >= ip || ip - ref > MAX_OFFSET || read32(base + ref) != seq)
+                {
+                    // 长时间没有匹配时加大步长，避免在不可压缩的数据上空转
+                    ip += 1 + ((ip - anchor) >> 6);
+                    continue;
+                }
+
+                // 向前扩展匹配，吸收与之相同的字面量
+                while (ip > anchor && ref > 0 && base[ip - 1] == base[ref - 1])
+                {
+                    --ip;
+                    --ref;
+                }
+
+                std::size_t len = MIN_MATCH;
+                while (ip + len < match_end && base[ip + len] == base[ref + len])
+                    ++len;
+
+                put_sequence(out, base + anchor, ip - anchor, ip - ref, len);
+                ip += len;
+                anchor = ip;
+
+                if (ip - 2 < limit)
+                    table[hash(read32(base + ip - 2))] = static_cast<std::uint32_t>(ip - 2);
+            }
+        }
+
+        put_sequence(out, base + anchor, n - anchor, 0, 0);
+        return out.size() - start;
+    }
+
+    ResultV<void> decompress(std::span<const std::byte> src, std::span<std::byte> dst)
+    {
+        using Ret = ResultV<void>;
+
+        std::size_t ip = 0, op = 0;
+        while (ip < src.size())
+        {
+            auto token = static_cast<std::uint8_t>(src[ip++]);
+
+            std::size_t lit = token >> 4;
+            if (lit == 15 && !get_length(src, ip, lit))
+                return Ret::Err(corrupt("literal length"));
+            if (lit > src.size() - ip || lit > dst.size() - op)
+                return Ret::Err(corrupt("literals out of range"));
+            if (lit)
+                std::memcpy(dst.data() + op, src.data() + ip, lit);
+            ip += lit;
+            op += lit;
+
+            if (ip == src.size())
+                break;
+
+            if (src.size() - ip < 2)
+                return Ret::Err(corrupt("offset"));
+            std::size_t offset = static_cast<std::size_t>(src[ip]) |
+                                 (static_cast<std::size_t>(src[ip + 1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > op)
+                return Ret::Err(corrupt("offset out of range"));
+
+            std::size_t len = token & 0x0F;
+            if (len == 15 && !get_length(src, ip, len))
+                return Ret::Err(corrupt("match length"));
+            len += MIN_MATCH;
+            if (len > dst.size() - op)
+                return Ret::Err(corrupt("match out of range"));
+
+            // 距离小于长度时源与目标重叠，需逐字节复制以重复前面的内容
+            std::byte *d = dst.data() + op;
+            const std::byte *s = d - offset;
+            if (offset >= len)
+                std::memcpy(d, s, len);
+            else
+                for (std::size_t i = 0; i < len; ++i)
+                    d[i] = s[i];
+            op += len;
+        }
+
+        if (op != dst.size())
+            return Ret::Err(corrupt("length mismatch"));
+        return Ret::Ok();
+    }
+}
@@ -0,0 +1,564 @@
+/*
+ * ============================================================================
+ *  File Name   : roaring_bitmap.cpp
+ *  Module      : util
+ *
+ *  Description :
+ *      RoaringBitmap 的实现。稀疏块之间的交集按长度比例选择归并或
+ *      galloping 查找；稠密块的按字运算在首次使用时根据 CPU 能力选择
+ *      AVX2 或标量实现，无需额外的编译选项。
+ *
+ *  Third-Party Dependencies :
+ *      None
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include "eunet/util/roaring_bitmap.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define EUNET_ROARING_AVX2 1
+#endif
+
+namespace util
+{
+    namespace
+    {
+        using WordOp = std::uint32_t (*)(const std::uint64_t *, const std::uint64_t *, std::uint64_t *, std::size_t);
+        using WordCount = std::uint32_t (*)(const std::uint64_t *, const std::uint64_t *, std::size_t);
+
+        std::uint32_t and_scalar(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::size_t n)
+        {
+            std::uint32_t card = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                out[i] = a[i] & b[i];
+                card += std::popcount(out[i]);
+            }
+            return card;
+        }
+
+        std::uint32_t or_scalar(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::size_t n)
+        {
+            std::uint32_t card = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                out[i] = a[i] | b[i];
+                card += std::popcount(out[i]);
+            }
+            return card;
+        }
+
+        std::uint32_t and_count_scalar(const std::uint64_t *a, const std::uint64_t *b, std::size_t n)
+        {
+            std::uint32_t card = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                card += std::popcount(a[i] & b[i]);
+            return card;
+        }
+
+#ifdef EUNET_ROARING_AVX2
+        // n 为 4 的倍数（位集固定 1024 个字）
+        __attribute__((target("avx2,popcnt"))) std::uint32_t
+        and_avx2(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::size_t n)
+        {
+            std::uint64_t card = 0;
+            for (std::size_t i = 0; i < n; i += 4)
+            {
+                __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_and_si256(va, vb));
+                card += _mm_popcnt_u64(out[i]) + _mm_popcnt_u64(out[i + 1]) +
+                        _mm_popcnt_u64(out[i + 2]) + _mm_popcnt_u64(out[i + 3]);
+            }
+            return static_cast<std::uint32_t>(card);
+        }
+
+        __attribute__((target("avx2,popcnt"))) std::uint32_t
+        or_avx2(const std::uint64_t *a, const std::uint64_t *b, std::uint64_t *out, std::size_t n)
+        {
+            std::uint64_t card = 0;
+            for (std::size_t i = 0; i < n; i += 4)
+            {
+                __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_or_si256(va, vb));
+                card += _mm_popcnt_u64(out[i]) + _mm_popcnt_u64(out[i + 1]) +
+                        _mm_popcnt_u64(out[i + 2]) + _mm_popcnt_u64(out[i + 3]);
+            }
+            return static_cast<std::uint32_t>(card);
+        }
+
+        __attribute__((target("avx2,popcnt"))) std::uint32_t
+        and_count_avx2(const std::uint64_t *a, const std::uint64_t *b, std::size_t n)
+        {
+            std::uint64_t card = 0;
+            for (std::size_t i = 0; i < n; i += 4)
+            {
+                __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                __m256i r = _mm256_and_si256(va, vb);
+                card += _mm_popcnt_u64(static_cast<std::uint64_t>(_mm256_extract_epi64(r, 0))) +
+                        _mm_popcnt_u64(static_cast<std::uint64_t>(_mm256_extract_epi64(r, 1))) +
+                        _mm_popcnt_u64(static_cast<std::uint64_t>(_mm256_extract_epi64(r, 2))) +
+                        _mm_popcnt_u64(static_cast<std::uint64_t>(_mm256_extract_epi64(r, 3)));
+            }
+            return static_cast<std::uint32_t>(card);
+        }
+#endif
+
+        struct Kernels
+        {
+            WordOp and_words;
+            WordOp or_words;
+            WordCount and_count;
+            const char *name;
+        };
+
+        const Kernels &kernels()
+        {
+            static const Kernels k = []
+            {
+#ifdef EUNET_ROARING_AVX2
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+                    return Kernels{and_avx2, or_avx2, and_count_avx2, "avx2"};
+#endif
+                return Kernels{and_scalar, or_scalar, and_count_scalar, "scalar"};
+            }();
+            return k;
+        }
+
+        bool test_bit(const std::vector<std::uint64_t> &bits, std::uint16_t v) noexcept
+        {
+            return (bits[v >> 6] >> (v & 63)) & 1u;
+        }
+
+        // 长度悬殊时在长数组上跳跃查找，否则直接归并
+        template <typename Out>
+        void intersect_arrays(
+            const std::vector<std::uint16_t> &a,
+            const std::vector<std::uint16_t> &b,
+            Out out)
+        {
+            const auto &small = a.size() <= b.size() ? a : b;
+            const auto &large = a.size() <= b.size() ? b : a;
+
+            if (small.size() * 32 < large.size())
+            {
+                auto it = large.begin();
+                for (auto v : small)
+                {
+                    // 指数步长找到上界后再二分
+                    std::size_t step = 1;
+                    auto hi = it;
+                    while (hi != large.end() && *hi < v)
+                    {
+                        it = hi;
+                        hi = static_cast<std::size_t>(large.end() - hi) > step ? hi + step : large.end();
+                        step <<= 1;
+                    }
+                    it = std::lower_bound(it, hi, v);
+                    if (it == large.end())
+                        break;
+                    if (*it == v)
+                        out(v);
+                }
+                return;
+            }
+
+            auto i = a.begin(), j = b.begin();
+            while (i != a.end() && j != b.end())
+            {
+                if (*i < *j)
+                    ++i;
+                else if (*j < *i)
+                    ++j;
+                else
+                {
+                    out(*i);
+                    ++i;
+                    ++j;
+                }
+            }
+        }
+    }
+
+    void RoaringBitmap::add(std::uint32_t v)
+    {
+        auto key = static_cast<std::uint16_t>(v >> 16);
+        auto low = static_cast<std::uint16_t>(v & 0xFFFF);
+
+        // 升序追加时总是落在最后一个块
+        Container *c;
+        if (!m_containers.empty() && m_containers.back().key == key)
+            c = &m_containers.back();
+        else if (m_containers.empty() || m_containers.back().key < key)
+        {
+            m_containers.emplace_back();
+            m_containers.back().key = key;
+            c = &m_containers.back();
+        }
+        else
+            c = find_or_insert(key);
+
+        if (c->is_bitset())
+        {
+            auto &word = c->bits[low >> 6];
+            std::uint64_t mask = std::uint64_t{1} << (low & 63);
+            if (word & mask)
+                return;
+            word |= mask;
+        }
+        else if (c->array.empty() || c->array.back() < low)
+        {
+            c->array.push_back(low);
+        }
+        else
+        {
+            auto it = std::lower_bound(c->array.begin(), c->array.end(), low);
+            if (*it == low)
+                return;
+            c->array.insert(it, low);
+        }
+
+        ++c->card;
+        ++m_card;
+
+        if (!c->is_bitset() && c->card > ARRAY_MAX)
+            to_bitset(*c);
+    }
+
+    bool RoaringBitmap::contains(std::uint32_t v) const noexcept
+    {
+        const Container *c = find(static_cast<std::uint16_t>(v >> 16));
+        if (!c)
+            return false;
+
+        auto low = static_cast<std::uint16_t>(v & 0xFFFF);
+        return c->is_bitset()
+                   ? test_bit(c->bits, low)
+                   : std::binary_search(c->array.begin(), c->array.end(), low);
+    }
+
+    void RoaringBitmap::remove_from(std::uint32_t v)
+    {
+        auto key = static_cast<std::uint16_t>(v >> 16);
+        auto low = static_cast<std::uint16_t>(v & 0xFFFF);
+
+        while (!m_containers.empty() && m_containers.back().key > key)
+        {
+            m_card -= m_containers.back().card;
+            m_containers.pop_back();
+        }
+
+        if (m_containers.empty() || m_containers.back().key != key)
+            return;
+
+        Container &c = m_containers.back();
+        m_card -= c.card;
+
+        if (c.is_bitset())
+        {
+            // 清掉 low 所在字中 >= low 的位以及之后的所有字
+            std::size_t w = low >> 6;
+            c.bits[w] &= (std::uint64_t{1} << (low & 63)) - 1;
+            std::fill(c.bits.begin() + w + 1, c.bits.end(), 0);
+
+            c.card = 0;
+            for (auto word : c.bits)
+                c.card += std::popcount(word);
+            if (c.card <= ARRAY_MAX)
+                to_array(c);
+        }
+        else
+        {
+            c.array.erase(std::lower_bound(c.array.begin(), c.array.end(), low), c.array.end());
+            c.card = static_cast<std::uint32_t>(c.array.size());
+        }
+
+        m_card += c.card;
+        if (c.card == 0)
+            m_containers.pop_back();
+    }
+
+    void RoaringBitmap::clear() noexcept
+    {
+        m_containers.clear();
+        m_card = 0;
+    }
+
+    std::uint32_t RoaringBitmap::minimum() const noexcept
+    {
+        if (m_containers.empty())
+            return 0;
+
+        const Container &c = m_containers.front();
+        std::uint32_t base = static_cast<std::uint32_t>(c.key) << 16;
+        if (!c.is_bitset())
+            return base + c.array.front();
+
+        for (std::size_t w = 0; w < BITSET_WORDS; ++w)
+            if (c.bits[w])
+                return base + static_cast<std::uint32_t>(w * 64 + std::countr_zero(c.bits[w]));
+        return base;
+    }
+
+    std::uint32_t RoaringBitmap::maximum() const noexcept
+    {
+        if (m_containers.empty())
+            return 0;
+
+        const Container &c = m_containers.back();
+        std::uint32_t base = static_cast<std::uint32_t>(c.key) << 16;
+        if (!c.is_bitset())
+            return base + c.array.back();
+
+        for (std::size_t w = BITSET_WORDS; w-- > 0;)
+            if (c.bits[w])
+                return base + static_cast<std::uint32_t>(w * 64 + 63 - std::countl_zero(c.bits[w]));
+        return base;
+    }
+
+    RoaringBitmap RoaringBitmap::intersect(const RoaringBitmap &a, const RoaringBitmap &b)
+    {
+        RoaringBitmap out;
+
+        auto i = a.m_containers.begin(), j = b.m_containers.begin();
+        while (i != a.m_containers.end() && j != b.m_containers.end())
+        {
+            if (i->key < j->key)
+                ++i;
+            else if (j->key < i->key)
+                ++j;
+            else
+            {
+                Container c = intersect(*i, *j);
+                if (c.card)
+                {
+                    out.m_card += c.card;
+                    out.m_containers.push_back(std::move(c));
+                }
+                ++i;
+                ++j;
+            }
+        }
+
+        return out;
+    }
+
+    RoaringBitmap RoaringBitmap::unite(const RoaringBitmap &a, const RoaringBitmap &b)
+    {
+        RoaringBitmap out;
+
+        auto i = a.m_containers.begin(), j = b.m_containers.begin();
+        while (i != a.m_containers.end() || j != b.m_containers.end())
+        {
+            if (j == b.m_containers.end() || (i != a.m_containers.end() && i->key < j->key))
+                out.m_containers.push_back(*i++);
+            else if (i == a.m_containers.end() || j->key < i->key)
+                out.m_containers.push_back(*j++);
+            else
+                out.m_containers.push_back(unite(*i++, *j++));
+
+            out.m_card += out.m_containers.back().card;
+        }
+
+        return out;
+    }
+
+    std::size_t RoaringBitmap::intersect_count(const RoaringBitmap &a, const RoaringBitmap &b)
+    {
+        std::size_t card = 0;
+
+        auto i = a.m_containers.begin(), j = b.m_containers.begin();
+        while (i != a.m_containers.end() && j != b.m_containers.end())
+        {
+            if (i->key < j->key)
+                ++i;
+            else if (j->key < i->key)
+                ++j;
+            else
+                card += intersect_count(*i++, *j++);
+        }
+
+        return card;
+    }
+
+    std::vector<std::uint32_t> RoaringBitmap::to_vector() const
+    {
+        std::vector<std::uint32_t> out;
+        out.reserve(m_card);
+        for_each([&](std::uint32_t v)
+                 { out.push_back(v); });
+        return out;
+    }
+
+    std::size_t RoaringBitmap::memory_bytes() const noexcept
+    {
+        std::size_t bytes = m_containers.capacity() * sizeof(Container);
+        for (const auto &c : m_containers)
+            bytes += c.array.capacity() * sizeof(std::uint16_t) + c.bits.capacity() * sizeof(std::uint64_t);
+        return bytes;
+    }
+
+    const char *RoaringBitmap::simd_backend() noexcept
+    {
+        return kernels().name;
+    }
+
+    RoaringBitmap::Container *
+    RoaringBitmap::find_or_insert(std::uint16_t key)
+    {
+        auto it = std::lower_bound(
+            m_containers.begin(), m_containers.end(), key,
+            [](const Container &c, std::uint16_t k)
+            { return c.key < k; });
+
+        if (it == m_containers.end() || it->key != key)
+        {
+            it = m_containers.insert(it, Container{});
+            it->key = key;
+        }
+        return &*it;
+    }
+
+    const RoaringBitmap::Container *
+    RoaringBitmap::find(std::uint16_t key) const noexcept
+    {
+        auto it = std::lower_bound(
+            m_containers.begin(), m_containers.end(), key,
+            [](const Container &c, std::uint16_t k)
+            { return c.key < k; });
+
+        return it != m_containers.end() && it->key == key ? &*it : nullptr;
+    }
+
+    void RoaringBitmap::to_bitset(Container &c)
+    {
+        c.bits.assign(BITSET_WORDS, 0);
+        for (auto v : c.array)
+            c.bits[v >> 6] |= std::uint64_t{1} << (v & 63);
+
+        c.array.clear();
+        c.array.shrink_to_fit();
+    }
+
+    void RoaringBitmap::to_array(Container &c)
+    {
+        c.array.clear();
+        c.array.reserve(c.card);
+        for (std::size_t w = 0; w < BITSET_WORDS; ++w)
+        {
+            std::uint64_t word = c.bits[w];
+            while (word)
+            {
+                c.array.push_back(static_cast<std::uint16_t>(w * 64 + std::countr_zero(word)));
+                word &= word - 1;
+            }
+        }
+
+        c.bits.clear();
+        c.bits.shrink_to_fit();
+    }
+
+    RoaringBitmap::Container
+    RoaringBitmap::intersect(const Container &a, const Container &b)
+    {
+        Container out;
+        out.key = a.key;
+
+        if (a.is_bitset() && b.is_bitset())
+        {
+            out.bits.resize(BITSET_WORDS);
+            out.card = kernels().and_words(a.bits.data(), b.bits.data(), out.bits.data(), BITSET_WORDS);
+            if (out.card <= ARRAY_MAX)
+                to_array(out);
+        }
+        else if (a.is_bitset() || b.is_bitset())
+        {
+            const auto &bits = a.is_bitset() ? a : b;
+            const auto &arr = a.is_bitset() ? b : a;
+            for (auto v : arr.array)
+                if (test_bit(bits.bits, v))
+                    out.array.push_back(v);
+            out.card = static_cast<std::uint32_t>(out.array.size());
+        }
+        else
+        {
+            intersect_arrays(a.array, b.array, [&](std::uint16_t v)
+                             { out.array.push_back(v); });
+            out.card = static_cast<std::uint32_t>(out.array.size());
+        }
+
+        return out;
+    }
+
+    RoaringBitmap::Container
+    RoaringBitmap::unite(const Container &a, const Container &b)
+    {
+        Container out;
+        out.key = a.key;
+
+        if (a.is_bitset() && b.is_bitset())
+        {
+            out.bits.resize(BITSET_WORDS);
+            out.card = kernels().or_words(a.bits.data(), b.bits.data(), out.bits.data(), BITSET_WORDS);
+        }
+        else if (a.is_bitset() || b.is_bitset())
+        {
+            const auto &bits = a.is_bitset() ? a : b;
+            const auto &arr = a.is_bitset() ? b : a;
+            out.bits = bits.bits;
+            out.card = bits.card;
+            for (auto v : arr.array)
+            {
+                auto &word = out.bits[v >> 6];
+                std::uint64_t mask = std::uint64_t{1} << (v & 63);
+                out.card += (word & mask) == 0;
+                word |= mask;
+            }
+        }
+        else
+        {
+            out.array.reserve(a.array.size() + b.array.size());
+            std::set_union(
+                a.array.begin(), a.array.end(),
+                b.array.begin(), b.array.end(),
+                std::back_inserter(out.array));
+            out.card = static_cast<std::uint32_t>(out.array.size());
+            if (out.card > ARRAY_MAX)
+                to_bitset(out);
+        }
+
+        return out;
+    }
+
+    std::uint32_t RoaringBitmap::intersect_count(const Container &a, const Container &b)
+    {
+        if (a.is_bitset() && b.is_bitset())
+            return kernels().and_count(a.bits.data(), b.bits.data(), BITSET_WORDS);
+
+        std::uint32_t card = 0;
+        if (a.is_bitset() || b.is_bitset())
+        {
+            const auto &bits = a.is_bitset() ? a : b;
+            const auto &arr = a.is_bitset() ? b : a;
+            for (auto v : arr.array)
+                card += test_bit(bits.bits, v);
+            return card;
+        }
+
+        intersect_arrays(a.array, b.array, [&](std::uint16_t)
+                         { ++card; });
+        return card;
+    }
+}
@@ -0,0 +1,65 @@
+#include <cassert>
+#include <initializer_list>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "eunet/app/cli_options.hpp"
+
+static std::optional<app::CliOptions> parse(std::initializer_list<const char *> args)
+{
+    std::vector<std::string> store{"eunet_cli"};
+    store.insert(store.end(), args.begin(), args.end());
+    std::vector<char *> argv;
+    for (auto &s : store)
+        argv.push_back(s.data());
+    return app::parse_args(static_cast<int>(argv.size()), argv.data());
+}
+
+void test_record_with_bench()
+{
+    // 压测模式同样写追踪文件
+    auto opts = parse({"-c", "8", "-d", "1s", "--record", "bench.trace", "http://127.0.0.1/"});
+    assert(opts);
+    assert(opts->bench);
+    assert(opts->record_path == "bench.trace");
+    assert(opts->bench_cfg.connections == 8);
+    assert(opts->bench_cfg.url == "http://127.0.0.1/");
+
+    auto json = parse({"--json", "--record", "run.trace", "http://a/"});
+    assert(json && json->record_path == "run.trace");
+
+    std::cout << "[OK] test_record_with_bench\n";
+}
+
+void test_conflicts()
+{
+    assert(!parse({"--json", "-c", "4"}));
+    assert(!parse({"--events"}));
+    assert(!parse({"--open", "a.trace", "-c", "4"}));
+    assert(!parse({"--open", "a.trace", "--record", "b.trace"}));
+    assert(!parse({"--replay", "10x"}));
+    assert(!parse({"--record", ""}));
+
+    std::cout << "[OK] test_conflicts\n";
+}
+
+void test_spill()
+{
+    assert(!parse({"--memory", "64"}));
+    assert(!parse({"--spill", ""}));
+
+    auto opts = parse({"-c", "4", "--spill", "/tmp", "--memory", "64"});
+    assert(opts && opts->spill_dir == "/tmp" && opts->memory_mib == 64u);
+
+    std::cout << "[OK] test_spill\n";
+}
+
+int main()
+{
+    test_record_with_bench();
+    test_conflicts();
+    test_spill();
+    return 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * ============================================================================
+ *  File Name   : benchmark_cold_segment_test.cpp
+ *  Module      : test
+ *
+ *  Description :
+ *      冷数据段压缩基准测试。模拟 24 小时的合成监测：若干目标每 30 秒
+ *      探测一次，每次经历 DNS、建连、内核采样、HTTP 收发与关闭，
+ *      响应头只有 Date 与请求 ID 变化，响应体为带时间戳的相似 JSON，
+ *      偶有超时。把 Timeline 的每个段压缩为 ColdSegment，比较：
+ *          hot  : Timeline 上的查询
+ *          cold : 逐段在 ColdSegment 上执行同样的查询
+ *
+ *  Metrics :
+ *      - size     : Timeline 内存、原始追踪块与冷数据段的字节数及压缩比
+ *      - encode   : 压缩全部段的耗时与吞吐
+ *      - query    : 各查询在 hot / cold 上的耗时 (ms) 与变慢倍数
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "eunet/core/cold_segment.hpp"
+#include "eunet/core/timeline.hpp"
+
+using namespace core;
+using Clock = std::chrono::steady_clock;
+
+// ================= 配置参数 =================
+constexpr int TARGETS = 8;
+constexpr std::int64_t PROBE_INTERVAL_NS = 30'000'000'000; // 每个目标每 30 秒一次
+constexpr std::int64_t CAPTURE_NS = 24 * 3600 * 1'000'000'000LL;
+constexpr int BODY_CHUNKS = 2;
+constexpr int FAIL_EVERY = 97; // 约 1% 的探测超时
+
+double ms_since(Clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+std::vector<std::byte> bytes_of(const std::string &s)
+{
+    std::vector<std::byte> out(s.size());
+    for (std::size_t i = 0; i < s.size(); ++i)
+        out[i] = static_cast<std::byte>(s[i]);
+    return out;
+}
+
+void fill(Timeline &tl)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> jitter_us(200, 5000);
+    auto err = util::Error::transport().timeout().message("connect timeout").build();
+    platform::net::TcpInfo info{};
+    info.snd_cwnd = 10;
+    info.snd_mss = 1448;
+
+    std::int64_t start = platform::time::event_now() - CAPTURE_NS;
+    SessionId sid = 0;
+
+    for (std::int64_t t = 0; t < CAPTURE_NS; t += PROBE_INTERVAL_NS)
+    {
+        for (int target = 0; target < TARGETS; ++target)
+        {
+            ++sid;
+            int fd = 10 + target;
+            std::int64_t ts = start + t + target * 1'000'000;
+            std::string host = "probe" + std::to_string(target) + ".example.com";
+
+            auto push = [&](EventType type, MessageId msg, RecordExtras extras = {}, std::uint64_t arg = 0)
+            {
+                auto rec = make_record(type, msg, type == EventType::DNS_RESOLVE_START ||
+                                                          type == EventType::DNS_RESOLVE_DONE
+                                                      ? -1
+                                                      : fd,
+                                       sid);
+                ts += jitter_us(rng) * 1000;
+                rec.ts_ns = ts;
+                rec.args[0] = arg;
+                (void)tl.push(rec, extras);
+            };
+
+            push(EventType::DNS_RESOLVE_START, MessageId::ResolvingHost, {.text = host});
+            push(EventType::DNS_RESOLVE_DONE, MessageId::ResolvedTo, {.text = "10.0.0." + std::to_string(target + 1)});
+            push(EventType::TCP_CONNECT_START, MessageId::Connecting, {.text = host}, 443);
+            if (sid % FAIL_EVERY == 0)
+            {
+                push(EventType::TCP_CONNECT_TIMEOUT, MessageId::Text, {.text = "connect timeout", .error = &err});
+                continue;
+            }
+            push(EventType::TCP_CONNECT_SUCCESS, MessageId::ConnectionEstablished);
+
+            info.rtt_us = 800 + static_cast<std::uint32_t>(rng() % 400);
+            push(EventType::TCP_INFO_SAMPLE, MessageId::TcpInfoSample, {.tcp_info = &info});
+            push(EventType::HTTP_REQUEST_BUILD, MessageId::HttpGet, {.text = "/health"});
+            push(EventType::HTTP_SENT, MessageId::HttpRequestSent);
+
+            auto headers = "HTTP/1.1 200 OK\r\n"
+                           "Server: nginx/1.24.0\r\n"
+                           "Date: " + std::to_string((start + t) / 1'000'000'000) + "\r\n"
+                           "Content-Type: application/json\r\n"
+                           "Cache-Control: no-cache\r\n"
+                           "X-Request-Id: " + std::to_string(rng()) + "\r\n"
+                           "Connection: close\r\n";
+            push(EventType::HTTP_HEADERS_RECEIVED, MessageId::Text, {.text = headers});
+
+            auto body = bytes_of("{\"status\":\"ok\",\"target\":" + std::to_string(target) +
+                                 ",\"checked_at\":" + std::to_string(ts) +
+                                 ",\"components\":{\"db\":\"ok\",\"cache\":\"ok\",\"queue\":\"ok\"},"
+                                 "\"version\":\"2.14.1\",\"region\":\"eu-west-1\",\"padding\":\"" +
+                                 std::string(400, 'x') + "\"}");
+            for (int c = 0; c < BODY_CHUNKS; ++c)
+                push(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, {.payload = body}, body.size());
+            push(EventType::HTTP_BODY_DONE, MessageId::Text, {.text = "body done"});
+            push(EventType::CONNECTION_CLOSED, MessageId::ClosingConnection);
+        }
+    }
+}
+
+struct Row
+{
+    const char *name;
+    double hot_ms;
+    double cold_ms;
+    std::size_t hits;
+};
+
+void print(const Row &r)
+{
+    std::cout << "  " << std::left << std::setw(22) << r.name
+              << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << r.hot_ms << " ms"
+              << std::setw(10) << r.cold_ms << " ms"
+              << std::setw(8) << std::setprecision(1) << r.cold_ms / std::max(r.hot_ms, 1e-6) << "x"
+              << "  hits=" << r.hits << "\n";
+}
+
+int main()
+{
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Cold Segment] 24h capture, targets=" << TARGETS << "\n";
+
+    Timeline tl;
+    fill(tl);
+    auto snap = tl.snapshot();
+    std::cout << "  events      : " << tl.size() << "\n";
+
+    // 按 Timeline 的段边界逐段压缩
+    auto t0 = Clock::now();
+    std::vector<ColdSegment> segs;
+    std::size_t image = 0, cold_mem = 0;
+    for (std::size_t from = 0; from < snap.size(); from += Timeline::SEGMENT_CAPACITY)
+    {
+        segs.push_back(ColdSegment::compress(snap, from, Timeline::SEGMENT_CAPACITY).unwrap());
+        image += segs.back().image_bytes();
+    }
+    double encode_ms = ms_since(t0);
+    for (const auto &s : segs)
+        cold_mem += s.memory_bytes();
+
+    auto hot = tl.memory_bytes();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  timeline    : " << hot / (1024.0 * 1024.0) << " MiB ("
+              << static_cast<double>(hot) / tl.size() << " B/event)\n";
+    std::cout << "  cold image  : " << image / (1024.0 * 1024.0) << " MiB ("
+              << static_cast<double>(image) / tl.size() << " B/event), cache "
+              << cold_mem / 1024.0 << " KiB\n";
+    std::cout << "  ratio       : " << static_cast<double>(hot) / (image + cold_mem) << "x\n";
+    std::cout << "  encode      : " << encode_ms << " ms ("
+              << (hot / (1024.0 * 1024.0)) / (encode_ms / 1000.0) << " MiB/s)\n";
+
+    auto all_cold = [&](auto &&fn)
+    {
+        std::size_t n = 0;
+        for (const auto &s : segs)
+            n += fn(s);
+        return n;
+    };
+
+    std::cout << "  " << std::left << std::setw(22) << "query" << std::right
+              << std::setw(13) << "hot" << std::setw(13) << "cold" << std::setw(9) << "slower" << "\n";
+
+    auto events = snap.size();
+    auto mid = snap.event_at(events / 2).unwrap().ts;
+    auto hour_end = mid + std::chrono::hours(1);
+
+    {
+        t0 = Clock::now();
+        auto n = tl.count_by_fd(12);
+        double h = ms_since(t0);
+        t0 = Clock::now();
+        auto c = all_cold([](const ColdSegment &s)
+                          { return s.count_by_fd(12); });
+        print({"count_by_fd", h, ms_since(t0), c == n ? n : 0});
+    }
+    {
+        t0 = Clock::now();
+        auto n = tl.count_by_time(mid, hour_end);
+        double h = ms_since(t0);
+        t0 = Clock::now();
+        auto c = all_cold([&](const ColdSegment &s)
+                          { return s.count_by_time(mid, hour_end); });
+        print({"count_by_time (1h)", h, ms_since(t0), c == n ? n : 0});
+    }
+    {
+        t0 = Clock::now();
+        auto n = tl.query_by_time(mid, hour_end).size();
+        double h = ms_since(t0);
+        t0 = Clock::now();
+        auto c = all_cold([&](const ColdSegment &s)
+                          { return s.query_by_time(mid, hour_end).size(); });
+        print({"query_by_time (1h)", h, ms_since(t0), c == n ? n : 0});
+    }
+    {
+        t0 = Clock::now();
+        auto n = tl.query_errors().size();
+        double h = ms_since(t0);
+        t0 = Clock::now();
+        auto c = all_cold([](const ColdSegment &s)
+                          { return s.query_errors().size(); });
+        print({"query_errors", h, ms_since(t0), c == n ? n : 0});
+    }
+    {
+        TimelineQuery q;
+        q.fd = 13;
+        q.types = {EventType::HTTP_RECEIVED};
+        q.start = mid;
+        q.end = hour_end;
+        t0 = Clock::now();
+        auto n = tl.query(q).size();
+        double h = ms_since(t0);
+        t0 = Clock::now();
+        auto c = all_cold([&](const ColdSegment &s)
+                          { return s.query(q).size(); });
+        print({"fd+type+time payload", h, ms_since(t0), c == n ? n : 0});
+    }
+    {
+        // 随机按下标访问：冷数据段需从最近的解码起点解码
+        std::mt19937 rng(1);
+        std::vector<std::size_t> idxs(2000);
+        for (auto &i : idxs)
+            i = rng() % events;
+
+        t0 = Clock::now();
+        std::size_t n = 0;
+        for (auto i : idxs)
+            n += tl.event_at(i).is_ok();
+        double h = ms_since(t0);
+        t0 = Clock::now();
+        std::size_t c = 0;
+        for (auto i : idxs)
+        {
+            const auto &s = segs[i / Timeline::SEGMENT_CAPACITY];
+            c += s.event_at(i % Timeline::SEGMENT_CAPACITY).is_ok();
+        }
+        print({"event_at x2000", h, ms_since(t0), c == n ? n : 0});
+    }
+
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "Benchmark finished." << std::endl;
+    return 0;
+}
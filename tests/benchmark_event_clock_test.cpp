@@ -0,0 +1,84 @@
+/*
+ * ============================================================================
+ *  File Name   : benchmark_event_clock_test.cpp
+ *  Module      : test
+ *
+ *  Description :
+ *      事件打点开销基准测试。
+ *      对比 system_clock (wall_now)、steady_clock (monotonic_now)、
+ *      CLOCK_MONOTONIC_RAW 与事件时钟 (event_now) 的单次读取耗时，
+ *      以及完整构造一个 Event / EventRecord 的耗时。
+ *
+ *  Metrics :
+ *      - ns/stamp : 单线程连续读取的平均耗时
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#include "eunet/core/event.hpp"
+#include "eunet/core/event_record.hpp"
+#include "eunet/platform/time.hpp"
+
+using namespace platform::time;
+using Clock = std::chrono::steady_clock;
+
+// ================= 配置参数 =================
+constexpr int ROUNDS = 5'000'000;
+
+// 防止读数被优化掉
+volatile std::int64_t g_sink = 0;
+
+template <typename Fn>
+void measure(const char *name, Fn &&fn)
+{
+    // 预热，同时触发时钟源的首次校准
+    for (int i = 0; i < 1000; ++i)
+        g_sink = g_sink + fn();
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < ROUNDS; ++i)
+        g_sink = g_sink + fn();
+    auto ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+
+    std::cout << "  " << std::left << std::setw(24) << name
+              << " ns/stamp=" << std::fixed << std::setprecision(2) << ns / ROUNDS
+              << std::defaultfloat << "\n";
+}
+
+int main()
+{
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Stamp Cost] rounds=" << ROUNDS
+              << " source=" << to_string(event_clock_source()) << "\n";
+
+    measure("wall_now()", []
+            { return wall_now().time_since_epoch().count(); });
+    measure("monotonic_now()", []
+            { return monotonic_now().time_since_epoch().count(); });
+    measure("monotonic_raw_ns()", []
+            { return monotonic_raw_ns(); });
+    measure("event_now()", []
+            { return event_now(); });
+    measure("event_to_wall(now)", []
+            { return event_to_wall(event_now()).time_since_epoch().count(); });
+
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Construct Cost]\n";
+
+    measure("Event::info", []
+            { return core::Event::info(core::EventType::HTTP_SENT, {}).mono_ns; });
+    measure("make_record", []
+            { return core::make_record(core::EventType::HTTP_SENT, core::MessageId::HttpRequestSent).ts_ns; });
+
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "Benchmark finished." << std::endl;
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * ============================================================================
+ *  File Name   : benchmark_ingest_contention_test.cpp
+ *  Module      : test
+ *
+ *  Description :
+ *      多生产者事件入库竞争基准测试。
+ *      1 .. 32 个生产者线程同时上报事件，对比三条入库路径：
+ *          emit(Event)        : 每条事件获取 Orchestrator 与 Timeline 的锁
+ *          record(EventRecord): 同样逐条加锁，但省去格式化与 Event 构造
+ *          append + merge     : 生产者写线程局部段，单独的合并线程整批归并入库
+ *
+ *  Metrics :
+ *      - Events/s : 全部事件进入 Timeline 的总吞吐
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "eunet/core/orchestrator.hpp"
+
+using namespace core;
+using Clock = std::chrono::steady_clock;
+
+// ================= 配置参数 =================
+constexpr int PER_THREAD = 20000;
+constexpr int THREAD_COUNTS[] = {1, 2, 4, 8, 16, 32};
+
+enum class Mode
+{
+    Emit,
+    Record,
+    Runs,
+};
+
+const char *mode_name(Mode m)
+{
+    switch (m)
+    {
+    case Mode::Emit:
+        return "emit(Event)";
+    case Mode::Record:
+        return "record(EventRecord)";
+    case Mode::Runs:
+        return "append + merge";
+    }
+    return "";
+}
+
+void produce(Orchestrator &orch, Mode mode, int t)
+{
+    auto sid = static_cast<SessionId>(t + 1);
+    for (int i = 0; i < PER_THREAD; ++i)
+    {
+        switch (mode)
+        {
+        case Mode::Emit:
+        {
+            auto e = Event::info(EventType::HTTP_RECEIVED, "Received 512 bytes", {100 + t});
+            e.session_id = sid;
+            (void)orch.emit(std::move(e));
+            break;
+        }
+        case Mode::Record:
+        {
+            auto r = make_record(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, 100 + t, sid);
+            r.args[0] = 512;
+            (void)orch.record(r);
+            break;
+        }
+        case Mode::Runs:
+        {
+            auto r = make_record(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, 100 + t, sid);
+            r.args[0] = 512;
+            orch.append(r);
+            break;
+        }
+        }
+    }
+
+    if (mode == Mode::Runs)
+        orch.flush_local();
+}
+
+double run(Mode mode, int threads)
+{
+    Orchestrator orch;
+    const std::size_t total = static_cast<std::size_t>(threads) * PER_THREAD;
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; ++t)
+        producers.emplace_back([&, t]
+                               {
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            produce(orch, mode, t); });
+
+    auto t0 = Clock::now();
+    go.store(true, std::memory_order_release);
+
+    if (mode == Mode::Runs)
+    {
+        // 合并线程即当前线程：持续归并直到全部事件入库
+        while (orch.get_timeline().size() < total)
+        {
+            if (orch.merge().unwrap_or(0) == 0)
+                std::this_thread::yield();
+        }
+    }
+
+    for (auto &th : producers)
+        th.join();
+
+    auto elapsed = std::chrono::duration<double>(Clock::now() - t0).count();
+    if (orch.get_timeline().size() != total)
+        std::cerr << "  [warn] ingested " << orch.get_timeline().size() << " / " << total << "\n";
+
+    return total / elapsed;
+}
+
+int main()
+{
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Ingest Contention] events/thread=" << PER_THREAD
+              << " cores=" << std::thread::hardware_concurrency() << "\n";
+
+    for (auto mode : {Mode::Emit, Mode::Record, Mode::Runs})
+    {
+        std::cout << "  " << mode_name(mode) << "\n";
+        double base = 0;
+        for (int threads : THREAD_COUNTS)
+        {
+            double eps = run(mode, threads);
+            if (threads == 1)
+                base = eps;
+            std::cout << "    threads=" << std::left << std::setw(4) << threads
+                      << " events/s=" << std::setw(12) << static_cast<std::uint64_t>(eps)
+                      << " scale=" << std::fixed << std::setprecision(2) << eps / base
+                      << std::defaultfloat << "\n";
+        }
+    }
+
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "Benchmark finished." << std::endl;
+    return 0;
+}
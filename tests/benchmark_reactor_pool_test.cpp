@@ -0,0 +1,314 @@
+/*
+ * ============================================================================
+ *  File Name   : benchmark_reactor_pool_test.cpp
+ *  Module      : test
+ *
+ *  Description :
+ *      多 reactor 扩展性基准测试。
+ *      在环回地址上启动 N 个 SO_REUSEPORT 服务端 reactor 与 N 个客户端 reactor，
+ *      客户端每个连接循环发送定长请求、接收定长响应，并把收发事件
+ *      通过 Orchestrator::submit 无锁上报，主线程持续 drain。
+ *
+ *  Metrics :
+ *      - RPS 与每核 RPS（1 .. N 个 reactor）
+ *      - Events/s（主线程 drain 进入 Timeline 的事件速率）
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "eunet/core/orchestrator.hpp"
+#include "eunet/platform/reactor_pool.hpp"
+
+using namespace platform::reactor;
+using Clock = std::chrono::steady_clock;
+
+// ================= 配置参数 =================
+constexpr int CONNS_PER_REACTOR = 16;
+constexpr int DURATION_MS = 1000;
+constexpr size_t REQUEST_SIZE = 64;
+constexpr size_t RESPONSE_SIZE = 128;
+
+static void set_nonblocking(int fd)
+{
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+// ================= 服务端：每个 reactor 一个 SO_REUSEPORT 监听套接字 =================
+struct ServerShard
+{
+    int listen_fd = -1;
+    std::unordered_map<int, size_t> pending; // fd -> 已收到的请求字节数
+};
+
+static int make_listener(uint16_t port)
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+        ::listen(fd, 1024) < 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+    set_nonblocking(fd);
+    return fd;
+}
+
+static uint16_t local_port(int fd)
+{
+    sockaddr_in addr{};
+    socklen_t len = sizeof(addr);
+    ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len);
+    return ntohs(addr.sin_port);
+}
+
+static void serve_conn(EventLoop &loop, ServerShard &shard, int fd)
+{
+    (void)loop.watch({fd}, EPOLLIN, [&loop, &shard, fd](uint32_t)
+                     {
+                         static thread_local char buf[4096];
+                         static thread_local char resp[RESPONSE_SIZE] = {};
+                         for (;;)
+                         {
+                             ssize_t n = ::read(fd, buf, sizeof(buf));
+                             if (n > 0)
+                             {
+                                 size_t &got = shard.pending[fd];
+                                 got += static_cast<size_t>(n);
+                                 for (; got >= REQUEST_SIZE; got -= REQUEST_SIZE)
+                                     (void)::write(fd, resp, sizeof(resp));
+                                 continue;
+                             }
+                             if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                                 return;
+
+                             (void)loop.unwatch({fd});
+                             shard.pending.erase(fd);
+                             ::close(fd);
+                             return;
+                         } });
+}
+
+// ================= 客户端：每个连接循环请求 =================
+struct alignas(64) ClientShard
+{
+    std::atomic<uint64_t> completed{0};
+    std::vector<int> fds;
+    std::unordered_map<int, size_t> received;
+};
+
+struct RunResult
+{
+    double rps = 0;
+    double events_per_sec = 0;
+    size_t pinned = 0;
+};
+
+static RunResult run_with(size_t n)
+{
+    ReactorPoolOptions opts;
+    opts.threads = n;
+
+    auto server = std::move(ReactorPool::create(opts).unwrap());
+    auto client = std::move(ReactorPool::create(opts).unwrap());
+
+    // 第一个监听套接字绑定随机端口，其余复用同一端口
+    std::vector<ServerShard> sshards(n);
+    sshards[0].listen_fd = make_listener(0);
+    uint16_t port = local_port(sshards[0].listen_fd);
+    for (size_t i = 1; i < n; ++i)
+        sshards[i].listen_fd = make_listener(port);
+
+    server->start();
+    client->start();
+
+    std::atomic<size_t> ready{0};
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto &r = server->at(i);
+        auto &shard = sshards[i];
+        r.post([&r, &shard, &ready]
+               {
+                   auto &loop = r.loop();
+                   (void)loop.watch({shard.listen_fd}, EPOLLIN, [&loop, &shard](uint32_t)
+                                    {
+                                        for (;;)
+                                        {
+                                            int c = ::accept4(shard.listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+                                            if (c < 0)
+                                                return;
+                                            set_nonblocking(c);
+                                            serve_conn(loop, shard, c);
+                                        } });
+                   ++ready; });
+    }
+    while (ready.load() < n)
+        std::this_thread::yield();
+
+    core::Orchestrator orch;
+    std::atomic<bool> running{true};
+    std::vector<ClientShard> cshards(n);
+
+    ready = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto &r = client->assign();
+        auto &shard = cshards[r.index()];
+        r.post([&r, &shard, &orch, &running, &ready, port]
+               {
+                   static thread_local char req[REQUEST_SIZE] = {};
+                   auto &loop = r.loop();
+                   for (int k = 0; k < CONNS_PER_REACTOR; ++k)
+                   {
+                       int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+                       sockaddr_in addr{};
+                       addr.sin_family = AF_INET;
+                       addr.sin_port = htons(port);
+                       addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+                       if (::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
+                       {
+                           ::close(fd);
+                           continue;
+                       }
+                       set_nonblocking(fd);
+                       shard.fds.push_back(fd);
+
+                       (void)loop.watch({fd}, EPOLLIN, [&shard, &orch, &running, fd](uint32_t)
+                                        {
+                                            char buf[4096];
+                                            for (;;)
+                                            {
+                                                ssize_t m = ::read(fd, buf, sizeof(buf));
+                                                if (m <= 0)
+                                                    return;
+
+                                                size_t &got = shard.received[fd];
+                                                got += static_cast<size_t>(m);
+                                                while (got >= RESPONSE_SIZE)
+                                                {
+                                                    got -= RESPONSE_SIZE;
+                                                    shard.completed.fetch_add(1, std::memory_order_relaxed);
+                                                    orch.submit(core::Event::info(core::EventType::HTTP_RECEIVED, "", {fd}));
+                                                    if (running.load(std::memory_order_relaxed))
+                                                    {
+                                                        orch.submit(core::Event::info(core::EventType::HTTP_SENT, "", {fd}));
+                                                        (void)::write(fd, req, sizeof(req));
+                                                    }
+                                                }
+                                            } });
+
+                       orch.submit(core::Event::info(core::EventType::HTTP_SENT, "", {fd}));
+                       (void)::write(fd, req, sizeof(req));
+                   }
+                   ++ready; });
+    }
+    while (ready.load() < n)
+        std::this_thread::yield();
+
+    // 测量窗口：主线程作为唯一消费者持续 drain
+    uint64_t base = 0;
+    for (auto &s : cshards)
+        base += s.completed.load();
+    size_t drained = 0;
+    auto t0 = Clock::now();
+    auto end = t0 + std::chrono::milliseconds(DURATION_MS);
+    while (Clock::now() < end)
+    {
+        auto d = orch.drain(4096);
+        drained += d.is_ok() ? d.unwrap() : 0;
+        if (d.is_ok() && d.unwrap() == 0)
+            std::this_thread::yield();
+    }
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+    uint64_t total = 0;
+    for (auto &s : cshards)
+        total += s.completed.load();
+
+    running = false;
+    client->stop();
+    server->stop();
+    (void)orch.drain();
+
+    RunResult res;
+    res.rps = (total - base) / secs;
+    res.events_per_sec = drained / secs;
+    for (size_t i = 0; i < n; ++i)
+        res.pinned += client->at(i).pinned() ? 1 : 0;
+
+    for (auto &s : cshards)
+        for (int fd : s.fds)
+            ::close(fd);
+    for (auto &s : sshards)
+    {
+        for (auto &[fd, _] : s.pending)
+            ::close(fd);
+        ::close(s.listen_fd);
+    }
+
+    return res;
+}
+
+int main()
+{
+    size_t max_cores = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Reactor Pool Scaling] conns/reactor=" << CONNS_PER_REACTOR
+              << " duration=" << DURATION_MS << "ms"
+              << " hw_cores=" << max_cores << "\n";
+    std::cout << std::left << std::setw(10) << "  cores"
+              << std::right << std::setw(14) << "RPS"
+              << std::setw(14) << "RPS/core"
+              << std::setw(16) << "events/s"
+              << std::setw(10) << "pinned" << "\n";
+
+    std::vector<size_t> counts;
+    for (size_t n = 1; n < max_cores; n *= 2)
+        counts.push_back(n);
+    counts.push_back(max_cores);
+    if (max_cores == 1)
+        counts.push_back(2); // 单核机器上也观察超额订阅时的表现
+
+    for (size_t n : counts)
+    {
+        auto r = run_with(n);
+        std::cout << "  " << std::left << std::setw(8) << n
+                  << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(14) << r.rps
+                  << std::setw(14) << r.rps / n
+                  << std::setw(16) << r.events_per_sec
+                  << std::setw(7) << r.pinned << "/" << n << "\n";
+    }
+    std::cout << "------------------------------------------------------------\n";
+
+    std::cout << "Benchmark finished." << std::endl;
+    return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ * ============================================================================
+ *  File Name   : benchmark_replay_sink_test.cpp
+ *  Module      : test
+ *
+ *  Description :
+ *      追踪回放与 Sink 吞吐基准测试。先写出一份模拟真实负载的追踪文件
+ *      （每个会话依次经历 DNS、TCP 建连、内核采样、HTTP 收发与关闭，
+ *      部分会话超时失败，响应分多次到达并带载荷），再用 ReplayScenario
+ *      以不等待模式回放，分别挂载不同的 Sink 测量端到端吞吐；
+ *      最后以倍速回放一小段，测量提交时刻相对计划时刻的滞后。
+ *
+ *  Metrics :
+ *      - Events/s : 各 Sink 组合下回放的吞吐
+ *      - Lag      : 倍速回放时的最大滞后 (us)
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "eunet/core/orchestrator.hpp"
+#include "eunet/core/replay_scenario.hpp"
+#include "eunet/core/timeline.hpp"
+#include "eunet/core/trace_file.hpp"
+#include "eunet/core/sink/json_sink.hpp"
+#include "eunet/core/sink/metrics_sink.hpp"
+#include "eunet/core/sink/trace_sink.hpp"
+
+using namespace core;
+using scenario::ReplayConfig;
+using scenario::ReplayScenario;
+
+// ================= 配置参数 =================
+constexpr int SESSIONS = 20000;
+constexpr int CHUNKS = 4;           // 每个响应分几次到达
+constexpr int FAIL_EVERY = 25;      // 每 25 个会话一个建连超时
+constexpr std::size_t PAYLOAD = 512;
+constexpr std::size_t PACED = 2000; // 倍速回放的条数
+constexpr double PACED_SPEED = 100.0;
+
+// 丢弃一切输出的流缓冲
+struct NullBuffer : std::streambuf
+{
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char *, std::streamsize n) override { return n; }
+};
+
+std::string temp_path(const char *name)
+{
+    auto dir = std::filesystem::temp_directory_path();
+    return (dir / (std::string("eunet_bench_") + name + "_" + std::to_string(::getpid()) + ".trace")).string();
+}
+
+void write_trace(const std::string &path)
+{
+    Timeline tl;
+    std::vector<std::byte> payload(PAYLOAD, std::byte{'x'});
+    auto err = util::Error::transport().timeout().message("connect timeout").build();
+    platform::net::TcpInfo info{};
+    info.rtt_us = 800;
+    info.snd_cwnd = 10;
+
+    std::int64_t ts = platform::time::event_now() - 3'600'000'000'000;
+    auto push = [&](EventType type, MessageId msg, int fd, SessionId sid, RecordExtras extras = {})
+    {
+        auto rec = make_record(type, msg, fd, sid);
+        ts += 50'000; // 相邻事件间隔 50us
+        rec.ts_ns = ts;
+        rec.args[0] = PAYLOAD;
+        (void)tl.push(rec, extras);
+    };
+
+    for (int s = 0; s < SESSIONS; ++s)
+    {
+        auto sid = static_cast<SessionId>(s + 1);
+        int fd = 16 + s % 256;
+        std::string host = "api" + std::to_string(s % 8) + ".example.com";
+
+        push(EventType::DNS_RESOLVE_START, MessageId::ResolvingHost, -1, sid, {.text = host});
+        push(EventType::DNS_RESOLVE_DONE, MessageId::ResolvedTo, -1, sid, {.text = "10.0.0.1"});
+        push(EventType::TCP_CONNECT_START, MessageId::Connecting, fd, sid, {.text = "10.0.0.1"});
+        if (s % FAIL_EVERY == 0)
+        {
+            push(EventType::TCP_CONNECT_TIMEOUT, MessageId::Text, fd, sid, {.text = "timeout", .error = &err});
+            continue;
+        }
+        push(EventType::TCP_CONNECT_SUCCESS, MessageId::ConnectionEstablished, fd, sid);
+        push(EventType::TCP_INFO_SAMPLE, MessageId::TcpInfoSample, fd, sid, {.tcp_info = &info});
+        push(EventType::HTTP_REQUEST_BUILD, MessageId::HttpGet, fd, sid, {.text = "/v1/items"});
+        push(EventType::HTTP_SENT, MessageId::HttpRequestSent, fd, sid);
+        push(EventType::HTTP_HEADERS_RECEIVED, MessageId::Text, fd, sid, {.text = "HTTP/1.1 200 OK"});
+        for (int c = 0; c < CHUNKS; ++c)
+            push(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, fd, sid, {.payload = payload});
+        push(EventType::HTTP_BODY_DONE, MessageId::Text, fd, sid, {.text = "body done"});
+        push(EventType::CONNECTION_CLOSED, MessageId::ClosingConnection, fd, sid);
+    }
+
+    auto w = TraceWriter::create(path).unwrap();
+    (void)w.append(tl.snapshot());
+}
+
+void run_case(const char *name, const std::shared_ptr<const TraceFile> &trace, std::vector<Orchestrator::SinkPtr> sinks)
+{
+    Orchestrator orch;
+    for (auto &s : sinks)
+        orch.attach(s);
+
+    ReplayScenario sc(trace, ReplayConfig{.speed = 0});
+    auto r = sc.run(orch);
+    if (r.is_err())
+    {
+        std::cerr << r.unwrap_err().format() << "\n";
+        return;
+    }
+
+    const auto &st = sc.stats();
+    double secs = static_cast<double>(st.elapsed_ns) / 1e9;
+    std::cout << "  " << std::left << std::setw(26) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << secs * 1000 << " ms"
+              << std::setw(12) << std::setprecision(0) << static_cast<double>(st.emitted) / secs << " events/s\n";
+}
+
+int main()
+{
+    auto path = temp_path("replay_src");
+    auto out_path = temp_path("replay_out");
+    write_trace(path);
+
+    auto opened = TraceFile::open(path);
+    if (opened.is_err())
+    {
+        std::cerr << opened.unwrap_err().format() << "\n";
+        return 1;
+    }
+    auto trace = std::make_shared<const TraceFile>(std::move(opened).unwrap());
+
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Replay -> Sinks] sessions=" << SESSIONS << " events=" << trace->size() << "\n";
+
+    NullBuffer null_buf;
+    std::ostream null_out(&null_buf);
+
+    run_case("no sink", trace, {});
+    run_case("metrics", trace, {std::make_shared<sink::MetricsSink>()});
+    run_case("json (null stream)", trace, {std::make_shared<sink::JsonSink>(null_out)});
+    run_case("trace file", trace,
+             {std::make_shared<sink::TraceSink>(TraceWriter::create(out_path).unwrap())});
+    run_case("metrics + json + trace", trace,
+             {std::make_shared<sink::MetricsSink>(),
+              std::make_shared<sink::JsonSink>(null_out),
+              std::make_shared<sink::TraceSink>(TraceWriter::create(out_path).unwrap())});
+
+    // 倍速回放：真实时间上事件间隔为 0.5us，主要体现等待与提交的开销
+    {
+        Orchestrator orch;
+        orch.attach(std::make_shared<sink::MetricsSink>());
+        ReplayScenario sc(trace, ReplayConfig{.speed = PACED_SPEED, .count = PACED});
+        (void)sc.run(orch);
+        const auto &st = sc.stats();
+        std::cout << "  paced " << PACED_SPEED << "x (" << st.emitted << " events)"
+                  << "  elapsed=" << std::setprecision(1) << static_cast<double>(st.elapsed_ns) / 1e6 << " ms"
+                  << "  expected=" << static_cast<double>(st.trace_span_ns) / PACED_SPEED / 1e6 << " ms"
+                  << "  max lag=" << static_cast<double>(st.max_lag_ns) / 1e3 << " us\n";
+    }
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(out_path);
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "Benchmark finished." << std::endl;
+    return 0;
+}
@@ -6,6 +6,8 @@
  *  Description :
  *      性能基准测试套件。
  *      横向对比 LibCurl (C), Boost.Beast (C++) 与 EuNet 的 HTTP GET 性能。
+ *      EuNet 分别以 Full / Timing / Null 三种可观测性策略运行，
+ *      与 Beast、libcurl 对比量化事件上报的开销。
  *
  *  Metrics :
  *      - RPS (Requests Per Second)
@@ -18,6 +20,9 @@
  *      2. 开启 TCP_NODELAY (禁用 Nagle 算法)
  *      3. 使用 Keep-Alive (长连接复用)
  *
+ *      另附 EuNet 套接字选项对比：逐项开启 TCP_NODELAY / TCP_QUICKACK /
+ *      收发缓冲区 / TCP Fast Open，测量环回短连接请求的延迟分布。
+ *
  *  Author      : 爱特小登队
  *  Created On  : 2026-1-5
  *
@@ -39,6 +44,10 @@
 // 资源监控头文件 (Linux/macOS)
 #include <sys/resource.h>
 #include <unistd.h>
+#include <netinet/tcp.h>
+
+#include <algorithm>
+#include <numeric>
 
 #define ENABLE_EUNET
 
@@ -159,6 +168,13 @@ public:
         acceptor_.open(ep.protocol());
         acceptor_.set_option(asio::socket_base::reuse_address(true));
         acceptor_.bind(ep);
+
+        // 开启服务端 TFO 队列（内核不支持时忽略），供套接字选项对比使用
+        beast::error_code tfo_ec;
+        acceptor_.set_option(
+            asio::detail::socket_option::integer<IPPROTO_TCP, TCP_FASTOPEN>(16),
+            tfo_ec);
+
         acceptor_.listen();
         thread_ = std::thread([this]
                               { run(); });
@@ -287,21 +303,22 @@ void bench_beast_reuse(uint16_t port, int requests)
 }
 
 // ================= Eunet 评测 =================
-void bench_eunet(uint16_t port, int requests)
-{
 #ifdef ENABLE_EUNET
-    Profiler prof("Eunet Framework");
-    core::Orchestrator orch;
-    net::http::HTTPClient client(orch);
+// 同一套请求流程分别以三种可观测性策略运行，差值即为观测开销
+template <typename Client>
+void bench_eunet_client(const std::string &name, Client &client, uint16_t port, int requests)
+{
+    Profiler prof(name);
 
     // 预热
     for (int i = 0; i < WARMUP_REQUESTS; ++i)
     {
-        client.get({.host = HOST, .port = port, .target = PATH});
+        (void)client.get({.host = HOST, .port = port, .target = PATH});
     }
 
     prof.start();
     int success = 0;
+    net::http::Timings sum;
     for (int i = 0; i < requests; ++i)
     {
         // 注意：eunet 内部无法复用连接
@@ -313,14 +330,165 @@ void bench_eunet(uint16_t port, int requests)
              .connection_close = true});
 
         if (res.is_ok() && res.unwrap().status == 200)
+        {
             success++;
+
+            // 阶段耗时直接取自响应，无需订阅事件
+            const auto &t = res.unwrap().timings;
+            sum.dns += t.dns;
+            sum.connect += t.connect;
+            sum.request += t.request;
+            sum.ttfb += t.ttfb;
+            sum.body += t.body;
+            sum.total += t.total;
+        }
     }
     prof.stop(success, requests);
+
+    if (success > 0 && sum.total.count() > 0)
+    {
+        auto avg_us = [&](net::http::Timings::Span s)
+        { return net::http::Timings::ms(s) * 1000.0 / success; };
+
+        std::cout << std::fixed << std::setprecision(1)
+                  << "  phases avg (us): dns " << avg_us(sum.dns)
+                  << "  connect " << avg_us(sum.connect)
+                  << "  request " << avg_us(sum.request)
+                  << "  ttfb " << avg_us(sum.ttfb)
+                  << "  body " << avg_us(sum.body)
+                  << "  total " << avg_us(sum.total) << "\n";
+    }
+}
+#endif
+
+void bench_eunet(uint16_t port, int requests)
+{
+#ifdef ENABLE_EUNET
+    {
+        core::Orchestrator orch;
+        net::http::HTTPClient client(orch);
+        bench_eunet_client("Eunet Framework (FullObserver)", client, port, requests);
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    {
+        net::http::TimingHTTPClient client;
+        bench_eunet_client("Eunet Framework (TimingObserver)", client, port, requests);
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    {
+        net::http::NullHTTPClient client;
+        bench_eunet_client("Eunet Framework (NullObserver)", client, port, requests);
+    }
 #else
     std::cout << "[Eunet] Skipped (ENABLE_EUNET not defined)\n";
 #endif
 }
 
+// ================= Eunet 套接字选项对比 =================
+// 逐项开启套接字调优选项，测量环回下单次短连接请求的延迟分布
+void bench_eunet_socket_options(uint16_t port, int requests)
+{
+#ifdef ENABLE_EUNET
+    using platform::net::SocketOptions;
+
+    struct Profile
+    {
+        const char *name;
+        SocketOptions opts;
+    };
+
+    std::vector<Profile> profiles;
+    profiles.push_back({"default", SocketOptions{}});
+    {
+        SocketOptions o;
+        o.tcp_nodelay = true;
+        profiles.push_back({"TCP_NODELAY", o});
+    }
+    {
+        SocketOptions o;
+        o.tcp_quickack = true;
+        profiles.push_back({"TCP_QUICKACK", o});
+    }
+    {
+        SocketOptions o;
+        o.send_buffer = 256 * 1024;
+        o.recv_buffer = 256 * 1024;
+        profiles.push_back({"SO_SNDBUF/SO_RCVBUF 256K", o});
+    }
+    {
+        SocketOptions o;
+        o.fastopen = true;
+        profiles.push_back({"TCP Fast Open", o});
+    }
+    {
+        SocketOptions o = SocketOptions::low_latency();
+        o.fastopen = true;
+        profiles.push_back({"low_latency + TFO", o});
+    }
+
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Eunet Socket Options] loopback latency per request (us)\n";
+    std::cout << std::left << std::setw(28) << "  profile"
+              << std::right << std::setw(10) << "avg"
+              << std::setw(10) << "p50"
+              << std::setw(10) << "p99"
+              << std::setw(10) << "ok" << "\n";
+
+    for (const auto &p : profiles)
+    {
+        core::Orchestrator orch;
+        net::http::HTTPClient client(orch);
+
+        net::http::HttpRequest req{
+            .host = HOST,
+            .port = port,
+            .target = PATH,
+            .timeout_ms = 3000,
+            .connection_close = true};
+        req.socket_options = p.opts;
+
+        // 预热（TFO 需要先拿到服务端 cookie）
+        for (int i = 0; i < WARMUP_REQUESTS / 10; ++i)
+            (void)client.get(req);
+
+        std::vector<double> lat_us;
+        lat_us.reserve(requests);
+        int success = 0;
+
+        for (int i = 0; i < requests; ++i)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            auto res = client.get(req);
+            auto t1 = std::chrono::steady_clock::now();
+
+            lat_us.push_back(
+                std::chrono::duration<double, std::micro>(t1 - t0).count());
+            if (res.is_ok() && res.unwrap().status == 200)
+                success++;
+        }
+
+        std::sort(lat_us.begin(), lat_us.end());
+        double avg = std::accumulate(lat_us.begin(), lat_us.end(), 0.0) / lat_us.size();
+        double p50 = lat_us[lat_us.size() / 2];
+        double p99 = lat_us[std::min(lat_us.size() - 1, lat_us.size() * 99 / 100)];
+
+        std::cout << "  " << std::left << std::setw(26) << p.name
+                  << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << avg
+                  << std::setw(10) << p50
+                  << std::setw(10) << p99
+                  << std::setw(10) << success << "\n";
+    }
+    std::cout << "------------------------------------------------------------\n";
+#else
+    std::cout << "[Eunet Socket Options] Skipped (ENABLE_EUNET not defined)\n";
+#endif
+}
+
 // ================= Main =================
 int main()
 {
@@ -350,6 +518,10 @@ int main()
 
     bench_eunet(port, BENCH_REQUESTS);
 
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    bench_eunet_socket_options(port, BENCH_REQUESTS / 5);
+
     std::cout << "Benchmark finished." << std::endl;
 
     curl_global_cleanup();
@@ -0,0 +1,150 @@
+/*
+ * ============================================================================
+ *  File Name   : benchmark_timeline_snapshot_test.cpp
+ *  Module      : test
+ *
+ *  Description :
+ *      读者持续全量扫描时的入库延迟基准测试。
+ *      写入线程逐条 push 记录并统计单次耗时，读者线程同时循环做全量扫描：
+ *          no reader     : 无读者，作为基线
+ *          locked scan   : 读者扫描期间持有与写入方相同的锁（即旧的查询方式）
+ *          snapshot scan : 读者取快照后无锁扫描
+ *
+ *  Metrics :
+ *      - p50 / p99 / max : 单次 push 耗时 (ns)
+ *      - scans           : 测试期间读者完成的全量扫描次数
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "eunet/core/timeline.hpp"
+
+using namespace core;
+using Clock = std::chrono::steady_clock;
+
+// ================= 配置参数 =================
+constexpr int PRELOAD = 200'000; // 扫描的基础规模
+constexpr int PUSHES = 200'000;  // 测量期间写入的条数
+
+// 防止扫描被优化掉
+volatile std::uint64_t g_sink = 0;
+
+enum class Mode
+{
+    NoReader,
+    LockedScan,
+    SnapshotScan,
+};
+
+const char *mode_name(Mode m)
+{
+    switch (m)
+    {
+    case Mode::NoReader:
+        return "no reader";
+    case Mode::LockedScan:
+        return "locked scan";
+    case Mode::SnapshotScan:
+        return "snapshot scan";
+    }
+    return "";
+}
+
+std::uint64_t scan(const TimelineSnapshot &snap)
+{
+    std::uint64_t sum = 0;
+    snap.for_each([&](const EventRecord &r, const RecordArena &)
+                  { sum += static_cast<std::uint64_t>(r.ts_ns) ^ r.args[0]; });
+    return sum;
+}
+
+void run(Mode mode)
+{
+    Timeline tl;
+    std::mutex big_lock; // locked scan 模式下模拟查询与写入共用一把锁
+
+    for (int i = 0; i < PRELOAD; ++i)
+        (void)tl.push(make_record(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, i % 16));
+
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> scans{0};
+
+    std::thread reader;
+    if (mode != Mode::NoReader)
+        reader = std::thread([&]
+                             {
+            while (!done.load(std::memory_order_relaxed))
+            {
+                if (mode == Mode::LockedScan)
+                {
+                    std::lock_guard lock(big_lock);
+                    g_sink = g_sink + scan(tl.snapshot());
+                }
+                else
+                {
+                    g_sink = g_sink + scan(tl.snapshot());
+                }
+                scans.fetch_add(1, std::memory_order_relaxed);
+            } });
+
+    std::vector<std::int64_t> lat;
+    lat.reserve(PUSHES);
+
+    for (int i = 0; i < PUSHES; ++i)
+    {
+        auto rec = make_record(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, i % 16);
+        auto t0 = Clock::now();
+        if (mode == Mode::LockedScan)
+        {
+            std::lock_guard lock(big_lock);
+            (void)tl.push(rec);
+        }
+        else
+        {
+            (void)tl.push(rec);
+        }
+        lat.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+    }
+
+    done = true;
+    if (reader.joinable())
+        reader.join();
+
+    std::sort(lat.begin(), lat.end());
+    auto pct = [&](double p)
+    { return lat[static_cast<std::size_t>(p * (lat.size() - 1))]; };
+
+    std::cout << "  " << std::left << std::setw(14) << mode_name(mode)
+              << " p50=" << std::setw(8) << pct(0.50)
+              << " p99=" << std::setw(10) << pct(0.99)
+              << " max=" << std::setw(10) << lat.back()
+              << " scans=" << scans.load() << "\n";
+}
+
+int main()
+{
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Ingest Latency Under Full Scans] preload=" << PRELOAD
+              << " pushes=" << PUSHES
+              << " cores=" << std::thread::hardware_concurrency() << "\n";
+
+    for (auto mode : {Mode::NoReader, Mode::LockedScan, Mode::SnapshotScan})
+        run(mode);
+
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "Benchmark finished." << std::endl;
+    return 0;
+}
@@ -0,0 +1,243 @@
+/*
+ * ============================================================================
+ *  File Name   : benchmark_timeline_spill_test.cpp
+ *  Module      : test
+ *
+ *  Description :
+ *      Timeline 冷数据落盘基准测试。模拟 3 天的合成监测（与冷数据段基准
+ *      相同的探测流程），分别写入两个时间线：
+ *          memory : 全部留在内存中
+ *          spill  : 开启落盘，超出内存预算后旧段由后台线程写入冷段文件
+ *      比较两者的内存、磁盘占用、写入吞吐与同样查询的耗时。
+ *
+ *  Metrics :
+ *      - ingest   : 写入全部事件的耗时与吞吐 (events/s)
+ *      - size     : Timeline 内存与冷段文件的字节数
+ *      - query    : 各查询在 memory / spill 上的耗时 (ms) 与变慢倍数
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "eunet/core/timeline.hpp"
+
+using namespace core;
+using Clock = std::chrono::steady_clock;
+
+// ================= 配置参数 =================
+constexpr int TARGETS = 4;
+constexpr std::int64_t PROBE_INTERVAL_NS = 60'000'000'000; // 每个目标每分钟一次
+constexpr std::int64_t CAPTURE_NS = 3 * 24 * 3600 * 1'000'000'000LL;
+constexpr int BODY_CHUNKS = 2;
+constexpr int FAIL_EVERY = 97; // 约 1% 的探测超时
+constexpr std::size_t MEMORY_BUDGET = 16 * 1024 * 1024;
+
+double ms_since(Clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+std::vector<std::byte> bytes_of(const std::string &s)
+{
+    std::vector<std::byte> out(s.size());
+    for (std::size_t i = 0; i < s.size(); ++i)
+        out[i] = static_cast<std::byte>(s[i]);
+    return out;
+}
+
+void fill(Timeline &tl)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> jitter_us(200, 5000);
+    auto err = util::Error::transport().timeout().message("connect timeout").build();
+    platform::net::TcpInfo info{};
+    info.snd_cwnd = 10;
+    info.snd_mss = 1448;
+
+    std::int64_t start = platform::time::event_now() - CAPTURE_NS;
+    SessionId sid = 0;
+
+    for (std::int64_t t = 0; t < CAPTURE_NS; t += PROBE_INTERVAL_NS)
+    {
+        for (int target = 0; target < TARGETS; ++target)
+        {
+            ++sid;
+            int fd = 10 + target;
+            std::int64_t ts = start + t + target * 1'000'000;
+            std::string host = "probe" + std::to_string(target) + ".example.com";
+
+            auto push = [&](EventType type, MessageId msg, RecordExtras extras = {}, std::uint64_t arg = 0)
+            {
+                auto rec = make_record(type, msg, type == EventType::DNS_RESOLVE_START ||
+                                                          type == EventType::DNS_RESOLVE_DONE
+                                                      ? -1
+                                                      : fd,
+                                       sid);
+                ts += jitter_us(rng) * 1000;
+                rec.ts_ns = ts;
+                rec.args[0] = arg;
+                (void)tl.push(rec, extras);
+            };
+
+            push(EventType::DNS_RESOLVE_START, MessageId::ResolvingHost, {.text = host});
+            push(EventType::DNS_RESOLVE_DONE, MessageId::ResolvedTo, {.text = "10.0.0." + std::to_string(target + 1)});
+            push(EventType::TCP_CONNECT_START, MessageId::Connecting, {.text = host}, 443);
+            if (sid % FAIL_EVERY == 0)
+            {
+                push(EventType::TCP_CONNECT_TIMEOUT, MessageId::Text, {.text = "connect timeout", .error = &err});
+                continue;
+            }
+            push(EventType::TCP_CONNECT_SUCCESS, MessageId::ConnectionEstablished);
+
+            info.rtt_us = 800 + static_cast<std::uint32_t>(rng() % 400);
+            push(EventType::TCP_INFO_SAMPLE, MessageId::TcpInfoSample, {.tcp_info = &info});
+            push(EventType::HTTP_REQUEST_BUILD, MessageId::HttpGet, {.text = "/health"});
+            push(EventType::HTTP_SENT, MessageId::HttpRequestSent);
+
+            auto headers = "HTTP/1.1 200 OK\r\n"
+                           "Server: nginx/1.24.0\r\n"
+                           "Date: " + std::to_string((start + t) / 1'000'000'000) + "\r\n"
+                           "Content-Type: application/json\r\n"
+                           "Cache-Control: no-cache\r\n"
+                           "X-Request-Id: " + std::to_string(rng()) + "\r\n"
+                           "Connection: close\r\n";
+            push(EventType::HTTP_HEADERS_RECEIVED, MessageId::Text, {.text = headers});
+
+            auto body = bytes_of("{\"status\":\"ok\",\"target\":" + std::to_string(target) +
+                                 ",\"checked_at\":" + std::to_string(ts) +
+                                 ",\"components\":{\"db\":\"ok\",\"cache\":\"ok\",\"queue\":\"ok\"},"
+                                 "\"version\":\"2.14.1\",\"region\":\"eu-west-1\",\"padding\":\"" +
+                                 std::string(400, 'x') + "\"}");
+            for (int c = 0; c < BODY_CHUNKS; ++c)
+                push(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, {.payload = body}, body.size());
+            push(EventType::HTTP_BODY_DONE, MessageId::Text, {.text = "body done"});
+            push(EventType::CONNECTION_CLOSED, MessageId::ClosingConnection);
+        }
+    }
+}
+
+struct Row
+{
+    const char *name;
+    double mem_ms;
+    double spill_ms;
+    std::size_t hits;
+};
+
+void print(const Row &r)
+{
+    std::cout << "  " << std::left << std::setw(22) << r.name
+              << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << r.mem_ms << " ms"
+              << std::setw(10) << r.spill_ms << " ms"
+              << std::setw(8) << std::setprecision(1) << r.spill_ms / std::max(r.mem_ms, 1e-6) << "x"
+              << "  hits=" << r.hits << "\n";
+}
+
+double mib(std::size_t bytes)
+{
+    return bytes / (1024.0 * 1024.0);
+}
+
+int main()
+{
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Timeline Spill] 3-day capture, targets=" << TARGETS
+              << ", budget=" << mib(MEMORY_BUDGET) << " MiB\n";
+
+    auto dir = std::filesystem::temp_directory_path() / ("eunet_spill_bench_" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+
+    Timeline mem;
+    auto t0 = Clock::now();
+    fill(mem);
+    double mem_ingest = ms_since(t0);
+
+    Timeline spill;
+    if (spill.enable_spill({.dir = dir.string(), .memory_budget = MEMORY_BUDGET}).is_err())
+    {
+        std::cout << "  enable_spill failed\n";
+        return 1;
+    }
+    t0 = Clock::now();
+    fill(spill);
+    double spill_ingest = ms_since(t0);
+    t0 = Clock::now();
+    spill.flush_spill();
+    double drain = ms_since(t0);
+
+    auto events = mem.size();
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "  events      : " << events << " (cold " << spill.cold_size() << ")\n";
+    std::cout << "  ingest      : memory " << mem_ingest << " ms ("
+              << events / (mem_ingest / 1000.0) << " events/s), spill " << spill_ingest << " ms ("
+              << events / (spill_ingest / 1000.0) << " events/s), drain " << drain << " ms\n";
+    std::cout << "  memory      : " << mib(mem.memory_bytes()) << " MiB -> " << mib(spill.memory_bytes()) << " MiB\n";
+    std::cout << "  disk        : " << mib(spill.disk_bytes()) << " MiB\n";
+
+    std::cout << "  " << std::left << std::setw(22) << "query" << std::right
+              << std::setw(13) << "memory" << std::setw(13) << "spill" << std::setw(9) << "slower" << "\n";
+
+    auto bench = [&](const char *name, auto &&fn)
+    {
+        auto t = Clock::now();
+        auto n = fn(mem);
+        double m = ms_since(t);
+        t = Clock::now();
+        auto c = fn(spill);
+        print({name, m, ms_since(t), c == n ? n : 0});
+    };
+
+    // 第一天的一小时落在冷段中，最后一小时仍在内存中
+    auto first = mem.event_at(0).unwrap().ts + std::chrono::hours(12);
+    auto last = mem.event_at(events - 1).unwrap().ts - std::chrono::hours(1);
+    auto old_end = first + std::chrono::hours(1);
+    auto new_end = last + std::chrono::hours(1);
+
+    bench("count_by_fd", [](Timeline &tl)
+          { return tl.count_by_fd(12); });
+    bench("query_by_fd", [](Timeline &tl)
+          { return tl.query_by_fd(12).size(); });
+    bench("query_by_type", [](Timeline &tl)
+          { return tl.query_by_type(EventType::TCP_INFO_SAMPLE).size(); });
+    bench("query_by_time (cold)", [&](Timeline &tl)
+          { return tl.query_by_time(first, old_end).size(); });
+    bench("query_by_time (hot)", [&](Timeline &tl)
+          { return tl.query_by_time(last, new_end).size(); });
+    bench("query_errors", [](Timeline &tl)
+          { return tl.query_errors().size(); });
+    bench("fd+type+time (cold)", [&](Timeline &tl)
+          {
+              TimelineQuery q;
+              q.fd = 13;
+              q.types = {EventType::HTTP_RECEIVED};
+              q.start = first;
+              q.end = old_end;
+              return tl.query(q).size(); });
+    bench("event_at x2000", [&](Timeline &tl)
+          {
+              // 随机按下标访问：冷段需从最近的解码起点解码
+              std::mt19937 rng(1);
+              std::size_t n = 0;
+              for (int i = 0; i < 2000; ++i)
+                  n += tl.event_at(rng() % events).is_ok();
+              return n; });
+
+    std::filesystem::remove_all(dir);
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "Benchmark finished." << std::endl;
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * ============================================================================
+ *  File Name   : benchmark_trace_open_test.cpp
+ *  Module      : test
+ *
+ *  Description :
+ *      追踪文件的打开与查询基准测试。先写出一个大文件，再比较：
+ *          mmap open       : TraceFile::open，只读取索引
+ *          reload timeline : 把文件中的全部事件重新写入 Timeline（逐条解析的做法）
+ *          query on map    : 在映射上直接执行各类查询
+ *
+ *  Metrics :
+ *      - size        : 文件字节数与记录条数
+ *      - write       : 写出整个文件的耗时与吞吐
+ *      - open        : 打开耗时 (ms)
+ *      - reload      : 重建 Timeline 的耗时 (ms)
+ *      - query       : 各查询的耗时 (ms) 与命中数
+ *
+ *  Author      : 爱特小登队
+ *  Created On  : 2026-10-18
+ *
+ * ============================================================================
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "eunet/core/timeline.hpp"
+#include "eunet/core/trace_file.hpp"
+
+using namespace core;
+using Clock = std::chrono::steady_clock;
+
+// ================= 配置参数 =================
+constexpr std::size_t RECORDS = 8'000'000; // 约 0.5 GB
+constexpr std::size_t RELOAD = 1'000'000;  // 重建 Timeline 的条数（全量过慢）
+constexpr int FDS = 64;
+constexpr int SESSIONS = 4096;
+
+double ms_since(Clock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+void row(const char *name, double ms, std::size_t hits)
+{
+    std::cout << "  " << std::left << std::setw(22) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(3) << ms << " ms"
+              << "  hits=" << hits << "\n";
+}
+
+int main()
+{
+    auto path = (std::filesystem::temp_directory_path() /
+                 ("eunet_bench_" + std::to_string(::getpid()) + ".trace"))
+                    .string();
+
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "[Trace File Open & Query] records=" << RECORDS << "\n";
+
+    // 写出：按块构造记录，每条带一段文本
+    auto t0 = Clock::now();
+    {
+        auto w = TraceWriter::create(path).unwrap();
+        std::vector<EventRecord> records;
+        RecordArena arena;
+        std::int64_t ts = platform::time::event_now();
+
+        for (std::size_t i = 0; i < RECORDS; ++i)
+        {
+            auto type = static_cast<EventType>(i % EVENT_TYPE_COUNT);
+            auto rec = make_record(type, MessageId::ReceivedBytes,
+                                   static_cast<int>(i % FDS),
+                                   static_cast<SessionId>(i % SESSIONS + 1));
+            rec.ts_ns = ts + static_cast<std::int64_t>(i) * 100;
+            rec.args[0] = i;
+            if (i % 97 == 0)
+            {
+                auto err = util::Error::transport().timeout().message("timeout").build();
+                arena.attach(rec, {.error = &err});
+            }
+            records.push_back(rec);
+
+            if (records.size() == TraceWriter::CHUNK_CAPACITY || i + 1 == RECORDS)
+            {
+                (void)w.append(records, arena);
+                records.clear();
+                arena.clear();
+            }
+        }
+    }
+    double write_ms = ms_since(t0);
+    auto bytes = std::filesystem::file_size(path);
+    std::cout << "  size  : " << bytes / (1024 * 1024) << " MiB\n";
+    std::cout << "  write : " << std::fixed << std::setprecision(1) << write_ms << " ms ("
+              << (bytes / (1024.0 * 1024.0)) / (write_ms / 1000.0) << " MiB/s)\n";
+
+    // 打开
+    t0 = Clock::now();
+    auto opened = TraceFile::open(path);
+    double open_ms = ms_since(t0);
+    if (opened.is_err())
+    {
+        std::cerr << opened.unwrap_err().format() << "\n";
+        return 1;
+    }
+    const auto &trace = opened.unwrap();
+    row("mmap open", open_ms, trace.size());
+
+    // 对照：把前 RELOAD 条事件还原后重新写入 Timeline
+    t0 = Clock::now();
+    {
+        Timeline tl;
+        for (std::size_t i = 0; i < RELOAD; ++i)
+            (void)tl.push(trace.event_at(i).unwrap());
+        row("reload timeline (1M)", ms_since(t0), tl.size());
+    }
+
+    // 查询直接在映射上执行；第一次访问会触发缺页
+    auto start = trace.event_at(RECORDS / 2).unwrap().ts;
+    auto end = trace.event_at(RECORDS / 2 + 10'000).unwrap().ts;
+
+    t0 = Clock::now();
+    auto n = trace.count_by_time(start, end);
+    row("count_by_time", ms_since(t0), n);
+
+    t0 = Clock::now();
+    auto window = trace.query_by_time(start, end);
+    row("query_by_time (10k)", ms_since(t0), window.size());
+
+    t0 = Clock::now();
+    n = trace.count_by_fd(7);
+    row("count_by_fd (cold)", ms_since(t0), n);
+
+    t0 = Clock::now();
+    n = trace.count_by_fd(7);
+    row("count_by_fd (warm)", ms_since(t0), n);
+
+    t0 = Clock::now();
+    auto errors = trace.query_errors();
+    row("query_errors", ms_since(t0), errors.size());
+
+    TimelineQuery q;
+    q.fd = 3;
+    q.session = 4;
+    q.start = start;
+    q.end = end;
+    t0 = Clock::now();
+    n = trace.count_matching(q);
+    row("fd+session+time", ms_since(t0), n);
+
+    std::filesystem::remove(path);
+    std::cout << "------------------------------------------------------------\n";
+    std::cout << "Benchmark finished." << std::endl;
+    return 0;
+}
@@ -0,0 +1,256 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "eunet/core/orchestrator.hpp"
+#include "eunet/core/engine.hpp"
+#include "eunet/core/sink/json_sink.hpp"
+#include "eunet/net/http_scenario.hpp"
+
+using namespace core;
+using namespace core::sink;
+
+static std::vector<std::string> lines_of(const std::string &s)
+{
+    std::vector<std::string> out;
+    std::istringstream in(s);
+    for (std::string line; std::getline(in, line);)
+        out.push_back(line);
+    return out;
+}
+
+static bool contains(const std::string &s, const std::string &needle)
+{
+    return s.find(needle) != std::string::npos;
+}
+
+static Event with_session(Event e, SessionId sid)
+{
+    e.session_id = sid;
+    return e;
+}
+
+void test_escape()
+{
+    assert(JsonSink::escape("plain") == "plain");
+    assert(JsonSink::escape("a\"b\\c") == "a\\\"b\\\\c");
+    assert(JsonSink::escape("x\ny\tz") == "x\\ny\\tz");
+    assert(JsonSink::escape(std::string("\x01", 1)) == "\\u0001");
+}
+
+void test_session_phases()
+{
+    std::ostringstream os;
+    auto json = std::make_shared<JsonSink>(os);
+
+    Orchestrator orch;
+    orch.attach(json);
+
+    auto a = orch.new_session();
+    auto b = orch.new_session();
+
+    // 两个会话的事件交错到达，按 session_id 各自聚合
+    assert(orch.emit(with_session(Event::info(EventType::DNS_RESOLVE_START, "dns"), a)).is_ok());
+    assert(orch.emit(with_session(Event::info(EventType::DNS_RESOLVE_START, "dns"), b)).is_ok());
+    assert(orch.emit(with_session(Event::info(EventType::DNS_RESOLVE_DONE, "dns"), a)).is_ok());
+    assert(orch.emit(with_session(Event::info(EventType::TCP_CONNECT_START, "c", {7}), a)).is_ok());
+    assert(orch.emit(with_session(Event::info(EventType::TCP_CONNECT_SUCCESS, "c", {7}), a)).is_ok());
+    assert(orch.emit(with_session(Event::info(EventType::HTTP_REQUEST_BUILD, "b", {7}), a)).is_ok());
+    assert(orch.emit(with_session(Event::info(EventType::HTTP_SENT, "s", {7}), a)).is_ok());
+
+    std::vector<std::byte> chunk(10, std::byte{'x'});
+    assert(orch.emit(with_session(Event::info(EventType::HTTP_RECEIVED, "r", {7}, chunk), a)).is_ok());
+    assert(orch.emit(with_session(Event::info(EventType::HTTP_RECEIVED, "r", {7}, chunk), a)).is_ok());
+    assert(orch.emit(with_session(Event::info(EventType::CONNECTION_CLOSED, "bye", {7}), a)).is_ok());
+
+    // 关闭后的事件不会生成第二条记录
+    assert(orch.emit(with_session(Event::info(EventType::CONNECTION_CLOSED, "bye", {7}), a)).is_ok());
+
+    auto err = util::Error::transport()
+                   .timeout()
+                   .message("connect \"timed out\"")
+                   .build();
+    assert(orch.emit(with_session(Event::failure(EventType::TCP_CONNECT_START, err), b)).is_ok());
+
+    // 失败后的迟到事件被丢弃，不会重新生成会话
+    assert(orch.emit(with_session(Event::info(EventType::CONNECTION_CLOSED, "bye"), b)).is_ok());
+
+    // 结束的会话立即输出并从表中移除
+    assert(json->pending() == 0);
+
+    auto lines = lines_of(os.str());
+    assert(lines.size() == 3);
+
+    const auto &sa = lines[0];
+    assert(contains(sa, "\"type\":\"session\""));
+    assert(contains(sa, "\"session\":" + std::to_string(a)));
+    assert(contains(sa, "\"fd\":7"));
+    assert(contains(sa, "\"bytes_received\":20"));
+    assert(contains(sa, "\"ok\":true"));
+    assert(contains(sa, "\"error\":null"));
+    assert(!contains(sa, "\"dns_ms\":null"));
+    assert(!contains(sa, "\"ttfb_ms\":null"));
+
+    // 失败事件立即输出，且消息中的引号被转义
+    const auto &eb = lines[1];
+    assert(contains(eb, "\"type\":\"error\""));
+    assert(contains(eb, "\"session\":" + std::to_string(b)));
+    assert(contains(eb, "\"category\":\"Timeout\""));
+    assert(contains(eb, "\\\"timed out\\\""));
+
+    // 失败即结束会话，缺失阶段为 null
+    const auto &sb = lines[2];
+    assert(contains(sb, "\"type\":\"session\""));
+    assert(contains(sb, "\"session\":" + std::to_string(b)));
+    assert(contains(sb, "\"ok\":false"));
+    assert(contains(sb, "\"connect_ms\":null"));
+    assert(contains(sb, "\"category\":\"Timeout\""));
+
+    // 未结束的会话在 flush 时补齐
+    auto c = orch.new_session();
+    assert(orch.emit(with_session(Event::info(EventType::TCP_CONNECT_START, "c", {9}), c)).is_ok());
+    assert(json->pending() == 1);
+
+    json->flush();
+    assert(json->pending() == 0);
+    lines = lines_of(os.str());
+    assert(lines.size() == 4);
+    assert(contains(lines[3], "\"session\":" + std::to_string(c)));
+    assert(contains(lines[3], "\"connect_ms\":null"));
+
+    json->flush();
+    assert(json->written() == 4);
+
+    std::cout << "JsonSink session phase test passed.\n";
+}
+
+void test_raw_events()
+{
+    std::ostringstream os;
+    auto json = std::make_shared<JsonSink>(os, JsonSinkOptions{.events = true});
+
+    Orchestrator orch;
+    orch.attach(json);
+
+    // session 0 的事件只在逐条模式下输出，不参与聚合
+    assert(orch.emit(Event::info(EventType::TCP_CONNECT_START, "line\nbreak", {3})).is_ok());
+    json->flush();
+
+    auto lines = lines_of(os.str());
+    assert(lines.size() == 1);
+    assert(contains(lines[0], "\"type\":\"event\""));
+    assert(contains(lines[0], "\"msg\":\"line\\nbreak\""));
+
+    std::cout << "JsonSink raw event test passed.\n";
+}
+
+static void serve_once(int listen_fd)
+{
+    static const char RESPONSE[] =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Length: 5\r\n"
+        "Connection: close\r\n"
+        "\r\n"
+        "hello";
+
+    int fd = ::accept(listen_fd, nullptr, nullptr);
+    assert(fd >= 0);
+
+    std::string req;
+    char buf[1024];
+    while (req.find("\r\n\r\n") == std::string::npos)
+    {
+        ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0)
+            break;
+        req.append(buf, static_cast<size_t>(n));
+    }
+
+    (void)::send(fd, RESPONSE, sizeof(RESPONSE) - 1, 0);
+    ::close(fd);
+}
+
+void test_headless_engine()
+{
+    int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    assert(listen_fd >= 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    assert(::bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) == 0);
+    assert(::listen(listen_fd, 4) == 0);
+    socklen_t len = sizeof(addr);
+    assert(::getsockname(listen_fd, (sockaddr *)&addr, &len) == 0);
+    uint16_t port = ntohs(addr.sin_port);
+
+    std::thread server(serve_once, listen_fd);
+
+    std::ostringstream os;
+    auto json = std::make_shared<JsonSink>(os);
+
+    Orchestrator orch;
+    orch.attach(json);
+    NetworkEngine engine(orch);
+
+    // 与 --json 模式相同的执行路径：经引擎运行场景并等待结束
+    assert(engine.execute(std::make_unique<net::http::HttpGetScenario>(
+        "http://127.0.0.1:" + std::to_string(port) + "/")));
+    engine.wait();
+    assert(!engine.last_error());
+
+    server.join();
+    ::close(listen_fd);
+
+    // 连接到一个已关闭的端口，场景失败并被记录
+    assert(engine.execute(std::make_unique<net::http::HttpGetScenario>(
+        "http://127.0.0.1:" + std::to_string(port) + "/")));
+    engine.wait();
+    assert(engine.last_error());
+
+    json->flush();
+
+    auto lines = lines_of(os.str());
+    size_t ok_sessions = 0, failed_sessions = 0, errors = 0;
+    for (const auto &l : lines)
+    {
+        if (contains(l, "\"type\":\"session\""))
+        {
+            assert(!contains(l, "\"session\":0,"));
+            if (contains(l, "\"ok\":true"))
+            {
+                ++ok_sessions;
+                assert(contains(l, "\"bytes_received\":"));
+                assert(!contains(l, "\"connect_ms\":null"));
+                assert(!contains(l, "\"ttfb_ms\":null"));
+            }
+            else
+                ++failed_sessions;
+        }
+        else if (contains(l, "\"type\":\"error\""))
+            ++errors;
+    }
+
+    assert(ok_sessions == 1);
+    assert(failed_sessions == 1);
+    assert(errors >= 1);
+
+    std::cout << "headless engine NDJSON test passed.\n";
+}
+
+int main()
+{
+    test_escape();
+    test_session_phases();
+    test_raw_events();
+    test_headless_engine();
+    return 0;
+}
@@ -60,6 +60,47 @@ int main()
     assert(m.total_events == 3);
     assert(m.errors == 1);
 
+    // TCP_INFO 采样按会话累积；同一 fd 被后续会话复用时不会合并
+    auto sample = [&](SessionId sid, int fd, uint32_t rtt, uint32_t retrans, uint32_t unacked)
+    {
+        platform::net::TcpInfo info;
+        info.rtt_us = rtt;
+        info.total_retrans = retrans;
+        info.unacked = unacked;
+
+        Event e = Event::tcp_sample(info, {fd});
+        e.session_id = sid;
+        sink.on_event(EventSnapshot{
+            .event = e,
+            .fd = fd,
+            .state = LifeState::Receiving,
+            .ts = e.ts,
+        });
+    };
+
+    sample(11, 7, 300, 2, 4);
+    sample(11, 7, 100, 2, 1);
+    sample(12, 7, 5000, 9, 0);
+
+    assert(m.tcp_info_samples == 3);
+    assert(!sink.connection(3));
+
+    auto conn = sink.connection(11);
+    assert(conn);
+    assert(conn->fd == 7);
+    assert(conn->samples == 2);
+    assert(conn->min_rtt_us == 100);
+    assert(conn->max_rtt_us == 300);
+    assert(conn->max_unacked == 4);
+    assert(conn->last.total_retrans == 2);
+
+    auto reused = sink.connection(12);
+    assert(reused);
+    assert(reused->fd == 7);
+    assert(reused->samples == 1);
+    assert(reused->min_rtt_us == 5000);
+    assert(reused->last.total_retrans == 9);
+
     std::cout << "[OK] MetricsSink basic counting test passed\n";
     return 0;
 }
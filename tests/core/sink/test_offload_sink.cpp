@@ -0,0 +1,83 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "eunet/core/orchestrator.hpp"
+#include "eunet/core/engine.hpp"
+#include "eunet/core/sink/offload_sink.hpp"
+#include "eunet/core/sink/metrics_sink.hpp"
+
+using namespace core;
+using namespace core::sink;
+
+// 记录处理线程与事件顺序的内层 Sink
+class RecordingSink : public IEventSink
+{
+public:
+    std::vector<int> fds;
+    std::vector<std::thread::id> threads;
+
+    void on_event(const EventSnapshot &s) override
+    {
+        fds.push_back(s.fd);
+        threads.push_back(std::this_thread::get_id());
+    }
+};
+
+int main()
+{
+    auto sched_res = platform::sched::Scheduler::create({.threads = 2});
+    assert(sched_res.is_ok());
+    auto sched = std::move(sched_res.unwrap());
+    sched->start();
+
+    constexpr int EVENTS = 500;
+    auto recorder = std::make_shared<RecordingSink>();
+    auto metrics = std::make_shared<MetricsSink>();
+    auto offload = std::make_shared<OffloadSink>(recorder, *sched);
+
+    {
+        Orchestrator orch;
+        orch.attach(offload);
+        orch.attach(std::make_shared<OffloadSink>(metrics, *sched));
+
+        for (int i = 0; i < EVENTS; ++i)
+            assert(orch.emit(Event::info(EventType::TCP_CONNECT_START, "c", {i})).is_ok());
+
+        sched->wait_idle();
+    }
+
+    // 事件在 worker 线程上按 emit 顺序处理
+    assert(offload->processed() == EVENTS);
+    assert(offload->pending() == 0);
+    assert(recorder->fds.size() == EVENTS);
+    for (int i = 0; i < EVENTS; ++i)
+    {
+        assert(recorder->fds[i] == i);
+        assert(recorder->threads[i] != std::this_thread::get_id());
+    }
+    assert(metrics->snapshot().total_events == EVENTS);
+
+    // NetworkEngine 提交的 CPU 任务：未绑定调度器时内联执行，绑定后交给 worker
+    {
+        Orchestrator orch;
+        NetworkEngine engine(orch);
+
+        std::thread::id ran_on;
+        engine.submit([&]
+                      { ran_on = std::this_thread::get_id(); });
+        assert(ran_on == std::this_thread::get_id());
+
+        engine.set_scheduler(sched.get());
+        engine.submit([&]
+                      { ran_on = std::this_thread::get_id(); },
+                      platform::sched::Priority::High);
+        sched->wait_idle();
+        assert(ran_on != std::this_thread::get_id());
+    }
+
+    std::cout << "OffloadSink tests passed.\n";
+    return 0;
+}
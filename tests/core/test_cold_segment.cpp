@@ -0,0 +1,214 @@
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "eunet/core/cold_segment.hpp"
+#include "eunet/core/timeline.hpp"
+
+using namespace core;
+
+static std::vector<std::byte> bytes_of(const std::string &s)
+{
+    std::vector<std::byte> out;
+    for (char c : s)
+        out.push_back(static_cast<std::byte>(c));
+    return out;
+}
+
+static void assert_same(const Event &a, const Event &b)
+{
+    assert(a.type == b.type);
+    assert(a.fd.fd == b.fd.fd);
+    assert(a.session_id == b.session_id);
+    assert(a.msg == b.msg);
+    assert(a.ts == b.ts);
+    assert(a.kernel_ts == b.kernel_ts);
+    assert(a.payload == b.payload);
+    assert(a.is_error() == b.is_error());
+    if (a.error)
+    {
+        assert(a.error->category() == b.error->category());
+        assert(a.error->message() == b.error->message());
+        assert((a.error->cause() == nullptr) == (b.error->cause() == nullptr));
+    }
+    assert(a.tcp_info.has_value() == b.tcp_info.has_value());
+    if (a.tcp_info)
+        assert(a.tcp_info->rtt_us == b.tcp_info->rtt_us);
+}
+
+static void same_list(const std::vector<Event> &a, const std::vector<Event> &b)
+{
+    assert(a.size() == b.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+        assert_same(a[i], b[i]);
+}
+
+// 近似长时间监测的记录：相同的消息、几乎相同的响应头、重复的载荷
+static void fill(Timeline &tl, int n, bool shuffle_ts = false)
+{
+    const EventType types[] = {
+        EventType::TCP_CONNECT_START,
+        EventType::HTTP_SENT,
+        EventType::HTTP_HEADERS_RECEIVED,
+        EventType::HTTP_RECEIVED,
+        EventType::TCP_INFO_SAMPLE,
+    };
+
+    auto base = platform::time::event_now();
+    for (int i = 0; i < n; ++i)
+    {
+        auto type = types[i % 5];
+        auto rec = make_record(type, MessageId::Text, i % 7, static_cast<SessionId>(i / 5 + 1));
+        rec.ts_ns = base + std::int64_t{i} * 1'000'000 + (shuffle_ts && i % 3 == 0 ? -5'000'000 : 0);
+        rec.args[0] = static_cast<std::uint64_t>(i % 4);
+        if (i % 13 == 0)
+        {
+            rec.flags |= EventRecord::HAS_KERNEL_TS;
+            rec.kernel_delay_ns = -(i % 50) * 1000;
+        }
+
+        std::string text = "event " + std::to_string(i % 20);
+        if (type == EventType::HTTP_HEADERS_RECEIVED)
+            text = "HTTP/1.1 200 OK\r\nServer: demo\r\nDate: " + std::to_string(i) + "\r\nContent-Length: 512\r\n";
+
+        auto payload = bytes_of(std::string(300 + i % 3, static_cast<char>('a' + i % 3)) + std::to_string(i % 40));
+        auto cause = util::Error::system().code(i).connection_refused().message("refused").build();
+        auto err = util::Error::transport().timeout().message("slow " + std::to_string(i)).wrap(cause).build();
+        platform::net::TcpInfo info{};
+        info.rtt_us = static_cast<std::uint32_t>(i);
+
+        RecordExtras extras{.text = text};
+        if (type == EventType::HTTP_RECEIVED)
+            extras.payload = payload;
+        if (i % 17 == 16)
+            extras.error = &err;
+        if (type == EventType::TCP_INFO_SAMPLE)
+            extras.tcp_info = &info;
+        (void)tl.push(rec, extras);
+    }
+}
+
+void test_roundtrip()
+{
+    Timeline tl;
+    fill(tl, 5000);
+    auto snap = tl.snapshot();
+
+    auto opened = ColdSegment::compress(snap);
+    assert(opened.is_ok());
+    const auto &seg = opened.unwrap();
+    assert(seg.size() == tl.size());
+    assert(seg.ordered());
+    assert(seg.has_type(EventType::HTTP_SENT));
+    assert(!seg.has_type(EventType::DNS_RESOLVE_START));
+    assert(seg.may_contain_fd(3));
+
+    // 重复内容占比很高，映像应远小于 Timeline 的内存占用
+    assert(seg.image_bytes() * 5 < tl.memory_bytes());
+
+    same_list(seg.replay_all(), tl.replay_all());
+
+    for (std::size_t i : {0, 1, 127, 128, 129, 2500, 4999})
+    {
+        assert_same(seg.event_at(i).unwrap(), tl.event_at(i).unwrap());
+        assert(seg.record_at(i).ts_ns == snap.ref_at(i).rec->ts_ns);
+    }
+    assert(seg.event_at(seg.size()).is_err());
+    assert(!seg.event_at(3, false).unwrap().payload);
+
+    same_list(seg.query_by_fd(3), tl.query_by_fd(3));
+    same_list(seg.query_by_type(EventType::HTTP_HEADERS_RECEIVED), tl.query_by_type(EventType::HTTP_HEADERS_RECEIVED));
+    same_list(seg.query_by_session(42), tl.query_by_session(42));
+    same_list(seg.query_errors(), tl.query_errors());
+    assert(seg.count_by_fd(5) == tl.count_by_fd(5));
+    assert(seg.count_by_type(EventType::HTTP_RECEIVED) == tl.count_by_type(EventType::HTTP_RECEIVED));
+    assert(seg.count_by_session(7) == tl.count_by_session(7));
+    assert(seg.count_by_fd(1000) == 0);
+
+    auto all = tl.replay_all();
+    auto start = all[1000].ts;
+    auto end = all[3333].ts;
+    same_list(seg.query_by_time(start, end), tl.query_by_time(start, end));
+    assert(seg.count_by_time(start, end) == tl.count_by_time(start, end));
+    assert(seg.count_by_time(end, start) == 0);
+    assert(seg.count_by_time(all.front().ts, all.back().ts) == tl.size());
+
+    TimelineQuery q;
+    q.fd = 2;
+    q.types = {EventType::HTTP_RECEIVED, EventType::HTTP_SENT};
+    q.start = start;
+    q.end = end;
+    same_list(seg.query(q), tl.query(q));
+    assert(seg.count_matching(q) == tl.count_matching(q));
+
+    auto idxs = seg.select(q);
+    same_list(seg.materialize(idxs), tl.query(q));
+    idxs.push_back(seg.size() + 10);
+    assert(seg.materialize(idxs).size() == idxs.size() - 1);
+}
+
+void test_unordered_and_partial()
+{
+    Timeline tl;
+    fill(tl, 1000, true);
+    auto snap = tl.snapshot();
+
+    // 只压缩中间一段
+    auto seg = ColdSegment::compress(snap, 300, 400).unwrap();
+    assert(seg.size() == 400);
+    assert(!seg.ordered());
+    for (std::size_t i = 0; i < seg.size(); i += 37)
+        assert_same(seg.event_at(i).unwrap(), tl.event_at(300 + i).unwrap());
+
+    auto all = tl.replay_all();
+    auto start = all[400].ts;
+    auto end = all[600].ts;
+    std::size_t expect = 0;
+    for (std::size_t i = 300; i < 700; ++i)
+        expect += all[i].ts >= start && all[i].ts <= end;
+    assert(seg.count_by_time(start, end) == expect);
+    assert(seg.query_by_time(start, end).size() == expect);
+
+    // 空段
+    auto empty = ColdSegment::compress(snap, 2000).unwrap();
+    assert(empty.empty());
+    assert(empty.replay_all().empty());
+    assert(empty.count_by_fd(1) == 0);
+}
+
+void test_reject_corrupt()
+{
+    Timeline tl;
+    fill(tl, 300);
+    auto snap = tl.snapshot();
+
+    std::vector<RecordRef> refs;
+    for (std::size_t i = 0; i < snap.size(); ++i)
+        refs.push_back(snap.ref_at(i));
+
+    std::vector<std::byte> buf;
+    ColdSegment::encode(refs, buf);
+    assert(buf.size() % 8 == 0);
+    assert(ColdSegment::open(buf).is_ok());
+
+    // 截断或损坏魔数
+    assert(ColdSegment::open(std::span<const std::byte>(buf).first(buf.size() / 2)).is_err());
+    auto bad = buf;
+    bad[0] = std::byte{0};
+    assert(ColdSegment::open(bad).is_err());
+
+    // 同一缓冲区中依次存放多个映像
+    std::size_t second = buf.size();
+    ColdSegment::encode(std::span<const RecordRef>(refs).first(10), buf);
+    auto seg = ColdSegment::open(std::span<const std::byte>(buf).subspan(second));
+    assert(seg.is_ok() && seg.unwrap().size() == 10);
+    assert(seg.unwrap().event_at(9).unwrap().msg == tl.event_at(9).unwrap().msg);
+}
+
+int main()
+{
+    test_roundtrip();
+    test_unordered_and_partial();
+    test_reject_corrupt();
+    return 0;
+}
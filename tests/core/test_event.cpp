@@ -71,6 +71,20 @@ void test_event()
     assert(e1.ts.time_since_epoch().count() > 0);
     assert(e3.ts.time_since_epoch().count() > 0);
 
+    // 7. 内核时间戳与用户态时间戳间隔
+    assert(!e1.kernel_delay());
+    {
+        auto e6 = Event::info(EventType::HTTP_RECEIVED, "chunk", {fd_test});
+        e6.kernel_ts = e6.ts - std::chrono::microseconds(150);
+        auto delay = e6.kernel_delay();
+        assert(delay);
+        assert(*delay == -std::chrono::microseconds(150));
+
+        // 发送事件的内核时间戳晚于用户态 间隔为正
+        e6.kernel_ts = e6.ts + std::chrono::microseconds(40);
+        assert(e6.kernel_delay() == std::chrono::microseconds(40));
+    }
+
     std::cout << "=== Event Unit Test Passed ===\n";
 }
 
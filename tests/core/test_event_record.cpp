@@ -0,0 +1,164 @@
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "eunet/core/event_record.hpp"
+#include "eunet/core/orchestrator.hpp"
+
+using namespace core;
+
+static std::vector<std::byte> bytes_of(const std::string &s)
+{
+    std::vector<std::byte> v(s.size());
+    std::memcpy(v.data(), s.data(), s.size());
+    return v;
+}
+
+void test_layout()
+{
+    static_assert(sizeof(EventRecord) <= 64);
+    static_assert(std::is_trivially_copyable_v<EventRecord>);
+}
+
+void test_round_trip()
+{
+    RecordArena arena;
+
+    // 1. 普通事件：文本、FD、会话、载荷、内核时间戳
+    auto e = Event::info(EventType::HTTP_RECEIVED, "chunk", {7}, bytes_of("hello"));
+    e.session_id = 42;
+    e.kernel_ts = e.ts - std::chrono::microseconds(30);
+
+    auto rec = compact(e, arena);
+    assert(rec.fd == 7 && rec.session == 42);
+    assert(rec.has_payload() && !rec.is_error());
+    assert(rec.flags & EventRecord::HAS_KERNEL_TS);
+
+    auto back = materialize(rec, arena);
+    assert(back.type == e.type);
+    assert(back.ts == e.ts);
+    assert(back.kernel_ts == e.kernel_ts);
+    assert(back.fd.fd == 7 && back.session_id == 42);
+    assert(back.msg == "chunk");
+    assert(back.payload && *back.payload == *e.payload);
+
+    // 2. 失败事件与 TCP_INFO 采样
+    auto err = util::Error::transport().timeout().message("timeout").build();
+    auto f = Event::failure(EventType::TCP_CONNECT_TIMEOUT, err, {3});
+    auto f_back = materialize(compact(f, arena), arena);
+    assert(f_back.is_error());
+    assert(f_back.error->message() == "timeout");
+    assert(!f_back.payload);
+
+    platform::net::TcpInfo info{};
+    info.rtt_us = 1234;
+    auto s = Event::tcp_sample(info, {3});
+    auto s_back = materialize(compact(s, arena), arena);
+    assert(s_back.tcp_info && s_back.tcp_info->rtt_us == 1234);
+    assert(s_back.msg == s.msg);
+
+    // 3. 空载荷与无载荷需要区分
+    auto empty = Event::info(EventType::HTTP_SENT, "", {3}, std::vector<std::byte>{});
+    auto empty_back = materialize(compact(empty, arena), arena);
+    assert(empty_back.payload && empty_back.payload->empty());
+
+    // 4. 相同文本只存一份
+    auto id = arena.add_text("chunk");
+    for (int i = 0; i < 100; ++i)
+        assert(compact(Event::info(EventType::HTTP_SENT, "chunk", {3}), arena).text == id);
+}
+
+void test_deferred_format()
+{
+    RecordArena arena;
+
+    auto rec = make_record(EventType::TCP_CONNECT_START, MessageId::Connecting, 5, 9);
+    rec.args[0] = 8080;
+    rec.args[1] = 3000;
+    arena.attach(rec, {.text = "example.com"});
+    assert(render_message(rec, arena) == "Connecting to example.com:8080 (timeout=3000ms)...");
+
+    auto recv = make_record(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, 5, 9);
+    recv.args[0] = 512;
+    assert(render_message(recv, arena) == "Received 512 bytes");
+
+    recv.flags |= EventRecord::HAS_KERNEL_TS;
+    recv.kernel_delay_ns = -25'000;
+    assert(render_message(recv, arena) == "Received 512 bytes (kernel->user 25us)");
+
+    auto e = materialize(recv, arena);
+    assert(e.kernel_delay() == std::chrono::nanoseconds(-25'000));
+
+    auto get = make_record(EventType::HTTP_REQUEST_BUILD, MessageId::HttpGet);
+    arena.attach(get, {.text = "/index.html"});
+    assert(render_message(get, arena) == "HTTP GET /index.html");
+}
+
+void test_adopt()
+{
+    RecordArena a, b;
+    auto payload = bytes_of("xyz");
+    auto rec = make_record(EventType::HTTP_SENT, MessageId::SendingBytes, 4);
+    rec.args[0] = payload.size();
+    a.attach(rec, {.text = "unused", .payload = payload});
+
+    auto moved = b.adopt(rec, a);
+    a.clear();
+
+    auto e = materialize(moved, b);
+    assert(e.msg == "Sending 3 bytes...");
+    assert(e.payload && *e.payload == payload);
+}
+
+class CountingSink : public sink::IEventSink
+{
+public:
+    std::vector<EventSnapshot> seen;
+    void on_event(const EventSnapshot &snap) override { seen.push_back(snap); }
+};
+
+void test_orchestrator_record()
+{
+    Orchestrator orch;
+    auto payload = bytes_of("body");
+
+    // 1. 无 Sink 时只写入 Timeline，不构建快照
+    auto rec = make_record(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, 11, 1);
+    rec.args[0] = payload.size();
+    assert(orch.record(rec, {.payload = payload}).is_ok());
+    assert(orch.dispatch_stats().snapshots_built == 0);
+
+    auto stored = orch.get_timeline().latest_event().unwrap();
+    assert(stored.msg == "Received 4 bytes");
+    assert(stored.session_id == 1 && stored.payload == payload);
+
+    // 2. 不要载荷的 Sink 拿到格式化后的文本与载荷大小
+    auto sink = std::make_shared<CountingSink>();
+    orch.attach(sink, sink::Interest::all().with_payload(false));
+    assert(orch.record(rec, {.payload = payload}).is_ok());
+    assert(sink->seen.size() == 1);
+    assert(sink->seen[0].event.msg == "Received 4 bytes");
+    assert(!sink->seen[0].payload && sink->seen[0].payload_size == 4);
+
+    // 3. 记录同样驱动状态机
+    auto err = util::Error::transport().message("reset").build();
+    auto bad = make_record(EventType::HTTP_RECEIVED, MessageId::Text, 11, 1);
+    assert(orch.record(bad, {.text = "recv failed", .error = &err}).is_ok());
+    assert(orch.get_fsm(1)->current_state() == LifeState::Error);
+    assert(sink->seen.back().event.is_error());
+    assert(orch.get_timeline().query_errors().size() == 1);
+}
+
+int main()
+{
+    test_layout();
+    test_round_trip();
+    test_deferred_format();
+    test_adopt();
+    test_orchestrator_record();
+
+    std::cout << "EventRecord tests passed\n";
+    return 0;
+}
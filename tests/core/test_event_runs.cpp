@@ -0,0 +1,177 @@
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "eunet/core/event_runs.hpp"
+#include "eunet/core/orchestrator.hpp"
+
+using namespace core;
+
+static EventRecord rec_at(std::int64_t ts, int fd, SessionId sid = 0)
+{
+    auto r = make_record(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, fd, sid);
+    r.ts_ns = ts;
+    r.args[0] = static_cast<std::uint64_t>(ts);
+    return r;
+}
+
+void test_seal_and_collect()
+{
+    EventRuns runs(4);
+
+    for (int i = 0; i < 10; ++i)
+        runs.append(rec_at(i, 1));
+
+    // 写满两段后自动封存，剩余 2 条等待 flush
+    assert(runs.pending() == 8);
+    runs.flush();
+    assert(runs.pending() == 10);
+
+    std::vector<EventRuns::RunPtr> out;
+    assert(runs.collect(out) == 3);
+    assert(runs.pending() == 0);
+
+    auto merged = EventRuns::merge(out);
+    assert(merged.size() == 10);
+    for (std::size_t i = 0; i < merged.size(); ++i)
+        assert(merged[i].rec->ts_ns == static_cast<std::int64_t>(i));
+}
+
+void test_kway_merge_and_thread_exit()
+{
+    EventRuns runs(16);
+
+    // 每个线程写交错的时间戳，且不主动 flush：线程退出时自动封存
+    constexpr int THREADS = 4;
+    constexpr int PER = 100;
+    std::vector<std::thread> ths;
+    for (int t = 0; t < THREADS; ++t)
+        ths.emplace_back([&, t]
+                         {
+            for (int i = 0; i < PER; ++i)
+                runs.append(rec_at(i * THREADS + t, 10 + t)); });
+    for (auto &th : ths)
+        th.join();
+
+    assert(runs.pending() == THREADS * PER);
+
+    std::vector<EventRuns::RunPtr> out;
+    runs.collect(out);
+    auto merged = EventRuns::merge(out);
+    assert(merged.size() == THREADS * PER);
+    for (std::size_t i = 0; i < merged.size(); ++i)
+        assert(merged[i].rec->ts_ns == static_cast<std::int64_t>(i));
+}
+
+void test_unsorted_run_is_sorted_on_seal()
+{
+    EventRuns runs;
+    runs.append(rec_at(30, 1));
+    runs.append(rec_at(10, 1));
+    runs.append(rec_at(20, 1));
+    runs.flush();
+
+    std::vector<EventRuns::RunPtr> out;
+    runs.collect(out);
+    auto merged = EventRuns::merge(out);
+    assert(merged[0].rec->ts_ns == 10 && merged[2].rec->ts_ns == 30);
+}
+
+void test_timeline_push_sorted()
+{
+    Timeline tl;
+    RecordArena arena;
+
+    std::vector<EventRecord> head = {rec_at(10, 1), rec_at(20, 2), rec_at(30, 1)};
+    std::vector<EventRecord> late = {rec_at(15, 2), rec_at(25, 1), rec_at(40, 3)};
+
+    std::vector<RecordRef> refs;
+    for (auto &r : head)
+        refs.push_back({&r, &arena});
+    assert(tl.push_sorted(refs).unwrap() == 3);
+
+    // 批次起点早于尾部：只与重叠部分归并，索引随之更新
+    refs.clear();
+    for (auto &r : late)
+        refs.push_back({&r, &arena});
+    assert(tl.push_sorted(refs).unwrap() == 3);
+
+    auto all = tl.replay_all();
+    assert(all.size() == 6);
+    for (std::size_t i = 1; i < all.size(); ++i)
+        assert(all[i - 1].mono_ns <= all[i].mono_ns);
+
+    assert(tl.count_by_fd(1) == 3);
+    assert(tl.count_by_fd(2) == 2);
+    assert(tl.count_by_fd(3) == 1);
+
+    auto fd1 = tl.query_by_fd(1);
+    assert(fd1[0].mono_ns == 10 && fd1[1].mono_ns == 25 && fd1[2].mono_ns == 30);
+    assert(fd1[1].msg == "Received 25 bytes");
+
+    assert(tl.sort_by_time().unwrap() == 6);
+}
+
+void test_orchestrator_merge()
+{
+    Orchestrator orch;
+
+    auto payload = std::vector<std::byte>(8, std::byte{0x11});
+    std::vector<std::thread> ths;
+    for (int t = 0; t < 3; ++t)
+        ths.emplace_back([&, t]
+                         {
+            for (int i = 0; i < 50; ++i)
+            {
+                auto r = make_record(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, 20 + t, t + 1);
+                r.args[0] = payload.size();
+                orch.append(r, {.payload = payload});
+            }
+            orch.flush_local(); });
+    for (auto &th : ths)
+        th.join();
+
+    assert(orch.pending_runs() == 150);
+    assert(orch.merge().unwrap() == 150);
+    assert(orch.pending_runs() == 0);
+    assert(orch.merge().unwrap() == 0);
+
+    const auto &tl = orch.get_timeline();
+    assert(tl.size() == 150);
+    assert(tl.count_by_fd(21) == 50);
+    assert(tl.query_by_fd(22).back().payload == payload);
+
+    auto all = tl.replay_all();
+    for (std::size_t i = 1; i < all.size(); ++i)
+        assert(all[i - 1].ts <= all[i].ts);
+
+    // FSM 按会话更新
+    assert(orch.get_fsm(2) != nullptr);
+}
+
+void test_runs_outlive()
+{
+    // 实例先于线程销毁：线程退出时残留段被丢弃而不是访问已释放的内存
+    auto runs = std::make_unique<EventRuns>();
+    std::thread th([&]
+                   {
+        runs->append(rec_at(1, 1));
+        runs.reset(); });
+    th.join();
+}
+
+int main()
+{
+    test_seal_and_collect();
+    test_kway_merge_and_thread_exit();
+    test_unsorted_run_is_sorted_on_seal();
+    test_timeline_push_sorted();
+    test_orchestrator_merge();
+    test_runs_outlive();
+
+    std::cout << "EventRuns tests passed\n";
+    return 0;
+}
@@ -127,6 +127,14 @@ void test_fsm_timestamp_behavior()
 
     fsm.on_event(make_ok(EventType::DNS_RESOLVE_DONE, 7));
     assert(fsm.last_timestamp() > start);
+    assert(fsm.elapsed() >= std::chrono::milliseconds(1));
+
+    // 乱序到达的较早事件不会让间隔变为负值
+    auto early = make_ok(EventType::TCP_CONNECT_START, 7);
+    early.mono_ns = 0;
+    fsm.on_event(early);
+    assert(fsm.elapsed() >= std::chrono::milliseconds(1));
+    assert(fsm.to_wall(fsm.wall_anchor().event_ns) == fsm.wall_anchor().wall);
 }
 
 /* -------------------------------------------------
@@ -1,5 +1,7 @@
 #include <cassert>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "eunet/core/orchestrator.hpp"
 #include "eunet/core/lifecycle_fsm.hpp"
@@ -109,5 +111,114 @@ int main()
     assert(!fsm->has_error());
 
     std::cout << "[OK] Orchestrator lifecycle test passed.\n";
+
+    // ---------- Lock-free submit / drain ----------
+    {
+        Orchestrator multi;
+        auto msink = std::make_shared<FakeSink>();
+        multi.attach(msink);
+
+        constexpr int PRODUCERS = 4;
+        constexpr int PER = 1000;
+
+        std::vector<std::thread> producers;
+        for (int p = 0; p < PRODUCERS; ++p)
+            producers.emplace_back([&, p]
+                                   {
+                                       for (int i = 0; i < PER; ++i)
+                                       {
+                                           auto e = Event::info(EventType::HTTP_SENT, "send", {100 + p});
+                                           e.session_id = 100 + p;
+                                           multi.submit(e);
+                                       } });
+
+        size_t drained = 0;
+        while (drained < PRODUCERS * PER)
+        {
+            auto r = multi.drain(256);
+            assert(r.is_ok());
+            assert(r.unwrap() <= 256);
+            drained += r.unwrap();
+        }
+        for (auto &t : producers)
+            t.join();
+
+        assert(multi.pending() == 0);
+        assert(multi.drain().unwrap() == 0);
+        assert(multi.get_timeline().size() == PRODUCERS * PER);
+        assert(msink->records.size() == PRODUCERS * PER);
+        for (int p = 0; p < PRODUCERS; ++p)
+            assert(multi.get_timeline().count_by_fd(100 + p) == PER);
+    }
+
+    std::cout << "[OK] Orchestrator submit/drain test passed.\n";
+
+    // ---------- Interest-based dispatch ----------
+    {
+        Orchestrator disp;
+
+        // 不声明条件时订阅全部事件（含载荷）
+        auto all = std::make_shared<FakeSink>();
+        // 只关心 HTTP_RECEIVED 且不要载荷
+        auto recv_lean = std::make_shared<FakeSink>();
+        // 只关心会话 7 的错误
+        auto errors7 = std::make_shared<FakeSink>();
+
+        disp.attach(all);
+        disp.attach(recv_lean,
+                    sink::Interest::only({EventType::HTTP_RECEIVED}).with_payload(false));
+        disp.attach(errors7, sink::Interest::all().errors().session(7));
+
+        std::vector<std::byte> body(64, std::byte{1});
+
+        auto recv = Event::info(EventType::HTTP_RECEIVED, "recv", {5}, body);
+        recv.session_id = 7;
+        assert(disp.emit(recv).is_ok());
+
+        // 全部 Sink 共用不含载荷的快照；all 收到带载荷的快照
+        assert(all->records.size() == 1);
+        assert(all->records[0].payload && all->records[0].payload->size() == 64);
+        assert(all->records[0].event.payload);
+        assert(recv_lean->records.size() == 1);
+        assert(!recv_lean->records[0].payload);
+        assert(!recv_lean->records[0].event.payload);
+        assert(recv_lean->records[0].payload_size == 64);
+        assert(errors7->records.empty());
+
+        // Timeline 中的事件仍保留载荷
+        assert(disp.get_timeline().query_by_fd(5).front().payload);
+
+        auto err = util::Error::transport().timeout().message("t").build();
+        auto fail7 = Event::failure(EventType::TCP_CONNECT_TIMEOUT, err, {6});
+        fail7.session_id = 7;
+        auto fail8 = fail7;
+        fail8.session_id = 8;
+        assert(disp.emit(fail7).is_ok());
+        assert(disp.emit(fail8).is_ok());
+
+        assert(errors7->records.size() == 1);
+        assert(errors7->records[0].event.session_id == 7);
+        assert(recv_lean->records.size() == 1);
+        assert(all->records.size() == 3);
+
+        auto st = disp.dispatch_stats();
+        assert(st.deliveries == 5);
+        assert(st.snapshots_built == 4); // recv 两种各一份，两个失败事件各一份
+        assert(st.payload_snapshots == 1);
+        assert(st.filtered == 2);        // recv 与 fail8 未通过 errors7 的条件
+        assert(st.snapshots_skipped == 0);
+
+        // 无人订阅的事件不构建快照
+        disp.detach(all);
+        assert(disp.emit(Event::info(EventType::DNS_RESOLVE_START, "dns")).is_ok());
+        assert(disp.emit(Event::info(EventType::HTTP_SENT, "send", {5})).is_ok());
+
+        st = disp.dispatch_stats();
+        assert(st.snapshots_built == 4);
+        assert(st.snapshots_skipped == 2);
+        assert(disp.get_timeline().size() == 5);
+    }
+
+    std::cout << "[OK] Orchestrator interest dispatch test passed.\n";
     return 0;
 }
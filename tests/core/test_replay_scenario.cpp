@@ -0,0 +1,196 @@
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "eunet/core/orchestrator.hpp"
+#include "eunet/core/replay_scenario.hpp"
+#include "eunet/core/timeline.hpp"
+#include "eunet/core/trace_file.hpp"
+
+using namespace core;
+using scenario::ReplayConfig;
+using scenario::ReplayScenario;
+
+constexpr std::int64_t MS = 1'000'000;
+
+struct FakeSink : sink::IEventSink
+{
+    std::vector<EventSnapshot> records;
+
+    void on_event(const EventSnapshot &snap) override
+    {
+        records.push_back(snap);
+    }
+};
+
+static std::string temp_path(const char *name)
+{
+    auto dir = std::filesystem::temp_directory_path();
+    return (dir / (std::string("eunet_") + name + "_" + std::to_string(::getpid()) + ".trace")).string();
+}
+
+// 写出 n 条记录，相邻记录间隔 gap_ns；会话 100/200 交替，每 4 条带一个错误
+static std::shared_ptr<const TraceFile> make_trace(const std::string &path, int n, std::int64_t gap_ns)
+{
+    Timeline tl;
+    auto base = platform::time::event_now() - 10'000 * MS;
+    for (int i = 0; i < n; ++i)
+    {
+        auto rec = make_record(EventType::HTTP_SENT, MessageId::Text, 3, i % 2 ? 200 : 100);
+        rec.ts_ns = base + i * gap_ns;
+
+        auto text = "event " + std::to_string(i);
+        auto err = util::Error::transport().timeout().message("slow").build();
+        RecordExtras extras{.text = text};
+        if (i % 4 == 3)
+            extras.error = &err;
+        (void)tl.push(rec, extras);
+    }
+
+    auto w = TraceWriter::create(path).unwrap();
+    (void)w.append(tl.snapshot());
+    return std::make_shared<const TraceFile>(TraceFile::open(path).unwrap());
+}
+
+static std::int64_t replay_ms(const std::shared_ptr<const TraceFile> &trace, double speed)
+{
+    Orchestrator orch;
+    ReplayScenario sc(trace, ReplayConfig{.speed = speed});
+    assert(sc.run(orch).is_ok());
+    assert(sc.stats().emitted == trace->size());
+    return sc.stats().elapsed_ns / MS;
+}
+
+void test_order_and_content()
+{
+    auto path = temp_path("replay_order");
+    auto trace = make_trace(path, 8, 5 * MS);
+
+    Orchestrator orch;
+    auto sink = std::make_shared<FakeSink>();
+    orch.attach(sink);
+    auto before = orch.new_session();
+
+    ReplayScenario sc(trace, ReplayConfig{.speed = 0});
+    assert(sc.run(orch).is_ok());
+    assert(!sc.stats().stopped);
+    assert(sc.stats().trace_span_ns == 35 * MS);
+
+    // 经 Orchestrator 写入 Timeline 并分发给 Sink，顺序与内容不变
+    assert(orch.get_timeline().size() == 8);
+    assert(sink->records.size() == 8);
+    for (int i = 0; i < 8; ++i)
+    {
+        const auto &e = sink->records[i].event;
+        assert(e.msg == "event " + std::to_string(i));
+        assert(e.is_error() == (i % 4 == 3));
+        if (i > 0)
+            assert(e.ts - sink->records[i - 1].event.ts == std::chrono::milliseconds(5));
+    }
+    assert(sink->records[3].event.error->message() == "slow");
+
+    // 时间戳平移到回放开始时刻
+    auto now = platform::time::WallClock::now();
+    assert(sink->records.front().event.ts <= now);
+    assert(sink->records.front().event.ts > now - std::chrono::seconds(1));
+
+    // 会话改用新分配的号，同一会话映射到同一个新号
+    auto s0 = sink->records[0].event.session_id;
+    auto s1 = sink->records[1].event.session_id;
+    assert(s0 > before && s1 > before && s0 != s1);
+    assert(sink->records[2].event.session_id == s0);
+    assert(orch.get_timeline().count_by_session(s1) == 4);
+
+    std::filesystem::remove(path);
+}
+
+void test_keep_original()
+{
+    auto path = temp_path("replay_keep");
+    auto trace = make_trace(path, 6, MS);
+
+    Orchestrator orch;
+    ReplayScenario sc(trace, ReplayConfig{.speed = 0, .rebase = false, .remap_sessions = false, .first = 2, .count = 3});
+    assert(sc.run(orch).is_ok());
+    assert(sc.stats().emitted == 3);
+
+    auto events = orch.get_timeline().replay_all();
+    assert(events.size() == 3);
+    assert(events[0].msg == "event 2");
+    assert(events[0].ts == trace->event_at(2).unwrap().ts);
+    assert(events[0].session_id == 100);
+    assert(events[1].session_id == 200);
+
+    // 起点越界时什么也不做
+    ReplayScenario past(trace, ReplayConfig{.speed = 0, .first = 100});
+    assert(past.run(orch).is_ok());
+    assert(past.stats().emitted == 0);
+
+    std::filesystem::remove(path);
+}
+
+void test_speed()
+{
+    auto path = temp_path("replay_speed");
+    auto trace = make_trace(path, 11, 20 * MS); // 记录跨越 200ms
+
+    // 1x 至少等满记录的时长，4x 约为四分之一，不等待时远小于二者
+    auto normal = replay_ms(trace, 1.0);
+    auto fast = replay_ms(trace, 4.0);
+    auto max = replay_ms(trace, 0);
+    assert(normal >= 200);
+    assert(fast >= 50 && fast < normal);
+    assert(max < 50);
+
+    std::filesystem::remove(path);
+}
+
+void test_stop()
+{
+    auto path = temp_path("replay_stop");
+    auto trace = make_trace(path, 3, 10'000 * MS); // 原速回放需要 20s
+
+    Orchestrator orch;
+    auto sc = std::make_unique<ReplayScenario>(trace);
+    auto stopper = sc->stop_source();
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::thread th([&]
+                   { assert(sc->run(orch).is_ok()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    stopper.request_stop();
+    th.join();
+
+    assert(std::chrono::steady_clock::now() - t0 < std::chrono::seconds(2));
+    assert(sc->stats().stopped);
+    assert(sc->stats().emitted == 1);
+
+    // 停止是粘滞的：再次运行立即结束
+    assert(sc->run(orch).is_ok());
+    assert(sc->stats().emitted == 0 && sc->stats().stopped);
+
+    std::filesystem::remove(path);
+}
+
+void test_missing_file()
+{
+    Orchestrator orch;
+    ReplayScenario sc(temp_path("replay_missing"));
+    assert(sc.run(orch).is_err());
+}
+
+int main()
+{
+    test_order_and_content();
+    test_keep_original();
+    test_speed();
+    test_stop();
+    test_missing_file();
+    return 0;
+}
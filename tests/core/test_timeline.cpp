@@ -1,7 +1,11 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <random>
 #include <thread>
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include "eunet/core/timeline.hpp"
 
@@ -188,8 +192,257 @@ void test_timeline()
     }
 }
 
+static EventRecord rec_at(std::int64_t ts, int fd)
+{
+    auto r = make_record(EventType::HTTP_RECEIVED, MessageId::ReceivedBytes, fd);
+    r.ts_ns = ts;
+    r.args[0] = static_cast<std::uint64_t>(ts);
+    return r;
+}
+
+void test_snapshot()
+{
+    Timeline tl;
+    constexpr std::int64_t N = Timeline::SEGMENT_CAPACITY * 2 + 100;
+
+    for (std::int64_t i = 0; i < N; ++i)
+        (void)tl.push(rec_at(i * 10, static_cast<int>(i % 3)));
+
+    // 1. 快照跨越多个段，内容与时间线一致
+    auto snap = tl.snapshot();
+    assert(snap.size() == static_cast<std::size_t>(N));
+    assert(snap.segment_count() >= 3);
+    assert(snap.event_at(Timeline::SEGMENT_CAPACITY).unwrap().mono_ns ==
+           static_cast<std::int64_t>(Timeline::SEGMENT_CAPACITY) * 10);
+    assert(tl.query_by_fd(1).size() == snap.query_by_fd(1).size());
+
+    // 2. 内容不变时重复取快照得到同一版本
+    assert(tl.snapshot().segment_count() == snap.segment_count());
+
+    // 3. 之后的写入、归并与删除都不影响已取得的快照
+    (void)tl.push(rec_at(N * 10, 7));
+
+    std::vector<EventRecord> late = {rec_at(15, 8), rec_at(Timeline::SEGMENT_CAPACITY * 10 + 5, 8)};
+    RecordArena arena;
+    std::vector<RecordRef> refs;
+    for (auto &r : late)
+        refs.push_back({&r, &arena});
+    (void)tl.push_sorted(refs);
+
+    assert(tl.remove_by_fd(0) > 0);
+
+    assert(snap.size() == static_cast<std::size_t>(N));
+    assert(snap.query_by_fd(0).size() == static_cast<std::size_t>((N + 2) / 3));
+    assert(snap.query_by_fd(8).empty());
+
+    // 4. 新快照按时间有序，索引随重写更新
+    auto now_snap = tl.snapshot();
+    assert(now_snap.size() == tl.size());
+    auto all = now_snap.replay_all();
+    for (std::size_t i = 1; i < all.size(); ++i)
+        assert(all[i - 1].mono_ns <= all[i].mono_ns);
+
+    auto fd8 = tl.query_by_fd(8);
+    assert(fd8.size() == 2 && fd8[0].mono_ns == 15);
+    assert(tl.count_by_fd(0) == 0);
+    assert(tl.latest_by_fd(7).unwrap().mono_ns == N * 10);
+}
+
+void test_snapshot_concurrent_reader()
+{
+    Timeline tl;
+    std::atomic<bool> done{false};
+
+    // 读者持续做全量扫描，写入方同时追加
+    std::thread reader([&]
+                       {
+        std::size_t last = 0;
+        while (!done.load())
+        {
+            auto snap = tl.snapshot();
+            assert(snap.size() >= last);
+            last = snap.size();
+
+            std::int64_t prev = -1;
+            snap.for_each([&](const EventRecord &r, const RecordArena &)
+                          {
+                assert(r.ts_ns > prev);
+                prev = r.ts_ns; });
+        } });
+
+    for (std::int64_t i = 0; i < 20000; ++i)
+        (void)tl.push(rec_at(i, 1));
+    done = true;
+    reader.join();
+
+    assert(tl.snapshot().size() == 20000);
+}
+
+static EventRecord session_rec(std::int64_t ts, EventType type, int fd, SessionId sid)
+{
+    auto r = make_record(type, MessageId::Text, fd, sid);
+    r.ts_ns = ts;
+    return r;
+}
+
+void test_session_index()
+{
+    Timeline tl;
+
+    // 会话 1 与会话 2 先后复用 fd 5；DNS / 连接开始阶段 fd 为 -1
+    (void)tl.push(session_rec(10, EventType::DNS_RESOLVE_START, -1, 1));
+    (void)tl.push(session_rec(20, EventType::TCP_CONNECT_START, -1, 1));
+    (void)tl.push(session_rec(30, EventType::HTTP_SENT, 5, 1));
+    (void)tl.push(session_rec(40, EventType::CONNECTION_CLOSED, 5, 1));
+    (void)tl.push(session_rec(50, EventType::DNS_RESOLVE_START, -1, 2));
+    (void)tl.push(session_rec(60, EventType::HTTP_SENT, 5, 2));
+    (void)tl.push(session_rec(70, EventType::CONNECTION_IDLE, -1, 0));
+
+    assert(tl.count_by_session(1) == 4);
+    assert(tl.count_by_session(2) == 2);
+    assert(tl.count_by_session(0) == 0);
+    assert(tl.count_by_fd(5) == 3);
+
+    auto s1 = tl.query_by_session(1);
+    assert(s1.size() == 4);
+    assert(s1.front().type == EventType::DNS_RESOLVE_START && s1.back().mono_ns == 40);
+
+    // 迟到的记录归并进历史中间，会话链随重写保持有序
+    std::vector<EventRecord> late = {session_rec(35, EventType::HTTP_RECEIVED, 5, 1),
+                                     session_rec(55, EventType::TCP_CONNECT_START, -1, 2)};
+    RecordArena arena;
+    std::vector<RecordRef> refs;
+    for (auto &r : late)
+        refs.push_back({&r, &arena});
+    (void)tl.push_sorted(refs);
+
+    s1 = tl.query_by_session(1);
+    assert(s1.size() == 5 && s1[3].mono_ns == 35 && s1[4].mono_ns == 40);
+    auto s2 = tl.query_by_session(2);
+    assert(s2.size() == 3 && s2[1].mono_ns == 55);
+
+    // 删除会话 1 不影响复用同一 fd 的会话 2
+    assert(tl.remove_by_session(1) == 5);
+    assert(tl.count_by_session(1) == 0);
+    assert(tl.query_by_session(1).empty());
+    assert(tl.count_by_fd(5) == 1);
+    assert(tl.query_by_session(2).size() == 3);
+    assert(tl.size() == 4);
+    assert(tl.remove_by_session(1) == 0);
+
+    // 会话链跨越多个段
+    Timeline big;
+    constexpr std::int64_t N = Timeline::SEGMENT_CAPACITY * 3;
+    for (std::int64_t i = 0; i < N; ++i)
+        (void)big.push(session_rec(i, EventType::HTTP_RECEIVED, 3, static_cast<SessionId>(i % 4 + 1)));
+
+    auto s3 = big.query_by_session(3);
+    assert(s3.size() == static_cast<std::size_t>(N / 4));
+    for (std::size_t i = 0; i < s3.size(); ++i)
+        assert(s3[i].mono_ns == static_cast<std::int64_t>(i * 4 + 2));
+
+    assert(big.remove_by_session(4) == static_cast<std::size_t>(N / 4));
+    assert(big.count_by_session(3) == static_cast<std::size_t>(N / 4));
+    assert(big.query_by_session(3).back().mono_ns == N - 2);
+}
+
+// 暴力扫描作为多条件查询的对照
+static std::size_t brute_count(const std::vector<EventRecord> &recs, const TimelineQuery &q)
+{
+    auto lo = q.start ? platform::time::event_from_wall(*q.start) : INT64_MIN;
+    auto hi = q.end ? platform::time::event_from_wall(*q.end) : INT64_MAX;
+
+    std::size_t n = 0;
+    for (const auto &r : recs)
+    {
+        if (q.fd && r.fd != *q.fd)
+            continue;
+        if (!q.types.empty() && std::find(q.types.begin(), q.types.end(), r.type) == q.types.end())
+            continue;
+        if (q.session && r.session != *q.session)
+            continue;
+        if (q.errors_only && !r.is_error())
+            continue;
+        if (r.ts_ns < lo || r.ts_ns > hi)
+            continue;
+        ++n;
+    }
+    return n;
+}
+
+void test_multi_predicate_query()
+{
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> fd_dist(3, 10);
+    std::uniform_int_distribution<int> type_dist(0, 5);
+    std::uniform_int_distribution<int> sid_dist(1, 50);
+    std::bernoulli_distribution err_dist(0.1);
+
+    const EventType types[] = {EventType::DNS_RESOLVE_START, EventType::TCP_CONNECT_START,
+                               EventType::TCP_CONNECT_SUCCESS, EventType::HTTP_SENT,
+                               EventType::HTTP_RECEIVED, EventType::CONNECTION_CLOSED};
+    auto err = util::Error::transport().timeout().message("timeout").build();
+
+    for (bool shuffled : {false, true})
+    {
+        Timeline tl;
+        std::vector<EventRecord> recs;
+
+        constexpr int N = 20000;
+        for (int i = 0; i < N; ++i)
+        {
+            auto r = make_record(types[type_dist(rng)], MessageId::Text, fd_dist(rng), sid_dist(rng));
+            r.ts_ns = shuffled ? static_cast<std::int64_t>(rng() % N) * 100 : i * 100;
+            RecordExtras ex;
+            if (err_dist(rng))
+                ex.error = &err;
+            auto stored = r;
+            if (ex.error)
+                stored.error = 1;
+            recs.push_back(stored);
+            (void)tl.push(r, ex);
+        }
+
+        auto wall = [](std::int64_t ns)
+        { return platform::time::event_to_wall(ns); };
+
+        std::vector<TimelineQuery> queries = {
+            {.fd = 7, .types = {EventType::TCP_CONNECT_START, EventType::TCP_CONNECT_SUCCESS}, .errors_only = true},
+            {.fd = 7, .types = {EventType::TCP_CONNECT_START, EventType::TCP_CONNECT_SUCCESS}, .errors_only = true, .start = wall(200000), .end = wall(900000)},
+            {.types = {EventType::HTTP_SENT}, .session = 9},
+            {.fd = 4, .start = wall(100000), .end = wall(150000)},
+            {.start = wall(500), .end = wall(1000)},
+            {.errors_only = true},
+            {.fd = 99},
+            {},
+        };
+
+        for (const auto &q : queries)
+        {
+            auto want = brute_count(recs, q);
+            assert(tl.count_matching(q) == want);
+
+            auto got = tl.query(q);
+            assert(got.size() == want);
+            for (const auto &e : got)
+            {
+                if (q.fd)
+                    assert(e.fd.fd == *q.fd);
+                if (q.errors_only)
+                    assert(e.error);
+            }
+        }
+
+        assert(tl.query_errors().size() == brute_count(recs, {.errors_only = true}));
+    }
+}
+
 int main()
 {
     test_timeline();
+    test_snapshot();
+    test_snapshot_concurrent_reader();
+    test_session_index();
+    test_multi_predicate_query();
     return 0;
 }
@@ -0,0 +1,268 @@
+#include <cassert>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "eunet/core/timeline.hpp"
+#include "eunet/core/trace_file.hpp"
+
+using namespace core;
+
+static std::string temp_dir(const char *name)
+{
+    auto dir = std::filesystem::temp_directory_path() /
+               (std::string("eunet_") + name + "_" + std::to_string(::getpid()));
+    std::filesystem::create_directories(dir);
+    return dir.string();
+}
+
+static std::vector<std::byte> bytes_of(const std::string &s)
+{
+    std::vector<std::byte> out;
+    for (char c : s)
+        out.push_back(static_cast<std::byte>(c));
+    return out;
+}
+
+static void assert_same(const Event &a, const Event &b)
+{
+    assert(a.type == b.type);
+    assert(a.fd.fd == b.fd.fd);
+    assert(a.session_id == b.session_id);
+    assert(a.msg == b.msg);
+    assert(a.mono_ns == b.mono_ns);
+    assert(a.payload == b.payload);
+    assert(a.is_error() == b.is_error());
+    if (a.error)
+        assert(a.error->message() == b.error->message());
+    assert(a.tcp_info.has_value() == b.tcp_info.has_value());
+    if (a.tcp_info)
+        assert(a.tcp_info->rtt_us == b.tcp_info->rtt_us);
+}
+
+static void same_list(const std::vector<Event> &a, const std::vector<Event> &b)
+{
+    assert(a.size() == b.size());
+    for (std::size_t i = 0; i < a.size(); ++i)
+        assert_same(a[i], b[i]);
+}
+
+// 同样的内容写入两个时间线，只有其中一个开启落盘
+static void fill(Timeline &tl, std::int64_t base, int n)
+{
+    auto err = util::Error::transport().timeout().message("timeout").build();
+    platform::net::TcpInfo info{};
+
+    for (int i = 0; i < n; ++i)
+    {
+        auto type = i % 4 == 0 ? EventType::HTTP_RECEIVED : i % 4 == 1 ? EventType::TCP_INFO_SAMPLE
+                                                                       : EventType::HTTP_SENT;
+        auto rec = make_record(type, MessageId::Text, i % 5, static_cast<SessionId>(i / 8 + 1));
+        rec.ts_ns = base + std::int64_t{i} * 1000;
+
+        auto text = "GET /item/" + std::to_string(i % 50);
+        auto payload = bytes_of(std::string(200, 'p') + std::to_string(i));
+        info.rtt_us = static_cast<std::uint32_t>(i);
+
+        RecordExtras extras{.text = text};
+        if (type == EventType::HTTP_RECEIVED)
+            extras.payload = payload;
+        if (type == EventType::TCP_INFO_SAMPLE)
+            extras.tcp_info = &info;
+        if (i % 101 == 100)
+            extras.error = &err;
+        (void)tl.push(rec, extras);
+    }
+}
+
+static platform::time::WallPoint wall_of(std::int64_t event_ns)
+{
+    return platform::time::process_anchor().to_wall(event_ns);
+}
+
+void test_spill_and_query()
+{
+    auto dir = temp_dir("spill");
+    constexpr int N = 60000;
+    auto base = platform::time::event_now();
+
+    Timeline ref;
+    fill(ref, base, N);
+
+    Timeline tl;
+    assert(tl.enable_spill({.dir = dir, .memory_budget = 2 * 1024 * 1024}).is_ok());
+    auto before = tl.snapshot();
+    fill(tl, base, N);
+    auto early = tl.snapshot();
+    tl.flush_spill();
+
+    // 1. 旧段已落盘，内存回到预算附近，文件创建后即删除，目录中不残留
+    assert(tl.size() == ref.size());
+    assert(tl.cold_size() > N / 2);
+    assert(tl.disk_bytes() > 0);
+    assert(tl.memory_bytes() * 2 < ref.memory_bytes());
+    assert(!tl.spill_error());
+    assert(std::filesystem::is_empty(dir));
+
+    // 2. 索引查询跨越冷段与内存段，结果与未落盘的时间线一致
+    assert(tl.count_by_fd(3) == ref.count_by_fd(3));
+    assert(tl.count_by_type(EventType::HTTP_RECEIVED) == ref.count_by_type(EventType::HTTP_RECEIVED));
+    assert(tl.count_by_session(9) == ref.count_by_session(9));
+    same_list(tl.query_by_fd(3), ref.query_by_fd(3));
+    same_list(tl.query_by_type(EventType::TCP_INFO_SAMPLE), ref.query_by_type(EventType::TCP_INFO_SAMPLE));
+    same_list(tl.query_by_session(9), ref.query_by_session(9));
+    same_list(tl.query_errors(), ref.query_errors());
+    same_list(tl.replay_all(), ref.replay_all());
+
+    auto start = wall_of(base + 10'000'000);
+    auto end = wall_of(base + 50'000'000);
+    assert(tl.count_by_time(start, end) == ref.count_by_time(start, end));
+    same_list(tl.query_by_time(start, end), ref.query_by_time(start, end));
+    same_list(tl.replay_since(end), ref.replay_since(end));
+
+    TimelineQuery q;
+    q.fd = 2;
+    q.types = {EventType::HTTP_RECEIVED, EventType::HTTP_SENT};
+    q.start = start;
+    q.end = end;
+    same_list(tl.query(q), ref.query(q));
+    assert(tl.count_matching(q) == ref.count_matching(q));
+
+    for (std::size_t i : {std::size_t{0}, std::size_t{4097}, std::size_t{N / 2}, std::size_t{N - 1}})
+        assert_same(tl.event_at(i).unwrap(), ref.event_at(i).unwrap());
+    assert(!tl.event_at(1, false).unwrap().payload);
+    assert_same(tl.latest_by_fd(0).unwrap(), ref.latest_by_fd(0).unwrap());
+
+    // 3. 落盘前取得的快照不受影响，新快照同样覆盖冷段
+    assert(before.empty());
+    assert(early.size() == ref.size());
+    same_list(early.query_by_fd(1), ref.query_by_fd(1));
+
+    auto snap = tl.snapshot();
+    assert(snap.cold_size() == tl.cold_size());
+    same_list(snap.query_by_type(EventType::HTTP_RECEIVED), ref.query_by_type(EventType::HTTP_RECEIVED));
+    same_list(snap.query_by_time(start, end), ref.query_by_time(start, end));
+    same_list(snap.materialize({0, 5, 4096, 4095, N - 1}), ref.snapshot().materialize({0, 5, 4096, 4095, N - 1}));
+    assert(snap.count_by_time(start, end) == ref.count_by_time(start, end));
+
+    // 4. 快照写入追踪文件时冷段逐段解压
+    auto path = dir + "/spill.trace";
+    auto w = TraceWriter::create(path).unwrap();
+    assert(w.append(snap).unwrap() == static_cast<std::size_t>(N));
+    auto file = TraceFile::open(path).unwrap();
+    assert(file.count_by_fd(3) == ref.count_by_fd(3));
+    std::filesystem::remove_all(dir);
+}
+
+void test_rewrite_cold_history()
+{
+    auto dir = temp_dir("spill_rewrite");
+    constexpr int N = 30000;
+    auto base = platform::time::event_now();
+
+    constexpr std::size_t BUDGET = 1024 * 1024;
+
+    Timeline ref, tl;
+    fill(ref, base, N);
+    assert(tl.enable_spill({.dir = dir, .memory_budget = BUDGET}).is_ok());
+    fill(tl, base, N);
+    tl.flush_spill();
+    assert(tl.cold_size() > 0);
+    assert(tl.memory_bytes() <= BUDGET);
+
+    // 早于冷段的批次与冷段归并后重新落盘，不解压回内存
+    std::vector<EventRecord> late = {make_record(EventType::DNS_RESOLVE_START, MessageId::Text, 9),
+                                     make_record(EventType::DNS_RESOLVE_DONE, MessageId::Text, 9)};
+    late[0].ts_ns = base + 500;
+    late[1].ts_ns = base + 20'000'500;
+    RecordArena arena;
+    std::vector<RecordRef> refs;
+    for (auto &r : late)
+        refs.push_back({&r, &arena});
+    assert(tl.push_sorted(refs).is_ok());
+    assert(ref.push_sorted(refs).is_ok());
+    same_list(tl.query_by_fd(9), ref.query_by_fd(9));
+    assert(tl.event_at(1).unwrap().fd.fd == 9);
+    assert(tl.cold_size() > N / 2);
+    assert(tl.memory_bytes() <= BUDGET);
+
+    // 删除跨越冷段：命中的冷段重新编码落盘，其余冷段原样保留，内存不超出预算
+    assert(tl.remove_by_fd(4) == ref.remove_by_fd(4));
+    assert(tl.remove_by_type(EventType::TCP_INFO_SAMPLE) == ref.remove_by_type(EventType::TCP_INFO_SAMPLE));
+    assert(tl.memory_bytes() <= BUDGET);
+    fill(tl, base + N * 1000, N);
+    fill(ref, base + N * 1000, N);
+    tl.flush_spill();
+    assert(tl.cold_size() > 0);
+    assert(tl.remove_by_time(wall_of(base + 25'000'000), wall_of(base + 26'000'000)) ==
+           ref.remove_by_time(wall_of(base + 25'000'000), wall_of(base + 26'000'000)));
+    assert(tl.cold_size() > N / 2);
+    assert(tl.memory_bytes() <= BUDGET);
+    assert(!tl.spill_error());
+    same_list(tl.replay_all(), ref.replay_all());
+    assert(tl.count_by_fd(4) == ref.count_by_fd(4));
+    assert(tl.count_by_session(9) == ref.count_by_session(9));
+    same_list(tl.query_by_session(9), ref.query_by_session(9));
+    same_list(tl.query_by_type(EventType::HTTP_RECEIVED), ref.query_by_type(EventType::HTTP_RECEIVED));
+    same_list(tl.query_errors(), ref.query_errors());
+
+    tl.clear();
+    assert(tl.size() == 0 && tl.cold_size() == 0 && tl.disk_bytes() == 0);
+    std::filesystem::remove_all(dir);
+}
+
+void test_sort_cold_history()
+{
+    auto dir = temp_dir("spill_sort");
+    constexpr int N = 30000;
+    constexpr std::size_t BUDGET = 1024 * 1024;
+    auto base = platform::time::event_now();
+
+    // 每 1000 条倒序写入一批，整体无序，落盘的段内同样无序
+    Timeline ref, tl;
+    assert(tl.enable_spill({.dir = dir, .memory_budget = BUDGET}).is_ok());
+    for (int batch = 0; batch < N / 1000; ++batch)
+        for (Timeline *t : {&ref, &tl})
+            fill(*t, base + std::int64_t{N - batch * 1000} * 1000, 1000);
+    tl.flush_spill();
+    assert(tl.cold_size() > N / 2);
+
+    // 逐段排序后归并写回，冷段仍在磁盘上
+    assert(tl.sort_by_time().unwrap() == static_cast<std::size_t>(N));
+    assert(ref.sort_by_time().unwrap() == static_cast<std::size_t>(N));
+    assert(tl.cold_size() > N / 2);
+    assert(tl.memory_bytes() <= BUDGET);
+    assert(!tl.spill_error());
+
+    same_list(tl.replay_all(), ref.replay_all());
+    same_list(tl.query_by_fd(2), ref.query_by_fd(2));
+    same_list(tl.query_by_session(3), ref.query_by_session(3));
+    auto start = wall_of(base + 5'000'000);
+    auto end = wall_of(base + 9'000'000);
+    same_list(tl.query_by_time(start, end), ref.query_by_time(start, end));
+    std::filesystem::remove_all(dir);
+}
+
+void test_invalid_options()
+{
+    Timeline tl;
+    assert(tl.enable_spill({.dir = "/nonexistent/eunet", .memory_budget = 1024}).is_err());
+    assert(tl.enable_spill({.dir = "/tmp", .memory_budget = 0}).is_err());
+
+    // 未开启落盘时全部留在内存中
+    fill(tl, platform::time::event_now(), 10000);
+    assert(tl.cold_size() == 0);
+    tl.flush_spill();
+}
+
+int main()
+{
+    test_spill_and_query();
+    test_rewrite_cold_history();
+    test_sort_cold_history();
+    test_invalid_options();
+    return 0;
+}
@@ -0,0 +1,289 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "eunet/core/timeline.hpp"
+#include "eunet/core/trace_file.hpp"
+#include "eunet/core/sink/trace_sink.hpp"
+
+using namespace core;
+
+static std::string temp_path(const char *name)
+{
+    auto dir = std::filesystem::temp_directory_path();
+    return (dir / (std::string("eunet_") + name + "_" + std::to_string(::getpid()) + ".trace")).string();
+}
+
+static std::vector<std::byte> bytes_of(const std::string &s)
+{
+    std::vector<std::byte> out;
+    for (char c : s)
+        out.push_back(static_cast<std::byte>(c));
+    return out;
+}
+
+static void assert_same(const Event &a, const Event &b)
+{
+    assert(a.type == b.type);
+    assert(a.fd.fd == b.fd.fd);
+    assert(a.session_id == b.session_id);
+    assert(a.msg == b.msg);
+    assert(a.ts == b.ts);
+    assert(a.payload == b.payload);
+    assert(a.is_error() == b.is_error());
+    if (a.error)
+    {
+        assert(a.error->category() == b.error->category());
+        assert(a.error->message() == b.error->message());
+    }
+}
+
+// 构造覆盖各类变长数据的时间线：文本、载荷、空载荷、带原因的错误、TCP_INFO
+static void fill(Timeline &tl, int n)
+{
+    const EventType types[] = {
+        EventType::DNS_RESOLVE_START,
+        EventType::TCP_CONNECT_START,
+        EventType::HTTP_SENT,
+        EventType::HTTP_RECEIVED,
+    };
+
+    for (int i = 0; i < n; ++i)
+    {
+        auto rec = make_record(types[i % 4], MessageId::Text, i % 7, static_cast<SessionId>(i % 5));
+        rec.ts_ns += i * 1000;
+
+        auto text = "event " + std::to_string(i);
+        auto payload = bytes_of("payload-" + std::to_string(i));
+        auto cause = util::Error::system().code(i).connection_refused().message("refused").context("connect").build();
+        auto err = util::Error::transport().timeout().message("wrapped").wrap(cause).build();
+        platform::net::TcpInfo info{};
+        info.rtt_us = static_cast<uint32_t>(i);
+
+        RecordExtras extras{.text = text};
+        if (i % 3 == 0)
+            extras.payload = payload;
+        if (i % 10 == 9)
+            extras.error = &err;
+        if (i % 11 == 0)
+            extras.tcp_info = &info;
+        (void)tl.push(rec, extras);
+    }
+}
+
+void test_arena_image()
+{
+    RecordArena arena;
+    auto cause = util::Error::system().code(111).connection_refused().message("refused").context("connect").build();
+    auto err = util::Error::transport().timeout().transient().message("outer").wrap(cause).build();
+    platform::net::TcpInfo info{};
+    info.rtt_us = 1234;
+    info.snd_cwnd = 10;
+
+    auto payload = bytes_of("GET / HTTP/1.1");
+    EventRecord rec = make_record(EventType::HTTP_RECEIVED, MessageId::HttpGet, 5, 9);
+    arena.attach(rec, {.text = "http://example.com/", .payload = payload, .error = &err, .tcp_info = &info});
+
+    std::vector<std::byte> buf;
+    arena.write_image(buf);
+    assert(buf.size() % 8 == 0);
+
+    auto view = ArenaImage::view(buf);
+    assert(view.is_ok());
+    const auto &img = view.unwrap();
+    assert(img.image_bytes() == buf.size());
+
+    assert(img.text(rec.text) == "http://example.com/");
+    assert(img.text(0).empty());
+    assert(img.text(99).empty());
+    assert(img.payload(rec.payload).size() == payload.size());
+    assert(img.tcp_info(rec.tcp_info)->rtt_us == 1234);
+    assert(img.tcp_info(2) == nullptr);
+
+    auto decoded = img.error(rec.error);
+    assert(decoded);
+    assert(decoded->category() == util::ErrorCategory::Timeout);
+    assert(decoded->severity() == util::ErrorSeverity::Transient);
+    assert(decoded->message() == "outer");
+    assert(decoded->cause());
+    assert(decoded->cause()->code() == 111);
+    assert(decoded->cause()->context() == "connect");
+    assert(decoded->root_category() == util::ErrorCategory::Timeout);
+
+    assert_same(materialize(rec, arena), materialize(rec, img));
+    assert(render_message(rec, arena) == render_message(rec, img));
+
+    // 长度不足的映像被拒绝
+    auto truncated = ArenaImage::view(std::span<const std::byte>(buf).first(buf.size() / 2));
+    assert(truncated.is_err());
+}
+
+void test_write_and_open()
+{
+    auto path = temp_path("roundtrip");
+
+    Timeline tl;
+    fill(tl, 10'000);
+
+    auto writer = TraceWriter::create(path);
+    assert(writer.is_ok());
+    auto w = std::move(writer).unwrap();
+    auto r = w.append(tl.snapshot());
+    assert(r.is_ok() && r.unwrap() == tl.size());
+    assert(w.chunk_count() == (tl.size() + TraceWriter::CHUNK_CAPACITY - 1) / TraceWriter::CHUNK_CAPACITY);
+
+    auto opened = TraceFile::open(path);
+    assert(opened.is_ok());
+    const auto &trace = opened.unwrap();
+    assert(!trace.recovered());
+    assert(trace.ordered());
+    assert(trace.size() == tl.size());
+    assert(trace.chunk_count() == w.chunk_count());
+
+    // 同一进程内写入与读取，时间戳换算后与 Timeline 一致
+    auto expect = tl.replay_all();
+    auto got = trace.replay_all();
+    assert(got.size() == expect.size());
+    for (std::size_t i = 0; i < got.size(); ++i)
+        assert_same(got[i], expect[i]);
+
+    auto same_list = [](const std::vector<Event> &a, const std::vector<Event> &b)
+    {
+        assert(a.size() == b.size());
+        for (std::size_t i = 0; i < a.size(); ++i)
+            assert_same(a[i], b[i]);
+    };
+
+    same_list(trace.query_by_fd(3), tl.query_by_fd(3));
+    same_list(trace.query_by_type(EventType::HTTP_RECEIVED), tl.query_by_type(EventType::HTTP_RECEIVED));
+    same_list(trace.query_by_session(2), tl.query_by_session(2));
+    same_list(trace.query_errors(), tl.query_errors());
+    assert(trace.count_by_fd(3) == tl.count_by_fd(3));
+    assert(trace.count_by_session(4) == tl.count_by_session(4));
+
+    auto start = expect[1234].ts;
+    auto end = expect[8765].ts;
+    same_list(trace.query_by_time(start, end), tl.query_by_time(start, end));
+    assert(trace.count_by_time(start, end) == tl.count_by_time(start, end));
+    assert(trace.count_by_time(end, start) == 0);
+
+    TimelineQuery q;
+    q.fd = 2;
+    q.types = {EventType::HTTP_RECEIVED, EventType::HTTP_SENT};
+    q.start = start;
+    q.end = end;
+    same_list(trace.query(q), tl.query(q));
+    assert(trace.count_matching(q) == tl.count_matching(q));
+    assert(trace.materialize(trace.select(q)).size() == trace.count_matching(q));
+
+    auto lean = trace.event_at(3, false);
+    assert(lean.is_ok() && !lean.unwrap().payload);
+    assert(trace.event_at(trace.size()).is_err());
+    assert(trace.latest_event().unwrap().msg == expect.back().msg);
+
+    std::filesystem::remove(path);
+}
+
+void test_append_and_recover()
+{
+    auto path = temp_path("append");
+
+    Timeline tl;
+    fill(tl, 3000);
+    auto snap = tl.snapshot();
+
+    auto w = TraceWriter::create(path).unwrap();
+
+    // 创建后即可打开
+    {
+        auto empty = TraceFile::open(path);
+        assert(empty.is_ok() && empty.unwrap().empty());
+    }
+
+    assert(w.append(snap, 0).unwrap() == 3000);
+    {
+        auto first = TraceFile::open(path);
+        assert(first.is_ok() && first.unwrap().size() == 3000);
+    }
+
+    // 从下标 1000 起再追加一次：与已有内容时间上重叠，文件不再整体有序
+    assert(w.append(snap, 1000).unwrap() == 2000);
+    {
+        auto second = TraceFile::open(path);
+        assert(second.is_ok());
+        const auto &trace = second.unwrap();
+        assert(trace.size() == 5000);
+        assert(!trace.ordered());
+        assert(trace.event_at(3000).unwrap().msg == "event 1000");
+        assert(trace.query_by_session(1).size() == 600 + 400);
+    }
+
+    // 截去尾部：按块头扫描恢复全部完整的块
+    auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 3);
+    {
+        auto recovered = TraceFile::open(path);
+        assert(recovered.is_ok());
+        const auto &trace = recovered.unwrap();
+        assert(trace.recovered());
+        assert(trace.size() == 5000);
+        assert(trace.event_at(4999).unwrap().msg == "event 2999");
+    }
+
+    // 文件头损坏则拒绝打开
+    {
+        std::FILE *f = std::fopen(path.c_str(), "r+b");
+        std::fputc('X', f);
+        std::fclose(f);
+        assert(TraceFile::open(path).is_err());
+    }
+
+    assert(TraceFile::open(temp_path("missing")).is_err());
+    std::filesystem::remove(path);
+}
+
+void test_trace_sink()
+{
+    auto path = temp_path("sink");
+
+    {
+        auto sink = std::make_shared<sink::TraceSink>(TraceWriter::create(path).unwrap(), 4);
+        for (int i = 0; i < 10; ++i)
+        {
+            Event e = Event::info(EventType::HTTP_SENT, "sent " + std::to_string(i), {i});
+            e.session_id = 7;
+            sink->on_event(EventSnapshot{e, i, LifeState::Init});
+
+            // 每攒满 4 条写出一块，写出后立即可读
+            if (i == 3)
+                assert(TraceFile::open(path).unwrap().size() == 4);
+        }
+        assert(sink->written() == 8);
+        assert(sink->flush() == 10);
+        assert(!sink->last_error());
+    }
+
+    auto trace = TraceFile::open(path).unwrap();
+    assert(trace.size() == 10);
+    assert(trace.chunk_count() == 3);
+    auto events = trace.query_by_session(7);
+    assert(events.size() == 10);
+    assert(events[9].msg == "sent 9");
+    assert(events[9].fd.fd == 9);
+
+    std::filesystem::remove(path);
+}
+
+int main()
+{
+    test_arena_image();
+    test_write_and_open();
+    test_append_and_recover();
+    test_trace_sink();
+    return 0;
+}
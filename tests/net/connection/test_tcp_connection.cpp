@@ -3,6 +3,8 @@
 #include <vector>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include "eunet/util/task.hpp"
+#include "eunet/platform/event_loop.hpp"
 #include "eunet/platform/socket/tcp_socket.hpp"
 #include "eunet/net/connection/tcp_connection.hpp"
 
@@ -82,8 +84,115 @@ void test_tcp_connection()
     std::cout << "TCPConnection test passed.\n";
 }
 
+void test_tcp_connection_async()
+{
+    using namespace net::tcp;
+    using namespace platform::net;
+
+    // ---------- echo server ----------
+    int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    assert(listen_fd >= 0);
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+
+    assert(::bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) == 0);
+    assert(::listen(listen_fd, 4) == 0);
+
+    socklen_t len = sizeof(addr);
+    assert(::getsockname(listen_fd, (sockaddr *)&addr, &len) == 0);
+    uint16_t port = ntohs(addr.sin_port);
+
+    // 第一个连接回显 第二个连接保持沉默以触发读超时
+    std::thread server(
+        [listen_fd]()
+        {
+            int echo_fd = ::accept(listen_fd, nullptr, nullptr);
+            assert(echo_fd >= 0);
+
+            char buf[64];
+            ssize_t n = ::recv(echo_fd, buf, sizeof(buf), 0);
+            assert(n == 3);
+            assert(::send(echo_fd, buf, n, 0) == n);
+
+            int silent_fd = ::accept(listen_fd, nullptr, nullptr);
+            assert(silent_fd >= 0);
+            (void)::recv(silent_fd, buf, sizeof(buf), 0); // 等待客户端关闭
+
+            ::close(echo_fd);
+            ::close(silent_fd);
+        });
+
+    // ---------- client coroutine ----------
+    auto loop = std::move(platform::reactor::EventLoop::create().unwrap());
+    auto ep = Endpoint::from_ipv4(htonl(INADDR_LOOPBACK), port);
+    const auto base = loop->poller().size();
+
+    bool echoed = false;
+    bool timed_out = false;
+    bool finished = false;
+
+    auto session = [&]() -> util::Task<void>
+    {
+        auto conn_res = co_await TCPConnection::async_connect(ep, *loop, 500);
+        assert(conn_res.is_ok());
+        auto conn = std::move(conn_res.unwrap());
+
+        util::ByteBuffer out;
+        out.append(std::vector<std::byte>{std::byte{1}, std::byte{2}, std::byte{3}});
+
+        auto wr = co_await conn.async_write(out, *loop, 500);
+        assert(wr.is_ok() && wr.unwrap() == 3);
+        assert(out.empty());
+
+        util::ByteBuffer in(64);
+        auto rd = co_await conn.async_read(in, *loop, 500);
+        assert(rd.is_ok() && rd.unwrap() == 3);
+
+        // 多次等待共用建连时的同一注册
+        assert(loop->poller().size() == base + 1);
+        auto bytes = in.readable();
+        echoed = bytes[0] == std::byte{1} && bytes[2] == std::byte{3};
+
+        // 对端不回包 读取应在超时后返回 Timeout
+        auto silent_res = co_await TCPConnection::async_connect(ep, *loop, 500);
+        assert(silent_res.is_ok());
+        auto silent = std::move(silent_res.unwrap());
+
+        util::ByteBuffer none(16);
+        auto to = co_await silent.async_read(none, *loop, 50);
+        timed_out = to.is_err() &&
+                    to.unwrap_err().category() == util::ErrorCategory::Timeout;
+
+        silent.close();
+        conn.close();
+    };
+
+    util::spawn(session(), [&]
+                { finished = true; });
+
+    for (int i = 0; i < 200 && !finished; ++i)
+        assert(loop->run_once(100).is_ok());
+
+    assert(finished);
+    assert(echoed);
+    assert(timed_out);
+
+    // 所有等待结束后 reactor 上不应残留关注与定时器
+    assert(loop->timers().size() == 0);
+    assert(loop->poller().size() == base);
+
+    server.join();
+    ::close(listen_fd);
+
+    std::cout << "TCPConnection async test passed.\n";
+}
+
 int main()
 {
     test_tcp_connection();
+    test_tcp_connection_async();
     return 0;
 }
\ No newline at end of file
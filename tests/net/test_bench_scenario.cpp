@@ -0,0 +1,169 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "eunet/core/orchestrator.hpp"
+#include "eunet/net/bench_scenario.hpp"
+
+using namespace net::http;
+
+static const char RESPONSE[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Length: 5\r\n"
+    "\r\n"
+    "hello";
+
+// keep-alive 服务端：每条连接一个线程，循环读取请求并回复，直到对端关闭
+struct KeepAliveServer
+{
+    int listen_fd = -1;
+    uint16_t port = 0;
+    std::atomic<int> accepted{0};
+    std::thread th;
+    std::mutex mtx;
+    std::vector<std::thread> sessions;
+
+    void start()
+    {
+        listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        assert(listen_fd >= 0);
+
+        int one = 1;
+        ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        assert(::bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) == 0);
+        assert(::listen(listen_fd, 128) == 0);
+
+        socklen_t len = sizeof(addr);
+        assert(::getsockname(listen_fd, (sockaddr *)&addr, &len) == 0);
+        port = ntohs(addr.sin_port);
+
+        th = std::thread([this]
+                         {
+                             for (;;)
+                             {
+                                 int fd = ::accept(listen_fd, nullptr, nullptr);
+                                 if (fd < 0)
+                                     return;
+                                 ++accepted;
+                                 std::lock_guard lock(mtx);
+                                 sessions.emplace_back(serve, fd);
+                             } });
+    }
+
+    static void serve(int fd)
+    {
+        std::string pending;
+        char buf[1024];
+        for (;;)
+        {
+            ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0)
+                break;
+            pending.append(buf, static_cast<size_t>(n));
+
+            size_t pos;
+            while ((pos = pending.find("\r\n\r\n")) != std::string::npos)
+            {
+                pending.erase(0, pos + 4);
+                (void)::send(fd, RESPONSE, sizeof(RESPONSE) - 1, MSG_NOSIGNAL);
+            }
+        }
+        ::close(fd);
+    }
+
+    void stop()
+    {
+        ::shutdown(listen_fd, SHUT_RDWR);
+        th.join();
+        ::close(listen_fd);
+        for (auto &s : sessions)
+            s.join();
+    }
+};
+
+void test_keep_alive_bench()
+{
+    KeepAliveServer server;
+    server.start();
+
+    BenchConfig cfg;
+    cfg.url = "http://127.0.0.1:" + std::to_string(server.port) + "/";
+    cfg.connections = 4;
+    cfg.threads = 2;
+    cfg.duration = std::chrono::milliseconds(500);
+
+    core::Orchestrator orch;
+    BenchScenario sc(cfg);
+    assert(sc.run(orch).is_ok());
+    server.stop();
+
+    const auto &r = sc.report();
+    std::cout << format_report(cfg, r);
+
+    // 每条连接只建连一次，之后全部请求复用
+    assert(r.connects == cfg.connections);
+    assert(server.accepted.load() == static_cast<int>(cfg.connections));
+    assert(r.errors == 0);
+    assert(r.non_2xx == 0);
+    assert(r.requests > cfg.connections * 10);
+    assert(r.latency.total_count() == r.requests);
+    assert(r.bytes == r.requests * (sizeof(RESPONSE) - 1));
+    assert(r.elapsed_s >= 0.5);
+    assert(r.requests_per_sec() > 0);
+
+    std::cout << "BenchScenario keep-alive test passed.\n";
+}
+
+void test_error_breakdown()
+{
+    // 绑定后立即关闭的端口：所有建连都被拒绝
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    assert(::bind(fd, (sockaddr *)&addr, sizeof(addr)) == 0);
+    socklen_t len = sizeof(addr);
+    assert(::getsockname(fd, (sockaddr *)&addr, &len) == 0);
+    uint16_t port = ntohs(addr.sin_port);
+    ::close(fd);
+
+    BenchConfig cfg;
+    cfg.url = "http://127.0.0.1:" + std::to_string(port) + "/";
+    cfg.connections = 2;
+    cfg.threads = 1;
+    cfg.duration = std::chrono::milliseconds(100);
+
+    core::Orchestrator orch;
+    BenchScenario sc(cfg);
+    assert(sc.run(orch).is_ok());
+
+    const auto &r = sc.report();
+    std::cout << format_report(cfg, r);
+
+    assert(r.requests == 0);
+    assert(r.errors > 0);
+    assert(r.errors_by_category.count(util::ErrorCategory::ConnectionRefused) == 1);
+    assert(r.errors_by_category.at(util::ErrorCategory::ConnectionRefused) == r.errors);
+
+    std::cout << "BenchScenario error breakdown test passed.\n";
+}
+
+int main()
+{
+    test_keep_alive_bench();
+    test_error_breakdown();
+    return 0;
+}
@@ -0,0 +1,247 @@
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "eunet/util/task.hpp"
+#include "eunet/platform/event_loop.hpp"
+#include "eunet/core/orchestrator.hpp"
+#include "eunet/net/http_client.hpp"
+#include "eunet/net/http_scenario.hpp"
+
+constexpr int SESSIONS = 200;
+
+static const char RESPONSE[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/plain\r\n"
+    "Content-Length: 5\r\n"
+    "Connection: close\r\n"
+    "\r\n"
+    "hello";
+
+// 逐个处理连接的最简 HTTP 服务端：读完请求头后回固定响应并关闭
+static void serve(int listen_fd, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        assert(fd >= 0);
+
+        std::string req;
+        char buf[1024];
+        while (req.find("\r\n\r\n") == std::string::npos)
+        {
+            ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0)
+                break;
+            req.append(buf, static_cast<size_t>(n));
+        }
+        assert(req.rfind("GET /hello HTTP/1.1\r\n", 0) == 0);
+
+        (void)::send(fd, RESPONSE, sizeof(RESPONSE) - 1, 0);
+        ::close(fd);
+    }
+}
+
+static int make_listener(uint16_t &port)
+{
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    assert(fd >= 0);
+
+    int one = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    assert(::bind(fd, (sockaddr *)&addr, sizeof(addr)) == 0);
+    assert(::listen(fd, SESSIONS + 16) == 0);
+
+    socklen_t len = sizeof(addr);
+    assert(::getsockname(fd, (sockaddr *)&addr, &len) == 0);
+    port = ntohs(addr.sin_port);
+    return fd;
+}
+
+void test_async_get_concurrent()
+{
+    uint16_t port = 0;
+    int listen_fd = make_listener(port);
+    std::thread server(serve, listen_fd, SESSIONS);
+
+    auto loop = std::move(platform::reactor::EventLoop::create().unwrap());
+    core::Orchestrator orch;
+
+    int active = 0;
+    int peak = 0;
+    int ok = 0;
+    int done = 0;
+
+    auto session = [&]() -> util::Task<void>
+    {
+        peak = std::max(peak, ++active);
+
+        net::http::HttpRequest req;
+        req.host = "127.0.0.1";
+        req.port = port;
+        req.target = "/hello";
+        req.timeout_ms = 5000;
+
+        auto res = co_await net::http::HTTPClient::async_get(orch, req, *loop);
+        --active;
+
+        if (res.is_ok() &&
+            res.unwrap().status == 200 &&
+            res.unwrap().body == "hello")
+        {
+            // 各阶段首尾相接，之和不超过总耗时
+            const auto &t = res.unwrap().timings;
+            assert(t.connect.count() > 0);
+            assert(t.dns + t.connect + t.request + t.ttfb + t.body <= t.total);
+            ++ok;
+        }
+    };
+
+    // 全部会话都在同一个 reactor 线程上推进，每个会话只占一个协程帧链
+    for (int i = 0; i < SESSIONS; ++i)
+        util::spawn(session(), [&]
+                    { ++done; });
+
+    for (int i = 0; i < 1000 && done < SESSIONS; ++i)
+        assert(loop->run_once(100).is_ok());
+
+    server.join();
+    ::close(listen_fd);
+
+    assert(done == SESSIONS);
+    assert(ok == SESSIONS);
+    assert(peak > 1);
+
+    // 每个会话都上报了完整的 HTTP 事件序列
+    const auto &tl = orch.get_timeline();
+    assert(tl.count_by_type(core::EventType::TCP_CONNECT_SUCCESS) == SESSIONS);
+    assert(tl.count_by_type(core::EventType::HTTP_HEADERS_RECEIVED) == SESSIONS);
+    assert(tl.count_by_type(core::EventType::CONNECTION_CLOSED) >= SESSIONS);
+
+    std::cout << "async_get concurrent test passed (peak in-flight "
+              << peak << ").\n";
+}
+
+void test_scenario_run_async()
+{
+    uint16_t port = 0;
+    int listen_fd = make_listener(port);
+    std::thread server(serve, listen_fd, 1);
+
+    auto loop = std::move(platform::reactor::EventLoop::create().unwrap());
+    core::Orchestrator orch;
+
+    net::http::HttpGetScenario scenario(
+        "http://127.0.0.1:" + std::to_string(port) + "/hello");
+
+    bool finished = false;
+    bool passed = false;
+    util::spawn(scenario.run_async(orch, *loop),
+                [&](util::ResultV<void> r)
+                {
+                    finished = true;
+                    passed = r.is_ok();
+                });
+
+    for (int i = 0; i < 100 && !finished; ++i)
+        assert(loop->run_once(100).is_ok());
+
+    server.join();
+    ::close(listen_fd);
+
+    assert(finished);
+    assert(passed);
+
+    std::cout << "HttpGetScenario::run_async test passed.\n";
+}
+
+void test_sync_get_timings()
+{
+    uint16_t port = 0;
+    int listen_fd = make_listener(port);
+    std::thread server(serve, listen_fd, 1);
+
+    core::Orchestrator orch;
+    net::http::HTTPClient client(orch);
+
+    net::http::HttpRequest req;
+    req.host = "127.0.0.1";
+    req.port = port;
+    req.target = "/hello";
+
+    auto res = client.get(req);
+
+    server.join();
+    ::close(listen_fd);
+
+    assert(res.is_ok());
+    const auto &t = res.unwrap().timings;
+    assert(t.connect.count() > 0);
+    assert(t.request.count() > 0);
+    assert(t.ttfb.count() > 0);
+    assert(t.dns + t.connect + t.request + t.ttfb + t.body <= t.total);
+
+    std::cout << "HTTPClient::get timings test passed.\n";
+}
+
+void test_observer_policies()
+{
+    uint16_t port = 0;
+    int listen_fd = make_listener(port);
+    std::thread server(serve, listen_fd, 3);
+
+    net::http::HttpRequest req;
+    req.host = "127.0.0.1";
+    req.port = port;
+    req.target = "/hello";
+
+    // 完整策略：事件写入 Timeline
+    core::Orchestrator orch;
+    net::http::HTTPClient full(orch);
+    auto a = full.get(req);
+    assert(a.is_ok() && a.unwrap().body == "hello");
+    assert(orch.get_timeline().count_by_type(core::EventType::HTTP_HEADERS_RECEIVED) == 1);
+
+    // 仅计时：无需 Orchestrator，仍有阶段耗时
+    net::http::TimingHTTPClient timing;
+    auto b = timing.get(req);
+    assert(b.is_ok() && b.unwrap().body == "hello");
+    assert(b.unwrap().timings.connect.count() > 0);
+    assert(b.unwrap().timings.total.count() > 0);
+
+    // 空策略：响应完整，耗时全为 0
+    net::http::NullHTTPClient null;
+    auto c = null.get(req);
+    assert(c.is_ok() && c.unwrap().body == "hello");
+    assert(c.unwrap().wire_size == a.unwrap().wire_size);
+    assert(c.unwrap().timings.total.count() == 0);
+    assert(c.unwrap().timings.connect.count() == 0);
+
+    server.join();
+    ::close(listen_fd);
+
+    static_assert(!net::NullObserver::events && !net::NullObserver::timings);
+    static_assert(!net::TimingObserver::events && net::TimingObserver::timings);
+
+    std::cout << "observer policy test passed.\n";
+}
+
+int main()
+{
+    test_sync_get_timings();
+    test_observer_policies();
+    test_async_get_concurrent();
+    test_scenario_run_async();
+    return 0;
+}
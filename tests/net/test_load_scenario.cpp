@@ -0,0 +1,265 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "eunet/core/orchestrator.hpp"
+#include "eunet/net/load_scenario.hpp"
+
+using namespace net::http;
+
+static const char RESPONSE[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Length: 2\r\n"
+    "Connection: close\r\n"
+    "\r\n"
+    "ok";
+
+// 逐个处理连接的 HTTP 服务端，可在第 stall_at 个请求上停顿，模拟服务端卡顿
+struct Server
+{
+    int listen_fd = -1;
+    uint16_t port = 0;
+    int stall_at = -1;
+    std::chrono::milliseconds stall{0};
+    std::atomic<int> served{0};
+    std::thread th;
+
+    void start()
+    {
+        listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        assert(listen_fd >= 0);
+
+        int one = 1;
+        ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        assert(::bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) == 0);
+        assert(::listen(listen_fd, 1024) == 0);
+
+        socklen_t len = sizeof(addr);
+        assert(::getsockname(listen_fd, (sockaddr *)&addr, &len) == 0);
+        port = ntohs(addr.sin_port);
+
+        th = std::thread([this]
+                         { loop(); });
+    }
+
+    void loop()
+    {
+        for (;;)
+        {
+            int fd = ::accept(listen_fd, nullptr, nullptr);
+            if (fd < 0)
+                return;
+
+            std::string req;
+            char buf[1024];
+            while (req.find("\r\n\r\n") == std::string::npos)
+            {
+                ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+                if (n <= 0)
+                    break;
+                req.append(buf, static_cast<size_t>(n));
+            }
+
+            if (served.fetch_add(1) == stall_at)
+                std::this_thread::sleep_for(stall);
+
+            (void)::send(fd, RESPONSE, sizeof(RESPONSE) - 1, MSG_NOSIGNAL);
+            ::close(fd);
+        }
+    }
+
+    void stop()
+    {
+        ::shutdown(listen_fd, SHUT_RDWR);
+        th.join();
+        ::close(listen_fd);
+    }
+
+    std::string url() const
+    {
+        return "http://127.0.0.1:" + std::to_string(port) + "/";
+    }
+};
+
+void test_fixed_rate()
+{
+    Server server;
+    server.start();
+
+    LoadConfig cfg;
+    cfg.url = server.url();
+    cfg.rate = 200;
+    cfg.warmup = std::chrono::milliseconds(200);
+    cfg.duration = std::chrono::milliseconds(1000);
+
+    core::Orchestrator orch;
+    LoadScenario sc(cfg);
+    assert(sc.run(orch).is_ok());
+    server.stop();
+
+    const auto &r = sc.report();
+    std::cout << format_report(r);
+
+    // 计划发送数由速率与时长决定，与响应快慢无关
+    assert(r.warmup_sent == 40);
+    assert(r.sent == 200);
+    assert(r.errors == 0);
+    assert(r.completed == r.sent);
+    assert(r.latency.total_count() == r.sent);
+    assert(r.achieved_rate > cfg.rate * 0.9);
+    assert(server.served.load() == 240);
+
+    std::cout << "LoadScenario fixed-rate test passed.\n";
+}
+
+void test_coordinated_omission()
+{
+    // 在途上限为 1 时发生器退化为闭环；服务端卡顿期间计划中的请求全部被推迟，
+    // 修正后的延迟应体现这段排队时间，而服务时间只看到一次慢请求
+    Server server;
+    server.stall_at = 10;
+    server.stall = std::chrono::milliseconds(300);
+    server.start();
+
+    LoadConfig cfg;
+    cfg.url = server.url();
+    cfg.rate = 100;
+    cfg.warmup = std::chrono::milliseconds(0);
+    cfg.duration = std::chrono::milliseconds(1000);
+    cfg.max_in_flight = 1;
+
+    core::Orchestrator orch;
+    LoadScenario sc(cfg);
+    assert(sc.run(orch).is_ok());
+    server.stop();
+
+    const auto &r = sc.report();
+    std::cout << format_report(r);
+
+    assert(r.sent == 100);
+    assert(r.completed == 100);
+    assert(r.throttled > 0);
+    assert(r.saturated);
+
+    assert(r.service.value_at_percentile(90) < 50'000);
+    assert(r.service.max() >= 300'000);
+    assert(r.latency.value_at_percentile(90) >= 100'000);
+
+    std::cout << "LoadScenario coordinated-omission test passed.\n";
+}
+
+void test_poisson()
+{
+    Server server;
+    server.start();
+
+    LoadConfig cfg;
+    cfg.url = server.url();
+    cfg.rate = 300;
+    cfg.arrival = Arrival::Poisson;
+    cfg.warmup = std::chrono::milliseconds(0);
+    cfg.duration = std::chrono::milliseconds(1000);
+    cfg.seed = 42;
+
+    core::Orchestrator orch;
+    LoadScenario sc(cfg);
+    assert(sc.run(orch).is_ok());
+    server.stop();
+
+    const auto &r = sc.report();
+    assert(r.sent > 200 && r.sent < 400);
+    assert(r.completed + r.errors == r.sent);
+
+    std::cout << "LoadScenario poisson test passed (" << r.sent << " requests).\n";
+}
+
+void test_low_rate_poisson_not_saturated()
+{
+    // 低速率泊松到达的实际到达数常明显少于 rate * duration，
+    // 这几个种子的实际发出速率都低于名义速率的 95%，但客户端并不繁忙
+    Server server;
+    server.start();
+
+    for (std::uint64_t seed : {7, 20, 27})
+    {
+        LoadConfig cfg;
+        cfg.url = server.url();
+        cfg.rate = 20;
+        cfg.arrival = Arrival::Poisson;
+        cfg.warmup = std::chrono::milliseconds(0);
+        cfg.duration = std::chrono::milliseconds(500);
+        cfg.lag_threshold = std::chrono::milliseconds(100); // 只考察速率判定，放宽调度抖动
+        cfg.seed = seed;
+
+        core::Orchestrator orch;
+        LoadScenario sc(cfg);
+        assert(sc.run(orch).is_ok());
+
+        const auto &r = sc.report();
+        assert(r.achieved_rate < cfg.rate * 0.95);
+        assert(r.throttled == 0);
+        assert(!r.saturated);
+    }
+    server.stop();
+
+    std::cout << "LoadScenario low-rate poisson test passed.\n";
+}
+
+void test_errors_in_latency()
+{
+    // 目标端口无人监听 每个请求都以连接被拒绝结束
+    LoadConfig cfg;
+    cfg.url = "http://127.0.0.1:1/";
+    cfg.rate = 100;
+    cfg.warmup = std::chrono::milliseconds(0);
+    cfg.duration = std::chrono::milliseconds(300);
+
+    core::Orchestrator orch;
+    LoadScenario sc(cfg);
+    assert(sc.run(orch).is_ok());
+
+    const auto &r = sc.report();
+    assert(r.sent > 0);
+    assert(r.completed == 0 && r.errors == r.sent);
+    assert(r.latency.total_count() == r.sent);
+    assert(r.error_latency.total_count() == r.errors);
+    assert(format_report(r).find("Errors") != std::string::npos);
+
+    std::cout << "LoadScenario error latency test passed.\n";
+}
+
+void test_invalid_config()
+{
+    LoadConfig cfg;
+    cfg.url = "http://127.0.0.1:1/";
+    cfg.rate = 0;
+
+    core::Orchestrator orch;
+    LoadScenario sc(cfg);
+    auto r = sc.run(orch);
+    assert(r.is_err());
+    assert(r.unwrap_err().category() == util::ErrorCategory::InvalidArgument);
+}
+
+int main()
+{
+    test_invalid_config();
+    test_fixed_rate();
+    test_coordinated_omission();
+    test_poisson();
+    test_low_rate_poisson_not_saturated();
+    test_errors_in_latency();
+    return 0;
+}
@@ -2,8 +2,10 @@
 #include <cstring>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include <arpa/inet.h>
+#include <netinet/tcp.h>
 #include <unistd.h>
 
 #include "eunet/platform/poller.hpp"
@@ -97,13 +99,276 @@ void test_tcp_blocking_read_write()
 
     assert(echoed == msg);
 
+    /* ---------- tcp_info ---------- */
+    auto info_res = sock.tcp_info();
+    assert(info_res.is_ok());
+    assert(info_res.unwrap().snd_mss > 0);
+
     server.join();
 
     std::cout << "[OK] test_tcp_blocking_read_write\n";
 }
 
+void test_tcp_info_sampler()
+{
+    TcpInfoSampler off;
+    assert(!off.enabled());
+    assert(!off.due(platform::time::monotonic_now()));
+
+    TcpInfoSampler sampler(platform::time::Duration{50});
+    auto t0 = platform::time::monotonic_now();
+    assert(sampler.due(t0));
+
+    sampler.mark(t0);
+    assert(!sampler.due(t0 + 10ms));
+    assert(sampler.due(t0 + 50ms));
+
+    sampler.reset();
+    assert(sampler.due(t0));
+
+    std::cout << "[OK] test_tcp_info_sampler\n";
+}
+
+void test_tcp_socket_options()
+{
+    constexpr uint16_t PORT = 23459;
+
+    // 服务端开启 TFO 队列 以便客户端的 Fast Open 请求被接受
+    int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    assert(listen_fd >= 0);
+
+    int opt = 1;
+    ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    int qlen = 8;
+    ::setsockopt(listen_fd, IPPROTO_TCP, TCP_FASTOPEN, &qlen, sizeof(qlen));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(PORT);
+    assert(::bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) == 0);
+    assert(::listen(listen_fd, 1) == 0);
+
+    std::thread server(
+        [listen_fd]
+        {
+            int conn = ::accept(listen_fd, nullptr, nullptr);
+            assert(conn >= 0);
+
+            char buf[64];
+            ssize_t n = ::recv(conn, buf, sizeof(buf), 0);
+            assert(n == 5);
+            assert(std::memcmp(buf, "hello", 5) == 0);
+
+            ::close(conn);
+        });
+
+    auto poller = std::move(platform::poller::Poller::create().unwrap());
+
+    SocketOptions opts = SocketOptions::low_latency();
+    opts.recv_buffer = 64 * 1024;
+    opts.fastopen = true;
+    assert(!opts.empty());
+    assert(SocketOptions{}.empty());
+
+    auto sock = std::move(TCPSocket::create(poller, AddressFamily::IPv4, opts).unwrap());
+
+    // 创建期：NODELAY / RCVBUF / FASTOPEN_CONNECT，QUICKACK 留到连接期
+    bool nodelay_ok = false;
+    for (const auto &rec : sock.applied_options())
+    {
+        assert(rec.stage == SocketOptionStage::Create);
+        if (rec.name == "TCP_NODELAY")
+            nodelay_ok = rec.ok() && rec.value == 1;
+        assert(rec.name != "TCP_QUICKACK");
+    }
+    assert(nodelay_ok);
+
+    int nodelay = 0;
+    socklen_t len = sizeof(nodelay);
+    ::getsockopt(sock.view().fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, &len);
+    assert(nodelay == 1);
+
+    auto ep = Endpoint::from_string("127.0.0.1", PORT).unwrap();
+    assert(sock.connect(ep, 1000).is_ok());
+
+    // 首次写入携带请求数据（TFO 不可用时退化为普通 connect + send）
+    util::ByteBuffer buf(16);
+    buf.append(std::as_bytes(std::span("hello", 5)));
+    auto w = sock.write(buf, 1000);
+    assert(w.is_ok());
+    assert(w.unwrap() == 5);
+
+    bool quickack_recorded = false;
+    for (const auto &rec : sock.applied_options())
+        if (rec.name == "TCP_QUICKACK")
+            quickack_recorded = rec.stage == SocketOptionStage::Connect;
+    assert(quickack_recorded);
+
+    server.join();
+    ::close(listen_fd);
+
+    std::cout << "[OK] test_tcp_socket_options\n";
+}
+
+void test_tcp_fastopen_no_cookie()
+{
+    constexpr uint16_t PORT = 23460;
+    constexpr size_t SIZE = 256 * 1024;
+
+    // 服务端不开启 TFO 客户端拿不到 cookie 使用独立地址避免命中之前缓存的 cookie
+    int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    assert(listen_fd >= 0);
+
+    int opt = 1;
+    ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = inet_addr("127.0.0.3");
+    addr.sin_port = htons(PORT);
+    assert(::bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) == 0);
+    assert(::listen(listen_fd, 1) == 0);
+
+    size_t received = 0;
+    std::thread server(
+        [listen_fd, &received]
+        {
+            int conn = ::accept(listen_fd, nullptr, nullptr);
+            assert(conn >= 0);
+
+            char buf[16 * 1024];
+            ssize_t n;
+            while ((n = ::recv(conn, buf, sizeof(buf), 0)) > 0)
+                received += static_cast<size_t>(n);
+
+            ::close(conn);
+        });
+
+    auto poller = std::move(platform::poller::Poller::create().unwrap());
+
+    SocketOptions opts;
+    opts.fastopen = true;
+    auto sock = std::move(TCPSocket::create(poller, AddressFamily::IPv4, opts).unwrap());
+    assert(sock.set_nonblocking(true).is_ok());
+
+    // 关闭 TCP_FASTOPEN_CONNECT 走推迟到首次写入的 sendto(MSG_FASTOPEN) 路径
+    int off = 0;
+    ::setsockopt(sock.view().fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &off, sizeof(off));
+
+    auto ep = Endpoint::from_string("127.0.0.3", PORT).unwrap();
+    assert(sock.connect(ep, 1000).is_ok());
+    assert(sock.connect_pending());
+
+    // 没有 cookie 时内核只发出 SYN 同步写入等待握手后写完整个缓冲区
+    util::ByteBuffer buf(SIZE);
+    std::vector<std::byte> data(SIZE, std::byte{'x'});
+    buf.append(data);
+    auto w = sock.write(buf, 2000);
+    assert(w.is_ok());
+    assert(w.unwrap() == SIZE);
+    assert(buf.empty());
+    assert(!sock.connect_pending());
+
+    sock.close();
+    server.join();
+    ::close(listen_fd);
+    assert(received == SIZE);
+
+    std::cout << "[OK] test_tcp_fastopen_no_cookie\n";
+}
+
+void test_tcp_tx_timestamp_matching()
+{
+    constexpr uint16_t PORT = 23461;
+
+    int listen_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    assert(listen_fd >= 0);
+
+    int opt = 1;
+    ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(PORT);
+    assert(::bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) == 0);
+    assert(::listen(listen_fd, 1) == 0);
+
+    // 收齐两次发送后稍作停顿再回包 使第二次发送的回执可能在客户端等待期间到达
+    std::thread server(
+        [listen_fd]
+        {
+            int conn = ::accept(listen_fd, nullptr, nullptr);
+            assert(conn >= 0);
+
+            char buf[16];
+            size_t got = 0;
+            while (got < 2)
+            {
+                ssize_t n = ::recv(conn, buf, sizeof(buf), 0);
+                assert(n > 0);
+                got += static_cast<size_t>(n);
+            }
+
+            std::this_thread::sleep_for(50ms);
+            assert(::send(conn, "ok", 2, 0) == 2);
+
+            (void)::recv(conn, buf, sizeof(buf), 0); // 等待客户端关闭
+            ::close(conn);
+        });
+
+    auto poller = std::move(platform::poller::Poller::create().unwrap());
+    auto sock = std::move(TCPSocket::create(poller, AddressFamily::IPv4).unwrap());
+
+    auto ep = Endpoint::from_string("127.0.0.1", PORT).unwrap();
+    assert(sock.connect(ep, 1000).is_ok());
+
+    // 连接建立后开启 内核才能为发送分配 OPT_ID 序号
+    assert(sock.enable_timestamping().is_ok());
+    assert(sock.tx_timestamping());
+    assert(sock.set_nonblocking(true).is_ok());
+
+    const std::byte one[1] = {std::byte{'a'}};
+
+    util::ByteBuffer buf(8);
+    buf.append(one);
+    assert(sock.write(buf, 1000).is_ok());
+
+    // 环回下发送回执在 send 返回前生成
+    auto tx1 = sock.last_tx_timestamp();
+    assert(tx1);
+
+    buf.append(one);
+    assert(sock.write(buf, 1000).is_ok());
+
+    // 第二次发送的回执未到时为空 不会沿用上一次的时间
+    if (auto tx2 = sock.last_tx_timestamp())
+        assert(*tx2 > *tx1);
+
+    // 等待期间回执触发的 EPOLLERR 不应被当作连接错误
+    util::ByteBuffer reply(8);
+    auto r = sock.read(reply, 2000);
+    assert(r.is_ok());
+    assert(r.unwrap() == 2);
+
+    auto tx2 = sock.drain_tx_timestamps();
+    assert(tx2);
+    assert(*tx2 > *tx1);
+
+    sock.close();
+    server.join();
+    ::close(listen_fd);
+
+    std::cout << "[OK] test_tcp_tx_timestamp_matching\n";
+}
+
 int main()
 {
     test_tcp_blocking_read_write();
+    test_tcp_info_sampler();
+    test_tcp_socket_options();
+    test_tcp_fastopen_no_cookie();
+    test_tcp_tx_timestamp_matching();
     return 0;
 }
@@ -118,8 +118,57 @@ void test_udp_socket_read_write()
     std::cout << "[OK] test_udp_socket_read_write\n";
 }
 
+void test_udp_socket_timestamping()
+{
+    constexpr uint16_t PORT = 23458;
+
+    std::thread server(
+        [&]
+        { run_udp_echo_server(PORT); });
+
+    std::this_thread::sleep_for(50ms);
+
+    auto poller = std::move(platform::poller::Poller::create().unwrap());
+    UDPSocket sock = std::move(UDPSocket::create(poller).unwrap());
+
+    assert(!sock.timestamping_enabled());
+    assert(sock.enable_timestamping().is_ok());
+    assert(sock.timestamping_enabled());
+
+    auto ep = Endpoint::from_string("127.0.0.1", PORT).unwrap();
+    assert(sock.connect(ep, 1000).is_ok());
+
+    auto before = platform::time::wall_now();
+
+    util::ByteBuffer write_buf(32);
+    const char *msg = "stamped";
+    write_buf.append(std::as_bytes(std::span(msg, std::strlen(msg))));
+    assert(sock.write(write_buf, 1000).is_ok());
+
+    util::ByteBuffer read_buf(32);
+    auto read_res = sock.read(read_buf, 2000);
+    assert(read_res.is_ok());
+    assert(read_res.unwrap() == std::strlen(msg));
+
+    auto after = platform::time::wall_now();
+
+    // 软件 RX 时间戳必然落在发送与读取完成之间
+    auto rx = sock.last_rx_timestamp();
+    assert(rx);
+    assert(*rx >= before - 1s && *rx <= after);
+
+    // TX 时间戳在 write 后立即收取，环回下通常已就绪
+    if (auto tx = sock.last_tx_timestamp())
+        assert(*tx >= before - 1s && *tx <= after);
+
+    server.join();
+
+    std::cout << "[OK] test_udp_socket_timestamping\n";
+}
+
 int main()
 {
     test_udp_socket_read_write();
+    test_udp_socket_timestamping();
     return 0;
 }
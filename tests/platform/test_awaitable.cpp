@@ -0,0 +1,99 @@
+#include <cassert>
+#include <chrono>
+#include <coroutine>
+#include <iostream>
+#include <unistd.h>
+
+#include "eunet/platform/awaitable.hpp"
+#include "eunet/platform/event_loop.hpp"
+#include "eunet/platform/fd.hpp"
+
+using platform::fd::Fd;
+using platform::reactor::EventLoop;
+
+// 立即开始执行、结束时挂起的最小协程，测试可在任意挂起点手动销毁协程帧
+struct Probe
+{
+    struct promise_type
+    {
+        Probe get_return_object() { return Probe{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> h;
+};
+
+static Probe wait_readable(EventLoop &loop, platform::fd::FdView fd, int timeout_ms, int &resumed)
+{
+    (void)co_await platform::reactor::readable(loop, fd, timeout_ms);
+    ++resumed;
+}
+
+void test_destroy_while_waiting()
+{
+    auto loop = std::move(EventLoop::create().unwrap());
+    auto [rd, wr] = std::move(Fd::pipe().unwrap());
+
+    // 带超时挂起后销毁协程：定时器与单次关注都不得再恢复它
+    int resumed = 0;
+    auto probe = wait_readable(*loop, rd.view(), 30, resumed);
+    assert(!probe.h.done());
+    assert(loop->timers().size() == 1);
+
+    probe.h.destroy();
+    assert(loop->timers().size() == 0);
+
+    assert(::write(wr.get(), "x", 1) == 1);
+    assert(loop->run_once(60).is_ok());
+    assert(loop->run_once(60).is_ok());
+    assert(resumed == 0);
+
+    // fd 仍保持注册，可被新的等待者再次使用
+    auto again = wait_readable(*loop, rd.view(), -1, resumed);
+    assert(loop->run_once(100).is_ok());
+    assert(resumed == 1 && again.h.done());
+    again.h.destroy();
+
+    assert(loop->unwatch(rd.view()).is_ok());
+    std::cout << "[OK] test_destroy_while_waiting\n";
+}
+
+static Probe sleep_for(EventLoop &loop, std::chrono::milliseconds d, int &resumed)
+{
+    (void)co_await platform::reactor::sleep_until(loop, platform::time::monotonic_now() + d);
+    ++resumed;
+}
+
+void test_destroy_while_sleeping()
+{
+    auto loop = std::move(EventLoop::create().unwrap());
+
+    int resumed = 0;
+    auto probe = sleep_for(*loop, std::chrono::milliseconds(20), resumed);
+    assert(!probe.h.done());
+    assert(loop->timers().size() == 1);
+
+    probe.h.destroy();
+    assert(loop->timers().size() == 0);
+    assert(loop->run_once(50).is_ok());
+    assert(resumed == 0);
+
+    // 正常到期的路径不受影响
+    auto again = sleep_for(*loop, std::chrono::milliseconds(10), resumed);
+    while (!again.h.done())
+        assert(loop->run_once(50).is_ok());
+    assert(resumed == 1);
+    again.h.destroy();
+
+    std::cout << "[OK] test_destroy_while_sleeping\n";
+}
+
+int main()
+{
+    test_destroy_while_waiting();
+    test_destroy_while_sleeping();
+    return 0;
+}
@@ -0,0 +1,146 @@
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "eunet/platform/event_loop.hpp"
+#include "eunet/platform/fd.hpp"
+
+using platform::fd::Fd;
+using platform::reactor::EventLoop;
+using std::chrono::milliseconds;
+
+void test_cross_thread_post()
+{
+    auto loop_res = EventLoop::create();
+    assert(loop_res.is_ok());
+    auto loop = std::move(loop_res.unwrap());
+
+    constexpr int PRODUCERS = 4;
+    constexpr int PER = 5000;
+
+    int counter = 0; // 只在 reactor 线程内修改，无需同步
+    std::thread reactor([&]
+                        {
+                            auto r = loop->run();
+                            assert(r.is_ok()); });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+        producers.emplace_back([&]
+                               {
+                                   for (int i = 0; i < PER; ++i)
+                                       loop->post([&] { ++counter; }); });
+    for (auto &t : producers)
+        t.join();
+
+    // 投递在 stop 之前完成，stop 任务排在最后
+    loop->post([&]
+               { loop->stop(); });
+    reactor.join();
+
+    assert(counter == PRODUCERS * PER);
+
+    const auto &st = loop->stats();
+    assert(st.posted == PRODUCERS * PER + 1);
+    assert(st.executed == PRODUCERS * PER + 1);
+    // 唤醒被合并，eventfd 写入次数不超过投递次数
+    assert(st.wakeups <= st.posted);
+
+    std::cout << "[event_loop] posted=" << st.posted
+              << " wakeups=" << st.wakeups
+              << " iterations=" << st.iterations << "\n";
+}
+
+void test_io_and_timers()
+{
+    auto loop = std::move(EventLoop::create().unwrap());
+
+    auto [rd, wr] = std::move(Fd::pipe().unwrap());
+    std::string got;
+
+    auto w = loop->watch(rd.view(), EPOLLIN, [&](uint32_t ev)
+                         {
+                             assert(ev & EPOLLIN);
+                             char buf[16];
+                             ssize_t n = ::read(rd.get(), buf, sizeof(buf));
+                             got.append(buf, n);
+                             auto u = loop->unwatch(rd.view());
+                             assert(u.is_ok()); });
+    assert(w.is_ok());
+
+    bool fired = false;
+    auto t = loop->timers().schedule_after(milliseconds(20), [&]
+                                           {
+                                               fired = true;
+                                               assert(::write(wr.get(), "ping", 4) == 4); });
+    assert(t.is_ok());
+
+    // dispatch 在 reactor 线程内直接执行
+    loop->post([&]
+               {
+                   bool inline_ran = false;
+                   loop->dispatch([&] { inline_ran = true; });
+                   assert(inline_ran); });
+
+    auto start = platform::time::monotonic_now();
+    while (got.empty() && platform::time::since(start) < milliseconds(1000))
+    {
+        auto r = loop->run_once(100);
+        assert(r.is_ok());
+    }
+
+    assert(fired);
+    assert(got == "ping");
+}
+
+void test_oneshot_arm()
+{
+    auto loop = std::move(EventLoop::create().unwrap());
+    const auto base = loop->poller().size();
+
+    auto [rd, wr] = std::move(Fd::pipe().unwrap());
+    int fired = 0;
+    auto on_ready = [&](uint32_t ev)
+    {
+        assert(ev & EPOLLIN);
+        ++fired;
+    };
+
+    assert(loop->arm(rd.view(), EPOLLIN, on_ready).is_ok());
+    assert(loop->poller().size() == base + 1);
+    assert(::write(wr.get(), "x", 1) == 1);
+
+    assert(loop->run_once(100).is_ok());
+    assert(fired == 1);
+
+    // 触发后单次关注自动停用，数据仍未读也不会再回调
+    assert(loop->run_once(20).is_ok());
+    assert(fired == 1);
+
+    // 重新布防只切换掩码，不增加注册
+    assert(loop->arm(rd.view(), EPOLLIN, on_ready).is_ok());
+    assert(loop->poller().size() == base + 1);
+    assert(loop->run_once(100).is_ok());
+    assert(fired == 2);
+
+    // 撤销后不再回调，fd 仍保持注册
+    assert(loop->arm(rd.view(), EPOLLIN, on_ready).is_ok());
+    assert(loop->disarm(rd.view()).is_ok());
+    assert(loop->run_once(20).is_ok());
+    assert(fired == 2);
+    assert(loop->poller().size() == base + 1);
+
+    assert(loop->unwatch(rd.view()).is_ok());
+    assert(loop->poller().size() == base);
+}
+
+int main()
+{
+    test_cross_thread_post();
+    test_io_and_timers();
+    test_oneshot_arm();
+    std::cout << "[test_event_loop] all assertions passed\n";
+}
@@ -6,10 +6,13 @@
 #include <unistd.h>
 #include <sys/epoll.h>
 #include <iostream>
+#include <vector>
 
 using platform::fd::Fd;
+using platform::poller::EventArray;
 using platform::poller::Poller;
 using platform::poller::PollEvent;
+using platform::poller::PollEventType;
 
 void test_poller_basic()
 {
@@ -105,7 +108,150 @@ void test_poller_basic()
     // fd 会在 Fd 析构时自动 close
 }
 
+struct Conn
+{
+    Fd rd;
+    Fd wr;
+    int hits = 0;
+};
+
+void test_poller_high_volume()
+{
+    auto poller_res = Poller::create();
+    assert(poller_res.is_ok());
+    Poller poller = std::move(poller_res.unwrap());
+
+    // 1. 以用户数据指针注册多个连接
+    constexpr int N = 32;
+    std::vector<Conn> conns(N);
+    for (auto &c : conns)
+    {
+        auto [rd, wr] = std::move(Fd::pipe().unwrap());
+        c.rd = std::move(rd);
+        c.wr = std::move(wr);
+
+        std::uint32_t ev = static_cast<std::uint32_t>(PollEventType::Read) |
+                           static_cast<std::uint32_t>(PollEventType::EdgeTriggered);
+        assert(poller.add(c.rd.view(), ev, &c).is_ok());
+    }
+    assert(poller.size() == N);
+    assert(poller.has_fd(conns[0].rd.get()));
+    assert(poller.registration(conns[0].rd.get())->data == &conns[0]);
+    assert(!poller.has_fd(-1));
+
+    // 空指针注册应当被拒绝
+    assert(poller.add(conns[0].rd.view(), EPOLLIN, nullptr).is_err());
+
+    // 2. 全部写入，事件通过指针直接定位连接
+    for (auto &c : conns)
+        assert(::write(c.wr.get(), "x", 1) == 1);
+
+    EventArray arr(8); // 容量小于就绪数，需要多轮取完
+    int total = 0;
+    while (total < N)
+    {
+        auto res = poller.wait(arr, 100);
+        assert(res.is_ok());
+        assert(res.unwrap() <= arr.capacity());
+        assert(res.unwrap() > 0);
+        for (std::size_t i = 0; i < arr.size(); ++i)
+        {
+            auto *c = static_cast<Conn *>(arr.data(i));
+            assert(arr.events(i) & EPOLLIN);
+            ++c->hits;
+            ++total;
+        }
+    }
+    for (auto &c : conns)
+        assert(c.hits == 1);
+
+    // 3. 边缘触发：未读出数据也不会再次通知
+    {
+        auto res = poller.wait(arr, 10);
+        assert(res.is_ok());
+        assert(arr.empty());
+    }
+
+    // 4. 一次性触发：需要 rearm 才能再次收到事件
+    Conn &c0 = conns[0];
+    {
+        std::uint32_t ev = static_cast<std::uint32_t>(PollEventType::Read) |
+                           static_cast<std::uint32_t>(PollEventType::OneShot);
+        assert(poller.add(c0.rd.view(), ev, &c0).is_ok());
+        assert(poller.size() == N);
+
+        auto res = poller.wait(arr, 100);
+        assert(res.is_ok() && arr.size() == 1);
+        assert(arr.data(0) == &c0);
+
+        res = poller.wait(arr, 10);
+        assert(res.is_ok() && arr.empty());
+
+        assert(poller.rearm(c0.rd.view()).is_ok());
+        res = poller.wait(arr, 100);
+        assert(res.is_ok() && arr.size() == 1);
+        assert(arr.data(0) == &c0);
+    }
+
+    // 5. 调用方提供的原始缓冲区
+    {
+        assert(poller.rearm(c0.rd.view()).is_ok());
+        epoll_event raw[4];
+        auto res = poller.wait(std::span<epoll_event>(raw), 100);
+        assert(res.is_ok() && res.unwrap() == 1);
+        assert(raw[0].data.ptr == &c0);
+    }
+
+    // 6. 移除后表项失效
+    for (auto &c : conns)
+        assert(poller.remove(c.rd.view()).is_ok());
+    assert(poller.size() == 0);
+    assert(!poller.has_fd(c0.rd.get()));
+
+    std::cout << "[test_poller_high_volume] all assertions passed\n";
+}
+
+void test_poller_mixed_registration()
+{
+    Poller poller = std::move(Poller::create().unwrap());
+
+    // 同一 Poller 上混用按 fd 与按指针两种注册
+    auto [a_rd, a_wr] = std::move(Fd::pipe().unwrap());
+    auto [b_rd, b_wr] = std::move(Fd::pipe().unwrap());
+    Conn tag;
+    assert(poller.add(a_rd.view(), EPOLLIN).is_ok());
+    assert(poller.add(b_rd.view(), EPOLLIN, &tag).is_ok());
+
+    assert(::write(a_wr.get(), "x", 1) == 1);
+    assert(::write(b_wr.get(), "x", 1) == 1);
+
+    // wait(int) 返回的均为真实 fd
+    auto res = poller.wait(100);
+    assert(res.is_ok());
+    auto events = res.unwrap();
+    assert(events.size() == 2);
+    bool seen_a = false, seen_b = false;
+    for (auto &ev : events)
+    {
+        seen_a |= ev.fd.fd == a_rd.get();
+        seen_b |= ev.fd.fd == b_rd.get();
+    }
+    assert(seen_a && seen_b);
+
+    // 指针注册改回按 fd 注册后，反查表同步失效
+    assert(poller.remove(b_rd.view()).is_ok());
+    assert(poller.add(b_rd.view(), EPOLLIN).is_ok());
+    res = poller.wait(100);
+    assert(res.is_ok());
+    for (auto &ev : res.unwrap())
+        assert(ev.fd.fd == a_rd.get() || ev.fd.fd == b_rd.get());
+
+    std::cout << "[test_poller_mixed_registration] all assertions passed\n";
+}
+
 int main()
 {
     test_poller_basic();
+    test_poller_high_volume();
+    test_poller_mixed_registration();
 }
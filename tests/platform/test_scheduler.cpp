@@ -0,0 +1,189 @@
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "eunet/platform/scheduler.hpp"
+
+using namespace platform::sched;
+
+static std::unique_ptr<Scheduler> make_scheduler(size_t threads)
+{
+    SchedulerOptions opts;
+    opts.threads = threads;
+
+    auto res = Scheduler::create(opts);
+    assert(res.is_ok());
+    return std::move(res.unwrap());
+}
+
+void test_basic_and_wait_idle()
+{
+    auto sched = make_scheduler(2);
+    assert(sched->size() == 2);
+    sched->start();
+
+    constexpr int TASKS = 1000;
+    std::atomic<int> done{0};
+    for (int i = 0; i < TASKS; ++i)
+        sched->submit([&]
+                      { ++done; });
+
+    sched->wait_idle();
+    assert(done.load() == TASKS);
+    assert(sched->outstanding() == 0);
+
+    auto st = sched->stats();
+    assert(st.submitted == TASKS);
+    assert(st.executed == TASKS);
+    assert(st.executed_by_priority[static_cast<size_t>(Priority::Normal)] == TASKS);
+    assert(st.workers.size() == 2);
+
+    std::cout << "Scheduler basic test passed.\n";
+}
+
+void test_priority()
+{
+    // 单 worker：阻塞任务运行期间排入的高优先级任务必须先于低优先级任务执行
+    auto sched = make_scheduler(1);
+    sched->start();
+
+    std::atomic<bool> started{false};
+    std::atomic<bool> release{false};
+    sched->submit([&]
+                  {
+                      started = true;
+                      while (!release.load())
+                          std::this_thread::yield(); });
+
+    while (!started.load())
+        std::this_thread::yield();
+
+    std::mutex mtx;
+    std::vector<Priority> order;
+    auto record = [&](Priority p)
+    {
+        return [&, p]
+        {
+            std::lock_guard lock(mtx);
+            order.push_back(p);
+        };
+    };
+
+    for (int i = 0; i < 100; ++i)
+        sched->submit(record(Priority::Low), Priority::Low);
+    for (int i = 0; i < 10; ++i)
+        sched->submit(record(Priority::Normal), Priority::Normal);
+    sched->submit(record(Priority::High), Priority::High);
+
+    release = true;
+    sched->wait_idle();
+
+    assert(order.size() == 111);
+    assert(order[0] == Priority::High);
+    for (size_t i = 1; i <= 10; ++i)
+        assert(order[i] == Priority::Normal);
+    for (size_t i = 11; i < order.size(); ++i)
+        assert(order[i] == Priority::Low);
+
+    std::cout << "Scheduler priority test passed.\n";
+}
+
+void test_stealing()
+{
+    auto sched = make_scheduler(4);
+    sched->start();
+
+    constexpr int CHILDREN = 64;
+    std::atomic<int> done{0};
+
+    // 父任务把子任务压入自身队列后一直占用该 worker，子任务只能被其他 worker 窃取
+    sched->submit([&]
+                  {
+                      assert(sched->in_worker());
+                      for (int i = 0; i < CHILDREN; ++i)
+                          sched->submit([&]
+                                        { ++done; });
+                      while (done.load() < CHILDREN)
+                          std::this_thread::yield(); });
+
+    sched->wait_idle();
+    assert(done.load() == CHILDREN);
+    assert(!sched->in_worker());
+
+    auto st = sched->stats();
+    assert(st.stolen == CHILDREN);
+    assert(st.executed == CHILDREN + 1);
+
+    // 空闲后 worker 会进入休眠，休眠计数可观测
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    st = sched->stats();
+    assert(st.idle_sleeps > 0);
+    assert(st.steal_misses > 0);
+
+    std::cout << "Scheduler stealing test passed (stolen "
+              << st.stolen << ").\n";
+}
+
+void test_stop_drains()
+{
+    auto sched = make_scheduler(2);
+
+    // 启动前提交的任务与执行中派生的任务都会在 stop 返回前执行完毕
+    std::atomic<int> done{0};
+    for (int i = 0; i < 100; ++i)
+        sched->submit([&]
+                      {
+                          ++done;
+                          sched->submit([&]
+                                        { ++done; }, Priority::Low); });
+
+    sched->start();
+    sched->stop();
+    assert(done.load() == 200);
+    assert(sched->outstanding() == 0);
+
+    std::cout << "Scheduler stop test passed.\n";
+}
+
+void test_strand_order()
+{
+    auto sched = make_scheduler(3);
+    sched->start();
+
+    constexpr int JOBS = 5000;
+    std::vector<int> seq;
+    std::atomic<int> inside{0};
+    bool overlapped = false;
+
+    {
+        Strand strand(*sched);
+        for (int i = 0; i < JOBS; ++i)
+            strand.post([&, i]
+                        {
+                            if (inside.fetch_add(1) != 0)
+                                overlapped = true;
+                            seq.push_back(i);
+                            inside.fetch_sub(1); });
+        // 析构时等待全部任务执行完毕
+    }
+
+    assert(!overlapped);
+    assert(seq.size() == JOBS);
+    for (int i = 0; i < JOBS; ++i)
+        assert(seq[i] == i);
+
+    std::cout << "Strand order test passed.\n";
+}
+
+int main()
+{
+    test_basic_and_wait_idle();
+    test_priority();
+    test_stealing();
+    test_stop_drains();
+    test_strand_order();
+    return 0;
+}
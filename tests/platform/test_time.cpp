@@ -71,7 +71,40 @@ void test_time_api()
     std::cout << "[test] OK\n";
 }
 
+void test_event_clock()
+{
+    std::cout << "[test] event clock source=" << to_string(event_clock_source()) << "\n";
+
+    /* 1. 事件时钟单调且与 CLOCK_MONOTONIC_RAW 同速 */
+    {
+        auto e0 = event_now();
+        auto r0 = monotonic_raw_ns();
+        sleep_for(std::chrono::milliseconds(20));
+        auto e1 = event_now();
+        auto r1 = monotonic_raw_ns();
+
+        assert(e1 > e0);
+        auto de = event_elapsed(e0, e1).count();
+        auto dr = r1 - r0;
+        assert(de > dr * 9 / 10 && de < dr * 11 / 10);
+    }
+
+    /* 2. 锚点双向换算精确往返，换算结果贴近当前墙上时间 */
+    {
+        auto anchor = WallAnchor::capture();
+        auto ns = event_now();
+        assert(anchor.from_wall(anchor.to_wall(ns)) == ns);
+
+        auto diff = event_to_wall(event_now()) - wall_now();
+        assert(std::chrono::abs(diff) < std::chrono::milliseconds(50));
+        assert(event_from_wall(event_to_wall(ns)) == ns);
+    }
+
+    std::cout << "[test] OK\n";
+}
+
 int main()
 {
     test_time_api();
+    test_event_clock();
 }
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include <cassert>
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "eunet/platform/timer.hpp"
+#include "eunet/platform/poller.hpp"
+#include "eunet/platform/time.hpp"
+
+using namespace platform::timer;
+using platform::time::MonoPoint;
+using std::chrono::milliseconds;
+
+void test_timer_wheel()
+{
+    std::cout << "[test] platform::timer::TimerWheel\n";
+
+    MonoPoint origin{};
+    TimerWheel wheel(milliseconds(1), origin);
+
+    /* 1. 基本触发与取整：截止时间未到不触发 */
+    {
+        int hits = 0;
+        wheel.schedule(origin + milliseconds(10), [&]
+                       { ++hits; });
+        assert(wheel.size() == 1);
+
+        assert(wheel.advance(origin + milliseconds(9)) == 0);
+        assert(hits == 0);
+        assert(wheel.advance(origin + milliseconds(10)) == 1);
+        assert(hits == 1);
+        assert(wheel.empty());
+    }
+
+    /* 2. 取消与句柄失效 */
+    {
+        int hits = 0;
+        auto id = wheel.schedule(origin + milliseconds(50), [&]
+                                 { ++hits; });
+        assert(wheel.pending(id));
+        assert(wheel.cancel(id));
+        assert(!wheel.cancel(id));
+        assert(!wheel.pending(id));
+
+        // 复用节点后旧句柄仍然无效
+        auto id2 = wheel.schedule(origin + milliseconds(60), [&]
+                                  { ++hits; });
+        assert(id2.index == id.index);
+        assert(!wheel.cancel(id));
+        assert(wheel.pending(id2));
+
+        wheel.advance(origin + milliseconds(100));
+        assert(hits == 1);
+    }
+
+    /* 3. 跨层下放：随机截止时间按序、按时触发 */
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> dist(1, 300000);
+
+        MonoPoint base = origin + milliseconds(100);
+        std::vector<int> offsets;
+        std::vector<int> fired_at;
+        MonoPoint cursor = base;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            int off = dist(rng);
+            offsets.push_back(off);
+            wheel.schedule(base + milliseconds(off), [&, off]
+                           {
+                               // 不早于截止时间、且在同一步进内触发
+                               assert(cursor >= base + milliseconds(off));
+                               fired_at.push_back(off); });
+        }
+
+        // 下一次唤醒时刻不会晚于最早截止时间
+        int earliest = *std::min_element(offsets.begin(), offsets.end());
+        auto wake = wheel.next_wakeup();
+        assert(wake && *wake <= base + milliseconds(earliest));
+
+        // 以不规则步长推进
+        while (!wheel.empty())
+        {
+            cursor += milliseconds(1 + (dist(rng) % 97));
+            wheel.advance(cursor);
+        }
+
+        // 同一步进内的触发顺序不做保证，只比较集合
+        assert(fired_at.size() == offsets.size());
+        std::sort(fired_at.begin(), fired_at.end());
+        std::sort(offsets.begin(), offsets.end());
+        assert(fired_at == offsets);
+        origin = cursor;
+    }
+
+    /* 4. 已过期截止时间与回调内重新调度 */
+    {
+        int hits = 0;
+        TimerId second{};
+        wheel.schedule(origin - milliseconds(5), [&]
+                       {
+                           ++hits;
+                           // 回调内取消同批次之外的定时器、再添加新的过期定时器
+                           wheel.cancel(second);
+                           wheel.schedule(origin, [&]
+                                          { ++hits; }); });
+        second = wheel.schedule(origin + milliseconds(3), [&]
+                                { hits += 100; });
+
+        assert(wheel.advance(origin) == 1);
+        assert(hits == 1);
+        assert(wheel.size() == 1);
+        assert(wheel.advance(origin) == 1);
+        assert(hits == 2);
+
+        wheel.advance(origin + milliseconds(10));
+        assert(hits == 2);
+    }
+
+    /* 5. 超出时间轮跨度的截止时间 */
+    {
+        int hits = 0;
+        auto far = milliseconds(TimerWheel::MAX_SPAN + 1000);
+        wheel.schedule(origin + far, [&]
+                       { ++hits; });
+        wheel.advance(origin + far - milliseconds(1));
+        assert(hits == 0);
+        wheel.advance(origin + far);
+        assert(hits == 1);
+    }
+
+    std::cout << "[test_timer_wheel] all assertions passed\n";
+}
+
+void test_timer_service()
+{
+    std::cout << "[test] platform::timer::TimerService\n";
+
+    auto poller = platform::poller::Poller::create().unwrap();
+    auto svc_res = TimerService::create();
+    assert(svc_res.is_ok());
+    TimerService svc = std::move(svc_res.unwrap());
+
+    auto attach_res = svc.attach(poller);
+    assert(attach_res.is_ok());
+
+    std::vector<int> order;
+    auto start = platform::time::monotonic_now();
+
+    // deadline_after 的结果可以直接调度
+    auto t30 = svc.schedule(platform::time::deadline_after(milliseconds(30)), [&]
+                            { order.push_back(30); });
+    auto t10 = svc.schedule_after(milliseconds(10), [&]
+                                  { order.push_back(10); });
+    auto cancelled = svc.schedule_after(milliseconds(20), [&]
+                                        { order.push_back(20); });
+    assert(t30.is_ok());
+    assert(t10.is_ok());
+    assert(cancelled.is_ok());
+    assert(svc.cancel(cancelled.unwrap()));
+
+    while (svc.size() > 0)
+    {
+        auto evs = poller.wait(1000);
+        assert(evs.is_ok());
+        assert(!evs.unwrap().empty());
+        assert(evs.unwrap()[0].fd == svc.fd());
+
+        auto n = svc.dispatch();
+        assert(n.is_ok());
+    }
+
+    auto elapsed = platform::time::since(start);
+    assert(elapsed >= milliseconds(30));
+    assert((order == std::vector<int>{10, 30}));
+
+    std::cout << "[test_timer_service] all assertions passed\n";
+}
+
+int main()
+{
+    test_timer_wheel();
+    test_timer_service();
+}
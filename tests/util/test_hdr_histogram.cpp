@@ -0,0 +1,97 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+
+#include "eunet/util/hdr_histogram.hpp"
+
+using util::HdrHistogram;
+
+// 相对误差不超过 3 位有效数字的精度
+static bool close_to(std::int64_t got, std::int64_t want)
+{
+    return std::abs(static_cast<double>(got - want)) <= want * 0.001 + 1;
+}
+
+void test_uniform_percentiles()
+{
+    HdrHistogram h(1, 3'600'000'000LL, 3);
+    for (std::int64_t v = 1; v <= 100000; ++v)
+        h.record(v);
+
+    assert(h.total_count() == 100000);
+    assert(h.min() == 1);
+    assert(h.max() == 100000);
+    assert(std::abs(h.mean() - 50000.5) < 1.0);
+
+    assert(close_to(h.value_at_percentile(50), 50000));
+    assert(close_to(h.value_at_percentile(90), 90000));
+    assert(close_to(h.value_at_percentile(99), 99000));
+    assert(close_to(h.value_at_percentile(99.9), 99900));
+    assert(h.value_at_percentile(100) == 100000);
+    assert(h.value_at_percentile(0) == 1);
+}
+
+void test_equivalent_ranges()
+{
+    HdrHistogram h(1, 1'000'000, 3);
+
+    // 小于 2048 的数值精确到 1
+    assert(h.lowest_equivalent(1000) == 1000);
+    assert(h.highest_equivalent(1000) == 1000);
+
+    // 更大的数值按桶宽合并，但相对误差保持在精度以内
+    std::int64_t lo = h.lowest_equivalent(123456);
+    std::int64_t hi = h.highest_equivalent(123456);
+    assert(lo <= 123456 && 123456 <= hi);
+    assert(static_cast<double>(hi - lo) / 123456.0 < 0.001);
+}
+
+void test_tail_and_clamp()
+{
+    HdrHistogram h(1, 10'000, 2);
+    for (int i = 0; i < 9990; ++i)
+        h.record(10);
+    h.record(5000, 10);
+    h.record(1'000'000); // 超出量程
+
+    assert(h.clamped() == 1);
+    assert(h.max() == 10'000);
+    assert(h.value_at_percentile(50) == 10);
+    assert(close_to(h.value_at_percentile(99.95), 5000) || h.value_at_percentile(99.95) >= 5000);
+}
+
+void test_merge_and_reset()
+{
+    HdrHistogram a(1, 1'000'000, 3);
+    HdrHistogram b(1, 1'000'000, 3);
+    HdrHistogram other(1, 1000, 3);
+
+    for (int i = 0; i < 100; ++i)
+        a.record(100);
+    for (int i = 0; i < 100; ++i)
+        b.record(300);
+
+    assert(a.merge(b));
+    assert(!a.merge(other));
+    assert(a.total_count() == 200);
+    assert(a.min() == 100);
+    assert(a.max() == 300);
+    assert(a.value_at_percentile(50) == 100);
+    assert(a.value_at_percentile(51) == 300);
+
+    a.reset();
+    assert(a.total_count() == 0);
+    assert(a.value_at_percentile(99) == 0);
+    assert(a.min() == 0);
+}
+
+int main()
+{
+    test_uniform_percentiles();
+    test_equivalent_ranges();
+    test_tail_and_clamp();
+    test_merge_and_reset();
+
+    std::cout << "HdrHistogram tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <cassert>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "eunet/util/lz_block.hpp"
+
+static std::vector<std::byte> bytes_of(const std::string &s)
+{
+    std::vector<std::byte> out;
+    for (char c : s)
+        out.push_back(static_cast<std::byte>(c));
+    return out;
+}
+
+static std::vector<std::byte> roundtrip(const std::vector<std::byte> &src)
+{
+    std::vector<std::byte> packed{std::byte{0xAA}}; // 结果追加在已有内容之后
+    auto n = util::lz::compress(src, packed);
+    assert(n == packed.size() - 1);
+    assert(n <= util::lz::max_compressed_size(src.size()));
+
+    std::vector<std::byte> out(src.size());
+    auto r = util::lz::decompress(std::span<const std::byte>(packed).subspan(1), out);
+    assert(r.is_ok());
+    assert(out == src);
+    return packed;
+}
+
+void test_edge_sizes()
+{
+    for (std::size_t n : {0, 1, 4, 12, 13, 16, 64})
+        roundtrip(std::vector<std::byte>(n, std::byte{'a'}));
+}
+
+void test_repetitive()
+{
+    std::string headers;
+    for (int i = 0; i < 200; ++i)
+        headers += "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nDate: " + std::to_string(1000 + i) + "\r\n\r\n";
+
+    auto src = bytes_of(headers);
+    auto packed = roundtrip(src);
+    assert(packed.size() * 10 < src.size());
+
+    // 重叠复制：距离 1 的长匹配
+    auto run = roundtrip(std::vector<std::byte>(100000, std::byte{0}));
+    assert(run.size() < 1000);
+}
+
+void test_random()
+{
+    std::mt19937 rng(42);
+    std::vector<std::byte> src(70000);
+    for (auto &b : src)
+        b = static_cast<std::byte>(rng());
+
+    // 不可压缩的数据只略微膨胀
+    auto packed = roundtrip(src);
+    assert(packed.size() < src.size() + src.size() / 100);
+
+    // 随机片段拼接：跨越 64 KiB 窗口的重复内容
+    std::vector<std::byte> mixed;
+    for (int i = 0; i < 50; ++i)
+    {
+        auto at = rng() % (src.size() - 5000);
+        mixed.insert(mixed.end(), src.begin() + at, src.begin() + at + 1 + rng() % 4000);
+    }
+    roundtrip(mixed);
+}
+
+void test_corrupt()
+{
+    auto src = bytes_of(std::string(1000, 'x') + "tail");
+    std::vector<std::byte> packed;
+    util::lz::compress(src, packed);
+
+    std::vector<std::byte> out(src.size());
+    // 目标长度不符
+    std::vector<std::byte> shorter(src.size() - 1);
+    assert(util::lz::decompress(packed, shorter).is_err());
+
+    // 截断的输入
+    for (std::size_t cut = 1; cut < packed.size(); ++cut)
+        assert(util::lz::decompress(std::span<const std::byte>(packed).first(cut), out).is_err());
+
+    // 回溯距离越过输出起点
+    std::vector<std::byte> bad{std::byte{0x10}, std::byte{'a'}, std::byte{0x05}, std::byte{0x00}};
+    std::vector<std::byte> small(5);
+    assert(util::lz::decompress(bad, small).is_err());
+}
+
+int main()
+{
+    test_edge_sizes();
+    test_repetitive();
+    test_random();
+    test_corrupt();
+    return 0;
+}
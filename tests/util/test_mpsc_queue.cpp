@@ -0,0 +1,91 @@
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <memory>
+
+#include "eunet/util/mpsc_queue.hpp"
+
+using util::MpscQueue;
+
+void test_single_thread_fifo()
+{
+    MpscQueue<int> q;
+    assert(q.empty());
+    assert(!q.try_pop());
+
+    for (int i = 0; i < 10; ++i)
+        q.push(i);
+    assert(!q.empty());
+
+    for (int i = 0; i < 10; ++i)
+    {
+        auto v = q.try_pop();
+        assert(v && *v == i);
+    }
+    assert(q.empty());
+}
+
+void test_move_only_and_limit()
+{
+    MpscQueue<std::unique_ptr<int>> q;
+    for (int i = 0; i < 5; ++i)
+        q.push(std::make_unique<int>(i));
+
+    int sum = 0;
+    size_t n = q.pop_all([&](std::unique_ptr<int> &&p)
+                         { sum += *p; },
+                         3);
+    assert(n == 3);
+    assert(sum == 0 + 1 + 2);
+
+    n = q.pop_all([&](std::unique_ptr<int> &&p)
+                  { sum += *p; });
+    assert(n == 2);
+    assert(sum == 10);
+    assert(q.empty());
+}
+
+void test_multi_producer()
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int PER = 20000;
+
+    MpscQueue<std::pair<int, int>> q;
+    std::vector<std::thread> ths;
+    for (int p = 0; p < PRODUCERS; ++p)
+        ths.emplace_back([&, p]
+                         {
+                             for (int i = 0; i < PER; ++i)
+                                 q.push({p, i}); });
+
+    // 每个生产者内部保持 FIFO
+    std::vector<int> next(PRODUCERS, 0);
+    int total = 0;
+    while (total < PRODUCERS * PER)
+    {
+        total += static_cast<int>(q.pop_all([&](std::pair<int, int> &&v)
+                                            {
+                                                assert(v.second == next[v.first]);
+                                                ++next[v.first]; }));
+    }
+
+    for (auto &t : ths)
+        t.join();
+
+    assert(q.empty());
+    for (int p = 0; p < PRODUCERS; ++p)
+        assert(next[p] == PER);
+}
+
+int main()
+{
+    std::cout << "Running MpscQueue tests...\n";
+
+    test_single_thread_fifo();
+    test_move_only_and_limit();
+    test_multi_producer();
+
+    std::cout << "All MpscQueue tests passed.\n";
+    return 0;
+}
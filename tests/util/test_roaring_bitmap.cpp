@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "eunet/util/roaring_bitmap.hpp"
+
+using util::RoaringBitmap;
+
+static std::vector<std::uint32_t> to_vec(const std::set<std::uint32_t> &s)
+{
+    return {s.begin(), s.end()};
+}
+
+// 稀疏、稠密与跨块混合的数据
+static void fill(RoaringBitmap &bm, std::set<std::uint32_t> &ref, std::mt19937 &rng, double density)
+{
+    std::bernoulli_distribution pick(density);
+    for (std::uint32_t v = 0; v < 300000; ++v)
+        if (pick(rng))
+        {
+            bm.add(v);
+            ref.insert(v);
+        }
+}
+
+void test_add_and_contains()
+{
+    RoaringBitmap bm;
+    assert(bm.empty() && bm.minimum() == 0 && bm.maximum() == 0);
+
+    // 乱序写入与重复写入
+    for (std::uint32_t v : {70000u, 5u, 70000u, 1u, 65536u, 5u, 4000000000u})
+        bm.add(v);
+
+    assert(bm.cardinality() == 5);
+    assert(bm.contains(1) && bm.contains(5) && bm.contains(65536) && bm.contains(70000));
+    assert(bm.contains(4000000000u));
+    assert(!bm.contains(2) && !bm.contains(65537));
+    assert(bm.minimum() == 1 && bm.maximum() == 4000000000u);
+    assert((bm.to_vector() == std::vector<std::uint32_t>{1, 5, 65536, 70000, 4000000000u}));
+}
+
+void test_dense_container()
+{
+    RoaringBitmap bm;
+    for (std::uint32_t v = 0; v < 10000; ++v)
+        bm.add(v * 2);
+
+    // 超过 4096 个元素后转为位集，结果不变
+    assert(bm.cardinality() == 10000);
+    assert(bm.contains(19998) && !bm.contains(19999));
+    assert(bm.minimum() == 0 && bm.maximum() == 19998);
+
+    bm.remove_from(9000);
+    assert(bm.cardinality() == 4500);
+    assert(bm.maximum() == 8998);
+    assert(!bm.contains(9000));
+
+    bm.remove_from(0);
+    assert(bm.empty());
+}
+
+void test_set_operations()
+{
+    std::mt19937 rng(42);
+
+    for (double da : {0.001, 0.05, 0.5})
+        for (double db : {0.002, 0.1, 0.7})
+        {
+            RoaringBitmap a, b;
+            std::set<std::uint32_t> ra, rb;
+            fill(a, ra, rng, da);
+            fill(b, rb, rng, db);
+
+            std::set<std::uint32_t> inter, uni;
+            std::set_intersection(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(inter, inter.end()));
+            std::set_union(ra.begin(), ra.end(), rb.begin(), rb.end(), std::inserter(uni, uni.end()));
+
+            auto i = RoaringBitmap::intersect(a, b);
+            assert(i.cardinality() == inter.size());
+            assert(i.to_vector() == to_vec(inter));
+            assert(RoaringBitmap::intersect_count(a, b) == inter.size());
+
+            auto u = RoaringBitmap::unite(a, b);
+            assert(u.cardinality() == uni.size());
+            assert(u.to_vector() == to_vec(uni));
+        }
+}
+
+void test_range_iteration_and_truncate()
+{
+    std::mt19937 rng(7);
+    RoaringBitmap bm;
+    std::set<std::uint32_t> ref;
+    fill(bm, ref, rng, 0.3);
+
+    std::vector<std::uint32_t> got;
+    bm.for_each([&](std::uint32_t v)
+                { got.push_back(v); },
+                1000, 140000);
+    std::vector<std::uint32_t> want(ref.lower_bound(1000), ref.lower_bound(140000));
+    assert(got == want);
+
+    bm.remove_from(100000);
+    ref.erase(ref.lower_bound(100000), ref.end());
+    assert(bm.to_vector() == to_vec(ref));
+    assert(bm.maximum() == *ref.rbegin());
+
+    // 截断后继续升序追加
+    bm.add(100001);
+    assert(bm.contains(100001) && bm.cardinality() == ref.size() + 1);
+}
+
+int main()
+{
+    test_add_and_contains();
+    test_dense_container();
+    test_set_operations();
+    test_range_iteration_and_truncate();
+
+    std::cout << "RoaringBitmap tests passed (" << RoaringBitmap::simd_backend() << ")\n";
+    return 0;
+}
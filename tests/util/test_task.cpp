@@ -0,0 +1,170 @@
+#include <cassert>
+#include <coroutine>
+#include <iostream>
+#include <memory>
+#include <optional>
+
+#include "eunet/util/task.hpp"
+#include "eunet/util/result.hpp"
+#include "eunet/util/error.hpp"
+
+using util::Task;
+
+// 手动恢复的挂起点，模拟 reactor 稍后恢复协程
+struct ManualEvent
+{
+    std::coroutine_handle<> waiter;
+
+    struct Awaiter
+    {
+        ManualEvent *ev;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) noexcept { ev->waiter = h; }
+        void await_resume() const noexcept {}
+    };
+
+    Awaiter wait() noexcept { return Awaiter{this}; }
+
+    void fire()
+    {
+        auto h = std::exchange(waiter, {});
+        h.resume();
+    }
+};
+
+Task<int> add(int a, int b)
+{
+    co_return a + b;
+}
+
+Task<int> nested()
+{
+    int x = co_await add(1, 2);
+    int y = co_await add(x, 4);
+    co_return y;
+}
+
+Task<int> depth(int n)
+{
+    if (n == 0)
+        co_return 0;
+    co_return 1 + co_await depth(n - 1);
+}
+
+void test_lazy_and_nested()
+{
+    bool started = false;
+    auto lazy = [&]() -> Task<void>
+    {
+        started = true;
+        co_return;
+    };
+
+    auto t = lazy();
+    assert(!started);
+    assert(!t.done());
+
+    util::spawn(std::move(t));
+    assert(started);
+
+    std::optional<int> out;
+    util::spawn(nested(), [&](int v)
+                { out = v; });
+    assert(out && *out == 7);
+}
+
+void test_deep_chain()
+{
+    // 逐层 co_await 子任务，完成后经 continuation 逐层返回
+    std::optional<int> out;
+    util::spawn(depth(1000), [&](int v)
+                { out = v; });
+    assert(out && *out == 1000);
+}
+
+void test_result_and_move_only()
+{
+    auto make = []() -> Task<util::ResultV<std::unique_ptr<int>>>
+    {
+        co_return util::ResultV<std::unique_ptr<int>>::Ok(std::make_unique<int>(42));
+    };
+
+    auto fail = []() -> Task<util::ResultV<int>>
+    {
+        co_return util::ResultV<int>::Err(
+            util::Error::internal()
+                .invalid_argument()
+                .message("boom")
+                .build());
+    };
+
+    int got = 0;
+    bool failed = false;
+
+    auto outer = [&]() -> Task<void>
+    {
+        auto r = co_await make();
+        assert(r.is_ok());
+        got = *r.unwrap();
+
+        auto e = co_await fail();
+        failed = e.is_err() &&
+                 e.unwrap_err().category() == util::ErrorCategory::InvalidArgument;
+    };
+
+    util::spawn(outer());
+    assert(got == 42);
+    assert(failed);
+}
+
+void test_suspend_and_resume_later()
+{
+    ManualEvent ev;
+    int stage = 0;
+
+    auto inner = [&]() -> Task<int>
+    {
+        stage = 1;
+        co_await ev.wait();
+        stage = 2;
+        co_return 5;
+    };
+
+    std::optional<int> out;
+    util::spawn(inner(), [&](int v)
+                { out = v; });
+
+    // 挂起在 ev 上，尚未完成
+    assert(stage == 1);
+    assert(!out);
+
+    ev.fire();
+    assert(stage == 2);
+    assert(out && *out == 5);
+}
+
+void test_destroy_unstarted()
+{
+    // 未启动的任务析构时释放协程帧，捕获的资源随之释放
+    auto res = std::make_shared<int>(1);
+    std::weak_ptr<int> weak = res;
+    {
+        auto t = [](std::shared_ptr<int> p) -> Task<int>
+        { co_return *p; }(std::move(res));
+        assert(!weak.expired());
+    }
+    assert(weak.expired());
+}
+
+int main()
+{
+    test_lazy_and_nested();
+    test_deep_chain();
+    test_result_and_move_only();
+    test_suspend_and_resume_later();
+    test_destroy_unstarted();
+
+    std::cout << "Task tests passed.\n";
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "eunet/util/ws_deque.hpp"
+
+using util::WorkStealingDeque;
+
+void test_owner_lifo_and_steal_fifo()
+{
+    WorkStealingDeque<int> dq(4);
+    assert(dq.empty());
+
+    for (int i = 0; i < 4; ++i)
+        dq.push(i);
+    assert(dq.size() == 4);
+
+    // 所有者从底部取出最新的，窃取者从顶部取出最早的
+    assert(*dq.pop() == 3);
+    assert(*dq.steal() == 0);
+    assert(*dq.pop() == 2);
+    assert(*dq.steal() == 1);
+
+    assert(!dq.pop());
+    assert(!dq.steal());
+    assert(dq.empty());
+}
+
+void test_grow()
+{
+    WorkStealingDeque<int> dq(2);
+    for (int i = 0; i < 1000; ++i)
+        dq.push(i);
+
+    assert(dq.capacity() >= 1000);
+    assert(dq.size() == 1000);
+
+    for (int i = 999; i >= 0; --i)
+        assert(*dq.pop() == i);
+    assert(dq.empty());
+}
+
+void test_concurrent_steal()
+{
+    constexpr int ITEMS = 100000;
+    constexpr int THIEVES = 3;
+
+    WorkStealingDeque<int> dq(64);
+    std::vector<std::atomic<int>> seen(ITEMS);
+    std::atomic<bool> done{false};
+    std::atomic<int> taken{0};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < THIEVES; ++t)
+    {
+        thieves.emplace_back([&]
+                             {
+                                 while (!done.load(std::memory_order_acquire) || !dq.empty())
+                                 {
+                                     if (auto v = dq.steal())
+                                     {
+                                         seen[*v].fetch_add(1);
+                                         ++taken;
+                                     }
+                                     else
+                                         std::this_thread::yield();
+                                 } });
+    }
+
+    // 所有者边 push 边 pop，与窃取者争抢同一批元素
+    for (int i = 0; i < ITEMS; ++i)
+    {
+        dq.push(i);
+        if (i % 3 == 0)
+        {
+            if (auto v = dq.pop())
+            {
+                seen[*v].fetch_add(1);
+                ++taken;
+            }
+        }
+    }
+    done.store(true, std::memory_order_release);
+
+    for (auto &t : thieves)
+        t.join();
+
+    while (auto v = dq.pop())
+    {
+        seen[*v].fetch_add(1);
+        ++taken;
+    }
+
+    // 每个元素恰好被取出一次：既不丢失也不重复
+    assert(taken.load() == ITEMS);
+    for (int i = 0; i < ITEMS; ++i)
+        assert(seen[i].load() == 1);
+}
+
+int main()
+{
+    test_owner_lifo_and_steal_fifo();
+    test_grow();
+    test_concurrent_steal();
+
+    std::cout << "WorkStealingDeque tests passed.\n";
+    return 0;
+}